@@ -33,6 +33,7 @@ set(DEM_L2_GAME_HEADERS
 	DEM/Game/src/AI/Navigation/NavMeshLoaderNM.h
 	DEM/Game/src/AI/Navigation/PathRequestQueue.h
 	DEM/Game/src/AI/Navigation/TraversalAction.h
+	DEM/Game/src/AI/Perception/FactMemory.h
 	DEM/Game/src/AI/Perception/Perception.h
 	DEM/Game/src/AI/Perception/SoundSensorComponent.h
 	DEM/Game/src/AI/Perception/SoundStimulus.h
@@ -117,7 +118,9 @@ set(DEM_L2_GAME_SOURCES
 	DEM/Game/src/AI/Navigation/NavMeshDebugDraw.cpp
 	DEM/Game/src/AI/Navigation/NavMeshLoaderNM.cpp
 	DEM/Game/src/AI/Navigation/PathRequestQueue.cpp
+	DEM/Game/src/AI/Perception/FactMemory.cpp
 	DEM/Game/src/AI/Perception/PerceptionSystems.cpp
+	DEM/Game/src/Animation/AnimationSystems.cpp
 	DEM/Game/src/Animation/TimelineTask.cpp
 	DEM/Game/src/App/AppFSM.cpp
 	DEM/Game/src/App/AppStateVideo.cpp
@@ -5,6 +5,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Animation/AnimationClip.h
 	DEM/Low/src/Animation/AnimationController.h
 	DEM/Low/src/Animation/AnimationLoaderANM.h
+	DEM/Low/src/Animation/AnimationPoseCache.h
 	DEM/Low/src/Animation/AnimationSampler.h
 	DEM/Low/src/Animation/Inertialization.h
 	DEM/Low/src/Animation/MappedPoseOutput.h
@@ -21,6 +22,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Animation/Graph/ClipPlayerNode.h
 	DEM/Low/src/Animation/Graph/FloatSelectorNode.h
 	DEM/Low/src/Animation/Graph/IntSelectorNode.h
+	DEM/Low/src/Animation/Graph/LayeredBlendNode.h
 	DEM/Low/src/Animation/Graph/SelectorNodeBase.h
 	DEM/Low/src/Animation/Graph/SpeedModifierNode.h
 	DEM/Low/src/Animation/Graph/StringSelectorNode.h
@@ -168,6 +170,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/IO/Streams/FileStream.h
 	DEM/Low/src/IO/Streams/MemStream.h
 	DEM/Low/src/IO/Streams/ScopedStream.h
+	DEM/Low/src/IO/Streams/VectorStream.h
 	DEM/Low/src/Jobs/JobSystem.h
 	DEM/Low/src/Jobs/Worker.h
 	DEM/Low/src/Jobs/WorkStealingQueue.h
@@ -187,6 +190,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Math/Polar.h
 	DEM/Low/src/Math/Quaternion.h
 	DEM/Low/src/Math/SIMDMath.h
+	DEM/Low/src/Math/SpatialHash.h
 	DEM/Low/src/Math/Sphere.h
 	DEM/Low/src/Math/TransformSRT.h
 	DEM/Low/src/Math/Triangle.h
@@ -196,6 +200,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Math/Vector4.h
 	DEM/Low/src/Math/WELL512.h
 	DEM/Low/src/Physics/BulletConv.h
+	DEM/Low/src/Physics/BulletTaskScheduler.h
 	DEM/Low/src/Physics/CollisionAttribute.h
 	DEM/Low/src/Physics/CollisionLoaderCDLOD.h
 	DEM/Low/src/Physics/CollisionLoaderHRD.h
@@ -219,6 +224,8 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Render/DisplayDriver.h
 	DEM/Low/src/Render/DisplayMode.h
 	DEM/Low/src/Render/Effect.h
+	DEM/Low/src/Render/FrameRingAllocator.h
+	DEM/Low/src/Render/GPUCommandList.h
 	DEM/Low/src/Render/GPUDriver.h
 	DEM/Low/src/Render/GPUFence.h
 	DEM/Low/src/Render/ImageBasedLight.h
@@ -295,6 +302,10 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Render/D3D9/D3D9VertexLayout.h
 	DEM/Low/src/Render/D3D9/DEMD3D9.h
 	DEM/Low/src/Render/D3D9/SM30ShaderMetadata.h
+	DEM/Low/src/Render/Null/NullDriverFactory.h
+	DEM/Low/src/Render/Null/NullGPUDriver.h
+	DEM/Low/src/Render/Null/NullResources.h
+	DEM/Low/src/Render/Null/NullShaderMetadata.h
 	DEM/Low/src/Resources/DataAssetLoader.h
 	DEM/Low/src/Resources/Resource.h
 	DEM/Low/src/Resources/ResourceCreator.h
@@ -310,6 +321,7 @@ set(DEM_L1_LOW_HEADERS
 	DEM/Low/src/Scripting/SolLow.h
 	DEM/Low/src/System/Memory.h
 	DEM/Low/src/System/OSFileSystem.h
+	DEM/Low/src/System/OSFileSystemStd.h
 	DEM/Low/src/System/OSWindow.h
 	DEM/Low/src/System/Platform.h
 	DEM/Low/src/System/System.h
@@ -354,6 +366,7 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Animation/AnimationClip.cpp
 	DEM/Low/src/Animation/AnimationController.cpp
 	DEM/Low/src/Animation/AnimationLoaderANM.cpp
+	DEM/Low/src/Animation/AnimationPoseCache.cpp
 	DEM/Low/src/Animation/AnimationSampler.cpp
 	DEM/Low/src/Animation/Inertialization.cpp
 	DEM/Low/src/Animation/PoseBuffer.cpp
@@ -367,6 +380,7 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Animation/Graph/ClipPlayerNode.cpp
 	DEM/Low/src/Animation/Graph/FloatSelectorNode.cpp
 	DEM/Low/src/Animation/Graph/IntSelectorNode.cpp
+	DEM/Low/src/Animation/Graph/LayeredBlendNode.cpp
 	DEM/Low/src/Animation/Graph/SelectorNodeBase.cpp
 	DEM/Low/src/Animation/Graph/SpeedModifierNode.cpp
 	DEM/Low/src/Animation/Graph/StringSelectorNode.cpp
@@ -454,6 +468,7 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/IO/Streams/FileStream.cpp
 	DEM/Low/src/IO/Streams/MemStream.cpp
 	DEM/Low/src/IO/Streams/ScopedStream.cpp
+	DEM/Low/src/IO/Streams/VectorStream.cpp
 	DEM/Low/src/Jobs/JobSystem.cpp
 	DEM/Low/src/Jobs/Worker.cpp
 	DEM/Low/src/Math/AABB.cpp
@@ -465,6 +480,7 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Math/Vector2.cpp
 	DEM/Low/src/Math/Vector3.cpp
 	DEM/Low/src/Math/Vector4.cpp
+	DEM/Low/src/Physics/BulletTaskScheduler.cpp
 	DEM/Low/src/Physics/CollisionAttribute.cpp
 	DEM/Low/src/Physics/CollisionLoaderCDLOD.cpp
 	DEM/Low/src/Physics/CollisionLoaderHRD.cpp
@@ -480,6 +496,8 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Physics/StaticMeshShape.cpp
 	DEM/Low/src/Render/CDLODDataLoader.cpp
 	DEM/Low/src/Render/Effect.cpp
+	DEM/Low/src/Render/FrameRingAllocator.cpp
+	DEM/Low/src/Render/GPUCommandList.cpp
 	DEM/Low/src/Render/GPUDriver.cpp
 	DEM/Low/src/Render/ImageBasedLight.cpp
 	DEM/Low/src/Render/ImageUtils.cpp
@@ -541,6 +559,10 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Render/D3D9/D3D9VertexBuffer.cpp
 	DEM/Low/src/Render/D3D9/D3D9VertexLayout.cpp
 	DEM/Low/src/Render/D3D9/SM30ShaderMetadata.cpp
+	DEM/Low/src/Render/Null/NullDriverFactory.cpp
+	DEM/Low/src/Render/Null/NullGPUDriver.cpp
+	DEM/Low/src/Render/Null/NullResources.cpp
+	DEM/Low/src/Render/Null/NullShaderMetadata.cpp
 	DEM/Low/src/Resources/Resource.cpp
 	DEM/Low/src/Resources/ResourceManager.cpp
 	DEM/Low/src/Scene/LODGroup.cpp
@@ -551,7 +573,9 @@ set(DEM_L1_LOW_SOURCES
 	DEM/Low/src/Scripting/ScriptAssetLoader.cpp
 	DEM/Low/src/Scripting/SolLow.cpp
 	DEM/Low/src/System/Memory.cpp
+	DEM/Low/src/System/OSFileSystemStd.cpp
 	DEM/Low/src/System/System.cpp
+	DEM/Low/src/System/SystemStd.cpp
 	DEM/Low/src/System/Win32/KeyboardWin32.cpp
 	DEM/Low/src/System/Win32/MouseWin32.cpp
 	DEM/Low/src/System/Win32/OSFileSystemWin32.cpp
@@ -0,0 +1,322 @@
+#include <AI/Behaviour/BehaviourTreeAsset.h>
+#include <AI/Behaviour/BehaviourTreeComponent.h>
+#include <AI/Behaviour/Nodes/BehaviourTreeCondition.h>
+#include <AI/Behaviour/Nodes/BehaviourTreeSelector.h>
+#include <AI/Behaviour/Nodes/BehaviourTreeSequence.h>
+#include <AI/Behaviour/Nodes/BehaviourTreeWaitTime.h>
+#include <AI/AIStateComponent.h>
+#include <AI/CommandStackComponent.h>
+#include <Game/GameSession.h>
+#include <Game/ECS/GameWorld.h>
+#include <Scripting/LogicRegistry.h>
+#include <Resources/ResourceManager.h>
+#include <IO/IOServer.h>
+#include <Data/HRDParser.h>
+#include <Data/SerializeToParams.h>
+#include <Core/Factory.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// CPU-side behaviour tree benchmark. Creates a few thousand actors playing the same tree built only from
+// builtin nodes, which are compiled into opcodes, and ticks them for a number of frames. Blackboard keys
+// are changed for a slice of actors each frame, so that conditions request re-evaluation like in a game.
+//
+// Usage: DEMBehaviourBench [options]
+//   -actors <N>     actor count (default 4096)
+//   -frames <N>     measured frame count (default 1000)
+//   -warmup <N>     frames updated before measuring (default 10)
+//   -period <N>     each actor changes its blackboard once in N frames, 0 to disable (default 64)
+//   -all            update all trees each frame, not only ones scheduled by UpdateBehaviourTrees
+
+namespace DEM::Jobs
+{
+	class CWorker;
+}
+
+namespace DEM::AI
+{
+// Systems are declared by their users, see BehaviourSystems.cpp
+void UpdateBehaviourTrees(Game::CGameWorld& World, float dt, Jobs::CWorker* pWorker);
+
+struct CBenchArgs
+{
+	U32  ActorCount = 4096;
+	U32  FrameCount = 1000;
+	U32  WarmupCount = 10;
+	U32  AlertPeriod = 64;
+	bool UpdateAll = false;
+};
+
+// Alert branch overrides the idle branch when the "Alert" blackboard key changes
+static const char* pTreeDesc = R"(
+Root
+{
+	ClassName = 'DEM::AI::CBehaviourTreeSelector'
+	Children
+	[
+		{
+			ClassName = 'DEM::AI::CBehaviourTreeCondition'
+			Params { Condition { Type = 'VarCmpConst' Params { Left = 'Alert' Op = '==' Right = 1 } } }
+			Children
+			[
+				{
+					ClassName = 'DEM::AI::CBehaviourTreeSequence'
+					Children
+					[
+						{ ClassName = 'DEM::AI::CBehaviourTreeWaitTime' Params { Time = 0.3 } },
+						{ ClassName = 'DEM::AI::CBehaviourTreeWaitTime' Params { Time = 0.2 } }
+					]
+				}
+			]
+		},
+		{
+			ClassName = 'DEM::AI::CBehaviourTreeSequence'
+			Children
+			[
+				{
+					ClassName = 'DEM::AI::CBehaviourTreeCondition'
+					Params { OverrideLowerPriority = false Condition { Type = 'VarCmpConst' Params { Left = 'Alert' Op = '==' Right = 0 } } }
+				},
+				{ ClassName = 'DEM::AI::CBehaviourTreeWaitTime' Params { Time = 1.0 } },
+				{
+					ClassName = 'DEM::AI::CBehaviourTreeSelector'
+					Children
+					[
+						{ ClassName = 'DEM::AI::CBehaviourTreeWaitTime' Params { Time = 0.5 } }
+					]
+				},
+				{ ClassName = 'DEM::AI::CBehaviourTreeWaitTime' Params { Time = 2.0 } }
+			]
+		}
+	]
+}
+)";
+
+static bool ParseArgs(int argc, const char** argv, CBenchArgs& Out)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* pArg = argv[i];
+		const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (!std::strcmp(pArg, "-all")) Out.UpdateAll = true;
+		else if (!pValue)
+		{
+			std::fprintf(stderr, "Missing value for %s\n", pArg);
+			FAIL;
+		}
+		else
+		{
+			if (!std::strcmp(pArg, "-actors")) Out.ActorCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-frames")) Out.FrameCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-warmup")) Out.WarmupCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-period")) Out.AlertPeriod = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else
+			{
+				std::fprintf(stderr, "Unknown argument %s\n", pArg);
+				std::fprintf(stderr, "Usage: DEMBehaviourBench [-actors <N>] [-frames <N>] [-warmup <N>] [-period <N>] [-all]\n");
+				FAIL;
+			}
+			++i;
+		}
+	}
+
+	if (!Out.ActorCount || !Out.FrameCount)
+	{
+		std::fprintf(stderr, "Actor and frame counts must be positive\n");
+		FAIL;
+	}
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Mirrors DFSUnwrapAndPrepareNodes from CBehaviourTreeAssetLoader
+static bool DFSUnwrapAndPrepareNodes(const Data::CData& CurrNodeData, std::vector<CBehaviourTreeAsset::CNodeInfo>& NodeInfo, U16 DepthLevel, U16 ParentIndex)
+{
+	const auto Index = static_cast<U16>(NodeInfo.size());
+
+	{
+		auto& CurrNodeInfo = NodeInfo.emplace_back();
+		DEM::ParamsFormat::Deserialize(CurrNodeData, CurrNodeInfo);
+
+		CurrNodeInfo.pRTTI = DEM::Core::CFactory::Instance().GetRTTI(CurrNodeInfo.ClassName.CStr());
+		if (!CurrNodeInfo.pRTTI || !CurrNodeInfo.pRTTI->IsDerivedFrom(CBehaviourTreeNodeBase::RTTI))
+		{
+			std::fprintf(stderr, "Behaviour tree node class %s is not found\n", CurrNodeInfo.ClassName.CStr());
+			FAIL;
+		}
+
+		CurrNodeInfo.DepthLevel = DepthLevel;
+		CurrNodeInfo.ParentIndex = ParentIndex;
+		CurrNodeInfo.Index = Index;
+
+		if (auto* pParams = CurrNodeData.As<Data::PParams>())
+		{
+			Data::PDataArray ChildrenDesc;
+			if ((*pParams)->TryGet(ChildrenDesc, CStrID("Children")))
+				for (const auto& ChildDesc : *ChildrenDesc)
+					if (!DFSUnwrapAndPrepareNodes(ChildDesc, NodeInfo, DepthLevel + 1, Index))
+						FAIL;
+		}
+	}
+
+	NodeInfo[Index].SkipSubtreeIndex = static_cast<U16>(NodeInfo.size());
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+static PBehaviourTreeAsset CreateTreeAsset()
+{
+	CBehaviourTreeSelector::ForceFactoryRegistration();
+	CBehaviourTreeSequence::ForceFactoryRegistration();
+	CBehaviourTreeCondition::ForceFactoryRegistration();
+	CBehaviourTreeWaitTime::ForceFactoryRegistration();
+
+	Data::CParams Desc;
+	Data::CHRDParser Parser;
+	std::string Errors;
+	if (!Parser.ParseBuffer(pTreeDesc, std::strlen(pTreeDesc), Desc, &Errors))
+	{
+		std::fprintf(stderr, "Can't parse the tree description:\n%s", Errors.c_str());
+		return nullptr;
+	}
+
+	auto* pRootDesc = Desc.Find(CStrID("Root"));
+	if (!pRootDesc) return nullptr;
+
+	std::vector<CBehaviourTreeAsset::CNodeInfo> NodeInfo;
+	if (!DFSUnwrapAndPrepareNodes(pRootDesc->GetRawValue(), NodeInfo, 0, 0) || NodeInfo.empty()) return nullptr;
+
+	return n_new(CBehaviourTreeAsset(std::move(NodeInfo)));
+}
+//---------------------------------------------------------------------
+
+static void PrintResults(const CBenchArgs& Args, const CBehaviourTreeAsset& Asset, std::vector<double>& FrameMs)
+{
+	U32 CompiledNodes = 0;
+	for (U16 i = 0; i < Asset.GetNodeCount(); ++i)
+		if (Asset.GetNode(i)->Opcode != EBTOpcode::Call)
+			++CompiledNodes;
+
+	double TotalMs = 0.0;
+	for (const double Ms : FrameMs)
+		TotalMs += Ms;
+
+	std::sort(FrameMs.begin(), FrameMs.end());
+
+	const double Count = static_cast<double>(FrameMs.size());
+	const auto Percentile = [&FrameMs](double P) { return FrameMs[std::min(FrameMs.size() - 1, static_cast<size_t>(P * FrameMs.size()))]; };
+
+	std::printf("Actors:        %u, %s\n", Args.ActorCount, Args.UpdateAll ? "all trees updated each frame" : "scheduled by UpdateBehaviourTrees");
+	std::printf("Tree:          %u nodes, %u compiled into opcodes, depth %u, %u instance bytes\n",
+		static_cast<U32>(Asset.GetNodeCount()), CompiledNodes, static_cast<U32>(Asset.GetMaxDepth()), static_cast<U32>(Asset.GetMaxInstanceBytes()));
+	std::printf("Frames:        %u (+%u warmup), blackboard change period %u\n", static_cast<U32>(FrameMs.size()), Args.WarmupCount, Args.AlertPeriod);
+	std::printf("Frame ms:      avg %.3f, min %.3f, median %.3f, p95 %.3f, max %.3f\n",
+		TotalMs / Count, FrameMs.front(), Percentile(0.5), Percentile(0.95), FrameMs.back());
+	std::printf("Per actor:     %.1f ns\n", TotalMs * 1000000.0 / (Count * Args.ActorCount));
+}
+//---------------------------------------------------------------------
+
+static int RunBenchmark(const CBenchArgs& Args)
+{
+	PBehaviourTreeAsset Asset = CreateTreeAsset();
+	if (!Asset)
+	{
+		std::fprintf(stderr, "Can't create a behaviour tree asset\n");
+		return 1;
+	}
+
+	IO::CIOServer IOServer;
+	Resources::CResourceManager ResMgr(&IOServer);
+
+	Game::PGameSession Session = n_new(Game::CGameSession(ResMgr));
+	Session->RegisterFeature<Game::CLogicRegistry>(CStrID("Logic"), *Session);
+	auto* pWorld = Session->RegisterFeature<Game::CGameWorld>(CStrID("World"), ResMgr);
+	pWorld->RegisterComponent<CAIStateComponent>(CStrID("AIState"), Args.ActorCount);
+	pWorld->RegisterComponent<CCommandStackComponent>(CStrID("CommandStack"), Args.ActorCount);
+	pWorld->RegisterComponent<CBehaviourTreeComponent>(CStrID("BehaviourTree"), Args.ActorCount);
+
+	const CStrID LevelID("Bench");
+	const CStrID sidAlert("Alert");
+	std::vector<Game::HEntity> Actors(Args.ActorCount);
+	for (auto& ActorID : Actors)
+	{
+		ActorID = pWorld->CreateEntity(LevelID);
+		pWorld->AddComponent<CAIStateComponent>(ActorID)->Blackboard.Set(sidAlert, 0);
+		pWorld->AddComponent<CCommandStackComponent>(ActorID);
+		pWorld->AddComponent<CBehaviourTreeComponent>(ActorID);
+	}
+
+	// Components are added first, players subscribe to blackboards and must not move after starting
+	pWorld->ForEachComponent<CBehaviourTreeComponent>([&Asset, &Session](auto EntityID, CBehaviourTreeComponent& Component)
+	{
+		Component.Player.SetAsset(Asset);
+		Component.Player.Start(*Session, EntityID);
+	});
+
+	constexpr float dt = 1.f / 60.f;
+
+	std::vector<double> FrameMs;
+	FrameMs.reserve(Args.FrameCount);
+
+	const U32 TotalFrames = Args.WarmupCount + Args.FrameCount;
+	for (U32 i = 0; i < TotalFrames; ++i)
+	{
+		// Toggle an alert for a slice of actors, outside of measurements
+		if (Args.AlertPeriod)
+		{
+			for (size_t ActorIdx = i % Args.AlertPeriod; ActorIdx < Actors.size(); ActorIdx += Args.AlertPeriod)
+			{
+				auto& Blackboard = pWorld->FindComponent<CAIStateComponent>(Actors[ActorIdx])->Blackboard;
+				const auto Handle = Blackboard.GetStorage().Find(sidAlert);
+				Blackboard.Set(sidAlert, 1 - Blackboard.GetStorage().Get<int>(Handle, 0));
+			}
+		}
+
+		const auto Start = std::chrono::steady_clock::now();
+
+		if (Args.UpdateAll)
+		{
+			pWorld->ForEachComponent<CBehaviourTreeComponent>([dt](auto, CBehaviourTreeComponent& Component)
+			{
+				Component.Player.Update(dt);
+			});
+		}
+		else
+		{
+			UpdateBehaviourTrees(*pWorld, dt, nullptr);
+		}
+
+		const auto End = std::chrono::steady_clock::now();
+
+		if (i >= Args.WarmupCount)
+			FrameMs.push_back(std::chrono::duration<double, std::milli>(End - Start).count());
+	}
+
+	PrintResults(Args, *Asset, FrameMs);
+
+	// Players access the world when stopped, stop them while it is alive
+	pWorld->ForEachComponent<CBehaviourTreeComponent>([](auto, CBehaviourTreeComponent& Component)
+	{
+		Component.Player.Stop();
+	});
+
+	return 0;
+}
+//---------------------------------------------------------------------
+
+}
+
+int main(int argc, const char** argv)
+{
+	DEM::AI::CBenchArgs Args;
+	if (!DEM::AI::ParseArgs(argc, argv, Args)) return 1;
+
+	return DEM::AI::RunBenchmark(Args);
+}
@@ -20,6 +20,33 @@ void CAILevel::AddStimulusEvent(const CStimulusEvent& Event)
 }
 //---------------------------------------------------------------------
 
+void CAILevel::BuildVisibleObjectHash(float MaxSenseRange)
+{
+	// Cells as big as the longest sense range let each sensor query at most 3x3 cells
+	_VisibleObjectHash.Build(static_cast<U32>(_VisibleObjects.size()), std::max(MaxSenseRange, 1.f), [this](U32 Index, float& x, float& z)
+	{
+		x = rtm::vector_get_x(_VisibleObjects[Index].Position);
+		z = rtm::vector_get_z(_VisibleObjects[Index].Position);
+	});
+}
+//---------------------------------------------------------------------
+
+// Returns the index of the first sensor to process this frame. Sensors from it to it + MaxSensorsPerFrame are processed,
+// wrapping around the end of the list. Sensors are expected to be enumerated in the same order each frame.
+UPTR CAILevel::TimeSliceVisionSensors(UPTR SensorCount, UPTR MaxSensorsPerFrame)
+{
+	if (!SensorCount || !MaxSensorsPerFrame || MaxSensorsPerFrame >= SensorCount)
+	{
+		_NextVisionSensor = 0;
+		return 0;
+	}
+
+	const UPTR First = _NextVisionSensor % SensorCount;
+	_NextVisionSensor = (First + MaxSensorsPerFrame) % SensorCount;
+	return First;
+}
+//---------------------------------------------------------------------
+
 void CAILevel::RenderDebug(Debug::CDebugDraw& DebugDraw)
 {
 	NOT_IMPLEMENTED;
@@ -1,10 +1,12 @@
 #pragma once
 #include <Core/Object.h>
 #include <AI/Perception/Perception.h>
+#include <Math/SpatialHash.h>
 
 // AI level is an abstract space, like scene or CPhysicsLevel, that contains stimuli,
 // AI hints and other AI-related world info. Also AILevel is intended to serve as a
 // navigation manager in the future.
+// Visible objects are collected once per frame into a spatial hash that serves as a broadphase for vision sensors.
 
 namespace Debug
 {
@@ -17,10 +19,23 @@ using PAILevel = Ptr<class CAILevel>;
 
 class CAILevel : public DEM::Core::CObject
 {
+public:
+
+	struct CVisibleObject
+	{
+		rtm::vector4f Position; // A point at which line of sight is tested
+		Game::HEntity ID;
+		float         Visibility;
+	};
+
 protected:
 
 	std::vector<CStimulusEvent> _StimulusEvents; // pending for processing in the next AI frame
 
+	std::vector<CVisibleObject> _VisibleObjects; // Indexed by _VisibleObjectHash
+	Math::CSpatialHash2D        _VisibleObjectHash;
+	UPTR                        _NextVisionSensor = 0; // Round-robin cursor for time-sliced vision sensors
+
 public:
 
 	//!!!global, not per level!
@@ -40,6 +55,20 @@ public:
 		_StimulusEvents.clear();
 	}
 
+	void  ClearVisibleObjects() { _VisibleObjects.clear(); }
+	void  AddVisibleObject(Game::HEntity ID, const rtm::vector4f& Position, float Visibility) { _VisibleObjects.push_back({ Position, ID, Visibility }); }
+	void  BuildVisibleObjectHash(float MaxSenseRange);
+	UPTR  GetVisibleObjectCount() const { return _VisibleObjects.size(); }
+	const CVisibleObject& GetVisibleObject(U32 Index) const { return _VisibleObjects[Index]; }
+	UPTR  TimeSliceVisionSensors(UPTR SensorCount, UPTR MaxSensorsPerFrame);
+
+	// Range must not exceed MaxSenseRange passed to BuildVisibleObjectHash. Callback receives object indices.
+	template<typename F>
+	void ForEachVisibleObjectInRange(const rtm::vector4f& Position, float Range, F Callback) const
+	{
+		_VisibleObjectHash.ForEachInRange(rtm::vector_get_x(Position), rtm::vector_get_z(Position), Range, std::move(Callback));
+	}
+
 	void  RenderDebug(Debug::CDebugDraw& DebugDraw);
 };
 //---------------------------------------------------------------------
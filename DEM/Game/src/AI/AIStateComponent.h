@@ -1,5 +1,5 @@
 #pragma once
-#include <AI/Perception/Perception.h>
+#include <AI/Perception/FactMemory.h>
 #include <AI/Blackboard.h>
 #include <Data/Metadata.h>
 
@@ -12,8 +12,7 @@ struct CAIStateComponent
 {
 	CBlackboard                  Blackboard;
 	std::vector<CSensedStimulus> NewStimuli;
-	std::vector<CSensedStimulus> Facts;
-	size_t                       FactWithSourceCount = 0;
+	CFactMemory                  Facts;
 };
 
 }
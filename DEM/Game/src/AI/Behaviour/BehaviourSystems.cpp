@@ -2,9 +2,17 @@
 #include <Game/ECS/GameWorld.h>
 #include <AI/Behaviour/BehaviourTreeComponent.h>
 #include <AI/Behaviour/BehaviourTreeAsset.h>
+#include <Jobs/Worker.h>
+
+// Behaviour trees are updated only when something can change their outcome: an evaluation was requested by an event
+// or a blackboard change, or an active node needs an update, e.g. its timer is expired. Idle trees are re-evaluated
+// a few per frame in round-robin to catch changes that aren't signalled. Trees consisting of nodes that touch only
+// their actor are updated in parallel jobs, the rest are updated after them on the calling thread.
 
 namespace DEM::AI
 {
+constexpr size_t TREES_PER_JOB = 8;
+constexpr size_t MAX_IDLE_TREE_UPDATES_PER_FRAME = 16;
 
 void InitCharacterAIThinking(Game::CGameWorld& World, Game::CGameSession& Session, Resources::CResourceManager& ResMgr)
 {
@@ -22,13 +30,80 @@ void InitCharacterAIThinking(Game::CGameWorld& World, Game::CGameSession& Sessio
 }
 //---------------------------------------------------------------------
 
-void UpdateBehaviourTrees(DEM::Game::CGameWorld& World, float dt)
+void UpdateBehaviourTrees(DEM::Game::CGameWorld& World, float dt, Jobs::CWorker* pWorker)
 {
-	World.ForEachComponent<CBehaviourTreeComponent>([dt](auto EntityID, CBehaviourTreeComponent& Component)
+	ZoneScoped;
+
+	//!!!DBG TMP! Need reusable buffers and a round-robin cursor in an AI system!
+	static std::vector<CBehaviourTreePlayer*> ParallelTrees;
+	static std::vector<CBehaviourTreePlayer*> SerialTrees;
+	static std::vector<CBehaviourTreePlayer*> IdleTrees;
+	static size_t NextIdleTree = 0;
+
+	ParallelTrees.clear();
+	SerialTrees.clear();
+	IdleTrees.clear();
+
+	auto ScheduleTree = [](CBehaviourTreePlayer& Player)
+	{
+		if (Player.GetAsset()->CanUpdateInParallel())
+			ParallelTrees.push_back(&Player);
+		else
+			SerialTrees.push_back(&Player);
+	};
+
+	World.ForEachComponent<CBehaviourTreeComponent>([dt, &ScheduleTree](auto EntityID, CBehaviourTreeComponent& Component)
 	{
-		if (Component.Player.IsPlaying())
-			Component.Player.Update(dt);
+		auto& Player = Component.Player;
+		if (!Player.IsPlaying()) return;
+
+		if (Player.NeedsUpdate(dt))
+			ScheduleTree(Player);
+		else
+			IdleTrees.push_back(&Player);
 	});
+
+	// Give budget slots to idle trees
+	const size_t IdleUpdateCount = std::min(IdleTrees.size(), MAX_IDLE_TREE_UPDATES_PER_FRAME);
+	if (IdleUpdateCount)
+	{
+		NextIdleTree %= IdleTrees.size();
+		for (size_t i = 0; i < IdleUpdateCount; ++i)
+		{
+			auto*& pPlayer = IdleTrees[(NextIdleTree + i) % IdleTrees.size()];
+			ScheduleTree(*pPlayer);
+			pPlayer = nullptr;
+		}
+		NextIdleTree += IdleUpdateCount;
+	}
+
+	for (auto* pPlayer : IdleTrees)
+		if (pPlayer) pPlayer->SkipUpdate(dt);
+
+	if (pWorker && ParallelTrees.size() > TREES_PER_JOB)
+	{
+		ZoneScopedN("Parallel trees");
+
+		Jobs::CJobCounter Counter;
+		for (size_t i = 0; i < ParallelTrees.size(); i += TREES_PER_JOB)
+		{
+			const size_t End = std::min(i + TREES_PER_JOB, ParallelTrees.size());
+			pWorker->AddJob(Counter, [i, End, dt]()
+			{
+				for (size_t j = i; j < End; ++j)
+					ParallelTrees[j]->Update(dt);
+			});
+		}
+		pWorker->WaitActive(Counter);
+	}
+	else
+	{
+		for (auto* pPlayer : ParallelTrees)
+			pPlayer->Update(dt);
+	}
+
+	for (auto* pPlayer : SerialTrees)
+		pPlayer->Update(dt);
 }
 //---------------------------------------------------------------------
 
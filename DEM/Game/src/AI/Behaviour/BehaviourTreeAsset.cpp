@@ -54,6 +54,7 @@ CBehaviourTreeAsset::CBehaviourTreeAsset(std::vector<CNodeInfo>&& NodeInfo)
 		auto* pRTTI = CurrNodeInfo.pRTTI;
 		auto* pNodeImpl = static_cast<CBehaviourTreeNodeBase*>(pRTTI->CreateInstance(pAddr));
 		pNodeImpl->Init(CurrNodeInfo.Params.Get());
+		_CanUpdateInParallel &= pNodeImpl->CanUpdateInParallel();
 
 		pAddr += pRTTI->GetInstanceSize();
 
@@ -62,6 +63,14 @@ CBehaviourTreeAsset::CBehaviourTreeAsset(std::vector<CNodeInfo>&& NodeInfo)
 		CurrNode.SkipSubtreeIndex = CurrNodeInfo.SkipSubtreeIndex;
 		CurrNode.ParentIndex = CurrNodeInfo.ParentIndex;
 		CurrNode.DepthLevel = CurrNodeInfo.DepthLevel;
+
+		// Cache everything the player needs in a traversal, so that it doesn't call virtual methods of builtin nodes
+		n_assert(pNodeImpl->GetInstanceDataSize() <= std::numeric_limits<U16>().max() && pNodeImpl->GetInstanceDataAlignment() <= std::numeric_limits<U8>().max());
+		CurrNode.InstanceDataSize = static_cast<U16>(pNodeImpl->GetInstanceDataSize());
+		CurrNode.InstanceDataAlignment = static_cast<U8>(pNodeImpl->GetInstanceDataAlignment());
+		CurrNode.CanOverrideLowerPriorityNodes = pNodeImpl->CanOverrideLowerPriorityNodes();
+		CurrNode.Param.pCondition = nullptr;
+		CurrNode.Opcode = pNodeImpl->Compile(CurrNode.Param);
 	}
 
 	// Calculate per-instance node data memory requirements. This will be used by BT players.
@@ -80,11 +89,11 @@ CBehaviourTreeAsset::CBehaviourTreeAsset(std::vector<CNodeInfo>&& NodeInfo)
 
 			// Now add current node requirements
 			const auto& Node = _Nodes[CurrIndex];
-			if (const auto DataSize = Node.pNodeImpl->GetInstanceDataSize())
+			if (const size_t DataSize = Node.InstanceDataSize)
 			{
-				n_assert_dbg(Node.pNodeImpl->GetInstanceDataAlignment());
+				n_assert_dbg(Node.InstanceDataAlignment);
 				const size_t AlignedSize = Math::CeilToMultiple(DataSize, MinInstanceAlignment);
-				const size_t MaxPadding = (Node.pNodeImpl->GetInstanceDataAlignment() / MinInstanceAlignment - 1) * MinInstanceAlignment;
+				const size_t MaxPadding = (Node.InstanceDataAlignment / MinInstanceAlignment - 1) * MinInstanceAlignment;
 				TotalSize += AlignedSize + MaxPadding;
 				if (_MaxInstanceBytes < TotalSize)
 					_MaxInstanceBytes = TotalSize;
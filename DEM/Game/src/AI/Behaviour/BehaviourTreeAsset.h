@@ -4,11 +4,14 @@
 #include <Data/Metadata.h>
 #include <Core/Object.h>
 
-// Reusable behaviour tree asset
+// Reusable behaviour tree asset.
+// Nodes are stored as a flat array in depth-first order. Common composite and timer nodes are compiled into
+// opcodes with inline parameters and are executed by the player in a switch, only other nodes are called virtually.
 
 namespace DEM::Game
 {
 	class CGameSession;
+	struct CConditionData;
 }
 
 namespace DEM::AI
@@ -25,6 +28,22 @@ enum class EBTStatus : U8
 	Failed
 };
 
+// Node types executed by CBehaviourTreePlayer without calling a node implementation
+enum class EBTOpcode : U8
+{
+	Call,      // Any node, its virtual methods are called
+	Selector,
+	Sequence,
+	Condition, // A decorator that evaluates CBTInlineParam::pCondition when traversed
+	WaitTime   // Waits for CBTInlineParam::Time seconds
+};
+
+union CBTInlineParam
+{
+	float                       Time;
+	const Game::CConditionData* pCondition;
+};
+
 EBTStatus CommandStatusToBTStatus(ECommandStatus Status);
 
 struct CBehaviourTreeContext
@@ -47,6 +66,16 @@ public:
 	virtual void                      OnTreeStarted(U16 SelfIdx, CBehaviourTreePlayer& Player) const {}
 	virtual bool                      CanOverrideLowerPriorityNodes() const { return true; }
 
+	// A node that can be executed by the player itself returns its opcode and fills inline parameters.
+	// Inline parameters must stay valid while the asset exists.
+	virtual EBTOpcode                 Compile(CBTInlineParam& OutParam) const { return EBTOpcode::Call; }
+
+	// True if the node accesses only components of its actor and reads shared data, so that trees can be updated in parallel jobs
+	virtual bool                      CanUpdateInParallel() const { return false; }
+
+	// Time after which an active node needs Update. A tree is not updated until the time comes or an evaluation is requested.
+	virtual float                     GetUpdateDelay(const std::byte* pData) const { return 0.f; }
+
 	virtual std::pair<EBTStatus, U16> TraverseFromParent(U16 SelfIdx, U16 SkipIdx, const CBehaviourTreeContext& Ctx) const { return { EBTStatus::Running, SelfIdx }; }
 	virtual std::pair<EBTStatus, U16> TraverseFromChild(U16 SelfIdx, U16 SkipIdx, U16 NextIdx, EBTStatus ChildStatus, const CBehaviourTreeContext& Ctx) const { return { ChildStatus, NextIdx }; }
 	virtual EBTStatus                 Activate(std::byte* pData, const CBehaviourTreeContext& Ctx) const { return EBTStatus::Running; }
@@ -76,9 +105,14 @@ public:
 	struct CNode
 	{
 		CBehaviourTreeNodeBase* pNodeImpl;
+		CBTInlineParam          Param;
 		U16                     SkipSubtreeIndex;
 		U16                     ParentIndex;
 		U16                     DepthLevel; // 0 for the root
+		U16                     InstanceDataSize;
+		U8                      InstanceDataAlignment;
+		EBTOpcode               Opcode;
+		bool                    CanOverrideLowerPriorityNodes;
 	};
 
 protected:
@@ -88,6 +122,7 @@ protected:
 
 	U16                           _MaxDepth = 0;
 	size_t                        _MaxInstanceBytes = 0;
+	bool                          _CanUpdateInParallel = true;
 
 public:
 
@@ -98,6 +133,7 @@ public:
 	const CNode* GetNode(U16 i) const { return &_Nodes[i]; }
 	U16          GetMaxDepth() const { return _MaxDepth; }
 	size_t       GetMaxInstanceBytes() const { return _MaxInstanceBytes; }
+	bool         CanUpdateInParallel() const { return _CanUpdateInParallel; }
 };
 
 using PBehaviourTreeAsset = Ptr<CBehaviourTreeAsset>;
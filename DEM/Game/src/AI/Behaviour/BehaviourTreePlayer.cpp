@@ -5,6 +5,7 @@
 #include <Game/ECS/GameWorld.h>
 #include <Game/GameSession.h>
 #include <Events/Connection.h> // for destruction
+#include <Scripting/Condition.h>
 #include <Math/Math.h>
 
 namespace DEM::AI
@@ -27,6 +28,110 @@ static inline size_t CalcBufferSize(const CBehaviourTreeAsset& Asset)
 }
 //---------------------------------------------------------------------
 
+// Interpreter of compiled nodes. Opcodes reproduce the behaviour of corresponding node classes, other nodes are called.
+static DEM_FORCE_INLINE std::pair<EBTStatus, U16> NodeTraverseFromParent(const CBehaviourTreeAsset::CNode& Node, U16 SelfIdx, const CBehaviourTreeContext& Ctx)
+{
+	switch (Node.Opcode)
+	{
+		case EBTOpcode::Selector:
+		case EBTOpcode::Sequence:
+			return { EBTStatus::Succeeded, SelfIdx + 1 };
+		case EBTOpcode::Condition:
+			if (Game::EvaluateCondition(*Node.Param.pCondition, Ctx.Session, &Ctx.pBrain->Blackboard.GetStorage()))
+				return { EBTStatus::Succeeded, SelfIdx + 1 };
+			else
+				return { EBTStatus::Failed, Node.SkipSubtreeIndex };
+		case EBTOpcode::WaitTime:
+			return { EBTStatus::Running, SelfIdx };
+		default:
+			return Node.pNodeImpl->TraverseFromParent(SelfIdx, Node.SkipSubtreeIndex, Ctx);
+	}
+}
+//---------------------------------------------------------------------
+
+static DEM_FORCE_INLINE std::pair<EBTStatus, U16> NodeTraverseFromChild(const CBehaviourTreeAsset::CNode& Node, U16 SelfIdx, U16 NextIdx, EBTStatus ChildStatus, const CBehaviourTreeContext& Ctx)
+{
+	switch (Node.Opcode)
+	{
+		case EBTOpcode::Selector:
+			return { ChildStatus, (ChildStatus == EBTStatus::Failed) ? NextIdx : Node.SkipSubtreeIndex };
+		case EBTOpcode::Sequence:
+			return { ChildStatus, (ChildStatus == EBTStatus::Succeeded) ? NextIdx : Node.SkipSubtreeIndex };
+		case EBTOpcode::Condition:
+		case EBTOpcode::WaitTime:
+			return { ChildStatus, NextIdx };
+		default:
+			return Node.pNodeImpl->TraverseFromChild(SelfIdx, Node.SkipSubtreeIndex, NextIdx, ChildStatus, Ctx);
+	}
+}
+//---------------------------------------------------------------------
+
+static DEM_FORCE_INLINE EBTStatus NodeActivate(const CBehaviourTreeAsset::CNode& Node, std::byte* pData, const CBehaviourTreeContext& Ctx)
+{
+	switch (Node.Opcode)
+	{
+		case EBTOpcode::Selector:
+		case EBTOpcode::Sequence:
+		case EBTOpcode::Condition:
+			return EBTStatus::Running;
+		case EBTOpcode::WaitTime:
+			n_assert_dbg(Node.Param.Time > 0.f);
+			new(pData) float(Node.Param.Time);
+			return (Node.Param.Time > 0.f) ? EBTStatus::Running : EBTStatus::Succeeded;
+		default:
+			return Node.pNodeImpl->Activate(pData, Ctx);
+	}
+}
+//---------------------------------------------------------------------
+
+static DEM_FORCE_INLINE void NodeDeactivate(const CBehaviourTreeAsset::CNode& Node, std::byte* pData, const CBehaviourTreeContext& Ctx)
+{
+	// Builtin nodes have trivially destructible data
+	if (Node.Opcode == EBTOpcode::Call)
+		Node.pNodeImpl->Deactivate(pData, Ctx);
+}
+//---------------------------------------------------------------------
+
+static DEM_FORCE_INLINE std::pair<EBTStatus, U16> NodeUpdate(const CBehaviourTreeAsset::CNode& Node, U16 SelfIdx, std::byte* pData, float dt, const CBehaviourTreeContext& Ctx)
+{
+	switch (Node.Opcode)
+	{
+		case EBTOpcode::Selector:
+		case EBTOpcode::Sequence:
+		case EBTOpcode::Condition:
+			return { EBTStatus::Running, SelfIdx };
+		case EBTOpcode::WaitTime:
+		{
+			float& RemainingTime = *reinterpret_cast<float*>(pData);
+			if (RemainingTime > dt)
+			{
+				RemainingTime -= dt;
+				return { EBTStatus::Running, SelfIdx };
+			}
+			return { EBTStatus::Succeeded, SelfIdx };
+		}
+		default:
+			return Node.pNodeImpl->Update(SelfIdx, pData, dt, Ctx);
+	}
+}
+//---------------------------------------------------------------------
+
+static DEM_FORCE_INLINE float NodeGetUpdateDelay(const CBehaviourTreeAsset::CNode& Node, const std::byte* pData)
+{
+	switch (Node.Opcode)
+	{
+		case EBTOpcode::Selector:
+		case EBTOpcode::Sequence:
+		case EBTOpcode::Condition:
+			return std::numeric_limits<float>::max();
+		case EBTOpcode::WaitTime:
+			return *reinterpret_cast<const float*>(pData);
+		default:
+			return Node.pNodeImpl->GetUpdateDelay(pData);
+	}
+}
+//---------------------------------------------------------------------
+
 CBehaviourTreePlayer::CBehaviourTreePlayer() = default;
 CBehaviourTreePlayer::CBehaviourTreePlayer(CBehaviourTreePlayer&&) noexcept = default;
 CBehaviourTreePlayer& CBehaviourTreePlayer::operator =(CBehaviourTreePlayer&& Other) noexcept = default;
@@ -85,6 +190,9 @@ bool CBehaviourTreePlayer::Start(Game::CGameSession& Session, Game::HEntity Acto
 
 	_pSession = &Session;
 	_ActorID = ActorID;
+	_SkippedTime = 0.f;
+	_UpdateDelay = 0.f;
+	_EvaluationRequested = true;
 
 	for (U16 i = 0; i < _Asset->GetNodeCount(); ++i)
 		_Asset->GetNode(i)->pNodeImpl->OnTreeStarted(i, *this);
@@ -133,14 +241,12 @@ EBTStatus CBehaviourTreePlayer::ActivateNode(U16 Index, CDataStackRecord& Instan
 	n_assert_dbg(pNode);
 	if (!pNode) return EBTStatus::Failed;
 
-	auto* pNodeImpl = pNode->pNodeImpl;
-
 	// Allocate bytes for node instance data
 	InstanceDataRecord.pPrevStackTop = _pInstanceDataBuffer;
-	if (const auto DataSize = pNodeImpl->GetInstanceDataSize())
+	if (const auto DataSize = pNode->InstanceDataSize)
 	{
 		//???FIXME: must also consider MinInstanceAlignment from asset loading? or now it is guaranteed to work correctly?
-		InstanceDataRecord.pNodeData = Math::NextAligned(_pInstanceDataBuffer, pNodeImpl->GetInstanceDataAlignment());
+		InstanceDataRecord.pNodeData = Math::NextAligned(_pInstanceDataBuffer, pNode->InstanceDataAlignment);
 		_pInstanceDataBuffer = InstanceDataRecord.pNodeData + DataSize;
 	}
 	else
@@ -148,7 +254,7 @@ EBTStatus CBehaviourTreePlayer::ActivateNode(U16 Index, CDataStackRecord& Instan
 		InstanceDataRecord.pNodeData = nullptr;
 	}
 
-	const auto Status = pNodeImpl->Activate(InstanceDataRecord.pNodeData, Ctx);
+	const auto Status = NodeActivate(*pNode, InstanceDataRecord.pNodeData, Ctx);
 
 	// On failure cancel effects of possible partial activation and free allocated bytes
 	if (Status == EBTStatus::Failed)
@@ -160,7 +266,7 @@ EBTStatus CBehaviourTreePlayer::ActivateNode(U16 Index, CDataStackRecord& Instan
 
 void CBehaviourTreePlayer::DeactivateNode(U16 Index, CDataStackRecord& InstanceDataRecord, const CBehaviourTreeContext& Ctx)
 {
-	_Asset->GetNode(Index)->pNodeImpl->Deactivate(InstanceDataRecord.pNodeData, Ctx);
+	NodeDeactivate(*_Asset->GetNode(Index), InstanceDataRecord.pNodeData, Ctx);
 
 	// Free bytes allocated for this instance
 	_pInstanceDataBuffer = InstanceDataRecord.pPrevStackTop;
@@ -195,6 +301,11 @@ EBTStatus CBehaviourTreePlayer::Update(float dt)
 	// Proceed to update only when we have all necessary components
 	CBehaviourTreeContext Ctx{ *_pSession, _ActorID, pBrain, pActuator };
 
+	// Nodes receive all the time passed since the previous update. Requests made during the update are for the next one.
+	dt += _SkippedTime;
+	_SkippedTime = 0.f;
+	_EvaluationRequested = false;
+
 	// Start from the root
 	_pNewStack[0] = 0;
 	EBTStatus Status = EBTStatus::Running;
@@ -212,7 +323,7 @@ EBTStatus CBehaviourTreePlayer::Update(float dt)
 		if (IsGoingDown && NewLevel < _ActiveDepth && CurrIdx == _pActiveStack[NewLevel])
 		{
 			// Update an already active node
-			std::tie(Status, NextIdx) = pNode->pNodeImpl->Update(CurrIdx, _pNodeInstanceData[NewLevel].pNodeData, dt, Ctx);
+			std::tie(Status, NextIdx) = NodeUpdate(*pNode, CurrIdx, _pNodeInstanceData[NewLevel].pNodeData, dt, Ctx);
 
 			// The most often case for the node is to request itself when explicit traversal change is not needed
 			if (NextIdx == CurrIdx)
@@ -227,9 +338,9 @@ EBTStatus CBehaviourTreePlayer::Update(float dt)
 			// Search for a new active path in the tree.
 			// NB: Status value makes sense only for upwards traversal, otherwise the node is considered Running.
 			if (IsGoingDown)
-				std::tie(Status, NextIdx) = pNode->pNodeImpl->TraverseFromParent(CurrIdx, pNode->SkipSubtreeIndex, Ctx);
+				std::tie(Status, NextIdx) = NodeTraverseFromParent(*pNode, CurrIdx, Ctx);
 			else
-				std::tie(Status, NextIdx) = pNode->pNodeImpl->TraverseFromChild(CurrIdx, pNode->SkipSubtreeIndex, NextIdx, Status, Ctx);
+				std::tie(Status, NextIdx) = NodeTraverseFromChild(*pNode, CurrIdx, NextIdx, Status, Ctx);
 
 			// If the node requests itself, it is the new active node
 			if (NextIdx == CurrIdx)
@@ -310,14 +421,26 @@ EBTStatus CBehaviourTreePlayer::Update(float dt)
 	// If the tree is not running, the current active path is no longer active and must be deactivated
 	if (Status != EBTStatus::Running) ResetActivePath(Ctx);
 
+	// A succeeded tree restarts in the next update as before. A failed one has nothing to do until something changes.
+	if (Status == EBTStatus::Succeeded) _EvaluationRequested = true;
+
+	// The active path needs an update when the first of its nodes does
+	_UpdateDelay = std::numeric_limits<float>::max();
+	for (U16 Level = 0; Level < _ActiveDepth; ++Level)
+		_UpdateDelay = std::min(_UpdateDelay, NodeGetUpdateDelay(*_Asset->GetNode(_pActiveStack[Level]), _pNodeInstanceData[Level].pNodeData));
+
 	return Status;
 }
 //---------------------------------------------------------------------
 
 bool CBehaviourTreePlayer::RequestEvaluation(U16 Index)
 {
-	// Nothing to override, evaluation will start from the root
-	if (!_ActiveDepth) return false;
+	// Nothing to override, evaluation will start from the root. An idle tree may find something to do now.
+	if (!_ActiveDepth)
+	{
+		_EvaluationRequested = true;
+		return false;
+	}
 
 	// Only higher priority nodes can override the active path
 	const U16 ActiveLevel = _ActiveDepth - 1;
@@ -329,7 +452,7 @@ bool CBehaviourTreePlayer::RequestEvaluation(U16 Index)
 	const auto* pNode = _Asset->GetNode(CurrIdx);
 	while (ActiveLevel < pNode->DepthLevel || CurrIdx < _pActiveStack[pNode->DepthLevel])
 	{
-		if (!pNode->pNodeImpl->CanOverrideLowerPriorityNodes()) return false;
+		if (!pNode->CanOverrideLowerPriorityNodes) return false;
 
 		CandidateIdx = CurrIdx;
 		CurrIdx = pNode->ParentIndex;
@@ -345,6 +468,7 @@ bool CBehaviourTreePlayer::RequestEvaluation(U16 Index)
 
 	// Finally register a request
 	RequestSlot = CandidateIdx;
+	_EvaluationRequested = true;
 	return true;
 }
 //---------------------------------------------------------------------
@@ -5,6 +5,8 @@
 #include <map>
 
 // Plays a CBehaviourTreeAsset and tracks its state. Parallel tasks can be implemented using their own nested players.
+// A scheduler may skip updates of a tree until its evaluation is requested by an event or a blackboard change, or until
+// active nodes need an update. Skipped time is accumulated and passed to nodes in the next update.
 
 namespace DEM::Events
 {
@@ -52,6 +54,10 @@ private:
 
 	U16                               _ActiveDepth = 0;               // Depth of _pActiveStack
 
+	float                             _SkippedTime = 0.f;             // Time passed since the last update
+	float                             _UpdateDelay = 0.f;             // Time the active path can go without updates
+	bool                              _EvaluationRequested = true;    // Something may have changed the tree outcome
+
 	EBTStatus ActivateNode(U16 Index, CDataStackRecord& InstanceDataRecord, const CBehaviourTreeContext& Ctx);
 	void      DeactivateNode(U16 Index, CDataStackRecord& InstanceDataRecord, const CBehaviourTreeContext& Ctx);
 	void      ResetActivePath(const CBehaviourTreeContext& Ctx);
@@ -68,6 +74,8 @@ public:
 	bool      Start(Game::CGameSession& Session, Game::HEntity ActorID);
 	void      Stop();
 	EBTStatus Update(float dt);
+	void      SkipUpdate(float dt) { _SkippedTime += dt; }
+	bool      NeedsUpdate(float dt) const { return _EvaluationRequested || (_ActiveDepth && _SkippedTime + dt >= _UpdateDelay); }
 	bool      RequestEvaluation(U16 Index);
 	void      EvaluateOnBlackboardChange(const CBlackboard& BB, CStrID BBKey, U16 Index);
 
@@ -56,6 +56,9 @@ void CBehaviourTreeCondition::Init(const Data::CParams* pParams)
 	{
 		ParamsFormat::Deserialize(pDesc->GetRawValue(), _Condition);
 
+		// Variable comparisons only read vars. Composite conditions copy shared params when evaluated, and scripts aren't thread-safe.
+		_CanUpdateInParallel = (_Condition.Type == Game::CVarCmpVarCondition::Type || _Condition.Type == Game::CVarCmpConstCondition::Type);
+
 		if (_OverrideLowerPriority)
 		{
 			// Gather context (blackboard) keys used by the conditon to subscribe on their changes
@@ -16,12 +16,16 @@ protected:
 	Game::CConditionData _Condition;
 	std::vector<CStrID>  _UsedBBKeys;
 	bool                 _OverrideLowerPriority = true;
+	bool                 _CanUpdateInParallel = false;
 
 public:
 
 	virtual void Init(const Data::CParams* pParams) override;
 
 	virtual void                      OnTreeStarted(U16 SelfIdx, CBehaviourTreePlayer& Player) const override;
+	virtual bool                      CanUpdateInParallel() const override { return _CanUpdateInParallel; }
+	virtual float                     GetUpdateDelay(const std::byte*) const override { return std::numeric_limits<float>::max(); }
+	virtual EBTOpcode                 Compile(CBTInlineParam& OutParam) const override { OutParam.pCondition = &_Condition; return EBTOpcode::Condition; }
 	virtual std::pair<EBTStatus, U16> TraverseFromParent(U16 SelfIdx, U16 SkipIdx, const CBehaviourTreeContext& Ctx) const override;
 };
 
@@ -26,6 +26,7 @@ public:
 	virtual void                      Init(const Data::CParams* pParams) override;
 	virtual size_t                    GetInstanceDataSize() const override;
 	virtual size_t                    GetInstanceDataAlignment() const override;
+	virtual bool                      CanUpdateInParallel() const override { return true; }
 
 	virtual EBTStatus                 Activate(std::byte* pData, const CBehaviourTreeContext& Ctx) const override;
 	virtual void                      Deactivate(std::byte* pData, const CBehaviourTreeContext& Ctx) const override;
@@ -105,7 +105,7 @@ static Game::HEntity FindClosestActor(const CBehaviourTreeContext& Ctx)
 
 	Game::HEntity Result;
 	float MinSqDist = std::numeric_limits<float>::max();
-	for (const auto& Fact : Ctx.pBrain->Facts)
+	for (const auto& Fact : Ctx.pBrain->Facts.GetFacts())
 	{
 		if (!Fact.SourceID) continue;
 
@@ -147,6 +147,12 @@ size_t CBehaviourTreeSelectClosestActor::GetInstanceDataAlignment() const
 }
 //---------------------------------------------------------------------
 
+float CBehaviourTreeSelectClosestActor::GetUpdateDelay(const std::byte* pData) const
+{
+	return reinterpret_cast<const CInstanceData*>(pData)->TimeToNextUpdate;
+}
+//---------------------------------------------------------------------
+
 void CBehaviourTreeSelectClosestActor::DoSelection(const CBehaviourTreeContext& Ctx, CInstanceData& Data) const
 {
 	const auto FoundID = FindClosestActor(Ctx);
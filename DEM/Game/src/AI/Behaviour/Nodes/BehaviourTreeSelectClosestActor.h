@@ -28,6 +28,8 @@ public:
 	virtual void                      Init(const Data::CParams* pParams) override;
 	virtual size_t                    GetInstanceDataSize() const override;
 	virtual size_t                    GetInstanceDataAlignment() const override;
+	virtual bool                      CanUpdateInParallel() const override { return true; }
+	virtual float                     GetUpdateDelay(const std::byte* pData) const override;
 
 	virtual std::pair<EBTStatus, U16> TraverseFromParent(U16 SelfIdx, U16 SkipIdx, const CBehaviourTreeContext& Ctx) const override { return { EBTStatus::Succeeded, SelfIdx + 1 }; }
 	virtual EBTStatus                 Activate(std::byte* pData, const CBehaviourTreeContext& Ctx) const override;
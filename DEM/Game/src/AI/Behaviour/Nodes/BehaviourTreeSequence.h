@@ -12,6 +12,10 @@ class CBehaviourTreeSequence : public CBehaviourTreeNodeBase
 
 public:
 
+	virtual bool                      CanUpdateInParallel() const override { return true; }
+	virtual float                     GetUpdateDelay(const std::byte*) const override { return std::numeric_limits<float>::max(); }
+	virtual EBTOpcode                 Compile(CBTInlineParam&) const override { return EBTOpcode::Sequence; }
+
 	virtual std::pair<EBTStatus, U16> TraverseFromParent(U16 SelfIdx, U16 SkipIdx, const CBehaviourTreeContext&) const override
 	{
 		// Traversing from above always means starting from the first child, if any, or reporting immediate success
@@ -29,6 +29,22 @@ size_t CBehaviourTreeWaitTime::GetInstanceDataAlignment() const
 }
 //---------------------------------------------------------------------
 
+float CBehaviourTreeWaitTime::GetUpdateDelay(const std::byte* pData) const
+{
+	return *reinterpret_cast<const float*>(pData);
+}
+//---------------------------------------------------------------------
+
+// Only a constant time can be inlined, time from a blackboard requires a call
+EBTOpcode CBehaviourTreeWaitTime::Compile(CBTInlineParam& OutParam) const
+{
+	if (!_Time.IsConstant()) return EBTOpcode::Call;
+
+	OutParam.Time = _Time.GetConstant();
+	return EBTOpcode::WaitTime;
+}
+//---------------------------------------------------------------------
+
 EBTStatus CBehaviourTreeWaitTime::Activate(std::byte* pData, const CBehaviourTreeContext& Ctx) const
 {
 	const float RemainingTime = _Time.Get(Ctx.pBrain->Blackboard);
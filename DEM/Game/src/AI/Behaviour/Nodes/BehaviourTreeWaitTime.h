@@ -20,6 +20,9 @@ public:
 	virtual void                      Init(const Data::CParams* pParams) override;
 	virtual size_t                    GetInstanceDataSize() const override;
 	virtual size_t                    GetInstanceDataAlignment() const override;
+	virtual bool                      CanUpdateInParallel() const override { return true; }
+	virtual float                     GetUpdateDelay(const std::byte* pData) const override;
+	virtual EBTOpcode                 Compile(CBTInlineParam& OutParam) const override;
 
 	virtual EBTStatus                 Activate(std::byte* pData, const CBehaviourTreeContext& Ctx) const override;
 	virtual void                      Deactivate(std::byte* pData, const CBehaviourTreeContext& Ctx) const override;
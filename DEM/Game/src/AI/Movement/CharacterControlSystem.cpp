@@ -7,34 +7,150 @@
 #include <Physics/RigidBody.h>
 #include <Physics/CollisionShape.h>
 #include <Physics/BulletConv.h>
+#include <Math/SpatialHash.h>
+#include <Jobs/JobSystem.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <DetourObstacleAvoidance.h>
 
 namespace DEM::Game
 {
+constexpr size_t AVOIDANCE_AGENTS_PER_JOB = 32;
+constexpr int MAX_AVOIDANCE_NEIGHBOURS = 6;           // As in DetourCrowd
+constexpr float AVOIDANCE_RANGE_RADIUS_FACTOR = 12.f; // Neighbour search range in agent radii, as in DetourCrowd
 
-static float CalcDistanceToGround(const CCharacterControllerComponent& Character, const rtm::vector4f& Pos)
+struct CCharacterMovementTask
 {
-	constexpr float GroundProbeLength = 0.5f;
+	rtm::vector4f                  Position;
+	rtm::vector4f                  Velocity;
+	rtm::vector4f                  DesiredVelocity; // From steering, read by neighbours during avoidance
+	rtm::vector4f                  AvoidedVelocity; // Written by avoidance
+	CCharacterControllerComponent* pCharacter;
+	AI::CCommandStackComponent*    pCmdStack;
+	float                          DistanceToGround;
+	bool                           IsSelfControlled;
+	bool                           NeedsAvoidance;
+};
+
+static const dtObstacleAvoidanceParams& GetObstacleAvoidanceParams()
+{
+	// Medium-high quality preset from DetourCrowd
+	static const dtObstacleAvoidanceParams Params = []()
+	{
+		dtObstacleAvoidanceParams Params;
+		Params.velBias = 0.5f;
+		Params.weightDesVel = 2.0f;
+		Params.weightCurVel = 0.75f;
+		Params.weightSide = 0.75f;
+		Params.weightToi = 2.5f;
+		Params.horizTime = 2.5f;
+		Params.gridSize = 33;
+		Params.adaptiveDivs = 7;
+		Params.adaptiveRings = 2;
+		Params.adaptiveDepth = 5;
+		return Params;
+	}();
+	return Params;
+}
+//---------------------------------------------------------------------
 
-	const rtm::vector4f Start = rtm::vector_add(Pos, rtm::vector_set(0.f, Character.Height, 0.f));
-	const rtm::vector4f End = rtm::vector_sub(Pos, rtm::vector_set(0.f, Character.MaxStepDownHeight + GroundProbeLength, 0.f)); // Falling state detection
+// Each worker thread has its own query, which is reset for every agent
+static dtObstacleAvoidanceQuery* GetObstacleAvoidanceQuery()
+{
+	thread_local std::unique_ptr<dtObstacleAvoidanceQuery, decltype(&dtFreeObstacleAvoidanceQuery)> Query(nullptr, &dtFreeObstacleAvoidanceQuery);
+	if (!Query)
+	{
+		Query.reset(dtAllocObstacleAvoidanceQuery());
+		if (Query && !Query->init(MAX_AVOIDANCE_NEIGHBOURS, 0)) Query.reset();
+	}
+	return Query.get();
+}
+//---------------------------------------------------------------------
 
-	auto pBody = Character.RigidBody.Get();
+// Velocity obstacles are built from neighbour current and desired velocities, so that agents
+// that see each other choose complementary velocities, like in DetourCrowd
+static void AvoidNeighbours(CCharacterMovementTask* pTasks, const Math::CSpatialHash2D& Grid, U32 Begin, U32 End)
+{
+	ZoneScoped;
 
-	// FIXME: improve passing collision flags through interfaces!
-	const auto* pCollisionProxy = pBody->GetBtBody()->getBroadphaseProxy();
+	auto* pQuery = GetObstacleAvoidanceQuery();
+	if (!pQuery) return;
 
-	rtm::vector4f ContactPos;
-	if (pBody->GetLevel()->GetClosestRayContact(Start, End,
-		pCollisionProxy->m_collisionFilterGroup,
-		pCollisionProxy->m_collisionFilterMask,
-		&ContactPos, nullptr, pBody))
+	std::pair<float, U32> Neighbours[MAX_AVOIDANCE_NEIGHBOURS];
+	for (U32 i = Begin; i < End; ++i)
 	{
-		return rtm::vector_get_y(rtm::vector_sub(Pos, ContactPos));
+		auto& Task = pTasks[i];
+		if (!Task.NeedsAvoidance) continue;
+
+		const auto& Character = *Task.pCharacter;
+		const float Range = Character.Radius * AVOIDANCE_RANGE_RADIUS_FACTOR;
+		const float SqRange = Range * Range;
+
+		// Keep the closest neighbours sorted by distance
+		int NeighbourCount = 0;
+		Grid.ForEachInRange(rtm::vector_get_x(Task.Position), rtm::vector_get_z(Task.Position), Range,
+			[pTasks, i, &Task, &Character, SqRange, &Neighbours, &NeighbourCount](U32 Index)
+		{
+			if (Index == i) return;
+
+			const rtm::vector4f Offset = rtm::vector_sub(pTasks[Index].Position, Task.Position);
+			if (std::fabs(rtm::vector_get_y(Offset)) >= Character.Height) return;
+
+			const float SqDistance = Math::vector_length_squared_xz(Offset);
+			if (SqDistance > SqRange) return;
+
+			int Pos = NeighbourCount;
+			while (Pos > 0 && Neighbours[Pos - 1].first > SqDistance) --Pos;
+			if (Pos >= MAX_AVOIDANCE_NEIGHBOURS) return;
+
+			const int Last = std::min(NeighbourCount, MAX_AVOIDANCE_NEIGHBOURS - 1);
+			for (int j = Last; j > Pos; --j)
+				Neighbours[j] = Neighbours[j - 1];
+			Neighbours[Pos] = { SqDistance, Index };
+			if (NeighbourCount < MAX_AVOIDANCE_NEIGHBOURS) ++NeighbourCount;
+		});
+
+		if (!NeighbourCount) continue;
+
+		pQuery->reset();
+		for (int j = 0; j < NeighbourCount; ++j)
+		{
+			const auto& Other = pTasks[Neighbours[j].second];
+			float Pos[3], Vel[3], DesiredVel[3];
+			rtm::vector_store3(Other.Position, Pos);
+			rtm::vector_store3(rtm::vector_set_y(Other.Velocity, 0.f), Vel);
+			rtm::vector_store3(rtm::vector_set_y(Other.DesiredVelocity, 0.f), DesiredVel);
+			pQuery->addCircle(Pos, Other.pCharacter->Radius, Vel, DesiredVel);
+		}
+
+		float Pos[3], Vel[3], DesiredVel[3], NewVel[3];
+		rtm::vector_store3(Task.Position, Pos);
+		rtm::vector_store3(rtm::vector_set_y(Task.Velocity, 0.f), Vel);
+		rtm::vector_store3(rtm::vector_set_y(Task.DesiredVelocity, 0.f), DesiredVel);
+		const float MaxSpeed = std::max(Character.MaxLinearSpeed, rtm::vector_length3(rtm::vector_set_y(Task.DesiredVelocity, 0.f)));
+		pQuery->sampleVelocityAdaptive(Pos, Character.Radius, MaxSpeed, Vel, DesiredVel, NewVel, &GetObstacleAvoidanceParams());
+
+		Task.AvoidedVelocity = rtm::vector_set(NewVel[0], rtm::vector_get_y(Task.DesiredVelocity), NewVel[2]);
 	}
+}
+//---------------------------------------------------------------------
 
-	return std::numeric_limits<float>().max();
+static Physics::CPhysicsLevel::CRayQuery GetGroundProbe(const CCharacterControllerComponent& Character, const rtm::vector4f& Pos)
+{
+	constexpr float GroundProbeLength = 0.5f;
+
+	auto pBody = Character.RigidBody.Get();
+
+	// FIXME: improve passing collision flags through interfaces!
+	const auto* pCollisionProxy = pBody->GetBtBody()->getBroadphaseProxy();
+
+	Physics::CPhysicsLevel::CRayQuery Probe;
+	Probe.Start = rtm::vector_add(Pos, rtm::vector_set(0.f, Character.Height, 0.f));
+	Probe.End = rtm::vector_sub(Pos, rtm::vector_set(0.f, Character.MaxStepDownHeight + GroundProbeLength, 0.f)); // Falling state detection
+	Probe.Group = pCollisionProxy->m_collisionFilterGroup;
+	Probe.Mask = pCollisionProxy->m_collisionFilterMask;
+	Probe.pExclude = pBody;
+	return Probe;
 }
 //---------------------------------------------------------------------
 
@@ -188,9 +304,6 @@ static rtm::vector4f ProcessMovement(CCharacterControllerComponent& Character, A
 		rtm::vector_div(ToDest, rtm::vector_set(FrameTime)) :
 		rtm::vector_mul(DesiredMovement, Speed / RemainingDistance);
 
-// TODO: neighbour separation, obstacle avoidance (see DetourCrowd for impl.)
-//if (Character._ObstacleAvoidanceEnabled) AvoidObstacles();
-
 	Character.SqExpectedLinearSpeed = Speed * Speed;
 
 	return DesiredLinearVelocity;
@@ -308,36 +421,112 @@ void FinalizeCharacterControllerCommands(AI::CCommandStackComponent& CmdStack)
 }
 //---------------------------------------------------------------------
 
-void ProcessCharacterControllers(CGameWorld& World, Physics::CPhysicsLevel& PhysicsLevel, float dt)
+// Steering and rigid body updates access Bullet and command stacks and are done serially. Ground checks are
+// batched read-only raycasts, and local avoidance only reads gathered movement data, so both run in parallel jobs.
+// Neighbours are found in a spatial hash built once per call. Pass nullptr as pWorker to do all the work on the calling thread.
+void ProcessCharacterControllers(CGameWorld& World, Physics::CPhysicsLevel& PhysicsLevel, float dt, Jobs::CWorker* pWorker)
 {
+	ZoneScoped;
+
+	std::vector<CCharacterMovementTask> Tasks;
+	std::vector<Physics::CPhysicsLevel::CRayQuery> GroundProbes;
 	World.ForEachEntityWith<CCharacterControllerComponent, AI::CCommandStackComponent>(
-		[dt, &PhysicsLevel](auto EntityID, auto& Entity,
+		[&PhysicsLevel, &Tasks, &GroundProbes](auto EntityID, auto& Entity,
 			CCharacterControllerComponent& Character,
 			AI::CCommandStackComponent& CmdStack)
 	{
 		auto* pBody = Character.RigidBody.Get();
 		if (!pBody || pBody->GetLevel() != &PhysicsLevel) return;
 
+		auto& Task = Tasks.emplace_back();
+		Task.pCharacter = &Character;
+		Task.pCmdStack = &CmdStack;
+
 		// It is important to use physics body position because the system is called per physics tick, not per logic update
-		const auto Pos = pBody->GetPhysicalPosition();
+		Task.Position = pBody->GetPhysicalPosition();
+		Task.Velocity = Math::FromBullet(pBody->GetBtBody()->getLinearVelocity());
 
-		const float DistanceToGround = CalcDistanceToGround(Character, Pos);
-		if (UpdateSelfControlState(Character, DistanceToGround))
+		GroundProbes.push_back(GetGroundProbe(Character, Task.Position));
+	});
+
+	// Ground checks of all characters are done in one batch of raycasts
+	std::vector<Physics::CPhysicsLevel::CQueryHit> GroundHits(GroundProbes.size());
+	PhysicsLevel.CastRays(GroundProbes.data(), GroundHits.data(), GroundProbes.size(), pWorker);
+
+	float MaxAvoidanceRange = 0.f;
+	for (size_t i = 0; i < Tasks.size(); ++i)
+	{
+		auto& Task = Tasks[i];
+		auto& Character = *Task.pCharacter;
+		auto& CmdStack = *Task.pCmdStack;
+
+		Task.DistanceToGround = GroundHits[i].Hit ?
+			rtm::vector_get_y(rtm::vector_sub(Task.Position, GroundHits[i].Position)) :
+			std::numeric_limits<float>().max();
+		Task.IsSelfControlled = UpdateSelfControlState(Character, Task.DistanceToGround);
+
+		// Update movement and other self-control
+		Task.DesiredVelocity = Task.IsSelfControlled ? ProcessMovement(Character, CmdStack, Task.Position) : rtm::vector_zero();
+		Task.AvoidedVelocity = Task.DesiredVelocity;
+
+		// Short steps are precise positioning and are not disturbed by avoidance
+		Task.NeedsAvoidance = Task.IsSelfControlled && Character.ObstacleAvoidance && Character.State == ECharacterState::Walk &&
+			!rtm::vector_all_equal3(Task.DesiredVelocity, rtm::vector_zero());
+		if (Task.NeedsAvoidance)
+			MaxAvoidanceRange = std::max(MaxAvoidanceRange, Character.Radius * AVOIDANCE_RANGE_RADIUS_FACTOR);
+	}
+
+	if (MaxAvoidanceRange > 0.f && Tasks.size() > 1)
+	{
+		auto* pTasks = Tasks.data();
+		const U32 TaskCount = static_cast<U32>(Tasks.size());
+
+		Math::CSpatialHash2D Grid;
+		Grid.Build(TaskCount, MaxAvoidanceRange, [pTasks](U32 Index, float& x, float& z)
 		{
-			// Update movement and other self-control
-			rtm::vector4f DesiredLinearVelocity = ProcessMovement(Character, CmdStack, Pos);
-			const float DesiredAngularVelocity = ProcessFacing(Character, CmdStack, DesiredLinearVelocity);
-			UpdateRigidBodyMovement(pBody, dt, DesiredLinearVelocity, DesiredAngularVelocity, Character.MaxAcceleration);
-
-			// TODO: not needed when levitate, only when really stand on the ground
-			// We stand on the ground and want to compensate our DistanceToGround in a single simulation step
-			if (DistanceToGround != 0.f) pBody->GetBtBody()->applyCentralImpulse(btVector3(0.f, (-DistanceToGround / dt) * pBody->GetMass(), 0.f));
+			x = rtm::vector_get_x(pTasks[Index].Position);
+			z = rtm::vector_get_z(pTasks[Index].Position);
+		});
+
+		if (pWorker && TaskCount > AVOIDANCE_AGENTS_PER_JOB)
+		{
+			Jobs::CJobCounter Counter;
+			for (U32 i = 0; i < TaskCount; i += AVOIDANCE_AGENTS_PER_JOB)
+			{
+				const U32 End = std::min<U32>(i + AVOIDANCE_AGENTS_PER_JOB, TaskCount);
+				pWorker->AddJob(Counter, [pTasks, &Grid, i, End]() { AvoidNeighbours(pTasks, Grid, i, End); });
+			}
+			pWorker->WaitActive(Counter);
 		}
 		else
+		{
+			AvoidNeighbours(pTasks, Grid, 0, TaskCount);
+		}
+	}
+
+	for (auto& Task : Tasks)
+	{
+		if (!Task.IsSelfControlled)
 		{
 			// TODO: update above the ground (uncontrolled) state
+			continue;
 		}
-	});
+
+		auto& Character = *Task.pCharacter;
+		auto* pBody = Character.RigidBody.Get();
+
+		// Slowing down to let others pass is not being stuck
+		if (Task.NeedsAvoidance)
+			Character.SqExpectedLinearSpeed = std::min(Character.SqExpectedLinearSpeed, Math::vector_length_squared_xz(Task.AvoidedVelocity));
+
+		rtm::vector4f DesiredLinearVelocity = Task.AvoidedVelocity;
+		const float DesiredAngularVelocity = ProcessFacing(Character, *Task.pCmdStack, DesiredLinearVelocity);
+		UpdateRigidBodyMovement(pBody, dt, DesiredLinearVelocity, DesiredAngularVelocity, Character.MaxAcceleration);
+
+		// TODO: not needed when levitate, only when really stand on the ground
+		// We stand on the ground and want to compensate our DistanceToGround in a single simulation step
+		if (Task.DistanceToGround != 0.f) pBody->GetBtBody()->applyCentralImpulse(btVector3(0.f, (-Task.DistanceToGround / dt) * pBody->GetMass(), 0.f));
+	}
 }
 //---------------------------------------------------------------------
 
@@ -367,7 +556,7 @@ void CheckCharacterControllersArrival(CGameWorld& World, Physics::CPhysicsLevel&
 			const auto Pos = pBody->GetPhysicalPosition();
 			const auto ToDest = rtm::vector_sub(pSteerAction->_Dest, Pos);
 			const float SqDistance = Math::vector_length_squared_xz(ToDest);
-			const bool IsSameHeightLevel = (std::fabsf(rtm::vector_get_y(ToDest)) < Character.Height);
+			const bool IsSameHeightLevel = (std::fabs(rtm::vector_get_y(ToDest)) < Character.Height);
 			if (IsSameHeightLevel && SqDistance < AI::Steer::SqLinearTolerance)
 			{
 				::Sys::Log(EntityToString(EntityID) + ": arrived to dest\n");
@@ -403,7 +592,7 @@ void CheckCharacterControllersArrival(CGameWorld& World, Physics::CPhysicsLevel&
 			// Check angular arrival. Access real physical transform, not an interpolated motion state.
 			const rtm::vector4f LookatDir = Math::FromBullet(pBody->GetBtBody()->getWorldTransform().getBasis() * btVector3(0.f, 0.f, -1.f));
 			const float Angle = Math::AngleXZNorm(LookatDir, pTurnAction->_LookatDirection);
-			if (std::fabsf(Angle) < pTurnAction->_Tolerance)
+			if (std::fabs(Angle) < pTurnAction->_Tolerance)
 			{
 				::Sys::Log(EntityToString(EntityID) + ": finished facing\n");
 				CmdStack.PopCommand(Cmd, AI::ECommandStatus::Succeeded);
@@ -458,161 +647,6 @@ void UpdateCharacterControllerShape(CCharacterControllerComponent& Character)
 //---------------------------------------------------------------------
 
 /*
-//!!!FIXME: what if obstacle is over the destination point? brake and stand stuck until request is failed or location if freed?
-void CCharacterController::AvoidObstacles()
-{
-	constexpr float ObstacleDetectionMinRadius = 0.1f;
-	constexpr float ObstaclePredictionTime = 1.2f;
-	const float DetectionRadius = ObstacleDetectionMinRadius + Speed * ObstaclePredictionTime;
-
-#ifdef DETOUR_OBSTACLE_AVOIDANCE // In ActorFwd.h
-	float Range = pActor->Radius + DetectionRadius;
-
-	//???here or global persistent?
-	dtObstacleAvoidanceQuery ObstacleQuery;
-	ObstacleQuery.init(6, 8);
-	//ObstacleQuery.reset();
-	pActor->GetNavSystem().GetObstacles(Range, ObstacleQuery);
-
-	//???pre-filter mem facts? distance < Range, height intersects actor height etc
-	CMemFactNode It = pActor->GetMemSystem().GetFactsByType(CMemFactObstacle::RTTI);
-	for (; It; ++It)
-	{
-		CMemFactObstacle* pObstacle = (CMemFactObstacle*)It->Get();
-		//!!!remember obstacle velocity in the fact and use here!
-		// desired velocity can be get from obstacles-actors only!
-		ObstacleQuery.addCircle(pObstacle->Position.v, pObstacle->Radius, vector3::Zero.v, vector3::Zero.v);
-	}
-
-	//!!!GET AT ACTIVATION AND STORE!
-	//dtObstacleAvoidanceParams* pOAParams = n_new(dtObstacleAvoidanceParams);
-	//pOAParams->velBias = 0.4f;
-	//pOAParams->weightDesVel = 2.0f;
-	//pOAParams->weightCurVel = 0.75f;
-	//pOAParams->weightSide = 0.75f;
-	//pOAParams->weightToi = 2.5f;
-	//pOAParams->horizTime = 2.5f;
-	//pOAParams->gridSize = 33;
-	//pOAParams->adaptiveDivs = 7;
-	//pOAParams->adaptiveRings = 2;
-	//pOAParams->adaptiveDepth = 5;
-	//ObstacleAvoidanceParams.Add(CStrID::Empty, pOAParams);
-	const dtObstacleAvoidanceParams* pOAParams = AI::CAIServer::Instance()->GetDefaultObstacleAvoidanceParams();
-
-	if (ObstacleQuery.getObstacleCircleCount() || ObstacleQuery.getObstacleSegmentCount())
-	{
-		vector3 LinearVel;
-		pActor->GetEntity()->GetAttr(LinVel, CStrID("LinearVelocity"));
-		float DesVel[3] = { LinearVel.x, 0.f, LinearVel.z }; // Copy LVel because it is modified inside the call
-		if (AdaptiveVelocitySampling)
-			ObstacleQuery.sampleVelocityAdaptive(pActor->Position.v, pActor->Radius, MaxSpeed[pActor->MvmtType],
-													Velocity.v, DesVel, LinearVel.v, pOAParams);
-		else
-			ObstacleQuery.sampleVelocityGrid(pActor->Position.v, pActor->Radius, MaxSpeed[pActor->MvmtType],
-												Velocity.v, DesVel, LinearVel.v, pOAParams);
-	}
-
-#else
-	CMemFactNode It = pActor->GetMemSystem().GetFactsByType(CMemFactObstacle::RTTI);
-
-	//!!!???dynamic obstacles - take velocity into account!?
-	//!!!read about VO & RVO!
-	//!!!if get stuck avoiding obstacle, try to select far point
-
-	if (It)
-	{
-		CMemFactObstacle* pClosest = nullptr;
-		float MinIsect = FLT_MAX;
-		float MinExpRadius;
-
-		vector2 ActorPos(pActor->Position.x, pActor->Position.z);
-		vector2 ToDest(DestPoint.x - ActorPos.x, DestPoint.z - ActorPos.y);
-		float DistToDest = ToDest.Length();
-		ToDest /= DistToDest;
-		vector2 ActorSide(-ToDest.y, ToDest.x);
-		float ActorRadius = pActor->Radius + AvoidanceMargin;
-
-		float DetectorLength = ActorRadius + DetectionRadius;
-
-		for (; It; ++It)
-		{
-			CMemFactObstacle* pObstacle = (CMemFactObstacle*)It->Get();
-
-			// Uncomment if obstacle has Height
-			//if ((pActor->Position.y + pActor->Height < pObstacle->Position.y) ||
-			//	(pObstacle->Position.y + pObstacle->Height < pActor->Position.y))
-			//	continue;
-
-			vector2 FromObstacleToDest(
-				DestPoint.x - pObstacle->Position.x,
-				DestPoint.z - pObstacle->Position.z);
-			float ExpRadius = ActorRadius + pObstacle->Radius;
-			float SqExpRadius = ExpRadius * ExpRadius;
-
-			// Don't avoid obstacles at the destination
-			if (FromObstacleToDest.SqLength() < SqExpRadius) continue;
-
-			vector2 ToObstacle(
-				pObstacle->Position.x - ActorPos.x,
-				pObstacle->Position.z - ActorPos.y);
-			float SqDistToObstacle = ToObstacle.SqLength();
-
-			if (SqDistToObstacle >= DistToDest * DistToDest) continue; 
-
-			float DetectRadius = DetectorLength + pObstacle->Radius;
-
-			if (SqDistToObstacle >= DetectRadius * DetectRadius) continue;
-
-			vector2 LocalPos(pObstacle->Position.x, pObstacle->Position.z);
-			LocalPos.ToLocalAsPoint(ToDest, ActorSide, ActorPos);
-
-			if (LocalPos.x <= 0.f || n_fabs(LocalPos.y) >= ExpRadius) continue;
-
-			float SqrtPart = sqrtf(SqExpRadius - LocalPos.y * LocalPos.y);
-			float Isect = (LocalPos.x <= SqrtPart) ? LocalPos.x + SqrtPart : LocalPos.x - SqrtPart;
-
-			if (Isect < MinIsect)
-			{
-				pClosest = pObstacle;
-				MinIsect = Isect;
-				MinExpRadius = ExpRadius;
-			}
-		}
-
-		if (pClosest)
-		{
-			// Will not work if raduis of obstacle can change. If so, check Radius too.
-			vector2 ObstaclePos(pClosest->Position.x, pClosest->Position.z);
-			if (pClosest == pLastClosestObstacle && LastClosestObstaclePos.isequal(ObstaclePos, 0.01f))
-				ToDest = LastAvoidDir;
-			else
-			{
-				vector2 ToObstacle = ObstaclePos - ActorPos;
-				vector2 ProjDir = ToDest * ToObstacle.dot(ToDest) - ToObstacle;
-				float ProjDirLen = ProjDir.Length();
-				if (ProjDirLen <= TINY)
-				{
-					ProjDir.set(-ToObstacle.y, ToObstacle.x);
-					ProjDirLen = ProjDir.Length();
-				}
-
-				ToDest = ToObstacle + ProjDir * (MinExpRadius / ProjDirLen);
-				ToDest.norm();
-				LastAvoidDir = ToDest;
-			}
-
-			//!!!SPEED needs adjusting to! brake or arrival effect elimination.
-			LinearVel.set(ToDest.x * Speed, 0.f, ToDest.y * Speed);
-
-			LastClosestObstaclePos = ObstaclePos;
-		}
-
-		pLastClosestObstacle = pClosest;
-	}
-#endif
-}
-//---------------------------------------------------------------------
-
 void CMotorSystem::RenderDebug(Debug::CDebugDraw& DebugDraw)
 {
 	static const vector4 ColorNormal(1.0f, 1.0f, 1.0f, 1.0f);
@@ -61,7 +61,7 @@ struct CNavAgentComponent
 	static constexpr bool Signals = true;
 
 	dtPathCorridor       Corridor;
-	dtNavMeshQuery*      pNavQuery = nullptr; //???need per-agent or can use pool in path queue or navmesh?
+	dtNavMeshQuery*      pNavQuery = nullptr; // Shared per navmap, main thread only. Async path searches use pooled queries.
 	PNavMap              NavMap;
 	PNavAgentSettings    Settings;
 	CStrID               SettingsID; // FIXME: use resource instead of object+ID?
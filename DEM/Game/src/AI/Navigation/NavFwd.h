@@ -7,9 +7,13 @@
 #error "64-bit navigation poly refs aren't supported for now"
 #else
 typedef unsigned int dtPolyRef;
+typedef unsigned int dtTileRef;
 #endif
 
 class dtNavMesh;
+struct dtNavMeshParams;
+struct dtMeshHeader;
+struct dtPoly;
 
 namespace DEM::AI
 {
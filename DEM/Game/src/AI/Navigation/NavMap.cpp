@@ -1,9 +1,81 @@
 #include "NavMap.h"
 #include <Resources/Resource.h>
 #include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+#include <DetourCommon.h>
+#include <Jobs/JobSystem.h>
 
 namespace DEM::AI
 {
+constexpr float STREAMING_REMOVE_DISTANCE_FACTOR = 1.25f; // Hysteresis prevents tiles on the border from being re-added every frame
+
+// Obstacle bounds are expanded by the agent radius, because navmesh polys are already eroded by it
+static bool IsPolyBlocked(const float* pVerts, int VertCount, const float* pPolyMin, const float* pPolyMax,
+	const CNavMap::CObstacle& Obstacle, float AgentRadius, float AgentHeight)
+{
+	// An obstacle blocks a poly if it is between the poly surface and the agent head
+	if (pPolyMin[1] > Obstacle.Max[1] || pPolyMax[1] + AgentHeight < Obstacle.Min[1]) return false;
+
+	if (Obstacle.Radius > 0.f)
+	{
+		const float Center[3] = { (Obstacle.Min[0] + Obstacle.Max[0]) * 0.5f, 0.f, (Obstacle.Min[2] + Obstacle.Max[2]) * 0.5f };
+		if (dtPointInPolygon(Center, pVerts, VertCount)) return true;
+
+		const float RadiusSq = dtSqr(Obstacle.Radius + AgentRadius);
+		for (int i = 0, j = VertCount - 1; i < VertCount; j = i++)
+		{
+			float t;
+			if (dtDistancePtSegSqr2D(Center, &pVerts[j * 3], &pVerts[i * 3], t) < RadiusSq) return true;
+		}
+
+		return false;
+	}
+	else
+	{
+		const float MinX = Obstacle.Min[0] - AgentRadius;
+		const float MinZ = Obstacle.Min[2] - AgentRadius;
+		const float MaxX = Obstacle.Max[0] + AgentRadius;
+		const float MaxZ = Obstacle.Max[2] + AgentRadius;
+		if (pPolyMin[0] > MaxX || pPolyMax[0] < MinX || pPolyMin[2] > MaxZ || pPolyMax[2] < MinZ) return false;
+
+		const float Box[12] = { MinX, 0.f, MinZ, MinX, 0.f, MaxZ, MaxX, 0.f, MaxZ, MaxX, 0.f, MinZ };
+		return dtOverlapPolyPoly2D(Box, 4, pVerts, VertCount);
+	}
+}
+//---------------------------------------------------------------------
+
+static void ProcessObstacleTask(const CNavMesh::CTileData& TileData, CNavMap::CObstacleTask& Task, float AgentRadius, float AgentHeight)
+{
+	ZoneScoped;
+
+	float Verts[DT_VERTS_PER_POLYGON * 3];
+	for (int i = 0; i < TileData.pHeader->polyCount; ++i)
+	{
+		const dtPoly& Poly = TileData.pPolys[i];
+		if (Poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION || !Poly.vertCount) continue;
+
+		float PolyMin[3], PolyMax[3];
+		dtVcopy(PolyMin, &TileData.pVerts[Poly.verts[0] * 3]);
+		dtVcopy(PolyMax, PolyMin);
+		for (int j = 0; j < Poly.vertCount; ++j)
+		{
+			const float* pVertex = &TileData.pVerts[Poly.verts[j] * 3];
+			dtVcopy(&Verts[j * 3], pVertex);
+			dtVmin(PolyMin, pVertex);
+			dtVmax(PolyMax, pVertex);
+		}
+
+		for (const auto& Obstacle : Task.Obstacles)
+		{
+			if (IsPolyBlocked(Verts, Poly.vertCount, PolyMin, PolyMax, Obstacle, AgentRadius, AgentHeight))
+			{
+				Task.BlockedPolys.push_back(static_cast<U16>(i));
+				break;
+			}
+		}
+	}
+}
+//---------------------------------------------------------------------
 
 CNavMap::CNavMap(float AgentRadius, float AgentHeight, Resources::PResource NavMesh)
 	: _AgentRadius(AgentRadius)
@@ -13,7 +85,164 @@ CNavMap::CNavMap(float AgentRadius, float AgentHeight, Resources::PResource NavM
 }
 //---------------------------------------------------------------------
 
-CNavMap::~CNavMap() = default;
+CNavMap::~CNavMap()
+{
+	// Jobs write to obstacle tasks and read tile data
+	FinishObstacleJobs();
+
+	if (_pNavQuery) dtFreeNavMeshQuery(_pNavQuery);
+}
+//---------------------------------------------------------------------
+
+// Tiles must be added and removed only when no job reads them. Poly flags changed by obstacles are written
+// to the tile data in the navmesh resource, so they survive streaming and are seen by Detour when the tile is added.
+void CNavMap::Update(const rtm::vector4f* pCOIArray, UPTR COICount, Jobs::CWorker* pWorker)
+{
+	ZoneScoped;
+
+	auto pNavMesh = GetNavMesh();
+	if (!pNavMesh || !pNavMesh->GetDetourNavMesh()) return;
+
+	FinishObstacleJobs();
+	ApplyObstacleTasks(*pNavMesh);
+
+	if (pNavMesh->IsTiled() && _StreamingDistance > 0.f && pCOIArray && COICount)
+		UpdateTileStreaming(*pNavMesh, pCOIArray, COICount);
+
+	if (_DirtyTiles.empty()) return;
+
+	// Collect obstacles for each dirty tile, so that jobs don't access the obstacle map
+	std::sort(_DirtyTiles.begin(), _DirtyTiles.end());
+	_DirtyTiles.erase(std::unique(_DirtyTiles.begin(), _DirtyTiles.end()), _DirtyTiles.end());
+	_BlockedPolys.resize(pNavMesh->GetTileCount());
+
+	for (const UPTR TileIndex : _DirtyTiles)
+	{
+		const auto* pHeader = pNavMesh->GetTileData(TileIndex).pHeader;
+		if (!pHeader) continue;
+
+		auto& Task = _ObstacleTasks.emplace_back();
+		Task.TileIndex = TileIndex;
+		for (const auto& [ID, Obstacle] : _Obstacles)
+		{
+			if (Obstacle.Min[0] - _AgentRadius <= pHeader->bmax[0] && Obstacle.Max[0] + _AgentRadius >= pHeader->bmin[0] &&
+				Obstacle.Min[2] - _AgentRadius <= pHeader->bmax[2] && Obstacle.Max[2] + _AgentRadius >= pHeader->bmin[2] &&
+				Obstacle.Min[1] <= pHeader->bmax[1] && Obstacle.Max[1] >= pHeader->bmin[1] - _AgentHeight)
+			{
+				Task.Obstacles.push_back(Obstacle);
+			}
+		}
+	}
+	_DirtyTiles.clear();
+
+	// Results are applied in the next update, when the tile data is not used by path searches
+	const float AgentRadius = _AgentRadius;
+	const float AgentHeight = _AgentHeight;
+	if (pWorker)
+	{
+		_pObstacleWorker = pWorker;
+		for (auto& Task : _ObstacleTasks)
+		{
+			pWorker->AddJob(_ObstacleJobs, [TileData = pNavMesh->GetTileData(Task.TileIndex), pTask = &Task, AgentRadius, AgentHeight]()
+			{
+				ProcessObstacleTask(TileData, *pTask, AgentRadius, AgentHeight);
+			});
+		}
+	}
+	else
+	{
+		for (auto& Task : _ObstacleTasks)
+			ProcessObstacleTask(pNavMesh->GetTileData(Task.TileIndex), Task, AgentRadius, AgentHeight);
+		ApplyObstacleTasks(*pNavMesh);
+	}
+}
+//---------------------------------------------------------------------
+
+void CNavMap::FinishObstacleJobs()
+{
+	if (_ObstacleJobs)
+	{
+		n_assert_dbg(_pObstacleWorker);
+		_pObstacleWorker->WaitActive(_ObstacleJobs);
+		_ObstacleJobs.reset();
+	}
+	_pObstacleWorker = nullptr;
+}
+//---------------------------------------------------------------------
+
+// Blocks polys found by obstacle tasks and restores flags of polys that are not blocked anymore
+void CNavMap::ApplyObstacleTasks(CNavMesh& NavMesh)
+{
+	if (_ObstacleTasks.empty()) return;
+
+	ZoneScoped;
+
+	std::vector<CBlockedPoly> NewBlocked;
+	for (const auto& Task : _ObstacleTasks)
+	{
+		auto& Blocked = _BlockedPolys[Task.TileIndex];
+		dtPoly* pPolys = NavMesh.GetTileData(Task.TileIndex).pPolys;
+
+		NewBlocked.clear();
+		NewBlocked.reserve(Task.BlockedPolys.size());
+		auto It = Blocked.cbegin();
+		for (const U16 PolyIndex : Task.BlockedPolys)
+		{
+			for (; It != Blocked.cend() && It->PolyIndex < PolyIndex; ++It)
+				pPolys[It->PolyIndex].flags = It->SavedFlags;
+
+			if (It != Blocked.cend() && It->PolyIndex == PolyIndex)
+			{
+				NewBlocked.push_back(*It);
+				++It;
+			}
+			else
+			{
+				// Zero flags pass no filter in Detour
+				NewBlocked.push_back({ PolyIndex, pPolys[PolyIndex].flags });
+				pPolys[PolyIndex].flags = 0;
+			}
+		}
+
+		for (; It != Blocked.cend(); ++It)
+			pPolys[It->PolyIndex].flags = It->SavedFlags;
+
+		Blocked.swap(NewBlocked);
+	}
+
+	_ObstacleTasks.clear();
+}
+//---------------------------------------------------------------------
+
+// Poly refs don't change when a tile is removed and added back, so _Controllers and regions need no update
+void CNavMap::UpdateTileStreaming(CNavMesh& NavMesh, const rtm::vector4f* pCOIArray, UPTR COICount)
+{
+	ZoneScoped;
+
+	const float AddDistanceSq = _StreamingDistance * _StreamingDistance;
+	const float RemoveDistanceSq = AddDistanceSq * STREAMING_REMOVE_DISTANCE_FACTOR * STREAMING_REMOVE_DISTANCE_FACTOR;
+
+	for (UPTR i = 0; i < NavMesh.GetTileCount(); ++i)
+	{
+		const auto* pHeader = NavMesh.GetTileData(i).pHeader;
+
+		float MinDistanceSq = std::numeric_limits<float>().max();
+		for (UPTR COIIdx = 0; COIIdx < COICount; ++COIIdx)
+		{
+			const float x = rtm::vector_get_x(pCOIArray[COIIdx]);
+			const float z = rtm::vector_get_z(pCOIArray[COIIdx]);
+			const float dx = std::max({ pHeader->bmin[0] - x, 0.f, x - pHeader->bmax[0] });
+			const float dz = std::max({ pHeader->bmin[2] - z, 0.f, z - pHeader->bmax[2] });
+			MinDistanceSq = std::min(MinDistanceSq, dx * dx + dz * dz);
+		}
+
+		const bool IsAdded = NavMesh.IsTileAdded(i);
+		if (!IsAdded && MinDistanceSq <= AddDistanceSq)
+			NavMesh.AddTile(i);
+		else if (IsAdded && MinDistanceSq > RemoveDistanceSq)
+			NavMesh.RemoveTile(i);
+	}
+}
 //---------------------------------------------------------------------
 
 const CNavRegion* CNavMap::FindRegion(CStrID ID) const
@@ -23,22 +252,35 @@ const CNavRegion* CNavMap::FindRegion(CStrID ID) const
 }
 //---------------------------------------------------------------------
 
+// Flags are written to the tile data directly, so they are set even for polys in tiles that are streamed out
 void CNavMap::SetRegionFlags(CStrID RegionID, U16 Flags, bool On)
 {
 	if (!Flags) return;
 
-	auto pRegion = FindRegion(RegionID);
+	auto pNavMesh = GetNavMesh();
+	auto pRegion = pNavMesh ? pNavMesh->FindRegion(RegionID) : nullptr;
 	if (!pRegion) return;
 
-	auto pDtNavMesh = GetDetourNavMesh();
-	U16 CurrFlags;
+	// Obstacle jobs don't read flags, so there is no need to wait for them
+	auto pDtNavMesh = pNavMesh->GetDetourNavMesh();
 	for (auto PolyRef : *pRegion)
 	{
-		if (dtStatusSucceed(pDtNavMesh->getPolyFlags(PolyRef, &CurrFlags)))
+		auto pPoly = pNavMesh->GetPolyData(PolyRef);
+		if (!pPoly) continue;
+
+		// Polys blocked by obstacles receive new flags when unblocked
+		U16* pFlags = &pPoly->flags;
+		const UPTR TileIndex = pNavMesh->FindTileIndex(PolyRef);
+		if (TileIndex < _BlockedPolys.size())
 		{
-			const U16 NewFlags = On ? (CurrFlags | Flags) : (CurrFlags & ~Flags);
-			if (NewFlags != CurrFlags) pDtNavMesh->setPolyFlags(PolyRef, NewFlags);
+			auto& Blocked = _BlockedPolys[TileIndex];
+			const auto PolyIndex = static_cast<U16>(pDtNavMesh->decodePolyIdPoly(PolyRef));
+			auto It = std::lower_bound(Blocked.begin(), Blocked.end(), PolyIndex,
+				[](const CBlockedPoly& Elm, U16 Value) { return Elm.PolyIndex < Value; });
+			if (It != Blocked.end() && It->PolyIndex == PolyIndex) pFlags = &It->SavedFlags;
 		}
+
+		*pFlags = On ? (*pFlags | Flags) : (*pFlags & ~Flags);
 	}
 }
 //---------------------------------------------------------------------
@@ -78,6 +320,79 @@ Game::HEntity CNavMap::GetPolyController(dtPolyRef PolyRef) const
 }
 //---------------------------------------------------------------------
 
+void CNavMap::MarkTilesDirty(const CObstacle& Obstacle)
+{
+	auto pNavMesh = GetNavMesh();
+	if (!pNavMesh) return;
+
+	for (UPTR i = 0; i < pNavMesh->GetTileCount(); ++i)
+	{
+		const auto* pHeader = pNavMesh->GetTileData(i).pHeader;
+		if (Obstacle.Min[0] - _AgentRadius <= pHeader->bmax[0] && Obstacle.Max[0] + _AgentRadius >= pHeader->bmin[0] &&
+			Obstacle.Min[2] - _AgentRadius <= pHeader->bmax[2] && Obstacle.Max[2] + _AgentRadius >= pHeader->bmin[2])
+		{
+			_DirtyTiles.push_back(i);
+		}
+	}
+}
+//---------------------------------------------------------------------
+
+// Cylindrical obstacle standing on the Position. Setting an existing ID moves the obstacle.
+void CNavMap::SetObstacle(Game::HEntity ID, const rtm::vector4f& Position, float Radius, float Height)
+{
+	const float x = rtm::vector_get_x(Position);
+	const float y = rtm::vector_get_y(Position);
+	const float z = rtm::vector_get_z(Position);
+	const CObstacle Obstacle{ { x - Radius, y, z - Radius }, { x + Radius, y + Height, z + Radius }, std::max(Radius, 0.001f) };
+
+	auto It = _Obstacles.find(ID);
+	if (It != _Obstacles.cend())
+	{
+		MarkTilesDirty(It->second);
+		It->second = Obstacle;
+	}
+	else
+	{
+		_Obstacles.emplace(ID, Obstacle);
+	}
+
+	MarkTilesDirty(Obstacle);
+}
+//---------------------------------------------------------------------
+
+// Axis-aligned box obstacle. Setting an existing ID moves the obstacle.
+void CNavMap::SetBoxObstacle(Game::HEntity ID, const rtm::vector4f& Min, const rtm::vector4f& Max)
+{
+	CObstacle Obstacle;
+	rtm::vector_store3(rtm::vector_min(Min, Max), Obstacle.Min);
+	rtm::vector_store3(rtm::vector_max(Min, Max), Obstacle.Max);
+	Obstacle.Radius = 0.f;
+
+	auto It = _Obstacles.find(ID);
+	if (It != _Obstacles.cend())
+	{
+		MarkTilesDirty(It->second);
+		It->second = Obstacle;
+	}
+	else
+	{
+		_Obstacles.emplace(ID, Obstacle);
+	}
+
+	MarkTilesDirty(Obstacle);
+}
+//---------------------------------------------------------------------
+
+void CNavMap::RemoveObstacle(Game::HEntity ID)
+{
+	auto It = _Obstacles.find(ID);
+	if (It == _Obstacles.cend()) return;
+
+	MarkTilesDirty(It->second);
+	_Obstacles.erase(It);
+}
+//---------------------------------------------------------------------
+
 CNavMesh* CNavMap::GetNavMesh() const
 {
 	return _NavMesh ? _NavMesh->ValidateObject<CNavMesh>() : nullptr;
@@ -91,4 +406,23 @@ dtNavMesh* CNavMap::GetDetourNavMesh() const
 }
 //---------------------------------------------------------------------
 
+dtNavMeshQuery* CNavMap::GetNavQuery()
+{
+	if (!_pNavQuery)
+	{
+		auto pDtNavMesh = GetDetourNavMesh();
+		if (!pDtNavMesh) return nullptr;
+
+		_pNavQuery = dtAllocNavMeshQuery();
+		if (_pNavQuery && dtStatusFailed(_pNavQuery->init(pDtNavMesh, 512)))
+		{
+			dtFreeNavMeshQuery(_pNavQuery);
+			_pNavQuery = nullptr;
+		}
+	}
+
+	return _pNavQuery;
+}
+//---------------------------------------------------------------------
+
 }
@@ -2,36 +2,82 @@
 #include <Data/RefCounted.h>
 #include <AI/Navigation/NavMesh.h>
 #include <Game/ECS/Entity.h>
+#include <Jobs/Worker.h>
+#include <rtm/vector4f.h>
 
-// Navigation map used by agents to navigate over the game level
+// Navigation map used by agents to navigate over the game level.
+// Tiles of a tiled navmesh can be streamed in and out of the Detour navmesh around COIs. Tiles keep their
+// refs, so poly refs stored in regions, controllers and agent corridors remain valid when a tile returns.
+// Dynamic obstacles like closed doors and debris block navmesh polys they overlap. Affected tiles are
+// reprocessed in jobs and results are applied in the next update, so that blocking doesn't stall the frame.
 
 namespace Resources
 {
 	using PResource = Ptr<class CResource>;
 }
 
+class dtNavMeshQuery;
+
 namespace DEM::AI
 {
 using PNavMap = Ptr<class CNavMap>;
 
 class CNavMap : public ::Data::CRefCounted
 {
+public:
+
+	struct CObstacle
+	{
+		float Min[3];
+		float Max[3];
+		float Radius; // Cylinder radius, 0 for boxes
+	};
+
+	struct CObstacleTask
+	{
+		UPTR                   TileIndex;
+		std::vector<CObstacle> Obstacles;
+		std::vector<U16>       BlockedPolys; // Sorted poly indices, filled by the job
+	};
+
 protected:
 
+	struct CBlockedPoly
+	{
+		U16 PolyIndex;
+		U16 SavedFlags; // Flags the poly had before it was blocked
+	};
+
 	// Stored to be able to sort navmaps in a level even when namesh resource is not loaded
-	//???need? will ever load navmesh on the fly? for optional big enemy?
 	float                _AgentRadius;
 	float                _AgentHeight;
 
 	Resources::PResource _NavMesh;
+	dtNavMeshQuery*      _pNavQuery = nullptr; // Shared by agents for synchronous queries on the main thread
 
 	std::vector<std::pair<dtPolyRef, Game::HEntity>> _Controllers; // Sorted by polyref
 
+	float                _StreamingDistance = 0.f; // Tiles further than this from all COIs are removed, 0 to keep all tiles
+
+	std::unordered_map<Game::HEntity, CObstacle> _Obstacles;
+	std::vector<std::vector<CBlockedPoly>>       _BlockedPolys; // Per navmesh tile, sorted by poly index
+	std::vector<UPTR>                            _DirtyTiles;
+	std::vector<CObstacleTask>                   _ObstacleTasks;
+	Jobs::CJobCounter                            _ObstacleJobs;
+	Jobs::CWorker*                               _pObstacleWorker = nullptr; // The worker that started _ObstacleJobs
+
+	void MarkTilesDirty(const CObstacle& Obstacle);
+	void FinishObstacleJobs();
+	void ApplyObstacleTasks(CNavMesh& NavMesh);
+	void UpdateTileStreaming(CNavMesh& NavMesh, const rtm::vector4f* pCOIArray, UPTR COICount);
+
 public:
 
 	CNavMap(float AgentRadius, float AgentHeight, Resources::PResource NavMesh);
 	virtual ~CNavMap() override;
 
+	void              Update(const rtm::vector4f* pCOIArray, UPTR COICount, Jobs::CWorker* pWorker = nullptr);
+
 	float             GetAgentRadius() const { return _AgentRadius; }
 	float             GetAgentHeight() const { return _AgentHeight; }
 	const CNavRegion* FindRegion(CStrID ID) const;
@@ -39,8 +85,13 @@ public:
 	void              SetRegionController(CStrID RegionID, Game::HEntity Controller);
 	void              RemoveController(Game::HEntity Controller);
 	Game::HEntity     GetPolyController(dtPolyRef PolyRef) const;
+	void              SetStreamingDistance(float Distance) { _StreamingDistance = std::max(0.f, Distance); }
+	void              SetObstacle(Game::HEntity ID, const rtm::vector4f& Position, float Radius, float Height);
+	void              SetBoxObstacle(Game::HEntity ID, const rtm::vector4f& Min, const rtm::vector4f& Max);
+	void              RemoveObstacle(Game::HEntity ID);
 	CNavMesh*         GetNavMesh() const;
 	dtNavMesh*        GetDetourNavMesh() const;
+	dtNavMeshQuery*   GetNavQuery();
 };
 
 }
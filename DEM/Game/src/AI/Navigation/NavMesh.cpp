@@ -1,5 +1,6 @@
 #include "NavMesh.h"
 #include <DetourNavMesh.h>
+#include <DetourCommon.h>
 
 namespace DEM::AI
 {
@@ -7,12 +8,54 @@ namespace DEM::AI
 CNavMesh::CNavMesh(float AgentRadius, float AgentHeight, std::vector<U8>&& RawData, std::map<CStrID, CNavRegion>&& Regions)
 	: _AgentRadius(AgentRadius)
 	, _AgentHeight(AgentHeight)
-	, _NavMeshData(std::move(RawData))
 	, _Regions(std::move(Regions))
 {
+	_Tiles.push_back({ 0, std::move(RawData) });
+	auto& Tile = _Tiles.back();
+
 	if (_pNavMesh = dtAllocNavMesh())
-		if (dtStatusFailed(_pNavMesh->init(_NavMeshData.data(), _NavMeshData.size(), 0)))
+	{
+		if (dtStatusFailed(_pNavMesh->init(Tile.Data.data(), Tile.Data.size(), 0)))
+		{
 			dtFreeNavMesh(_pNavMesh);
+			_pNavMesh = nullptr;
+		}
+		else
+		{
+			Tile.Ref = _pNavMesh->getTileRef(_pNavMesh->getTile(0));
+			_TileIndices.emplace(0, 0);
+		}
+	}
+}
+//---------------------------------------------------------------------
+
+CNavMesh::CNavMesh(float AgentRadius, float AgentHeight, const dtNavMeshParams& Params, std::vector<CTile>&& Tiles, std::map<CStrID, CNavRegion>&& Regions)
+	: _AgentRadius(AgentRadius)
+	, _AgentHeight(AgentHeight)
+	, _Tiles(std::move(Tiles))
+	, _Regions(std::move(Regions))
+	, _Tiled(true)
+{
+	_pNavMesh = dtAllocNavMesh();
+	if (!_pNavMesh) return;
+
+	if (dtStatusFailed(_pNavMesh->init(&Params)))
+	{
+		dtFreeNavMesh(_pNavMesh);
+		_pNavMesh = nullptr;
+		return;
+	}
+
+	for (UPTR i = 0; i < _Tiles.size(); ++i)
+	{
+		_TileIndices.emplace(_pNavMesh->decodePolyIdTile(_Tiles[i].Ref), i);
+		if (!AddTile(i))
+		{
+			dtFreeNavMesh(_pNavMesh);
+			_pNavMesh = nullptr;
+			return;
+		}
+	}
 }
 //---------------------------------------------------------------------
 
@@ -29,4 +72,65 @@ const CNavRegion* CNavMesh::FindRegion(CStrID ID) const
 }
 //---------------------------------------------------------------------
 
+UPTR CNavMesh::FindTileIndex(dtPolyRef PolyRef) const
+{
+	if (!_pNavMesh) return _Tiles.size();
+	auto It = _TileIndices.find(static_cast<int>(_pNavMesh->decodePolyIdTile(PolyRef)));
+	return (It == _TileIndices.cend()) ? _Tiles.size() : It->second;
+}
+//---------------------------------------------------------------------
+
+// Follows the tile data layout from dtNavMesh::addTile
+CNavMesh::CTileData CNavMesh::GetTileData(UPTR Index)
+{
+	CTileData Result;
+	if (Index >= _Tiles.size()) return Result;
+
+	U8* pData = _Tiles[Index].Data.data();
+	Result.pHeader = reinterpret_cast<const dtMeshHeader*>(pData);
+	const int HeaderSize = dtAlign4(sizeof(dtMeshHeader));
+	const int VertsSize = dtAlign4(sizeof(float) * 3 * Result.pHeader->vertCount);
+	Result.pVerts = reinterpret_cast<const float*>(pData + HeaderSize);
+	Result.pPolys = reinterpret_cast<dtPoly*>(pData + HeaderSize + VertsSize);
+	return Result;
+}
+//---------------------------------------------------------------------
+
+// Returns the poly even if its tile is not added to the Detour navmesh. Salt is not checked.
+dtPoly* CNavMesh::GetPolyData(dtPolyRef PolyRef)
+{
+	const auto TileData = GetTileData(FindTileIndex(PolyRef));
+	if (!TileData.pHeader) return nullptr;
+
+	const auto PolyIndex = _pNavMesh->decodePolyIdPoly(PolyRef);
+	return (PolyIndex < static_cast<unsigned int>(TileData.pHeader->polyCount)) ? TileData.pPolys + PolyIndex : nullptr;
+}
+//---------------------------------------------------------------------
+
+// Zero flags mean that the navmesh doesn't own tile data. The saved ref is restored, so poly refs don't change.
+bool CNavMesh::AddTile(UPTR Index)
+{
+	if (!_pNavMesh || Index >= _Tiles.size()) return false;
+	if (IsTileAdded(Index)) return true;
+
+	auto& Tile = _Tiles[Index];
+	return dtStatusSucceed(_pNavMesh->addTile(Tile.Data.data(), static_cast<int>(Tile.Data.size()), 0, Tile.Ref, nullptr));
+}
+//---------------------------------------------------------------------
+
+bool CNavMesh::RemoveTile(UPTR Index)
+{
+	if (!IsTileAdded(Index)) return true;
+	return dtStatusSucceed(_pNavMesh->removeTile(_Tiles[Index].Ref, nullptr, nullptr));
+}
+//---------------------------------------------------------------------
+
+bool CNavMesh::IsTileAdded(UPTR Index) const
+{
+	if (!_pNavMesh || Index >= _Tiles.size()) return false;
+	const auto* pTile = _pNavMesh->getTileByRef(_Tiles[Index].Ref);
+	return pTile && pTile->header;
+}
+//---------------------------------------------------------------------
+
 }
@@ -3,8 +3,11 @@
 #include <Core/Object.h>
 #include <Data/StringID.h>
 #include <map>
+#include <unordered_map>
 
-// Navigation mesh for predefined agent parameters
+// Navigation mesh for predefined agent parameters. Can be a single tile or a set of tiles with fixed refs.
+// Tile data is owned by this object and Detour works with it in place, so tiles can be removed from
+// and returned to the Detour navmesh at runtime without invalidating poly refs or losing poly flags.
 
 namespace DEM::AI
 {
@@ -13,24 +16,52 @@ class CNavMesh : public DEM::Core::CObject
 {
 	RTTI_CLASS_DECL(DEM::AI::CNavMesh, DEM::Core::CObject);
 
+public:
+
+	struct CTile
+	{
+		dtTileRef       Ref;  // Saved at build time, so that refs in regions are valid regardless of the tile add order
+		std::vector<U8> Data;
+	};
+
+	// Direct access to the tile data, valid even when the tile is not added to the Detour navmesh
+	struct CTileData
+	{
+		const dtMeshHeader* pHeader = nullptr;
+		const float*        pVerts = nullptr;
+		dtPoly*             pPolys = nullptr;
+	};
+
 protected:
 
 	float                        _AgentRadius = 0.f;
 	float                        _AgentHeight = 0.f;
 
 	dtNavMesh*                   _pNavMesh = nullptr;
-	std::vector<U8>              _NavMeshData;
+	std::vector<CTile>           _Tiles;
+	std::unordered_map<int, UPTR> _TileIndices; // Detour tile index -> index in _Tiles
+	bool                         _Tiled = false;
 
 	std::map<CStrID, CNavRegion> _Regions;
 
 public:
 
 	CNavMesh(float AgentRadius, float AgentHeight, std::vector<U8>&& RawData, std::map<CStrID, CNavRegion>&& Regions);
+	CNavMesh(float AgentRadius, float AgentHeight, const dtNavMeshParams& Params, std::vector<CTile>&& Tiles, std::map<CStrID, CNavRegion>&& Regions);
 	virtual ~CNavMesh() override;
 
 	float             GetAgentRadius() const { return _AgentRadius; }
 	float             GetAgentHeight() const { return _AgentHeight; }
 	const CNavRegion* FindRegion(CStrID ID) const;
+	bool              IsTiled() const { return _Tiled; }
+
+	UPTR              GetTileCount() const { return _Tiles.size(); }
+	UPTR              FindTileIndex(dtPolyRef PolyRef) const;
+	CTileData         GetTileData(UPTR Index);
+	dtPoly*           GetPolyData(dtPolyRef PolyRef);
+	bool              AddTile(UPTR Index);
+	bool              RemoveTile(UPTR Index);
+	bool              IsTileAdded(UPTR Index) const;
 
 	dtNavMesh*        GetDetourNavMesh() const { return _pNavMesh; }
 };
@@ -2,6 +2,7 @@
 #include <AI/Navigation/NavMesh.h>
 #include <Resources/ResourceManager.h>
 #include <IO/BinaryReader.h>
+#include <DetourNavMesh.h>
 
 namespace Resources
 {
@@ -31,11 +32,42 @@ DEM::Core::PObject CNavMeshLoaderNM::CreateResource(CStrID UID)
 	if (!Reader.Read(H)) return nullptr;
 	//???need other agent params too?
 
-	U32 DataSize;
-	if (!Reader.Read(DataSize) || !DataSize) return nullptr;
+	std::vector<U8> RawData;
+	std::vector<DEM::AI::CNavMesh::CTile> Tiles;
+	dtNavMeshParams Params;
+	if (Version == 0x00010000)
+	{
+		// Single tile navmesh
+		U32 DataSize;
+		if (!Reader.Read(DataSize) || !DataSize) return nullptr;
 
-	std::vector<U8> RawData(DataSize);
-	if (Stream->Read(RawData.data(), DataSize) != DataSize) return nullptr;
+		RawData.resize(DataSize);
+		if (Stream->Read(RawData.data(), DataSize) != DataSize) return nullptr;
+	}
+	else if (Version == 0x00020000)
+	{
+		// Tiled navmesh
+		U32 MaxTiles, MaxPolys;
+		if (!Reader.Read(Params.orig[0]) || !Reader.Read(Params.orig[1]) || !Reader.Read(Params.orig[2])) return nullptr;
+		if (!Reader.Read(Params.tileWidth) || !Reader.Read(Params.tileHeight)) return nullptr;
+		if (!Reader.Read(MaxTiles) || !Reader.Read(MaxPolys)) return nullptr;
+		Params.maxTiles = static_cast<int>(MaxTiles);
+		Params.maxPolys = static_cast<int>(MaxPolys);
+
+		U32 TileCount;
+		if (!Reader.Read(TileCount) || !TileCount) return nullptr;
+
+		Tiles.resize(TileCount);
+		for (auto& Tile : Tiles)
+		{
+			U32 DataSize;
+			if (!Reader.Read(Tile.Ref) || !Reader.Read(DataSize) || !DataSize) return nullptr;
+
+			Tile.Data.resize(DataSize);
+			if (Stream->Read(Tile.Data.data(), DataSize) != DataSize) return nullptr;
+		}
+	}
+	else return nullptr;
 
 	U32 RegionCount;
 	if (!Reader.Read<U32>(RegionCount)) return nullptr;
@@ -55,6 +87,9 @@ DEM::Core::PObject CNavMeshLoaderNM::CreateResource(CStrID UID)
 		Regions.emplace(ID, std::move(Region));
 	}
 
+	if (!Tiles.empty())
+		return n_new(DEM::AI::CNavMesh(R, H, Params, std::move(Tiles), std::move(Regions)));
+
 	return n_new(DEM::AI::CNavMesh(R, H, std::move(RawData), std::move(Regions)));
 }
 //---------------------------------------------------------------------
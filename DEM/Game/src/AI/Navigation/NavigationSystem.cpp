@@ -9,6 +9,7 @@
 #include <AI/Navigation/NavMeshDebugDraw.h>
 #include <AI/Movement/SteerAction.h> // FIXME: only for Steer::SqLinearTolerance, can write better?
 #include <Physics/CharacterControllerComponent.h>
+#include <Jobs/JobSystem.h>
 #include <Debug/DebugDraw.h>
 #include <DetourCommon.h>
 #include <DetourDebugDraw.h>
@@ -266,9 +267,11 @@ static void RequestPath(CNavAgentComponent& Agent, CPathRequestQueue& PathQueue,
 		else
 			Agent.Corridor.setCorridor(Agent.Corridor.getPos(), Agent.Corridor.getPath(), 1);
 
-		// Request async path planning
+		// Request async path planning. Agents that can't even start moving are served first.
+		const float Priority = (Agent.Corridor.getPathCount() > 1) ? 0.f : 1.f;
 		if (AsyncPathTaskID) PathQueue.CancelRequest(AsyncPathTaskID);
-		AsyncPathTaskID = PathQueue.Request(Agent.Corridor.getLastPoly(), Agent.TargetRef, Agent.Corridor.getTarget(), Agent.TargetPos.v, Agent.pNavQuery, pNavFilter);
+		AsyncPathTaskID = PathQueue.Request(Agent.Corridor.getLastPoly(), Agent.TargetRef, Agent.Corridor.getTarget(), Agent.TargetPos.v,
+			Agent.NavMap->GetDetourNavMesh(), pNavFilter, Priority);
 		if (AsyncPathTaskID) Agent.State = ENavigationState::Planning;
 	}
 }
@@ -481,11 +484,7 @@ void InitNavigationAgents(Game::CGameWorld& World, Game::CGameLevel& Level, Reso
 
 		NavAgent.NavMap = Level.GetNavMap(NavAgent.Radius, NavAgent.Height);
 		if (NavAgent.NavMap)
-		{
-			//!!!???pooled queries? don't allocate one per agent?!
-			NavAgent.pNavQuery = dtAllocNavMeshQuery();
-			NavAgent.pNavQuery->init(NavAgent.NavMap->GetDetourNavMesh(), 512);
-		}
+			NavAgent.pNavQuery = NavAgent.NavMap->GetNavQuery();
 	});
 }
 //---------------------------------------------------------------------
@@ -606,8 +605,8 @@ static ECommandStatus ProcessAgentNavigation(DEM::Game::CGameSession& Session, G
 }
 //---------------------------------------------------------------------
 
-// NB: PathQueue is updated here, after components
-void ProcessNavigation(DEM::Game::CGameSession& Session, float dt, CPathRequestQueue& PathQueue, bool IsNewFrame)
+// NB: PathQueue is updated here, after components. Pass nullptr as pWorker to search paths on the calling thread.
+void ProcessNavigation(DEM::Game::CGameSession& Session, float dt, CPathRequestQueue& PathQueue, bool IsNewFrame, Jobs::CWorker* pWorker)
 {
 	auto pWorld = Session.FindFeature<DEM::Game::CGameWorld>();
 	if (!pWorld) return;
@@ -654,8 +653,7 @@ void ProcessNavigation(DEM::Game::CGameSession& Session, float dt, CPathRequestQ
 	});
 
 	// Execute async path requests
-	// FIXME: use multithreading!
-	PathQueue.Update(100);
+	PathQueue.Update(100, pWorker);
 }
 //---------------------------------------------------------------------
 
@@ -744,11 +742,8 @@ void DestroyNavigationAgent(Game::CGameWorld& World, CPathRequestQueue& PathQueu
 		FinalizeNavigationCommands(*pCmdStack, PathQueue);
 	}
 
-	if (Agent.pNavQuery)
-	{
-		dtFreeNavMeshQuery(Agent.pNavQuery);
-		Agent.pNavQuery = nullptr;
-	}
+	// The query is owned by the navmap
+	Agent.pNavQuery = nullptr;
 }
 //---------------------------------------------------------------------
 
@@ -1,166 +1,325 @@
 #include "PathRequestQueue.h"
 
 #include <System/System.h>
+#include <Jobs/JobSystem.h>
 #include <DetourCommon.h>
 #include <DetourNavMeshQuery.h>
 #include <memory.h> // memcpy
 
 namespace DEM::AI
 {
+constexpr U8 MAX_KEEP_ALIVE = 2;                 // In update ticks
+constexpr float PRIORITY_PER_WAITED_TICK = 0.1f; // Aging prevents starvation of low priority requests
+constexpr float COALESCE_DISTANCE_SQ = 0.01f;
+constexpr size_t SEARCHES_PER_JOB = 4;
 
-void CPathRequestQueue::Purge()
+static void UpdateSearch(dtNavMeshQuery& NavQuery, dtStatus& Status, const dtPolyRef StartRef, const dtPolyRef EndRef,
+	const float* pStartPos, const float* pEndPos, const dtQueryFilter* pFilter, dtPolyRef* pPath, int& PathSize, int MaxPathSize, int MaxIters)
 {
-	for (int i = 0; i < MAX_QUEUE; ++i)
+	if (Status == 0)
 	{
-		dtFree(Queue[i].pPath);
-		Queue[i].pPath = nullptr;
+		Status = NavQuery.initSlicedFindPath(StartRef, EndRef, pStartPos, pEndPos, pFilter);
+		if (dtStatusSucceed(Status))
+			Status = NavQuery.finalizeSlicedFindPath(pPath, &PathSize, MaxPathSize);
 	}
+
+	if (dtStatusInProgress(Status))
+	{
+		Status = NavQuery.updateSlicedFindPath(MaxIters, nullptr);
+		if (dtStatusSucceed(Status))
+			Status = NavQuery.finalizeSlicedFindPath(pPath, &PathSize, MaxPathSize);
+	}
+}
+//---------------------------------------------------------------------
+
+void CPathRequestQueue::Purge()
+{
+	for (auto& Search : _Searches)
+		if (Search.pNavQuery)
+			dtFreeNavMeshQuery(Search.pNavQuery);
+
+	for (auto [pNavMesh, pNavQuery] : _FreeNavQueries)
+		dtFreeNavMeshQuery(pNavQuery);
+
+	_Searches.clear();
+	_FreeSearches.clear();
+	_Requests.clear();
+	_FreeNavQueries.clear();
+	_ActiveSearches.clear();
 }
 //---------------------------------------------------------------------
 
-bool CPathRequestQueue::Init(int MaxPath)
+bool CPathRequestQueue::Init(int MaxPath, int MaxSearchNodes, U32 MaxActiveSearches)
 {
 	Purge();
-	
-	MaxPathSize = MaxPath;
-	for (int i = 0; i < MAX_QUEUE; ++i)
-		Queue[i].RequestID = 0;
-	
-	QueueHead = 0;
+
+	_MaxPathSize = MaxPath;
+	_MaxSearchNodes = MaxSearchNodes;
+	_MaxActiveSearches = std::max<U32>(MaxActiveSearches, 1);
+	_UpdateIndex = 0;
 	OK;
 }
 //---------------------------------------------------------------------
 
-void CPathRequestQueue::Update(int MaxIters)
+dtNavMeshQuery* CPathRequestQueue::AcquireNavQuery(dtNavMesh* pNavMesh)
+{
+	auto It = std::find_if(_FreeNavQueries.begin(), _FreeNavQueries.end(), [pNavMesh](const auto& Pair) { return Pair.first == pNavMesh; });
+	if (It != _FreeNavQueries.end())
+	{
+		auto* pNavQuery = It->second;
+		*It = _FreeNavQueries.back();
+		_FreeNavQueries.pop_back();
+		return pNavQuery;
+	}
+
+	auto* pNavQuery = dtAllocNavMeshQuery();
+	if (pNavQuery && dtStatusFailed(pNavQuery->init(pNavMesh, _MaxSearchNodes)))
+	{
+		dtFreeNavMeshQuery(pNavQuery);
+		return nullptr;
+	}
+
+	return pNavQuery;
+}
+//---------------------------------------------------------------------
+
+void CPathRequestQueue::ReleaseNavQuery(CPathSearch& Search)
+{
+	if (!Search.pNavQuery) return;
+	_FreeNavQueries.emplace_back(Search.pNavMesh, Search.pNavQuery);
+	Search.pNavQuery = nullptr;
+}
+//---------------------------------------------------------------------
+
+void CPathRequestQueue::ReleaseRequest(std::unordered_map<U16, U32>::iterator It)
+{
+	const U32 SearchIndex = It->second;
+	_Requests.erase(It);
+
+	auto& Search = _Searches[SearchIndex];
+	n_assert_dbg(Search.RefCount);
+	if (--Search.RefCount) return;
+
+	// The last interested requester is gone, stop the search
+	ReleaseNavQuery(Search);
+	Search.Status = 0;
+	_FreeSearches.push_back(SearchIndex);
+}
+//---------------------------------------------------------------------
+
+void CPathRequestQueue::Update(int MaxIters, Jobs::CWorker* pWorker)
 {
-	constexpr int MAX_KEEP_ALIVE = 2; // In update ticks
-	for (auto& Query : Queue)
+	ZoneScoped;
+
+	++_UpdateIndex;
+
+	// Drop results nobody has claimed for too long
+	for (auto It = _Requests.begin(); It != _Requests.end(); )
 	{
-		if (Query.RequestID && (dtStatusSucceed(Query.Status) || dtStatusFailed(Query.Status)))
+		const auto& Search = _Searches[It->second];
+		if ((dtStatusSucceed(Search.Status) || dtStatusFailed(Search.Status)) && Search.KeepAlive > MAX_KEEP_ALIVE)
 		{
-			++Query.KeepAlive;
-			if (Query.KeepAlive > MAX_KEEP_ALIVE)
-			{
-				Query.RequestID = 0;
-				Query.Status = 0;
-			}
+			auto ItToErase = It++;
+			ReleaseRequest(ItToErase);
 		}
+		else ++It;
+	}
+
+	// Select searches to advance. Already running ones go first, because they hold pooled queries.
+	_ActiveSearches.clear();
+	for (U32 i = 0; i < _Searches.size(); ++i)
+	{
+		auto& Search = _Searches[i];
+		if (!Search.RefCount) continue;
+
+		if (dtStatusSucceed(Search.Status) || dtStatusFailed(Search.Status))
+			++Search.KeepAlive;
+		else
+			_ActiveSearches.push_back(i);
 	}
 
-	int IterCount = MaxIters;	
-	for (int i = 0; i < MAX_QUEUE; ++i)
+	if (_ActiveSearches.empty()) return;
+
+	const auto GetEffectivePriority = [this](const CPathSearch& Search)
 	{
-		CPathQuery& Query = Queue[QueueHead % MAX_QUEUE];
-		
-		if (Query.RequestID == 0)
+		return Search.Priority + PRIORITY_PER_WAITED_TICK * static_cast<float>(_UpdateIndex - Search.RequestTime);
+	};
+
+	std::sort(_ActiveSearches.begin(), _ActiveSearches.end(), [this, &GetEffectivePriority](U32 a, U32 b)
+	{
+		const auto& SearchA = _Searches[a];
+		const auto& SearchB = _Searches[b];
+		if (!SearchA.pNavQuery != !SearchB.pNavQuery) return SearchA.pNavQuery != nullptr;
+		const float PriorityA = GetEffectivePriority(SearchA);
+		const float PriorityB = GetEffectivePriority(SearchB);
+		if (PriorityA != PriorityB) return PriorityA > PriorityB;
+		return SearchA.RequestTime < SearchB.RequestTime;
+	});
+
+	if (_ActiveSearches.size() > _MaxActiveSearches)
+		_ActiveSearches.resize(_MaxActiveSearches);
+
+	for (auto It = _ActiveSearches.begin(); It != _ActiveSearches.end(); )
+	{
+		auto& Search = _Searches[*It];
+		if (!Search.pNavQuery) Search.pNavQuery = AcquireNavQuery(Search.pNavMesh);
+		if (Search.pNavQuery)
+		{
+			++It;
+		}
+		else
 		{
-			++QueueHead;
-			continue;
+			Search.Status = DT_FAILURE;
+			It = _ActiveSearches.erase(It);
 		}
-		
-		if (Query.Status == 0)
+	}
+
+	// Advance searches. Navmesh is not modified during the update, so queries can run in parallel.
+	auto* pSearches = _Searches.data();
+	const auto MaxPathSize = _MaxPathSize;
+	const auto ProcessSearches = [pSearches, MaxPathSize, MaxIters](const U32* pBegin, const U32* pEnd)
+	{
+		ZoneScoped;
+
+		for (auto pIndex = pBegin; pIndex != pEnd; ++pIndex)
 		{
-			Query.Status = Query.pNavQuery->initSlicedFindPath(Query.StartRef, Query.EndRef, Query.StartPos, Query.EndPos, Query.pFilter);
-			if (dtStatusSucceed(Query.Status))
-				Query.Status = Query.pNavQuery->finalizeSlicedFindPath(Query.pPath, &Query.PathSize, MaxPathSize);
+			auto& Search = pSearches[*pIndex];
+			UpdateSearch(*Search.pNavQuery, Search.Status, Search.StartRef, Search.EndRef, Search.StartPos, Search.EndPos,
+				Search.pFilter, Search.Path.get(), Search.PathSize, MaxPathSize, MaxIters);
 		}
+	};
 
-		if (dtStatusInProgress(Query.Status))
+	const U32* pActive = _ActiveSearches.data();
+	const size_t ActiveCount = _ActiveSearches.size();
+	if (pWorker && ActiveCount > SEARCHES_PER_JOB)
+	{
+		Jobs::CJobCounter Counter;
+		for (size_t i = 0; i < ActiveCount; i += SEARCHES_PER_JOB)
 		{
-			int Iters = 0;
-			Query.Status = Query.pNavQuery->updateSlicedFindPath(IterCount, &Iters);
-			if (dtStatusSucceed(Query.Status))
-				Query.Status = Query.pNavQuery->finalizeSlicedFindPath(Query.pPath, &Query.PathSize, MaxPathSize);
-			IterCount -= Iters;
-			if (IterCount <= 0) break;
+			const U32* pBegin = pActive + i;
+			const U32* pEnd = pActive + std::min(i + SEARCHES_PER_JOB, ActiveCount);
+			pWorker->AddJob(Counter, [pBegin, pEnd, &ProcessSearches]() { ProcessSearches(pBegin, pEnd); });
 		}
+		pWorker->WaitActive(Counter);
+	}
+	else
+	{
+		ProcessSearches(pActive, pActive + ActiveCount);
+	}
 
-		++QueueHead;
+	// Return queries of finished searches to the pool
+	for (const U32 Index : _ActiveSearches)
+	{
+		auto& Search = _Searches[Index];
+		if (!dtStatusInProgress(Search.Status))
+			ReleaseNavQuery(Search);
 	}
 }
 //---------------------------------------------------------------------
 
 U16 CPathRequestQueue::Request(dtPolyRef RStart, dtPolyRef REnd, const float* pStart,
-								 const float* pEnd, dtNavMeshQuery* pNavQuery, const dtQueryFilter* pFilter)
+								 const float* pEnd, dtNavMesh* pNavMesh, const dtQueryFilter* pFilter, float Priority)
 {
-	n_assert(pStart && pEnd && pNavQuery);
+	n_assert(pStart && pEnd && pNavMesh);
 
-	int i;
-	for (i = 0; i < MAX_QUEUE; ++i)
-		if (Queue[i].RequestID == 0) break;
-
-	if (i == MAX_QUEUE)
+	// Requests are identified by 16-bit IDs, more simultaneous requests are unreasonable
+	if (_Requests.size() >= std::numeric_limits<U16>().max())
 	{
-		n_assert(false); // TODO: fix when it happens
+		n_assert(false);
 		return 0;
 	}
-	
-	CPathQuery& Query = Queue[i];
-	Query.RequestID = NextRequestID++;
-	if (NextRequestID == 0) NextRequestID++;
-	dtVcopy(Query.StartPos, pStart);
-	Query.StartRef = RStart;
-	dtVcopy(Query.EndPos, pEnd);
-	Query.EndRef = REnd;
-	Query.Status = 0;
-	Query.PathSize = 0;
-	Query.pNavQuery = pNavQuery;
-	Query.pFilter = pFilter;
-	Query.KeepAlive = 0;
-
-	if (!Queue[i].pPath)
-	{
-		Queue[i].pPath = (dtPolyRef*)dtAlloc(sizeof(dtPolyRef) * MaxPathSize, DT_ALLOC_PERM);
-		n_assert(Queue[i].pPath);
+
+	// Coalesce with a pending search for the same path, e.g. when a group of agents is ordered to the same location
+	U32 SearchIndex = static_cast<U32>(_Searches.size());
+	for (U32 i = 0; i < _Searches.size(); ++i)
+	{
+		const auto& Search = _Searches[i];
+		if (Search.RefCount && Search.Status == 0 && Search.StartRef == RStart && Search.EndRef == REnd &&
+			Search.pNavMesh == pNavMesh && Search.pFilter == pFilter &&
+			dtVdistSqr(Search.StartPos, pStart) < COALESCE_DISTANCE_SQ && dtVdistSqr(Search.EndPos, pEnd) < COALESCE_DISTANCE_SQ)
+		{
+			SearchIndex = i;
+			break;
+		}
 	}
 
-	return Query.RequestID;
+	if (SearchIndex < _Searches.size())
+	{
+		auto& Search = _Searches[SearchIndex];
+		++Search.RefCount;
+		Search.Priority = std::max(Search.Priority, Priority);
+	}
+	else
+	{
+		if (!_FreeSearches.empty())
+		{
+			SearchIndex = _FreeSearches.back();
+			_FreeSearches.pop_back();
+		}
+		else
+		{
+			_Searches.emplace_back();
+		}
+
+		auto& Search = _Searches[SearchIndex];
+		dtVcopy(Search.StartPos, pStart);
+		Search.StartRef = RStart;
+		dtVcopy(Search.EndPos, pEnd);
+		Search.EndRef = REnd;
+		Search.Status = 0;
+		Search.PathSize = 0;
+		Search.pNavMesh = pNavMesh;
+		Search.pFilter = pFilter;
+		Search.Priority = Priority;
+		Search.RequestTime = _UpdateIndex;
+		Search.RefCount = 1;
+		Search.KeepAlive = 0;
+
+		if (!Search.Path) Search.Path.reset(new dtPolyRef[_MaxPathSize]);
+	}
+
+	do
+	{
+		if (!++_NextRequestID) ++_NextRequestID;
+	}
+	while (_Requests.find(_NextRequestID) != _Requests.cend());
+
+	_Requests.emplace(_NextRequestID, SearchIndex);
+	return _NextRequestID;
 }
 //---------------------------------------------------------------------
 
 void CPathRequestQueue::CancelRequest(U16 RequestID)
 {
-	for (int i = 0; i < MAX_QUEUE; ++i)
-		if (Queue[i].RequestID == RequestID)
-		{
-			CPathQuery& Query = Queue[i];
-			Query.RequestID = 0;
-			Query.Status = 0;
-		}
+	auto It = _Requests.find(RequestID);
+	if (It != _Requests.end()) ReleaseRequest(It);
 }
 //---------------------------------------------------------------------
 
 dtStatus CPathRequestQueue::GetRequestStatus(U16 RequestID) const
 {
-	for (int i = 0; i < MAX_QUEUE; ++i)
-		if (Queue[i].RequestID == RequestID)
-			return Queue[i].Status;
-	return DT_FAILURE;
+	auto It = _Requests.find(RequestID);
+	return (It != _Requests.cend()) ? _Searches[It->second].Status : DT_FAILURE;
 }
 //---------------------------------------------------------------------
 
 dtStatus CPathRequestQueue::GetPathResult(U16 RequestID, dtPolyRef* pOutPath, int& OutSize, int MaxPath)
 {
-	for (int i = 0; i < MAX_QUEUE; ++i)
-		if (Queue[i].RequestID == RequestID)
-		{
-			CPathQuery& Query = Queue[i];
-			Query.RequestID = 0;
-			Query.Status = 0;
-			OutSize = dtMin(Query.PathSize, MaxPath);
-			std::memcpy(pOutPath, Query.pPath, sizeof(dtPolyRef) * OutSize);
-			return DT_SUCCESS;
-		}
-	return DT_FAILURE;
+	auto It = _Requests.find(RequestID);
+	if (It == _Requests.end()) return DT_FAILURE;
+
+	const auto& Search = _Searches[It->second];
+	OutSize = dtMin(Search.PathSize, MaxPath);
+	std::memcpy(pOutPath, Search.Path.get(), sizeof(dtPolyRef) * OutSize);
+	ReleaseRequest(It);
+	return DT_SUCCESS;
 }
 //---------------------------------------------------------------------
 
 int CPathRequestQueue::GetPathSize(U16 RequestID)
 {
-	for (int i = 0; i < MAX_QUEUE; ++i)
-		if (Queue[i].RequestID == RequestID)
-			return Queue[i].PathSize;
-	return 0;
+	auto It = _Requests.find(RequestID);
+	return (It != _Requests.cend()) ? _Searches[It->second].PathSize : 0;
 }
 //---------------------------------------------------------------------
 
@@ -1,15 +1,21 @@
 #pragma once
 #include <StdDEM.h>
 #include <DetourNavMesh.h>
+#include <unordered_map>
 
 // Queue of pathfinding requests.
-// Based on dtPathQueue, but allows each request to have its own dtNavMeshQuery ptr.
-
-//???write template queue?
+// Based on dtPathQueue, but unbounded and prioritized. Requests for the same path are coalesced into one search.
+// Searches are sliced and each active one is updated in parallel jobs with a limited iteration count per update.
+// Sliced search state lives in dtNavMeshQuery, so queries are pooled per navmesh and bound to a search until it ends.
 
 class dtNavMeshQuery;
 class dtQueryFilter;
 
+namespace DEM::Jobs
+{
+	class CWorker;
+}
+
 namespace DEM::AI
 {
 
@@ -17,41 +23,53 @@ class CPathRequestQueue
 {
 protected:
 
-	struct CPathQuery
+	struct CPathSearch
 	{
-		U16						RequestID;
-		float					StartPos[3];
-		float					EndPos[3];
-		dtPolyRef				StartRef;
-		dtPolyRef				EndRef;
-		dtPolyRef*				pPath = nullptr;
-		int						PathSize;
-		dtStatus				Status;
-		int						KeepAlive;
-		dtNavMeshQuery*			pNavQuery = nullptr;
-		const dtQueryFilter*	pFilter = nullptr;	///< TODO: This is potentially dangerous!
+		float                        StartPos[3];
+		float                        EndPos[3];
+		dtPolyRef                    StartRef;
+		dtPolyRef                    EndRef;
+		std::unique_ptr<dtPolyRef[]> Path;
+		int                          PathSize = 0;
+		dtStatus                     Status = 0;
+		dtNavMesh*                   pNavMesh = nullptr;
+		dtNavMeshQuery*              pNavQuery = nullptr; // Borrowed from the pool while the search is in progress
+		const dtQueryFilter*         pFilter = nullptr;   ///< TODO: This is potentially dangerous!
+		float                        Priority = 0.f;
+		U32                          RequestTime = 0;     // In update ticks
+		U16                          RefCount = 0;        // Number of coalesced requests, 0 for a free slot
+		U8                           KeepAlive = 0;
 	};
 
-	static const int MAX_QUEUE = 8;
+	std::vector<CPathSearch>                            _Searches;
+	std::vector<U32>                                    _FreeSearches;
+	std::unordered_map<U16, U32>                        _Requests; // Request ID -> search index
+	std::vector<std::pair<dtNavMesh*, dtNavMeshQuery*>> _FreeNavQueries;
+	std::vector<U32>                                    _ActiveSearches;
+
+	U32         _UpdateIndex = 0;
+	int         _MaxPathSize = 0;
+	int         _MaxSearchNodes = 0;
+	U32         _MaxActiveSearches = 0;
+	U16         _NextRequestID = 1;
 
-	CPathQuery	Queue[MAX_QUEUE];
-	U16			NextRequestID = 1;
-	int			MaxPathSize = 0;
-	int			QueueHead = 0;
-	
-	void		Purge();
+	void            Purge();
+	dtNavMeshQuery* AcquireNavQuery(dtNavMesh* pNavMesh);
+	void            ReleaseNavQuery(CPathSearch& Search);
+	void            ReleaseRequest(std::unordered_map<U16, U32>::iterator It);
 
 public:
 
 	~CPathRequestQueue() { Purge(); }
 
-	bool		Init(int MaxPath);
-	void		Update(int MaxIters);
-	U16			Request(dtPolyRef RStart, dtPolyRef REnd, const float* pStart, const float* pEnd, dtNavMeshQuery* pNavQuery, const dtQueryFilter* pFilter);
-	void		CancelRequest(U16 RequestID);
-	dtStatus	GetRequestStatus(U16 RequestID) const;
-	dtStatus	GetPathResult(U16 RequestID, dtPolyRef* pOutPath, int& OutSize, int MaxPath);
-	int			GetPathSize(U16 RequestID);
+	bool        Init(int MaxPath, int MaxSearchNodes = 2048, U32 MaxActiveSearches = 32);
+	void        Update(int MaxIters, Jobs::CWorker* pWorker = nullptr);
+	U16         Request(dtPolyRef RStart, dtPolyRef REnd, const float* pStart, const float* pEnd, dtNavMesh* pNavMesh, const dtQueryFilter* pFilter, float Priority = 0.f);
+	void        CancelRequest(U16 RequestID);
+	dtStatus    GetRequestStatus(U16 RequestID) const;
+	dtStatus    GetPathResult(U16 RequestID, dtPolyRef* pOutPath, int& OutSize, int MaxPath);
+	int         GetPathSize(U16 RequestID);
+	UPTR        GetRequestCount() const { return _Requests.size(); }
 };
 
 }
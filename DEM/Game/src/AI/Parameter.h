@@ -89,6 +89,9 @@ public:
 	{
 		return _BBKey ? Blackboard.GetStorage().Get(Blackboard.GetStorage().Find(_BBKey), _Value) : _Value;
 	}
+
+	bool  IsConstant() const { return !_BBKey; }
+	TPass GetConstant() const { n_assert_dbg(!_BBKey); return _Value; }
 };
 
 template<typename... TVarTypes>
@@ -0,0 +1,193 @@
+#include "FactMemory.h"
+
+namespace DEM::AI
+{
+static constexpr U8 NO_BUCKET = std::numeric_limits<U8>().max();
+static constexpr U32 MIN_SLOT_COUNT = 16;
+
+CFactMemory::CFactMemory()
+{
+	std::fill(std::begin(_Buckets), std::end(_Buckets), INVALID_INDEX);
+}
+//---------------------------------------------------------------------
+
+// Returns the slot with this source or the free slot where it must be inserted
+U32 CFactMemory::FindSlot(Game::HEntity SourceID) const
+{
+	n_assert_dbg(!_Slots.empty());
+
+	const U32 Mask = static_cast<U32>(_Slots.size()) - 1;
+	U32 SlotIndex = HashSource(SourceID) & Mask;
+	while (_Slots[SlotIndex].SourceID && _Slots[SlotIndex].SourceID != SourceID)
+		SlotIndex = (SlotIndex + 1) & Mask;
+	return SlotIndex;
+}
+//---------------------------------------------------------------------
+
+// Backward shift deletion keeps probe sequences intact without tombstones
+void CFactMemory::EraseSlot(U32 SlotIndex)
+{
+	const U32 Mask = static_cast<U32>(_Slots.size()) - 1;
+	U32 Hole = SlotIndex;
+	U32 Curr = (Hole + 1) & Mask;
+	while (_Slots[Curr].SourceID)
+	{
+		// An entry can fill the hole only if the hole lies between its home slot and its current slot
+		const U32 Home = HashSource(_Slots[Curr].SourceID) & Mask;
+		if (((Curr - Home) & Mask) >= ((Curr - Hole) & Mask))
+		{
+			_Slots[Hole] = _Slots[Curr];
+			Hole = Curr;
+		}
+		Curr = (Curr + 1) & Mask;
+	}
+
+	_Slots[Hole].SourceID = {};
+}
+//---------------------------------------------------------------------
+
+void CFactMemory::GrowSlots()
+{
+	ZoneScoped;
+
+	const U32 NewSlotCount = std::max<U32>(MIN_SLOT_COUNT, static_cast<U32>(_Slots.size()) * 2);
+	_Slots.assign(NewSlotCount, CSlot{ {}, INVALID_INDEX });
+
+	for (U32 i = 0; i < _Facts.size(); ++i)
+		if (const auto SourceID = _Facts[i].SourceID)
+			_Slots[FindSlot(SourceID)] = CSlot{ SourceID, i };
+}
+//---------------------------------------------------------------------
+
+void CFactMemory::Link(U32 Index, U8 Bucket)
+{
+	auto& Record = _Schedule[Index];
+	Record.Bucket = Bucket;
+	Record.Prev = INVALID_INDEX;
+	Record.Next = _Buckets[Bucket];
+	if (Record.Next != INVALID_INDEX) _Schedule[Record.Next].Prev = Index;
+	_Buckets[Bucket] = Index;
+}
+//---------------------------------------------------------------------
+
+void CFactMemory::Unlink(U32 Index)
+{
+	auto& Record = _Schedule[Index];
+	if (Record.Bucket == NO_BUCKET) return;
+
+	if (Record.Prev != INVALID_INDEX)
+		_Schedule[Record.Prev].Next = Record.Next;
+	else
+		_Buckets[Record.Bucket] = Record.Next;
+
+	if (Record.Next != INVALID_INDEX) _Schedule[Record.Next].Prev = Record.Prev;
+
+	Record.Bucket = NO_BUCKET;
+}
+//---------------------------------------------------------------------
+
+void CFactMemory::ScheduleAfter(U32 Index, U32 DueTimestamp, U32 CurrTimestamp)
+{
+	// A fact can't be due in the past, the earliest visit is the next update
+	if (static_cast<I32>(DueTimestamp - CurrTimestamp) <= 0)
+		DueTimestamp = CurrTimestamp + 1;
+
+	Unlink(Index);
+	_Schedule[Index].DueTimestamp = DueTimestamp;
+	Link(Index, static_cast<U8>(DueTimestamp & WHEEL_MASK));
+}
+//---------------------------------------------------------------------
+
+U32 CFactMemory::Find(Game::HEntity SourceID) const
+{
+	if (!SourceID || _Slots.empty()) return INVALID_INDEX;
+	const auto& Slot = _Slots[FindSlot(SourceID)];
+	return Slot.SourceID ? Slot.FactIndex : INVALID_INDEX;
+}
+//---------------------------------------------------------------------
+
+// Returns the index of the fact about this source, a new zeroed fact is added if there is none
+U32 CFactMemory::FindOrAdd(Game::HEntity SourceID, bool& OutAdded)
+{
+	n_assert_dbg(SourceID);
+
+	// Keep the load factor under 3/4
+	if ((_SourcedFactCount + 1) * 4 > _Slots.size() * 3) GrowSlots();
+
+	auto& Slot = _Slots[FindSlot(SourceID)];
+	if (Slot.SourceID)
+	{
+		OutAdded = false;
+		return Slot.FactIndex;
+	}
+
+	CSensedStimulus Fact{};
+	Fact.SourceID = SourceID;
+	Slot.FactIndex = Add(Fact);
+	Slot.SourceID = SourceID;
+
+	OutAdded = true;
+	return Slot.FactIndex;
+}
+//---------------------------------------------------------------------
+
+// Adds a fact without indexing it. Used for sourceless facts and from FindOrAdd.
+U32 CFactMemory::Add(const CSensedStimulus& Fact)
+{
+	const U32 Index = static_cast<U32>(_Facts.size());
+	_Facts.push_back(Fact);
+	_Schedule.push_back(CSchedule{ INVALID_INDEX, INVALID_INDEX, 0, NO_BUCKET });
+	if (Fact.SourceID) ++_SourcedFactCount;
+	return Index;
+}
+//---------------------------------------------------------------------
+
+// Swaps the last fact into the removed one's place, so indices of other facts may change
+void CFactMemory::Remove(U32 Index)
+{
+	n_assert_dbg(Index < _Facts.size());
+
+	Unlink(Index);
+
+	if (const auto SourceID = _Facts[Index].SourceID)
+	{
+		const U32 SlotIndex = FindSlot(SourceID);
+		n_assert_dbg(_Slots[SlotIndex].FactIndex == Index);
+		EraseSlot(SlotIndex);
+		--_SourcedFactCount;
+	}
+
+	const U32 LastIndex = static_cast<U32>(_Facts.size()) - 1;
+	if (Index != LastIndex)
+	{
+		_Facts[Index] = _Facts[LastIndex];
+
+		// Relink the moved fact at its new index
+		const auto LastRecord = _Schedule[LastIndex];
+		Unlink(LastIndex);
+		if (LastRecord.Bucket != NO_BUCKET)
+		{
+			_Schedule[Index].DueTimestamp = LastRecord.DueTimestamp;
+			Link(Index, LastRecord.Bucket);
+		}
+
+		if (const auto SourceID = _Facts[Index].SourceID)
+			_Slots[FindSlot(SourceID)].FactIndex = Index;
+	}
+
+	_Facts.pop_back();
+	_Schedule.pop_back();
+}
+//---------------------------------------------------------------------
+
+void CFactMemory::Clear()
+{
+	_Facts.clear();
+	_Schedule.clear();
+	std::fill(_Slots.begin(), _Slots.end(), CSlot{ {}, INVALID_INDEX });
+	std::fill(std::begin(_Buckets), std::end(_Buckets), INVALID_INDEX);
+	_SourcedFactCount = 0;
+}
+//---------------------------------------------------------------------
+
+}
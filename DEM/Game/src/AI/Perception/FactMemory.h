@@ -0,0 +1,122 @@
+#pragma once
+#include <AI/Perception/Perception.h>
+#include <optional>
+
+// Per-agent memory of sensed facts. Facts with a source are indexed by it in a small open-addressed map,
+// so merging a new stimulus is an O(1) upsert instead of sorting and merging all facts every tick.
+// Forgetting is scheduled on a timer wheel, and a fact is revisited only when its rule may fire.
+// Facts are stored densely and unordered. Storage is reused, so steady state doesn't allocate.
+
+namespace DEM::AI
+{
+
+class CFactMemory
+{
+public:
+
+	static constexpr U32 INVALID_INDEX = std::numeric_limits<U32>().max();
+
+protected:
+
+	static constexpr U32 WHEEL_SIZE = 16; // Must be a power of 2
+	static constexpr U32 WHEEL_MASK = WHEEL_SIZE - 1;
+	static constexpr U8  PROCESSING_BUCKET = WHEEL_SIZE; // Holds a bucket being processed in Update
+
+	struct CSchedule
+	{
+		U32 Prev;
+		U32 Next;
+		U32 DueTimestamp;
+		U8  Bucket;
+	};
+
+	struct CSlot
+	{
+		Game::HEntity SourceID; // Empty for a free slot
+		U32           FactIndex;
+	};
+
+	std::vector<CSensedStimulus> _Facts;
+	std::vector<CSchedule>       _Schedule;  // Per fact, links it into a timer wheel bucket
+	std::vector<CSlot>           _Slots;     // Source ID -> fact index, linear probing, power of 2 size
+	U32                          _Buckets[WHEEL_SIZE + 1];
+	U32                          _SourcedFactCount = 0;
+	U32                          _LastTimestamp = 0;
+
+	static DEM_FORCE_INLINE U32 HashSource(Game::HEntity SourceID)
+	{
+		U32 Hash = SourceID.Raw;
+		Hash ^= Hash >> 16;
+		Hash *= 0x45d9f3bu;
+		Hash ^= Hash >> 16;
+		return Hash;
+	}
+
+	U32  FindSlot(Game::HEntity SourceID) const;
+	void EraseSlot(U32 SlotIndex);
+	void GrowSlots();
+	void Link(U32 Index, U8 Bucket);
+	void Unlink(U32 Index);
+	void ScheduleAfter(U32 Index, U32 DueTimestamp, U32 CurrTimestamp);
+
+public:
+
+	CFactMemory();
+
+	U32                    FindOrAdd(Game::HEntity SourceID, bool& OutAdded);
+	U32                    Add(const CSensedStimulus& Fact);
+	void                   Remove(U32 Index);
+	void                   Clear();
+	void                   Schedule(U32 Index, U32 DueTimestamp) { ScheduleAfter(Index, DueTimestamp, _LastTimestamp); }
+	U32                    Find(Game::HEntity SourceID) const;
+
+	// Visits facts that are due by CurrTimestamp. The callback returns a new due timestamp or std::nullopt to forget the fact.
+	template<typename F>
+	void Update(U32 CurrTimestamp, F OnDue)
+	{
+		ZoneScoped;
+
+		// Facts added since the last update are scheduled relative to it, so all buckets up to now must be visited
+		const U32 StepCount = std::min(CurrTimestamp - _LastTimestamp, WHEEL_SIZE);
+		for (U32 Step = StepCount; Step > 0; --Step)
+		{
+			const U32 Bucket = (CurrTimestamp - Step + 1) & WHEEL_MASK;
+
+			// Move the bucket aside, so that facts rescheduled into it are not visited again in this step
+			n_assert_dbg(_Buckets[PROCESSING_BUCKET] == INVALID_INDEX);
+			_Buckets[PROCESSING_BUCKET] = _Buckets[Bucket];
+			_Buckets[Bucket] = INVALID_INDEX;
+			for (U32 i = _Buckets[PROCESSING_BUCKET]; i != INVALID_INDEX; i = _Schedule[i].Next)
+				_Schedule[i].Bucket = PROCESSING_BUCKET;
+
+			// Always take the head, because Remove may move the last fact into any position
+			while (_Buckets[PROCESSING_BUCKET] != INVALID_INDEX)
+			{
+				const U32 Index = _Buckets[PROCESSING_BUCKET];
+				Unlink(Index);
+
+				// Further than one wheel revolution away, wait for the next visit
+				if (static_cast<I32>(_Schedule[Index].DueTimestamp - CurrTimestamp) > 0)
+				{
+					Link(Index, static_cast<U8>(_Schedule[Index].DueTimestamp & WHEEL_MASK));
+					continue;
+				}
+
+				if (const auto NewDueTimestamp = OnDue(_Facts[Index]))
+					ScheduleAfter(Index, *NewDueTimestamp, CurrTimestamp);
+				else
+					Remove(Index);
+			}
+		}
+
+		_LastTimestamp = CurrTimestamp;
+	}
+
+	CSensedStimulus&       GetFact(U32 Index) { n_assert_dbg(Index < _Facts.size()); return _Facts[Index]; }
+	const CSensedStimulus& GetFact(U32 Index) const { n_assert_dbg(Index < _Facts.size()); return _Facts[Index]; }
+	const auto&            GetFacts() const { return _Facts; }
+	U32                    GetFactCount() const { return static_cast<U32>(_Facts.size()); }
+	bool                   IsEmpty() const { return _Facts.empty(); }
+};
+
+}
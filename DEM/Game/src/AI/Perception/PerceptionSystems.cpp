@@ -16,8 +16,8 @@ void InitCharacterAISenses(Game::CGameWorld& World)
 		Sensor.Node = Scene.RootNode->FindNodeByPath(Sensor.NodePath.c_str());
 		Sensor.PerfectRadiusSq = Sensor.PerfectRadius * Sensor.PerfectRadius;
 		Sensor.MaxRadiusSq = Sensor.MaxRadius * Sensor.MaxRadius;
-		Sensor.CosHalfPerfectFOV = std::cosf(n_deg2rad(Sensor.PerfectFOV) * 0.5f);
-		Sensor.CosHalfMaxFOV = std::cosf(n_deg2rad(Sensor.MaxFOV) * 0.5f);
+		Sensor.CosHalfPerfectFOV = std::cos(n_deg2rad(Sensor.PerfectFOV) * 0.5f);
+		Sensor.CosHalfMaxFOV = std::cos(n_deg2rad(Sensor.MaxFOV) * 0.5f);
 	});
 }
 //---------------------------------------------------------------------
@@ -9,6 +9,7 @@ namespace DEM::AI
 struct CVisibleComponent
 {
 	float Visibility = 1.f;
+	float TargetHeight = 1.f; // Height above the entity origin at which vision sensors test line of sight
 	// TODO: move to RPG and store last detection check time and value here?
 };
 
@@ -22,7 +23,8 @@ template<> constexpr auto RegisterMembers<AI::CVisibleComponent>()
 {
 	return std::make_tuple
 	(
-		DEM_META_MEMBER_FIELD(AI::CVisibleComponent, Visibility)
+		DEM_META_MEMBER_FIELD(AI::CVisibleComponent, Visibility),
+		DEM_META_MEMBER_FIELD(AI::CVisibleComponent, TargetHeight)
 	);
 }
 
@@ -0,0 +1,133 @@
+#include <Game/ECS/GameWorld.h>
+#include <Game/ECS/Components/EventsComponent.h>
+#include <Animation/AnimationComponent.h>
+#include <Animation/AnimationPoseCache.h>
+#include <Jobs/JobSystem.h>
+
+namespace DEM::Game
+{
+constexpr size_t ANIMATION_CONTROLLERS_PER_JOB = 8;
+
+// Collects animation events in a worker without copying event data, because the data may be shared between
+// characters playing the same clip and Ptr refcounting is not atomic. Events are delivered in a merge phase.
+// NB: non-empty event data must be owned by an animation asset and outlive the frame, which is the case for event clips.
+class CDeferredAnimEventOutput : public Events::IEventOutput
+{
+public:
+
+	struct CRecord
+	{
+		CStrID             ID;
+		const Data::CData* pData;
+		float              TimeShift;
+	};
+
+	std::vector<CRecord> Records;
+
+	virtual void OnEvent(CStrID ID, const Data::CData& Data, float TimeShift) override
+	{
+		Records.push_back({ ID, Data.IsVoid() ? nullptr : &Data, TimeShift });
+	}
+};
+
+struct CAnimationUpdateTask
+{
+	CAnimationComponent*     pAnimComponent;
+	CEventsComponent*        pEventsComponent;
+	CDeferredAnimEventOutput Events;
+};
+
+// Selects the most detailed LOD whose distance is reached by the closest COI. LODs are sorted by MinDistance ascending.
+static const Anim::CAnimationLOD* SelectAnimationLOD(const Anim::CSkeleton& Skeleton, const rtm::vector4f* pCOIArray, UPTR COICount,
+	const Anim::CAnimationLOD* pLODs, UPTR LODCount)
+{
+	if (!pLODs || !LODCount) return nullptr;
+
+	const auto* pRootNode = Skeleton.GetNode(0);
+	if (!pRootNode || !pCOIArray || !COICount) return pLODs;
+
+	const rtm::vector4f Pos = pRootNode->GetWorldPosition();
+	float MinSqDistance = std::numeric_limits<float>().max();
+	for (UPTR i = 0; i < COICount; ++i)
+		MinSqDistance = std::min<float>(MinSqDistance, rtm::vector_length_squared3(rtm::vector_sub(pCOIArray[i], Pos)));
+
+	const Anim::CAnimationLOD* pLOD = pLODs;
+	for (UPTR i = 1; i < LODCount && pLODs[i].MinDistance * pLODs[i].MinDistance <= MinSqDistance; ++i)
+		pLOD = pLODs + i;
+	return pLOD;
+}
+//---------------------------------------------------------------------
+
+static void UpdateAnimationTasks(CAnimationUpdateTask* pBegin, CAnimationUpdateTask* pEnd, float dt)
+{
+	ZoneScoped;
+
+	for (auto pTask = pBegin; pTask != pEnd; ++pTask)
+	{
+		auto& AnimComponent = *pTask->pAnimComponent;
+		AnimComponent.Controller.Update(AnimComponent.Output, dt, pTask->pEventsComponent ? &pTask->Events : nullptr);
+		AnimComponent.Controller.EvaluatePoseDeferred(AnimComponent.Output);
+	}
+}
+//---------------------------------------------------------------------
+
+// Characters are independent, so graph update and pose evaluation run in parallel jobs. Scene write-back
+// and event delivery are deferred to a merge phase on the calling thread, in a deterministic entity order.
+// Pass nullptr as pWorker to update all controllers on the calling thread. Optional LODs, sorted by MinDistance
+// ascending, are selected by the distance to the closest COI, the same that will be passed to the scene update.
+// Optional pose cache is shared by all controllers and is updated after all poses are evaluated.
+void UpdateAnimationControllers(CGameWorld& World, float dt, const rtm::vector4f* pCOIArray, UPTR COICount,
+	const Anim::CAnimationLOD* pLODs, UPTR LODCount, Anim::CAnimationPoseCache* pPoseCache, Jobs::CWorker* pWorker)
+{
+	ZoneScoped;
+
+	std::vector<CAnimationUpdateTask> Tasks;
+	World.ForEachEntityWith<CAnimationComponent, CEventsComponent*>(
+		[&Tasks, pCOIArray, COICount, pLODs, LODCount, pPoseCache](auto EntityID, auto& Entity, CAnimationComponent& AnimComponent, CEventsComponent* pEventsComponent)
+	{
+		AnimComponent.Controller.SetPoseCache(pPoseCache);
+
+		// Task index is used as a phase to distribute throttled evaluations between frames
+		if (auto pLOD = SelectAnimationLOD(AnimComponent.Output, pCOIArray, COICount, pLODs, LODCount))
+			AnimComponent.Controller.SetLOD(*pLOD, static_cast<U32>(Tasks.size()));
+
+		Tasks.push_back({ &AnimComponent, pEventsComponent });
+	});
+
+	if (Tasks.empty()) return;
+
+	auto* pTasks = Tasks.data();
+	const size_t TaskCount = Tasks.size();
+	if (pWorker && TaskCount > ANIMATION_CONTROLLERS_PER_JOB)
+	{
+		Jobs::CJobCounter Counter;
+		for (size_t i = 0; i < TaskCount; i += ANIMATION_CONTROLLERS_PER_JOB)
+		{
+			auto* pBegin = pTasks + i;
+			auto* pEnd = pTasks + std::min(i + ANIMATION_CONTROLLERS_PER_JOB, TaskCount);
+			pWorker->AddJob(Counter, [pBegin, pEnd, dt]() { UpdateAnimationTasks(pBegin, pEnd, dt); });
+		}
+		pWorker->WaitActive(Counter);
+	}
+	else
+	{
+		UpdateAnimationTasks(pTasks, pTasks + TaskCount, dt);
+	}
+
+	// Merge phase
+	for (auto& Task : Tasks)
+	{
+		Task.pAnimComponent->Controller.ApplyPose(Task.pAnimComponent->Output);
+
+		if (Task.pEventsComponent)
+			for (const auto& Record : Task.Events.Records)
+				Task.pEventsComponent->Buffer.OnEvent(Record.ID, Record.pData ? *Record.pData : Data::CData{}, Record.TimeShift);
+	}
+
+	// All poses are applied and no sampler holds cached keys, so the cache can register clips missed
+	// in this frame, decode hot ones and evict unused ones before the next frame's lookups
+	if (pPoseCache) pPoseCache->Update();
+}
+//---------------------------------------------------------------------
+
+}
@@ -5,8 +5,9 @@
 namespace DEM::Game
 {
 
-CGameWorld::CGameWorld(Resources::CResourceManager& ResMgr)
+CGameWorld::CGameWorld(Resources::CResourceManager& ResMgr, Jobs::CJobSystem* pJobSystem)
 	: _ResMgr(ResMgr)
+	, _pJobSystem(pJobSystem)
 {
 }
 //---------------------------------------------------------------------
@@ -425,7 +426,7 @@ CGameLevel* CGameWorld::CreateLevel(CStrID ID, const Math::CAABB& Bounds, const
 {
 	// Ensure there is no level with same ID
 
-	auto Level = n_new(DEM::Game::CGameLevel(ID, Bounds, InteractiveBounds, SubdivisionDepth));
+	auto Level = n_new(DEM::Game::CGameLevel(ID, Bounds, InteractiveBounds, SubdivisionDepth, _pJobSystem));
 
 	// Add level to the list
 
@@ -445,7 +446,7 @@ CGameLevel* CGameWorld::LoadLevel(CStrID ID, const Data::CParams& In)
 		return nullptr;
 	}
 
-	PGameLevel Level = CGameLevel::LoadFromDesc(ID, In, _ResMgr);
+	PGameLevel Level = CGameLevel::LoadFromDesc(ID, In, _ResMgr, _pJobSystem);
 	if (!Level) return nullptr;
 
 	_Levels.emplace(ID, Level);
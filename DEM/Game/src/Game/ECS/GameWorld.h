@@ -13,6 +13,11 @@
 // registered here. Designed using an ECS (entity-component-system) pattern.
 // Multiple isolated worlds can be created, but one is enough for any typical game.
 
+namespace DEM::Jobs
+{
+	class CJobSystem;
+}
+
 namespace DEM::Game
 {
 typedef std::unique_ptr<class CGameWorld> PGameWorld;
@@ -39,6 +44,7 @@ protected:
 	EState                         _State = EState::Stopped;
 
 	Resources::CResourceManager&   _ResMgr;
+	Jobs::CJobSystem*              _pJobSystem = nullptr; // Enables multithreaded physics in levels
 	IO::PStream                    _BaseStream; // Base data is accessed on demand in RAM or in a mapped file
 
 	CEntityStorage                 _EntitiesBase;
@@ -77,7 +83,7 @@ protected:
 
 public:
 
-	CGameWorld(Resources::CResourceManager& ResMgr);
+	CGameWorld(Resources::CResourceManager& ResMgr, Jobs::CJobSystem* pJobSystem = nullptr);
 	~CGameWorld();
 
 	void Start();
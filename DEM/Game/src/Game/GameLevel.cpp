@@ -20,10 +20,10 @@ namespace DEM::Game
 {
 bool GetTargetFromPhysicsObject(const Physics::CPhysicsObject& Object, CTargetInfo& OutTarget);
 
-CGameLevel::CGameLevel(CStrID ID, const Math::CAABB& Bounds, const Math::CAABB& InteractiveBounds, UPTR SubdivisionDepth)
+CGameLevel::CGameLevel(CStrID ID, const Math::CAABB& Bounds, const Math::CAABB& InteractiveBounds, UPTR SubdivisionDepth, Jobs::CJobSystem* pJobSystem)
 	: _ID(ID)
 	, _SceneRoot(n_new(Scene::CSceneNode(ID)))
-	, _PhysicsLevel(n_new(Physics::CPhysicsLevel(Bounds)))
+	, _PhysicsLevel(n_new(Physics::CPhysicsLevel(Bounds, pJobSystem)))
 	, _AILevel(n_new(AI::CAILevel()))
 {
 	const auto BoundsSize = Math::FromSIMD3(rtm::vector_mul(Bounds.Extent, 2.f));
@@ -33,13 +33,15 @@ CGameLevel::CGameLevel(CStrID ID, const Math::CAABB& Bounds, const Math::CAABB&
 
 CGameLevel::~CGameLevel()
 {
+	FinishPhysicsUpdate();
+
 	// Order of destruction is important
 	_SceneRoot = nullptr;
 	_PhysicsLevel = nullptr;
 }
 //---------------------------------------------------------------------
 
-PGameLevel CGameLevel::LoadFromDesc(CStrID ID, const Data::CParams& In, Resources::CResourceManager& ResMgr)
+PGameLevel CGameLevel::LoadFromDesc(CStrID ID, const Data::CParams& In, Resources::CResourceManager& ResMgr, Jobs::CJobSystem* pJobSystem)
 {
 	vector3 Center(vector3::Zero);
 	vector3 Size(512.f, 128.f, 512.f);
@@ -56,7 +58,8 @@ PGameLevel CGameLevel::LoadFromDesc(CStrID ID, const Data::CParams& In, Resource
 		ID,
 		Math::CAABB{ Math::ToSIMD(Center), Math::ToSIMD(Extents) },
 		Math::CAABB{ Math::ToSIMD(InteractiveCenter), Math::ToSIMD(InteractiveExtents) },
-		SubdivisionDepth);
+		SubdivisionDepth,
+		pJobSystem);
 
 	// Load optional scene with static graphics, collision and other attributes. No entity is associated with it.
 	const bool StaticSceneIsUnique = In.Get(CStrID("StaticSceneIsUnique"), true);
@@ -103,7 +106,9 @@ PGameLevel CGameLevel::LoadFromDesc(CStrID ID, const Data::CParams& In, Resource
 			if (NavDesc->Get(CStrID("Preload"), false))
 				Rsrc->ValidateObject<DEM::AI::CNavMesh>();
 
-			Level->_NavMaps.push_back(n_new(AI::CNavMap)(AgentRadius, AgentHeight, Rsrc));
+			AI::PNavMap NavMap = n_new(AI::CNavMap)(AgentRadius, AgentHeight, Rsrc);
+			NavMap->SetStreamingDistance(NavDesc->Get(CStrID("StreamingDistance"), 0.f));
+			Level->_NavMaps.push_back(std::move(NavMap));
 		}
 
 		std::sort(Level->_NavMaps.begin(), Level->_NavMaps.end(),
@@ -147,11 +152,21 @@ bool CGameLevel::Validate(Resources::CResourceManager& RsrcMgr)
 }
 //---------------------------------------------------------------------
 
-void CGameLevel::Update(float dt, const rtm::vector4f* pCOIArray, UPTR COICount)
+void CGameLevel::Update(float dt, const rtm::vector4f* pCOIArray, UPTR COICount, Jobs::CWorker* pWorker)
 {
 	ZoneScoped;
 
-	if (_PhysicsLevel) _PhysicsLevel->Update(dt);
+	// Physics started in StartPhysicsUpdate has already advanced, only its results are applied here
+	if (_PhysicsLevel)
+	{
+		if (_PhysicsLevel->IsUpdating())
+			_PhysicsLevel->FinishUpdate();
+		else
+			_PhysicsLevel->Update(dt);
+	}
+
+	for (const auto& NavMap : _NavMaps)
+		NavMap->Update(pCOIArray, COICount, pWorker);
 
 	{
 		ZoneScopedN("Scene hierarchy update");
@@ -182,6 +197,18 @@ void CGameLevel::Update(float dt, const rtm::vector4f* pCOIArray, UPTR COICount)
 }
 //---------------------------------------------------------------------
 
+void CGameLevel::StartPhysicsUpdate(float dt, Jobs::CWorker* pWorker)
+{
+	if (_PhysicsLevel) _PhysicsLevel->StartUpdate(dt, pWorker);
+}
+//---------------------------------------------------------------------
+
+void CGameLevel::FinishPhysicsUpdate()
+{
+	if (_PhysicsLevel) _PhysicsLevel->FinishUpdate();
+}
+//---------------------------------------------------------------------
+
 Physics::CPhysicsObject* CGameLevel::GetFirstPickIntersection(const rtm::vector4f& RayFrom, const rtm::vector4f& RayTo, rtm::vector4f* pOutPoint3D, std::string_view CollisionMask, HEntity ExcludeID) const
 {
 	ZoneScoped;
@@ -240,6 +267,49 @@ Physics::CPhysicsObject* CGameLevel::GetFirstPickIntersection(const rtm::vector4
 }
 //---------------------------------------------------------------------
 
+// Batched version of GetFirstPickIntersection for N-per-frame workloads like line of sight checks.
+// Rays may be cast in parallel jobs, so it must not be called while the physics level is being updated.
+void CGameLevel::GetFirstPickIntersections(const CPickRay* pRays, Physics::CPhysicsObject** pOutObjects, rtm::vector4f* pOutPoints3D, UPTR Count, std::string_view CollisionMask, Jobs::CWorker* pWorker) const
+{
+	ZoneScoped;
+
+	if (!Count) return;
+
+	if (!_PhysicsLevel)
+	{
+		std::fill_n(pOutObjects, Count, nullptr);
+		return;
+	}
+
+	const U32 Group = _PhysicsLevel->PredefinedCollisionGroups.Query;
+	const U32 Mask = CollisionMask.empty() ? _PhysicsLevel->PredefinedCollisionGroups.All : _PhysicsLevel->CollisionGroups.GetMask(CollisionMask);
+
+	std::vector<Physics::CPhysicsLevel::CRayQuery> Queries(Count);
+	for (UPTR i = 0; i < Count; ++i)
+		Queries[i] = { pRays[i].From, pRays[i].To, Group, Mask };
+
+	// Excluded entity is checked against each physics object the ray meets, like in GetFirstPickIntersection
+	const auto EntityFilter = [](const Physics::CPhysicsObject& Object, UPTR QueryIndex, const void* pContext)
+	{
+		const HEntity ExcludeID = static_cast<const CPickRay*>(pContext)[QueryIndex].ExcludeID;
+		if (!ExcludeID) return true;
+
+		CTargetInfo Target;
+		GetTargetFromPhysicsObject(Object, Target);
+		return Target.Entity != ExcludeID;
+	};
+
+	std::vector<Physics::CPhysicsLevel::CQueryHit> Hits(Count);
+	_PhysicsLevel->CastRays(Queries.data(), Hits.data(), Count, pWorker, EntityFilter, pRays);
+
+	for (UPTR i = 0; i < Count; ++i)
+	{
+		pOutObjects[i] = Hits[i].pObject;
+		if (pOutPoints3D) pOutPoints3D[i] = Hits[i].Position;
+	}
+}
+//---------------------------------------------------------------------
+
 void CGameLevel::EnumEntitiesInSphere(const rtm::vector4f& Position, float Radius, std::string_view CollisionMask, std::function<bool(HEntity&, const rtm::vector4f&)>&& Callback) const
 {
 	if (!_PhysicsLevel || !Callback || Radius <= 0.f) return;
@@ -325,4 +395,25 @@ void CGameLevel::SetNavRegionFlags(CStrID RegionID, U16 Flags, bool On)
 }
 //---------------------------------------------------------------------
 
+void CGameLevel::SetNavObstacle(HEntity ID, const rtm::vector4f& Position, float Radius, float Height)
+{
+	for (const auto& NavMap : _NavMaps)
+		NavMap->SetObstacle(ID, Position, Radius, Height);
+}
+//---------------------------------------------------------------------
+
+void CGameLevel::SetNavBoxObstacle(HEntity ID, const rtm::vector4f& Min, const rtm::vector4f& Max)
+{
+	for (const auto& NavMap : _NavMaps)
+		NavMap->SetBoxObstacle(ID, Min, Max);
+}
+//---------------------------------------------------------------------
+
+void CGameLevel::RemoveNavObstacle(HEntity ID)
+{
+	for (const auto& NavMap : _NavMaps)
+		NavMap->RemoveObstacle(ID);
+}
+//---------------------------------------------------------------------
+
 }
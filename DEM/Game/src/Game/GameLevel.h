@@ -5,6 +5,9 @@
 
 // Represents one game location. Consists of subsystem worlds (scene, graphics, physics, AI).
 // In MVC pattern it is a model.
+// Physics can be stepped in a job while the previous frame renders: StartPhysicsUpdate after game logic,
+// and the next Update finishes it and applies new transforms before the scene update. In between
+// nothing may access physics, and physics lags one frame behind game time.
 
 namespace Scene
 {
@@ -34,12 +37,27 @@ namespace Data
 	class CParams;
 }
 
+namespace DEM::Jobs
+{
+	class CWorker;
+	class CJobSystem;
+}
+
 namespace DEM::Game
 {
 typedef Ptr<class CGameLevel> PGameLevel;
 
 class CGameLevel : public Data::CRefCounted
 {
+public:
+
+	struct CPickRay
+	{
+		rtm::vector4f From;
+		rtm::vector4f To;
+		HEntity       ExcludeID;
+	};
+
 protected:
 
 	CStrID                 _ID;
@@ -53,18 +71,24 @@ protected:
 
 public:
 
-	static PGameLevel LoadFromDesc(CStrID ID, const Data::CParams& In, Resources::CResourceManager& ResMgr);
+	static PGameLevel LoadFromDesc(CStrID ID, const Data::CParams& In, Resources::CResourceManager& ResMgr, Jobs::CJobSystem* pJobSystem = nullptr);
 
-	CGameLevel(CStrID ID, const Math::CAABB& Bounds, const Math::CAABB& InteractiveBounds = Math::EmptyAABB(), UPTR SubdivisionDepth = 0);
+	CGameLevel(CStrID ID, const Math::CAABB& Bounds, const Math::CAABB& InteractiveBounds = Math::EmptyAABB(), UPTR SubdivisionDepth = 0, Jobs::CJobSystem* pJobSystem = nullptr);
 	virtual ~CGameLevel() override;
 
 	bool                     Validate(Resources::CResourceManager& RsrcMgr);
-	void                     Update(float dt, const rtm::vector4f* pCOIArray, UPTR COICount);
+	void                     Update(float dt, const rtm::vector4f* pCOIArray, UPTR COICount, Jobs::CWorker* pWorker = nullptr);
+	void                     StartPhysicsUpdate(float dt, Jobs::CWorker* pWorker);
+	void                     FinishPhysicsUpdate();
 
 	void                     SetNavRegionController(CStrID RegionID, HEntity Controller);
 	void                     SetNavRegionFlags(CStrID RegionID, U16 Flags, bool On);
+	void                     SetNavObstacle(HEntity ID, const rtm::vector4f& Position, float Radius, float Height);
+	void                     SetNavBoxObstacle(HEntity ID, const rtm::vector4f& Min, const rtm::vector4f& Max);
+	void                     RemoveNavObstacle(HEntity ID);
 
 	Physics::CPhysicsObject* GetFirstPickIntersection(const rtm::vector4f& RayFrom, const rtm::vector4f& RayTo, rtm::vector4f* pOutPoint3D = nullptr, std::string_view CollisionMask = {}, HEntity ExcludeID = {}) const;
+	void                     GetFirstPickIntersections(const CPickRay* pRays, Physics::CPhysicsObject** pOutObjects, rtm::vector4f* pOutPoints3D, UPTR Count, std::string_view CollisionMask = {}, Jobs::CWorker* pWorker = nullptr) const;
 	// Query hierarchy:
 	// 4. Reachable entities in a shape (navigation)
 	// 5. Reachable entities in a shape filtered by a custom filter, e.g. by a component presence
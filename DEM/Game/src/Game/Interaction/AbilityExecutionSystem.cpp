@@ -275,7 +275,7 @@ static AI::ECommandStatus FaceTarget(CGameSession& Session, CAbilityInstance& Ab
 
 	const rtm::vector4f LookatDir = rtm::vector_normalize3(rtm::vector_neg(ActorWorldTfm.z_axis));
 	const float Angle = Math::AngleXZNorm(LookatDir, TargetDir);
-	if (std::fabsf(Angle) < FacingTolerance) return AI::ECommandStatus::Succeeded;
+	if (std::fabs(Angle) < FacingTolerance) return AI::ECommandStatus::Succeeded;
 
 	AI::PushOrUpdateCommand<AI::Turn>(CmdStack, Cmd._SubCommandFuture, TargetDir, FacingTolerance);
 
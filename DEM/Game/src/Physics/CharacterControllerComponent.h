@@ -37,6 +37,7 @@ struct CCharacterControllerComponent
 	float           BigTurnThreshold = PI / 3.f;        // Max angle (in rad) actor can turn without stopping linear movement
 	float           SteeringSmoothness = 0.3f;
 	float           ArriveBrakingCoeff = -0.5f / -10.f; // -1/2a = -0.5/a, where a is max brake acceleration, a < 0
+	bool            ObstacleAvoidance = true;           // Steer around other characters when walking
 
 	// For stuck state detection
 	float           SqExpectedLinearSpeed = 0.f;
@@ -63,7 +64,8 @@ template<> constexpr auto RegisterMembers<Game::CCharacterControllerComponent>()
 		Member(3, "Hover", &Game::CCharacterControllerComponent::Hover, &Game::CCharacterControllerComponent::Hover),
 		Member(4, "MaxLinearSpeed", &Game::CCharacterControllerComponent::MaxLinearSpeed, &Game::CCharacterControllerComponent::MaxLinearSpeed),
 		Member(5, "MaxAngularSpeed", &Game::CCharacterControllerComponent::MaxAngularSpeed, &Game::CCharacterControllerComponent::MaxAngularSpeed),
-		Member(6, "MaxAcceleration", &Game::CCharacterControllerComponent::MaxAcceleration, &Game::CCharacterControllerComponent::MaxAcceleration)
+		Member(6, "MaxAcceleration", &Game::CCharacterControllerComponent::MaxAcceleration, &Game::CCharacterControllerComponent::MaxAcceleration),
+		Member(7, "ObstacleAvoidance", &Game::CCharacterControllerComponent::ObstacleAvoidance, &Game::CCharacterControllerComponent::ObstacleAvoidance)
 	);
 }
 
@@ -53,7 +53,7 @@ protected:
 				{
 					Callback(i, Link);
 				}
-				else static_assert(false, "Callback must accept link index and const link reference");
+				else static_assert(always_false_v<F>, "Callback must accept link index and const link reference");
 			}
 		}
 	}
@@ -0,0 +1,286 @@
+#include <Data/HRDParser.h>
+#include <Data/Params.h>
+#include <Data/DataArray.h>
+#include <Math/Vector3.h>
+#include <Math/Vector4.h>
+#include <Math/Matrix44.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// CPU-side benchmark of the variant data used for HRD descriptions, templates and saves. Generates an HRD
+// with a number of entity-like records, parses it, copies and moves the records, and prints timings. Then
+// compares the memory CData inline storage costs against the heap allocations it saves.
+//
+// Usage: DEMDataBench [options]
+//   -records <N>    record count in the generated HRD (default 2000)
+//   -iterations <N> how many times each operation is repeated (default 20)
+
+namespace
+{
+
+struct CBenchArgs
+{
+	U32 RecordCount = 2000;
+	U32 IterationCount = 20;
+};
+
+// Counters of CData values by the place where their value lives
+struct CDataUsage
+{
+	U64 ValueCount = 0;
+	U64 InlineCount = 0;       // Stored inline
+	U64 SavedAllocCount = 0;   // Stored inline, but allocated when only pointer-sized values were inline
+	U64 SavedAllocBytes = 0;
+	U64 HeapCount = 0;         // Still allocated in the heap
+	U64 HeapBytes = 0;
+};
+
+static bool ParseArgs(int argc, const char** argv, CBenchArgs& Out)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* pArg = argv[i];
+		const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (!pValue)
+		{
+			std::fprintf(stderr, "Missing value for %s\n", pArg);
+			FAIL;
+		}
+
+		if (!std::strcmp(pArg, "-records")) Out.RecordCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+		else if (!std::strcmp(pArg, "-iterations")) Out.IterationCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+		else
+		{
+			std::fprintf(stderr, "Unknown argument %s\n", pArg);
+			std::fprintf(stderr, "Usage: DEMDataBench [-records <N>] [-iterations <N>]\n");
+			FAIL;
+		}
+		++i;
+	}
+
+	if (!Out.RecordCount || !Out.IterationCount)
+	{
+		std::fprintf(stderr, "Record and iteration counts must be positive\n");
+		FAIL;
+	}
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Records contain every value type HRD can produce, in proportions typical for entity templates
+static std::string GenerateHRD(U32 RecordCount)
+{
+	std::string HRD;
+	HRD.reserve(RecordCount * 512);
+
+	char Buffer[512];
+	for (U32 i = 0; i < RecordCount; ++i)
+	{
+		const float f = static_cast<float>(i);
+		std::snprintf(Buffer, sizeof(Buffer),
+			"Record%u\n"
+			"{\n"
+			"\tID = 'Entity%u'\n"
+			"\tName = \"Entity %u\"\n"
+			"\tDescription = \"A long description that doesn't fit into the small string buffer, entity %u\"\n"
+			"\tHealth = %u\n"
+			"\tSpeed = %.2f\n"
+			"\tVisible = %s\n"
+			"\tPosition = (%.1f, 0.0, %.1f)\n"
+			"\tColor = (1.0, 0.5, 0.25, 1.0)\n"
+			"\tTags [ 'Creature', 'Hostile', 'Tag%u' ]\n"
+			"\tStats { Strength = %u Agility = %u Range = %.1f }\n"
+			"}\n",
+			i, i, i, i, 100 + i % 50, 3.f + (i % 10) * 0.25f, (i % 2) ? "true" : "false", f, -f, i % 8, 10 + i % 5, 12 + i % 3, 1.f + (i % 4) * 0.5f);
+		HRD += Buffer;
+	}
+
+	return HRD;
+}
+//---------------------------------------------------------------------
+
+template<typename T>
+static void CountValue(CDataUsage& Usage)
+{
+	++Usage.ValueCount;
+	if constexpr (Data::CTypeImpl<T>::IsInline)
+	{
+		++Usage.InlineCount;
+		if constexpr (sizeof(T) > sizeof(void*))
+		{
+			++Usage.SavedAllocCount;
+			Usage.SavedAllocBytes += sizeof(T);
+		}
+	}
+	else
+	{
+		++Usage.HeapCount;
+		Usage.HeapBytes += sizeof(T);
+	}
+}
+//---------------------------------------------------------------------
+
+static void GatherUsage(const Data::CData& Value, CDataUsage& Usage)
+{
+	Value.Visit([&Usage](const auto& TypedValue)
+	{
+		using T = std::decay_t<decltype(TypedValue)>;
+		if constexpr (std::is_same_v<T, std::monostate>)
+		{
+			++Usage.ValueCount;
+			++Usage.InlineCount;
+		}
+		else
+		{
+			CountValue<T>(Usage);
+
+			if constexpr (std::is_same_v<T, Data::PParams>)
+			{
+				if (TypedValue)
+					for (const auto& Param : *TypedValue)
+						GatherUsage(Param.GetRawValue(), Usage);
+			}
+			else if constexpr (std::is_same_v<T, Data::PDataArray>)
+			{
+				if (TypedValue)
+					for (const auto& Element : *TypedValue)
+						GatherUsage(Element, Usage);
+			}
+		}
+	});
+}
+//---------------------------------------------------------------------
+
+// Returns the best of repetitions, it is the least affected by the OS and other processes.
+// Preparation is not measured, it restores the state the operation expects.
+template<typename FPrepare, typename FOperation>
+static double MeasureMs(U32 IterationCount, FPrepare Prepare, FOperation Operation)
+{
+	double BestMs = std::numeric_limits<double>::max();
+	for (U32 i = 0; i < IterationCount; ++i)
+	{
+		Prepare();
+		const auto Start = std::chrono::steady_clock::now();
+		Operation();
+		const auto End = std::chrono::steady_clock::now();
+		BestMs = std::min(BestMs, std::chrono::duration<double, std::milli>(End - Start).count());
+	}
+	return BestMs;
+}
+//---------------------------------------------------------------------
+
+static int RunBenchmark(const CBenchArgs& Args)
+{
+	const std::string HRD = GenerateHRD(Args.RecordCount);
+
+	// Parse
+
+	Data::CParams Root;
+	std::string Errors;
+	const double ParseMs = MeasureMs(Args.IterationCount, [&Root]() { Root.Clear(); }, [&HRD, &Root, &Errors]()
+	{
+		Data::CHRDParser Parser;
+		Parser.ParseBuffer(HRD.c_str(), HRD.size(), Root, &Errors);
+	});
+
+	if (Root.GetCount() != Args.RecordCount)
+	{
+		std::fprintf(stderr, "Can't parse the generated HRD:\n%s", Errors.c_str());
+		return 1;
+	}
+
+	std::vector<const Data::CParams*> Records;
+	Records.reserve(Root.GetCount());
+	for (const auto& Param : Root)
+		Records.push_back(Param.GetValue<Data::PParams>().Get());
+
+	// Copy each record. Values are copied and nested params are shared.
+
+	std::vector<Data::CParams> Copies;
+	Copies.reserve(Records.size());
+	const auto MakeCopies = [&Records, &Copies]()
+	{
+		for (const auto* pRecord : Records)
+			Copies.emplace_back(*pRecord);
+	};
+
+	const double CopyMs = MeasureMs(Args.IterationCount, [&Copies]() { Copies.clear(); }, MakeCopies);
+
+	// Move each value of each record, as when a vector of params grows
+
+	std::vector<Data::CParam> Moved;
+	Moved.reserve(Records.size() * Records[0]->GetCount());
+	const double MoveMs = MeasureMs(Args.IterationCount, [&Copies, &Moved, &MakeCopies]()
+	{
+		Moved.clear();
+		Copies.clear();
+		MakeCopies();
+	},
+	[&Copies, &Moved]()
+	{
+		for (auto& Record : Copies)
+			for (IPTR i = 0; i < static_cast<IPTR>(Record.GetCount()); ++i)
+				Moved.push_back(std::move(Record.Get(i)));
+	});
+
+	// Memory
+
+	CDataUsage TotalUsage;
+	for (const auto& Param : Root)
+		GatherUsage(Param.GetRawValue(), TotalUsage);
+
+	// Nested params are shared by a copy and don't contribute to its cost
+	CDataUsage CopyUsage;
+	for (const auto& Param : *Records[0])
+	{
+		if (Param.IsA<Data::PParams>() || Param.IsA<Data::PDataArray>())
+			CountValue<Data::PParams>(CopyUsage);
+		else
+			GatherUsage(Param.GetRawValue(), CopyUsage);
+	}
+
+	constexpr size_t PrevDataSize = 2 * sizeof(void*); // Type and a value or a pointer to it
+	const U64 ExtraBytes = TotalUsage.ValueCount * (sizeof(Data::CData) - PrevDataSize);
+	const double Count = static_cast<double>(Records.size());
+
+	std::printf("Records:       %u, %u bytes of HRD, best of %u iterations\n", Args.RecordCount, static_cast<U32>(HRD.size()), Args.IterationCount);
+	std::printf("Parse:         %.3f ms, %.1f ns per record\n", ParseMs, ParseMs * 1000000.0 / Count);
+	std::printf("Copy:          %.3f ms, %.1f ns per record\n", CopyMs, CopyMs * 1000000.0 / Count);
+	std::printf("Move:          %.3f ms, %.1f ns per record\n", MoveMs, MoveMs * 1000000.0 / Count);
+	std::printf("CData:         %u bytes, was %u bytes with only pointer-sized values inline (inline storage %u bytes)\n",
+		static_cast<U32>(sizeof(Data::CData)), static_cast<U32>(PrevDataSize), static_cast<U32>(Data::DATA_INLINE_SIZE));
+	std::printf("Values:        %llu, %llu inline, %llu in the heap (%llu bytes)\n",
+		static_cast<unsigned long long>(TotalUsage.ValueCount), static_cast<unsigned long long>(TotalUsage.InlineCount),
+		static_cast<unsigned long long>(TotalUsage.HeapCount), static_cast<unsigned long long>(TotalUsage.HeapBytes));
+	std::printf("Memory cost:   %llu bytes more in CData, %.1f per record\n",
+		static_cast<unsigned long long>(ExtraBytes), ExtraBytes / Count);
+	std::printf("Memory saved:  %llu allocations of %llu bytes without allocator overhead, %.1f allocations per record\n",
+		static_cast<unsigned long long>(TotalUsage.SavedAllocCount), static_cast<unsigned long long>(TotalUsage.SavedAllocBytes),
+		TotalUsage.SavedAllocCount / Count);
+	std::printf("Net bytes:     %lld, positive means inline storage costs more than it saves\n",
+		static_cast<long long>(ExtraBytes) - static_cast<long long>(TotalUsage.SavedAllocBytes));
+	std::printf("Record copy:   %llu values, %llu allocations saved, %llu still allocated\n",
+		static_cast<unsigned long long>(CopyUsage.ValueCount), static_cast<unsigned long long>(CopyUsage.SavedAllocCount),
+		static_cast<unsigned long long>(CopyUsage.HeapCount));
+
+	return 0;
+}
+//---------------------------------------------------------------------
+
+}
+
+int main(int argc, const char** argv)
+{
+	CBenchArgs Args;
+	if (!ParseArgs(argc, argv, Args)) return 1;
+
+	return RunBenchmark(Args);
+}
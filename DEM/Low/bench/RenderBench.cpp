@@ -0,0 +1,422 @@
+#include <Frame/GraphicsResourceManager.h>
+#include <Frame/GraphicsScene.h>
+#include <Frame/View.h>
+#include <Frame/CameraAttribute.h>
+#include <Frame/RenderPhaseGeometry.h>
+#include <Frame/RenderPath.h>
+#include <Frame/Renderables/ModelAttribute.h>
+#include <Frame/Lights/PointLightAttribute.h>
+#include <Render/Model.h>
+#include <Render/ModelRenderer.h>
+#include <Render/RenderTarget.h>
+#include <Render/MeshData.h>
+#include <Render/MeshLoaderMSH.h>
+#include <Render/TextureData.h>
+#include <Render/TextureLoaderDDS.h>
+#include <Render/TextureLoaderTGA.h>
+#include <Render/Null/NullDriverFactory.h>
+#include <Render/Null/NullGPUDriver.h>
+#include <Resources/ResourceManager.h>
+#include <Events/EventServer.h>
+#include <IO/IOServer.h>
+#include <IO/FS/FileSystemNative.h>
+#include <Scene/SceneNode.h>
+#if DEM_PLATFORM_WIN32
+#include <System/Win32/OSFileSystemWin32.h>
+#else
+#include <System/OSFileSystemStd.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// CPU-side render benchmark. Builds a synthetic grid scene, renders it through a CView on the null
+// GPU driver and prints frame timings. No GPU work is done, so the numbers measure only the engine:
+// scene update, culling, render queues, renderers and GPU driver command submission.
+//
+// Usage: DEMRenderBench -data <dir> -rp <RenderPathUID> -mesh <MeshUID> -mtl <MaterialUID> [options]
+//   -rt <ID>        render target ID used by the render path (default "Main")
+//   -ds <ID>        depth-stencil buffer ID used by the render path (default "MainDepth")
+//   -frames <N>     measured frame count (default 1000)
+//   -warmup <N>     frames rendered before measuring, resource loading goes here (default 10)
+//   -grid <N>       models are placed in an N x N grid (default 32)
+//   -spacing <F>    distance between grid cells (default 2.0)
+//   -lights <N>     point light count (default 16)
+//   -static         don't move the camera between frames
+//   -csv            print per-frame timings in CSV after the summary
+// All UIDs are resolved by the resource manager, "Data:" prefix refers to the -data directory.
+
+namespace
+{
+
+struct CBenchArgs
+{
+	const char* pDataPath = nullptr;
+	const char* pRenderPathUID = nullptr;
+	const char* pMeshUID = nullptr;
+	const char* pMaterialUID = nullptr;
+	const char* pRenderTargetID = "Main";
+	const char* pDepthStencilID = "MainDepth";
+	U32         FrameCount = 1000;
+	U32         WarmupCount = 10;
+	U32         GridSize = 32;
+	float       Spacing = 2.f;
+	U32         LightCount = 16;
+	bool        StaticCamera = false;
+	bool        CSV = false;
+};
+
+struct CFrameRecord
+{
+	double TimeMs;
+	U32    DrawCount;
+	U32    StateChangeCount;
+	U32    RedundantStateChangeCount;
+	U64    Primitives;
+	U64    Instances;
+	U64    BytesWritten;
+	Render::CRenderStats RendererStats;
+};
+
+static bool ParseArgs(int argc, const char** argv, CBenchArgs& Out)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* pArg = argv[i];
+		const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (!std::strcmp(pArg, "-static")) Out.StaticCamera = true;
+		else if (!std::strcmp(pArg, "-csv")) Out.CSV = true;
+		else if (!pValue)
+		{
+			std::fprintf(stderr, "Missing value for %s\n", pArg);
+			FAIL;
+		}
+		else
+		{
+			if (!std::strcmp(pArg, "-data")) Out.pDataPath = pValue;
+			else if (!std::strcmp(pArg, "-rp")) Out.pRenderPathUID = pValue;
+			else if (!std::strcmp(pArg, "-mesh")) Out.pMeshUID = pValue;
+			else if (!std::strcmp(pArg, "-mtl")) Out.pMaterialUID = pValue;
+			else if (!std::strcmp(pArg, "-rt")) Out.pRenderTargetID = pValue;
+			else if (!std::strcmp(pArg, "-ds")) Out.pDepthStencilID = pValue;
+			else if (!std::strcmp(pArg, "-frames")) Out.FrameCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-warmup")) Out.WarmupCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-grid")) Out.GridSize = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else if (!std::strcmp(pArg, "-spacing")) Out.Spacing = std::strtof(pValue, nullptr);
+			else if (!std::strcmp(pArg, "-lights")) Out.LightCount = static_cast<U32>(std::strtoul(pValue, nullptr, 10));
+			else
+			{
+				std::fprintf(stderr, "Unknown argument %s\n", pArg);
+				FAIL;
+			}
+			++i;
+		}
+	}
+
+	if (!Out.pDataPath || !Out.pRenderPathUID || !Out.pMeshUID || !Out.pMaterialUID)
+	{
+		std::fprintf(stderr, "Usage: DEMRenderBench -data <dir> -rp <RenderPathUID> -mesh <MeshUID> -mtl <MaterialUID> [-rt <ID>] [-ds <ID>] [-frames <N>] [-warmup <N>] [-grid <N>] [-spacing <F>] [-lights <N>] [-static] [-csv]\n");
+		FAIL;
+	}
+
+	if (!Out.FrameCount || !Out.GridSize || Out.Spacing <= 0.f)
+	{
+		std::fprintf(stderr, "Frame count, grid size and spacing must be positive\n");
+		FAIL;
+	}
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Models in an N x N grid on the XZ plane centered at the origin, point lights scattered over it
+static void BuildScene(Scene::CSceneNode& Root, const CBenchArgs& Args)
+{
+	const CStrID MeshUID(Args.pMeshUID);
+	const CStrID MaterialUID(Args.pMaterialUID);
+	const float HalfExtent = 0.5f * Args.Spacing * (Args.GridSize - 1);
+
+	for (U32 z = 0; z < Args.GridSize; ++z)
+	{
+		for (U32 x = 0; x < Args.GridSize; ++x)
+		{
+			std::string Name = "Model_" + std::to_string(x) + "_" + std::to_string(z);
+			auto pNode = Root.CreateChild(CStrID(Name.c_str()));
+			pNode->SetLocalPosition(rtm::vector_set(x * Args.Spacing - HalfExtent, 0.f, z * Args.Spacing - HalfExtent));
+			pNode->AddAttribute(*n_new(Frame::CModelAttribute(MeshUID, MaterialUID)));
+		}
+	}
+
+	// A fixed LCG keeps the light layout identical between runs
+	U32 Seed = 12345;
+	auto Rand01 = [&Seed]() { Seed = Seed * 1664525u + 1013904223u; return (Seed >> 8) / static_cast<float>(1 << 24); };
+
+	for (U32 i = 0; i < Args.LightCount; ++i)
+	{
+		std::string Name = "Light_" + std::to_string(i);
+		auto pNode = Root.CreateChild(CStrID(Name.c_str()));
+		pNode->SetLocalPosition(rtm::vector_set((Rand01() * 2.f - 1.f) * HalfExtent, Args.Spacing, (Rand01() * 2.f - 1.f) * HalfExtent));
+
+		auto pLight = n_new(Frame::CPointLightAttribute());
+		pLight->_Color = 0xff000000 | (static_cast<U32>(Rand01() * 255.f) << 16) | (static_cast<U32>(Rand01() * 255.f) << 8) | static_cast<U32>(Rand01() * 255.f);
+		pLight->_Intensity = 1.f;
+		pLight->_Range = Args.Spacing * 4.f;
+		pNode->AddAttribute(*pLight);
+	}
+}
+//---------------------------------------------------------------------
+
+// Mirrors the per-frame part of CGameLevel::Update
+static void UpdateScene(Scene::CSceneNode& Root, Frame::CGraphicsScene& GraphicsScene)
+{
+	Root.Update(nullptr, 0);
+
+	Root.Visit([&GraphicsScene](Scene::CSceneNode& Node)
+	{
+		for (UPTR i = 0; i < Node.GetAttributeCount(); ++i)
+		{
+			Scene::CNodeAttribute& Attr = *Node.GetAttribute(i);
+			if (!Attr.IsActive()) continue;
+
+			if (auto pAttr = Attr.As<Frame::CRenderableAttribute>())
+				pAttr->UpdateInGraphicsScene(GraphicsScene);
+			else if (auto pAttr = Attr.As<Frame::CLightAttribute>())
+				pAttr->UpdateInGraphicsScene(GraphicsScene);
+		}
+
+		OK;
+	});
+}
+//---------------------------------------------------------------------
+
+// The pivot is at the grid center, the camera looks down at it from a fixed distance
+static void SetCameraPose(Scene::CSceneNode& Pivot, Scene::CSceneNode& CameraNode, float Yaw, float Distance)
+{
+	constexpr float Pitch = -0.6f;
+	Pivot.SetLocalRotation(rtm::quat_from_axis_angle(rtm::vector_set(0.f, 1.f, 0.f), Yaw));
+	CameraNode.SetLocalRotation(rtm::quat_from_axis_angle(rtm::vector_set(1.f, 0.f, 0.f), Pitch));
+	CameraNode.SetLocalPosition(rtm::vector_set(0.f, -std::sin(Pitch) * Distance, std::cos(Pitch) * Distance));
+}
+//---------------------------------------------------------------------
+
+static void PrintResults(const CBenchArgs& Args, std::vector<CFrameRecord>& Frames)
+{
+	double TotalMs = 0.0;
+	U64 Draws = 0, StateChanges = 0, RedundantStateChanges = 0, Primitives = 0, Instances = 0, BytesWritten = 0;
+	U64 ModelInstances = 0, Batches = 0, DrawCalls = 0, ReorderedRanges = 0, SkippedPalettes = 0;
+	for (const auto& Frame : Frames)
+	{
+		ModelInstances += Frame.RendererStats.InstanceCount;
+		Batches += Frame.RendererStats.BatchCount;
+		DrawCalls += Frame.RendererStats.DrawCallCount;
+		ReorderedRanges += Frame.RendererStats.ReorderedRangeCount;
+		SkippedPalettes += Frame.RendererStats.SkippedPaletteCount;
+		TotalMs += Frame.TimeMs;
+		Draws += Frame.DrawCount;
+		StateChanges += Frame.StateChangeCount;
+		RedundantStateChanges += Frame.RedundantStateChangeCount;
+		Primitives += Frame.Primitives;
+		Instances += Frame.Instances;
+		BytesWritten += Frame.BytesWritten;
+	}
+
+	std::vector<double> Sorted(Frames.size());
+	std::transform(Frames.cbegin(), Frames.cend(), Sorted.begin(), [](const CFrameRecord& Frame) { return Frame.TimeMs; });
+	std::sort(Sorted.begin(), Sorted.end());
+
+	const double Count = static_cast<double>(Frames.size());
+	const auto Percentile = [&Sorted](double P) { return Sorted[std::min(Sorted.size() - 1, static_cast<size_t>(P * Sorted.size()))]; };
+
+	std::printf("Objects:       %u models, %u point lights\n", Args.GridSize * Args.GridSize, Args.LightCount);
+	std::printf("Frames:        %u (+%u warmup)\n", static_cast<U32>(Frames.size()), Args.WarmupCount);
+	std::printf("Frame ms:      avg %.3f, min %.3f, median %.3f, p95 %.3f, max %.3f\n",
+		TotalMs / Count, Sorted.front(), Percentile(0.5), Percentile(0.95), Sorted.back());
+	std::printf("Per frame:     %.1f draws, %.1f state changes (%.1f redundant), %.1f instances, %.0f primitives, %.0f bytes written\n",
+		Draws / Count, StateChanges / Count, RedundantStateChanges / Count, Instances / Count, Primitives / Count, BytesWritten / Count);
+	std::printf("Renderers:     %.1f instances in %.1f batches, %.1f draw calls, %.1f reordered ranges, %.1f skin palettes skipped\n",
+		ModelInstances / Count, Batches / Count, DrawCalls / Count, ReorderedRanges / Count, SkippedPalettes / Count);
+
+	if (Args.CSV)
+	{
+		std::printf("\nFrame,Ms,Draws,StateChanges,RedundantStateChanges,Instances,Primitives,BytesWritten,Batches,DrawCalls\n");
+		for (size_t i = 0; i < Frames.size(); ++i)
+		{
+			const auto& Frame = Frames[i];
+			std::printf("%u,%.4f,%u,%u,%u,%llu,%llu,%llu,%u,%u\n", static_cast<U32>(i), Frame.TimeMs, Frame.DrawCount, Frame.StateChangeCount,
+				Frame.RedundantStateChangeCount, static_cast<unsigned long long>(Frame.Instances),
+				static_cast<unsigned long long>(Frame.Primitives), static_cast<unsigned long long>(Frame.BytesWritten),
+				Frame.RendererStats.BatchCount, Frame.RendererStats.DrawCallCount);
+		}
+	}
+}
+//---------------------------------------------------------------------
+
+static int RunBenchmark(const CBenchArgs& Args)
+{
+#if DEM_PLATFORM_WIN32
+	DEM::Sys::COSFileSystemWin32 HostFS;
+#else
+	DEM::Sys::COSFileSystemStd HostFS;
+#endif
+
+	IO::CIOServer IOServer;
+	if (!IOServer.MountFileSystem(n_new(IO::CFileSystemNative(&HostFS, Args.pDataPath, true)), "Data"))
+	{
+		std::fprintf(stderr, "Can't mount %s\n", Args.pDataPath);
+		return 1;
+	}
+
+	Resources::CResourceManager ResMgr(&IOServer);
+	ResMgr.RegisterDefaultCreator("msh", &Render::CMeshData::RTTI, n_new(Resources::CMeshLoaderMSH(ResMgr)));
+	ResMgr.RegisterDefaultCreator("dds", &Render::CTextureData::RTTI, n_new(Resources::CTextureLoaderDDS(ResMgr)));
+	ResMgr.RegisterDefaultCreator("tga", &Render::CTextureData::RTTI, n_new(Resources::CTextureLoaderTGA(ResMgr)));
+
+	// Only geometry phases and models are supported, see CApplication::BootstrapGraphics for the full list
+	Frame::CRenderPhaseGeometry::ForceFactoryRegistration();
+	Frame::CModelAttribute::ForceFactoryRegistration();
+	Render::CModel::ForceFactoryRegistration();
+	Render::CModelRenderer::ForceFactoryRegistration();
+
+	Render::PVideoDriverFactory Gfx = n_new(Render::CNullDriverFactory());
+	if (!Gfx->Create())
+	{
+		std::fprintf(stderr, "Can't create null video driver factory\n");
+		return 1;
+	}
+
+	Render::PGPUDriver GPU = Gfx->CreateGPUDriver(Render::Adapter_AutoSelect, Render::GPU_Null);
+	if (!GPU)
+	{
+		std::fprintf(stderr, "Can't create null GPU driver\n");
+		return 1;
+	}
+	auto& NullGPU = static_cast<Render::CNullGPUDriver&>(*GPU);
+
+	Frame::PGraphicsResourceManager GraphicsMgr = n_new(Frame::CGraphicsResourceManager(ResMgr, *GPU));
+
+	// CView treats a missing render path as a fatal error, check it here to exit gracefully
+	if (!GraphicsMgr->GetRenderPath(CStrID(Args.pRenderPathUID)))
+	{
+		std::fprintf(stderr, "Can't load render path %s from %s\n", Args.pRenderPathUID, Args.pDataPath);
+		return 1;
+	}
+
+	Frame::PView View = GraphicsMgr->CreateView(CStrID(Args.pRenderPathUID));
+	if (!View)
+	{
+		std::fprintf(stderr, "Can't create a view with render path %s\n", Args.pRenderPathUID);
+		return 1;
+	}
+
+	const CStrID RenderTargetID(Args.pRenderTargetID);
+	const CStrID DepthStencilID(Args.pDepthStencilID);
+	Render::CRenderTargetDesc RTDesc;
+	RTDesc.Width = 1280;
+	RTDesc.Height = 720;
+	RTDesc.Format = Render::PixelFmt_B8G8R8A8;
+	RTDesc.MSAAQuality = Render::MSAA_None;
+	RTDesc.MipLevels = 1;
+	RTDesc.UseAsShaderInput = false;
+	if (!View->SetRenderTarget(RenderTargetID, GPU->CreateRenderTarget(RTDesc)) ||
+		!View->CreateMatchingDepthStencilBuffer(RenderTargetID, DepthStencilID))
+	{
+		std::fprintf(stderr, "Can't create view render targets\n");
+		return 1;
+	}
+
+	// Build the scene
+
+	Scene::PSceneNode Root = n_new(Scene::CSceneNode(CStrID("_root")));
+	BuildScene(*Root, Args);
+
+	Root->Visit([&ResMgr](Scene::CSceneNode& Node)
+	{
+		for (UPTR i = 0; i < Node.GetAttributeCount(); ++i)
+			Node.GetAttribute(i)->ValidateResources(ResMgr);
+		OK;
+	});
+
+	const float GridExtent = Args.Spacing * Args.GridSize;
+	Frame::CGraphicsScene GraphicsScene;
+	GraphicsScene.Init(rtm::vector_zero(), GridExtent + Args.Spacing * 8.f, 12);
+
+	auto pPivot = Root->CreateChild(CStrID("_camera_pivot"));
+	auto pCamera = View->CreateDefaultCamera(RenderTargetID, *pPivot);
+	pCamera->SetFarPlane(GridExtent * 4.f);
+	auto pCameraNode = pCamera->GetNode();
+	const float CameraDistance = GridExtent * 0.75f;
+	SetCameraPose(*pPivot, *pCameraNode, 0.f, CameraDistance);
+
+	View->SetGraphicsScene(&GraphicsScene);
+
+	// Render frames. Both the scene update and the view rendering are measured.
+
+	constexpr float dt = 1.f / 60.f;
+	constexpr float YawPerFrame = 0.01f;
+
+	std::vector<CFrameRecord> Frames;
+	Frames.reserve(Args.FrameCount);
+
+	const U32 TotalFrames = Args.WarmupCount + Args.FrameCount;
+	for (U32 i = 0; i < TotalFrames; ++i)
+	{
+		if (!Args.StaticCamera)
+			SetCameraPose(*pPivot, *pCameraNode, i * YawPerFrame, CameraDistance);
+
+		const auto Start = std::chrono::steady_clock::now();
+
+		UpdateScene(*Root, GraphicsScene);
+		View->Update(dt);
+		const bool Rendered = View->Render();
+
+		const auto End = std::chrono::steady_clock::now();
+
+		if (!Rendered)
+		{
+			std::fprintf(stderr, "Rendering failed at frame %u\n", i);
+			return 1;
+		}
+
+		if (i < Args.WarmupCount) continue;
+
+		const auto& Stats = NullGPU.GetFrameStats();
+		CFrameRecord Record;
+		Record.TimeMs = std::chrono::duration<double, std::milli>(End - Start).count();
+		Record.DrawCount = Stats.GetDrawCount();
+		Record.StateChangeCount = Stats.GetStateChangeCount();
+		Record.RedundantStateChangeCount = Stats.GetRedundantStateChangeCount();
+		Record.Primitives = Stats.Primitives;
+		Record.Instances = Stats.Instances;
+		Record.BytesWritten = Stats.BytesWritten;
+		Record.RendererStats = View->GetRenderStats();
+		Frames.push_back(Record);
+	}
+
+	PrintResults(Args, Frames);
+
+	// The view references the scene and the GPU, release it first
+	View.reset();
+	Root = nullptr;
+
+	return 0;
+}
+//---------------------------------------------------------------------
+
+}
+
+int main(int argc, const char** argv)
+{
+	CBenchArgs Args;
+	if (!ParseArgs(argc, argv, Args)) return 1;
+
+	n_new(::Events::CEventServer);
+	const int Result = RunBenchmark(Args);
+	if (::Events::CEventServer::HasInstance()) n_delete(EventSrv);
+
+	return Result;
+}
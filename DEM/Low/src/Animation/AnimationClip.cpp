@@ -47,7 +47,7 @@ float CAnimationClip::GetLocomotionPhase(float NormalizedTime) const
 	const size_t SegmentCount = _SampleCount - 1;
 	const float Sample = NormalizedTime * SegmentCount;
 	float IntSampleF;
-	const float Factor = std::modff(Sample, &IntSampleF);
+	const float Factor = std::modf(Sample, &IntSampleF);
 	const size_t IntSample1 = static_cast<size_t>(IntSampleF);
 
 	const float Phase1 = _LocomotionInfo->Phases[IntSample1];
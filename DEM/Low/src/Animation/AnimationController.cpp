@@ -66,13 +66,27 @@ void CAnimationController::Init(PAnimGraphNode&& GraphRoot, Resources::CResource
 
 		_LeftFootBoneIndex = _SkeletonInfo->FindNodePort(LeftFootID);
 		_RightFootBoneIndex = _SkeletonInfo->FindNodePort(RightFootID);
+
+		// Nodes that are not parents of other nodes. Root is never skipped.
+		const auto NodeCount = _SkeletonInfo->GetNodeCount();
+		_LeafBones.assign(NodeCount, true);
+		_LeafBones[0] = false;
+		for (UPTR i = 1; i < NodeCount; ++i)
+		{
+			const auto ParentIndex = _SkeletonInfo->GetNodeInfo(i).ParentIndex;
+			if (ParentIndex != CSkeletonInfo::EmptyPort) _LeafBones[ParentIndex] = false;
+		}
 	}
 	else
 	{
 		// TODO: can issue a warning - no leaf animation data is provided or some assets are not resolved
 		_LeftFootBoneIndex = INVALID_BONE_INDEX;
 		_RightFootBoneIndex = INVALID_BONE_INDEX;
+		_LeafBones.clear();
 	}
+
+	_LODPosesValid = false;
+	_SkipEvaluation = false;
 }
 //---------------------------------------------------------------------
 
@@ -86,6 +100,30 @@ void CAnimationController::Update(const CSkeleton& Target, float dt, Events::IEv
 	// - pose modifiers = skeletal controls (like lookat), object space (like rigid body or what?)
 	// - IK
 
+	if (_LOD.UpdateInterval > 1)
+	{
+		// Throttled update, the graph receives accumulated time when its turn comes
+		_LODAccumulatedDt += dt;
+		_LODTime += dt;
+		if (_LODFramesToSkip)
+		{
+			--_LODFramesToSkip;
+			_SkipEvaluation = true;
+			return;
+		}
+
+		_LODFramesToSkip = _LOD.UpdateInterval - 1;
+	}
+	else
+	{
+		// Time accumulated at the previous LOD must not be lost
+		_LODAccumulatedDt += dt;
+	}
+
+	dt = _LODAccumulatedDt;
+	_LODAccumulatedDt = 0.f;
+	_SkipEvaluation = false;
+
 	if (_GraphRoot)
 	{
 		++_UpdateCounter;
@@ -100,12 +138,37 @@ void CAnimationController::Update(const CSkeleton& Target, float dt, Events::IEv
 //---------------------------------------------------------------------
 
 void CAnimationController::EvaluatePose(CSkeleton& Target)
+{
+	EvaluatePoseDeferred(Target);
+	ApplyPose(Target);
+}
+//---------------------------------------------------------------------
+
+// Reads the current pose from the target but doesn't write the result back. This allows evaluating
+// independent controllers in parallel and applying their poses to the scene later in a fixed order.
+void CAnimationController::EvaluatePoseDeferred(const CSkeleton& Target)
 {
 	ZoneScoped;
 
+	if (_SkipEvaluation)
+	{
+		// Interpolate between the last two evaluated poses. This adds a latency of one
+		// update interval but is much cheaper than a graph evaluation.
+		if (_LODPosesValid && _LODInterval > 0.f)
+		{
+			_CurrPose = _LODPoses[0];
+			_CurrPose.Lerp(_LODPoses[1], std::min(_LODTime / _LODInterval, 1.f));
+		}
+		return;
+	}
+
 	Target.ToPoseBuffer(_CurrPose); // TODO: update only if changed externally?
 
-	if (_PoseIndex > 1)
+	if (!_LOD.Inertialization)
+	{
+		// No pose history is needed, _PoseIndex stays invalid and ProcessInertialization does nothing
+	}
+	else if (_PoseIndex > 1)
 	{
 		// Init both poses from current. Should be used at the first frame and when teleported.
 		_PoseIndex = 0;
@@ -132,7 +195,30 @@ void CAnimationController::EvaluatePose(CSkeleton& Target)
 	//???precalculate something in tools to simplify processing here? is possible?
 	//Output.SetTranslation(0, vector3::Zero);
 
-	Target.FromPoseBuffer(_CurrPose);
+	if (_LOD.UpdateInterval > 1)
+	{
+		if (_LODPosesValid)
+		{
+			std::swap(_LODPoses[0], _LODPoses[1]);
+			_LODPoses[1] = _CurrPose;
+			_CurrPose = _LODPoses[0];
+		}
+		else
+		{
+			_LODPoses[0] = _CurrPose;
+			_LODPoses[1] = _CurrPose;
+			_LODPosesValid = true;
+		}
+
+		_LODInterval = _LODTime;
+		_LODTime = 0.f;
+	}
+}
+//---------------------------------------------------------------------
+
+void CAnimationController::ApplyPose(CSkeleton& Target) const
+{
+	Target.FromPoseBuffer(_CurrPose, _LOD.SkipLeafBones ? &_LeafBones : nullptr);
 }
 //---------------------------------------------------------------------
 
@@ -157,7 +243,7 @@ float CAnimationController::GetLocomotionPhaseFromPose(const CSkeleton& Skeleton
 	const float CosA = rtm::vector_dot3(PhaseDir, ForwardDir);
 	const float SinA = rtm::vector_dot3(rtm::vector_cross3(PhaseDir, ForwardDir), SideDir);
 
-	const float Angle = std::copysignf(std::acosf(CosA) * 180.f / PI, SinA); // Could also use Angle = RadToDeg(std::atan2f(SinA, CosA));
+	const float Angle = std::copysign(std::acos(CosA) * 180.f / PI, SinA); // Could also use Angle = RadToDeg(std::atan2(SinA, CosA));
 
 	return 180.f - Angle; // map 180 -> -180 to 0 -> 360
 }
@@ -172,11 +258,44 @@ float CAnimationController::GetExpectedAnimationLength() const
 
 void CAnimationController::RequestInertialization(float Duration)
 {
+	if (!_LOD.Inertialization) return;
+
 	if (_InertializationRequest < 0.f || _InertializationRequest > Duration)
 		_InertializationRequest = Duration;
 }
 //---------------------------------------------------------------------
 
+// Phase is used for distributing evaluations of different controllers between frames when the update rate is reduced
+void CAnimationController::SetLOD(const CAnimationLOD& LOD, U32 Phase)
+{
+	if (_LOD.UpdateInterval != LOD.UpdateInterval)
+	{
+		if (LOD.UpdateInterval > 1)
+		{
+			_LODFramesToSkip = static_cast<U8>(Phase % LOD.UpdateInterval);
+		}
+		else
+		{
+			_LODFramesToSkip = 0;
+			_LODPosesValid = false;
+			_SkipEvaluation = false;
+		}
+	}
+
+	if (_LOD.Inertialization != LOD.Inertialization)
+	{
+		// Pose history is not tracked without inertialization or is stale after it, reset it like after teleportation
+		_PoseIndex = 2;
+		_InertializationRequest = -1.f;
+		_InertializationDuration = 0.f;
+		_InertializationElapsedTime = 0.f;
+		_InertializationDeficit = 0.f;
+	}
+
+	_LOD = LOD;
+}
+//---------------------------------------------------------------------
+
 // TODO: detect teleportation, reset pending request and _InertializationDt to mitigate abrupt velocity changes
 // That must zero out _LastPoseDt, when it is not a last dt yet!
 void CAnimationController::ProcessInertialization()
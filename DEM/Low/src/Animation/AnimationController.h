@@ -25,6 +25,7 @@ using PAnimationController = std::unique_ptr<class CAnimationController>;
 using PAnimGraphNode = std::unique_ptr<class CAnimGraphNode>;
 using PSkeletonInfo = Ptr<class CSkeletonInfo>;
 class CSkeleton;
+class CAnimationPoseCache;
 using CAnimVarStorage = CVarStorage<bool, int, float, CStrID>;
 
 // FIXME: unify EmptyPort, InvalidPort and this!
@@ -40,6 +41,15 @@ enum class EParamType
 	Invalid // For inexistent params
 };
 
+// Animation level of detail. Distant characters can be evaluated less often and with less detail.
+struct CAnimationLOD
+{
+	float MinDistance = 0.f;      // The level is used for characters farther than this from the closest COI
+	U8    UpdateInterval = 1;     // Evaluate the graph once in N frames, interpolating poses in between
+	bool  SkipLeafBones = false;  // Don't write leaf bones (fingers, toes, attachments) to the scene
+	bool  Inertialization = true; // Disabling it skips pose history tracking and diff evaluation
+};
+
 struct CAnimationInitContext
 {
 	CAnimationController&           Controller;
@@ -86,6 +96,18 @@ protected:
 	U16                                           _LeftFootBoneIndex = INVALID_BONE_INDEX;
 	U16                                           _RightFootBoneIndex = INVALID_BONE_INDEX;
 
+	CAnimationLOD                                 _LOD;
+	std::vector<bool>                             _LeafBones;
+	CPoseBuffer                                   _LODPoses[2];            // The last two evaluated poses, interpolated at reduced update rate
+	float                                         _LODTime = 0.f;          // Time elapsed since the last evaluation
+	float                                         _LODInterval = 0.f;      // Time between the last two evaluations
+	float                                         _LODAccumulatedDt = 0.f; // Time not yet passed to the graph
+	U8                                            _LODFramesToSkip = 0;
+	bool                                          _LODPosesValid = false;
+	bool                                          _SkipEvaluation = false;
+
+	CAnimationPoseCache*                          _pPoseCache = nullptr;
+
 	// shared conditions (allow nesting or not? if nested, must control cyclic dependencies and enforce calculation order)
 	// NB: each condition, shared or not, must cache its value and recalculate only if used parameter values changed!
 
@@ -101,6 +123,8 @@ public:
 	void   Init(PAnimGraphNode&& GraphRoot, Resources::CResourceManager& ResMgr, CStrID LeftFootID = {}, CStrID RightFootID = {}, std::map<CStrID, float>&& Floats = {}, std::map<CStrID, int>&& Ints = {}, std::map<CStrID, bool>&& Bools = {}, std::map<CStrID, CStrID>&& Strings = {}, const std::map<CStrID, CStrID>& AssetOverrides = {});
 	void   Update(const CSkeleton& Target, float dt, Events::IEventOutput* pEventOutput);
 	void   EvaluatePose(CSkeleton& Target);
+	void   EvaluatePoseDeferred(const CSkeleton& Target);
+	void   ApplyPose(CSkeleton& Target) const;
 
 	auto&  GetParams() { return _Params; }
 	auto&  GetParams() const { return _Params; }
@@ -108,8 +132,14 @@ public:
 	float  GetLocomotionPhaseFromPose(const CSkeleton& Skeleton) const;
 	float  GetExpectedAnimationLength() const;
 	void   RequestInertialization(float Duration);
+	void   SetLOD(const CAnimationLOD& LOD, U32 Phase = 0);
+	void   SetPoseCache(CAnimationPoseCache* pPoseCache) { _pPoseCache = pPoseCache; }
+
+	const CAnimationLOD& GetLOD() const { return _LOD; }
+	CAnimationPoseCache* GetPoseCache() const { return _pPoseCache; }
 
 	const CSkeletonInfo* GetSkeletonInfo() const { return _SkeletonInfo.Get(); }
+	const CPoseBuffer&   GetCurrentPose() const { return _CurrPose; }
 	U32                  GetUpdateIndex() const { return _UpdateCounter; }
 };
 
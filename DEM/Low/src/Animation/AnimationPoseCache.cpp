@@ -0,0 +1,180 @@
+#include "AnimationPoseCache.h"
+#include <Animation/AnimationClip.h>
+#include <Animation/AnimationSampler.h>
+
+namespace DEM::Anim
+{
+
+// Writes bone transforms from ACL clip to a key of the cache
+struct CKeyPoseWriter : public acl::track_writer
+{
+	rtm::qvvf* _pKey;
+
+	CKeyPoseWriter(rtm::qvvf* pKey) : _pKey(pKey) {}
+
+	void RTM_SIMD_CALL write_rotation(uint32_t track_index, rtm::quatf_arg0 rotation) { _pKey[track_index].rotation = rotation; }
+	void RTM_SIMD_CALL write_translation(uint32_t track_index, rtm::vector4f_arg0 translation) { _pKey[track_index].translation = translation; }
+	void RTM_SIMD_CALL write_scale(uint32_t track_index, rtm::vector4f_arg0 scale) { _pKey[track_index].scale = scale; }
+};
+
+static U32 GetKeyCount(const CAnimationClip& Clip, float SampleRate)
+{
+	return static_cast<U32>(std::ceil(Clip.GetDuration() * SampleRate)) + 1;
+}
+//---------------------------------------------------------------------
+
+CAnimationPoseCache::CAnimationPoseCache(UPTR MemoryBudget, float SampleRate, U32 MinUsesToDecode)
+	: _MemoryBudget(MemoryBudget)
+	, _SampleRate(std::max(SampleRate, 1.f))
+	, _MinUsesToDecode(std::max<U32>(MinUsesToDecode, 1))
+{
+}
+//---------------------------------------------------------------------
+
+CAnimationPoseCache::~CAnimationPoseCache()
+{
+	Clear();
+}
+//---------------------------------------------------------------------
+
+bool CAnimationPoseCache::DecodeClip(CEntry& Entry)
+{
+	ZoneScoped;
+
+	const auto* pACLClip = Entry.Clip->GetACLClip();
+	const float Duration = Entry.Clip->GetDuration();
+	if (!pACLClip || Duration <= 0.f) return false;
+
+	const U32 KeyCount = GetKeyCount(*Entry.Clip, _SampleRate);
+	const U32 TrackCount = pACLClip->get_num_tracks();
+	const UPTR Size = KeyCount * TrackCount * sizeof(rtm::qvvf);
+	auto* pKeys = static_cast<rtm::qvvf*>(n_malloc_aligned(Size, alignof(rtm::qvvf)));
+	if (!pKeys) return false;
+
+	// Keys are sampled with interpolation, so the cache rate doesn't depend on the rate the clip was exported with
+	const float KeyDuration = Duration / static_cast<float>(KeyCount - 1);
+	CACLContext Context;
+	Context.initialize(*pACLClip);
+	for (U32 i = 0; i < KeyCount; ++i)
+	{
+		Context.seek(std::min(i * KeyDuration, Duration), acl::sample_rounding_policy::none);
+		CKeyPoseWriter Writer(pKeys + i * TrackCount);
+		Context.decompress_tracks(Writer);
+	}
+
+	Entry.Poses.pKeys = pKeys;
+	Entry.Poses.KeyCount = KeyCount;
+	Entry.Poses.TrackCount = TrackCount;
+	Entry.Poses.KeyDuration = KeyDuration;
+	_MemoryUsed += Size;
+
+	return true;
+}
+//---------------------------------------------------------------------
+
+void CAnimationPoseCache::FreeClip(CEntry& Entry)
+{
+	if (!Entry.Poses.pKeys) return;
+
+	_MemoryUsed -= Entry.Poses.KeyCount * Entry.Poses.TrackCount * sizeof(rtm::qvvf);
+	auto* pKeys = const_cast<rtm::qvvf*>(Entry.Poses.pKeys);
+	SAFE_FREE_ALIGNED(pKeys);
+	Entry.Poses = {};
+}
+//---------------------------------------------------------------------
+
+// Returns decoded keys or nullptr if the clip is not cached. The result is valid until the next Update.
+const CAnimationPoseCache::CKeyPoses* CAnimationPoseCache::GetKeyPoses(CAnimationClip& Clip)
+{
+	auto It = _Entries.find(&Clip);
+	if (It == _Entries.cend())
+	{
+		// New clips are registered in Update, because the map is read without locking. The set
+		// keeps pending registrations unique however many samplers miss the clip in a frame.
+		std::lock_guard Lock(_PendingMutex);
+		_PendingClips.insert(&Clip);
+		return nullptr;
+	}
+
+	auto& Entry = *It->second;
+	Entry.UseCount.fetch_add(1, std::memory_order_relaxed);
+	return Entry.Poses.pKeys ? &Entry.Poses : nullptr;
+}
+//---------------------------------------------------------------------
+
+void CAnimationPoseCache::Update()
+{
+	ZoneScoped;
+
+	++_FrameIndex;
+
+	for (auto* pClip : _PendingClips)
+	{
+		auto& Entry = _Entries[pClip];
+		if (!Entry)
+		{
+			Entry = std::make_unique<CEntry>();
+			Entry->Clip = pClip;
+			Entry->LastUsedFrame = _FrameIndex;
+		}
+	}
+	_PendingClips.clear();
+
+	// Count uses, collect hot clips and forget clips that are not played for a long time
+	std::vector<CEntry*> ToDecode;
+	for (auto It = _Entries.begin(); It != _Entries.end(); )
+	{
+		auto& Entry = *It->second;
+		const U32 UseCount = Entry.UseCount.exchange(0, std::memory_order_relaxed);
+		if (UseCount) Entry.LastUsedFrame = _FrameIndex;
+
+		if (UseCount >= _MinUsesToDecode)
+		{
+			if (!Entry.Poses.pKeys) ToDecode.push_back(&Entry);
+		}
+		else if (_FrameIndex - Entry.LastUsedFrame > FORGET_AFTER_FRAMES)
+		{
+			FreeClip(Entry);
+			It = _Entries.erase(It);
+			continue;
+		}
+
+		++It;
+	}
+
+	for (auto* pEntry : ToDecode)
+	{
+		const auto* pACLClip = pEntry->Clip->GetACLClip();
+		if (!pACLClip) continue;
+
+		const UPTR Size = GetKeyCount(*pEntry->Clip, _SampleRate) * pACLClip->get_num_tracks() * sizeof(rtm::qvvf);
+		if (Size > _MemoryBudget) continue;
+
+		// Evict least recently used clips that were not played in this frame
+		while (_MemoryUsed + Size > _MemoryBudget)
+		{
+			CEntry* pLRU = nullptr;
+			for (auto& [pClip, Entry] : _Entries)
+				if (Entry->Poses.pKeys && Entry->LastUsedFrame != _FrameIndex && (!pLRU || Entry->LastUsedFrame < pLRU->LastUsedFrame))
+					pLRU = Entry.get();
+
+			if (!pLRU) break;
+			FreeClip(*pLRU);
+		}
+
+		if (_MemoryUsed + Size <= _MemoryBudget)
+			DecodeClip(*pEntry);
+	}
+}
+//---------------------------------------------------------------------
+
+void CAnimationPoseCache::Clear()
+{
+	for (auto& [pClip, Entry] : _Entries)
+		FreeClip(*Entry);
+	_Entries.clear();
+	_PendingClips.clear();
+}
+//---------------------------------------------------------------------
+
+}
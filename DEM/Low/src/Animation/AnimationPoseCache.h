@@ -0,0 +1,68 @@
+#pragma once
+#include <Data/Ptr.h>
+#include <rtm/qvvf.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <mutex>
+
+// Memory-bounded cache of decompressed key poses for animation clips played by many samplers at once.
+// Crowds playing the same clips decode each key once, and samplers only interpolate between cached keys.
+// Lookups are thread-safe and may be done from jobs. Update() decodes hot clips and evicts the least recently
+// used ones, it must be called when no sampler is evaluated, because it invalidates returned key pointers.
+
+namespace DEM::Anim
+{
+typedef Ptr<class CAnimationClip> PAnimationClip;
+
+class CAnimationPoseCache final
+{
+public:
+
+	struct CKeyPoses
+	{
+		const rtm::qvvf* pKeys = nullptr;   // KeyCount * TrackCount transforms, key-major
+		U32              KeyCount = 0;
+		U32              TrackCount = 0;
+		float            KeyDuration = 0.f; // Time between two subsequent keys
+	};
+
+protected:
+
+	struct CEntry
+	{
+		PAnimationClip   Clip;
+		CKeyPoses        Poses;
+		std::atomic<U32> UseCount { 0 };  // Evaluations since the last Update
+		U32              LastUsedFrame = 0;
+	};
+
+	std::unordered_map<const CAnimationClip*, std::unique_ptr<CEntry>> _Entries; // Modified only in Update
+	std::unordered_set<CAnimationClip*> _PendingClips;   // Unique clips to register in Update
+	std::mutex                   _PendingMutex;
+
+	UPTR                         _MemoryBudget;
+	UPTR                         _MemoryUsed = 0;
+	float                        _SampleRate;
+	U32                          _MinUsesToDecode;
+	U32                          _FrameIndex = 0;
+
+	bool DecodeClip(CEntry& Entry);
+	void FreeClip(CEntry& Entry);
+
+public:
+
+	static constexpr U32 FORGET_AFTER_FRAMES = 300;
+
+	CAnimationPoseCache(UPTR MemoryBudget = 16 * 1024 * 1024, float SampleRate = 30.f, U32 MinUsesToDecode = 4);
+	~CAnimationPoseCache();
+
+	const CKeyPoses* GetKeyPoses(CAnimationClip& Clip);
+	void             Update();
+	void             Clear();
+
+	UPTR             GetMemoryUsed() const { return _MemoryUsed; }
+	UPTR             GetMemoryBudget() const { return _MemoryBudget; }
+};
+
+}
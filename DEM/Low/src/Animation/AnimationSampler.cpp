@@ -1,5 +1,6 @@
 #include "AnimationSampler.h"
 #include <Animation/AnimationClip.h>
+#include <Animation/AnimationPoseCache.h>
 #include <Animation/SkeletonInfo.h>
 #include <Animation/PoseOutput.h>
 #include <Animation/PoseBuffer.h>
@@ -52,25 +53,90 @@ struct CMappedPoseBufferWriter : public acl::track_writer
 	bool skip_track_scale(uint32_t track_index) const { return _pMapping[track_index] == CSkeletonInfo::EmptyPort; }
 };
 
+// Contexts are shared by all samplers running on the same thread. Each one stays bound to a recently played
+// clip, so that crowds playing the same clips don't reinitialize them and don't keep a context per character.
+static CACLContext& GetDecompressionContext(const acl::compressed_tracks& ACLClip)
+{
+	constexpr size_t CONTEXTS_PER_THREAD = 8;
+	thread_local CACLContext Contexts[CONTEXTS_PER_THREAD];
+	thread_local size_t NextContext = 0;
+
+	for (auto& Context : Contexts)
+		if (Context.is_bound_to(ACLClip))
+			return Context;
+
+	auto& Context = Contexts[NextContext];
+	NextContext = (NextContext + 1) % CONTEXTS_PER_THREAD;
+	Context.initialize(ACLClip);
+	return Context;
+}
+//---------------------------------------------------------------------
+
+// Interpolates between two cached keys the same way as ACL interpolates between samples
+template<typename TWriter>
+static void SampleKeyPoses(const CAnimationPoseCache::CKeyPoses& Poses, float Time, float Duration, TWriter& Writer)
+{
+	const float KeyPosition = std::clamp(Time, 0.f, Duration) / Poses.KeyDuration;
+	const U32 Key = std::min(static_cast<U32>(KeyPosition), Poses.KeyCount - 1);
+	const U32 NextKey = std::min(Key + 1, Poses.KeyCount - 1);
+	const float Alpha = KeyPosition - static_cast<float>(Key);
+
+	const rtm::qvvf* pA = Poses.pKeys + Key * Poses.TrackCount;
+	const rtm::qvvf* pB = Poses.pKeys + NextKey * Poses.TrackCount;
+	for (uint32_t i = 0; i < Poses.TrackCount; ++i)
+	{
+		if (!Writer.skip_track_rotation(i))
+			Writer.write_rotation(i, rtm::quat_lerp(pA[i].rotation, pB[i].rotation, Alpha));
+		if (!Writer.skip_track_translation(i))
+			Writer.write_translation(i, rtm::vector_lerp(pA[i].translation, pB[i].translation, Alpha));
+		if (!Writer.skip_track_scale(i))
+			Writer.write_scale(i, rtm::vector_lerp(pA[i].scale, pB[i].scale, Alpha));
+	}
+}
+//---------------------------------------------------------------------
+
 CAnimationSampler::CAnimationSampler() = default;
 CAnimationSampler::~CAnimationSampler() = default;
 
+template<typename TWriter>
+void CAnimationSampler::Decompress(float Time, TWriter& Writer)
+{
+	if (_pPoseCache)
+	{
+		if (auto* pPoses = _pPoseCache->GetKeyPoses(*_Clip))
+		{
+			SampleKeyPoses(*pPoses, Time, _Clip->GetDuration(), Writer);
+			return;
+		}
+	}
+
+	auto& Context = GetDecompressionContext(*_Clip->GetACLClip());
+	Context.seek(Time, acl::sample_rounding_policy::none);
+	Context.decompress_tracks(Writer);
+}
+//---------------------------------------------------------------------
+
 void CAnimationSampler::EvaluatePose(float Time, IPoseOutput& Output)
 {
 	if (!_Clip) return;
-	_Context.seek(Time, acl::sample_rounding_policy::none);
-	_Context.decompress_tracks(COutputPoseWriter(Output));
+	COutputPoseWriter Writer(Output);
+	Decompress(Time, Writer);
 }
 //---------------------------------------------------------------------
 
 void CAnimationSampler::EvaluatePose(float Time, CPoseBuffer& Output, U16* pMapping)
 {
 	if (!_Clip) return;
-	_Context.seek(Time, acl::sample_rounding_policy::none);
 	if (pMapping)
-		_Context.decompress_tracks(CMappedPoseBufferWriter(Output, pMapping));
+	{
+		CMappedPoseBufferWriter Writer(Output, pMapping);
+		Decompress(Time, Writer);
+	}
 	else
-		_Context.decompress_tracks(CPoseBufferWriter(Output));
+	{
+		CPoseBufferWriter Writer(Output);
+		Decompress(Time, Writer);
+	}
 }
 //---------------------------------------------------------------------
 
@@ -78,11 +144,7 @@ bool CAnimationSampler::SetClip(PAnimationClip Clip)
 {
 	if (!Clip || Clip->GetDuration() <= 0.f) return false;
 
-	const auto* pACLClip = Clip->GetACLClip();
-	if (!pACLClip) return false;
-
-	if (!_Context.is_bound_to(*pACLClip))
-		_Context.initialize(*pACLClip);
+	if (!Clip->GetACLClip()) return false;
 
 	_Clip = std::move(Clip);
 
@@ -8,23 +8,26 @@ namespace DEM::Anim
 {
 class IPoseOutput;
 class CPoseBuffer;
+class CAnimationPoseCache;
 typedef Ptr<class CAnimationClip> PAnimationClip;
 typedef std::unique_ptr<class CAnimationSampler> PAnimationSampler;
 typedef std::unique_ptr<class CStaticPose> PStaticPose;
 using CACLContext = acl::decompression_context<acl::default_transform_decompression_settings>;
 
-class alignas(CACLContext) CAnimationSampler final
+// Decompression contexts are not owned by samplers. They are shared by all samplers on the same thread and stay
+// bound to recently played clips, and hot clips may be sampled from decoded key poses of a shared pose cache.
+class CAnimationSampler final
 {
 protected:
 
-	CACLContext    _Context; // At offset 0
-	PAnimationClip _Clip;
+	PAnimationClip       _Clip;
+	CAnimationPoseCache* _pPoseCache = nullptr;
 
 	//???store mask right here or separately? what bones (and maybe what components of SRT in them) are used.
 
-public:
+	template<typename TWriter> void Decompress(float Time, TWriter& Writer);
 
-	DEM_ALLOCATE_ALIGNED(alignof(CAnimationSampler));
+public:
 
 	CAnimationSampler();
 	~CAnimationSampler();
@@ -33,6 +36,7 @@ public:
 	void  EvaluatePose(float Time, CPoseBuffer& Output, U16* pMapping = nullptr);
 
 	bool  SetClip(PAnimationClip Clip);
+	void  SetPoseCache(CAnimationPoseCache* pPoseCache) { _pPoseCache = pPoseCache; }
 	auto* GetClip() const { return _Clip.Get(); }
 };
 
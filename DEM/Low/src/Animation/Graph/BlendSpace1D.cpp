@@ -94,12 +94,8 @@ void CBlendSpace1D::EvaluatePose(CPoseBuffer& Output)
 
 	if (!_pSecond) return;
 
-	Output *= (1.f - _BlendFactor);
-
 	_pSecond->EvaluatePose(_TmpPose);
-	Output.Accumulate(_TmpPose, _BlendFactor);
-
-	Output.NormalizeRotations();
+	Output.Lerp(_TmpPose, _BlendFactor);
 }
 //---------------------------------------------------------------------
 
@@ -185,7 +185,11 @@ void CBlendSpace2D::Init(CAnimationInitContext& Context)
 
 		// Call after initializing sources, letting them to contribute to SkeletonInfo
 		if (Context.SkeletonInfo && _Samples.size() > 1)
+		{
 			_TmpPose.SetSize(Context.SkeletonInfo->GetNodeCount());
+			if (_Samples.size() > 2)
+				_TmpPose2.SetSize(Context.SkeletonInfo->GetNodeCount());
+		}
 	}
 }
 //---------------------------------------------------------------------
@@ -196,8 +200,8 @@ static inline void AdvanceNormalizedTime(float dt, float AnimLength, float& Norm
 	if (AnimLength)
 	{
 		NormalizedTime += (dt / AnimLength);
-		if (NormalizedTime < 0.f) NormalizedTime += (1.f - std::truncf(NormalizedTime));
-		else if (NormalizedTime > 1.f) NormalizedTime -= std::truncf(NormalizedTime);
+		if (NormalizedTime < 0.f) NormalizedTime += (1.f - std::trunc(NormalizedTime));
+		else if (NormalizedTime > 1.f) NormalizedTime -= std::trunc(NormalizedTime);
 	}
 	else NormalizedTime = 0.f;
 }
@@ -437,18 +441,18 @@ void CBlendSpace2D::EvaluatePose(CPoseBuffer& Output)
 
 	if (!_pActiveSamples[1]) return;
 
-	Output *= _Weights[0];
-
 	_pActiveSamples[1]->EvaluatePose(_TmpPose);
-	Output.Accumulate(_TmpPose, _Weights[1]);
 
 	if (_pActiveSamples[2])
 	{
-		_pActiveSamples[2]->EvaluatePose(_TmpPose);
-		Output.Accumulate(_TmpPose, _Weights[2]);
+		// Single pass over all bones instead of scaling, accumulating and normalizing separately
+		_pActiveSamples[2]->EvaluatePose(_TmpPose2);
+		Output.Blend(_Weights[0], _TmpPose, _Weights[1], _TmpPose2, _Weights[2]);
+	}
+	else
+	{
+		Output.Lerp(_TmpPose, _Weights[1]);
 	}
-
-	Output.NormalizeRotations();
 }
 //---------------------------------------------------------------------
 
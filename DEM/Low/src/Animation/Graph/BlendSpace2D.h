@@ -31,7 +31,7 @@ protected:
 	struct CTriangle
 	{
 		CSample* Samples[3] = {};
-		U32      Adjacent[3] = { INVALID_INDEX, INVALID_INDEX, INVALID_INDEX };
+		U32      Adjacent[3] = { INVALID_INDEX_T<U32>, INVALID_INDEX_T<U32>, INVALID_INDEX_T<U32> };
 		float    InvDenominator;
 		float    ax, ay;
 		float    abx, aby;
@@ -40,15 +40,16 @@ protected:
 
 	struct CEdge
 	{
-		U32 TriIndex = INVALID_INDEX;
-		U32 EdgeIndex = INVALID_INDEX; // [0; 2]
-		U32 Adjacent[2] = { INVALID_INDEX, INVALID_INDEX };
+		U32 TriIndex = INVALID_INDEX_T<U32>;
+		U32 EdgeIndex = INVALID_INDEX_T<U32>; // [0; 2]
+		U32 Adjacent[2] = { INVALID_INDEX_T<U32>, INVALID_INDEX_T<U32> };
 	};
 
 	std::vector<CSample>   _Samples;
 	std::vector<CTriangle> _Triangles;
 	std::vector<CEdge>     _Contour;
 	CPoseBuffer            _TmpPose;
+	CPoseBuffer            _TmpPose2;
 	CAnimGraphNode*        _pActiveSamples[3] = { nullptr };
 	float                  _Weights[3] = { 0.f };
 
@@ -78,6 +78,9 @@ void CClipPlayerNode::Update(CAnimationUpdateContext& Context, float dt)
 	const auto pClip = _Sampler.GetClip();
 	if (!pClip || pClip->GetDuration() <= 0.f || _Speed == 0.f) return;
 
+	// Hot clips are sampled from the shared cache of decoded key poses if the controller provides it
+	_Sampler.SetPoseCache(Context.Controller.GetPoseCache());
+
 	const U32 CurrUpdateIndex = Context.Controller.GetUpdateIndex();
 	const bool WasInactive = (_LastUpdateIndex != CurrUpdateIndex - 1) || !IsActive(); // Was not updated on prev frame or played to the end without looping
 	if (_ResetOnActivate && WasInactive) ResetTime();
@@ -9,12 +9,12 @@ namespace DEM::Anim
 {
 using PClipPlayerNode = std::unique_ptr<class CClipPlayerNode>;
 
-class alignas(CAnimationSampler) CClipPlayerNode : public CAnimGraphNode
+class CClipPlayerNode : public CAnimGraphNode
 {
 protected:
 
 	//!!!TODO: support composite clips in a sampler!
-	CAnimationSampler      _Sampler; // At offset 0 for proper alignment
+	CAnimationSampler      _Sampler;
 	std::unique_ptr<U16[]> _PortMapping;
 
 	CStrID                 _ClipID;
@@ -32,8 +32,6 @@ protected:
 
 public:
 
-	DEM_ALLOCATE_ALIGNED(alignof(CClipPlayerNode));
-
 	CClipPlayerNode(CStrID ClipID, bool Loop = true, float Speed = 1.f, float StartTime = 0.f, bool ResetOnActivate = true);
 	~CClipPlayerNode();
 
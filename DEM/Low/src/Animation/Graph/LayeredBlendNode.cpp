@@ -0,0 +1,68 @@
+#include "LayeredBlendNode.h"
+#include <Animation/AnimationController.h>
+#include <Animation/SkeletonInfo.h>
+
+namespace DEM::Anim
+{
+
+CLayeredBlendNode::CLayeredBlendNode(PAnimGraphNode&& Base, PAnimGraphNode&& Layer, std::vector<CStrID>&& MaskRootIDs, CStrID ParamID, float FallbackWeight)
+	: _Base(std::move(Base))
+	, _Layer(std::move(Layer))
+	, _MaskRootIDs(std::move(MaskRootIDs))
+	, _ParamID(ParamID)
+	, _FallbackWeight(FallbackWeight)
+{
+}
+//---------------------------------------------------------------------
+
+void CLayeredBlendNode::Init(CAnimationInitContext& Context)
+{
+	_ParamHandle = Context.Controller.GetParams().Find<float>(_ParamID);
+
+	if (_Base) _Base->Init(Context);
+	if (_Layer) _Layer->Init(Context);
+
+	// Call after initializing sources, letting them to contribute to SkeletonInfo
+	_BoneWeights.clear();
+	if (!Context.SkeletonInfo || !_Layer) return;
+
+	const auto& SkeletonInfo = *Context.SkeletonInfo;
+	const UPTR NodeCount = SkeletonInfo.GetNodeCount();
+	_LayerPose.SetSize(NodeCount);
+
+	// Children always go after their parents, so subtrees are marked in one pass
+	_BoneWeights.resize(NodeCount, 0.f);
+	for (UPTR i = 0; i < NodeCount; ++i)
+	{
+		const auto& NodeInfo = SkeletonInfo.GetNodeInfo(i);
+		if (std::find(_MaskRootIDs.cbegin(), _MaskRootIDs.cend(), NodeInfo.ID) != _MaskRootIDs.cend())
+			_BoneWeights[i] = 1.f;
+		else if (NodeInfo.ParentIndex != CSkeletonInfo::EmptyPort)
+			_BoneWeights[i] = _BoneWeights[NodeInfo.ParentIndex];
+	}
+}
+//---------------------------------------------------------------------
+
+void CLayeredBlendNode::Update(CAnimationUpdateContext& Context, float dt)
+{
+	_Weight = std::clamp(Context.Controller.GetParams().Get<float>(_ParamHandle, _FallbackWeight), 0.f, 1.f);
+
+	if (_Base) _Base->Update(Context, dt);
+	if (_Layer && _Weight > 0.f) _Layer->Update(Context, dt);
+}
+//---------------------------------------------------------------------
+
+void CLayeredBlendNode::EvaluatePose(CPoseBuffer& Output)
+{
+	if (_Base) _Base->EvaluatePose(Output);
+
+	if (!_Layer || _Weight <= 0.f || _BoneWeights.empty()) return;
+
+	// Bones not animated by the layer must keep the base pose
+	_LayerPose = Output;
+	_Layer->EvaluatePose(_LayerPose);
+	Output.Lerp(_LayerPose, _Weight, _BoneWeights.data(), _BoneWeights.size());
+}
+//---------------------------------------------------------------------
+
+}
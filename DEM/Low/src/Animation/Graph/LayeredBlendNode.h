@@ -0,0 +1,41 @@
+#pragma once
+#include <Animation/Graph/AnimGraphNode.h>
+#include <Animation/PoseBuffer.h>
+#include <Data/StringID.h>
+#include <Data/VarStorage.h> // for HVar
+
+// Blends a layer subgraph over a base subgraph only for bones under the specified mask roots,
+// e.g. upper body actions over locomotion. The layer weight may be driven by a float parameter.
+
+namespace DEM::Anim
+{
+using PLayeredBlendNode = std::unique_ptr<class CLayeredBlendNode>;
+
+class CLayeredBlendNode : public CAnimGraphNode
+{
+protected:
+
+	PAnimGraphNode      _Base;
+	PAnimGraphNode      _Layer;
+	std::vector<CStrID> _MaskRootIDs;   // Bones that are blended with their whole subtrees
+	std::vector<float>  _BoneWeights;   // Per pose port, built in Init
+	CPoseBuffer         _LayerPose;
+	float               _Weight = 0.f;  // Current layer weight
+
+	CStrID              _ParamID;
+	HVar                _ParamHandle;   // Cached for fast access
+	float               _FallbackWeight = 1.f; // If param is not found, use this value
+
+public:
+
+	CLayeredBlendNode(PAnimGraphNode&& Base, PAnimGraphNode&& Layer, std::vector<CStrID>&& MaskRootIDs, CStrID ParamID, float FallbackWeight = 1.f);
+
+	virtual void  Init(CAnimationInitContext& Context) override;
+	virtual void  Update(CAnimationUpdateContext& Context, float dt) override;
+	virtual void  EvaluatePose(CPoseBuffer& Output) override;
+
+	virtual float GetAnimationLengthScaled() const override { return _Base ? _Base->GetAnimationLengthScaled() : 0.f; }
+	virtual bool  IsActive() const override { return _Base && _Base->IsActive(); }
+};
+
+}
@@ -14,6 +14,13 @@ protected:
 	std::unique_ptr<rtm::qvvf[]> _Transforms;
 	UPTR                         _Count = 0;
 
+	// Flips Other to the same hemisphere as Base for blending with shortest arc. Branchless, based on a 4D dot product sign.
+	static DEM_FORCE_INLINE rtm::quatf RTM_SIMD_CALL ShortestArc(rtm::quatf_arg0 Base, rtm::quatf_arg1 Other)
+	{
+		const rtm::vector4f Dot = rtm::vector_dot(Base, Other);
+		return rtm::vector_xor(Other, rtm::vector_and(Dot, rtm::vector_set(-0.f)));
+	}
+
 public:
 
 	CPoseBuffer() = default;
@@ -47,11 +54,7 @@ public:
 			const auto& OtherTfm = Other[i];
 			auto& Tfm = _Transforms.get()[i];
 
-			// Blend with shortest arc, based on a 4D dot product sign
-			if (rtm::vector_dot(Tfm.rotation, OtherTfm.rotation) < 0.f)
-				Tfm.rotation = rtm::vector_sub(Tfm.rotation, OtherTfm.rotation);
-			else
-				Tfm.rotation = rtm::vector_add(Tfm.rotation, OtherTfm.rotation);
+			Tfm.rotation = rtm::vector_add(Tfm.rotation, ShortestArc(Tfm.rotation, OtherTfm.rotation));
 
 			Tfm.translation = rtm::vector_add(Tfm.translation, OtherTfm.translation);
 			Tfm.scale = rtm::vector_add(Tfm.scale, OtherTfm.scale);
@@ -67,17 +70,79 @@ public:
 			const auto& OtherTfm = Other[i];
 			auto& Tfm = _Transforms.get()[i];
 
-			// Blend with shortest arc, based on a 4D dot product sign
-			auto OtherRotation = OtherTfm.rotation;
-			if (rtm::vector_dot(Tfm.rotation, OtherRotation) < 0.f)
-				OtherRotation = rtm::vector_neg(OtherRotation);
-			Tfm.rotation = rtm::vector_mul_add(OtherRotation, WeightVector, Tfm.rotation);
+			Tfm.rotation = rtm::vector_mul_add(ShortestArc(Tfm.rotation, OtherTfm.rotation), WeightVector, Tfm.rotation);
 
 			Tfm.translation = rtm::vector_mul_add(OtherTfm.translation, WeightVector, Tfm.translation);
 			Tfm.scale = rtm::vector_mul_add(OtherTfm.scale, WeightVector, Tfm.scale);
 		}
 	}
 
+	// Single pass replacement for "*= (1 - Factor), Accumulate(Other, Factor), NormalizeRotations()"
+	void Lerp(const CPoseBuffer& Other, float Factor)
+	{
+		const UPTR Size = std::min(_Count, Other._Count);
+		auto* pDest = _Transforms.get();
+		const auto* pSrc = Other._Transforms.get();
+		for (UPTR i = 0; i < Size; ++i)
+		{
+			auto& Tfm = pDest[i];
+			const auto& OtherTfm = pSrc[i];
+			Tfm.rotation = rtm::quat_lerp(Tfm.rotation, OtherTfm.rotation, Factor); // Takes shortest arc and normalizes
+			Tfm.translation = rtm::vector_lerp(Tfm.translation, OtherTfm.translation, Factor);
+			Tfm.scale = rtm::vector_lerp(Tfm.scale, OtherTfm.scale, Factor);
+		}
+	}
+
+	// Per-bone masked lerp. Bone weight of 0.f keeps this pose, 1.f applies the full Factor. Bones without a weight keep this pose.
+	void Lerp(const CPoseBuffer& Other, float Factor, const float* pBoneWeights, UPTR BoneWeightCount)
+	{
+		if (!pBoneWeights) return Lerp(Other, Factor);
+
+		const UPTR Size = std::min({ _Count, Other._Count, BoneWeightCount });
+		auto* pDest = _Transforms.get();
+		const auto* pSrc = Other._Transforms.get();
+		for (UPTR i = 0; i < Size; ++i)
+		{
+			const float BoneFactor = Factor * pBoneWeights[i];
+			if (BoneFactor <= 0.f) continue;
+
+			auto& Tfm = pDest[i];
+			const auto& OtherTfm = pSrc[i];
+			Tfm.rotation = rtm::quat_lerp(Tfm.rotation, OtherTfm.rotation, BoneFactor);
+			Tfm.translation = rtm::vector_lerp(Tfm.translation, OtherTfm.translation, BoneFactor);
+			Tfm.scale = rtm::vector_lerp(Tfm.scale, OtherTfm.scale, BoneFactor);
+		}
+	}
+
+	// Single pass weighted sum of 3 poses with rotation normalization. Weights are expected to sum to 1.
+	void Blend(float Weight, const CPoseBuffer& B, float WeightB, const CPoseBuffer& C, float WeightC)
+	{
+		const auto WeightVector = rtm::vector_set(Weight);
+		const auto WeightBVector = rtm::vector_set(WeightB);
+		const auto WeightCVector = rtm::vector_set(WeightC);
+		const UPTR Size = std::min(_Count, std::min(B._Count, C._Count));
+		auto* pDest = _Transforms.get();
+		const auto* pSrcB = B._Transforms.get();
+		const auto* pSrcC = C._Transforms.get();
+		for (UPTR i = 0; i < Size; ++i)
+		{
+			auto& Tfm = pDest[i];
+			const auto& TfmB = pSrcB[i];
+			const auto& TfmC = pSrcC[i];
+
+			// All rotations are aligned to the first one, which is the most weighted in blend spaces
+			rtm::vector4f Rotation = rtm::vector_mul(Tfm.rotation, WeightVector);
+			Rotation = rtm::vector_mul_add(ShortestArc(Tfm.rotation, TfmB.rotation), WeightBVector, Rotation);
+			Rotation = rtm::vector_mul_add(ShortestArc(Tfm.rotation, TfmC.rotation), WeightCVector, Rotation);
+			Tfm.rotation = rtm::quat_normalize(Rotation);
+
+			Tfm.translation = rtm::vector_mul_add(TfmC.translation, WeightCVector,
+				rtm::vector_mul_add(TfmB.translation, WeightBVector, rtm::vector_mul(Tfm.translation, WeightVector)));
+			Tfm.scale = rtm::vector_mul_add(TfmC.scale, WeightCVector,
+				rtm::vector_mul_add(TfmB.scale, WeightBVector, rtm::vector_mul(Tfm.scale, WeightVector)));
+		}
+	}
+
 	void operator *=(float Weight)
 	{
 		const auto WeightVector = rtm::vector_set(Weight);
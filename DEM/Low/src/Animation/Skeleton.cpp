@@ -44,12 +44,23 @@ U16 CSkeleton::FindPortByName(CStrID NodeID) const
 }
 //---------------------------------------------------------------------
 
-void CSkeleton::FromPoseBuffer(const CPoseBuffer& Pose)
+// Optional mask allows skipping some nodes, e.g. leaf bones of distant characters
+void CSkeleton::FromPoseBuffer(const CPoseBuffer& Pose, const std::vector<bool>* pSkipMask)
 {
 	const UPTR Size = _Nodes.size();
-	for (UPTR i = 0; i < Size; ++i)
-		if (auto pNode = _Nodes[i].Get())
-			pNode->SetLocalTransform(Pose[i]);
+	if (pSkipMask && pSkipMask->size() >= Size)
+	{
+		for (UPTR i = 0; i < Size; ++i)
+			if (auto pNode = _Nodes[i].Get())
+				if (!(*pSkipMask)[i])
+					pNode->SetLocalTransform(Pose[i]);
+	}
+	else
+	{
+		for (UPTR i = 0; i < Size; ++i)
+			if (auto pNode = _Nodes[i].Get())
+				pNode->SetLocalTransform(Pose[i]);
+	}
 }
 //---------------------------------------------------------------------
 
@@ -25,7 +25,7 @@ public:
 
 	U16  FindPortByName(CStrID NodeID) const;
 
-	void FromPoseBuffer(const CPoseBuffer& Pose);
+	void FromPoseBuffer(const CPoseBuffer& Pose, const std::vector<bool>* pSkipMask = nullptr);
 	void ToPoseBuffer(CPoseBuffer& Pose) const;
 
 	const Scene::CSceneNode* GetNode(U16 Port) const { return (_Nodes.size() > Port) ? _Nodes[Port] : nullptr; }
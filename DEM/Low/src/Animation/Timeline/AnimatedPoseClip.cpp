@@ -38,7 +38,10 @@ void CAnimatedPoseClip::PlayInterval(float /*PrevTime*/, float CurrTime, bool Is
 	if (IsLast)
 	{
 		if (_PortMapping)
-			_Sampler.EvaluatePose(CurrTime, CMappedPoseOutput(Output, _PortMapping.get()));
+		{
+			CMappedPoseOutput MappedOutput(Output, _PortMapping.get());
+			_Sampler.EvaluatePose(CurrTime, MappedOutput);
+		}
 		else
 			_Sampler.EvaluatePose(CurrTime, Output);
 	}
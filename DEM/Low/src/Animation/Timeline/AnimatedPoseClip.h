@@ -8,11 +8,11 @@ namespace DEM::Anim
 {
 using PAnimatedPoseClip = std::unique_ptr<class CAnimatedPoseClip>;
 
-class alignas(CAnimationSampler) CAnimatedPoseClip : public CPoseClipBase
+class CAnimatedPoseClip : public CPoseClipBase
 {
 protected:
 
-	CAnimationSampler      _Sampler; // At offset 0 for proper alignment
+	CAnimationSampler      _Sampler;
 	std::unique_ptr<U16[]> _PortMapping;
 
 	// float start, end(?) - normalized. If end > 1, it explicitly defines loop count
@@ -22,8 +22,6 @@ protected:
 
 public:
 
-	DEM_ALLOCATE_ALIGNED(alignof(CAnimatedPoseClip));
-
 	void                  SetAnimationClip(const PAnimationClip& Clip);
 
 	virtual PPoseClipBase Clone() const override;
@@ -29,7 +29,10 @@ void CStaticPoseClip::PlayInterval(float /*PrevTime*/, float /*CurrTime*/, bool
 	if (IsLast && _Pose)
 	{
 		if (_PortMapping)
-			_Pose->Apply(CMappedPoseOutput(Output, _PortMapping.get()));
+		{
+			CMappedPoseOutput MappedOutput(Output, _PortMapping.get());
+			_Pose->Apply(MappedOutput);
+		}
 		else
 			_Pose->Apply(Output);
 	}
@@ -25,7 +25,9 @@
 // TODO: consider incapsulating into methods of relevant subsystems
 #include <Frame/GraphicsResourceManager.h>
 #include <Frame/RenderPhaseGeometry.h>
+#if DEM_UI_CEGUI
 #include <UI/RenderPhaseGUI.h>
+#endif
 #include <Debug/RenderPhaseDebugDraw.h>
 //
 #include <Render/Model.h>
@@ -112,7 +114,7 @@ CApplication::CApplication(Sys::IPlatform& _Platform)
 	: Platform(_Platform)
 #ifdef TRACY_ENABLE
 		// Leave one core for tracy worker and one for Tracy.exe
-	, _JobSystem({ DEM::Jobs::CWorkerConfig::Normal(std::clamp(std::thread::hardware_concurrency(), 2u, DEM::Jobs::MAX_WORKERS - 4) - 2), DEM::Jobs::CWorkerConfig::Sleepy(4) })
+	, _JobSystem({ DEM::Jobs::CWorkerConfig::Normal(static_cast<uint8_t>(std::clamp<size_t>(std::thread::hardware_concurrency(), 2, DEM::Jobs::MAX_WORKERS - 4) - 2)), DEM::Jobs::CWorkerConfig::Sleepy(4) })
 #else
 	, _JobSystem({ DEM::Jobs::CWorkerConfig::Default(4), DEM::Jobs::CWorkerConfig::Sleepy(4) })
 #endif
@@ -621,7 +623,9 @@ Frame::PGraphicsResourceManager CApplication::BootstrapGraphics(Render::PVideoDr
 
 	// Register render path classes in the factory
 
+#if DEM_UI_CEGUI
 	Frame::CRenderPhaseGUI::ForceFactoryRegistration();
+#endif
 	Frame::CRenderPhaseGeometry::ForceFactoryRegistration();
 	Frame::CRenderPhaseDebugDraw::ForceFactoryRegistration();
 	Frame::CModelAttribute::ForceFactoryRegistration();
@@ -87,7 +87,7 @@ public:
 		return true;
 	}
 
-	template<> bool GetGlobal(const std::string& Name, Data::CData& OutValue) const
+	bool GetGlobal(const std::string& Name, Data::CData& OutValue) const
 	{
 		auto It = Globals.find(Name);
 		if (It == Globals.cend()) return false;
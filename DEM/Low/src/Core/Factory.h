@@ -1,5 +1,5 @@
 #pragma once
-#include <StdCfg.h>
+#include <System/System.h>
 #include <string>
 #include <unordered_map>
 
@@ -33,7 +33,7 @@ public:
 	template<typename T>
 	T*                 As() { return IsA(T::RTTI) ? static_cast<T*>(this) : nullptr; }
 	template<typename T>
-	const T*           As() const { return IsA(T::RTTI) ? static_cast<T*>(this) : nullptr; }
+	const T*           As() const { return IsA(T::RTTI) ? static_cast<const T*>(this) : nullptr; }
 	const std::string& GetClassName() const { return GetRTTI()->GetName(); }
 	Data::CFourCC      GetClassFourCC() const { return GetRTTI()->GetFourCC(); }
 };
@@ -81,7 +81,7 @@ inline void SortedDifference(const TCollection& a, const TCollection& b, TLess L
 			{
 				Callback(ItCurrA++);
 			}
-			else static_assert(false, "Callback must accept const_iterator and return void or bool");
+			else static_assert(always_false_v<TCallback>, "Callback must accept const_iterator and return void or bool");
 		}
 		else
 		{
@@ -100,7 +100,7 @@ inline void SortedDifference(const TCollection& a, const TCollection& b, TLess L
 		{
 			Callback(ItCurrA++);
 		}
-		else static_assert(false, "Callback must accept const_iterator and return void or bool");
+		else static_assert(always_false_v<TCallback>, "Callback must accept const_iterator and return void or bool");
 	}
 }
 //---------------------------------------------------------------------
@@ -153,7 +153,7 @@ DEM_FORCE_INLINE void SortedUnion(TCollectionA&& a, TCollectionB&& b, TLess Less
 		{
 			Callback(ItA, ItB);
 		}
-		else static_assert(false, "Callback must accept iterators to a & b and return void or bool");
+		else static_assert(always_false_v<TCallback>, "Callback must accept iterators to a & b and return void or bool");
 	}
 }
 //---------------------------------------------------------------------
@@ -212,7 +212,7 @@ DEM_FORCE_INLINE void SortedLeftJoin(TCollectionA&& a, TCollectionB&& b, TLess L
 		{
 			Callback(ItA, ItB);
 		}
-		else static_assert(false, "Callback must accept iterators to a & b and return void or bool");
+		else static_assert(always_false_v<TCallback>, "Callback must accept iterators to a & b and return void or bool");
 	}
 }
 //---------------------------------------------------------------------
@@ -259,7 +259,7 @@ DEM_FORCE_INLINE void SortedInnerJoin(TCollectionA&& a, TCollectionB&& b, TLess
 			{
 				Callback(ItCurrA, ItCurrB);
 			}
-			else static_assert(false, "Callback must accept iterators to a & b and return void or bool");
+			else static_assert(always_false_v<TCallback>, "Callback must accept iterators to a & b and return void or bool");
 
 			++ItCurrA;
 			++ItCurrB;
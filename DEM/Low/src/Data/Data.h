@@ -1,16 +1,22 @@
 #pragma once
 #include <Data/Type.h>
+#include <Data/Ptr.h>
 #include <StdDEM.h>
+#include <variant>
 
 // Variant data type with compile-time extendable type list
 
+class vector3;
+class vector4;
+class matrix44;
+
 namespace Data
 {
 class CStringID;
+class CDataArray;
+class CParams;
 
 #ifdef _DEBUG
-	class CDataArray;
-	class CParams;
 	class IBuffer;
 #endif
 
@@ -20,25 +26,24 @@ protected:
 
 	const CType*	Type = nullptr;
 
-#ifdef _DEBUG
+	// Small values are stored inline, others are allocated in the heap, and Value points to them. See CTypeImpl::IsInline.
 	union
 	{
 		void*							Value = nullptr;
+		U8								InlineStorage[DATA_INLINE_SIZE];
+#ifdef _DEBUG
 		bool							As_bool;
 		int								As_int;
 		float							As_float;
-		std::string*					As_String;
 		const char*						As_CStrID;
 		const CDataArray*				As_CDataArray;
 		const CParams*					As_CParams;
 		const IBuffer*				    As_PBuffer;
-		struct { float x, y, z; }*		As_vector3;
-		struct { float x, y, z, w; }*	As_vector4;
+		struct { float x, y, z; }		As_vector3;
+		struct { float x, y, z, w; }	As_vector4;
 		struct { float m[4][4]; }*		As_matrix44;
-	};
-#else
-	void*			Value = nullptr;
 #endif
+	};
 
 public:
 
@@ -46,6 +51,8 @@ public:
 	CData(const CData& Src) { SetTypeValue(Src); }
 	CData(CData&& Src) noexcept;
 	template<class T> CData(const T& Val) { Type = DATA_TYPE(T); DATA_TYPE_NV(T)::NewT(&Value, &Val); }
+	template<class T, typename std::enable_if_t<!std::is_reference_v<T> && !std::is_const_v<T> && !std::is_same_v<T, CData>>* = nullptr>
+	CData(T&& Val) { Type = DATA_TYPE(T); DATA_TYPE_NV(T)::NewMoveT(&Value, std::move(Val)); }
 	explicit CData(const CType* type) : Type(type) { if (Type) Type->New(&Value); }
 	~CData() { if (Type) Type->Delete(&Value); }
 
@@ -58,7 +65,7 @@ public:
 	template<class T> bool		IsA() const { return Type == CType::GetType<T>(); }
 	bool						IsValid() const { return Type != nullptr; }
 	bool						IsVoid() const { return !Type /*|| Type->GetID() == INVALID_TYPE_ID*/; }
-	bool						IsNull() const { return IsVoid() || (!Value && Type != DATA_TYPE(bool) && Type != DATA_TYPE(int) && Type != DATA_TYPE(float)); }
+	bool						IsNull() const { return IsVoid() || Type->IsNull(&Value); }
 
 	// Overwrites type
 	void						SetType(const CType* SrcType);
@@ -78,26 +85,29 @@ public:
 	template<class T> const T*	GetValuePtr() const;
 	void* const*				GetValueObjectPtr() const { return &Value; }
 
+	// Value types are declared after CData, so their lookup is deferred until Visit is instantiated
+	template<class T, class F> using TVisited = dependent_type_t<T, F>;
+
 	template<typename F>
 	decltype(auto) Visit(F Visitor) const
 	{
 		switch (GetTypeID())
 		{
-			case Data::CTypeID<bool>::TypeID: return Visitor(GetValue<bool>());
-			case Data::CTypeID<int>::TypeID: return Visitor(GetValue<int>());
-			case Data::CTypeID<float>::TypeID: return Visitor(GetValue<float>());
-			case Data::CTypeID<std::string>::TypeID: return Visitor(GetValue<std::string>());
-			case Data::CTypeID<CStrID>::TypeID: return Visitor(GetValue<CStrID>());
-			case Data::CTypeID<vector3>::TypeID: return Visitor(GetValue<vector3>());
-			case Data::CTypeID<vector4>::TypeID: return Visitor(GetValue<vector4>());
-			case Data::CTypeID<matrix44>::TypeID: return Visitor(GetValue<matrix44>());
-			case Data::CTypeID<Data::PParams>::TypeID: return Visitor(GetValue<Data::PParams>());
-			case Data::CTypeID<Data::PDataArray>::TypeID: return Visitor(GetValue<Data::PDataArray>());
+			case CTypeID<TVisited<bool, F>>::TypeID: return Visitor(GetValue<TVisited<bool, F>>());
+			case CTypeID<TVisited<int, F>>::TypeID: return Visitor(GetValue<TVisited<int, F>>());
+			case CTypeID<TVisited<float, F>>::TypeID: return Visitor(GetValue<TVisited<float, F>>());
+			case CTypeID<TVisited<std::string, F>>::TypeID: return Visitor(GetValue<TVisited<std::string, F>>());
+			case CTypeID<TVisited<CStringID, F>>::TypeID: return Visitor(GetValue<TVisited<CStringID, F>>());
+			case CTypeID<TVisited<vector3, F>>::TypeID: return Visitor(GetValue<TVisited<vector3, F>>());
+			case CTypeID<TVisited<vector4, F>>::TypeID: return Visitor(GetValue<TVisited<vector4, F>>());
+			case CTypeID<TVisited<matrix44, F>>::TypeID: return Visitor(GetValue<TVisited<matrix44, F>>());
+			case CTypeID<TVisited<Ptr<CParams>, F>>::TypeID: return Visitor(GetValue<TVisited<Ptr<CParams>, F>>());
+			case CTypeID<TVisited<Ptr<CDataArray>, F>>::TypeID: return Visitor(GetValue<TVisited<Ptr<CDataArray>, F>>());
 			default: return Visitor(std::monostate{});
 		}
 	}
 
-	std::string					ToString() const { return Type ? Type->ToString(Value) : std::string{}; }
+	std::string					ToString() const { return Type ? Type->ToString(&Value) : std::string{}; }
 
 	CData&                      operator =(const CData& Src) { SetTypeValue(Src); return *this; }
 	CData&                      operator =(CData&& Src) noexcept;
@@ -110,9 +120,10 @@ public:
 	bool						operator !=(const CData& Other) const { return !(*this == Other); }
 	template<class T> bool		operator !=(const T& Other) const { return !(*this == Other); }
 
-	template<class T>			operator T&() { return GetValue<T>(); }
-	template<class T>			operator const T&() { return GetValue<T>(); }
-	template<class T>			operator const T&() const { return GetValue<T>(); }
+	// Limited to declared types, otherwise they hijack conversions to wrappers like sol::optional<CData&>
+	template<class T, typename = std::enable_if_t<CTypeID<T>::IsDeclared>> operator T&() { return GetValue<T>(); }
+	template<class T, typename = std::enable_if_t<CTypeID<T>::IsDeclared>> operator const T&() { return GetValue<T>(); }
+	template<class T, typename = std::enable_if_t<CTypeID<T>::IsDeclared>> operator const T&() const { return GetValue<T>(); }
 	template<class T>			operator T*() { return GetValuePtr<T>(); }
 	template<class T>			operator const T*() { return GetValuePtr<T>(); }
 	template<class T>			operator const T*() const { return GetValuePtr<T>(); }
@@ -123,11 +134,12 @@ public:
 
 inline CData::CData(CData&& Src) noexcept
 	: Type(Src.Type)
-	, Value(Src.Value)
-
 {
-	Src.Type = nullptr;
-	Src.Value = nullptr;
+	if (Type)
+	{
+		Type->Relocate(&Value, &Src.Value);
+		Src.Type = nullptr;
+	}
 }
 //---------------------------------------------------------------------
 
@@ -259,7 +271,7 @@ template<class T> inline CData& CData::operator =(T&& Src)
 //}
 ////---------------------------------------------------------------------
 
-template<> inline CData& CData::operator =(CData& Src)
+template<> inline CData& CData::operator =<CData>(CData& Src)
 {
 	SetTypeValue(Src);
 	return *this;
@@ -268,11 +280,15 @@ template<> inline CData& CData::operator =(CData& Src)
 
 inline CData& CData::operator =(CData&& Src) noexcept
 {
+	if (this == &Src) return *this;
+
 	Clear();
 	Type = Src.Type;
-	Value = Src.Value;
-	Src.Type = nullptr;
-	Src.Value = nullptr;
+	if (Type)
+	{
+		Type->Relocate(&Value, &Src.Value);
+		Src.Type = nullptr;
+	}
 	return *this;
 }
 //---------------------------------------------------------------------
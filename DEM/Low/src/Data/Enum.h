@@ -145,7 +145,7 @@ inline std::string ToString(CEnumMask<T> Value)
 		if (!Value.Test(EnumValue)) continue;
 
 		if (!First)
-			Result.append('|');
+			Result.push_back('|');
 		else
 			First = false;
 
@@ -32,9 +32,9 @@ public:
 	CIterator	IteratorAt(IPTR Idx) const { return Idx == INVALID_INDEX ? nullptr : pData + Idx; }
 
 	void		Clear(T Elm = T()) { for (S i = 0; i < Count; ++i) pData[i] = Elm; }
-	CIterator	Find(const T& Val) const { IPTR Idx = FindIndex(Val); return Idx == INVALID_INDEX ? End() : IteratorAt(Idx); }
+	CIterator	Find(const T& Val) const { IPTR Idx = FindIndex(Val); return Idx == INVALID_INDEX ? pData + Count : IteratorAt(Idx); }
 	IPTR		FindIndex(const T& Elm) const;
-	CIterator	FindSorted(const T& Val) const { IPTR Idx = ArrayUtils::FindIndexSorted(pData, Count, Val); return Idx == INVALID_INDEX ? End() : IteratorAt(Idx); }
+	CIterator	FindSorted(const T& Val) const { IPTR Idx = ArrayUtils::FindIndexSorted(pData, Count, Val); return Idx == INVALID_INDEX ? pData + Count : IteratorAt(Idx); }
 	IPTR		FindIndexSorted(const T& Val) const { return ArrayUtils::FindIndexSorted(pData, Count, Val); }
 	bool		Contains(const T& Elm) const { return FindIndex(Elm) != -1; }
 	void		Sort() { std::sort(pData, pData + Count); }
@@ -32,7 +32,7 @@ struct function_traits<ReturnType(*)(Arguments...)>
 template<typename T> \
 struct has_method_##method_name \
 { \
-	template<typename U> static constexpr std::true_type test(decltype(&U::##method_name)); \
+	template<typename U> static constexpr std::true_type test(decltype(&U::method_name)); \
 	template<typename> static constexpr std::false_type test(...); \
 	static constexpr bool value = decltype(test<T>(0))::value; \
 }; \
@@ -43,13 +43,13 @@ constexpr bool has_method_##method_name##_v = has_method_##method_name<T>::value
 template<typename, typename> \
 struct has_method_with_signature_##method_name { static constexpr bool value = std::false_type::value; }; \
 template<typename T, typename Ret, typename... Args> \
-struct has_method_with_signature_##method_name##<T, Ret(Args...)> \
+struct has_method_with_signature_##method_name<T, Ret(Args...)> \
 { \
-	template<typename U> static constexpr auto test(U*) -> typename std::is_same<decltype(std::declval<U>().##method_name##(std::declval<Args>()...)), Ret>::type; \
+	template<typename U> static constexpr auto test(U*) -> typename std::is_same<decltype(std::declval<U>().method_name(std::declval<Args>()...)), Ret>::type; \
 	template<typename> static constexpr std::false_type test(...); \
 	static constexpr bool value = decltype(test<T>(0))::value; \
 }; \
 template<typename T, typename Ret, typename... Args> \
-constexpr bool has_method_with_signature_##method_name##_v = has_method_with_signature_##method_name##<T, Ret, Args...>::value;
+constexpr bool has_method_with_signature_##method_name##_v = has_method_with_signature_##method_name<T, Ret, Args...>::value;
 
 }
@@ -42,17 +42,17 @@ constexpr bool is_mutable_ref_getter_v =
 template<typename TClass, typename T, typename TAccessor, typename SFINAE_Enabled = void>
 struct MemberAccess
 {
-	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(false, "Unsupported getter type"); }
-	static inline T*       Ptr(TAccessor, TClass&) { static_assert(false, "Unsupported setter type"); }
-	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(false, "Unsupported getter type"); }
-	static inline T&       Ref(TAccessor, TClass&) { static_assert(false, "Unsupported setter type"); }
-	static inline T        Copy(TAccessor, const TClass&) { static_assert(false, "Unsupported getter type"); }
+	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported getter type"); }
+	static inline T*       Ptr(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported setter type"); }
+	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported getter type"); }
+	static inline T&       Ref(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported setter type"); }
+	static inline T        Copy(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported getter type"); }
 
 	template<typename U>
-	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(false, "Unsupported setter type"); }
+	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(always_false_v<TAccessor>, "Unsupported setter type"); }
 
-	static inline auto     BestGetConst(TAccessor, const TClass&) { static_assert(false, "Unsupported getter type"); }
-	static inline auto     BestGet(TAccessor, TClass&) { static_assert(false, "Unsupported setter type"); }
+	static inline auto     BestGetConst(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported getter type"); }
+	static inline auto     BestGet(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Unsupported setter type"); }
 };
 
 // Pointer-to-member specialization
@@ -76,34 +76,34 @@ struct MemberAccess<TClass, T, TAccessor, typename std::enable_if_t<is_pointer_t
 template<typename TClass, typename T, typename TAccessor>
 struct MemberAccess<TClass, T, TAccessor, typename std::enable_if_t<is_setter_v<TAccessor, TClass, T>>>
 {
-	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(false, "Can't get value with a setter function"); }
-	static inline T*       Ptr(TAccessor, TClass&) { static_assert(false, "Can't get value with a setter function"); }
-	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(false, "Can't get value with a setter function"); }
-	static inline T&       Ref(TAccessor, TClass&) { static_assert(false, "Can't get value with a setter function"); }
-	static inline T        Copy(TAccessor, const TClass&) { static_assert(false, "Can't get value with a setter function"); }
+	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
+	static inline T*       Ptr(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
+	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
+	static inline T&       Ref(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
+	static inline T        Copy(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
 
 	template<typename U>
 	static inline void     Set(TAccessor pSetter, TClass& Instance, U&& Value) { (Instance.*pSetter)(std::forward<U>(Value)); }
 
-	static inline auto     BestGetConst(TAccessor, const TClass&) { static_assert(false, "Can't get value with a setter function"); }
-	static inline auto     BestGet(TAccessor, TClass&) { static_assert(false, "Can't get value with a setter function"); }
+	static inline auto     BestGetConst(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
+	static inline auto     BestGet(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get value with a setter function"); }
 };
 
 // Value getter specialization
 template<typename TClass, typename T, typename TAccessor>
 struct MemberAccess<TClass, T, TAccessor, typename std::enable_if_t<is_value_getter_v<TAccessor, TClass, T>>>
 {
-	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(false, "Can't get pointer with a value getter"); }
-	static inline T*       Ptr(TAccessor, TClass&) { static_assert(false, "Can't get pointer with a value getter"); }
-	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(false, "Can't get reference with a value getter"); }
-	static inline T&       Ref(TAccessor, TClass&) { static_assert(false, "Can't get reference with a value getter"); }
+	static inline const T* ConstPtr(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get pointer with a value getter"); }
+	static inline T*       Ptr(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get pointer with a value getter"); }
+	static inline const T& ConstRef(TAccessor, const TClass&) { static_assert(always_false_v<TAccessor>, "Can't get reference with a value getter"); }
+	static inline T&       Ref(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get reference with a value getter"); }
 	static inline T        Copy(TAccessor pGetter, const TClass& Instance) { return (Instance.*pGetter)(); }
 
 	template<typename U>
-	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(false, "Can't set value with a getter function"); }
+	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(always_false_v<TAccessor>, "Can't set value with a getter function"); }
 
 	static inline T        BestGetConst(TAccessor pGetter, const TClass& Instance) { return Copy(pGetter, Instance); }
-	static inline auto     BestGet(TAccessor, TClass&) { static_assert(false, "Can't get reference with a value getter"); }
+	static inline auto     BestGet(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get reference with a value getter"); }
 };
 
 // Const ref getter specialization
@@ -111,16 +111,16 @@ template<typename TClass, typename T, typename TAccessor>
 struct MemberAccess<TClass, T, TAccessor, typename std::enable_if_t<is_const_ref_getter_v<TAccessor, TClass, T>>>
 {
 	static inline const T* ConstPtr(TAccessor pGetter, const TClass& Instance) { return &(Instance.*pGetter)(); }
-	static inline T*       Ptr(TAccessor, TClass&) { static_assert(false, "Can't get mutable pointer with a const getter"); }
+	static inline T*       Ptr(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get mutable pointer with a const getter"); }
 	static inline const T& ConstRef(TAccessor pGetter, const TClass& Instance) { return (Instance.*pGetter)(); }
-	static inline T&       Ref(TAccessor, TClass&) { static_assert(false, "Can't get mutable reference with a const getter"); }
+	static inline T&       Ref(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get mutable reference with a const getter"); }
 	static inline T        Copy(TAccessor pGetter, const TClass& Instance) { return (Instance.*pGetter)(); }
 
 	template<typename U>
-	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(false, "Can't set value with a getter function"); }
+	static inline void     Set(TAccessor, TClass&, U&&) { static_assert(always_false_v<TAccessor>, "Can't set value with a getter function"); }
 
 	static inline const T& BestGetConst(TAccessor pGetter, const TClass& Instance) { return ConstRef(pGetter, Instance); }
-	static inline auto     BestGet(TAccessor, TClass&) { static_assert(false, "Can't get mutable reference with a const getter"); }
+	static inline auto     BestGet(TAccessor, TClass&) { static_assert(always_false_v<TAccessor>, "Can't get mutable reference with a const getter"); }
 };
 
 // Mutable ref getter specialization
@@ -18,6 +18,7 @@ public:
 
 	CParam() {}
 	CParam(const CParam& Src) { Clone(Src); }
+	CParam(CParam&& Src) noexcept = default;
 	CParam(CStrID name, const CData& value) : Name(name), Value(value) {}
 	CParam(CStrID name, CData&& value) : Name(name), Value(std::move(value)) {}
 
@@ -40,6 +41,7 @@ public:
 	inline void					Clear() { Name = CStrID(); Value.Clear(); }
 
 	inline CParam&				operator =(const CParam& Src) { Clone(Src); return *this; }
+	CParam&						operator =(CParam&& Src) noexcept = default;
 	//inline bool				operator ==(const CParam& Other) const { return Name == Other.Name && Value == Other.Value; }
 	//inline bool				operator !=(const CParam& Other) const { return !(*this == Other); }
 };
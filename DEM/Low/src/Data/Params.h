@@ -44,35 +44,35 @@ public:
 	const CParam&				Get(IPTR Idx) const { return Params[Idx]; }
 	template<class T> const T&	Get(IPTR Idx) const { return Params[Idx].GetValue<T>(); }
 
-	CParam* CParams::Find(CStrID Name)
+	CParam* Find(CStrID Name)
 	{
 		for (UPTR i = 0; i < Params.size(); ++i)
 			if (Params[i].GetName() == Name) return &Params[i];
 		return nullptr;
 	}
 
-	const CParam* CParams::Find(CStrID Name) const
+	const CParam* Find(CStrID Name) const
 	{
 		for (UPTR i = 0; i < Params.size(); ++i)
 			if (Params[i].GetName() == Name) return &Params[i];
 		return nullptr;
 	}
 
-	CParam* CParams::Find(std::string_view Name)
+	CParam* Find(std::string_view Name)
 	{
 		for (UPTR i = 0; i < Params.size(); ++i)
 			if (Params[i].GetName() == Name) return &Params[i];
 		return nullptr;
 	}
 
-	const CParam* CParams::Find(std::string_view Name) const
+	const CParam* Find(std::string_view Name) const
 	{
 		for (UPTR i = 0; i < Params.size(); ++i)
 			if (Params[i].GetName() == Name) return &Params[i];
 		return nullptr;
 	}
 
-	const CData* CParams::FindValue(CStrID Name) const
+	const CData* FindValue(CStrID Name) const
 	{
 		const auto* pParam = Find(Name);
 		return pParam ? &pParam->GetRawValue() : nullptr;
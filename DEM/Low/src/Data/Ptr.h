@@ -4,6 +4,12 @@
 // Intrusive smart pointer class.
 // Can be used like a normal C++ pointer in most cases.
 
+namespace Data { class CRefCounted; }
+
+// Defined along with CRefCounted, declared here to be visible from the template
+inline void DEMPtrAddRef(Data::CRefCounted* p) noexcept;
+inline void DEMPtrRelease(Data::CRefCounted* p) noexcept;
+
 template<class T>
 class Ptr
 {
@@ -3,6 +3,8 @@
 #include <Data/CategorizationTraits.h>
 #include <IO/BinaryWriter.h>
 #include <IO/BinaryReader.h>
+#include <IO/Streams/VectorStream.h>
+#include <cstring>
 
 // Serialization of arbitrary data to binary format
 
@@ -56,227 +58,23 @@ struct BinaryFormat
 	}
 	//---------------------------------------------------------------------
 
-	template<typename T, typename std::enable_if_t<Meta::is_not_collection_v<T>>* = nullptr>
+	// Writes the difference of Value against BaseValue. Returns false if values are equal. Diff is built in a reused
+	// scratch RAM buffer and copied to the output at once. This allows to discard data written for unchanged elements
+	// by a simple size change instead of seeking and truncating the output stream, and doesn't allocate after warm up.
+	template<typename T>
 	static inline bool SerializeDiff(IO::CBinaryWriter& Output, const T& Value, const T& BaseValue)
 	{
-		if constexpr (DEM::Meta::CMetadata<T>::IsRegistered)
-		{
-			bool HasDiff = false;
-			DEM::Meta::CMetadata<T>::ForEachMember([&Output, &Value, &BaseValue, &HasDiff](const auto& Member)
-			{
-				if (!Member.CanSerialize()) return;
-
-				// Write the code to identify the member. If member is equal in both objects, this will be reverted.
-				// TODO: PROFILE! Code is written for each member, but changed % is typically much less than 100.
-				// If too slow, can write to RAM buffer and explicitly deny to flush. Then with first difference
-				// detected flush the code too. Discarding code in RAM is just a pointer subtraction, not fseek.
-				const auto CurrPos = Output.GetStream().Tell();
-				Output << Member.GetCode();
-
-				if (SerializeDiff(Output, Member.GetConstValue(Value), Member.GetConstValue(BaseValue)))
-					HasDiff = true;
-				else
-				{
-					// "Unwrite" code
-					Output.GetStream().Seek(CurrPos, IO::Seek_Begin);
-					Output.GetStream().Truncate();
-				}
-			});
-
-			// End the list of changed members (much like a trailing \0).
-			Output << DEM::Meta::NO_MEMBER_CODE;
-
-			return HasDiff;
-		}
-		else if (!Meta::IsEqualByValue(BaseValue, Value))
-		{
-			Output << Value;
-			return true;
-		}
-		return false;
-	}
-	//---------------------------------------------------------------------
-
-	template<typename T, typename std::enable_if_t<Meta::is_fixed_single_collection_v<T>>* = nullptr>
-	static inline bool SerializeDiff(IO::CBinaryWriter& Output, const T& Vector, const T& BaseVector)
-	{
-		constexpr auto ArraySize = Meta::fixed_array_size_v<T>;
-
-		// Only 32 bits are saved
-		static_assert(ArraySize <= std::numeric_limits<uint32_t>().max());
-
-		size_t FirstChange = 0;
-		for (; FirstChange < ArraySize; ++FirstChange)
-			if (!Meta::IsEqualByValue(Vector[FirstChange], BaseVector[FirstChange])) break;
-
-		if (FirstChange == ArraySize) return false;
-
-		for (size_t i = FirstChange; i < ArraySize; ++i)
-		{
-			// Write the index to identify the element. If values are equal in both objects, this will be reverted.
-			// TODO: PROFILE! See writing member code SerializeDiff(in is_not_collection_v), the same situation.
-			const auto CurrPos = Output.GetStream().Tell();
-			Output << static_cast<uint32_t>(i);
-
-			if (!SerializeDiff(Output, Vector[i], BaseVector[i]))
-			{
-				// "Unwrite" index
-				Output.GetStream().Seek(CurrPos, IO::Seek_Begin);
-				Output.GetStream().Truncate();
-			}
-		}
-
-		// End the list of changed elements (much like a trailing \0).
-		Output << std::numeric_limits<uint32_t>().max();
-
-		return true;
-	}
-	//---------------------------------------------------------------------
-
-	template<typename T, typename std::enable_if_t<Meta::is_std_vector_v<T>>* = nullptr>
-	static inline bool SerializeDiff(IO::CBinaryWriter& Output, const T& Vector, const T& BaseVector)
-	{
-		// Only 32 bits are saved
-		n_assert_dbg(Vector.size() <= std::numeric_limits<uint32_t>().max() &&
-			BaseVector.size() <= std::numeric_limits<uint32_t>().max());
-
-		size_t FirstChange = 0;
-		const size_t MinSize = std::min(Vector.size(), BaseVector.size());
-		for (; FirstChange < MinSize; ++FirstChange)
-			if (!Meta::IsEqualByValue(Vector[FirstChange], BaseVector[FirstChange])) break;
+		// Not cleared but restored to the start size, so that nested calls are safe
+		auto& Scratch = GetDiffScratchStream();
+		const auto Start = Scratch.GetSize();
 
-		if (FirstChange == MinSize && Vector.size() == BaseVector.size()) return false;
+		const bool HasDiff = WriteDiff(Scratch, Value, BaseValue);
 
-		// Write old array size to ensure for compatibility with base vector passed into diff loading
-		Output << static_cast<uint32_t>(BaseVector.size());
-
-		// Write new array size to load deleted or added tail elements
-		Output << static_cast<uint32_t>(Vector.size());
-
-		for (size_t i = FirstChange; i < MinSize; ++i)
-		{
-			// Write the index to identify the element. If values are equal in both objects, this will be reverted.
-			// TODO: PROFILE! See writing member code SerializeDiff(in is_not_collection_v), the same situation.
-			const auto CurrPos = Output.GetStream().Tell();
-			Output << static_cast<uint32_t>(i);
-
-			if (!SerializeDiff(Output, Vector[i], BaseVector[i]))
-			{
-				// "Unwrite" index
-				Output.GetStream().Seek(CurrPos, IO::Seek_Begin);
-				Output.GetStream().Truncate();
-			}
-		}
+		if (const auto Size = Scratch.GetSize() - Start)
+			Output.GetStream().Write(Scratch.GetPtr() + Start, Size);
+		Scratch.SetSize(Start);
 
-		// End the list of changed elements (much like a trailing \0).
-		Output << std::numeric_limits<uint32_t>().max();
-
-		// Process added elements. If new array is shorter, deleted elements will be detected from diff length.
-		for (size_t i = MinSize; i < Vector.size(); ++i)
-			Serialize(Output, Vector[i]);
-
-		return true;
-	}
-	//---------------------------------------------------------------------
-
-	template<typename T, typename std::enable_if_t<Meta::is_std_set_v<T> || Meta::is_std_unordered_set_v<T>>* = nullptr>
-	static inline bool SerializeDiff(IO::CBinaryWriter& Output, const T& Set, const T& BaseSet)
-	{
-		size_t AddedCount = 0, DeletedCount = 0;
-		Algo::SetDifference(Set, BaseSet, [&AddedCount](auto) { ++AddedCount; });
-		Algo::SetDifference(BaseSet, Set, [&DeletedCount](auto) { ++DeletedCount; });
-
-		if (!AddedCount && !DeletedCount) return false;
-
-		// Only 32 bits are saved
-		n_assert_dbg(AddedCount <= std::numeric_limits<uint32_t>().max() &&
-			DeletedCount <= std::numeric_limits<uint32_t>().max());
-
-		Output << static_cast<uint32_t>(DeletedCount);
-		if (DeletedCount)
-			Algo::SetDifference(BaseSet, Set, [&Output, &DeletedCount](auto It)
-			{
-				Serialize(Output, *It);
-				return --DeletedCount > 0;
-			});
-
-		Output << static_cast<uint32_t>(AddedCount);
-		if (AddedCount)
-			Algo::SetDifference(Set, BaseSet, [&Output, &AddedCount](auto It)
-			{
-				Serialize(Output, *It);
-				return --AddedCount > 0;
-			});
-
-		return true;
-	}
-	//---------------------------------------------------------------------
-
-	template<typename T, typename std::enable_if_t<Meta::is_pair_iterable_v<T>>* = nullptr>
-	static inline bool SerializeDiff(IO::CBinaryWriter& Output, const T& Map, const T& BaseMap)
-	{
-		// Can't choose value for termination key, so can't just do k-v-k-v-...-k(term).
-		// Have to calculate how many keys will be in each category in advance.
-		size_t AddedCount = 0, ModifiedCount = 0, DeletedCount = 0;
-		for (const auto& [Key, Value] : Map)
-		{
-			auto BaseIt = BaseMap.find(Key);
-			if (BaseIt == BaseMap.cend()) ++ AddedCount;
-			else if (!Meta::IsEqualByValue(BaseIt->second, Value)) ++ModifiedCount;
-		}
-		for (const auto& [Key, Value] : BaseMap)
-			if (Map.find(Key) == Map.cend()) ++DeletedCount;
-
-		if (!AddedCount && !DeletedCount && !ModifiedCount) return false;
-
-		// Only 32 bits are saved
-		n_assert_dbg(AddedCount <= std::numeric_limits<uint32_t>().max() &&
-			DeletedCount <= std::numeric_limits<uint32_t>().max() &&
-			ModifiedCount <= std::numeric_limits<uint32_t>().max());
-
-		Output << static_cast<uint32_t>(DeletedCount);
-		if (DeletedCount)
-		{
-			for (const auto& [Key, Value] : BaseMap)
-			{
-				if (Map.find(Key) == Map.cend())
-				{
-					Serialize(Output, Key);
-					if (--DeletedCount == 0) break;
-				}
-			}
-		}
-
-		Output << static_cast<uint32_t>(ModifiedCount);
-		if (ModifiedCount)
-		{
-			for (const auto& [Key, Value] : Map)
-			{
-				auto BaseIt = BaseMap.find(Key);
-				if (BaseIt != BaseMap.cend() && !Meta::IsEqualByValue(BaseIt->second, Value))
-				{
-					Serialize(Output, Key);
-					SerializeDiff(Output, Value, BaseIt->second);
-					if (--ModifiedCount == 0) break;
-				}
-			}
-		}
-
-		Output << static_cast<uint32_t>(AddedCount);
-		if (AddedCount)
-		{
-			for (const auto& [Key, Value] : Map)
-			{
-				if (BaseMap.find(Key) == BaseMap.cend())
-				{
-					Serialize(Output, Key);
-					Serialize(Output, Value);
-					if (--AddedCount == 0) break;
-				}
-			}
-		}
-
-		return true;
+		return HasDiff;
 	}
 	//---------------------------------------------------------------------
 
@@ -310,14 +108,14 @@ struct BinaryFormat
 		uint32_t Count;
 		Input >> Count;
 
-		if constexpr (std::is_same_v<std::vector<T::value_type>, T>) // Check that the collection is std vector
+		if constexpr (std::is_same_v<std::vector<typename T::value_type>, T>) // Check that the collection is std vector
 			Vector.resize(Count);
 		else
 			Vector.clear();
 
 		for (size_t i = 0; i < Count; ++i)
 		{
-			if constexpr (std::is_same_v<std::vector<T::value_type>, T>) // Check that the collection is std vector
+			if constexpr (std::is_same_v<std::vector<typename T::value_type>, T>) // Check that the collection is std vector
 			{
 				Deserialize(Input, Vector[i]);
 			}
@@ -501,6 +299,274 @@ struct BinaryFormat
 		else return sizeof(TValue);
 	}
 	//---------------------------------------------------------------------
+
+private:
+
+	// Types written by CBinaryWriter as is, so that their arrays can be copied with a single memcpy
+	template<typename T>
+	static constexpr bool IsRawBinary = std::is_trivially_copyable_v<T> && Meta::is_not_collection_v<T> &&
+		!DEM::Meta::CMetadata<T>::IsRegistered && !std::is_pointer_v<T> && !std::is_same_v<T, CStrID>;
+
+	static inline IO::CVectorStream& GetDiffScratchStream()
+	{
+		thread_local IO::CVectorStream Stream(4096);
+		return Stream;
+	}
+	//---------------------------------------------------------------------
+
+	// Bitwise equality is enough to skip a value. Bitwise inequality is conclusive only for types without padding and floats.
+	template<typename T>
+	static inline bool IsEqualForDiff(const T& a, const T& b)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (!std::memcmp(&a, &b, sizeof(T))) return true;
+			if constexpr (std::has_unique_object_representations_v<T>) return false;
+		}
+
+		return Meta::IsEqualByValue(a, b);
+	}
+	//---------------------------------------------------------------------
+
+	// Writes a key (member code or element index) followed by the value diff, or nothing if values are equal
+	template<typename T>
+	static inline bool WriteKeyedDiff(IO::CVectorStream& Out, uint32_t Key, const T& Value, const T& BaseValue)
+	{
+		if constexpr (DEM::Meta::CMetadata<T>::IsRegistered || !Meta::is_not_collection_v<T>)
+		{
+			// Most of objects are unchanged, don't descend into them
+			if constexpr (std::is_trivially_copyable_v<T>)
+				if (!std::memcmp(&Value, &BaseValue, sizeof(T))) return false;
+
+			// Structures and collections detect changes while writing. If there were none, discard the key.
+			const auto Start = Out.GetSize();
+			IO::CBinaryWriter(Out) << Key;
+			if (WriteDiff(Out, Value, BaseValue)) return true;
+			Out.SetSize(Start);
+			return false;
+		}
+		else
+		{
+			// Leaf values are compared before writing
+			if (IsEqualForDiff(Value, BaseValue)) return false;
+			IO::CBinaryWriter(Out) << Key << Value;
+			return true;
+		}
+	}
+	//---------------------------------------------------------------------
+
+	template<typename T, typename std::enable_if_t<Meta::is_not_collection_v<T>>* = nullptr>
+	static inline bool WriteDiff(IO::CVectorStream& Out, const T& Value, const T& BaseValue)
+	{
+		if constexpr (DEM::Meta::CMetadata<T>::IsRegistered)
+		{
+			bool HasDiff = false;
+			DEM::Meta::CMetadata<T>::ForEachMember([&Out, &Value, &BaseValue, &HasDiff](const auto& Member)
+			{
+				if (Member.CanSerialize() && WriteKeyedDiff(Out, Member.GetCode(), Member.GetConstValue(Value), Member.GetConstValue(BaseValue)))
+					HasDiff = true;
+			});
+
+			// End the list of changed members (much like a trailing \0).
+			IO::CBinaryWriter(Out) << DEM::Meta::NO_MEMBER_CODE;
+
+			return HasDiff;
+		}
+		else if (!IsEqualForDiff(Value, BaseValue))
+		{
+			IO::CBinaryWriter(Out) << Value;
+			return true;
+		}
+		return false;
+	}
+	//---------------------------------------------------------------------
+
+	template<typename T, typename std::enable_if_t<Meta::is_fixed_single_collection_v<T>>* = nullptr>
+	static inline bool WriteDiff(IO::CVectorStream& Out, const T& Vector, const T& BaseVector)
+	{
+		constexpr auto ArraySize = Meta::fixed_array_size_v<T>;
+		using TElement = std::remove_cv_t<std::remove_reference_t<decltype(Vector[0])>>;
+
+		// Only 32 bits are saved
+		static_assert(ArraySize <= std::numeric_limits<uint32_t>().max());
+
+		if constexpr (std::is_trivially_copyable_v<TElement>)
+			if (!std::memcmp(&Vector[0], &BaseVector[0], ArraySize * sizeof(TElement))) return false;
+
+		bool HasDiff = false;
+		for (size_t i = 0; i < ArraySize; ++i)
+			if (WriteKeyedDiff(Out, static_cast<uint32_t>(i), Vector[i], BaseVector[i]))
+				HasDiff = true;
+
+		if (!HasDiff) return false;
+
+		// End the list of changed elements (much like a trailing \0).
+		IO::CBinaryWriter(Out) << std::numeric_limits<uint32_t>().max();
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+
+	template<typename T, typename std::enable_if_t<Meta::is_std_vector_v<T>>* = nullptr>
+	static inline bool WriteDiff(IO::CVectorStream& Out, const T& Vector, const T& BaseVector)
+	{
+		using TElement = typename T::value_type;
+
+		// std::vector<bool> has no contiguous storage
+		constexpr bool IsPOD = std::is_trivially_copyable_v<TElement> && !std::is_same_v<TElement, bool>;
+
+		// Only 32 bits are saved
+		n_assert_dbg(Vector.size() <= std::numeric_limits<uint32_t>().max() &&
+			BaseVector.size() <= std::numeric_limits<uint32_t>().max());
+
+		if constexpr (IsPOD)
+			if (Vector.size() == BaseVector.size() && (Vector.empty() || !std::memcmp(Vector.data(), BaseVector.data(), Vector.size() * sizeof(TElement))))
+				return false;
+
+		IO::CBinaryWriter Writer(Out);
+		const auto Start = Out.GetSize();
+
+		// Write old array size to ensure for compatibility with base vector passed into diff loading
+		Writer << static_cast<uint32_t>(BaseVector.size());
+
+		// Write new array size to load deleted or added tail elements
+		Writer << static_cast<uint32_t>(Vector.size());
+
+		bool HasDiff = (Vector.size() != BaseVector.size());
+		const size_t MinSize = std::min(Vector.size(), BaseVector.size());
+		for (size_t i = 0; i < MinSize; ++i)
+			if (WriteKeyedDiff(Out, static_cast<uint32_t>(i), Vector[i], BaseVector[i]))
+				HasDiff = true;
+
+		if (!HasDiff)
+		{
+			Out.SetSize(Start);
+			return false;
+		}
+
+		// End the list of changed elements (much like a trailing \0).
+		Writer << std::numeric_limits<uint32_t>().max();
+
+		// Process added elements. If new array is shorter, deleted elements will be detected from diff length.
+		if constexpr (IsPOD && IsRawBinary<TElement>)
+		{
+			if (Vector.size() > MinSize)
+				Out.Write(Vector.data() + MinSize, (Vector.size() - MinSize) * sizeof(TElement));
+		}
+		else
+		{
+			for (size_t i = MinSize; i < Vector.size(); ++i)
+				Serialize(Writer, Vector[i]);
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+
+	template<typename T, typename std::enable_if_t<Meta::is_std_set_v<T> || Meta::is_std_unordered_set_v<T>>* = nullptr>
+	static inline bool WriteDiff(IO::CVectorStream& Out, const T& Set, const T& BaseSet)
+	{
+		size_t AddedCount = 0, DeletedCount = 0;
+		Algo::SetDifference(Set, BaseSet, [&AddedCount](auto) { ++AddedCount; });
+		Algo::SetDifference(BaseSet, Set, [&DeletedCount](auto) { ++DeletedCount; });
+
+		if (!AddedCount && !DeletedCount) return false;
+
+		// Only 32 bits are saved
+		n_assert_dbg(AddedCount <= std::numeric_limits<uint32_t>().max() &&
+			DeletedCount <= std::numeric_limits<uint32_t>().max());
+
+		IO::CBinaryWriter Writer(Out);
+
+		Writer << static_cast<uint32_t>(DeletedCount);
+		if (DeletedCount)
+			Algo::SetDifference(BaseSet, Set, [&Writer, &DeletedCount](auto It)
+			{
+				Serialize(Writer, *It);
+				return --DeletedCount > 0;
+			});
+
+		Writer << static_cast<uint32_t>(AddedCount);
+		if (AddedCount)
+			Algo::SetDifference(Set, BaseSet, [&Writer, &AddedCount](auto It)
+			{
+				Serialize(Writer, *It);
+				return --AddedCount > 0;
+			});
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+
+	template<typename T, typename std::enable_if_t<Meta::is_pair_iterable_v<T>>* = nullptr>
+	static inline bool WriteDiff(IO::CVectorStream& Out, const T& Map, const T& BaseMap)
+	{
+		// Can't choose value for termination key, so can't just do k-v-k-v-...-k(term).
+		// Have to calculate how many keys will be in each category in advance.
+		size_t AddedCount = 0, ModifiedCount = 0, DeletedCount = 0;
+		for (const auto& [Key, Value] : Map)
+		{
+			auto BaseIt = BaseMap.find(Key);
+			if (BaseIt == BaseMap.cend()) ++ AddedCount;
+			else if (!IsEqualForDiff(BaseIt->second, Value)) ++ModifiedCount;
+		}
+		for (const auto& [Key, Value] : BaseMap)
+			if (Map.find(Key) == Map.cend()) ++DeletedCount;
+
+		if (!AddedCount && !DeletedCount && !ModifiedCount) return false;
+
+		// Only 32 bits are saved
+		n_assert_dbg(AddedCount <= std::numeric_limits<uint32_t>().max() &&
+			DeletedCount <= std::numeric_limits<uint32_t>().max() &&
+			ModifiedCount <= std::numeric_limits<uint32_t>().max());
+
+		IO::CBinaryWriter Writer(Out);
+
+		Writer << static_cast<uint32_t>(DeletedCount);
+		if (DeletedCount)
+		{
+			for (const auto& [Key, Value] : BaseMap)
+			{
+				if (Map.find(Key) == Map.cend())
+				{
+					Serialize(Writer, Key);
+					if (--DeletedCount == 0) break;
+				}
+			}
+		}
+
+		Writer << static_cast<uint32_t>(ModifiedCount);
+		if (ModifiedCount)
+		{
+			for (const auto& [Key, Value] : Map)
+			{
+				auto BaseIt = BaseMap.find(Key);
+				if (BaseIt != BaseMap.cend() && !IsEqualForDiff(BaseIt->second, Value))
+				{
+					Serialize(Writer, Key);
+					WriteDiff(Out, Value, BaseIt->second);
+					if (--ModifiedCount == 0) break;
+				}
+			}
+		}
+
+		Writer << static_cast<uint32_t>(AddedCount);
+		if (AddedCount)
+		{
+			for (const auto& [Key, Value] : Map)
+			{
+				if (BaseMap.find(Key) == BaseMap.cend())
+				{
+					Serialize(Writer, Key);
+					Serialize(Writer, Value);
+					if (--AddedCount == 0) break;
+				}
+			}
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
 };
 
 }
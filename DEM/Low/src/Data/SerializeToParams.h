@@ -307,13 +307,13 @@ struct ParamsFormat
 		{
 			auto pArray = pArrayPtr->Get();
 
-			if constexpr (std::is_same_v<std::vector<T::value_type>, T>) // Check that the collection is std vector
+			if constexpr (std::is_same_v<std::vector<typename T::value_type>, T>) // Check that the collection is std vector
 				Vector.resize(pArray->size());
 
 			for (size_t i = 0; i < pArray->size(); ++i)
 			{
 				const auto& ValueData = pArray->at(i);
-				if constexpr (std::is_same_v<std::vector<T::value_type>, T>) // Check that the collection is std vector
+				if constexpr (std::is_same_v<std::vector<typename T::value_type>, T>) // Check that the collection is std vector
 				{
 					Deserialize(ValueData, Vector[i]);
 				}
@@ -328,7 +328,7 @@ struct ParamsFormat
 		else
 		{
 			// Try to deserialize the value as a vector of a single element
-			if constexpr (std::is_same_v<std::vector<T::value_type>, T>) // Check that the collection is std vector
+			if constexpr (std::is_same_v<std::vector<typename T::value_type>, T>) // Check that the collection is std vector
 			{
 				Deserialize(Input, Vector.emplace_back());
 			}
@@ -456,9 +456,9 @@ struct ParamsFormat
 	template<typename T, typename std::enable_if_t<Meta::is_pair_iterable_v<T>>* = nullptr>
 	static inline void DeserializeDiff(const Data::CData& Input, T& Map)
 	{
-		static_assert(is_string_compatible_v<T::key_type>, "CData deserialization supports only string map keys");
+		static_assert(is_string_compatible_v<typename T::key_type>, "CData deserialization supports only string map keys");
 
-		constexpr bool IsStrIDKey = std::is_same_v<std::remove_cv_t<std::remove_reference_t<T::key_type>>, CStrID>;
+		constexpr bool IsStrIDKey = std::is_same_v<std::remove_cv_t<std::remove_reference_t<typename T::key_type>>, CStrID>;
 
 		if (auto pParamsPtr = Input.As<Data::PParams>())
 		{
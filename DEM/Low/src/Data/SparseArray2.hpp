@@ -165,6 +165,7 @@ protected:
 	{
 	public:
 
+		using value_type = typename CConstantIterator::value_type;
 		using pointer = value_type*;
 		using reference = value_type&;
 
@@ -875,7 +876,7 @@ public:
 			_Data == Other._Data;
 	}
 
-	bool operator !=(const CSparseArray2<T, TIndex>& Other) const { return !(a == b); }
+	bool operator !=(const CSparseArray2<T, TIndex>& Other) const { return !(*this == Other); }
 };
 
 }
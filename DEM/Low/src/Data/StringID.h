@@ -1,5 +1,6 @@
 #pragma once
 #include <Data/Hash.h>
+#include <cstring>
 #include <string>
 
 // Static string identifier. The actual string is stored only once and all CStrIDs reference it
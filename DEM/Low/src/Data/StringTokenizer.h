@@ -71,7 +71,9 @@ inline const char* CStringTokenizer::GetNextToken(const char* pSplitChars)
 	}
 	else
 	{
-		n_verify_dbg(strcpy_s(pBuffer, BufferSize, pCursor) == 0);
+		const UPTR TokenSize = strlen(pCursor);
+		n_assert2_dbg(TokenSize < BufferSize, "CStringTokenizer > Buffer overflow");
+		memcpy(pBuffer, pCursor, TokenSize + 1);
 		CurrDelimiter = 0;
 	}
 
@@ -96,7 +98,9 @@ inline const char* CStringTokenizer::GetNextToken(char SplitChar)
 	}
 	else
 	{
-		n_verify_dbg(strcpy_s(pBuffer, BufferSize, pCursor) == 0);
+		const UPTR TokenSize = strlen(pCursor);
+		n_assert2_dbg(TokenSize < BufferSize, "CStringTokenizer > Buffer overflow");
+		memcpy(pBuffer, pCursor, TokenSize + 1);
 		CurrDelimiter = 0;
 	}
 
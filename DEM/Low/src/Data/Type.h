@@ -1,20 +1,39 @@
 #pragma once
 #include <System/Memory.h>
 #include <string>
+#include <cstring>
+#include <type_traits>
 
 // Template data type implementation.
 
 #define INVALID_TYPE_ID (-1)
 
 #define DECLARE_TYPE(T, ID)					namespace Data { template<> class CTypeID<T> { public: enum { TypeID = ID }; enum { IsDeclared = true }; }; }
-#define DEFINE_TYPE(T, DEFAULT)				static CTypeImpl<T> DataType_##T; const CType* CTypeImpl<T>::Type = &DataType_##T; const T CTypeImpl<T>::DefaultValue = DEFAULT;
-#define DEFINE_TYPE_EX(T, Name, DEFAULT)	static CTypeImpl<T> DataType_##Name; const CType* CTypeImpl<T>::Type = &DataType_##Name; const T CTypeImpl<T>::DefaultValue = DEFAULT;
+#define DEFINE_TYPE(T, DEFAULT)				static CTypeImpl<T> DataType_##T; template<> const CType* CTypeImpl<T>::Type = &DataType_##T; template<> const T CTypeImpl<T>::DefaultValue = DEFAULT;
+#define DEFINE_TYPE_EX(T, Name, DEFAULT)	static CTypeImpl<T> DataType_##Name; template<> const CType* CTypeImpl<T>::Type = &DataType_##Name; template<> const T CTypeImpl<T>::DefaultValue = DEFAULT;
 #define DATA_TYPE(T)						(Data::CType::GetType<T>())
 #define DATA_TYPE_ID(T)						(Data::CType::GetTypeID<T>())
 #define DATA_TYPE_NV(T)						Data::CTypeImpl<T>::GetNVType()->CTypeImpl<T>
 
 namespace Data
 {
+// Values up to this size are stored right inside a CData without a heap allocation. Fits vector3, vector4 and
+// std::string in release builds. Bigger values like matrix44 are allocated in the heap.
+constexpr size_t DATA_INLINE_SIZE = 32;
+
+// Needed only for assertions, can remove when disable asserts
+template<class T>
+class CTypeID
+{
+public:
+
+	enum { TypeID = INVALID_TYPE_ID }; //???use fourcc?
+	enum { IsDeclared = false };
+	//can store debug type name here
+};
+
+template<class T> class CTypeImpl;
+
 //if const void* Value <=> const void** pSrcObj ambiguity, use forex UPTR** instead of void**
 
 class CType
@@ -31,6 +50,8 @@ public:
 	virtual void		Delete(void** pObj) const = 0;
 	virtual void		Copy(void** pObj, void* const* pSrcObj) const = 0;
 	virtual void		CopyT(void** pObj, const void* Value) const = 0;
+	virtual void		Relocate(void** pObj, void** pSrcObj) const = 0;
+	virtual bool		IsNull(const void* pObj) const = 0;
 	virtual bool		IsEqual(const void* pObj, const void* pOtherObj) const = 0;
 	virtual bool		IsEqualT(const void* pObj, const void* OtherValue) const = 0;
 	virtual int			GetSize() const = 0;
@@ -43,17 +64,6 @@ public:
 	static int			GetTypeID() { static_assert(CTypeID<T>::IsDeclared, "Type not declared!"); return CTypeID<T>::TypeID; }
 };
 
-// Needed only for assertions, can remove when disable asserts
-template<class T>
-class CTypeID
-{
-public:
-
-	enum { TypeID = INVALID_TYPE_ID }; //???use fourcc?
-	enum { IsDeclared = false };
-	//can store debug type name here
-};
-
 template<class T>
 class CTypeImpl: public CType
 {
@@ -62,6 +72,9 @@ public:
 	static const CType* Type;
 	static const T		DefaultValue;
 
+	// NB: inline values are relocated on CData move, so moving them must not throw
+	static constexpr bool IsInline = (sizeof(T) <= DATA_INLINE_SIZE) && (alignof(T) <= alignof(void*)) && std::is_nothrow_move_constructible_v<T>;
+
 	CTypeImpl() { static_assert(CTypeID<T>::IsDeclared, "Type not declared!"); }
 	
 	// Getter for non-virtual type instance (convenience method)
@@ -73,18 +86,20 @@ public:
 	virtual void		Delete(void** pObj) const;
 	virtual void		Copy(void** pObj, void* const* pSrcObj) const;
 	virtual void		CopyT(void** pObj, const void* Value) const;
+	virtual void		Relocate(void** pObj, void** pSrcObj) const;
+	virtual bool		IsNull(const void* pObj) const;
 	virtual bool		IsEqual(const void* pObj, const void* pOtherObj) const { return (*(T*)GetPtr(pObj)) == (*(T*)GetPtr(pOtherObj)); }
 	virtual bool		IsEqualT(const void* pObj, const void* OtherValue) const { return (*(T*)GetPtr(pObj)) == (*(const T*)OtherValue); }
 	virtual int			GetSize() const { return (sizeof(T) <= sizeof(void*)) ? sizeof(void*) : sizeof(T); }
 	virtual int			GetID() const { return CTypeID<T>::TypeID; }
 	virtual std::string	ToString(const void* /*pObj*/) const { return {}; }
 
-	void*               GetPtr(void* pObj) const { return (sizeof(T) <= sizeof(void*)) ? pObj : *(T**)pObj; }
-	const void*         GetPtr(const void* pObj) const { return (sizeof(T) <= sizeof(void*)) ? pObj : *(T**)pObj; }
+	void*               GetPtr(void* pObj) const { return IsInline ? pObj : *(T**)pObj; }
+	const void*         GetPtr(const void* pObj) const { return IsInline ? pObj : *(T**)pObj; }
 
 	void NewMoveT(void** pObj, T&& Value) const
 	{
-		if constexpr (sizeof(T) <= sizeof(void*))
+		if constexpr (IsInline)
 			n_placement_new(pObj, T)(std::move(Value));
 		else
 			*(T**)pObj = n_new(T)(std::move(Value));
@@ -92,7 +107,7 @@ public:
 
 	void MoveT(void** pObj, T&& Value) const
 	{
-		if constexpr (sizeof(T) <= sizeof(void*))
+		if constexpr (IsInline)
 		{
 			*(T*)pObj = std::move(Value);
 		}
@@ -108,28 +123,28 @@ public:
 
 template<class T> inline void CTypeImpl<T>::New(void** pObj) const
 {
-	if (sizeof(T) <= sizeof(void*)) n_placement_new(pObj, T)(DefaultValue);
+	if (IsInline) n_placement_new(pObj, T)(DefaultValue);
 	else *(T**)pObj = n_new(T)(DefaultValue);
 }
 //---------------------------------------------------------------------
 
 template<class T> inline void CTypeImpl<T>::New(void** pObj, void* const* pSrcObj) const
 {
-	if (sizeof(T) <= sizeof(void*)) n_placement_new(pObj, T)(*(const T*)GetPtr(pSrcObj));
+	if (IsInline) n_placement_new(pObj, T)(*(const T*)GetPtr(pSrcObj));
 	else *(T**)pObj = n_new(T)(*(const T*)GetPtr(pSrcObj));
 }
 //---------------------------------------------------------------------
 
 template<class T> inline void CTypeImpl<T>::NewT(void** pObj, const void* Value) const
 {
-	if (sizeof(T) <= sizeof(void*)) n_placement_new(pObj, T)(*(const T*)Value);
+	if (IsInline) n_placement_new(pObj, T)(*(const T*)Value);
 	else *(T**)pObj = n_new(T)(*(const T*)Value);
 }
 //---------------------------------------------------------------------
 
 template<class T> inline void CTypeImpl<T>::Delete(void** pObj) const
 {
-	if (sizeof(T) <= sizeof(void*)) ((T*)pObj)->~T();
+	if (IsInline) ((T*)pObj)->~T();
 	else
 	{
 		if (*(T**)pObj) n_delete(*(T**)pObj);
@@ -140,7 +155,7 @@ template<class T> inline void CTypeImpl<T>::Delete(void** pObj) const
 
 template<class T> inline void CTypeImpl<T>::Copy(void** pObj, void* const* pSrcObj) const
 {
-	if (sizeof(T) <= sizeof(void*)) *(T*)pObj = *(T*)pSrcObj;
+	if (IsInline) *(T*)pObj = *(T*)pSrcObj;
 	else
 	{
 		if (*(T**)pObj) **(T**)pObj = **(T**)pSrcObj;
@@ -149,9 +164,40 @@ template<class T> inline void CTypeImpl<T>::Copy(void** pObj, void* const* pSrcO
 }
 //---------------------------------------------------------------------
 
+// Constructs the value in uninitialized pObj storage from pSrcObj and leaves pSrcObj empty
+template<class T> inline void CTypeImpl<T>::Relocate(void** pObj, void** pSrcObj) const
+{
+	if constexpr (!IsInline)
+	{
+		// Only the pointer is transferred
+		*pObj = *pSrcObj;
+	}
+	else if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		std::memcpy(pObj, pSrcObj, sizeof(T));
+	}
+	else
+	{
+		n_placement_new(pObj, T)(std::move(*(T*)pSrcObj));
+		((T*)pSrcObj)->~T();
+	}
+	*pSrcObj = nullptr;
+}
+//---------------------------------------------------------------------
+
+// Pointer-like values and heap storage pointers can be null, other inline values can't
+template<class T> inline bool CTypeImpl<T>::IsNull(const void* pObj) const
+{
+	if constexpr (!IsInline || (sizeof(T) == sizeof(void*) && !std::is_arithmetic_v<T>))
+		return !*(void* const*)pObj;
+	else
+		return false;
+}
+//---------------------------------------------------------------------
+
 template<class T> inline void CTypeImpl<T>::CopyT(void** pObj, const void* Value) const
 {
-	if (sizeof(T) <= sizeof(void*)) *(T*)pObj = *(const T*)Value;
+	if (IsInline) *(T*)pObj = *(const T*)Value;
 	else
 	{
 		if (*(T**)pObj) **(T**)pObj = *(const T*)Value;
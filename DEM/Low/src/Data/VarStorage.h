@@ -312,7 +312,7 @@ public:
 		{
 			Saved += DEM::Meta::compile_switch(Handle.TypeIdx, std::index_sequence_for<TVarTypes...>{}, [this, &Params, ID = ID, Handle = Handle](auto i)
 			{
-				using TVarType = TEffective<T>;
+				using TVarType = std::tuple_element_t<i, std::tuple<TVarTypes...>>;
 				using THRDType = Data::THRDType<TVarType>;
 
 				if constexpr (Data::CTypeID<THRDType>::IsDeclared)
@@ -169,7 +169,7 @@ void CDebugDraw::Render(Render::CEffect& Effect, const rtm::matrix4x4f& ViewProj
 				for (const auto& Pass : Passes)
 				{
 					GPU.SetRenderState(Pass);
-					GPU.Draw({ {}, 0, BatchSize, 0, 0, Render::Prim_TriList });
+					GPU.Draw({ Math::CAABB{}, 0, BatchSize, 0, 0, Render::Prim_TriList });
 				}
 			}
 		}
@@ -211,7 +211,7 @@ void CDebugDraw::Render(Render::CEffect& Effect, const rtm::matrix4x4f& ViewProj
 				for (const auto& Pass : Passes)
 				{
 					GPU.SetRenderState(Pass);
-					GPU.Draw({ {}, 0, BatchSize, 0, 0, Render::Prim_LineList });
+					GPU.Draw({ Math::CAABB{}, 0, BatchSize, 0, 0, Render::Prim_LineList });
 				}
 			}
 		}
@@ -252,7 +252,7 @@ void CDebugDraw::Render(Render::CEffect& Effect, const rtm::matrix4x4f& ViewProj
 				for (const auto& Pass : Passes)
 				{
 					GPU.SetRenderState(Pass);
-					GPU.Draw({ {}, 0, BatchSize, 0, 0, Render::Prim_PointList });
+					GPU.Draw({ Math::CAABB{}, 0, BatchSize, 0, 0, Render::Prim_PointList });
 				}
 			}
 		}
@@ -427,7 +427,7 @@ void CDebugDraw::DrawCircleXZ(const vector3& Pos, float Radius, float SegmentCou
 	for (U16 i = 1; i < SegmentCount; ++i)
 	{
 		const float Longitude = StepInRadians * i;
-		vector3 Vertex(Radius * std::sinf(Longitude), 0.f, Radius * std::cosf(Longitude)); 
+		vector3 Vertex(Radius * std::sin(Longitude), 0.f, Radius * std::cos(Longitude)); 
 		AddLineVertex(Vertex);
 		AddLineVertex(Vertex);
 	}
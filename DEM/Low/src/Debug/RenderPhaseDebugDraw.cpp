@@ -40,7 +40,8 @@ bool CRenderPhaseDebugDraw::Render(CView& View)
 	if (!pCamera || !pDebugDraw || !Effect || !pTarget) FAIL;
 
 	View.GetGPU()->SetRenderTarget(0, pTarget);
-	View.GetGPU()->SetViewport(0, &Render::GetRenderTargetViewport(pTarget->GetDesc()));
+	const auto Viewport = Render::GetRenderTargetViewport(pTarget->GetDesc());
+	View.GetGPU()->SetViewport(0, &Viewport);
 
 	pDebugDraw->Render(*Effect, pCamera->GetViewProjMatrix());
 
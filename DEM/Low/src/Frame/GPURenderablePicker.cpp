@@ -4,6 +4,7 @@
 #include <Frame/CameraAttribute.h>
 #include <Render/Renderable.h>
 #include <Render/GPUDriver.h>
+#include <Render/GPUCommandList.h>
 #include <Render/RenderTarget.h>
 #include <Render/Texture.h>
 #include <Render/DepthStencilBuffer.h> // at least for a destructor
@@ -80,13 +81,18 @@ bool CGPURenderablePicker::PickAsync(CPickRequest& AsyncRequest)
 	// Bind render targets and a depth-stencil buffer
 	pGPU->SetRenderTarget(0, _RT);
 	pGPU->SetDepthStencilBuffer(_DS);
-	pGPU->SetViewport(0, &Render::GetRenderTargetViewport(_RT->GetDesc()));
+	const auto Viewport = Render::GetRenderTargetViewport(_RT->GetDesc());
+	pGPU->SetViewport(0, &Viewport);
 	pGPU->ClearRenderTarget(*_RT, PickerTargetEmptyValue);
 	pGPU->ClearDepthStencilBuffer(*_DS, Render::Clear_Depth, 1.f, 0);
 
 	// Initialize rendering context
+	// Render modifiers write per-instance params directly, so commands are executed immediately
+	Render::CGPUCommandList CmdList(pGPU);
+
 	Render::IRenderer::CRenderContext Ctx;
 	Ctx.pGPU = pGPU;
+	Ctx.pCommandList = &CmdList;
 	Ctx.pShaderTechCache = pView->GetGPUPickShaderTechCache();
 
 	// Calculate a view-projection matrix to render only the requested rect (typically a single pixel)
@@ -129,7 +135,11 @@ bool CGPURenderablePicker::PickAsync(CPickRequest& AsyncRequest)
 					pCurrRenderer = nullptr;
 		}
 
-		if (pCurrRenderer) pCurrRenderer->Render(Ctx, *pRenderable, &CGPUPickRenderModifier(ViewProj, i));
+		if (pCurrRenderer)
+		{
+			CGPUPickRenderModifier Modifier(ViewProj, i);
+			pCurrRenderer->Render(Ctx, *pRenderable, &Modifier);
+		}
 	}
 	if (pCurrRenderer) pCurrRenderer->EndRange(Ctx);
 
@@ -16,7 +16,9 @@
 #include <Render/MeshData.h>
 #include <Render/RenderStateDesc.h>
 #include <Render/SamplerDesc.h>
+#if DEM_UI_CEGUI
 #include <UI/UIServer.h>
+#endif
 #include <Resources/ResourceManager.h>
 #include <Resources/Resource.h>
 #include <IO/Stream.h>
@@ -320,7 +322,7 @@ bool CGraphicsResourceManager::LoadShaderParamValues(IO::CBinaryReader& Reader,
 
 		// Convert offsets to direct pointers
 		for (auto& Pair : Out.ConstValues)
-			Pair.second.pData = Out.ConstValueBuffer.get() + (U32)Pair.second.pData;
+			Pair.second.pData = Out.ConstValueBuffer.get() + reinterpret_cast<UPTR>(Pair.second.pData);
 	}
 
 	OK;
@@ -925,10 +927,14 @@ PRenderPath CGraphicsResourceManager::LoadRenderPath(CStrID UID)
 
 bool CGraphicsResourceManager::InitUI(const Data::CParams* pSettings)
 {
+#if DEM_UI_CEGUI
 	if (UIServer || !GPU) FAIL;
 
 	UIServer.reset(n_new(UI::CUIServer)(*GPU, pSettings));
 	return !!UIServer;
+#else
+	FAIL;
+#endif
 }
 //---------------------------------------------------------------------
 
@@ -940,7 +946,9 @@ PView CGraphicsResourceManager::CreateView(CStrID RenderPathID, int SwapChainID,
 
 void CGraphicsResourceManager::Update(float dt)
 {
+#if DEM_UI_CEGUI
 	if (UIServer) UIServer->Trigger(dt);
+#endif
 }
 //---------------------------------------------------------------------
 
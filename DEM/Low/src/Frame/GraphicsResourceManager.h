@@ -52,7 +52,9 @@ private:
 	Resources::CResourceManager*                  pResMgr = nullptr; //???strong ref?
 	Render::PGPUDriver                            GPU;
 	DEM::Jobs::CJobSystem*                        _pJobSystem = nullptr; // TODO: service locator?
+#if DEM_UI_CEGUI
 	std::unique_ptr<UI::CUIServer>                UIServer; // FIXME: is the right place?
+#endif
 
 	std::unordered_map<CStrID, Render::PMesh>     Meshes;
 	std::unordered_map<CStrID, Render::PTexture>  Textures;
@@ -94,8 +96,13 @@ public:
 
 	Resources::CResourceManager* GetResourceManager() const { return pResMgr; }
 	Render::CGPUDriver*          GetGPU() const { return GPU.Get(); }
+	DEM::Jobs::CJobSystem*       GetJobSystem() const { return _pJobSystem; }
 	DEM::Jobs::CWorker*          GetJobSystemWorker() const;
+#if DEM_UI_CEGUI
 	UI::CUIServer*               GetUI() const { return UIServer.get(); }
+#else
+	UI::CUIServer*               GetUI() const { return nullptr; }
+#endif
 };
 
 }
@@ -1,11 +1,13 @@
 #include "RenderPhaseGeometry.h"
 #include <Frame/View.h>
 #include <Frame/RenderPath.h>
+#include <Frame/GraphicsResourceManager.h>
 #include <Frame/CameraAttribute.h>
 #include <Render/Renderable.h>
 #include <Render/GPUDriver.h>
 #include <Render/RenderTarget.h>
 #include <Render/DepthStencilBuffer.h>
+#include <Jobs/JobSystem.h>
 #include <Data/Params.h>
 #include <Data/DataArray.h>
 #include <Core/Factory.h>
@@ -31,7 +33,8 @@ bool CRenderPhaseGeometry::Render(CView& View)
 	{
 		auto pTarget = View.GetRenderTarget(_RenderTargetIDs[i]);
 		pGPU->SetRenderTarget(i, pTarget);
-		pGPU->SetViewport(i, &Render::GetRenderTargetViewport(pTarget->GetDesc()));
+		const auto Viewport = Render::GetRenderTargetViewport(pTarget->GetDesc());
+		pGPU->SetViewport(i, &Viewport);
 	}
 
 	const UPTR MaxRTCount = pGPU->GetMaxMultipleRenderTargetCount();
@@ -40,38 +43,57 @@ bool CRenderPhaseGeometry::Render(CView& View)
 
 	auto pDepthStencliBuffer = View.GetDepthStencilBuffer(_DepthStencilID);
 	if (pDepthStencliBuffer && !RenderTargetCount)
-		pGPU->SetViewport(0, &Render::GetRenderTargetViewport(pDepthStencliBuffer->GetDesc()));
+	{
+		const auto Viewport = Render::GetRenderTargetViewport(pDepthStencliBuffer->GetDesc());
+		pGPU->SetViewport(0, &Viewport);
+	}
 	pGPU->SetDepthStencilBuffer(pDepthStencliBuffer);
 
 	// Render objects from queues
 
-	Render::IRenderer::CRenderContext Ctx;
-	Ctx.pGPU = pGPU;
-	Ctx.pShaderTechCache = View.GetShaderTechCache(_ShaderTechCacheIndex);
-
-	Render::IRenderer* pCurrRenderer = nullptr;
-	U8 CurrRendererIndex = 0;
+	size_t TotalCount = 0;
 	for (const U32 QueueIndex : _RenderQueueIndices)
+		TotalCount += View.GetRenderableCountInQueue(QueueIndex);
+
+	// Decide how many command lists to record in parallel. Each one needs its own set of renderers.
+	auto pGfxMgr = View.GetGraphicsManager();
+	auto pWorker = pGfxMgr->GetJobSystemWorker();
+	UPTR ListCount = 1;
+	if (pWorker && _MinRenderablesPerCommandList)
+	{
+		const UPTR MaxListCount = _MaxCommandLists ? _MaxCommandLists : (pGfxMgr->GetJobSystem()->GetWorkerThreadCount() + 1);
+		ListCount = std::clamp<UPTR>(TotalCount / _MinRenderablesPerCommandList, 1, MaxListCount);
+		if (ListCount > 1 && !View.PrepareRendererSets(ListCount)) ListCount = 1;
+	}
+
+	if (ListCount > 1)
 	{
-		View.ForEachRenderableInQueue(QueueIndex, [this, &View, &Ctx, &pCurrRenderer, &CurrRendererIndex](Render::IRenderable* pRenderable)
+		if (_CommandLists.size() < ListCount) _CommandLists.resize(ListCount);
+
+		DEM::Jobs::CJobCounter Counter;
+		for (UPTR i = 1; i < ListCount; ++i)
 		{
-			// This is guaranteed by CView, it fills queues with visible objects only
-			n_assert_dbg(pRenderable->IsVisible);
+			const size_t Start = TotalCount * i / ListCount;
+			const size_t End = TotalCount * (i + 1) / ListCount;
+			pWorker->AddJob(Counter, [this, &View, i, Start, End]() { RecordRange(View, _CommandLists[i], i, Start, End); });
+		}
 
-			if (CurrRendererIndex != pRenderable->RendererIndex)
-			{
-				if (pCurrRenderer) pCurrRenderer->EndRange(Ctx);
-				CurrRendererIndex = pRenderable->RendererIndex;
-				pCurrRenderer = View.GetRenderer(CurrRendererIndex);
-				if (pCurrRenderer)
-					if (!pCurrRenderer->BeginRange(Ctx))
-						pCurrRenderer = nullptr;
-			}
-
-			if (pCurrRenderer) pCurrRenderer->Render(Ctx, *pRenderable);
-		});
+		// Record the first range on this thread while workers record the rest
+		RecordRange(View, _CommandLists[0], 0, 0, TotalCount / ListCount);
+
+		pWorker->WaitIdle(Counter);
+
+		for (UPTR i = 0; i < ListCount; ++i)
+		{
+			_CommandLists[i].Submit(*pGPU);
+			_CommandLists[i].Clear();
+		}
+	}
+	else
+	{
+		Render::CGPUCommandList CmdList(pGPU);
+		RecordRange(View, CmdList, 0, 0, TotalCount);
 	}
-	if (pCurrRenderer) pCurrRenderer->EndRange(Ctx);
 
 	// Unbind render target(s) etc
 	//???allow each phase to declare all its RTs and clear unused ones by itself?
@@ -81,6 +103,53 @@ bool CRenderPhaseGeometry::Render(CView& View)
 }
 //---------------------------------------------------------------------
 
+// Records renderables [Start, End) of queues concatenated in the order of _RenderQueueIndices
+void CRenderPhaseGeometry::RecordRange(CView& View, Render::CGPUCommandList& CmdList, UPTR RendererSetIndex, size_t Start, size_t End) const
+{
+	ZoneScoped;
+
+	Render::IRenderer::CRenderContext Ctx;
+	Ctx.pGPU = View.GetGPU();
+	Ctx.pCommandList = &CmdList;
+	Ctx.pShaderTechCache = View.GetShaderTechCache(_ShaderTechCacheIndex);
+
+	Render::IRenderer* pCurrRenderer = nullptr;
+	U8 CurrRendererIndex = 0;
+	size_t QueueStart = 0;
+	for (const U32 QueueIndex : _RenderQueueIndices)
+	{
+		if (QueueStart >= End) break;
+
+		const size_t QueueEnd = QueueStart + View.GetRenderableCountInQueue(QueueIndex);
+		if (QueueEnd > Start)
+		{
+			const size_t LocalStart = std::max(Start, QueueStart) - QueueStart;
+			const size_t LocalEnd = std::min(End, QueueEnd) - QueueStart;
+			View.ForEachRenderableInQueue(QueueIndex, LocalStart, LocalEnd, [&View, &Ctx, &pCurrRenderer, &CurrRendererIndex, RendererSetIndex](Render::IRenderable* pRenderable)
+			{
+				// This is guaranteed by CView, it fills queues with visible objects only
+				n_assert_dbg(pRenderable->IsVisible);
+
+				if (CurrRendererIndex != pRenderable->RendererIndex)
+				{
+					if (pCurrRenderer) pCurrRenderer->EndRange(Ctx);
+					CurrRendererIndex = pRenderable->RendererIndex;
+					pCurrRenderer = View.GetRenderer(CurrRendererIndex, RendererSetIndex);
+					if (pCurrRenderer)
+						if (!pCurrRenderer->BeginRange(Ctx))
+							pCurrRenderer = nullptr;
+				}
+
+				if (pCurrRenderer) pCurrRenderer->Render(Ctx, *pRenderable);
+			});
+		}
+
+		QueueStart = QueueEnd;
+	}
+	if (pCurrRenderer) pCurrRenderer->EndRange(Ctx);
+}
+//---------------------------------------------------------------------
+
 bool CRenderPhaseGeometry::Init(CRenderPath& Owner, CGraphicsResourceManager& GfxMgr, CStrID PhaseName, const Data::CParams& Desc)
 {
 	if (!CRenderPhase::Init(Owner, GfxMgr, PhaseName, Desc)) FAIL;
@@ -125,6 +194,9 @@ bool CRenderPhaseGeometry::Init(CRenderPath& Owner, CGraphicsResourceManager& Gf
 		_RenderQueueIndices[i] = It->second;
 	}
 
+	_MaxCommandLists = static_cast<U32>(std::max(0, Desc.Get(CStrID("MaxCommandLists"), 0)));
+	_MinRenderablesPerCommandList = static_cast<U32>(std::max(0, Desc.Get(CStrID("MinRenderablesPerCommandList"), 256)));
+
 	Data::PParams EffectsDesc;
 	if (Desc.TryGet(EffectsDesc, CStrID("Effects")))
 	{
@@ -1,9 +1,13 @@
 #pragma once
 #include <Frame/RenderPhase.h>
+#include <Render/GPUCommandList.h>
 #include <Data/FixedArray.h>
 
 // Renders geometry batches, instanced when possible. Uses sorting, lights.
 // Batches are designed to minimize shader state switches.
+// Big queues are split into ranges recorded into command lists on job workers in parallel.
+// Lists are submitted to the GPU in order, so the result is the same as with serial rendering,
+// except that batches can't be merged across range boundaries.
 
 namespace Frame
 {
@@ -18,6 +22,12 @@ protected:
 	CFixedArray<CStrID> _RenderTargetIDs; // TODO: could resolve into indices too?
 	CStrID              _DepthStencilID; // TODO: could resolve into index too?
 	UPTR                _ShaderTechCacheIndex = 0;
+	U32                 _MaxCommandLists = 0;                // 0 means one per job system thread
+	U32                 _MinRenderablesPerCommandList = 256; // 0 disables parallel recording
+
+	std::vector<Render::CGPUCommandList> _CommandLists;
+
+	void RecordRange(CView& View, Render::CGPUCommandList& CmdList, UPTR RendererSetIndex, size_t Start, size_t End) const;
 
 public:
 
@@ -50,6 +50,11 @@ bool CModelAttribute::LoadDataBlocks(IO::CBinaryReader& DataReader, UPTR Count)
 				if (!DataReader.Read(_MeshGroupIndex)) FAIL;
 				break;
 			}
+			case 'MLOD':
+			{
+				if (!DataReader.Read(_MeshLOD)) FAIL;
+				break;
+			}
 			default: FAIL;
 		}
 	}
@@ -64,6 +69,7 @@ Scene::PNodeAttribute CModelAttribute::Clone()
 	ClonedAttr->_MeshUID = _MeshUID;
 	ClonedAttr->_MaterialUID = _MaterialUID;
 	ClonedAttr->_MeshGroupIndex = _MeshGroupIndex;
+	ClonedAttr->_MeshLOD = _MeshLOD;
 	ClonedAttr->_MeshData = _MeshData;
 	return ClonedAttr;
 }
@@ -91,7 +97,8 @@ void CModelAttribute::UpdateRenderable(CView& View, Render::IRenderable& Rendera
 {
 	//!!!TODO: calc LOD from Renderable.SqDistanceToCamera and from screen radius (to be added to Renderable)!
 	//!!!NB: object can be culled by LOD (i.e. by distance or screen size). Then need to set Renderable.IsVisible here to false and return.
-	UPTR LOD = 0;	
+	// Now LOD is fixed per attribute and distance based switching is done by a CLODGroup.
+	const UPTR LOD = (_MeshData && _MeshData->GetLODCount()) ? std::min<UPTR>(_MeshLOD, _MeshData->GetLODCount() - 1) : 0;
 
 	auto pModel = static_cast<Render::CModel*>(&Renderable);
 
@@ -126,6 +133,13 @@ void CModelAttribute::UpdateRenderable(CView& View, Render::IRenderable& Rendera
 		{
 			pModel->pSkinPalette = Palette->GetSkinPalette();
 			pModel->BoneCount = Palette->GetSkinInfo()->GetBoneCount();
+
+			// Renderer skips uploading the palette if the version is unchanged or uploads only the dirty range
+			UPTR DirtyBegin, DirtyEnd;
+			if (!Palette->GetDirtyRange(DirtyBegin, DirtyEnd)) DirtyBegin = DirtyEnd = 0;
+			pModel->SkinPaletteVersion = Palette->GetVersion();
+			pModel->SkinDirtyBegin = static_cast<U32>(DirtyBegin);
+			pModel->SkinDirtyEnd = static_cast<U32>(DirtyEnd);
 		}
 	}
 	else pModel->pSkinPalette = nullptr;
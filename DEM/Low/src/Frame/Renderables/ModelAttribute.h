@@ -20,6 +20,7 @@ protected:
 	CStrID            _MeshUID;
 	CStrID            _MaterialUID;
 	U32               _MeshGroupIndex = 0;
+	U32               _MeshLOD = 0;        // Mesh LOD is selected by a CLODGroup on a parent node, which switches between model nodes
 
 	Render::PMeshData _MeshData;
 
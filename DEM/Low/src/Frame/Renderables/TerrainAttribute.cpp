@@ -189,7 +189,7 @@ void CTerrainAttribute::UpdateRenderable(CView& View, Render::IRenderable& Rende
 	if (MorphChanged || ViewProjChanged || pTerrain->PatchesTransformVersion != _pNode->GetTransformVersion())
 	{
 		// FIXME: must pass the main camera position, the one used for final frame presentation, not a view camera pos!?
-		pTerrain->UpdatePatches(View.GetCamera()->GetPosition(), View.GetViewFrustum());
+		pTerrain->UpdatePatches(View.GetCamera()->GetPosition(), View.GetViewFrustum(), View.GetGraphicsManager()->GetJobSystemWorker());
 		pTerrain->PatchesTransformVersion = _pNode->GetTransformVersion();
 	}
 }
@@ -27,6 +27,9 @@ void CSkinPalette::SetSkinInfo(Render::PSkinInfo SkinInfo)
 		// Allocate aligned to 16 for faster transfer to VRAM
 		_pSkinPalette = static_cast<rtm::matrix3x4f*>(n_malloc_aligned(BoneCount * sizeof(rtm::matrix3x4f), alignof(rtm::matrix3x4f)));
 		_BoneNodes = std::make_unique<CBoneInfo[]>(BoneCount);
+		_DirtyBones = std::make_unique<CDirtyBone[]>(BoneCount);
+		_DirtyBegin = 0;
+		_DirtyEnd = 0;
 	}
 }
 //---------------------------------------------------------------------
@@ -42,6 +45,7 @@ void CSkinPalette::SetupBoneNodes(UPTR ParentIndex, Scene::CSceneNode& ParentNod
 
 		// Reset palette just in case some nodes are not found
 		_pSkinPalette[i] = rtm::matrix_identity();
+		MarkDirty(i, i + 1);
 
 		const auto& BoneInfo = _SkinInfo->GetBoneInfo(i);
 		if (BoneInfo.ParentIndex != ParentIndex) continue;
@@ -64,20 +68,88 @@ void CSkinPalette::SetupBoneNodes(UPTR ParentIndex, Scene::CSceneNode& ParentNod
 }
 //---------------------------------------------------------------------
 
+// Changes made between updates are accumulated and published by the next update
+void CSkinPalette::MarkDirty(UPTR Begin, UPTR End)
+{
+	if (_DirtyRangePublished)
+	{
+		_DirtyBegin = 0;
+		_DirtyEnd = 0;
+		_DirtyRangePublished = false;
+	}
+
+	if (_DirtyBegin < _DirtyEnd)
+	{
+		_DirtyBegin = std::min(_DirtyBegin, Begin);
+		_DirtyEnd = std::max(_DirtyEnd, End);
+	}
+	else
+	{
+		_DirtyBegin = Begin;
+		_DirtyEnd = End;
+	}
+}
+//---------------------------------------------------------------------
+
+// Dirty bones are gathered first and then multiplied in a separate loop, so that the loop that does the math
+// doesn't branch on scene node state. Results are written directly to the aligned palette that is uploaded
+// to the GPU. The dirty range and the version tell the renderer which part of the palette to re-upload.
 void CSkinPalette::Update()
 {
 	if (!_SkinInfo || !_BoneNodes || !_pSkinPalette) return;
 
+	ZoneScoped;
+
+	if (_DirtyRangePublished)
+	{
+		_DirtyBegin = 0;
+		_DirtyEnd = 0;
+	}
+	_DirtyRangePublished = true;
+
+	// Gather bones whose world transform changed since the last update
+	UPTR DirtyCount = 0;
 	const UPTR BoneCount = _SkinInfo->GetBoneCount();
 	for (UPTR i = 0; i < BoneCount; ++i)
 	{
-		const Scene::CSceneNode* pBoneNode = _BoneNodes[i].pNode;
-		if (pBoneNode && pBoneNode->GetTransformVersion() != _BoneNodes[i].LastTransformVersion)
+		auto& BoneInfo = _BoneNodes[i];
+		const Scene::CSceneNode* pBoneNode = BoneInfo.pNode;
+		if (pBoneNode && pBoneNode->GetTransformVersion() != BoneInfo.LastTransformVersion)
 		{
-			_pSkinPalette[i] = rtm::matrix_mul(_SkinInfo->GetInvBindPose(i), pBoneNode->GetWorldMatrix());
-			_BoneNodes[i].LastTransformVersion = pBoneNode->GetTransformVersion();
+			_DirtyBones[DirtyCount++] = { i, &pBoneNode->GetWorldMatrix() };
+			BoneInfo.LastTransformVersion = pBoneNode->GetTransformVersion();
 		}
 	}
+
+	// Indices are gathered in ascending order
+	if (DirtyCount)
+	{
+		_DirtyBegin = (_DirtyBegin < _DirtyEnd) ? std::min(_DirtyBegin, _DirtyBones[0].Index) : _DirtyBones[0].Index;
+		_DirtyEnd = std::max(_DirtyEnd, _DirtyBones[DirtyCount - 1].Index + 1);
+	}
+
+	if (_DirtyBegin >= _DirtyEnd) return;
+
+	++_Version;
+
+	// Each rtm::matrix_mul is SIMD inside, but matrices are still multiplied one by one. Unrolling by 4 only gives
+	// the CPU independent multiplications to overlap, there is no vectorization across matrices.
+	const rtm::matrix3x4f* pInvBindPose = &_SkinInfo->GetInvBindPose(0);
+	const CDirtyBone* pCurr = _DirtyBones.get();
+	const CDirtyBone* pEnd = pCurr + DirtyCount;
+	for (; pCurr + 4 <= pEnd; pCurr += 4)
+	{
+		const rtm::matrix3x4f M0 = rtm::matrix_mul(pInvBindPose[pCurr[0].Index], *pCurr[0].pWorldMatrix);
+		const rtm::matrix3x4f M1 = rtm::matrix_mul(pInvBindPose[pCurr[1].Index], *pCurr[1].pWorldMatrix);
+		const rtm::matrix3x4f M2 = rtm::matrix_mul(pInvBindPose[pCurr[2].Index], *pCurr[2].pWorldMatrix);
+		const rtm::matrix3x4f M3 = rtm::matrix_mul(pInvBindPose[pCurr[3].Index], *pCurr[3].pWorldMatrix);
+		_pSkinPalette[pCurr[0].Index] = M0;
+		_pSkinPalette[pCurr[1].Index] = M1;
+		_pSkinPalette[pCurr[2].Index] = M2;
+		_pSkinPalette[pCurr[3].Index] = M3;
+	}
+	for (; pCurr < pEnd; ++pCurr)
+		_pSkinPalette[pCurr->Index] = rtm::matrix_mul(pInvBindPose[pCurr->Index], *pCurr->pWorldMatrix);
 }
 //---------------------------------------------------------------------
 
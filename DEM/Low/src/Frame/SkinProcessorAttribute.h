@@ -23,9 +23,22 @@ protected:
 		U32 LastTransformVersion = 0;
 	};
 
-	Render::PSkinInfo            _SkinInfo;
-	rtm::matrix3x4f*             _pSkinPalette = nullptr;
-	std::unique_ptr<CBoneInfo[]> _BoneNodes;
+	struct CDirtyBone
+	{
+		UPTR                   Index;
+		const rtm::matrix3x4f* pWorldMatrix;
+	};
+
+	Render::PSkinInfo             _SkinInfo;
+	rtm::matrix3x4f*              _pSkinPalette = nullptr;
+	std::unique_ptr<CBoneInfo[]>  _BoneNodes;
+	std::unique_ptr<CDirtyBone[]> _DirtyBones;     // Scratch list of bones gathered for a batched update
+	UPTR                          _DirtyBegin = 0; // Range of palette matrices changed by the last update
+	UPTR                          _DirtyEnd = 0;
+	U32                           _Version = 0;    // Incremented by each update that changes palette contents, see CModelRenderer
+	bool                          _DirtyRangePublished = false;
+
+	void MarkDirty(UPTR Begin, UPTR End);
 
 public:
 
@@ -38,6 +51,8 @@ public:
 
 	const Render::CSkinInfo* GetSkinInfo() const { return _SkinInfo.Get(); }
 	const rtm::matrix3x4f*   GetSkinPalette() const { return _pSkinPalette; }
+	U32                      GetVersion() const { return _Version; }
+	bool                     GetDirtyRange(UPTR& Begin, UPTR& End) const { Begin = _DirtyBegin; End = _DirtyEnd; return Begin < End; }
 };
 
 using PSkinPalette = Ptr<CSkinPalette>;
@@ -18,8 +18,10 @@
 #include <Scene/SceneNode.h>
 #include <Debug/DebugDraw.h>
 #include <Data/Algorithms.h>
+#if DEM_UI_CEGUI
 #include <UI/UIContext.h>
 #include <UI/UIServer.h>
+#endif
 #include <System/OSWindow.h>
 #include <System/SystemEvents.h>
 #include <Core/Application.h>
@@ -92,7 +94,7 @@ CView::CView(CGraphicsResourceManager& GraphicsMgr, CStrID RenderPathID, int Swa
 	_RenderPath = GraphicsMgr.GetRenderPath(RenderPathID);
 	if (!_RenderPath)
 	{
-		::Sys::Error("CView() > no render path with ID " + RenderPathID);
+		::Sys::Error("CView() > no render path with ID " + RenderPathID.ToString());
 		return;
 	}
 
@@ -134,9 +136,11 @@ CView::CView(CGraphicsResourceManager& GraphicsMgr, CStrID RenderPathID, int Swa
 
 	// Index zero is always an invalid renderer, e.g. for unknown renderable types
 	_Renderers.push_back(nullptr);
+	_RendererSettingIndices.push_back(0);
 
-	for (const auto& RendererSettings : _RenderPath->_RendererSettings)
+	for (size_t i = 0; i < _RenderPath->_RendererSettings.size(); ++i)
 	{
+		const auto& RendererSettings = _RenderPath->_RendererSettings[i];
 		Render::PRenderer Renderer(static_cast<Render::IRenderer*>(RendererSettings.pRendererType->CreateInstance()));
 		if (!Renderer || !Renderer->Init(*RendererSettings.SettingsDesc, *GraphicsMgr.GetGPU())) continue;
 
@@ -144,6 +148,7 @@ CView::CView(CGraphicsResourceManager& GraphicsMgr, CStrID RenderPathID, int Swa
 			_RenderersByRenderableType.emplace(pRTTI, static_cast<U8>(_Renderers.size()));
 
 		_Renderers.push_back(std::move(Renderer));
+		_RendererSettingIndices.push_back(i);
 	}
 
 	// Create render queues used by this render path
@@ -160,7 +165,7 @@ CView::CView(CGraphicsResourceManager& GraphicsMgr, CStrID RenderPathID, int Swa
 			_RenderQueues[Index] = std::make_unique<Render::CRenderQueue<CMaterialKey32>>(ENUM_MASK(Render::EEffectType::EffectType_Opaque));
 		else if (Type == "AlphaTestDepthPrePass")
 			// FIXME: also would benefit from FtB sorting here, see CAlphaTestDepthPrePass64, but can't use on 32-bit!
-			// FIXME: virtual type of the queue must not depend on the key size! Now only Render::PRenderQueueBaseT_<UPTR>_ stop us from using 64 bit key!
+			// FIXME: virtual type of the queue must not depend on the key size! Now only Render::PRenderQueueBaseT_<U32>_ stop us from using 64 bit key!
 			_RenderQueues[Index] = std::make_unique<Render::CRenderQueue<CMaterialKey32>>(ENUM_MASK(Render::EEffectType::EffectType_AlphaTest));
 		else if (Type == "OpaqueMaterial")
 			_RenderQueues[Index] = std::make_unique<Render::CRenderQueue<CMaterialKey32>>(ENUM_MASK(Render::EEffectType::EffectType_Opaque, Render::EEffectType::EffectType_Skybox));
@@ -186,6 +191,7 @@ bool CView::CreateUIContext(CStrID RenderTargetID)
 {
 	ZoneScoped;
 
+#if DEM_UI_CEGUI
 	auto* pUI = _GraphicsMgr->GetUI();
 	if (!pUI || RTs.empty()) FAIL;
 
@@ -209,6 +215,9 @@ bool CView::CreateUIContext(CStrID RenderTargetID)
 		(pRT == pSwapChainRT) ? GetTargetWindow() : nullptr);
 
 	return _UIContext.IsValidPtr();
+#else
+	FAIL;
+#endif
 }
 //---------------------------------------------------------------------
 
@@ -373,6 +382,41 @@ bool CView::PrecreateRenderObjects()
 }
 //---------------------------------------------------------------------
 
+// Creates additional instances of all renderers, so that each parallel recording job has its own
+// renderer state. Set 0 is the main one. Must be called from the thread that owns the GPU.
+bool CView::PrepareRendererSets(UPTR Count)
+{
+	if (Count <= GetRendererSetCount()) return true;
+
+	auto pGPU = GetGPU();
+	if (!pGPU) return false;
+
+	ZoneScoped;
+
+	_ExtraRendererSets.reserve(Count - 1);
+	while (GetRendererSetCount() < Count)
+	{
+		auto& Set = _ExtraRendererSets.emplace_back();
+		Set.reserve(_Renderers.size());
+		Set.push_back(nullptr);
+		for (size_t i = 1; i < _Renderers.size(); ++i)
+		{
+			const auto& RendererSettings = _RenderPath->_RendererSettings[_RendererSettingIndices[i]];
+			Render::PRenderer Renderer(static_cast<Render::IRenderer*>(RendererSettings.pRendererType->CreateInstance()));
+			if (!Renderer || !Renderer->Init(*RendererSettings.SettingsDesc, *pGPU))
+			{
+				_ExtraRendererSets.pop_back();
+				return false;
+			}
+
+			Set.push_back(std::move(Renderer));
+		}
+	}
+
+	return true;
+}
+//---------------------------------------------------------------------
+
 U32 CView::RegisterEffect(const Render::CEffect& Effect, CStrID InputSet)
 {
 	// View only tracks unique combinations of a source material and an input set. Passes may
@@ -419,7 +463,9 @@ void CView::Update(float dt)
 	ZoneScoped;
 
 	if (_GraphicsMgr) _GraphicsMgr->Update(dt);
+#if DEM_UI_CEGUI
 	if (_UIContext) _UIContext->Update(dt);
+#endif
 }
 //---------------------------------------------------------------------
 
@@ -453,7 +499,10 @@ bool CView::UpdateCameraFrustum()
 
 	// NB: must be normalized for correct sphere culling
 	if (ViewProjChanged)
-		_LastViewFrustum = Math::NormalizeFrustum(Math::CalcFrustumParams(_pCamera->GetViewProjMatrix()));
+	{
+		_LastViewFrustum = Math::CalcFrustumParams(_pCamera->GetViewProjMatrix());
+		Math::NormalizeFrustum(_LastViewFrustum);
+	}
 
 	return ViewProjChanged;
 }
@@ -601,7 +650,7 @@ void CView::UpdateRenderables(bool ViewProjChanged)
 			// Calculate LOD prerequisites. They depend only on camera and object bounds.
 			if (pRenderable->IsVisible)
 			{
-				pRenderable->DistanceToCamera = std::sqrtf(Math::SqDistancePointAABB(_EyePos, Record.Box.Center, Record.Box.Extent));
+				pRenderable->DistanceToCamera = std::sqrt(Math::SqDistancePointAABB(_EyePos, Record.Box.Center, Record.Box.Extent));
 				pRenderable->RelScreenRadius = _ScreenMultiple * rtm::vector_get_w(Record.Sphere) / std::max<float>(rtm::vector_distance3(_EyePos, Record.Box.Center), 1.0f);
 			}
 		}
@@ -971,7 +1020,15 @@ bool CView::Render()
 
 	DEM_RENDER_EVENT_SCOPED(GetGPU(), std::wstring(_DebugName.begin(), _DebugName.end()).c_str());
 
-	return _RenderPath->Render(*this);
+	// Renderer stats are per frame. Parallel phases spread instances over renderer sets, so they are summed.
+	ForEachRenderer([](Render::IRenderer& Renderer) { Renderer.ResetStats(); });
+
+	const bool Result = _RenderPath->Render(*this);
+
+	_RenderStats = {};
+	ForEachRenderer([this](Render::IRenderer& Renderer) { Renderer.AccumulateStats(_RenderStats); });
+
+	return Result;
 }
 //---------------------------------------------------------------------
 
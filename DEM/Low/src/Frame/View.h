@@ -72,13 +72,18 @@ protected:
 
 	CGraphicsScene*								_pScene = nullptr;
 
+#if DEM_UI_CEGUI
 	UI::PUIContext								_UIContext;
+#endif
 	Debug::PDebugDraw                           _DebugDraw;
 
 	std::map<CStrID, Render::PRenderTarget>        RTs;
 	std::map<CStrID, Render::PDepthStencilBuffer>  DSBuffers;
-	std::vector<Render::PRenderQueueBaseT<UPTR>>   _RenderQueues;
+	std::vector<Render::PRenderQueueBaseT<U32>>    _RenderQueues;
 	std::vector<Render::PRenderer>                 _Renderers;
+	std::vector<std::vector<Render::PRenderer>>    _ExtraRendererSets;   // Renderer instances for parallel command recording
+	Render::CRenderStats                           _RenderStats;         // Summed over all renderer sets for the last rendered frame
+	std::vector<size_t>                            _RendererSettingIndices; // For creating extra renderer instances
 	std::map<const DEM::Core::CRTTI*, U8>               _RenderersByRenderableType;
 
 	std::vector<bool>                              _SpatialTreeNodeVisibility;
@@ -112,6 +117,17 @@ protected:
 	void UpdateLights(bool ViewProjChanged);
 	void UploadLightsToGPU();
 
+	// Visits renderers of all sets, index 0 is always empty
+	template<typename TCallback>
+	void ForEachRenderer(TCallback Callback)
+	{
+		for (size_t i = 1; i < _Renderers.size(); ++i)
+			if (_Renderers[i]) Callback(*_Renderers[i]);
+		for (auto& Set : _ExtraRendererSets)
+			for (size_t i = 1; i < Set.size(); ++i)
+				if (Set[i]) Callback(*Set[i]);
+	}
+
 public:
 
 	struct CPickInfo : public CGPURenderablePicker::CPickInfo
@@ -160,6 +176,10 @@ public:
 	const Render::CTechnique* const* GetShaderTechCache(UPTR OverrideIndex = 0) const { return (OverrideIndex < _ShaderTechCache.size()) ? _ShaderTechCache[OverrideIndex].data() : nullptr; }
 	const Render::CTechnique* const* GetGPUPickShaderTechCache() const { return GetShaderTechCache(_GPUPickerShaderTechCacheIndex); }
 	Render::IRenderer*              GetRenderer(U8 Index) const { n_assert_dbg(Index < _Renderers.size()); return _Renderers[Index].get(); }
+	Render::IRenderer*              GetRenderer(U8 Index, UPTR SetIndex) const { return SetIndex ? _ExtraRendererSets[SetIndex - 1][Index].get() : GetRenderer(Index); }
+	bool                            PrepareRendererSets(UPTR Count);
+	UPTR                            GetRendererSetCount() const { return _ExtraRendererSets.size() + 1; }
+	const Render::CRenderStats&     GetRenderStats() const { return _RenderStats; }
 	Render::IRenderable*			GetRenderable(UPTR UID) const { auto It = _Renderables.find(UID); return (It == _Renderables.cend()) ? nullptr : It->second.get(); }
 	Render::CLight*			        GetLight(UPTR UID) const { auto It = _Lights.find(UID); return (It == _Lights.cend()) ? nullptr : It->second.get(); }
 
@@ -170,6 +190,15 @@ public:
 			_RenderQueues[QueueIndex]->ForEachRenderable(Callback);
 	}
 
+	template<typename TCallback>
+	DEM_FORCE_INLINE void ForEachRenderableInQueue(U32 QueueIndex, size_t Start, size_t End, TCallback Callback)
+	{
+		if (QueueIndex < _RenderQueues.size() && _RenderQueues[QueueIndex])
+			_RenderQueues[QueueIndex]->ForEachRenderable(Start, End, Callback);
+	}
+
+	size_t GetRenderableCountInQueue(U32 QueueIndex) const { return (QueueIndex < _RenderQueues.size() && _RenderQueues[QueueIndex]) ? _RenderQueues[QueueIndex]->GetCount() : 0; }
+
 	void                            Update(float dt);
 	bool							Render();
 	bool							Present() const;
@@ -188,7 +217,11 @@ public:
 	const Math::CSIMDFrustum&       GetViewFrustum() const { return _LastViewFrustum; }
 	CGraphicsResourceManager*		GetGraphicsManager() const;
 	Render::CGPUDriver*				GetGPU() const;
+#if DEM_UI_CEGUI
 	UI::CUIContext*                 GetUIContext() const { return _UIContext.Get(); }
+#else
+	UI::CUIContext*                 GetUIContext() const { return nullptr; }
+#endif
 	Debug::CDebugDraw*              GetDebugDrawer() const { return _DebugDraw.get(); }
 	DEM::Sys::COSWindow*			GetTargetWindow() const;
 	Render::PDisplayDriver			GetTargetDisplay() const;
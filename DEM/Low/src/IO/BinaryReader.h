@@ -34,15 +34,6 @@ public:
 	T					Read() { T Val; n_assert(Read<T>(Val)); return Val; }
 	template<class T>
 	bool				Read(T& OutValue) { return Stream.Read(&OutValue, sizeof(T)) == sizeof(T); }
-	template<> bool		Read<char*>(char*& OutValue) { return ReadString(OutValue); }
-	template<> bool		Read<std::string>(std::string& OutValue) { return ReadString(OutValue); }
-	template<> bool		Read<CStrID>(CStrID& OutValue);
-	template<> bool		Read<Data::CDataArray>(Data::CDataArray& OutValue) { return ReadDataArray(OutValue); }
-	template<> bool		Read<Data::PDataArray>(Data::PDataArray& OutValue) { return OutValue.IsValidPtr() ? ReadDataArray(*OutValue) : true; }
-	//template<> bool		Read<CParams>(const CParams& OutValue) { return WriteParams(OutValue); }
-	//template<> bool		Read<PParams>(const PParams& OutValue) { return OutValue.IsValid() ? Read(*OutValue) : true; }
-	//template<> bool		Read<CParam>(const CParam& OutValue) { return WriteParam(OutValue); }
-	template<> bool		Read<Data::CData>(Data::CData& OutValue) { return ReadData(OutValue); }
 
 	/*
 	template<typename U>
@@ -70,6 +61,14 @@ public:
 	IStream& GetStream() const { return Stream; }
 };
 
+// Explicit specializations are not allowed at class scope by the standard
+template<> inline bool CBinaryReader::Read<char*>(char*& OutValue) { return ReadString(OutValue); }
+template<> inline bool CBinaryReader::Read<std::string>(std::string& OutValue) { return ReadString(OutValue); }
+template<> inline bool CBinaryReader::Read<Data::CDataArray>(Data::CDataArray& OutValue) { return ReadDataArray(OutValue); }
+template<> inline bool CBinaryReader::Read<Data::PDataArray>(Data::PDataArray& OutValue) { return OutValue.IsValidPtr() ? ReadDataArray(*OutValue) : true; }
+template<> inline bool CBinaryReader::Read<Data::CData>(Data::CData& OutValue) { return ReadData(OutValue); }
+//---------------------------------------------------------------------
+
 template<> inline bool CBinaryReader::Read<CStrID>(CStrID& OutValue)
 {
 	char Buffer[512]; // Some sane size. Can use ReadString(char*&) to allocate dynamically.
@@ -33,23 +33,12 @@ public:
 	bool				WriteString(const std::string& Value);
 	bool				WriteParams(const Data::CParams& Value);
 	bool				WriteParams(const Data::CParams& Value, const Data::CDataScheme& Scheme, const std::map<CStrID, Data::PDataScheme>& Schemes) { UPTR Dummy; return WriteParamsByScheme(Value, Scheme, Schemes, Dummy); }
-	bool				WriteParam(const Data::CParam& Value) { return Write(Value.GetName()) && Write(Value.GetRawValue()); }
+	bool				WriteParam(const Data::CParam& Value);
 	bool				WriteData(const Data::CData& Value);
-	bool				WriteVoidData() { return Write<U8>(INVALID_TYPE_ID); }
+	bool				WriteVoidData();
 
 	template<class T>
 	bool				Write(const T& Value) { return Stream.Write(&Value, sizeof(T)) == sizeof(T); }
-	template<> bool		Write<char*>(char* const& Value) { return WriteString(Value); }
-	template<> bool		Write<const char*>(const char* const& Value) { return WriteString(Value); }
-	template<> bool		Write<std::string>(const std::string& Value) { return WriteString(Value); }
-	template<> bool		Write<CStrID>(const CStrID& Value) { return WriteString(Value.CStr()); }
-	template<> bool		Write<Data::CParams>(const Data::CParams& Value) { return WriteParams(Value); }
-	template<> bool		Write<Data::PParams>(const Data::PParams& Value) { return !Value || WriteParams(*Value); }
-	template<> bool		Write<Data::CParam>(const Data::CParam& Value) { return WriteParam(Value); }
-	template<> bool		Write<Data::CData>(const Data::CData& Value) { return WriteData(Value); }
-	template<> bool		Write<Data::CDataArray>(const Data::CDataArray& Value);
-	template<> bool		Write<Data::PDataArray>(const Data::PDataArray& Value) { return !Value || Write<Data::CDataArray>(*Value); }
-	template<> bool		Write<Data::CBufferMalloc>(const Data::CBufferMalloc& Value);
 
 	/*
 	template<typename U>
@@ -66,6 +55,32 @@ public:
 	IStream& GetStream() const { return Stream; }
 };
 
+// Explicit specializations are not allowed at class scope by the standard
+template<> inline bool CBinaryWriter::Write<char*>(char* const& Value) { return WriteString(Value); }
+template<> inline bool CBinaryWriter::Write<const char*>(const char* const& Value) { return WriteString(Value); }
+template<> inline bool CBinaryWriter::Write<std::string>(const std::string& Value) { return WriteString(Value); }
+template<> inline bool CBinaryWriter::Write<CStrID>(const CStrID& Value) { return WriteString(Value.CStr()); }
+template<> inline bool CBinaryWriter::Write<Data::CParams>(const Data::CParams& Value) { return WriteParams(Value); }
+template<> inline bool CBinaryWriter::Write<Data::PParams>(const Data::PParams& Value) { return !Value || WriteParams(*Value); }
+template<> inline bool CBinaryWriter::Write<Data::CParam>(const Data::CParam& Value) { return WriteParam(Value); }
+template<> inline bool CBinaryWriter::Write<Data::CData>(const Data::CData& Value) { return WriteData(Value); }
+template<> bool CBinaryWriter::Write<Data::CDataArray>(const Data::CDataArray& Value);
+template<> inline bool CBinaryWriter::Write<Data::PDataArray>(const Data::PDataArray& Value) { return !Value || Write<Data::CDataArray>(*Value); }
+template<> bool CBinaryWriter::Write<Data::CBufferMalloc>(const Data::CBufferMalloc& Value);
+//---------------------------------------------------------------------
+
+inline bool CBinaryWriter::WriteParam(const Data::CParam& Value)
+{
+	return Write(Value.GetName()) && Write(Value.GetRawValue());
+}
+//---------------------------------------------------------------------
+
+inline bool CBinaryWriter::WriteVoidData()
+{
+	return Write<U8>(INVALID_TYPE_ID);
+}
+//---------------------------------------------------------------------
+
 inline bool CBinaryWriter::WriteString(const char* Value)
 {
 	short Len = Value ? (short)strlen(Value) : 0;
@@ -39,7 +39,7 @@ bool CHRDWriter::WriteData(const Data::CData& Value)
 	if (Value.IsVoid()) WRITE_STATIC_STRING("null")
 	else if (Value.IsA<bool>())
 	{
-		if ((bool)Value) WRITE_STATIC_STRING("true")
+		if (Value.GetValue<bool>()) WRITE_STATIC_STRING("true")
 		else WRITE_STATIC_STRING("false")
 	}
 	else if (Value.IsA<int>()) WRITE_NSTRING(StringUtils::ToString(Value))
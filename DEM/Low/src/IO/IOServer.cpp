@@ -89,7 +89,7 @@ const char* CIOServer::GetFSLocalPath(const CFSRecord& Rec, const char* pPath, s
 		}
 		else
 		{
-			if (_strnicmp(Rec.RootPath.c_str(), pLocalPath, RootPathLen)) return nullptr;
+			if (n_strnicmp(Rec.RootPath.c_str(), pLocalPath, RootPathLen)) return nullptr;
 		}
 		pLocalPath += RootPathLen;
 	}
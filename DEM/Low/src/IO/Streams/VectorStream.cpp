@@ -0,0 +1,64 @@
+#include "VectorStream.h"
+#include <Data/Buffer.h>
+#include <algorithm>
+#include <cstring>
+
+namespace IO
+{
+
+UPTR CVectorStream::Read(void* pData, UPTR Size)
+{
+	const UPTR BytesToRead = std::min(Size, _Size - _Pos);
+	if (BytesToRead > 0)
+	{
+		std::memcpy(pData, _Data.data() + _Pos, BytesToRead);
+		_Pos += BytesToRead;
+	}
+	return BytesToRead;
+}
+//---------------------------------------------------------------------
+
+UPTR CVectorStream::Write(const void* pData, UPTR Size)
+{
+	if (!Size) return 0;
+
+	const auto NewPos = _Pos + Size;
+	if (NewPos > _Data.size())
+		_Data.resize(std::max<UPTR>(NewPos, std::max<UPTR>(64, _Data.size() * 2)));
+
+	std::memcpy(_Data.data() + _Pos, pData, Size);
+	_Pos = NewPos;
+	if (_Pos > _Size) _Size = _Pos;
+
+	return Size;
+}
+//---------------------------------------------------------------------
+
+bool CVectorStream::Seek(I64 Offset, ESeekOrigin Origin)
+{
+	I64 SeekPos;
+	switch (Origin)
+	{
+		case Seek_Begin:   SeekPos = Offset; break;
+		case Seek_Current: SeekPos = _Pos + Offset; break;
+		case Seek_End:     SeekPos = _Size + Offset; break;
+		default:           ::Sys::Error("CVectorStream::Seek() > unknown ESeekOrigin");
+	}
+	_Pos = static_cast<UPTR>(std::clamp<I64>(SeekPos, 0, _Size));
+	return _Pos == SeekPos;
+}
+//---------------------------------------------------------------------
+
+Data::PBuffer CVectorStream::ReadAll()
+{
+	if (IsEOF()) return nullptr;
+
+	const auto Size = _Size - _Pos;
+	auto Buffer = std::make_unique<Data::CBufferMalloc>(Size);
+	Read(Buffer->GetPtr(), Size);
+
+	return Buffer;
+}
+//---------------------------------------------------------------------
+
+}
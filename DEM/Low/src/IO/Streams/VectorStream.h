@@ -0,0 +1,54 @@
+#pragma once
+#include <IO/Stream.h>
+#include <vector>
+#include <algorithm>
+
+// Growable RAM stream for building temporary binary data. Keeps its capacity on Clear(), so
+// a long living instance stops allocating after warming up. Unlike CMemStream, the storage grows
+// geometrically, and discarding the written tail with SetSize() is just a size change.
+
+namespace IO
+{
+
+class CVectorStream: public IStream
+{
+protected:
+
+	std::vector<U8> _Data;
+	UPTR            _Size = 0; // Size of written data, the vector is never shrunk
+	UPTR            _Pos = 0;
+
+public:
+
+	CVectorStream(UPTR InitialCapacity = 0) { _Data.resize(InitialCapacity); }
+
+	void            Clear() { _Size = 0; _Pos = 0; }
+	void            SetSize(UPTR Size) { n_assert_dbg(Size <= _Size); _Size = Size; _Pos = std::min(_Pos, _Size); }
+	const U8*       GetPtr() const { return _Data.data(); }
+	UPTR            GetCapacity() const { return _Data.size(); }
+
+	virtual void	Close() override { Clear(); }
+	virtual UPTR	Read(void* pData, UPTR Size) override;
+	virtual UPTR	Write(const void* pData, UPTR Size) override;
+	virtual bool	Seek(I64 Offset, ESeekOrigin Origin) override;
+	virtual U64		Tell() const override { return _Pos; }
+	virtual bool    Truncate() override { _Size = _Pos; OK; }
+	virtual void	Flush() override {}
+	virtual void*	Map() override { return _Data.data(); }
+	virtual void	Unmap() override {}
+
+	virtual U64		GetSize() const override { return _Size; }
+	virtual bool	IsOpened() const override { OK; }
+	virtual bool    IsMapped() const override { return false; }
+	virtual bool	IsEOF() const override { return _Pos >= _Size; }
+	virtual bool	CanRead() const override { OK; }
+	virtual bool	CanWrite() const override { OK; }
+	virtual bool	CanSeek() const override { OK; }
+	virtual bool	CanBeMapped() const override { OK; }
+
+	virtual Data::PBuffer ReadAll() override;
+};
+
+typedef Ptr<CVectorStream> PVectorStream;
+
+}
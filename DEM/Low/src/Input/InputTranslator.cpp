@@ -13,6 +13,10 @@ CInputTranslator::CInputTranslator(CStrID UserID)
 }
 //---------------------------------------------------------------------
 
+// Defined here, because CControlLayout is incomplete in the header
+CInputTranslator::~CInputTranslator() = default;
+//---------------------------------------------------------------------
+
 void CInputTranslator::Clear()
 {
 	_Contexts.clear();
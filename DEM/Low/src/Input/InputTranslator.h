@@ -43,7 +43,7 @@ private:
 public:
 
 	CInputTranslator(CStrID UserID);
-	virtual ~CInputTranslator() override = default;
+	virtual ~CInputTranslator() override;
 
 	bool			LoadSettings(const Data::CParams& Desc);
 	bool			UpdateParams(const DEM::Core::CApplication& App, std::set<std::string>* pOutParams = nullptr);
@@ -45,6 +45,12 @@ void CWorker::CancelJob(CJob* pJob)
 }
 //---------------------------------------------------------------------
 
+void CWorker::MainLoop()
+{
+	MainLoop([]() { return false; });
+}
+//---------------------------------------------------------------------
+
 // Active waiting. The worker thread is allowed to pick and execute independent jobs while waiting on the counter.
 // TODO: could use fibers to move the current job into a wait list in the middle of its execution
 // with CJobSystem::StartWaiting() and continue the main loop without recursion
@@ -2,6 +2,7 @@
 #include "WorkStealingQueue.h"
 #include <System/Allocators/HalfSafePool.h>
 #include <Math/WELL512.h>
+#include <condition_variable>
 
 // Implements a worker thread logic. After construction, all its fields and methods must be accessed
 // from the corresponding worker thread only unless explicitly stated otherwise.
@@ -87,131 +88,12 @@ protected:
 
 	// Implements https://taskflow.github.io/taskflow/icpads20.pdf with some changes
 	template<typename TPred>
-	void MainLoop(TPred ExitPred)
-	{
-		const size_t ThreadCount = _pOwner->GetWorkerThreadCount();
-		const size_t MaxStealsBeforeYield = 2 * (ThreadCount + 1);
-		const size_t MaxStealAttempts = MaxStealsBeforeYield * 64;
-
-		// PERF: WELL512 is slightly faster in my local tests
-		//std::default_random_engine VictimRNG{ std::random_device{}() };
-		Math::CWELL512 VictimRNG{ std::random_device{}() };
-		std::uniform_int_distribution<size_t> GetRandomVictim(0, ThreadCount - 2); // Exclude the current worker from the range, see generation below
-		size_t Victim = ThreadCount; // Start stealing from the main thread
-
-		// Main loop of the worker thread implements a state-machine of 3 states: local queue loop, stealing loop and sleeping.
-		while (true)
-		{
-			// Process the local queue until it is empty or until termination is requested
-			while (true)
-			{
-				if (ExitPred()) return;
-
-				CJob* pJob = PopJob();
-
-				if (_pOwner->IsTerminationRequested())
-				{
-					CancelJob(pJob);
-					return;
-				}
-
-				if (!pJob) break;
-
-				DoJob(*pJob);
-			}
-
-			// Try stealing from random victims
-			while (true)
-			{
-				CJob* pJob = nullptr;
-				size_t StealsWithoutYield = 0;
-				for (size_t StealAttempts = 0; StealAttempts < MaxStealAttempts; ++StealAttempts)
-				{
-					if (ExitPred()) return;
-
-					pJob = _pOwner->GetWorker(static_cast<uint8_t>(Victim)).Steal(_JobTypeMask);
-
-					if (_pOwner->IsTerminationRequested())
-					{
-						CancelJob(pJob);
-						return;
-					}
-
-					if (pJob) break;
-
-					if (++StealsWithoutYield >= MaxStealsBeforeYield)
-					{
-						StealsWithoutYield = 0;
-						std::this_thread::yield();
-					}
-
-					// Steal attempt to the current victim has failed, try another one. Skip our index.
-					Victim = GetRandomVictim(VictimRNG);
-					if (Victim >= _Index) ++Victim;
-				}
-
-				// There is a big chance that randomization will not return us the index of the thread that has jobs to steal.
-				// As a last resort, try to scan all workers including a main thread worker. This is especially helpful when there are many workers.
-				if (!pJob)
-				{
-					// TODO: start from the main thread?
-					for (uint8_t i = 0; i <= ThreadCount; ++i)
-					{
-						if (i == _Index) continue;
-						pJob = _pOwner->GetWorker(i).Steal(_JobTypeMask);
-						if (pJob) break;
-					}
-				}
-
-				if (pJob)
-				{
-					// We have stolen a job an will be busy, wake up one more worker to continue stealing jobs
-					_pOwner->WakeUpWorker();
-
-					// Do the job and return to the local queue loop because this job might push new jobs to it
-					DoJob(*pJob);
-					break;
-				}
-				else
-				{
-					// This store must not be reordered past the sleep condition evaluation. Otherwise a condition may
-					// be evaluated to true, then WakeUp() will preempt us, read "waiting is false" and skip notification.
-					// This thread will resume and start waiting on CV. This results in a missing wakeup. Making sure that the
-					// waiting flag is set before eliminates this case. We either see "waiting is true" and send notification
-					// or we skip notification due to "waiting is false" but sleep condition will detect new jobs, if any.
-					_pOwner->SetWorkerWaitingJob(_Index);
-
-					// No jobs to steal, go to sleep. After waking up the worker returns to stealing because no one could push jobs into its local queue.
-					// TODO PERF C++20: wait on atomic?!
-					bool NeedExit = false;
-					{
-						std::unique_lock Lock(_WaitJobsMutex);
-
-						NeedExit = ExitPred() || _pOwner->IsTerminationRequested(true);
-						while (!NeedExit && !_pOwner->HasJobs(_JobTypeMask))
-						{
-							_WaitJobsCV.wait(Lock);
-							NeedExit = ExitPred() || _pOwner->IsTerminationRequested(true);
-						}
-
-						_pOwner->SetWorkerNotWaitingJob(_Index);
-					}
-
-					// We could have been woken up because of termination request, let's check immediately
-					if (NeedExit) return;
-
-					// We don't know who has sent a signal, start stealing from the main thread.
-					// This is a good choice because the main thread is the most likely to have new jobs.
-					Victim = ThreadCount;
-				}
-			}
-		}
-	}
+	void MainLoop(TPred ExitPred);
 
 public:
 
 	void Init(CJobSystem& Owner, std::string Name, uint8_t Index, uint8_t JobTypeMask = ~0);
-	void MainLoop() { MainLoop([]() { return false; }); }
+	void MainLoop();
 	void WaitActive(CJobCounter Counter);
 	void WaitIdle(CJobCounter Counter);
 
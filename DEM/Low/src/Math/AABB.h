@@ -1,6 +1,6 @@
 #pragma once
 #include <Math/Matrix44.h>
-#include <Math/plane.h>
+#include <Math/Plane.h>
 #include <System/System.h>
 #include <algorithm>
 
@@ -13,7 +13,7 @@
                            Fix of #263
 */
 #include "Math/Matrix44.h"
-#include "Math/euler.h"
+#include "Math/Euler.h"
 
 //-------------------------------------------------------------------
 class nEulerAngles {
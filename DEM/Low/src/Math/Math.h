@@ -1,5 +1,5 @@
 #pragma once
-#include <StdDEM.h>
+#include <System/System.h>
 #include <math.h>
 #include <type_traits>
 
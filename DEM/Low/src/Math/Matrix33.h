@@ -10,9 +10,9 @@
 
     (C) 2002 RadonLabs GmbH
 */
-#include <Math/vector3.h>
-#include <Math/vector2.h>
-#include <Math/euler.h>
+#include <Math/Vector3.h>
+#include <Math/Vector2.h>
+#include <Math/Euler.h>
 #include <Math/MatrixDefs.h>
 #include <Math/Quaternion.h>
 #include <memory.h>
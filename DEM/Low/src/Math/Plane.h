@@ -1,7 +1,7 @@
 #ifndef N_PLANE_H
 #define N_PLANE_H
 
-#include <Math/line.h>
+#include <Math/Line.h>
 
 // A plane in 3d space
 // (C) 2004 RadonLabs GmbH
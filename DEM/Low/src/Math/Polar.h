@@ -26,7 +26,7 @@ public:
 	bool	IsEqual(const CPolar& Other, float Tolerance) const;
 
 	// Rotate by Theta around x (inclination), than by Phi around y (azimuth), then get y axis
-	rtm::vector4f RTM_SIMD_CALL CPolar::GetCartesianY() const
+	rtm::vector4f RTM_SIMD_CALL GetCartesianY() const
 	{
 		float SinTheta, CosTheta, SinPhi, CosPhi;
 		n_sincos(Theta, SinTheta, CosTheta);
@@ -35,7 +35,7 @@ public:
 	}
 
 	// Rotate by Theta around x (inclination), than by Phi around y (azimuth), then get z axis
-	rtm::vector4f RTM_SIMD_CALL CPolar::GetCartesianZ() const
+	rtm::vector4f RTM_SIMD_CALL GetCartesianZ() const
 	{
 		float SinTheta, CosTheta, SinPhi, CosPhi;
 		n_sincos(Theta, SinTheta, CosTheta);
@@ -23,8 +23,8 @@ public:
 		//n_sincos(a * 0.5f, sin_a, cos_a);
 
 		const float HalfAngle = 0.5f * a;
-		const float sin_a = std::sinf(HalfAngle);
-		const float cos_a = std::cosf(HalfAngle);
+		const float sin_a = std::sin(HalfAngle);
+		const float cos_a = std::cos(HalfAngle);
 		return quaternion(v.x * sin_a, v.y * sin_a, v.z * sin_a, cos_a);
 	}
 
@@ -60,7 +60,7 @@ public:
 	float GetAngleAroundAxis(const vector3& Axis) const
 	{
 		const float Dot = Axis.x * x + Axis.y * y + Axis.z * z;
-		const float Angle = 2.f * std::atan2f(Dot, w); // [-2PI; 2PI], convert to [-PI; PI]
+		const float Angle = 2.f * std::atan2(Dot, w); // [-2PI; 2PI], convert to [-PI; PI]
 		if (Angle > PI) return Angle - TWO_PI;
 		if (Angle < -PI) return Angle + TWO_PI;
 		return Angle;
@@ -74,7 +74,7 @@ public:
 		return vector3(x * InvLen, y * InvLen, z * InvLen);
 	}
 
-	float GetAngle() const { return 2.f * std::acosf(w); }
+	float GetAngle() const { return 2.f * std::acos(w); }
 
     //-- convert from euler angles ----------------------------------
     void set_rotate_x(float a) { y = 0.f; z = 0.f; n_sincos(a * 0.5f, x, w); }
@@ -236,7 +236,7 @@ static inline quaternion operator *(const quaternion& q0, const quaternion& q1)
 }
 //---------------------------------------------------------------------
 
-template<> static inline void lerp<quaternion>(quaternion& result, const quaternion& val0, const quaternion& val1, float lerpVal)
+template<> inline void lerp<quaternion>(quaternion& result, const quaternion& val0, const quaternion& val1, float lerpVal)
 {
 	result.lerp(val0, val1, lerpVal);
 }
@@ -287,6 +287,8 @@ RTM_MIX_ALIAS_TWO(x, b, c, w);
 
 }
 
+// Operators can be overloaded only for class types, and __m128 is a class only in MSVC
+#if defined(_MSC_VER)
 RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE bool RTM_SIMD_CALL operator ==(rtm::vector4f_arg0 v0, rtm::vector4f_arg1 v1) noexcept
 {
 	return rtm::mask_all_true(rtm::vector_equal(v0, v1));
@@ -298,3 +300,4 @@ RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE bool RTM_SIMD_CALL operator !
 	return !rtm::mask_all_true(rtm::vector_equal(v0, v1));
 }
 //---------------------------------------------------------------------
+#endif
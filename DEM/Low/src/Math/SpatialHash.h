@@ -0,0 +1,101 @@
+#pragma once
+#include <Math/Math.h>
+#include <vector>
+#include <algorithm>
+
+// Uniform spatial hash over the XZ plane for neighbour queries among many moving objects.
+// It is rebuilt from scratch each frame with a counting sort, so there are no per-cell allocations and
+// the world size is unbounded. Different cells may share a bucket, callers must check actual distances.
+
+namespace Math
+{
+
+class CSpatialHash2D
+{
+protected:
+
+	std::vector<U32> _BucketStart; // Range of each bucket in _Items, bucket count + 1 elements
+	std::vector<U32> _Items;       // Item indices grouped by bucket
+	std::vector<U32> _ItemBuckets;
+	float            _CellSize = 1.f;
+	float            _InvCellSize = 1.f;
+	U32              _BucketMask = 0;
+
+	static DEM_FORCE_INLINE U32 HashCell(I32 x, I32 z) { return (static_cast<U32>(x) * 73856093u) ^ (static_cast<U32>(z) * 19349663u); }
+	DEM_FORCE_INLINE I32 GetCell(float Coord) const { return static_cast<I32>(std::floor(Coord * _InvCellSize)); }
+
+public:
+
+	// Positions are passed as GetPosition(Index, OutX, OutZ)
+	template<typename F>
+	void Build(U32 Count, float CellSize, F GetPosition)
+	{
+		ZoneScoped;
+
+		n_assert_dbg(CellSize > 0.f);
+		_CellSize = CellSize;
+		_InvCellSize = 1.f / CellSize;
+
+		const U32 BucketCount = NextPow2(std::max<U32>(Count * 2, 16));
+		_BucketMask = BucketCount - 1;
+		_BucketStart.assign(BucketCount + 1, 0);
+		_Items.resize(Count);
+		_ItemBuckets.resize(Count);
+
+		for (U32 i = 0; i < Count; ++i)
+		{
+			float x, z;
+			GetPosition(i, x, z);
+			const U32 Bucket = HashCell(GetCell(x), GetCell(z)) & _BucketMask;
+			_ItemBuckets[i] = Bucket;
+			++_BucketStart[Bucket + 1];
+		}
+
+		for (U32 i = 1; i <= BucketCount; ++i)
+			_BucketStart[i] += _BucketStart[i - 1];
+
+		// Items in a bucket are sorted by index, which makes queries deterministic. Filling advances
+		// each bucket start to its end, so starts are restored by shifting the array afterwards.
+		for (U32 i = 0; i < Count; ++i)
+			_Items[_BucketStart[_ItemBuckets[i]]++] = i;
+
+		for (U32 i = BucketCount; i > 0; --i)
+			_BucketStart[i] = _BucketStart[i - 1];
+		_BucketStart[0] = 0;
+	}
+
+	// Calls Callback(ItemIndex) for items in cells overlapping the square of half-size Range around the point.
+	// Range must not exceed the cell size, so that at most 3x3 cells are visited.
+	template<typename F>
+	void ForEachInRange(float x, float z, float Range, F Callback) const
+	{
+		if (_Items.empty()) return;
+
+		n_assert_dbg(Range <= _CellSize);
+
+		const I32 MinX = GetCell(x - Range);
+		const I32 MaxX = GetCell(x + Range);
+		const I32 MinZ = GetCell(z - Range);
+		const I32 MaxZ = GetCell(z + Range);
+
+		// Skip buckets already visited from another cell, otherwise items would be reported twice
+		U32 Visited[9];
+		U32 VisitedCount = 0;
+		for (I32 CellZ = MinZ; CellZ <= MaxZ; ++CellZ)
+		{
+			for (I32 CellX = MinX; CellX <= MaxX; ++CellX)
+			{
+				const U32 Bucket = HashCell(CellX, CellZ) & _BucketMask;
+				if (std::find(Visited, Visited + VisitedCount, Bucket) != Visited + VisitedCount) continue;
+				if (VisitedCount < 9) Visited[VisitedCount++] = Bucket;
+
+				for (U32 i = _BucketStart[Bucket]; i < _BucketStart[Bucket + 1]; ++i)
+					Callback(_Items[i]);
+			}
+		}
+	}
+
+	float GetCellSize() const { return _CellSize; }
+};
+
+}
@@ -10,8 +10,8 @@
     (C) 2004 RadonLabs GmbH
 */
 #include "Math/vector.h"
-#include "Math/line.h"
-#include "Math/plane.h"
+#include "Math/Line.h"
+#include "Math/Plane.h"
 
 //-------------------------------------------------------------------
 //  Triangle points are tri(s,t)=b + s*e0 + t*e1 where
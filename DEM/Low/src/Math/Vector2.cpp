@@ -1,3 +1,3 @@
-#include "Math/vector2.h"
+#include "Math/Vector2.h"
 
 const vector2 vector2::zero = vector2();
@@ -164,7 +164,7 @@ static inline vector2 operator -(const vector2& v)
 }
 //---------------------------------------------------------------------
 
-template<> static inline void lerp<vector2>(vector2 & result, const vector2 & val0, const vector2 & val1, float lerpVal)
+template<> inline void lerp<vector2>(vector2 & result, const vector2 & val0, const vector2 & val1, float lerpVal)
 {
 	result.lerp(val0, val1, lerpVal);
 }
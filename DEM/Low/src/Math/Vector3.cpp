@@ -1,6 +1,6 @@
-#include "Math/vector3.h"
+#include "Math/Vector3.h"
 
-#include <Math/vector4.h>
+#include <Math/Vector4.h>
 
 const vector3 vector3::Zero(0.f, 0.f, 0.f);
 const vector3 vector3::One(1.f, 1.f, 1.f);
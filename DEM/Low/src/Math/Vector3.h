@@ -37,7 +37,7 @@ public:
 
 	constexpr vector3(): x(0.f), y(0.f), z(0.f) {}
 	constexpr vector3(const float _x, const float _y, const float _z): x(_x), y(_y), z(_z) {}
-	constexpr vector3(const vector3& vec): x(vec.x), y(vec.y), z(vec.z) {}
+	constexpr vector3(const vector3& vec) noexcept: x(vec.x), y(vec.y), z(vec.z) {}
 	vector3(const vector4& vec);
 	constexpr vector3(const float* vec): x(vec[0]), y(vec[1]), z(vec[2]) {}
 	vector3(rtm::vector4f_arg0 v) : x(rtm::vector_get_x(v)), y(rtm::vector_get_y(v)), z(rtm::vector_get_z(v)) {}
@@ -1,4 +1,4 @@
-#include "Math/vector4.h"
+#include "Math/Vector4.h"
 
 const vector4 vector4::Zero;
 const vector4 vector4::Red(1.f, 0.f, 0.f, 1.f);
@@ -31,9 +31,9 @@ public:
         W = (1<<3),
     };
 
-    constexpr vector4() = default;
+	constexpr vector4() : v{ 0.f, 0.f, 0.f, 0.f } {}
 	constexpr vector4(const float _x, const float _y, const float _z, const float _w) : x(_x), y(_y), z(_z), w(_w) {}
-	constexpr vector4(const vector4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+	constexpr vector4(const vector4& v) noexcept : x(v.x), y(v.y), z(v.z), w(v.w) {}
 	constexpr vector4(const vector3& v, float w_ = 1.f) : x(v.x), y(v.y), z(v.z), w(w_) {}
 	vector4(rtm::vector4f_arg0 v) : x(rtm::vector_get_x(v)), y(rtm::vector_get_y(v)), z(rtm::vector_get_z(v)), w(rtm::vector_get_w(v)) {}
 
@@ -446,7 +446,7 @@ float vector4::dot(const vector4& v0) const
 
 //------------------------------------------------------------------------------
 
-template<> static inline void lerp<vector4>(vector4 & result, const vector4 & val0, const vector4 & val1, float lerpVal)
+template<> inline void lerp<vector4>(vector4 & result, const vector4 & val0, const vector4 & val1, float lerpVal)
 {
 	result.lerp(val0, val1, lerpVal);
 }
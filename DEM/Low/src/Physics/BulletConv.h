@@ -7,14 +7,21 @@
 
 // Bullet physics library to DEM data convertors
 
-// TODO: can compile with errors if RTM and Bullet use different representations. Fix then.
+// Bullet stores SIMD registers only when built with BT_USE_SSE or BT_USE_NEON, otherwise values are copied per component
+#if defined(BT_USE_SSE) || defined(BT_USE_NEON)
+#define DEM_BULLET_SIMD (1)
+#endif
 
 namespace Math
 {
 
 RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE rtm::vector4f FromBullet(const btVector3& v) noexcept
 {
+#if DEM_BULLET_SIMD
 	return rtm::vector4f{ v.get128() };
+#else
+	return rtm::vector_set(v.x(), v.y(), v.z(), v.w());
+#endif
 }
 //---------------------------------------------------------------------
 
@@ -22,22 +29,35 @@ RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE rtm::vector4f FromBullet(cons
 RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE btVector3 ToBullet3(rtm::vector4f_arg0 v) noexcept
 {
 	btVector3 Result;
+#if DEM_BULLET_SIMD
 	Result.set128(v); //??? rtm::vector_set_w(v, 0.f)); - is that w=0 important anywhere in Bullet?
+#else
+	Result.setValue(rtm::vector_get_x(v), rtm::vector_get_y(v), rtm::vector_get_z(v));
+	Result.setW(rtm::vector_get_w(v));
+#endif
 	return Result;
 }
 //---------------------------------------------------------------------
 
 RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE rtm::quatf FromBullet(const btQuaternion& q) noexcept
 {
+#if DEM_BULLET_SIMD
 	return rtm::quatf{ q.get128() };
+#else
+	return rtm::quat_set(q.x(), q.y(), q.z(), q.w());
+#endif
 }
 //---------------------------------------------------------------------
 
 RTM_DISABLE_SECURITY_COOKIE_CHECK RTM_FORCE_INLINE btQuaternion ToBullet(rtm::quatf_arg0 q) noexcept
 {
+#if DEM_BULLET_SIMD
 	btQuaternion Result;
 	Result.set128(q);
 	return Result;
+#else
+	return btQuaternion(rtm::quat_get_x(q), rtm::quat_get_y(q), rtm::quat_get_z(q), rtm::quat_get_w(q));
+#endif
 }
 //---------------------------------------------------------------------
 
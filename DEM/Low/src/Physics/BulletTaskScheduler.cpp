@@ -0,0 +1,100 @@
+#include "BulletTaskScheduler.h"
+#include <Jobs/JobSystem.h>
+
+// Declared in btThreads.cpp but not exported in headers. Nested loops check btThreadsAreRunning() and run serially.
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+
+namespace Physics
+{
+
+CBulletTaskScheduler::CBulletTaskScheduler(DEM::Jobs::CJobSystem& JobSystem)
+	: btITaskScheduler("DEMJobSystem")
+	, _JobSystem(JobSystem)
+{
+}
+//---------------------------------------------------------------------
+
+int CBulletTaskScheduler::getMaxNumThreads() const
+{
+	return static_cast<int>(BT_MAX_THREAD_COUNT);
+}
+//---------------------------------------------------------------------
+
+// Bullet sizes per-thread data by this value, and any thread that runs our jobs takes a Bullet thread index.
+// The thread that created the scheduler is Bullet's main thread with index 0, the rest are job system workers.
+int CBulletTaskScheduler::getNumThreads() const
+{
+	return static_cast<int>(std::min<size_t>(_JobSystem.GetWorkerThreadCount() + 1, BT_MAX_THREAD_COUNT));
+}
+//---------------------------------------------------------------------
+
+bool CBulletTaskScheduler::IsThreadCountSupported() const
+{
+	return _JobSystem.GetWorkerThreadCount() + 1 <= BT_MAX_THREAD_COUNT;
+}
+//---------------------------------------------------------------------
+
+void CBulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+	ZoneScoped;
+
+	const int Count = iEnd - iBegin;
+	grainSize = std::max(grainSize, 1);
+	auto pWorker = _JobSystem.FindCurrentThreadWorker();
+	if (!pWorker || Count <= grainSize)
+	{
+		body.forLoop(iBegin, iEnd);
+		return;
+	}
+
+	btPushThreadsAreRunning();
+
+	DEM::Jobs::CJobCounter Counter;
+	for (int i = iBegin; i < iEnd; i += grainSize)
+	{
+		const int End = std::min(i + grainSize, iEnd);
+		pWorker->AddJob(Counter, [&body, i, End]() { body.forLoop(i, End); });
+	}
+	pWorker->WaitActive(Counter);
+
+	btPopThreadsAreRunning();
+}
+//---------------------------------------------------------------------
+
+btScalar CBulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+{
+	ZoneScoped;
+
+	const int Count = iEnd - iBegin;
+	grainSize = std::max(grainSize, 1);
+	auto pWorker = _JobSystem.FindCurrentThreadWorker();
+	if (!pWorker || Count <= grainSize)
+		return body.sumLoop(iBegin, iEnd);
+
+	btPushThreadsAreRunning();
+
+	// Partial sums are added in chunk order, so the result doesn't depend on job timing
+	const int ChunkCount = (Count + grainSize - 1) / grainSize;
+	std::vector<btScalar> Sums(ChunkCount);
+
+	DEM::Jobs::CJobCounter Counter;
+	for (int Chunk = 0; Chunk < ChunkCount; ++Chunk)
+	{
+		const int Begin = iBegin + Chunk * grainSize;
+		const int End = std::min(Begin + grainSize, iEnd);
+		btScalar* pSum = &Sums[Chunk];
+		pWorker->AddJob(Counter, [&body, Begin, End, pSum]() { *pSum = body.sumLoop(Begin, End); });
+	}
+	pWorker->WaitActive(Counter);
+
+	btPopThreadsAreRunning();
+
+	btScalar Sum = 0.f;
+	for (int Chunk = 0; Chunk < ChunkCount; ++Chunk)
+		Sum += Sums[Chunk];
+	return Sum;
+}
+//---------------------------------------------------------------------
+
+}
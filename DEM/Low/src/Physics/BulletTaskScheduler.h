@@ -0,0 +1,37 @@
+#pragma once
+#include <StdDEM.h>
+#include <LinearMath/btThreads.h>
+
+// Bullet task scheduler that runs btParallelFor and btParallelSum loops as engine jobs instead of
+// Bullet's own thread pool, so that physics shares worker threads with the rest of the engine.
+// Loops are split on the worker of the calling thread. Calls from threads outside the job system run serially.
+
+namespace DEM::Jobs
+{
+	class CJobSystem;
+}
+
+namespace Physics
+{
+
+class CBulletTaskScheduler : public btITaskScheduler
+{
+protected:
+
+	DEM::Jobs::CJobSystem& _JobSystem;
+
+public:
+
+	CBulletTaskScheduler(DEM::Jobs::CJobSystem& JobSystem);
+
+	virtual int      getMaxNumThreads() const override;
+	virtual int      getNumThreads() const override;
+	virtual void     setNumThreads(int numThreads) override {} // Thread count is controlled by the job system
+	virtual void     parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+	virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+	bool             IsThreadCountSupported() const;
+	DEM::Jobs::CJobSystem& GetJobSystem() const { return _JobSystem; }
+};
+
+}
@@ -2,22 +2,37 @@
 #include <Physics/BulletConv.h>
 #include <Physics/TickListener.h>
 #include <Physics/PhysicsObject.h>
+#include <Physics/RigidBody.h>
 #include <Physics/PhysicsDebugDraw.h>
+#include <Physics/BulletTaskScheduler.h>
 #include <Math/AABB.h>
+#include <Jobs/JobSystem.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btCapsuleShape.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+
+constexpr UPTR QUERIES_PER_JOB = 32;
+constexpr int MAX_SUBSTEPS = 10;
+
+// Bullet supports only one task scheduler per process. It is shared by all multithreaded levels and is never
+// replaced, because Bullet assigns thread indices once per thread and a new scheduler would restart the counter.
+static std::unique_ptr<Physics::CBulletTaskScheduler> TaskScheduler;
 
 // TODO: probably newer bullet versions allow to clear or at least access all objects
-class CMyDiscreteDynamicsWorld : public btDiscreteDynamicsWorld
+template<typename TWorld>
+class CMyDiscreteDynamicsWorld : public TWorld
 {
 public:
 
-	CMyDiscreteDynamicsWorld(btDispatcher* dispatcher, btBroadphaseInterface* pairCache, btConstraintSolver* constraintSolver, btCollisionConfiguration* collisionConfiguration)
-		: btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration)
+	template<typename... TArgs>
+	CMyDiscreteDynamicsWorld(TArgs&&... Args)
+		: TWorld(std::forward<TArgs>(Args)...)
 	{}
 
 	virtual ~CMyDiscreteDynamicsWorld() override
@@ -31,15 +46,16 @@ public:
 
 		// Necessary for static collision data removal, if loaded from .bullet
 		// TODO: not tested, maybe a better way exists! For example store .bullet-loaded object refs in a game level.
-		if (m_collisionObjects.size() > 0)
+		auto& Objects = this->m_collisionObjects;
+		if (Objects.size() > 0)
 		{
-			std::vector<btCollisionObject*> CollisionObjects(m_collisionObjects.size());
-			for (int i = 0; i < m_collisionObjects.size(); ++i)
-				CollisionObjects[i] = m_collisionObjects[i];
+			std::vector<btCollisionObject*> CollisionObjects(Objects.size());
+			for (int i = 0; i < Objects.size(); ++i)
+				CollisionObjects[i] = Objects[i];
 
 			for (btCollisionObject* pObject : CollisionObjects)
 			{
-				removeCollisionObject(pObject);
+				this->removeCollisionObject(pObject);
 				delete pObject;
 			}
 		}
@@ -116,6 +132,80 @@ public:
 	UPTR GetContactCount() const { return _Counter; }
 };
 
+// btDbvtBroadphase::rayTest shares one traversal stack between all callers. Batched queries traverse
+// DBVT sets directly with per-thread stacks instead, so they can run in parallel and don't allocate.
+static btAlignedObjectArray<const btDbvtNode*>& GetTraversalStack()
+{
+	thread_local btAlignedObjectArray<const btDbvtNode*> Stack;
+	return Stack;
+}
+//---------------------------------------------------------------------
+
+static void InitBroadphaseRay(btBroadphaseRayCallback& Callback, const btVector3& From, const btVector3& To)
+{
+	// The same as in btSingleRayCallback
+	const btVector3 Dir = (To - From).normalized();
+	Callback.m_rayDirectionInverse[0] = (Dir[0] == 0.f) ? BT_LARGE_FLOAT : 1.f / Dir[0];
+	Callback.m_rayDirectionInverse[1] = (Dir[1] == 0.f) ? BT_LARGE_FLOAT : 1.f / Dir[1];
+	Callback.m_rayDirectionInverse[2] = (Dir[2] == 0.f) ? BT_LARGE_FLOAT : 1.f / Dir[2];
+	Callback.m_signs[0] = Callback.m_rayDirectionInverse[0] < 0.f;
+	Callback.m_signs[1] = Callback.m_rayDirectionInverse[1] < 0.f;
+	Callback.m_signs[2] = Callback.m_rayDirectionInverse[2] < 0.f;
+	Callback.m_lambda_max = Dir.dot(To - From);
+}
+//---------------------------------------------------------------------
+
+static void DbvtRayTest(const btDbvtBroadphase& Broadphase, const btVector3& From, const btVector3& To,
+	const btVector3& AabbMin, const btVector3& AabbMax, btBroadphaseRayCallback& Callback)
+{
+	struct CTester : btDbvt::ICollide
+	{
+		btBroadphaseRayCallback& _Callback;
+
+		CTester(btBroadphaseRayCallback& Callback) : _Callback(Callback) {}
+		void Process(const btDbvtNode* pLeaf) { _Callback.process(static_cast<const btBroadphaseProxy*>(pLeaf->data)); }
+	};
+
+	CTester Tester(Callback);
+	auto& Stack = GetTraversalStack();
+	for (const auto& Set : Broadphase.m_sets)
+		Set.rayTestInternal(Set.m_root, From, To, Callback.m_rayDirectionInverse, Callback.m_signs, Callback.m_lambda_max, AabbMin, AabbMax, Stack, Tester);
+}
+//---------------------------------------------------------------------
+
+static bool NeedsBatchCollision(const btBroadphaseProxy* pProxy, U32 Group, U32 Mask, const Physics::CPhysicsObject* pExclude,
+	Physics::CPhysicsLevel::PQueryFilter pFilter, const void* pFilterContext, UPTR QueryIndex)
+{
+	if (!(pProxy->m_collisionFilterGroup & Mask)) return false;
+	if (!(Group & pProxy->m_collisionFilterMask)) return false;
+
+	const auto* pObject = static_cast<const Physics::CPhysicsObject*>(static_cast<const btCollisionObject*>(pProxy->m_clientObject)->getUserPointer());
+	if (pExclude && pObject == pExclude) return false;
+	if (pFilter && pObject && !pFilter(*pObject, QueryIndex, pFilterContext)) return false;
+	return true;
+}
+//---------------------------------------------------------------------
+
+template<typename F>
+static void RunQueryJobs(UPTR Count, DEM::Jobs::CWorker* pWorker, F Process)
+{
+	if (pWorker && Count > QUERIES_PER_JOB)
+	{
+		DEM::Jobs::CJobCounter Counter;
+		for (UPTR i = 0; i < Count; i += QUERIES_PER_JOB)
+		{
+			const UPTR End = std::min(i + QUERIES_PER_JOB, Count);
+			pWorker->AddJob(Counter, [&Process, i, End]() { Process(i, End); });
+		}
+		pWorker->WaitActive(Counter);
+	}
+	else
+	{
+		Process(0, Count);
+	}
+}
+//---------------------------------------------------------------------
+
 namespace Physics
 {
 
@@ -136,7 +226,7 @@ void CPhysicsLevel::AfterTick(btDynamicsWorld* world, btScalar timeStep)
 }
 //---------------------------------------------------------------------
 
-CPhysicsLevel::CPhysicsLevel(const Math::CAABB& /*Bounds*/)
+CPhysicsLevel::CPhysicsLevel(const Math::CAABB& /*Bounds*/, DEM::Jobs::CJobSystem* pJobSystem)
 {
 	// Register predefined collision groups
 	PredefinedCollisionGroups.Dynamic = CollisionGroups.GetMask("Dynamic");
@@ -152,12 +242,40 @@ CPhysicsLevel::CPhysicsLevel(const Math::CAABB& /*Bounds*/)
 	btBroadphaseInterface* pBtBroadPhase = new btDbvtBroadphase();
 
 	btDefaultCollisionConfiguration* pBtCollCfg = new btDefaultCollisionConfiguration();
-	btCollisionDispatcher* pBtCollDisp = new btCollisionDispatcher(pBtCollCfg);
 
-	//http://bulletphysics.org/mediawiki-1.5.8/index.php/BtContactSolverInfo
-	btSequentialImpulseConstraintSolver* pBtSolver = new btSequentialImpulseConstraintSolver();
+	// The scheduler must be set before creating Mt objects, they allocate per-thread data for its thread count.
+	// It is set from the main thread, which becomes Bullet's thread 0. More threads than Bullet supports disable multithreading.
+	// The scheduler lives until the process exits and is bound to the first job system, levels with another one run serially.
+	if (pJobSystem && !TaskScheduler)
+	{
+		auto NewScheduler = std::make_unique<CBulletTaskScheduler>(*pJobSystem);
+		if (NewScheduler->IsThreadCountSupported())
+		{
+			TaskScheduler = std::move(NewScheduler);
+			btSetTaskScheduler(TaskScheduler.get());
+		}
+	}
+
+	if (pJobSystem && TaskScheduler && &TaskScheduler->GetJobSystem() == pJobSystem)
+	{
+		btCollisionDispatcher* pBtCollDisp = new btCollisionDispatcherMt(pBtCollCfg);
+
+		//http://bulletphysics.org/mediawiki-1.5.8/index.php/BtContactSolverInfo
+		// Islands are solved in parallel by pooled solvers, and a single large island is solved by the Mt solver
+		auto pBtSolverPool = new btConstraintSolverPoolMt(TaskScheduler->getNumThreads());
+		_pBtSolverMt = new btSequentialImpulseConstraintSolverMt();
+
+		pBtDynWorld = new CMyDiscreteDynamicsWorld<btDiscreteDynamicsWorldMt>(pBtCollDisp, pBtBroadPhase, pBtSolverPool, _pBtSolverMt, pBtCollCfg);
+	}
+	else
+	{
+		btCollisionDispatcher* pBtCollDisp = new btCollisionDispatcher(pBtCollCfg);
 
-	pBtDynWorld = new CMyDiscreteDynamicsWorld(pBtCollDisp, pBtBroadPhase, pBtSolver, pBtCollCfg);
+		//http://bulletphysics.org/mediawiki-1.5.8/index.php/BtContactSolverInfo
+		btSequentialImpulseConstraintSolver* pBtSolver = new btSequentialImpulseConstraintSolver();
+
+		pBtDynWorld = new CMyDiscreteDynamicsWorld<btDiscreteDynamicsWorld>(pBtCollDisp, pBtBroadPhase, pBtSolver, pBtCollCfg);
+	}
 
 	pBtDynWorld->setGravity(btVector3(0.f, -9.81f, 0.f));
 
@@ -172,13 +290,14 @@ CPhysicsLevel::CPhysicsLevel(const Math::CAABB& /*Bounds*/)
 	use CCD for fast moving objects
 	btConeTwistConstraint for ragdolls
 	materials - restitution and friction
-	there is a multithreading support
 	*/
 }
 //---------------------------------------------------------------------
 
 CPhysicsLevel::~CPhysicsLevel()
 {
+	FinishUpdate();
+
 	if (!pBtDynWorld) return;
 
 	btConstraintSolver* pBtSolver = pBtDynWorld->getConstraintSolver();
@@ -192,6 +311,29 @@ CPhysicsLevel::~CPhysicsLevel()
 	delete pBtCollDisp;
 	delete pBtCollCfg;
 	delete pBtBroadPhase;
+
+	if (_pBtSolverMt) delete _pBtSolverMt;
+}
+//---------------------------------------------------------------------
+
+void CPhysicsLevel::StepSimulation(float dt)
+{
+	ZoneScoped;
+
+	pBtDynWorld->stepSimulation(dt, MAX_SUBSTEPS, StepTime);
+}
+//---------------------------------------------------------------------
+
+// Writes transforms buffered by rigid body motion states during the step into scene nodes
+void CPhysicsLevel::ApplyMotionStates()
+{
+	ZoneScoped;
+
+	const auto& Bodies = pBtDynWorld->getNonStaticRigidBodies();
+	for (int i = 0; i < Bodies.size(); ++i)
+		if (auto pObject = static_cast<CPhysicsObject*>(Bodies[i]->getUserPointer()))
+			if (auto pRigidBody = pObject->As<CRigidBody>())
+				pRigidBody->ApplyMotionState();
 }
 //---------------------------------------------------------------------
 
@@ -199,7 +341,45 @@ void CPhysicsLevel::Update(float dt)
 {
 	ZoneScoped;
 
-	if (pBtDynWorld) pBtDynWorld->stepSimulation(dt, 10, StepTime);
+	FinishUpdate();
+
+	if (!pBtDynWorld) return;
+
+	StepSimulation(dt);
+	ApplyMotionStates();
+}
+//---------------------------------------------------------------------
+
+// Starts a simulation step in a job. Without a worker the step is done immediately as in Update.
+void CPhysicsLevel::StartUpdate(float dt, DEM::Jobs::CWorker* pWorker)
+{
+	ZoneScoped;
+
+	if (!pWorker)
+	{
+		Update(dt);
+		return;
+	}
+
+	FinishUpdate();
+
+	if (!pBtDynWorld) return;
+
+	_pUpdateWorker = pWorker;
+	pWorker->AddJob(_UpdateJob, [this, dt]() { StepSimulation(dt); });
+}
+//---------------------------------------------------------------------
+
+void CPhysicsLevel::FinishUpdate()
+{
+	if (!_pUpdateWorker) return;
+
+	ZoneScoped;
+
+	_pUpdateWorker->WaitActive(_UpdateJob);
+	_pUpdateWorker = nullptr;
+
+	ApplyMotionStates();
 }
 //---------------------------------------------------------------------
 
@@ -313,6 +493,254 @@ UPTR CPhysicsLevel::EnumCapsuleYContacts(const rtm::vector4f& Position, float Ra
 }
 //---------------------------------------------------------------------
 
+// Rays are cast against exact collision shapes, like with GetClosestRayContact, but without per-query allocations
+void CPhysicsLevel::CastRays(const CRayQuery* pQueries, CQueryHit* pOutHits, UPTR Count, DEM::Jobs::CWorker* pWorker, PQueryFilter pFilter, const void* pFilterContext) const
+{
+	ZoneScoped;
+
+	if (!Count) return;
+
+	n_assert_dbg(pQueries && pOutHits);
+
+	struct CResultCallback : public btCollisionWorld::ClosestRayResultCallback
+	{
+		const CRayQuery& _Query;
+		PQueryFilter     _pFilter;
+		const void*      _pFilterContext;
+		UPTR             _QueryIndex;
+
+		CResultCallback(const btVector3& From, const btVector3& To, const CRayQuery& Query, PQueryFilter pFilter, const void* pFilterContext, UPTR QueryIndex)
+			: ClosestRayResultCallback(From, To), _Query(Query), _pFilter(pFilter), _pFilterContext(pFilterContext), _QueryIndex(QueryIndex)
+		{
+		}
+
+		virtual bool needsCollision(btBroadphaseProxy* proxy0) const override
+		{
+			return NeedsBatchCollision(proxy0, _Query.Group, _Query.Mask, _Query.pExclude, _pFilter, _pFilterContext, _QueryIndex);
+		}
+	};
+
+	struct CBroadphaseCallback : public btBroadphaseRayCallback
+	{
+		btTransform      _From;
+		btTransform      _To;
+		CResultCallback& _Result;
+
+		CBroadphaseCallback(const btVector3& From, const btVector3& To, CResultCallback& Result)
+			: _From(btMatrix3x3::getIdentity(), From), _To(btMatrix3x3::getIdentity(), To), _Result(Result)
+		{
+			InitBroadphaseRay(*this, From, To);
+		}
+
+		virtual bool process(const btBroadphaseProxy* proxy) override
+		{
+			// Nothing can be closer than the start point
+			if (_Result.m_closestHitFraction == 0.f) return false;
+
+			auto* pBtObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+			if (_Result.needsCollision(pBtObject->getBroadphaseHandle()))
+				btCollisionWorld::rayTestSingle(_From, _To, pBtObject, pBtObject->getCollisionShape(), pBtObject->getWorldTransform(), _Result);
+
+			return true;
+		}
+	};
+
+	const auto* pBroadphase = pBtDynWorld ? static_cast<const btDbvtBroadphase*>(pBtDynWorld->getBroadphase()) : nullptr;
+
+	RunQueryJobs(Count, pWorker, [=](UPTR Begin, UPTR End)
+	{
+		for (UPTR i = Begin; i < End; ++i)
+		{
+			const auto& Query = pQueries[i];
+			auto& Result = pOutHits[i];
+			Result.Position = Query.End;
+			Result.Normal = rtm::vector_zero();
+			Result.pObject = nullptr;
+			Result.Fraction = 1.f;
+			Result.Hit = false;
+
+			const btVector3 BtStart = Math::ToBullet3(Query.Start);
+			const btVector3 BtEnd = Math::ToBullet3(Query.End);
+			if (!pBroadphase || BtStart == BtEnd) continue;
+
+			CResultCallback RayCB(BtStart, BtEnd, Query, pFilter, pFilterContext, i);
+			CBroadphaseCallback BroadphaseCB(BtStart, BtEnd, RayCB);
+			DbvtRayTest(*pBroadphase, BtStart, BtEnd, btVector3(0.f, 0.f, 0.f), btVector3(0.f, 0.f, 0.f), BroadphaseCB);
+
+			if (!RayCB.hasHit()) continue;
+
+			Result.Position = Math::FromBullet(RayCB.m_hitPointWorld);
+			Result.Normal = Math::FromBullet(RayCB.m_hitNormalWorld);
+			Result.pObject = static_cast<CPhysicsObject*>(RayCB.m_collisionObject->getUserPointer());
+			Result.Fraction = RayCB.m_closestHitFraction;
+			Result.Hit = true;
+		}
+	});
+}
+//---------------------------------------------------------------------
+
+void CPhysicsLevel::SweepSpheres(const CSphereSweepQuery* pQueries, CQueryHit* pOutHits, UPTR Count, DEM::Jobs::CWorker* pWorker, PQueryFilter pFilter, const void* pFilterContext) const
+{
+	ZoneScoped;
+
+	if (!Count) return;
+
+	n_assert_dbg(pQueries && pOutHits);
+
+	struct CResultCallback : public btCollisionWorld::ClosestConvexResultCallback
+	{
+		const CSphereSweepQuery& _Query;
+		PQueryFilter             _pFilter;
+		const void*              _pFilterContext;
+		UPTR                     _QueryIndex;
+
+		CResultCallback(const btVector3& From, const btVector3& To, const CSphereSweepQuery& Query, PQueryFilter pFilter, const void* pFilterContext, UPTR QueryIndex)
+			: ClosestConvexResultCallback(From, To), _Query(Query), _pFilter(pFilter), _pFilterContext(pFilterContext), _QueryIndex(QueryIndex)
+		{
+		}
+
+		virtual bool needsCollision(btBroadphaseProxy* proxy0) const override
+		{
+			return NeedsBatchCollision(proxy0, _Query.Group, _Query.Mask, _Query.pExclude, _pFilter, _pFilterContext, _QueryIndex);
+		}
+	};
+
+	struct CBroadphaseCallback : public btBroadphaseRayCallback
+	{
+		btTransform          _From;
+		btTransform          _To;
+		const btConvexShape& _Shape;
+		CResultCallback&     _Result;
+		btScalar             _AllowedPenetration;
+
+		CBroadphaseCallback(const btVector3& From, const btVector3& To, const btConvexShape& Shape, CResultCallback& Result, btScalar AllowedPenetration)
+			: _From(btMatrix3x3::getIdentity(), From), _To(btMatrix3x3::getIdentity(), To), _Shape(Shape), _Result(Result), _AllowedPenetration(AllowedPenetration)
+		{
+			InitBroadphaseRay(*this, From, To);
+		}
+
+		virtual bool process(const btBroadphaseProxy* proxy) override
+		{
+			if (_Result.m_closestHitFraction == 0.f) return false;
+
+			auto* pBtObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+			if (_Result.needsCollision(pBtObject->getBroadphaseHandle()))
+				btCollisionWorld::objectQuerySingle(&_Shape, _From, _To, pBtObject, pBtObject->getCollisionShape(), pBtObject->getWorldTransform(), _Result, _AllowedPenetration);
+
+			return true;
+		}
+	};
+
+	const auto* pBroadphase = pBtDynWorld ? static_cast<const btDbvtBroadphase*>(pBtDynWorld->getBroadphase()) : nullptr;
+	const btScalar AllowedPenetration = pBtDynWorld ? pBtDynWorld->getDispatchInfo().m_allowedCcdPenetration : 0.f;
+
+	RunQueryJobs(Count, pWorker, [=](UPTR Begin, UPTR End)
+	{
+		for (UPTR i = Begin; i < End; ++i)
+		{
+			const auto& Query = pQueries[i];
+			auto& Result = pOutHits[i];
+			Result.Position = Query.End;
+			Result.Normal = rtm::vector_zero();
+			Result.pObject = nullptr;
+			Result.Fraction = 1.f;
+			Result.Hit = false;
+
+			const btVector3 BtStart = Math::ToBullet3(Query.Start);
+			const btVector3 BtEnd = Math::ToBullet3(Query.End);
+			if (!pBroadphase || BtStart == BtEnd || Query.Radius <= 0.f) continue;
+
+			// A sphere AABB doesn't depend on rotation, so the swept volume is simply extended by the radius
+			const btSphereShape Shape(Query.Radius);
+			const btVector3 Extent(Query.Radius, Query.Radius, Query.Radius);
+			CResultCallback SweepCB(BtStart, BtEnd, Query, pFilter, pFilterContext, i);
+			CBroadphaseCallback BroadphaseCB(BtStart, BtEnd, Shape, SweepCB, AllowedPenetration);
+			DbvtRayTest(*pBroadphase, BtStart, BtEnd, -Extent, Extent, BroadphaseCB);
+
+			if (!SweepCB.hasHit()) continue;
+
+			Result.Position = Math::FromBullet(SweepCB.m_hitPointWorld);
+			Result.Normal = Math::FromBullet(SweepCB.m_hitNormalWorld);
+			Result.pObject = static_cast<CPhysicsObject*>(SweepCB.m_hitCollisionObject->getUserPointer());
+			Result.Fraction = SweepCB.m_closestHitFraction;
+			Result.Hit = true;
+		}
+	});
+}
+//---------------------------------------------------------------------
+
+// Unlike EnumSphereContacts, objects are tested by their broadphase AABBs and each object is reported once.
+// This is enough for sensing and proximity checks and doesn't touch the dispatcher, which is not thread-safe.
+// Objects without CPhysicsObject are skipped. Overlaps exceeding MaxOverlapsPerQuery are dropped.
+void CPhysicsLevel::OverlapSpheres(const CSphereQuery* pQueries, UPTR Count, COverlap* pOutOverlaps, U32* pOutCounts, U32 MaxOverlapsPerQuery,
+	DEM::Jobs::CWorker* pWorker, PQueryFilter pFilter, const void* pFilterContext) const
+{
+	ZoneScoped;
+
+	if (!Count) return;
+
+	n_assert_dbg(pQueries && pOutCounts && (pOutOverlaps || !MaxOverlapsPerQuery));
+
+	struct CCollector : btDbvt::ICollide
+	{
+		const CSphereQuery& _Query;
+		btVector3           _Center;
+		PQueryFilter        _pFilter;
+		const void*         _pFilterContext;
+		UPTR                _QueryIndex;
+		COverlap*           _pOut;
+		U32                 _MaxCount;
+		U32                 _Count = 0;
+
+		CCollector(const CSphereQuery& Query, PQueryFilter pFilter, const void* pFilterContext, UPTR QueryIndex, COverlap* pOut, U32 MaxCount)
+			: _Query(Query), _Center(Math::ToBullet3(Query.Position)), _pFilter(pFilter), _pFilterContext(pFilterContext), _QueryIndex(QueryIndex), _pOut(pOut), _MaxCount(MaxCount)
+		{
+		}
+
+		void Process(const btDbvtNode* pLeaf)
+		{
+			if (_Count >= _MaxCount) return;
+
+			const auto* pProxy = static_cast<const btBroadphaseProxy*>(pLeaf->data);
+			if (!NeedsBatchCollision(pProxy, _Query.Group, _Query.Mask, nullptr, _pFilter, _pFilterContext, _QueryIndex)) return;
+
+			auto* pObject = static_cast<CPhysicsObject*>(static_cast<const btCollisionObject*>(pProxy->m_clientObject)->getUserPointer());
+			if (!pObject) return;
+
+			btVector3 ClosestPoint = _Center;
+			ClosestPoint.setMax(pProxy->m_aabbMin);
+			ClosestPoint.setMin(pProxy->m_aabbMax);
+			if (ClosestPoint.distance2(_Center) > _Query.Radius * _Query.Radius) return;
+
+			_pOut[_Count++] = { Math::FromBullet(ClosestPoint), pObject };
+		}
+	};
+
+	const auto* pBroadphase = pBtDynWorld ? static_cast<const btDbvtBroadphase*>(pBtDynWorld->getBroadphase()) : nullptr;
+
+	RunQueryJobs(Count, pWorker, [=](UPTR Begin, UPTR End)
+	{
+		auto& Stack = GetTraversalStack();
+		for (UPTR i = Begin; i < End; ++i)
+		{
+			const auto& Query = pQueries[i];
+			pOutCounts[i] = 0;
+			if (!pBroadphase || Query.Radius <= 0.f || !MaxOverlapsPerQuery) continue;
+
+			const btVector3 Center = Math::ToBullet3(Query.Position);
+			const btVector3 Extent(Query.Radius, Query.Radius, Query.Radius);
+			const ATTRIBUTE_ALIGNED16(btDbvtVolume) Bounds = btDbvtVolume::FromMM(Center - Extent, Center + Extent);
+
+			CCollector Collector(Query, pFilter, pFilterContext, i, pOutOverlaps + i * MaxOverlapsPerQuery, MaxOverlapsPerQuery);
+			for (const auto& Set : pBroadphase->m_sets)
+				Set.collideTVNoStackAlloc(Set.m_root, Bounds, Stack, Collector);
+
+			pOutCounts[i] = Collector._Count;
+		}
+	});
+}
+//---------------------------------------------------------------------
+
 void CPhysicsLevel::RegisterTickListener(ITickListener* pListener)
 {
 	if (pListener) _TickListeners.insert(pListener);
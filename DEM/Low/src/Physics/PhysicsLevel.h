@@ -3,19 +3,31 @@
 #include <Data/DynamicEnum.h>
 #include <Math/Vector3.h>
 #include <Math/SIMDMath.h>
+#include <Jobs/Worker.h>
 #include <LinearMath/btScalar.h>
 
 // Physics level represents a space where physics bodies and collision objects live.
+// Batched queries are read-only and may run in parallel jobs, but only between simulation steps.
+// With a job system the world is multithreaded: Bullet parallel loops run as engine jobs.
+// StartUpdate steps the simulation in a job, so that it overlaps with other work, e.g. rendering of the previous
+// frame. Until FinishUpdate the level and its objects must not be accessed, and tick listeners are called from
+// the job thread. Rigid body transforms are buffered during the step and written to scene nodes in FinishUpdate.
 
 class CAABB;
 class btDynamicsWorld;
 class btDiscreteDynamicsWorld;
+class btConstraintSolver;
 
 namespace Debug
 {
 	class CDebugDraw;
 }
 
+namespace DEM::Jobs
+{
+	class CJobSystem;
+}
+
 namespace Physics
 {
 typedef Ptr<class CPhysicsLevel> PPhysicsLevel;
@@ -31,9 +43,16 @@ protected:
 
 	std::set<ITickListener*> _TickListeners; // TODO: weak ptrs?
 
+	btConstraintSolver*      _pBtSolverMt = nullptr;   // Solver for large islands, exists only in a multithreaded world
+	DEM::Jobs::CJobCounter   _UpdateJob;
+	DEM::Jobs::CWorker*      _pUpdateWorker = nullptr; // The worker that started _UpdateJob
+
 	static void BeforeTick(btDynamicsWorld* world, btScalar timeStep);
 	static void AfterTick(btDynamicsWorld* world, btScalar timeStep);
 
+	void        StepSimulation(float dt);
+	void        ApplyMotionStates();
+
 public:
 
 	// Predefined collision groups used in game logic
@@ -46,13 +65,62 @@ public:
 		U32 All;
 	};
 
+	struct CRayQuery
+	{
+		rtm::vector4f         Start;
+		rtm::vector4f         End;
+		U32                   Group;
+		U32                   Mask;
+		const CPhysicsObject* pExclude = nullptr;
+	};
+
+	struct CSphereSweepQuery
+	{
+		rtm::vector4f         Start;
+		rtm::vector4f         End;
+		float                 Radius;
+		U32                   Group;
+		U32                   Mask;
+		const CPhysicsObject* pExclude = nullptr;
+	};
+
+	struct CSphereQuery
+	{
+		rtm::vector4f         Position;
+		float                 Radius;
+		U32                   Group;
+		U32                   Mask;
+	};
+
+	struct CQueryHit
+	{
+		rtm::vector4f         Position; // The end of the query if nothing is hit
+		rtm::vector4f         Normal;
+		CPhysicsObject*       pObject;  // May be nullptr even on hit, if a Bullet object has no CPhysicsObject
+		float                 Fraction; // Along the ray or sweep, 1.f if nothing is hit
+		bool                  Hit;
+	};
+
+	struct COverlap
+	{
+		rtm::vector4f         Position; // The closest point of the object AABB to the sphere center
+		CPhysicsObject*       pObject;
+	};
+
+	// Optional filter for batched queries, called from job threads. Returns false to ignore the object for the query.
+	using PQueryFilter = bool(*)(const CPhysicsObject& Object, UPTR QueryIndex, const void* pContext);
+
 	Data::CDynamicEnum32     CollisionGroups;
 	CCollisionGroups         PredefinedCollisionGroups;
 
-	CPhysicsLevel(const Math::CAABB& Bounds);
+	CPhysicsLevel(const Math::CAABB& Bounds, DEM::Jobs::CJobSystem* pJobSystem = nullptr);
 	virtual ~CPhysicsLevel() override;
 
 	void  Update(float dt);
+	void  StartUpdate(float dt, DEM::Jobs::CWorker* pWorker);
+	void  FinishUpdate();
+	bool  IsUpdating() const { return !!_pUpdateWorker; }
+	bool  IsMultithreaded() const { return !!_pBtSolverMt; }
 	void  RenderDebug(Debug::CDebugDraw& DebugDraw);
 
 	// FIXME CONSISTENCY: contact enumerators work only with CPhysicsObject but GetClosestRayContact detects hit point for any bullet collision objects!
@@ -62,6 +130,11 @@ public:
 	UPTR  EnumSphereContacts(const rtm::vector4f& Position, float Radius, U32 Group, U32 Mask, std::function<bool(CPhysicsObject&, const rtm::vector4f&)>&& Callback) const;
 	UPTR  EnumCapsuleYContacts(const rtm::vector4f& Position, float Radius, float CylinderLength, U32 Group, U32 Mask, std::function<bool(CPhysicsObject&, const rtm::vector4f&)>&& Callback) const;
 
+	// Result i is written for query i. Overlaps of query i are written starting at pOutOverlaps[i * MaxOverlapsPerQuery].
+	void  CastRays(const CRayQuery* pQueries, CQueryHit* pOutHits, UPTR Count, DEM::Jobs::CWorker* pWorker = nullptr, PQueryFilter pFilter = nullptr, const void* pFilterContext = nullptr) const;
+	void  SweepSpheres(const CSphereSweepQuery* pQueries, CQueryHit* pOutHits, UPTR Count, DEM::Jobs::CWorker* pWorker = nullptr, PQueryFilter pFilter = nullptr, const void* pFilterContext = nullptr) const;
+	void  OverlapSpheres(const CSphereQuery* pQueries, UPTR Count, COverlap* pOutOverlaps, U32* pOutCounts, U32 MaxOverlapsPerQuery, DEM::Jobs::CWorker* pWorker = nullptr, PQueryFilter pFilter = nullptr, const void* pFilterContext = nullptr) const;
+
 	void  RegisterTickListener(ITickListener* pListener);
 	void  UnregisterTickListener(ITickListener* pListener);
 
@@ -29,17 +29,27 @@ void CRigidBody::CDynamicMotionState::getWorldTransform(btTransform& worldTrans)
 }
 //---------------------------------------------------------------------
 
+// Called by Bullet, possibly from a job thread. Only one thread syncs each body, so no locking is required.
 void CRigidBody::CDynamicMotionState::setWorldTransform(const btTransform& worldTrans)
 {
 	if (_Node)
 	{
-		auto Tfm = Math::FromBullet(worldTrans);
-		Tfm.w_axis = rtm::matrix_mul_point3(rtm::vector_neg(_Offset), Tfm);
-		_Node->SetWorldTransform(Tfm);
+		_PendingTfm = Math::FromBullet(worldTrans);
+		_PendingTfm.w_axis = rtm::matrix_mul_point3(rtm::vector_neg(_Offset), _PendingTfm);
+		_HasPendingTfm = true;
 	}
 }
 //---------------------------------------------------------------------
 
+void CRigidBody::CDynamicMotionState::ApplyPendingTransform()
+{
+	if (!_HasPendingTfm) return;
+
+	_HasPendingTfm = false;
+	if (_Node) _Node->SetWorldTransform(_PendingTfm);
+}
+//---------------------------------------------------------------------
+
 CRigidBody::CRigidBody(float Mass, CCollisionShape& Shape, CStrID CollisionGroupID, CStrID CollisionMaskID, const rtm::matrix3x4f& InitialTfm, const CPhysicsMaterial& Material)
 	: CPhysicsObject(CollisionGroupID, CollisionMaskID)
 	, _MotionState(Shape.GetOffset())
@@ -81,7 +91,11 @@ void CRigidBody::SetControlledNode(Scene::CSceneNode* pNode)
 	_MotionState.SetSceneNode(pNode);
 	if (pNode)
 	{
-		if (_Level) _Level->GetBtWorld()->synchronizeSingleMotionState(static_cast<btRigidBody*>(_pBtObject));
+		if (_Level)
+		{
+			_Level->GetBtWorld()->synchronizeSingleMotionState(static_cast<btRigidBody*>(_pBtObject));
+			_MotionState.ApplyPendingTransform();
+		}
 		_pBtObject->activate();
 	}
 }
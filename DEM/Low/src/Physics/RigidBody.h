@@ -21,13 +21,16 @@ class CRigidBody : public CPhysicsObject
 
 protected:
 
-	// To be useful, rigid body must be connected to a scene node to serve as its transformation source
+	// To be useful, rigid body must be connected to a scene node to serve as its transformation source.
+	// Bullet may set transforms from job threads during a step, so they are buffered and applied to the node later.
 	class CDynamicMotionState : public btMotionState
 	{
 	protected:
 
 		Scene::PSceneNode _Node;
 		rtm::vector4f     _Offset;
+		rtm::matrix3x4f   _PendingTfm;
+		bool              _HasPendingTfm = false;
 
 	public:
 
@@ -36,6 +39,7 @@ protected:
 
 		void SetSceneNode(Scene::PSceneNode&& Node);
 		Scene::CSceneNode* GetSceneNode() const { return _Node.Get(); }
+		void ApplyPendingTransform();
 
 		virtual void getWorldTransform(btTransform& worldTrans) const override;
 		virtual void setWorldTransform(const btTransform& worldTrans) override;
@@ -58,6 +62,7 @@ public:
 	virtual void       GetTransform(rtm::matrix3x4f& OutTfm) const override;
 	virtual void       GetGlobalAABB(Math::CAABB& OutBox) const override;
 	virtual void       SetActive(bool Active, bool Always = false) override;
+	void               ApplyMotionState() { _MotionState.ApplyPendingTransform(); }
 	float              GetInvMass() const;
 	float              GetMass() const { return 1.f / GetInvMass(); }
 
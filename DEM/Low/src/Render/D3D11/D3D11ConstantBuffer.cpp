@@ -37,7 +37,12 @@ CD3D11ConstantBuffer::~CD3D11ConstantBuffer()
 {
 	SAFE_RELEASE(pSRView);
 	SAFE_RELEASE(pBuffer);
-	if (Flags.Is(CB11_UsesRAMCopy))
+	if (Flags.Is(CB11_View))
+	{
+		// RAM copy belongs to the owner
+		pMapped = nullptr;
+	}
+	else if (Flags.Is(CB11_UsesRAMCopy))
 	{
 		n_assert_dbg(!SizeInBytes || pMapped);
 		SAFE_FREE_ALIGNED(pMapped);
@@ -60,6 +65,36 @@ U8 CD3D11ConstantBuffer::GetAccessFlags() const
 }
 //---------------------------------------------------------------------
 
+// Makes this buffer a temporary view of the range in the owner buffer. The owner must have a RAM copy,
+// views write to it and commit only their range. The view keeps the owner's D3D buffer alive.
+bool CD3D11ConstantBuffer::SetViewRange(CD3D11ConstantBuffer& Owner, UPTR Offset, UPTR Size)
+{
+	if (!Owner.pBuffer || !Owner.UsesRAMCopy() || Owner.IsView() || Offset + Size > Owner.SizeInBytes) FAIL;
+
+	// Only reusing views is allowed, not regular buffers
+	n_assert_dbg(!pBuffer || Flags.Is(CB11_View));
+	n_assert_dbg(!Flags.Is(CB11_InWriteMode));
+
+	if (pBuffer != Owner.pBuffer)
+	{
+		SAFE_RELEASE(pBuffer);
+		pBuffer = Owner.pBuffer;
+		pBuffer->AddRef();
+	}
+
+	pMapped = Owner.pMapped + Offset;
+	Type = Owner.Type;
+	D3DUsage = Owner.D3DUsage;
+	SizeInBytes = Size;
+	OffsetInBytes = Offset;
+
+	Flags.ClearAll();
+	Flags.Set(CB11_View | CB11_UsesRAMCopy | CB11_Temporary);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
 bool CD3D11ConstantBuffer::CreateRAMCopy()
 {
 	if (Flags.Is(CB11_UsesRAMCopy)) OK;
@@ -85,7 +120,7 @@ void CD3D11ConstantBuffer::ResetRAMCopy(const void* pVBuffer)
 
 void CD3D11ConstantBuffer::DestroyRAMCopy()
 {
-	if (Flags.IsNot(CB11_UsesRAMCopy)) return;
+	if (Flags.IsNot(CB11_UsesRAMCopy) || Flags.Is(CB11_View)) return;
 	SAFE_FREE_ALIGNED(pMapped);
 	Flags.Clear(CB11_UsesRAMCopy | CB11_Dirty);
 }
@@ -8,6 +8,8 @@
 // save memory, but non-mappable ones don't support BeginChanges() +
 // Set...() + EndChanges() and, as of DX11, can't be updated partially.
 // Use WriteCommitToVRAM() to update non-mappable VRAM-only buffers.
+// A buffer can also be a view of a range in a bigger buffer. Such views are used for
+// sub-allocating transient constants with D3D11.1 constant buffer offsetting.
 
 struct ID3D11Buffer;
 struct ID3D11ShaderResourceView;
@@ -29,7 +31,8 @@ protected:
 		CB11_UsesRAMCopy	= 0x01,
 		CB11_Dirty			= 0x02,
 		CB11_InWriteMode	= 0x04,
-		CB11_Temporary		= 0x08
+		CB11_Temporary		= 0x08,
+		CB11_View			= 0x10	// RAM copy and D3D buffer are owned by another CB
 	};
 
 	ID3D11Buffer*				pBuffer = nullptr;
@@ -37,11 +40,13 @@ protected:
 	char*						pMapped = nullptr;
 	EUSMBufferType				Type;
 	D3D11_USAGE					D3DUsage;
-	UPTR						SizeInBytes;
+	UPTR						SizeInBytes = 0;
+	UPTR						OffsetInBytes = 0;	// Non-zero for views only
 	Data::CFlags				Flags;
 
 public:
 
+	CD3D11ConstantBuffer() = default;
 	CD3D11ConstantBuffer(ID3D11Buffer* pCB, ID3D11ShaderResourceView* pSRV, bool Temporary = false);
 	virtual ~CD3D11ConstantBuffer() override;
 
@@ -56,6 +61,8 @@ public:
 	void						ResetRAMCopy(const void* pVBuffer);
 	void						DestroyRAMCopy();
 
+	bool						SetViewRange(CD3D11ConstantBuffer& Owner, UPTR Offset, UPTR Size);
+
 	void						WriteData(UPTR Offset, const void* pData, UPTR Size);
 
 	ID3D11Buffer*				GetD3DBuffer() const { return pBuffer; }
@@ -65,8 +72,10 @@ public:
 	const char*					GetRAMCopy() const { return Flags.Is(CB11_UsesRAMCopy) ? pMapped : nullptr; }
 	D3D11_USAGE					GetD3DUsage() const { return D3DUsage; }
 	UPTR						GetSizeInBytes() const { return SizeInBytes; }
+	UPTR						GetOffsetInBytes() const { return OffsetInBytes; }
 	EUSMBufferType				GetType() const { return Type; }
 	bool						UsesRAMCopy() const { return Flags.Is(CB11_UsesRAMCopy); }
+	bool						IsView() const { return Flags.Is(CB11_View); }
 
 	void						OnBegin(void* pMappedVRAM = nullptr);	// For internal use by the GPUDriver
 	void						OnCommit();							// For internal use by the GPUDriver
@@ -30,10 +30,8 @@
 #endif
 #define WIN32_LEAN_AND_MEAN
 #include <d3d11.h>
+#include <d3d11_1.h> // For constant buffer offsets and debug annotations, used only if the runtime supports them
 #if DEM_RENDER_DEBUG
-#ifdef DEM_RENDER_DEBUG_D3D11_1 // TODO: now included only for debug API, will need to check another macro for normal use!
-#include <d3d11_1.h>
-#endif
 #ifdef DEM_RENDER_DEBUG_D3D9 // Debug markers API from D3D9 is used for D3D before 11.1
 #include <d3d9.h>
 #endif
@@ -197,6 +195,9 @@ bool CD3D11GPUDriver::Init(UPTR AdapterNumber, EGPUDriverType DriverType)
 	CurrSR = n_new_array(RECT, MaxViewportCount);
 	VPSRSetFlags.ClearAll();
 
+	if (!InitTransientConstantBuffers())
+		Sys::Log("D3D11.1 constant buffer offsets are not supported, transient constants will use separate buffers\n");
+
 	OK;
 }
 //---------------------------------------------------------------------
@@ -276,6 +277,10 @@ void CD3D11GPUDriver::Release()
 
 	TmpCBPool.Clear();
 
+	_FreeTransientCBViews.clear();
+	_TransientCB = nullptr;
+	_TransientCBRing.Reset();
+
 	VertexLayouts.clear();
 	RenderStates.clear();
 	Samplers.clear();
@@ -316,6 +321,7 @@ void CD3D11GPUDriver::Release()
 	_pTracyImmCtx = nullptr;
 #endif
 
+	SAFE_RELEASE(_pD3DImmContext1);
 	SAFE_RELEASE(pD3DImmContext);
 	SAFE_RELEASE(pD3DDevice);
 
@@ -1168,6 +1174,9 @@ bool CD3D11GPUDriver::BeginFrame()
 
 void CD3D11GPUDriver::EndFrame()
 {
+	// Transient constants written in this frame can be overwritten after the GPU has executed it
+	if (_TransientCB) _TransientCBRing.EndFrame(*this);
+
 #ifdef DEM_STATS
 	std::string RTString;
 	for (UPTR i = 0; i < CurrRT.size(); ++i)
@@ -1390,16 +1399,58 @@ UPTR CD3D11GPUDriver::ApplyChanges(UPTR ChangesToUpdate)
 	if (Update.Is(GPU_Dirty_CB) && CurrDirtyFlags.Is(GPU_Dirty_CB))
 	{
 		ID3D11Buffer* D3DBuffers[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+		UINT FirstConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+		UINT NumConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
 		UPTR Offset = 0;
 		for (UPTR Sh = 0; Sh < ShaderType_COUNT; ++Sh, Offset += D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT)
 		{
 			UPTR ShdDirtyFlag = (1 << (Shader_Dirty_CBuffers + Sh));
 			if (ShaderParamsDirtyFlags.IsNot(ShdDirtyFlag)) continue;
 
+			bool HasViews = false;
 			for (UPTR i = 0; i < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT; ++i)
 			{
 				const CD3D11ConstantBuffer* pCB = CurrCB[Offset + i].Get();
 				D3DBuffers[i] = pCB ? pCB->GetD3DBuffer() : nullptr;
+
+				// Regular buffers are bound whole, which is the same as the first 4096 constants
+				if (pCB && pCB->IsView())
+				{
+					HasViews = true;
+					FirstConstants[i] = static_cast<UINT>(pCB->GetOffsetInBytes() / 16);
+					NumConstants[i] = static_cast<UINT>(pCB->GetSizeInBytes() / 16);
+				}
+				else
+				{
+					FirstConstants[i] = 0;
+					NumConstants[i] = D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT;
+				}
+			}
+
+			// Views can be created only when D3D11.1 context is available
+			if (HasViews)
+			{
+				switch ((EShaderType)Sh)
+				{
+					case ShaderType_Vertex:
+						_pD3DImmContext1->VSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, D3DBuffers, FirstConstants, NumConstants);
+						break;
+					case ShaderType_Pixel:
+						_pD3DImmContext1->PSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, D3DBuffers, FirstConstants, NumConstants);
+						break;
+					case ShaderType_Geometry:
+						_pD3DImmContext1->GSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, D3DBuffers, FirstConstants, NumConstants);
+						break;
+					case ShaderType_Hull:
+						_pD3DImmContext1->HSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, D3DBuffers, FirstConstants, NumConstants);
+						break;
+					case ShaderType_Domain:
+						_pD3DImmContext1->DSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, D3DBuffers, FirstConstants, NumConstants);
+						break;
+				};
+
+				ShaderParamsDirtyFlags.Clear(ShdDirtyFlag);
+				continue;
 			}
 
 			switch ((EShaderType)Sh)
@@ -1956,11 +2007,96 @@ PConstantBuffer CD3D11GPUDriver::CreateConstantBuffer(IConstantBufferParam& Para
 }
 //---------------------------------------------------------------------
 
+// Checks D3D11.1 runtime features and creates a ring buffer for transient constants if possible
+bool CD3D11GPUDriver::InitTransientConstantBuffers()
+{
+	_FreeTransientCBViews.clear();
+	_TransientCB = nullptr;
+	_TransientCBRing.Reset();
+	SAFE_RELEASE(_pD3DImmContext1);
+
+	D3D11_FEATURE_DATA_D3D11_OPTIONS Options = {};
+	if (FAILED(pD3DDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &Options, sizeof(Options)))) FAIL;
+	if (!Options.ConstantBufferOffsetting || !Options.MapNoOverwriteOnDynamicConstantBuffer) FAIL;
+
+	if (FAILED(pD3DImmContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&_pD3DImmContext1)))) FAIL;
+
+	D3D11_BUFFER_DESC Desc;
+	Desc.ByteWidth = TransientCBRingSize;
+	Desc.Usage = D3D11_USAGE_DYNAMIC;
+	Desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	Desc.MiscFlags = 0;
+	Desc.StructureByteStride = 0;
+
+	ID3D11Buffer* pD3DBuf = nullptr;
+	if (FAILED(pD3DDevice->CreateBuffer(&Desc, nullptr, &pD3DBuf)))
+	{
+		SAFE_RELEASE(_pD3DImmContext1);
+		FAIL;
+	}
+
+	// RAM copy serves as a persistent CPU mapping, views write there and commit their ranges with no-overwrite
+	_TransientCB = n_new(CD3D11ConstantBuffer(pD3DBuf, nullptr));
+	if (!_TransientCB->IsValid() || !_TransientCB->CreateRAMCopy())
+	{
+		_TransientCB = nullptr;
+		SAFE_RELEASE(_pD3DImmContext1);
+		FAIL;
+	}
+
+#if DEM_RENDER_DEBUG
+	_TransientCB->SetDebugName("TransientRing");
+#endif
+
+	// Initial discard, after that the ring is always mapped with no-overwrite
+	D3D11_MAPPED_SUBRESOURCE MappedSubRsrc;
+	if (SUCCEEDED(pD3DImmContext->Map(pD3DBuf, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedSubRsrc)))
+		pD3DImmContext->Unmap(pD3DBuf, 0);
+
+	_TransientCBRing.Init(TransientCBRingSize);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// NB: the result must be applied in the same frame, ring memory is reclaimed on frame fences
+PD3D11ConstantBuffer CD3D11GPUDriver::AllocateTransientConstantBuffer(UPTR Size)
+{
+	// D3D11.1 requires bound ranges to start and end at multiples of 16 constants
+	constexpr UPTR RangeGranularity = 16 * 4 * sizeof(float);
+	Size = Math::CeilToMultipleOfPow2(Size, RangeGranularity);
+	if (Size > D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 4 * sizeof(float)) return nullptr;
+
+	UPTR Offset;
+	if (!_TransientCBRing.Allocate(Size, RangeGranularity, Offset)) return nullptr;
+
+	PD3D11ConstantBuffer CB;
+	if (_FreeTransientCBViews.empty())
+	{
+		CB = n_new(CD3D11ConstantBuffer());
+	}
+	else
+	{
+		CB = std::move(_FreeTransientCBViews.back());
+		_FreeTransientCBViews.pop_back();
+	}
+
+	n_verify_dbg(CB->SetViewRange(*_TransientCB, Offset, Size));
+	return CB;
+}
+//---------------------------------------------------------------------
+
 PConstantBuffer CD3D11GPUDriver::CreateTemporaryConstantBuffer(IConstantBufferParam& Param)
 {
 	auto pUSMParam = Param.As<CUSMConstantBufferParam>();
 	if (!pD3DDevice || !pUSMParam || !pUSMParam->GetSize()) return nullptr;
 
+	// Prefer a range in the transient ring. If it is full, fall back to a separate buffer.
+	if (_TransientCB && pUSMParam->GetType() == USMBuffer_Constant)
+		if (auto CB = AllocateTransientConstantBuffer(pUSMParam->GetSize()))
+			return CB;
+
 	// We create temporary buffers sized by powers of 2, to make reuse easier (the same
 	// principle as for a small allocator). 16 bytes is the smallest possible buffer.
 	UPTR NextPow2Size = std::max<U32>(16, Math::NextPow2(pUSMParam->GetSize())/* * ElementCount; //!!!for StructuredBuffer!*/);
@@ -1995,9 +2131,16 @@ void CD3D11GPUDriver::FreeTemporaryConstantBuffer(CConstantBuffer& Buffer)
 {
 	CD3D11ConstantBuffer& CB11 = (CD3D11ConstantBuffer&)Buffer;
 
+	// Ring memory of the view is reclaimed by a frame fence, only the view object is reused here
+	if (CB11.IsView() && !IsConstantBufferBound(&CB11))
+	{
+		_FreeTransientCBViews.push_back(&CB11);
+		return;
+	}
+
 	UPTR BufferSize = CB11.GetSizeInBytes();
 #ifdef _DEBUG
-	n_assert(BufferSize == Math::NextPow2(CB11.GetSizeInBytes()));
+	n_assert(CB11.IsView() || BufferSize == Math::NextPow2(CB11.GetSizeInBytes()));
 #endif
 
 	CTmpCB* pNewNode = TmpCBPool.Construct();
@@ -2093,6 +2236,13 @@ void CD3D11GPUDriver::FreePendingTemporaryBuffer(const CD3D11ConstantBuffer* pBu
 			if (pPrevNode) pPrevNode->pNext = pCurrNode->pNext;
 			else pPendingCBHead = pCurrNode->pNext;
 
+			if (pBuffer->IsView())
+			{
+				_FreeTransientCBViews.push_back(std::move(pCurrNode->CB));
+				TmpCBPool.Destroy(pCurrNode);
+				break;
+			}
+
 			UPTR BufferSize = pBuffer->GetSizeInBytes();
 			n_assert_dbg(BufferSize == Math::NextPow2(pBuffer->GetSizeInBytes()));
 			auto It = BufferPool.find(BufferSize);
@@ -3529,6 +3679,14 @@ bool CD3D11GPUDriver::CommitShaderConstants(CConstantBuffer& Buffer)
 		{
 			pD3DImmContext->UpdateSubresource(pBuffer, 0, nullptr, CB11.GetRAMCopy(), 0, 0);
 		}
+		else if (CB11.IsView())
+		{
+			// The ring is never discarded, fences guarantee that the GPU doesn't read this range anymore
+			D3D11_MAPPED_SUBRESOURCE MappedSubRsrc;
+			if (FAILED(pD3DImmContext->Map(pBuffer, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &MappedSubRsrc))) FAIL;
+			std::memcpy(static_cast<char*>(MappedSubRsrc.pData) + CB11.GetOffsetInBytes(), CB11.GetRAMCopy(), CB11.GetSizeInBytes());
+			pD3DImmContext->Unmap(pBuffer, 0);
+		}
 		else if (D3DUsage == D3D11_USAGE_DYNAMIC || D3DUsage == D3D11_USAGE_STAGING)
 		{
 			D3D11_MAPPED_SUBRESOURCE MappedSubRsrc;
@@ -1,6 +1,7 @@
 #pragma once
 #include <Render/GPUDriver.h>
 #include <Render/D3D11/D3D11SwapChain.h>
+#include <Render/FrameRingAllocator.h>
 #include <Data/FixedArray.h>
 #include <Data/StringID.h>
 #include <System/Allocators/PoolAllocator.h>
@@ -11,6 +12,7 @@
 struct IDXGISwapChain;
 struct ID3D11Device;
 struct ID3D11DeviceContext;
+struct ID3D11DeviceContext1;
 struct ID3D11InputLayout;
 struct ID3D11Buffer;
 struct ID3D11ShaderResourceView;
@@ -169,6 +171,14 @@ protected:
 	std::map<UPTR, CTmpCB*>				TmpStructuredBuffers;	// Key is a size (pow2), value is a linked list
 	CTmpCB*								pPendingCBHead = nullptr;
 
+	// Transient constant buffers are sub-allocated from one big dynamic buffer when D3D11.1 runtime
+	// supports constant buffer offsets. The ring memory is reused when the GPU finishes the frame.
+	static constexpr UPTR               TransientCBRingSize = 4 * 1024 * 1024;
+	ID3D11DeviceContext1*               _pD3DImmContext1 = nullptr;
+	PD3D11ConstantBuffer                _TransientCB;
+	CFrameRingAllocator                 _TransientCBRing;
+	std::vector<PD3D11ConstantBuffer>   _FreeTransientCBViews;
+
 	CD3D11GPUDriver(CD3D11DriverFactory& DriverFactory);
 
 	bool								OnOSWindowClosing(Events::CEventDispatcher* pDispatcher, const Events::CEventBase& Event);
@@ -198,6 +208,8 @@ protected:
 	void								UnbindSRV(EShaderType ShaderType, UPTR SlotIndex, ID3D11ShaderResourceView* pSRV);
 	bool								IsConstantBufferBound(const CD3D11ConstantBuffer* pBuffer, EShaderType ExceptStage = ShaderType_Invalid, UPTR ExceptSlot = 0);
 	void								FreePendingTemporaryBuffer(const CD3D11ConstantBuffer* pBuffer, EShaderType Stage, UPTR Slot);
+	bool								InitTransientConstantBuffers();
+	PD3D11ConstantBuffer				AllocateTransientConstantBuffer(UPTR Size);
 
 public:
 
@@ -0,0 +1,132 @@
+#include "FrameRingAllocator.h"
+#include <Render/GPUDriver.h>
+#include <Math/Math.h>
+
+namespace Render
+{
+
+void CFrameRingAllocator::Init(UPTR Capacity, U32 MaxFrameLatency)
+{
+	Reset();
+	_Capacity = Capacity;
+	_MaxFrameLatency = std::max<U32>(1, MaxFrameLatency);
+}
+//---------------------------------------------------------------------
+
+void CFrameRingAllocator::Reset()
+{
+	_Frames.clear();
+	_FreeFences.clear();
+	_Head = 0;
+	_Tail = 0;
+	_UsedSize = 0;
+	_FrameSize = 0;
+	_PeakUsedSize = 0;
+	_FrameIndex = 0;
+}
+//---------------------------------------------------------------------
+
+// Returns true if at least one frame was reclaimed
+bool CFrameRingAllocator::ReclaimCompletedFrames()
+{
+	bool Reclaimed = false;
+	while (!_Frames.empty())
+	{
+		auto& Frame = _Frames.front();
+		if (Frame.Fence ? !Frame.Fence->IsSignaled() : (_FrameIndex - Frame.FrameIndex < _MaxFrameLatency)) break;
+
+		_Tail = Frame.End;
+		_UsedSize -= Frame.Size;
+		if (Frame.Fence) _FreeFences.push_back(std::move(Frame.Fence));
+		_Frames.pop_front();
+		Reclaimed = true;
+	}
+
+	// Nothing is in use, restart from the beginning to reduce wrapping waste
+	if (!_UsedSize)
+	{
+		_Head = 0;
+		_Tail = 0;
+	}
+
+	return Reclaimed;
+}
+//---------------------------------------------------------------------
+
+// Doesn't block. If the ring is full, fails and the caller must use some other storage for the data.
+bool CFrameRingAllocator::Allocate(UPTR Size, UPTR Alignment, UPTR& OutOffset)
+{
+	n_assert_dbg(Alignment && Math::IsPow2(Alignment));
+
+	if (!Size || Size > _Capacity) FAIL;
+
+	do
+	{
+		const UPTR AlignedHead = Math::CeilToMultipleOfPow2(_Head, Alignment);
+		if (!_UsedSize || _Head > _Tail)
+		{
+			// Free space is [Head, Capacity) + [0, Tail)
+			if (AlignedHead + Size <= _Capacity)
+			{
+				OutOffset = AlignedHead;
+			}
+			else if (Size <= _Tail)
+			{
+				// Wrap, the tail of the ring is wasted until this frame is reclaimed
+				_UsedSize += _Capacity - _Head;
+				_FrameSize += _Capacity - _Head;
+				_Head = 0;
+				OutOffset = 0;
+			}
+			else continue;
+		}
+		else if (_Head < _Tail && AlignedHead + Size <= _Tail)
+		{
+			// Free space is [Head, Tail)
+			OutOffset = AlignedHead;
+		}
+		else continue;
+
+		const UPTR Consumed = OutOffset + Size - _Head;
+		_Head = OutOffset + Size;
+		_UsedSize += Consumed;
+		_FrameSize += Consumed;
+		_PeakUsedSize = std::max(_PeakUsedSize, _UsedSize);
+		OK;
+	}
+	while (ReclaimCompletedFrames());
+
+	FAIL;
+}
+//---------------------------------------------------------------------
+
+// Must be called after the last GPU command that reads data allocated in this frame
+void CFrameRingAllocator::EndFrame(CGPUDriver& GPU)
+{
+	++_FrameIndex;
+
+	if (_FrameSize)
+	{
+		PGPUFence Fence;
+		if (!_FreeFences.empty())
+		{
+			Fence = std::move(_FreeFences.back());
+			_FreeFences.pop_back();
+		}
+		else
+		{
+			Fence = GPU.CreateFence();
+		}
+
+		if (Fence && !GPU.SignalFence(*Fence)) Fence = nullptr;
+
+		_Frames.push_back({ std::move(Fence), _Head, _FrameSize, _FrameIndex });
+		_FrameSize = 0;
+	}
+
+	// Reclaim regularly, not only when the ring is full, to keep the used part compact
+	ReclaimCompletedFrames();
+}
+//---------------------------------------------------------------------
+
+}
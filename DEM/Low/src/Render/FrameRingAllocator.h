@@ -0,0 +1,53 @@
+#pragma once
+#include <Render/RenderFwd.h>
+#include <Render/GPUFence.h>
+#include <deque>
+
+// Sub-allocates offsets in a fixed size ring for transient per-frame GPU data, e.g. for
+// constant buffers that are written once and read by the GPU in the same frame. The allocator
+// doesn't own any memory, it only tracks ranges. Allocations are never freed individually. Instead
+// all memory allocated between two EndFrame() calls is reclaimed at once when the GPU signals the
+// fence issued for that frame, so that the CPU never overwrites data the GPU may still read.
+
+namespace Render
+{
+
+class CFrameRingAllocator final
+{
+protected:
+
+	struct CFrameRecord
+	{
+		PGPUFence Fence;      // May be null if fences are not supported, then frame latency is used
+		UPTR      End;        // Head position at the end of the frame
+		UPTR      Size;       // Bytes consumed by the frame including alignment and wrapping waste
+		U32       FrameIndex;
+	};
+
+	std::deque<CFrameRecord> _Frames;
+	std::vector<PGPUFence>   _FreeFences;
+	UPTR                     _Capacity = 0;
+	UPTR                     _Head = 0;      // Next free byte
+	UPTR                     _Tail = 0;      // Start of the oldest range still in use
+	UPTR                     _UsedSize = 0;  // Bytes in use, needed to distinguish a full ring from an empty one
+	UPTR                     _FrameSize = 0; // Bytes consumed by the current frame
+	UPTR                     _PeakUsedSize = 0;
+	U32                      _FrameIndex = 0;
+	U32                      _MaxFrameLatency = 3;
+
+	bool ReclaimCompletedFrames();
+
+public:
+
+	void Init(UPTR Capacity, U32 MaxFrameLatency = 3);
+	void Reset();
+
+	bool Allocate(UPTR Size, UPTR Alignment, UPTR& OutOffset);
+	void EndFrame(CGPUDriver& GPU);
+
+	UPTR GetCapacity() const { return _Capacity; }
+	UPTR GetUsedSize() const { return _UsedSize; }
+	UPTR GetPeakUsedSize() const { return _PeakUsedSize; }
+};
+
+}
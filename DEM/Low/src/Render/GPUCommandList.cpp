@@ -0,0 +1,201 @@
+#include "GPUCommandList.h"
+#include <Render/GPUDriver.h>
+#include <Render/ShaderParamStorage.h>
+#include <Render/ShaderParamTable.h>
+#include <Render/VertexLayout.h>
+#include <Render/VertexBuffer.h>
+#include <Render/IndexBuffer.h>
+#include <Render/RenderState.h>
+#include <Render/Texture.h>
+#include <Render/Sampler.h>
+
+namespace Render
+{
+
+void CGPUCommandList::Record(ECommand Type, const void* pTarget, const void* pArg, U32 Arg0, U32 Arg1, U32 Arg2, U32 Arg3, bool ColumnMajor)
+{
+	_Commands.push_back(CCommand{ const_cast<void*>(pTarget), const_cast<void*>(pArg), Arg0, Arg1, Arg2, Arg3, Type, ColumnMajor });
+}
+//---------------------------------------------------------------------
+
+U32 CGPUCommandList::RecordPayload(const void* pData, UPTR Size)
+{
+	const UPTR Offset = _Payload.size() * sizeof(CPayloadChunk);
+	_Payload.resize(_Payload.size() + (Size + sizeof(CPayloadChunk) - 1) / sizeof(CPayloadChunk));
+	std::memcpy(reinterpret_cast<U8*>(_Payload.data()) + Offset, pData, Size);
+	return static_cast<U32>(Offset);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::RecordConstant(ECommand Type, CShaderParamStorage& Storage, const CShaderConstantParam& Param, const void* pData, UPTR Size, U32 StartIndex, bool ColumnMajor)
+{
+	if (!Param || !pData || !Size) return;
+
+	const U32 PayloadOffset = RecordPayload(pData, Size);
+	Record(Type, &Storage, Param._Info.Get(), Param._Offset, PayloadOffset, static_cast<U32>(Size), StartIndex, ColumnMajor);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetVertexLayout(CVertexLayout* pVLayout)
+{
+	if (_pImmediateGPU) _pImmediateGPU->SetVertexLayout(pVLayout);
+	else Record(ECommand::SetVertexLayout, pVLayout);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetVertexBuffer(UPTR Index, CVertexBuffer* pVB, UPTR OffsetVertex)
+{
+	if (_pImmediateGPU) _pImmediateGPU->SetVertexBuffer(Index, pVB, OffsetVertex);
+	else Record(ECommand::SetVertexBuffer, pVB, nullptr, static_cast<U32>(Index), static_cast<U32>(OffsetVertex));
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetIndexBuffer(CIndexBuffer* pIB)
+{
+	if (_pImmediateGPU) _pImmediateGPU->SetIndexBuffer(pIB);
+	else Record(ECommand::SetIndexBuffer, pIB);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetRenderState(CRenderState* pState)
+{
+	if (_pImmediateGPU) _pImmediateGPU->SetRenderState(pState);
+	else Record(ECommand::SetRenderState, pState);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetRawConstant(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const void* pData, UPTR Size)
+{
+	if (_pImmediateGPU) Storage.SetRawConstant(Param, pData, Size);
+	else RecordConstant(ECommand::SetRawConstant, Storage, Param, pData, Size);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetUInt(CShaderParamStorage& Storage, const CShaderConstantParam& Param, U32 Value)
+{
+	if (_pImmediateGPU) Storage.SetUInt(Param, Value);
+	else RecordConstant(ECommand::SetUInt, Storage, Param, &Value, sizeof(U32));
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetMatrix(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const rtm::matrix4x4f& Value, bool ColumnMajor)
+{
+	if (_pImmediateGPU) Storage.SetMatrix(Param, Value, ColumnMajor);
+	else RecordConstant(ECommand::SetMatrix, Storage, Param, &Value, sizeof(rtm::matrix4x4f), 0, ColumnMajor);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::SetMatrixArray(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const rtm::matrix3x4f* pValues, UPTR Count, U32 StartIndex, bool ColumnMajor)
+{
+	if (_pImmediateGPU) Storage.SetMatrixArray(Param, pValues, Count, StartIndex, ColumnMajor);
+	else RecordConstant(ECommand::SetMatrixArray, Storage, Param, pValues, Count * sizeof(rtm::matrix3x4f), StartIndex, ColumnMajor);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::ApplyParams(CShaderParamStorage& Storage)
+{
+	if (_pImmediateGPU) n_verify_dbg(Storage.Apply());
+	else Record(ECommand::ApplyParams, &Storage);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::ApplyResource(const IResourceParam& Param, CTexture* pValue)
+{
+	if (_pImmediateGPU) Param.Apply(*_pImmediateGPU, pValue);
+	else Record(ECommand::ApplyResource, &Param, pValue);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::ApplySampler(const ISamplerParam& Param, CSampler* pValue)
+{
+	if (_pImmediateGPU) Param.Apply(*_pImmediateGPU, pValue);
+	else Record(ECommand::ApplySampler, &Param, pValue);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::Draw(const CPrimitiveGroup& PrimGroup)
+{
+	if (_pImmediateGPU) _pImmediateGPU->Draw(PrimGroup);
+	else Record(ECommand::Draw, &PrimGroup);
+}
+//---------------------------------------------------------------------
+
+void CGPUCommandList::DrawInstanced(const CPrimitiveGroup& PrimGroup, UPTR InstanceCount)
+{
+	if (_pImmediateGPU) _pImmediateGPU->DrawInstanced(PrimGroup, InstanceCount);
+	else Record(ECommand::DrawInstanced, &PrimGroup, nullptr, static_cast<U32>(InstanceCount));
+}
+//---------------------------------------------------------------------
+
+// Must be called on the thread that owns the GPU. Commands are executed in the order of recording.
+bool CGPUCommandList::Submit(CGPUDriver& GPU) const
+{
+	ZoneScoped;
+
+	n_assert_dbg(!_pImmediateGPU);
+
+	bool Result = true;
+	for (const auto& Cmd : _Commands)
+	{
+		switch (Cmd.Type)
+		{
+			case ECommand::SetVertexLayout:
+				GPU.SetVertexLayout(static_cast<CVertexLayout*>(Cmd.pTarget));
+				break;
+			case ECommand::SetVertexBuffer:
+				GPU.SetVertexBuffer(Cmd.Arg0, static_cast<CVertexBuffer*>(Cmd.pTarget), Cmd.Arg1);
+				break;
+			case ECommand::SetIndexBuffer:
+				GPU.SetIndexBuffer(static_cast<CIndexBuffer*>(Cmd.pTarget));
+				break;
+			case ECommand::SetRenderState:
+				GPU.SetRenderState(static_cast<CRenderState*>(Cmd.pTarget));
+				break;
+			case ECommand::SetRawConstant:
+			{
+				const CShaderConstantParam Param(static_cast<CShaderConstantInfo*>(Cmd.pArg), Cmd.Arg0);
+				static_cast<CShaderParamStorage*>(Cmd.pTarget)->SetRawConstant(Param, GetPayload<U8>(Cmd.Arg1), Cmd.Arg2);
+				break;
+			}
+			case ECommand::SetUInt:
+			{
+				const CShaderConstantParam Param(static_cast<CShaderConstantInfo*>(Cmd.pArg), Cmd.Arg0);
+				static_cast<CShaderParamStorage*>(Cmd.pTarget)->SetUInt(Param, *GetPayload<U32>(Cmd.Arg1));
+				break;
+			}
+			case ECommand::SetMatrix:
+			{
+				const CShaderConstantParam Param(static_cast<CShaderConstantInfo*>(Cmd.pArg), Cmd.Arg0);
+				static_cast<CShaderParamStorage*>(Cmd.pTarget)->SetMatrix(Param, *GetPayload<rtm::matrix4x4f>(Cmd.Arg1), Cmd.ColumnMajor);
+				break;
+			}
+			case ECommand::SetMatrixArray:
+			{
+				const CShaderConstantParam Param(static_cast<CShaderConstantInfo*>(Cmd.pArg), Cmd.Arg0);
+				const UPTR Count = Cmd.Arg2 / sizeof(rtm::matrix3x4f);
+				static_cast<CShaderParamStorage*>(Cmd.pTarget)->SetMatrixArray(Param, GetPayload<rtm::matrix3x4f>(Cmd.Arg1), Count, Cmd.Arg3, Cmd.ColumnMajor);
+				break;
+			}
+			case ECommand::ApplyParams:
+				Result &= static_cast<CShaderParamStorage*>(Cmd.pTarget)->Apply();
+				break;
+			case ECommand::ApplyResource:
+				Result &= static_cast<const IResourceParam*>(Cmd.pTarget)->Apply(GPU, static_cast<CTexture*>(Cmd.pArg));
+				break;
+			case ECommand::ApplySampler:
+				Result &= static_cast<const ISamplerParam*>(Cmd.pTarget)->Apply(GPU, static_cast<CSampler*>(Cmd.pArg));
+				break;
+			case ECommand::Draw:
+				Result &= GPU.Draw(*static_cast<const CPrimitiveGroup*>(Cmd.pTarget));
+				break;
+			case ECommand::DrawInstanced:
+				Result &= GPU.DrawInstanced(*static_cast<const CPrimitiveGroup*>(Cmd.pTarget), Cmd.Arg0);
+				break;
+		}
+	}
+
+	return Result;
+}
+//---------------------------------------------------------------------
+
+}
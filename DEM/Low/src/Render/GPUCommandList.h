@@ -0,0 +1,102 @@
+#pragma once
+#include <Render/RenderFwd.h>
+#include <rtm/matrix4x4f.h>
+#include <rtm/matrix3x4f.h>
+
+// A backend-agnostic list of rendering commands. Render phases and renderers write draw submission
+// work into it: geometry and render state setup, shader param updates and draws. A deferred list
+// only records commands and can be filled on any thread, then it is submitted to the GPU in order on
+// the thread that owns the driver. An immediate list forwards each call to the GPU right away, like
+// D3D11 immediate context does, so renderers have a single code path for both modes.
+// Recording never touches reference counters, which are not thread-safe, so all referenced objects
+// must stay alive until the list is submitted or cleared. Shader param storages are updated only
+// during submission, so their constant buffers are created and filled on the driver thread.
+
+namespace Render
+{
+class CShaderParamStorage;
+class CShaderConstantParam;
+class CShaderConstantInfo;
+class IResourceParam;
+class ISamplerParam;
+
+class CGPUCommandList final
+{
+protected:
+
+	enum class ECommand : U8
+	{
+		SetVertexLayout,
+		SetVertexBuffer,
+		SetIndexBuffer,
+		SetRenderState,
+		SetRawConstant,
+		SetUInt,
+		SetMatrix,
+		SetMatrixArray,
+		ApplyParams,
+		ApplyResource,
+		ApplySampler,
+		Draw,
+		DrawInstanced
+	};
+
+	struct CCommand
+	{
+		void*    pTarget; // Resource, state, param storage or param
+		void*    pArg;    // Constant info, texture, sampler or primitive group
+		U32      Arg0;    // Slot, constant offset or instance count
+		U32      Arg1;    // Vertex offset or payload offset
+		U32      Arg2;    // Payload size
+		U32      Arg3;    // Start index of an array
+		ECommand Type;
+		bool     ColumnMajor;
+	};
+
+	// Payload is 16-byte aligned for SIMD matrices
+	struct alignas(16) CPayloadChunk
+	{
+		U8 Bytes[16];
+	};
+
+	CGPUDriver*                _pImmediateGPU = nullptr;
+	std::vector<CCommand>      _Commands;
+	std::vector<CPayloadChunk> _Payload;
+
+	void     Record(ECommand Type, const void* pTarget, const void* pArg = nullptr, U32 Arg0 = 0, U32 Arg1 = 0, U32 Arg2 = 0, U32 Arg3 = 0, bool ColumnMajor = false);
+	U32      RecordPayload(const void* pData, UPTR Size);
+	void     RecordConstant(ECommand Type, CShaderParamStorage& Storage, const CShaderConstantParam& Param, const void* pData, UPTR Size, U32 StartIndex = 0, bool ColumnMajor = false);
+	template<typename T>
+	const T* GetPayload(U32 Offset) const { return reinterpret_cast<const T*>(reinterpret_cast<const U8*>(_Payload.data()) + Offset); }
+
+public:
+
+	CGPUCommandList(CGPUDriver* pImmediateGPU = nullptr) : _pImmediateGPU(pImmediateGPU) {}
+
+	void SetVertexLayout(CVertexLayout* pVLayout);
+	void SetVertexBuffer(UPTR Index, CVertexBuffer* pVB, UPTR OffsetVertex = 0);
+	void SetIndexBuffer(CIndexBuffer* pIB);
+	void SetRenderState(CRenderState* pState);
+
+	void SetRawConstant(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const void* pData, UPTR Size);
+	template<typename T>
+	void SetRawConstant(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const T& Data) { SetRawConstant(Storage, Param, &Data, sizeof(T)); }
+	void SetUInt(CShaderParamStorage& Storage, const CShaderConstantParam& Param, U32 Value);
+	void SetMatrix(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const rtm::matrix4x4f& Value, bool ColumnMajor = false);
+	void SetMatrixArray(CShaderParamStorage& Storage, const CShaderConstantParam& Param, const rtm::matrix3x4f* pValues, UPTR Count, U32 StartIndex = 0, bool ColumnMajor = false);
+	void ApplyParams(CShaderParamStorage& Storage);
+	void ApplyResource(const IResourceParam& Param, CTexture* pValue);
+	void ApplySampler(const ISamplerParam& Param, CSampler* pValue);
+
+	void Draw(const CPrimitiveGroup& PrimGroup);
+	void DrawInstanced(const CPrimitiveGroup& PrimGroup, UPTR InstanceCount);
+
+	bool Submit(CGPUDriver& GPU) const;
+	void Clear() { _Commands.clear(); _Payload.clear(); } // Keeps allocated memory for the next frame
+
+	bool IsImmediate() const { return !!_pImmediateGPU; }
+	bool IsEmpty() const { return _Commands.empty(); }
+	UPTR GetCommandCount() const { return _Commands.size(); }
+};
+
+}
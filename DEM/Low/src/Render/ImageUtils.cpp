@@ -6,7 +6,7 @@
 namespace Render
 {
 
-void __fastcall CopyImage(const CImageData& Src, const CImageData& Dest, UPTR Flags, const CCopyImageParams& Params)
+void CopyImage(const CImageData& Src, const CImageData& Dest, UPTR Flags, const CCopyImageParams& Params)
 {
 	const IPTR X = 0, Y = 1, Z = 2;
 
@@ -87,26 +87,26 @@ void __fastcall CopyImage(const CImageData& Src, const CImageData& Dest, UPTR Fl
 }
 //---------------------------------------------------------------------
 
-bool __fastcall CalcValidImageRegion(const Data::CBox* pInRegion, UPTR Dimensions,
+bool CalcValidImageRegion(const Data::CBox* pInRegion, UPTR Dimensions,
 									 UPTR ImageWidth, UPTR ImageHeight, UPTR ImageDepth,
 									 UPTR& OutOffsetX, UPTR& OutOffsetY, UPTR& OutOffsetZ,
 									 UPTR& OutSizeX, UPTR& OutSizeY, UPTR& OutSizeZ)
 {
 	if (pInRegion)
 	{
-		int OffsetX = std::max(pInRegion->X, 0);
+		int OffsetX = std::max<IPTR>(pInRegion->X, 0);
 		int SizeX = std::min(pInRegion->W, ImageWidth - OffsetX);
 		if (SizeX <= 0) FAIL;
 
 		if (Dimensions > 1)
 		{
-			int OffsetY = std::max(pInRegion->Y, 0);
+			int OffsetY = std::max<IPTR>(pInRegion->Y, 0);
 			int SizeY = std::min(pInRegion->H, ImageHeight - OffsetY);
 			if (SizeY <= 0) FAIL;
 
 			if (Dimensions > 2)
 			{
-				int OffsetZ = std::max(pInRegion->Z, 0);
+				int OffsetZ = std::max<IPTR>(pInRegion->Z, 0);
 				int SizeZ = std::min(pInRegion->D, ImageDepth - OffsetZ);
 				if (SizeZ <= 0) FAIL;
 
@@ -29,24 +29,24 @@ struct CCopyImageParams
 };
 
 // Source and destination formats must match, no conversion occurs //!!!can use custom memcpy substitutes as arg to allow conversion algorithms!
-void __fastcall CopyImage(const CImageData& Src, const CImageData& Dest, UPTR Flags, const CCopyImageParams& Params);
+void CopyImage(const CImageData& Src, const CImageData& Dest, UPTR Flags, const CCopyImageParams& Params);
 
 // pInRegion may be nullptr, which means that region covers the whole image
 // Dimensions is a number of image dimensions from 1 to 3
 // If region requested is degenerate, function returns false not finishing calculations
-bool __fastcall CalcValidImageRegion(const Data::CBox* pInRegion, UPTR Dimensions,
+bool CalcValidImageRegion(const Data::CBox* pInRegion, UPTR Dimensions,
 									 UPTR ImageWidth, UPTR ImageHeight, UPTR ImageDepth,
 									 UPTR& OutOffsetX, UPTR& OutOffsetY, UPTR& OutOffsetZ,
 									 UPTR& OutSizeX, UPTR& OutSizeY, UPTR& OutSizeZ);
 
-inline UPTR __fastcall CalcImageRowPitch(UPTR BitsPerPixel, UPTR Width, bool IsBlockCompressed = false)
+inline UPTR CalcImageRowPitch(UPTR BitsPerPixel, UPTR Width, bool IsBlockCompressed = false)
 {
 	if (IsBlockCompressed) return (((Width + 3) >> 2) * BitsPerPixel) << 1;
 	else return (Width * BitsPerPixel + 7) >> 3;
 }
 //---------------------------------------------------------------------
 
-inline UPTR __fastcall CalcImageSlicePitch(UPTR RowPitch, UPTR Height, bool IsBlockCompressed = false)
+inline UPTR CalcImageSlicePitch(UPTR RowPitch, UPTR Height, bool IsBlockCompressed = false)
 {
 	if (IsBlockCompressed) return ((Height + 3) >> 2) * RowPitch;
 	else return Height * RowPitch;
@@ -16,6 +16,7 @@ void CMeshData::Destroy()
 {
 	pGroupLODMapping = nullptr;
 	SAFE_FREE(pGroups);
+	_ShadowGroups.clear();
 }
 //---------------------------------------------------------------------
 
@@ -23,6 +24,7 @@ void CMeshData::InitGroups(CPrimitiveGroup* pData, UPTR Count, UPTR SubMeshCount
 {
 	pGroupLODMapping = nullptr;
 	SAFE_FREE(pGroups);
+	_ShadowGroups.clear();
 
 	_SubMeshCount = SubMeshCount;
 	_LODCount = LODCount;
@@ -101,8 +103,21 @@ void CMeshData::InitGroups(CPrimitiveGroup* pData, UPTR Count, UPTR SubMeshCount
 	std::memcpy(pGroups, pData, TotalSize);
 	if (UseMapping) pGroupLODMapping = (CPrimitiveGroup**)(pGroups + _GroupCount);
 
-	for (U8 i = 0; i < Count; ++i)
-		pGroups[i].IndexInMesh = i;
+	for (UPTR i = 0; i < Count; ++i)
+		pGroups[i].IndexInMesh = static_cast<U8>(i);
+}
+//---------------------------------------------------------------------
+
+// Shadow groups are supported only for direct mapping and must be set after InitGroups()
+void CMeshData::InitShadowGroups(const CPrimitiveGroup* pData, UPTR Count)
+{
+	n_assert(!pGroupLODMapping && Count == _SubMeshCount * _LODCount);
+
+	_ShadowGroups.assign(pData, pData + Count);
+
+	// Shadow geometry is a separate geometry for sorting purposes
+	for (UPTR i = 0; i < Count; ++i)
+		_ShadowGroups[i].IndexInMesh = static_cast<U8>(_GroupCount + i);
 }
 //---------------------------------------------------------------------
 
@@ -9,7 +9,8 @@
 // Renderers can determine desired LOD level, where 0 is the best, and request a mesh group
 // for the given submesh at the given LOD via GetGroup(Idx, LOD). Since some groups are shared between
 // multiple LODs, and some SubMeshes can have no group in a certain LOD, there is an additional
-// mapping layer, pGroupLODMapping.
+// mapping layer, pGroupLODMapping. Optional shadow groups reference the same vertices with indices
+// welded by position only, they are smaller and more cache friendly for depth-only rendering.
 
 namespace Data
 {
@@ -35,6 +36,8 @@ protected:
 	UPTR								_LODCount = 0;
 	UPTR								_GroupCount = 0;
 
+	std::vector<CPrimitiveGroup>		_ShadowGroups;				// [LOD][SubMeshIndex], empty if not provided
+
 	UPTR								BufferUseCounter = 0;
 
 public:
@@ -52,7 +55,9 @@ public:
 	void					Destroy();
 
 	void					InitGroups(CPrimitiveGroup* pData, UPTR Count, UPTR SubMeshCount, UPTR LODCount, bool UseMapping, bool UpdateAABBs);
+	void					InitShadowGroups(const CPrimitiveGroup* pData, UPTR Count);
 	const CPrimitiveGroup*	GetGroup(UPTR SubMeshIdx, UPTR LOD = 0) const;
+	const CPrimitiveGroup*	GetShadowGroup(UPTR SubMeshIdx, UPTR LOD = 0) const;
 	UPTR					GetSubMeshCount() const { return _SubMeshCount; }
 	UPTR					GetLODCount() const { return _LODCount; }
 	UPTR					GetGroupCount() const { return _GroupCount; }
@@ -76,4 +81,13 @@ inline const CPrimitiveGroup* CMeshData::GetGroup(UPTR SubMeshIdx, UPTR LOD) con
 }
 //---------------------------------------------------------------------
 
+// Falls back to a regular group if the mesh has no dedicated depth-only geometry
+inline const CPrimitiveGroup* CMeshData::GetShadowGroup(UPTR SubMeshIdx, UPTR LOD) const
+{
+	if (_ShadowGroups.empty()) return GetGroup(SubMeshIdx, LOD);
+	n_assert(LOD < _LODCount && SubMeshIdx < _SubMeshCount);
+	return &_ShadowGroups[LOD * _SubMeshCount + SubMeshIdx];
+}
+//---------------------------------------------------------------------
+
 }
@@ -197,14 +197,14 @@ DEM::Core::PObject CMeshGeneratorSphere::CreateResource(CStrID UID)
 	for (UPTR i = 1; i < _RowCount; ++i)
 	{
 		const float Latitude = LatitudeStepInRadians * i;
-		const float SinLat = std::sinf(Latitude);
-		const float CosLat = std::cosf(Latitude);
+		const float SinLat = std::sin(Latitude);
+		const float CosLat = std::cos(Latitude);
 
 		for (UPTR j = 0; j < MeridianCount; ++j)
 		{
 			const float Longitude = LongitudeStepInRadians * j;
-			const float SinLon = std::sinf(Longitude);
-			const float CosLon = std::cosf(Longitude);
+			const float SinLon = std::sin(Longitude);
+			const float CosLon = std::cos(Longitude);
 
 			// See https://en.wikipedia.org/wiki/Spherical_coordinate_system
 			// NB: catresian Z is up, but we use Y as up axis, so Y and Z are swapped
@@ -322,7 +322,7 @@ DEM::Core::PObject CMeshGeneratorCylinder::CreateResource(CStrID UID)
 	for (U16 i = 0; i < _SectorCount; ++i)
 	{
 		const float Longitude = StepInRadians * i;
-		Vertices.push_back({ Radius * std::sinf(Longitude), HalfHeight, Radius * std::cosf(Longitude) });
+		Vertices.push_back({ Radius * std::sin(Longitude), HalfHeight, Radius * std::cos(Longitude) });
 	}
 
 	// Bottom circle
@@ -431,7 +431,7 @@ DEM::Core::PObject CMeshGeneratorCone::CreateResource(CStrID UID)
 	for (U16 i = 0; i < _SectorCount; ++i)
 	{
 		const float Longitude = StepInRadians * i;
-		Vertices.push_back({ Radius * std::sinf(Longitude), -HalfHeight, Radius * std::cosf(Longitude) });
+		Vertices.push_back({ Radius * std::sin(Longitude), -HalfHeight, Radius * std::cos(Longitude) });
 	}
 
 	std::vector<U16> Indices;
@@ -38,9 +38,13 @@ DEM::Core::PObject CMeshLoaderMSH::CreateResource(CStrID UID)
 
 	U32 FormatVersion;
 	if (!Reader.Read(FormatVersion)) return nullptr;
+	if (FormatVersion != 0x00010000 && FormatVersion != 0x00020000) return nullptr;
 
-	U32 GroupCount, VertexCount, IndexCount;
-	if (!Reader.Read(GroupCount)) return nullptr;
+	// Since 0.2.0.0 groups are stored for each LOD, [LOD][SubMesh]
+	U32 SubMeshCount, LODCount = 1, VertexCount, IndexCount;
+	if (!Reader.Read(SubMeshCount)) return nullptr;
+	if (FormatVersion >= 0x00020000 && !Reader.Read(LODCount)) return nullptr;
+	if (!LODCount) return nullptr;
 	if (!Reader.Read(VertexCount)) return nullptr;
 	if (!Reader.Read(IndexCount)) return nullptr;
 
@@ -73,7 +77,7 @@ DEM::Core::PObject CMeshLoaderMSH::CreateResource(CStrID UID)
 		Component.PerInstanceData = false;
 	}
 
-	std::vector<Render::CPrimitiveGroup> Groups(GroupCount);
+	std::vector<Render::CPrimitiveGroup> Groups(SubMeshCount * LODCount);
 	for (auto& MeshGroup : Groups)
 	{
 		CMSHMeshGroup Group;
@@ -87,6 +91,20 @@ DEM::Core::PObject CMeshLoaderMSH::CreateResource(CStrID UID)
 		MeshGroup.AABB = Math::AABBFromMinMax(Math::ToSIMD(Group.AABBMin), Math::ToSIMD(Group.AABBMax));
 	}
 
+	// Optional depth-only groups share vertices with regular ones and reference position-deduplicated indices
+	std::vector<Render::CPrimitiveGroup> ShadowGroups;
+	U8 HasShadowGroups = 0;
+	if (FormatVersion >= 0x00020000 && !Reader.Read(HasShadowGroups)) return nullptr;
+	if (HasShadowGroups)
+	{
+		ShadowGroups = Groups;
+		for (auto& MeshGroup : ShadowGroups)
+		{
+			if (!Reader.Read(MeshGroup.FirstIndex)) return nullptr;
+			if (!Reader.Read(MeshGroup.IndexCount)) return nullptr;
+		}
+	}
+
 	U32 VertexStartPos, IndexStartPos;
 	if (!Reader.Read(VertexStartPos)) return nullptr;
 	if (!Reader.Read(IndexStartPos)) return nullptr;
@@ -109,7 +127,9 @@ DEM::Core::PObject CMeshLoaderMSH::CreateResource(CStrID UID)
 		Stream->Read(MeshData->IBData->GetPtr(), DataSize);
 	}
 
-	MeshData->InitGroups(Groups.data(), Groups.size(), Groups.size(), 1, false, false);
+	MeshData->InitGroups(Groups.data(), Groups.size(), SubMeshCount, LODCount, false, false);
+	if (!ShadowGroups.empty())
+		MeshData->InitShadowGroups(ShadowGroups.data(), ShadowGroups.size());
 
 	return MeshData;
 }
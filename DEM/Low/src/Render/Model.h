@@ -26,6 +26,9 @@ public:
 	const rtm::matrix3x4f*         pSkinPalette = nullptr; // nullptr if no skin
 	std::map<UPTR, CLight*>        Lights;
 	U32                            BoneCount = 0;
+	U32                            SkinPaletteVersion = 0;  // Changes when palette contents change
+	U32                            SkinDirtyBegin = 0;      // Bones changed by the last palette version
+	U32                            SkinDirtyEnd = 0;
 	U32                            ShaderTechIndex = INVALID_INDEX_T<U32>;
 };
 
@@ -5,7 +5,10 @@
 #include <Render/Mesh.h>
 #include <Render/Light.h>
 #include <Render/GPUDriver.h>
+#include <Render/GPUCommandList.h>
 #include <Core/Factory.h>
+#include <algorithm>
+#include <tuple>
 
 namespace Render
 {
@@ -16,6 +19,9 @@ CModelRenderer::CModelTechInterface* CModelRenderer::GetTechInterface(const CTec
 	auto It = _TechInterfaces.find(pTech);
 	if (It != _TechInterfaces.cend()) return &It->second;
 
+	// Param tables and the GPU are shared between renderer instances recording in parallel
+	std::lock_guard Lock(GetSharedStateMutex());
+
 	auto& TechInterface = _TechInterfaces[pTech];
 	TechInterface.TechLightCount = 0;
 
@@ -33,6 +39,13 @@ CModelRenderer::CModelTechInterface* CModelRenderer::GetTechInterface(const CTec
 		TechInterface.ConstInstanceData = pTech->GetParamTable().GetConstant(sidInstanceData);
 		TechInterface.ConstSkinPalette = pTech->GetParamTable().GetConstant(sidSkinPalette);
 
+		// A palette in its own buffer keeps contents between batches, so unchanged palettes aren't written again.
+		// Temporary buffers are released on apply and must be filled from scratch for each batch.
+		const auto SkinPaletteBufferIndex = TechInterface.ConstSkinPalette.GetConstantBufferIndex();
+		if (TechInterface.ConstSkinPalette && SkinPaletteBufferIndex != TechInterface.ConstInstanceData.GetConstantBufferIndex())
+			TechInterface.PersistentSkinPalette = !!TechInterface.PerInstanceParams.CreatePermanentConstantBuffer(
+				SkinPaletteBufferIndex, Access_CPU_Write | Access_GPU_Read, "SkinPalette");
+
 		if (auto Struct = TechInterface.ConstInstanceData[0])
 		{
 			TechInterface.MemberFirstBoneIndex = Struct[sidFirstBoneIndex];
@@ -63,17 +76,16 @@ bool CModelRenderer::BeginRange(const CRenderContext& Context)
 	_pCurrMesh = nullptr;
 	_pCurrGroup = nullptr;
 	_InstanceCount = 0;
+	_BufferedBoneCount = 0;
+	_Instances.clear();
 
 	OK;
 }
 //---------------------------------------------------------------------
 
-// For constant buffer handling see https://learn.microsoft.com/en-us/windows/win32/dxtecharts/direct3d10-frequently-asked-questions
 void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderable, IRenderModifier* pModifier)
 {
-	ZoneScoped;
-
-	CModel& Model = static_cast<CModel&>(Renderable);
+	const CModel& Model = static_cast<const CModel&>(Renderable);
 
 	const CTechnique* pTech = Context.pShaderTechCache[Model.ShaderTechIndex];
 	if (!pTech) return;
@@ -90,13 +102,93 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 	n_assert_dbg(pGroup);
 	if (!pGroup) return;
 
+	// The same order of keys as in the render queue, so that grouping preserves state sorting as much as possible
+	const U64 SortKey = (static_cast<U64>(Model.ShaderTechKey) << 32) | (static_cast<U64>(Model.MaterialKey) << 16) | Model.GeometryKey;
+	const bool OrderDependent = (pTech->GetEffect()->GetType() == EEffectType::EffectType_AlphaBlend);
+	const CInstanceRecord Record{ &Model, pTech, pMaterial, pMesh, pGroup, SortKey, OrderDependent };
+
+	if (pModifier)
+	{
+		// Modifier object may not outlive this call, so the instance is added right now after everything collected before it
+		BatchCollectedInstances(Context);
+		AddInstance(Context, Record, pModifier);
+	}
+	else
+	{
+		_Instances.push_back(Record);
+	}
+}
+//---------------------------------------------------------------------
+
+// Sorts runs of order independent instances so that instances of the same batch are adjacent.
+// Order dependent instances stay in place and split runs. Sorting is stable, so the queue
+// order is preserved between instances of the same batch.
+void CModelRenderer::GroupCollectedInstances()
+{
+	ZoneScoped;
+
+	const auto BatchLess = [](const CInstanceRecord& a, const CInstanceRecord& b)
+	{
+		if (a.SortKey != b.SortKey) return a.SortKey < b.SortKey;
+		return std::tie(a.pTech, a.pMaterial, a.pMesh, a.pGroup) < std::tie(b.pTech, b.pMaterial, b.pMesh, b.pGroup);
+	};
+
+	auto ItRunStart = _Instances.begin();
+	while (ItRunStart != _Instances.end())
+	{
+		if (ItRunStart->OrderDependent)
+		{
+			++ItRunStart;
+			continue;
+		}
+
+		const auto ItRunEnd = std::find_if(ItRunStart, _Instances.end(), [](const CInstanceRecord& Record) { return Record.OrderDependent; });
+		if (!std::is_sorted(ItRunStart, ItRunEnd, BatchLess))
+		{
+			std::stable_sort(ItRunStart, ItRunEnd, BatchLess);
+			++_Stats.ReorderedRangeCount;
+		}
+
+		ItRunStart = ItRunEnd;
+	}
+}
+//---------------------------------------------------------------------
+
+void CModelRenderer::BatchCollectedInstances(const CRenderContext& Context)
+{
+	if (_Instances.empty()) return;
+
+	ZoneScoped;
+
+	GroupCollectedInstances();
+
+	for (const auto& Record : _Instances)
+		AddInstance(Context, Record, nullptr);
+
+	_Instances.clear();
+}
+//---------------------------------------------------------------------
+
+// For constant buffer handling see https://learn.microsoft.com/en-us/windows/win32/dxtecharts/direct3d10-frequently-asked-questions
+void CModelRenderer::AddInstance(const CRenderContext& Context, const CInstanceRecord& Record, IRenderModifier* pModifier)
+{
+	const CModel& Model = *Record.pModel;
+	const CTechnique* pTech = Record.pTech;
+	CMaterial* pMaterial = Record.pMaterial;
+	const CMesh* pMesh = Record.pMesh;
+	const CPrimitiveGroup* pGroup = Record.pGroup;
+
 	auto& GPU = *Context.pGPU;
+	auto& CmdList = *Context.pCommandList;
+
+	// Modifiers write to param storages directly, which is correct only when commands aren't deferred
+	n_assert_dbg(!pModifier || CmdList.IsImmediate());
 
 	// Detect batch breaking, commit collected instances to GPU and prepare the new batch
 
 	if (pTech != _pCurrTech)
 	{
-		if (_InstanceCount) CommitCollectedInstances(GPU);
+		if (_InstanceCount) CommitCollectedInstances(CmdList);
 
 		_pCurrTech = pTech;
 		_pCurrTechInterface = GetTechInterface(pTech, GPU);
@@ -111,32 +203,32 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 			(_InstanceCount && Model.BoneCount && !_pCurrTechInterface->MemberFirstBoneIndex) ||
 			(_BufferedBoneCount && Model.BoneCount > _pCurrTechInterface->ConstSkinPalette.GetElementCount() - _BufferedBoneCount))
 		{
-			CommitCollectedInstances(GPU);
+			CommitCollectedInstances(CmdList);
 		}
 	}
 
 	if (_pCurrTechInterface->TechNeedsMaterial && pMaterial != _pCurrMaterial)
 	{
-		if (_InstanceCount) CommitCollectedInstances(GPU);
+		if (_InstanceCount) CommitCollectedInstances(CmdList);
 
 		_pCurrMaterial = pMaterial;
-		n_verify_dbg(pMaterial->Apply());
+		CmdList.ApplyParams(pMaterial->GetValues());
 	}
 
 	if (pMesh != _pCurrMesh)
 	{
-		if (_InstanceCount) CommitCollectedInstances(GPU);
+		if (_InstanceCount) CommitCollectedInstances(CmdList);
 
 		auto pVB = pMesh->GetVertexBuffer().Get();
-		GPU.SetVertexLayout(pVB->GetVertexLayout());
-		GPU.SetVertexBuffer(0, pVB);
-		GPU.SetIndexBuffer(pMesh->GetIndexBuffer().Get());
+		CmdList.SetVertexLayout(pVB->GetVertexLayout());
+		CmdList.SetVertexBuffer(0, pVB);
+		CmdList.SetIndexBuffer(pMesh->GetIndexBuffer().Get());
 		_pCurrMesh = pMesh;
 	}
 
 	if (pGroup != _pCurrGroup)
 	{
-		if (_InstanceCount) CommitCollectedInstances(GPU);
+		if (_InstanceCount) CommitCollectedInstances(CmdList);
 
 		_pCurrGroup = pGroup;
 	}
@@ -146,7 +238,7 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 	if (_pCurrTechInterface->MemberWorldMatrix)
 	{
 		_pCurrTechInterface->MemberWorldMatrix.Shift(_pCurrTechInterface->ConstInstanceData, _InstanceCount);
-		_pCurrTechInterface->PerInstanceParams.SetMatrix(_pCurrTechInterface->MemberWorldMatrix, Model.Transform);
+		CmdList.SetMatrix(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->MemberWorldMatrix, Model.Transform);
 	}
 
 	if (Model.pSkinPalette)
@@ -154,13 +246,12 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 		if (_pCurrTechInterface->MemberFirstBoneIndex)
 		{
 			_pCurrTechInterface->MemberFirstBoneIndex.Shift(_pCurrTechInterface->ConstInstanceData, _InstanceCount);
-			_pCurrTechInterface->PerInstanceParams.SetUInt(_pCurrTechInterface->MemberFirstBoneIndex, _BufferedBoneCount);
+			CmdList.SetUInt(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->MemberFirstBoneIndex, _BufferedBoneCount);
 		}
 
 		//!!!this allows using _ConstSkinPalette curcularly with no_overwrite! if out of space, wrap and discard and start filling from beginning. Hide inside CShaderParamStorage?
-		//!!!make sure that only a changed part of the buffer is updated and submitted to GPU!
-		const auto InstanceBoneCount = std::min(Model.BoneCount, _pCurrTechInterface->ConstSkinPalette.GetElementCount() - _BufferedBoneCount);
-		_pCurrTechInterface->PerInstanceParams.SetMatrixArray(_pCurrTechInterface->ConstSkinPalette, Model.pSkinPalette, InstanceBoneCount, _BufferedBoneCount);
+		const auto InstanceBoneCount = static_cast<U32>(std::min<UPTR>(Model.BoneCount, _pCurrTechInterface->ConstSkinPalette.GetElementCount() - _BufferedBoneCount));
+		WriteSkinPalette(CmdList, Model, InstanceBoneCount);
 		_BufferedBoneCount += InstanceBoneCount;
 	}
 
@@ -182,12 +273,13 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 		if (_LightIndexBuffer.size() < _pCurrTechInterface->TechLightCount)
 			_LightIndexBuffer.push_back(-1);
 
-		_pCurrTechInterface->PerInstanceParams.SetRawConstant(_pCurrTechInterface->MemberLightIndices, _LightIndexBuffer.data(), sizeof(U32) * _LightIndexBuffer.size());
+		CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->MemberLightIndices, _LightIndexBuffer.data(), sizeof(U32) * _LightIndexBuffer.size());
 	}
 
 	if (pModifier) pModifier->ModifyPerInstanceShaderParams(_pCurrTechInterface->PerInstanceParams, _InstanceCount);
 
 	++_InstanceCount;
+	++_Stats.InstanceCount;
 
 	//!!!updating big CB loads the bus with unnecessary bytes. Using big per-instance data array for few instances will pass too many unnecessary traffic.
 	//what about UpdateSubresource? Can it make this better? Could exploit no-overwrite and offsets to avoid stalls drawing from previous region!
@@ -213,18 +305,74 @@ void CModelRenderer::Render(const CRenderContext& Context, IRenderable& Renderab
 }
 //---------------------------------------------------------------------
 
+// Writes the model's palette at the current offset in the palette buffer. A persistent buffer remembers which
+// palette version occupies each range, so an unchanged palette is not written at all, and a palette that advanced
+// by one version since it was written is written only in its dirty range. Skipping the write leaves the buffer
+// clean, and Apply() then only binds it without committing anything to the GPU.
+void CModelRenderer::WriteSkinPalette(CGPUCommandList& CmdList, const CModel& Model, U32 BoneCount)
+{
+	auto& TechInterface = *_pCurrTechInterface;
+	const auto Offset = static_cast<U32>(_BufferedBoneCount);
+
+	U32 Begin = 0;
+	U32 End = BoneCount;
+	if (TechInterface.PersistentSkinPalette)
+	{
+		auto& Ranges = TechInterface.SkinPaletteRanges;
+		auto It = std::find_if(Ranges.begin(), Ranges.end(), [&Model, Offset, BoneCount](const CSkinPaletteRange& Range)
+		{
+			return Range.pPalette == Model.pSkinPalette && Range.Offset == Offset && Range.Count == BoneCount;
+		});
+
+		if (It != Ranges.end())
+		{
+			if (It->Version == Model.SkinPaletteVersion)
+			{
+				++_Stats.SkippedPaletteCount;
+				return;
+			}
+
+			if (It->Version + 1 == Model.SkinPaletteVersion)
+			{
+				Begin = std::min(Model.SkinDirtyBegin, BoneCount);
+				End = std::min(Model.SkinDirtyEnd, BoneCount);
+			}
+
+			It->Version = Model.SkinPaletteVersion;
+		}
+		else
+		{
+			// Forget palettes overwritten by this one
+			Ranges.erase(std::remove_if(Ranges.begin(), Ranges.end(), [Offset, BoneCount](const CSkinPaletteRange& Range)
+			{
+				return Range.Offset < Offset + BoneCount && Offset < Range.Offset + Range.Count;
+			}), Ranges.end());
+
+			Ranges.push_back({ Model.pSkinPalette, Model.SkinPaletteVersion, Offset, BoneCount });
+		}
+	}
+
+	if (Begin < End)
+		CmdList.SetMatrixArray(TechInterface.PerInstanceParams, TechInterface.ConstSkinPalette, Model.pSkinPalette + Begin, End - Begin, Offset + Begin);
+}
+//---------------------------------------------------------------------
+
 void CModelRenderer::EndRange(const CRenderContext& Context)
 {
-	if (_InstanceCount) CommitCollectedInstances(*Context.pGPU);
+	BatchCollectedInstances(Context);
+	if (_InstanceCount) CommitCollectedInstances(*Context.pCommandList);
 }
 //---------------------------------------------------------------------
 
-void CModelRenderer::CommitCollectedInstances(CGPUDriver& GPU)
+void CModelRenderer::CommitCollectedInstances(CGPUCommandList& CmdList)
 {
 	//!!!PERF: needs testing on big scene. Check is moved outside the call to reduce redundant call count, but is it necessary?
 	n_assert_dbg(_InstanceCount);
 
-	_pCurrTechInterface->PerInstanceParams.Apply();
+	CmdList.ApplyParams(_pCurrTechInterface->PerInstanceParams);
+
+	++_Stats.BatchCount;
+	_Stats.DrawCallCount += static_cast<U32>(_pCurrTech->GetPasses().size());
 
 	//???need multipass techs or move that to another layer of logic?! multipass tech kills shader sorting and leads to render state switches.
 	//but it keeps material and mesh, and maybe even cached intermediate data like GPU skinned vertices buffer.
@@ -232,11 +380,11 @@ void CModelRenderer::CommitCollectedInstances(CGPUDriver& GPU)
 	//may remove pass arrays from tech and leave there only one render state, or at least a set of states for different factor (instance limit etc)
 	for (const auto& Pass : _pCurrTech->GetPasses())
 	{
-		GPU.SetRenderState(Pass);
+		CmdList.SetRenderState(Pass);
 		if (_InstanceCount > 1)
-			GPU.DrawInstanced(*_pCurrGroup, _InstanceCount);
+			CmdList.DrawInstanced(*_pCurrGroup, _InstanceCount);
 		else
-			GPU.Draw(*_pCurrGroup); //!!!TODO PERF: check if this is better for a single object! DrawInstanced(1) works either! Maybe there is no profit in branching here!
+			CmdList.Draw(*_pCurrGroup); //!!!TODO PERF: check if this is better for a single object! DrawInstanced(1) works either! Maybe there is no profit in branching here!
 	}
 
 	_InstanceCount = 0;
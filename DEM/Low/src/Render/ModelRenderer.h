@@ -5,9 +5,14 @@
 
 // Default renderer for CModel render objects.
 // Implements "Model" and "ModelSkinned" input sets.
+// Models are collected during the range and batched in EndRange(). Before batching, instances with
+// the same tech, material and geometry are grouped together even if they weren't adjacent in the
+// queue, so that each group is drawn with as few instanced draw calls as the tech limits allow.
+// Alpha blended models are never reordered, because their order in the queue is significant.
 
 namespace Render
 {
+class CModel;
 
 class CModelRenderer: public IRenderer
 {
@@ -15,6 +20,25 @@ class CModelRenderer: public IRenderer
 
 protected:
 
+	struct CInstanceRecord
+	{
+		const CModel*          pModel;
+		const CTechnique*      pTech;
+		CMaterial*             pMaterial;
+		const CMesh*           pMesh;
+		const CPrimitiveGroup* pGroup;
+		U64                    SortKey;
+		bool                   OrderDependent;
+	};
+
+	struct CSkinPaletteRange
+	{
+		const rtm::matrix3x4f* pPalette;
+		U32                    Version;
+		U32                    Offset;
+		U32                    Count;
+	};
+
 	struct CModelTechInterface
 	{
 		CShaderParamStorage  PerInstanceParams;
@@ -25,9 +49,12 @@ protected:
 		CShaderConstantParam MemberFirstBoneIndex;
 		CShaderConstantParam MemberLightIndices;
 
+		std::vector<CSkinPaletteRange> SkinPaletteRanges; // Palettes held by a persistent palette buffer
+
 		UPTR TechMaxInstanceCount = 1;
 		U32  TechLightCount = 0;
 		bool TechNeedsMaterial = false;
+		bool PersistentSkinPalette = false;
 	};
 
 	const CTechnique* _pCurrTech = nullptr;
@@ -40,9 +67,15 @@ protected:
 
 	std::map<const CTechnique*, CModelTechInterface> _TechInterfaces;
 	std::vector<U32> _LightIndexBuffer; // here to avoid per frame reallocation
+	std::vector<CInstanceRecord> _Instances; // collected in a range, batched at its end
+	CRenderStats _Stats;
 
 	CModelTechInterface* GetTechInterface(const CTechnique* pTech, CGPUDriver& GPU);
-	void CommitCollectedInstances(CGPUDriver& GPU);
+	void GroupCollectedInstances();
+	void BatchCollectedInstances(const CRenderContext& Context);
+	void AddInstance(const CRenderContext& Context, const CInstanceRecord& Record, IRenderModifier* pModifier);
+	void WriteSkinPalette(CGPUCommandList& CmdList, const CModel& Model, U32 BoneCount);
+	void CommitCollectedInstances(CGPUCommandList& CmdList);
 
 public:
 
@@ -51,6 +84,9 @@ public:
 	virtual bool BeginRange(const CRenderContext& Context) override;
 	virtual void Render(const CRenderContext& Context, IRenderable& Renderable, IRenderModifier* pModifier = nullptr) override;
 	virtual void EndRange(const CRenderContext& Context) override;
+
+	virtual void AccumulateStats(CRenderStats& Out) const override { Out += _Stats; }
+	virtual void ResetStats() override { _Stats = {}; }
 };
 
 }
@@ -0,0 +1,48 @@
+#include "NullDriverFactory.h"
+#include <Render/Null/NullGPUDriver.h>
+#include <Render/DisplayDriver.h>
+
+namespace Render
+{
+
+bool CNullDriverFactory::GetAdapterInfo(UPTR Adapter, CAdapterInfo& OutInfo) const
+{
+	if (!AdapterExists(Adapter)) FAIL;
+
+	OutInfo.Description = "Null GPU";
+	OutInfo.VendorID = 0;
+	OutInfo.DeviceID = 0;
+	OutInfo.SubSysID = 0;
+	OutInfo.Revision = 0;
+	OutInfo.VideoMemBytes = 0;
+	OutInfo.DedicatedSystemMemBytes = 0;
+	OutInfo.SharedSystemMemBytes = 0;
+	OutInfo.IsSoftware = true;
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// There are no outputs, so no displays can be created
+PDisplayDriver CNullDriverFactory::CreateDisplayDriver(UPTR Adapter, UPTR Output)
+{
+	return nullptr;
+}
+//---------------------------------------------------------------------
+
+// Only the null driver type is supported, auto selection resolves to it
+PGPUDriver CNullDriverFactory::CreateGPUDriver(UPTR Adapter, EGPUDriverType DriverType)
+{
+	n_assert(_Created);
+
+	if (Adapter == Adapter_AutoSelect) Adapter = 0;
+	if (!AdapterExists(Adapter)) return nullptr;
+	if (DriverType != GPU_AutoSelect && DriverType != GPU_Null) return nullptr;
+
+	PNullGPUDriver Driver = n_new(CNullGPUDriver());
+	if (!Driver->Init(Adapter, GPU_Null)) Driver = nullptr;
+	return Driver.Get();
+}
+//---------------------------------------------------------------------
+
+}
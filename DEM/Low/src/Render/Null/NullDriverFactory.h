@@ -0,0 +1,35 @@
+#pragma once
+#include <Render/VideoDriverFactory.h>
+
+// Null implementation of CVideoDriverFactory. Exposes one software adapter without outputs,
+// which creates CNullGPUDriver. Use it for headless runs, CPU profiling of the render pipeline
+// and for counting draws and state changes without a GPU.
+
+namespace Render
+{
+
+class CNullDriverFactory: public CVideoDriverFactory
+{
+	RTTI_CLASS_DECL(Render::CNullDriverFactory, Render::CVideoDriverFactory);
+
+protected:
+
+	bool                    _Created = false;
+
+public:
+
+	virtual bool			Create() override { _Created = true; OK; }
+	virtual void			Release() override { _Created = false; }
+	bool					IsOpened() const { return _Created; }
+
+	virtual bool			AdapterExists(UPTR Adapter) const override { return _Created && Adapter == 0; }
+	virtual UPTR			GetAdapterCount() const override { return _Created ? 1 : 0; }
+	virtual bool			GetAdapterInfo(UPTR Adapter, CAdapterInfo& OutInfo) const override;
+	virtual UPTR			GetAdapterOutputCount(UPTR Adapter) const override { return 0; }
+	virtual PDisplayDriver	CreateDisplayDriver(UPTR Adapter = 0, UPTR Output = 0) override;
+	virtual PGPUDriver		CreateGPUDriver(UPTR Adapter = Adapter_AutoSelect, EGPUDriverType DriverType = GPU_AutoSelect) override;
+};
+
+typedef Ptr<CNullDriverFactory> PNullDriverFactory;
+
+}
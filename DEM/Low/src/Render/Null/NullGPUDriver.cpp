@@ -0,0 +1,888 @@
+#include "NullGPUDriver.h"
+#include <Render/Null/NullResources.h>
+#include <Render/Null/NullShaderMetadata.h>
+#include <Render/TextureData.h>
+#include <Render/DisplayDriver.h>
+#include <System/OSWindow.h>
+#include <IO/BinaryReader.h>
+#include <IO/Stream.h>
+#include <Data/Buffer.h>
+
+namespace Render
+{
+
+U32 CNullGPUFrameStats::GetStateChangeCount() const
+{
+	U32 Count = 0;
+	for (auto Cmd = ENullGPUCommand::SetViewport; Cmd <= ENullGPUCommand::BindSampler; Cmd = static_cast<ENullGPUCommand>(static_cast<U8>(Cmd) + 1))
+		Count += Get(Cmd);
+	return Count;
+}
+//---------------------------------------------------------------------
+
+U32 CNullGPUFrameStats::GetRedundantStateChangeCount() const
+{
+	U32 Count = 0;
+	for (auto Cmd = ENullGPUCommand::SetViewport; Cmd <= ENullGPUCommand::BindSampler; Cmd = static_cast<ENullGPUCommand>(static_cast<U8>(Cmd) + 1))
+		Count += GetRedundant(Cmd);
+	return Count;
+}
+//---------------------------------------------------------------------
+
+CNullGPUDriver::CNullGPUDriver() = default;
+//---------------------------------------------------------------------
+
+CNullGPUDriver::~CNullGPUDriver() = default;
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::Init(UPTR AdapterNumber, EGPUDriverType DriverType)
+{
+	if (!CGPUDriver::Init(AdapterNumber, DriverType)) FAIL;
+
+	// Pretend to be a D3D11 class device, because the driver accepts the same compiled shaders
+	Type = GPU_Null;
+	FeatureLevel = GPU_Level_D3D11_0;
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::Record(ENullGPUCommand Type, const void* pObject, U32 Arg0, U32 Arg1, U32 Arg2, U8 ShaderType)
+{
+	++_Stats.Commands[static_cast<size_t>(Type)];
+	if (_Recording)
+		_Commands.push_back(CNullGPUCommand{ pObject, Arg0, Arg1, Arg2, Type, ShaderType });
+}
+//---------------------------------------------------------------------
+
+int CNullGPUDriver::CreateSwapChain(const CRenderTargetDesc& BackBufferDesc, const CSwapChainDesc& SwapChainDesc, DEM::Sys::COSWindow* pWindow)
+{
+	// Headless swap chains have no window, their back buffer size must be specified or the default one is used
+	U32 Width = static_cast<U32>(BackBufferDesc.Width);
+	U32 Height = static_cast<U32>(BackBufferDesc.Height);
+	if (pWindow)
+	{
+		PrepareWindowAndBackBufferSize(*pWindow, Width, Height);
+		if (!Width) Width = pWindow->GetWidth();
+		if (!Height) Height = pWindow->GetHeight();
+	}
+	if (!Width) Width = DEFAULT_BACK_BUFFER_WIDTH;
+	if (!Height) Height = DEFAULT_BACK_BUFFER_HEIGHT;
+
+	CRenderTargetDesc RTDesc = BackBufferDesc;
+	RTDesc.Width = Width;
+	RTDesc.Height = Height;
+	RTDesc.MipLevels = 1;
+	RTDesc.UseAsShaderInput = false;
+
+	auto SwapChain = std::make_unique<CSwapChain>();
+	SwapChain->BackBufferRT = n_new(CNullRenderTarget(RTDesc, nullptr));
+	SwapChain->TargetWindow = pWindow;
+
+	// Reuse a free slot to keep IDs of other swap chains valid
+	auto It = std::find(_SwapChains.begin(), _SwapChains.end(), nullptr);
+	if (It != _SwapChains.end())
+	{
+		*It = std::move(SwapChain);
+		return static_cast<int>(std::distance(_SwapChains.begin(), It));
+	}
+
+	_SwapChains.push_back(std::move(SwapChain));
+	return static_cast<int>(_SwapChains.size() - 1);
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::DestroySwapChain(UPTR SwapChainID)
+{
+	if (!SwapChainExists(SwapChainID)) FAIL;
+
+	auto& SwapChain = _SwapChains[SwapChainID];
+	for (auto& RT : _CurrRT)
+		if (RT == SwapChain->BackBufferRT)
+			RT = nullptr;
+
+	SwapChain.reset();
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::ResizeSwapChain(UPTR SwapChainID, unsigned int Width, unsigned int Height)
+{
+	if (!SwapChainExists(SwapChainID)) FAIL;
+
+	auto& SwapChain = *_SwapChains[SwapChainID];
+	CRenderTargetDesc RTDesc = SwapChain.BackBufferRT->GetDesc();
+	if (Width) RTDesc.Width = Width;
+	if (Height) RTDesc.Height = Height;
+
+	PRenderTarget NewRT = n_new(CNullRenderTarget(RTDesc, nullptr));
+	for (auto& RT : _CurrRT)
+		if (RT == SwapChain.BackBufferRT)
+			RT = NewRT;
+	SwapChain.BackBufferRT = std::move(NewRT);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+PRenderTarget CNullGPUDriver::GetSwapChainRenderTarget(UPTR SwapChainID) const
+{
+	const auto* pSwapChain = GetSwapChain(SwapChainID);
+	return pSwapChain ? pSwapChain->BackBufferRT : nullptr;
+}
+//---------------------------------------------------------------------
+
+DEM::Sys::COSWindow* CNullGPUDriver::GetSwapChainWindow(UPTR SwapChainID) const
+{
+	const auto* pSwapChain = GetSwapChain(SwapChainID);
+	return pSwapChain ? pSwapChain->TargetWindow.Get() : nullptr;
+}
+//---------------------------------------------------------------------
+
+// There are no displays, swap chains never go fullscreen
+PDisplayDriver CNullGPUDriver::GetSwapChainDisplay(UPTR SwapChainID) const
+{
+	return nullptr;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::Present(UPTR SwapChainID)
+{
+	if (!SwapChainExists(SwapChainID)) FAIL;
+	++_SwapChains[SwapChainID]->FrameID;
+	Record(ENullGPUCommand::Present, _SwapChains[SwapChainID]->BackBufferRT.Get(), static_cast<U32>(SwapChainID));
+	OK;
+}
+//---------------------------------------------------------------------
+
+PVertexLayout CNullGPUDriver::CreateVertexLayout(const CVertexComponent* pComponents, UPTR Count)
+{
+	PNullVertexLayout Layout = n_new(CNullVertexLayout);
+	if (!Layout->Create(pComponents, Count)) return nullptr;
+	return Layout.Get();
+}
+//---------------------------------------------------------------------
+
+PVertexBuffer CNullGPUDriver::CreateVertexBuffer(CVertexLayout& VertexLayout, UPTR VertexCount, UPTR AccessFlags, const void* pData)
+{
+	PNullVertexBuffer VB = n_new(CNullVertexBuffer);
+	if (!VB->Create(VertexLayout, VertexCount, AccessFlags, pData)) return nullptr;
+	return VB.Get();
+}
+//---------------------------------------------------------------------
+
+PIndexBuffer CNullGPUDriver::CreateIndexBuffer(EIndexType IndexType, UPTR IndexCount, UPTR AccessFlags, const void* pData)
+{
+	PNullIndexBuffer IB = n_new(CNullIndexBuffer);
+	if (!IB->Create(IndexType, IndexCount, AccessFlags, pData)) return nullptr;
+	return IB.Get();
+}
+//---------------------------------------------------------------------
+
+PRenderState CNullGPUDriver::CreateRenderState(const CRenderStateDesc& Desc)
+{
+	return n_new(CNullRenderState(Desc));
+}
+//---------------------------------------------------------------------
+
+// Reads the same file format as CD3D11GPUDriver::CreateShader, the shader binary itself is skipped
+PShader CNullGPUDriver::CreateShader(IO::IStream& Stream, bool LoadParamTable)
+{
+	IO::CBinaryReader R(Stream);
+
+	U32 ShaderFormatCode;
+	if (!R.Read(ShaderFormatCode) || !SupportsShaderFormat(ShaderFormatCode)) return nullptr;
+
+	U32 MinFeatureLevel;
+	if (!R.Read(MinFeatureLevel) || static_cast<EGPUFeatureLevel>(MinFeatureLevel) > FeatureLevel) return nullptr;
+
+	U8 ShaderTypeCode;
+	if (!R.Read(ShaderTypeCode)) return nullptr;
+	const auto ShaderType = static_cast<EShaderType>(ShaderTypeCode);
+	if (ShaderType >= ShaderType_COUNT) return nullptr;
+
+	U32 MetadataSize;
+	if (!R.Read(MetadataSize)) return nullptr;
+
+	U32 InputSignatureID;
+	if (!R.Read(InputSignatureID)) return nullptr;
+	MetadataSize -= sizeof(U32);
+
+	U64 RequiresFlags;
+	if (!R.Read(RequiresFlags)) return nullptr;
+	MetadataSize -= sizeof(U64);
+
+	PShaderParamTable Params;
+	if (LoadParamTable)
+	{
+		Params = LoadShaderParamTable(ShaderFormatCode, Stream);
+		if (!Params) return nullptr;
+	}
+	else
+	{
+		if (!Stream.Seek(MetadataSize, IO::Seek_Current)) return nullptr;
+	}
+
+	return n_new(CNullShader(ShaderType, InputSignatureID, Params));
+}
+//---------------------------------------------------------------------
+
+// Mirrors CD3D11GPUDriver::LoadShaderParamTable, but creates metadata that works with null resources
+PShaderParamTable CNullGPUDriver::LoadShaderParamTable(uint32_t ShaderFormatCode, IO::IStream& Stream)
+{
+	if (!SupportsShaderFormat(ShaderFormatCode)) return nullptr;
+
+	IO::CBinaryReader R(Stream);
+
+	U32 Count;
+
+	if (!R.Read(Count)) return nullptr;
+	std::vector<PConstantBufferParam> Buffers(Count);
+	for (auto& BufferPtr : Buffers)
+	{
+		auto Name = R.Read<CStrID>();
+		auto Register = R.Read<U32>();
+		auto Size = R.Read<U32>();
+
+		EUSMBufferType Type;
+		switch (Register >> 30)
+		{
+			case 0:		Type = USMBuffer_Constant; break;
+			case 1:		Type = USMBuffer_Texture; break;
+			case 2:		Type = USMBuffer_Structured; break;
+			default:	return nullptr;
+		};
+
+		Register &= 0x3fffffff; // Clear bits 30 and 31
+
+		BufferPtr = n_new(CNullConstantBufferParam(Name, 0, Type, Register, Size));
+	}
+
+	if (!R.Read(Count)) return nullptr;
+	std::vector<PShaderStructureInfo> Structs(Count);
+
+	// Precreate for valid referencing (see StructIndex)
+	for (auto& StructPtr : Structs)
+		StructPtr = n_new(CShaderStructureInfo);
+
+	for (auto& StructPtr : Structs)
+	{
+		std::vector<PShaderConstantInfo> Members(R.Read<U32>());
+		for (auto& MemberPtr : Members)
+		{
+			MemberPtr = n_new(CNullConstantInfo());
+			auto& Member = *static_cast<CNullConstantInfo*>(MemberPtr.Get());
+
+			if (!R.Read(Member.Name)) return nullptr;
+
+			U32 StructIndex;
+			if (!R.Read(StructIndex)) return nullptr;
+			if (StructIndex != static_cast<U32>(-1))
+				Member.Struct = Structs[StructIndex];
+
+			Member.Type = static_cast<EUSMConstType>(R.Read<U8>());
+			if (!R.Read(Member.LocalOffset)) return nullptr;
+			if (!R.Read(Member.ElementStride)) return nullptr;
+			if (!R.Read(Member.ElementCount)) return nullptr;
+			if (!R.Read(Member.Columns)) return nullptr;
+			if (!R.Read(Member.Rows)) return nullptr;
+			if (!R.Read(Member.Flags)) return nullptr;
+
+			Member.CalculateCachedValues();
+		}
+
+		StructPtr->SetMembers(std::move(Members));
+	}
+
+	if (!R.Read(Count)) return nullptr;
+	std::vector<CShaderConstantParam> Consts(Count);
+	for (auto& Const : Consts)
+	{
+		U8 ShaderTypeMask;
+		if (!R.Read(ShaderTypeMask)) return nullptr;
+
+		PNullConstantInfo Info = n_new(CNullConstantInfo());
+
+		if (!R.Read(Info->Name)) return nullptr;
+
+		if (!R.Read(Info->BufferIndex)) return nullptr;
+		if (Info->BufferIndex >= Buffers.size()) return nullptr;
+
+		U32 StructIndex;
+		if (!R.Read(StructIndex)) return nullptr;
+		if (StructIndex != static_cast<U32>(-1))
+			Info->Struct = Structs[StructIndex];
+
+		Info->Type = static_cast<EUSMConstType>(R.Read<U8>());
+
+		if (!R.Read(Info->LocalOffset)) return nullptr;
+		if (!R.Read(Info->ElementStride)) return nullptr;
+		if (!R.Read(Info->ElementCount)) return nullptr;
+		if (!R.Read(Info->Columns)) return nullptr;
+		if (!R.Read(Info->Rows)) return nullptr;
+		if (!R.Read(Info->Flags)) return nullptr;
+
+		static_cast<CNullConstantBufferParam*>(Buffers[Info->BufferIndex].Get())->AddShaderTypes(ShaderTypeMask);
+
+		Info->CalculateCachedValues();
+
+		Const = CShaderConstantParam(Info);
+	}
+
+	if (!R.Read(Count)) return nullptr;
+	std::vector<PResourceParam> Resources(Count);
+	for (auto& ResourcePtr : Resources)
+	{
+		auto ShaderTypeMask = R.Read<U8>();
+		auto Name = R.Read<CStrID>();
+		R.Read<U8>(); // Resource type
+		auto RegisterStart = R.Read<U32>();
+		R.Read<U32>(); // Register count
+		ResourcePtr = n_new(CNullResourceParam(Name, ShaderTypeMask, RegisterStart));
+	}
+
+	if (!R.Read(Count)) return nullptr;
+	std::vector<PSamplerParam> Samplers(Count);
+	for (auto& SamplerPtr : Samplers)
+	{
+		auto ShaderTypeMask = R.Read<U8>();
+		auto Name = R.Read<CStrID>();
+		auto RegisterStart = R.Read<U32>();
+		R.Read<U32>(); // Register count
+		SamplerPtr = n_new(CNullSamplerParam(Name, ShaderTypeMask, RegisterStart));
+	}
+
+	return n_new(CShaderParamTable(std::move(Consts), std::move(Buffers), std::move(Resources), std::move(Samplers)));
+}
+//---------------------------------------------------------------------
+
+PConstantBuffer CNullGPUDriver::CreateConstantBuffer(IConstantBufferParam& Param, UPTR AccessFlags, const CConstantBuffer* pData)
+{
+	auto pParam = Param.As<CNullConstantBufferParam>();
+	if (!pParam || !pParam->GetSize()) return nullptr;
+
+	PNullConstantBuffer CB = n_new(CNullConstantBuffer(pParam->GetType(), pParam->GetSize(), static_cast<U8>(AccessFlags), false));
+
+	if (auto pSrcCB = pData ? pData->As<CNullConstantBuffer>() : nullptr)
+		std::memcpy(CB->GetData(), pSrcCB->GetData(), std::min(CB->GetSizeInBytes(), pSrcCB->GetSizeInBytes()));
+
+	return CB.Get();
+}
+//---------------------------------------------------------------------
+
+// Temporary buffers are pooled by size like in D3D11, so that the CPU cost of their reuse is comparable
+PConstantBuffer CNullGPUDriver::CreateTemporaryConstantBuffer(IConstantBufferParam& Param)
+{
+	auto pParam = Param.As<CNullConstantBufferParam>();
+	if (!pParam || !pParam->GetSize()) return nullptr;
+
+	const UPTR Size = Math::NextPow2(pParam->GetSize());
+
+	auto& FreeBuffers = _FreeTmpBuffers[Size];
+	for (auto It = FreeBuffers.begin(); It != FreeBuffers.end(); ++It)
+	{
+		if ((*It)->GetType() == pParam->GetType())
+		{
+			PNullConstantBuffer CB = std::move(*It);
+			*It = std::move(FreeBuffers.back());
+			FreeBuffers.pop_back();
+			return CB.Get();
+		}
+	}
+
+	return n_new(CNullConstantBuffer(pParam->GetType(), static_cast<U32>(Size), static_cast<U8>(Access_CPU_Write | Access_GPU_Read), true));
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::FreeTemporaryConstantBuffer(CConstantBuffer& Buffer)
+{
+	auto pCB = Buffer.As<CNullConstantBuffer>();
+	if (!pCB || !pCB->IsTemporary()) return;
+
+	// No GPU is reading from the buffer, so it can be reused immediately
+	_FreeTmpBuffers[pCB->GetSizeInBytes()].push_back(pCB);
+}
+//---------------------------------------------------------------------
+
+PTexture CNullGPUDriver::CreateTexture(PTextureData Data, UPTR AccessFlags)
+{
+	PNullTexture Tex = n_new(CNullTexture);
+	if (!Tex->Create(std::move(Data), AccessFlags)) return nullptr;
+	return Tex.Get();
+}
+//---------------------------------------------------------------------
+
+PSampler CNullGPUDriver::CreateSampler(const CSamplerDesc& Desc)
+{
+	return n_new(CNullSampler(Desc));
+}
+//---------------------------------------------------------------------
+
+PTexture CNullGPUDriver::CreateRenderTargetTexture(const CRenderTargetDesc& Desc)
+{
+	if (!Desc.UseAsShaderInput) return nullptr;
+
+	PTextureData TexData = n_new(CTextureData);
+	TexData->Desc.Type = Texture_2D;
+	TexData->Desc.Width = Desc.Width;
+	TexData->Desc.Height = Desc.Height;
+	TexData->Desc.Depth = 1;
+	TexData->Desc.MipLevels = std::max<UPTR>(1, Desc.MipLevels);
+	TexData->Desc.ArraySize = 1;
+	TexData->Desc.Format = Desc.Format;
+	TexData->Desc.MSAAQuality = Desc.MSAAQuality;
+
+	return CreateTexture(TexData, Access_GPU_Read | Access_GPU_Write);
+}
+//---------------------------------------------------------------------
+
+PRenderTarget CNullGPUDriver::CreateRenderTarget(const CRenderTargetDesc& Desc)
+{
+	if (!Desc.Width || !Desc.Height) return nullptr;
+	return n_new(CNullRenderTarget(Desc, CreateRenderTargetTexture(Desc)));
+}
+//---------------------------------------------------------------------
+
+PDepthStencilBuffer CNullGPUDriver::CreateDepthStencilBuffer(const CRenderTargetDesc& Desc)
+{
+	if (!Desc.Width || !Desc.Height) return nullptr;
+	return n_new(CNullDepthStencilBuffer(Desc, CreateRenderTargetTexture(Desc)));
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetViewport(UPTR Index, const CViewport* pViewport)
+{
+	if (Index >= MAX_VIEWPORTS) FAIL;
+
+	const U32 Bit = (1 << Index);
+	if (pViewport)
+	{
+		if ((_VPSetFlags & Bit) && !std::memcmp(&_CurrVP[Index], pViewport, sizeof(CViewport)))
+		{
+			RecordRedundant(ENullGPUCommand::SetViewport);
+			OK;
+		}
+		_CurrVP[Index] = *pViewport;
+		_VPSetFlags |= Bit;
+	}
+	else
+	{
+		if (!(_VPSetFlags & Bit))
+		{
+			RecordRedundant(ENullGPUCommand::SetViewport);
+			OK;
+		}
+		_VPSetFlags &= ~Bit;
+	}
+
+	Record(ENullGPUCommand::SetViewport, nullptr, static_cast<U32>(Index));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::GetViewport(UPTR Index, CViewport& OutViewport)
+{
+	if (Index >= MAX_VIEWPORTS) FAIL;
+
+	if (_VPSetFlags & (1 << Index))
+	{
+		OutViewport = _CurrVP[Index];
+		OK;
+	}
+
+	// Default viewport covers the first render target
+	CRenderTarget* pRT = _CurrRT[0].Get();
+	if (!pRT) FAIL;
+
+	const auto& RTDesc = pRT->GetDesc();
+	OutViewport.Left = 0.f;
+	OutViewport.Top = 0.f;
+	OutViewport.Width = static_cast<float>(RTDesc.Width);
+	OutViewport.Height = static_cast<float>(RTDesc.Height);
+	OutViewport.MinDepth = 0.f;
+	OutViewport.MaxDepth = 1.f;
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetScissorRect(UPTR Index, const Data::CRect* pScissorRect)
+{
+	if (Index >= MAX_VIEWPORTS) FAIL;
+
+	const U32 Bit = (1 << Index);
+	if (pScissorRect)
+	{
+		if ((_SRSetFlags & Bit) && !std::memcmp(&_CurrSR[Index], pScissorRect, sizeof(Data::CRect)))
+		{
+			RecordRedundant(ENullGPUCommand::SetScissorRect);
+			OK;
+		}
+		_CurrSR[Index] = *pScissorRect;
+		_SRSetFlags |= Bit;
+	}
+	else
+	{
+		if (!(_SRSetFlags & Bit))
+		{
+			RecordRedundant(ENullGPUCommand::SetScissorRect);
+			OK;
+		}
+		_SRSetFlags &= ~Bit;
+	}
+
+	Record(ENullGPUCommand::SetScissorRect, nullptr, static_cast<U32>(Index));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::GetScissorRect(UPTR Index, Data::CRect& OutScissorRect)
+{
+	if (Index >= MAX_VIEWPORTS || !(_SRSetFlags & (1 << Index))) FAIL;
+	OutScissorRect = _CurrSR[Index];
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetVertexLayout(CVertexLayout* pVLayout)
+{
+	if (_CurrVL.Get() == pVLayout)
+	{
+		RecordRedundant(ENullGPUCommand::SetVertexLayout);
+		OK;
+	}
+
+	_CurrVL = pVLayout;
+	Record(ENullGPUCommand::SetVertexLayout, pVLayout);
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetVertexBuffer(UPTR Index, CVertexBuffer* pVB, UPTR OffsetVertex)
+{
+	if (Index >= MAX_VERTEX_STREAMS || (pVB && OffsetVertex >= pVB->GetVertexCount())) FAIL;
+
+	if (_CurrVB[Index].Get() == pVB && _CurrVBOffset[Index] == OffsetVertex)
+	{
+		RecordRedundant(ENullGPUCommand::SetVertexBuffer);
+		OK;
+	}
+
+	_CurrVB[Index] = pVB;
+	_CurrVBOffset[Index] = OffsetVertex;
+	Record(ENullGPUCommand::SetVertexBuffer, pVB, static_cast<U32>(Index), static_cast<U32>(OffsetVertex));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetIndexBuffer(CIndexBuffer* pIB)
+{
+	if (_CurrIB.Get() == pIB)
+	{
+		RecordRedundant(ENullGPUCommand::SetIndexBuffer);
+		OK;
+	}
+
+	_CurrIB = pIB;
+	Record(ENullGPUCommand::SetIndexBuffer, pIB);
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetRenderState(CRenderState* pState)
+{
+	if (_CurrRS.Get() == pState)
+	{
+		RecordRedundant(ENullGPUCommand::SetRenderState);
+		OK;
+	}
+
+	_CurrRS = pState;
+	Record(ENullGPUCommand::SetRenderState, pState);
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetRenderTarget(UPTR Index, CRenderTarget* pRT)
+{
+	if (Index >= MAX_RENDER_TARGETS) FAIL;
+
+	if (_CurrRT[Index].Get() == pRT)
+	{
+		RecordRedundant(ENullGPUCommand::SetRenderTarget);
+		OK;
+	}
+
+	_CurrRT[Index] = pRT;
+	Record(ENullGPUCommand::SetRenderTarget, pRT, static_cast<U32>(Index));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::SetDepthStencilBuffer(CDepthStencilBuffer* pDS)
+{
+	if (_CurrDS.Get() == pDS)
+	{
+		RecordRedundant(ENullGPUCommand::SetDepthStencilBuffer);
+		OK;
+	}
+
+	_CurrDS = pDS;
+	Record(ENullGPUCommand::SetDepthStencilBuffer, pDS);
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::Bind(ENullGPUCommand Type, EShaderType ShaderType, U32 Register, const void* pObject)
+{
+	if (ShaderType >= ShaderType_COUNT) FAIL;
+
+	const U64 Key = (static_cast<U64>(Type) << 40) | (static_cast<U64>(ShaderType) << 32) | Register;
+	auto It = _Bindings.find(Key);
+	const void* pCurrObject = (It == _Bindings.cend()) ? nullptr : It->second;
+	if (pCurrObject == pObject)
+	{
+		RecordRedundant(Type);
+		OK;
+	}
+
+	if (pObject)
+		_Bindings.insert_or_assign(Key, pObject);
+	else
+		_Bindings.erase(It);
+
+	Record(Type, pObject, Register, 0, 0, static_cast<U8>(ShaderType));
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::Unbind(ENullGPUCommand Type, EShaderType ShaderType, U32 Register, const void* pObject)
+{
+	if (ShaderType >= ShaderType_COUNT) return;
+
+	// Unbind only if the object is still bound, it may be already replaced
+	const U64 Key = (static_cast<U64>(Type) << 40) | (static_cast<U64>(ShaderType) << 32) | Register;
+	auto It = _Bindings.find(Key);
+	if (It == _Bindings.cend() || It->second != pObject) return;
+
+	_Bindings.erase(It);
+	Record(Type, nullptr, Register, 0, 0, static_cast<U8>(ShaderType));
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::BeginFrame()
+{
+	if (_InsideFrame) FAIL;
+
+	_InsideFrame = true;
+	_Commands.clear();
+	_Stats = {};
+
+#ifdef DEM_STATS
+	PrimitivesRendered = 0;
+	DrawsRendered = 0;
+#endif
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::EndFrame()
+{
+	_InsideFrame = false;
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::Clear(UPTR Flags, const vector4& ColorRGBA, float Depth, U8 Stencil)
+{
+	Record(ENullGPUCommand::Clear, nullptr, static_cast<U32>(Flags));
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::ClearRenderTarget(CRenderTarget& RT, const vector4& ColorRGBA)
+{
+	Record(ENullGPUCommand::ClearRenderTarget, &RT);
+}
+//---------------------------------------------------------------------
+
+void CNullGPUDriver::ClearDepthStencilBuffer(CDepthStencilBuffer& DS, UPTR Flags, float Depth, U8 Stencil)
+{
+	Record(ENullGPUCommand::ClearDepthStencilBuffer, &DS, static_cast<U32>(Flags));
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::InternalDraw(const CPrimitiveGroup& PrimGroup, bool Instanced, UPTR InstanceCount)
+{
+	n_assert_dbg(InstanceCount && (Instanced || InstanceCount == 1));
+
+	// Validate what a real driver would need to issue the draw
+	if (!_CurrVL || !_CurrRS) FAIL;
+	if (PrimGroup.IndexCount > 0 && !_CurrIB) FAIL;
+
+	UPTR PrimCount = (PrimGroup.IndexCount > 0) ? PrimGroup.IndexCount : PrimGroup.VertexCount;
+	switch (PrimGroup.Topology)
+	{
+		case Prim_PointList:	break;
+		case Prim_LineList:		PrimCount >>= 1; break;
+		case Prim_LineStrip:	--PrimCount; break;
+		case Prim_TriList:		PrimCount /= 3; break;
+		case Prim_TriStrip:		PrimCount -= 2; break;
+		default:				Sys::Error("CNullGPUDriver::Draw() -> Invalid primitive topology!"); FAIL;
+	}
+
+	_Stats.Primitives += InstanceCount * PrimCount;
+	_Stats.Instances += InstanceCount;
+
+	const bool Indexed = (PrimGroup.IndexCount > 0);
+	Record(Instanced ? ENullGPUCommand::DrawInstanced : ENullGPUCommand::Draw, _CurrRS.Get(),
+		static_cast<U32>(Indexed ? PrimGroup.IndexCount : PrimGroup.VertexCount),
+		static_cast<U32>(Indexed ? PrimGroup.FirstIndex : PrimGroup.FirstVertex),
+		static_cast<U32>(InstanceCount));
+
+#ifdef DEM_STATS
+	PrimitivesRendered += InstanceCount * PrimCount;
+	++DrawsRendered;
+#endif
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::MapResource(void** ppOutData, const CVertexBuffer& Resource, EResourceMapMode Mode)
+{
+	auto pVB = Resource.As<CNullVertexBuffer>();
+	if (!ppOutData || !pVB) FAIL;
+	*ppOutData = pVB->GetData();
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::MapResource(void** ppOutData, const CIndexBuffer& Resource, EResourceMapMode Mode)
+{
+	auto pIB = Resource.As<CNullIndexBuffer>();
+	if (!ppOutData || !pIB) FAIL;
+	*ppOutData = pIB->GetData();
+	OK;
+}
+//---------------------------------------------------------------------
+
+static bool ReadFromRAMBuffer(void* pDest, const char* pSrc, UPTR BufferSize, UPTR Size, UPTR Offset)
+{
+	if (!pDest || !pSrc || Offset >= BufferSize) FAIL;
+	const UPTR RequestedSize = Size ? Size : BufferSize;
+	std::memcpy(pDest, pSrc + Offset, std::min(RequestedSize, BufferSize - Offset));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::ReadFromResource(void* pDest, const CVertexBuffer& Resource, UPTR Size, UPTR Offset)
+{
+	auto pVB = Resource.As<CNullVertexBuffer>();
+	return pVB && ReadFromRAMBuffer(pDest, pVB->GetData(), pVB->GetSizeInBytes(), Size, Offset);
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::ReadFromResource(void* pDest, const CIndexBuffer& Resource, UPTR Size, UPTR Offset)
+{
+	auto pIB = Resource.As<CNullIndexBuffer>();
+	return pIB && ReadFromRAMBuffer(pDest, pIB->GetData(), pIB->GetSizeInBytes(), Size, Offset);
+}
+//---------------------------------------------------------------------
+
+static UPTR WriteToRAMBuffer(char* pDest, UPTR BufferSize, const void* pData, UPTR Size, UPTR Offset)
+{
+	if (!pDest || !pData || Offset >= BufferSize) return 0;
+	const UPTR RequestedSize = Size ? Size : BufferSize;
+	const UPTR SizeToCopy = std::min(RequestedSize, BufferSize - Offset);
+	std::memcpy(pDest + Offset, pData, SizeToCopy);
+	return SizeToCopy;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::WriteToResource(CVertexBuffer& Resource, const void* pData, UPTR Size, UPTR Offset)
+{
+	auto pVB = Resource.As<CNullVertexBuffer>();
+	if (!pVB) FAIL;
+
+	const UPTR Written = WriteToRAMBuffer(pVB->GetData(), pVB->GetSizeInBytes(), pData, Size, Offset);
+	if (!Written) FAIL;
+
+	_Stats.BytesWritten += Written;
+	Record(ENullGPUCommand::WriteBuffer, pVB, static_cast<U32>(Offset), static_cast<U32>(Written));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::WriteToResource(CIndexBuffer& Resource, const void* pData, UPTR Size, UPTR Offset)
+{
+	auto pIB = Resource.As<CNullIndexBuffer>();
+	if (!pIB) FAIL;
+
+	const UPTR Written = WriteToRAMBuffer(pIB->GetData(), pIB->GetSizeInBytes(), pData, Size, Offset);
+	if (!Written) FAIL;
+
+	_Stats.BytesWritten += Written;
+	Record(ENullGPUCommand::WriteBuffer, pIB, static_cast<U32>(Offset), static_cast<U32>(Written));
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Texture contents are not stored, only the traffic is accounted
+bool CNullGPUDriver::WriteToResource(CTexture& Resource, const CImageData& SrcData, UPTR ArraySlice, UPTR MipLevel, const Data::CBox* pRegion)
+{
+	if (!SrcData.pData) FAIL;
+	Record(ENullGPUCommand::WriteBuffer, &Resource, static_cast<U32>(ArraySlice), static_cast<U32>(MipLevel));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::WriteToResource(CConstantBuffer& Resource, const void* pData, UPTR Size, UPTR Offset)
+{
+	auto pCB = Resource.As<CNullConstantBuffer>();
+	if (!pCB) FAIL;
+
+	const UPTR Written = WriteToRAMBuffer(pCB->GetData(), pCB->GetSizeInBytes(), pData, Size, Offset);
+	if (!Written) FAIL;
+
+	_Stats.BytesWritten += Written;
+	Record(ENullGPUCommand::WriteBuffer, pCB, static_cast<U32>(Offset), static_cast<U32>(Written));
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::BeginShaderConstants(CConstantBuffer& Buffer)
+{
+	auto pCB = Buffer.As<CNullConstantBuffer>();
+	if (!pCB) FAIL;
+	pCB->OnBegin();
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullGPUDriver::CommitShaderConstants(CConstantBuffer& Buffer)
+{
+	auto pCB = Buffer.As<CNullConstantBuffer>();
+	if (!pCB) FAIL;
+
+	// A real driver uploads the whole buffer on commit
+	if (pCB->IsDirty())
+	{
+		_Stats.BytesWritten += pCB->GetSizeInBytes();
+		Record(ENullGPUCommand::CommitShaderConstants, pCB, 0, pCB->GetSizeInBytes());
+	}
+	else
+	{
+		RecordRedundant(ENullGPUCommand::CommitShaderConstants);
+	}
+
+	pCB->OnCommit();
+	OK;
+}
+//---------------------------------------------------------------------
+
+PGPUFence CNullGPUDriver::CreateFence()
+{
+	return n_new(CNullGPUFence());
+}
+//---------------------------------------------------------------------
+
+}
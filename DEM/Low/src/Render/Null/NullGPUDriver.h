@@ -0,0 +1,221 @@
+#pragma once
+#include <Render/GPUDriver.h>
+#include <Render/RenderFwd.h>
+#include <unordered_map>
+
+// Null GPU device driver. It renders nothing, but implements the full driver interface on the CPU,
+// so that the frame pipeline (views, render phases, renderers, shader params) can run and be profiled
+// on machines without a GPU. Calls are recorded into a compact command stream, and state changes
+// and draws are counted per frame. Redundant state changes are counted separately, which makes
+// the driver useful for catching batching and sorting regressions.
+
+namespace Render
+{
+typedef Ptr<class CNullConstantBuffer> PNullConstantBuffer;
+
+enum class ENullGPUCommand : U8
+{
+	SetViewport,
+	SetScissorRect,
+	SetVertexLayout,
+	SetVertexBuffer,
+	SetIndexBuffer,
+	SetRenderState,
+	SetRenderTarget,
+	SetDepthStencilBuffer,
+	BindConstantBuffer,
+	BindResource,
+	BindSampler,
+	Clear,
+	ClearRenderTarget,
+	ClearDepthStencilBuffer,
+	Draw,
+	DrawInstanced,
+	WriteBuffer,
+	CommitShaderConstants,
+	Present,
+
+	COUNT
+};
+
+struct CNullGPUCommand
+{
+	const void*     pObject; // Resource or state involved, may be nullptr
+	U32             Arg0;    // Slot or register, clear flags, index or vertex count
+	U32             Arg1;    // Offset, size, first index or vertex
+	U32             Arg2;    // Instance count
+	ENullGPUCommand Type;
+	U8              ShaderType;
+};
+
+struct CNullGPUFrameStats
+{
+	U32 Commands[static_cast<size_t>(ENullGPUCommand::COUNT)] = {};
+	U32 RedundantCommands[static_cast<size_t>(ENullGPUCommand::COUNT)] = {}; // Set and bind calls that didn't change anything
+	U64 Primitives = 0;
+	U64 Instances = 0;
+	U64 BytesWritten = 0;
+
+	U32 Get(ENullGPUCommand Cmd) const { return Commands[static_cast<size_t>(Cmd)]; }
+	U32 GetRedundant(ENullGPUCommand Cmd) const { return RedundantCommands[static_cast<size_t>(Cmd)]; }
+	U32 GetDrawCount() const { return Get(ENullGPUCommand::Draw) + Get(ENullGPUCommand::DrawInstanced); }
+	U32 GetStateChangeCount() const;
+	U32 GetRedundantStateChangeCount() const;
+};
+
+class CNullGPUDriver : public CGPUDriver
+{
+	RTTI_CLASS_DECL(Render::CNullGPUDriver, Render::CGPUDriver);
+
+public:
+
+	static constexpr UPTR MAX_VERTEX_STREAMS = 16;
+	static constexpr UPTR MAX_RENDER_TARGETS = 8;
+	static constexpr UPTR MAX_VIEWPORTS = 16;
+	static constexpr U32  DEFAULT_BACK_BUFFER_WIDTH = 1280;
+	static constexpr U32  DEFAULT_BACK_BUFFER_HEIGHT = 720;
+
+protected:
+
+	struct CSwapChain
+	{
+		PRenderTarget        BackBufferRT;
+		DEM::Sys::POSWindow  TargetWindow;
+		UPTR                 FrameID = 0;
+	};
+
+	PVertexLayout                 _CurrVL;
+	PVertexBuffer                 _CurrVB[MAX_VERTEX_STREAMS];
+	UPTR                          _CurrVBOffset[MAX_VERTEX_STREAMS] = {};
+	PIndexBuffer                  _CurrIB;
+	PRenderState                  _CurrRS;
+	PRenderTarget                 _CurrRT[MAX_RENDER_TARGETS];
+	PDepthStencilBuffer           _CurrDS;
+	CViewport                     _CurrVP[MAX_VIEWPORTS] = {};
+	Data::CRect                   _CurrSR[MAX_VIEWPORTS];
+	U32                           _VPSetFlags = 0;
+	U32                           _SRSetFlags = 0;
+
+	// Shader stage bindings, the key is a command type, a shader type and a register
+	std::unordered_map<U64, const void*> _Bindings;
+
+	std::vector<std::unique_ptr<CSwapChain>>            _SwapChains;
+	std::unordered_map<UPTR, std::vector<PNullConstantBuffer>> _FreeTmpBuffers; // Keyed by size
+
+	std::vector<CNullGPUCommand>  _Commands;
+	CNullGPUFrameStats            _Stats;
+	bool                          _Recording = true;
+	bool                          _InsideFrame = false;
+
+	void                          Record(ENullGPUCommand Type, const void* pObject, U32 Arg0 = 0, U32 Arg1 = 0, U32 Arg2 = 0, U8 ShaderType = ShaderType_Invalid);
+	void                          RecordRedundant(ENullGPUCommand Type) { ++_Stats.RedundantCommands[static_cast<size_t>(Type)]; }
+	bool                          InternalDraw(const CPrimitiveGroup& PrimGroup, bool Instanced, UPTR InstanceCount);
+	bool                          Bind(ENullGPUCommand Type, EShaderType ShaderType, U32 Register, const void* pObject);
+	void                          Unbind(ENullGPUCommand Type, EShaderType ShaderType, U32 Register, const void* pObject);
+	PTexture                      CreateRenderTargetTexture(const CRenderTargetDesc& Desc);
+	const CSwapChain*             GetSwapChain(UPTR SwapChainID) const { return (SwapChainID < _SwapChains.size()) ? _SwapChains[SwapChainID].get() : nullptr; }
+
+public:
+
+	CNullGPUDriver();
+	virtual ~CNullGPUDriver() override;
+
+	virtual bool				Init(UPTR AdapterNumber, EGPUDriverType DriverType) override;
+	virtual bool				CheckCaps(ECaps Cap) const override { OK; }
+	virtual bool				SupportsShaderFormat(U32 ShaderFormatCode) const override { return ShaderFormatCode == 'DXBC'; }
+	virtual UPTR				GetMaxVertexStreams() const override { return MAX_VERTEX_STREAMS; }
+	virtual UPTR				GetMaxTextureSize(ETextureType Type) const override { return 16384; }
+	virtual UPTR				GetMaxMultipleRenderTargetCount() const override { return MAX_RENDER_TARGETS; }
+
+	virtual int					CreateSwapChain(const CRenderTargetDesc& BackBufferDesc, const CSwapChainDesc& SwapChainDesc, DEM::Sys::COSWindow* pWindow) override;
+	virtual bool				DestroySwapChain(UPTR SwapChainID) override;
+	virtual bool				SwapChainExists(UPTR SwapChainID) const override { return !!GetSwapChain(SwapChainID); }
+	virtual bool				ResizeSwapChain(UPTR SwapChainID, unsigned int Width, unsigned int Height) override;
+	virtual bool				SwitchToFullscreen(UPTR SwapChainID, CDisplayDriver* pDisplay = nullptr, const CDisplayMode* pMode = nullptr) override { FAIL; }
+	virtual bool				SwitchToWindowed(UPTR SwapChainID, const Data::CRect* pWindowRect = nullptr) override { return SwapChainExists(SwapChainID); }
+	virtual bool				IsFullscreen(UPTR SwapChainID) const override { FAIL; }
+	virtual PRenderTarget		GetSwapChainRenderTarget(UPTR SwapChainID) const override;
+	virtual DEM::Sys::COSWindow*	GetSwapChainWindow(UPTR SwapChainID) const override;
+	virtual PDisplayDriver		GetSwapChainDisplay(UPTR SwapChainID) const override;
+	virtual bool				Present(UPTR SwapChainID) override;
+	virtual bool				CaptureScreenshot(UPTR SwapChainID, IO::IStream& OutStream) const override { FAIL; }
+
+	virtual PVertexLayout		CreateVertexLayout(const CVertexComponent* pComponents, UPTR Count) override;
+	virtual PVertexBuffer		CreateVertexBuffer(CVertexLayout& VertexLayout, UPTR VertexCount, UPTR AccessFlags, const void* pData = nullptr) override;
+	virtual PIndexBuffer		CreateIndexBuffer(EIndexType IndexType, UPTR IndexCount, UPTR AccessFlags, const void* pData = nullptr) override;
+	virtual PRenderState		CreateRenderState(const CRenderStateDesc& Desc) override;
+	virtual PShader				CreateShader(IO::IStream& Stream, bool LoadParamTable = true) override;
+	virtual PShaderParamTable   LoadShaderParamTable(uint32_t ShaderFormatCode, IO::IStream& Stream) override;
+	virtual PConstantBuffer		CreateConstantBuffer(IConstantBufferParam& Param, UPTR AccessFlags, const CConstantBuffer* pData = nullptr) override;
+	virtual PConstantBuffer		CreateTemporaryConstantBuffer(IConstantBufferParam& Param) override;
+	virtual void				FreeTemporaryConstantBuffer(CConstantBuffer& Buffer) override;
+	virtual PTexture			CreateTexture(PTextureData Data, UPTR AccessFlags) override;
+	virtual PSampler			CreateSampler(const CSamplerDesc& Desc) override;
+	virtual PRenderTarget		CreateRenderTarget(const CRenderTargetDesc& Desc) override;
+	virtual PDepthStencilBuffer	CreateDepthStencilBuffer(const CRenderTargetDesc& Desc) override;
+
+	virtual bool				SetViewport(UPTR Index, const CViewport* pViewport) override;
+	virtual bool				GetViewport(UPTR Index, CViewport& OutViewport) override;
+	virtual bool				SetScissorRect(UPTR Index, const Data::CRect* pScissorRect) override;
+	virtual bool				GetScissorRect(UPTR Index, Data::CRect& OutScissorRect) override;
+
+	virtual bool				SetVertexLayout(CVertexLayout* pVLayout) override;
+	virtual bool				SetVertexBuffer(UPTR Index, CVertexBuffer* pVB, UPTR OffsetVertex = 0) override;
+	virtual bool				SetIndexBuffer(CIndexBuffer* pIB) override;
+	virtual bool				SetRenderState(CRenderState* pState) override;
+	virtual bool				SetRenderTarget(UPTR Index, CRenderTarget* pRT) override;
+	virtual bool				SetDepthStencilBuffer(CDepthStencilBuffer* pDS) override;
+	virtual CRenderTarget*		GetRenderTarget(UPTR Index) const override { return (Index < MAX_RENDER_TARGETS) ? _CurrRT[Index].Get() : nullptr; }
+	virtual CDepthStencilBuffer* GetDepthStencilBuffer() const override { return _CurrDS.Get(); }
+
+	virtual bool				BeginFrame() override;
+	virtual void				EndFrame() override;
+	virtual void				Clear(UPTR Flags, const vector4& ColorRGBA, float Depth, U8 Stencil) override;
+	virtual void				ClearRenderTarget(CRenderTarget& RT, const vector4& ColorRGBA) override;
+	virtual void				ClearDepthStencilBuffer(CDepthStencilBuffer& DS, UPTR Flags, float Depth, U8 Stencil) override;
+	virtual bool				Draw(const CPrimitiveGroup& PrimGroup) override { return InternalDraw(PrimGroup, false, 1); }
+	virtual bool				DrawInstanced(const CPrimitiveGroup& PrimGroup, UPTR InstanceCount) override { return InternalDraw(PrimGroup, true, InstanceCount); }
+
+	virtual bool				MapResource(void** ppOutData, const CVertexBuffer& Resource, EResourceMapMode Mode) override;
+	virtual bool				MapResource(void** ppOutData, const CIndexBuffer& Resource, EResourceMapMode Mode) override;
+	virtual bool				MapResource(CImageData& OutData, const CTexture& Resource, EResourceMapMode Mode, UPTR ArraySlice = 0, UPTR MipLevel = 0) override { FAIL; }
+	virtual bool				UnmapResource(const CVertexBuffer& Resource) override { OK; }
+	virtual bool				UnmapResource(const CIndexBuffer& Resource) override { OK; }
+	virtual bool				UnmapResource(const CTexture& Resource, UPTR ArraySlice = 0, UPTR MipLevel = 0) override { FAIL; }
+	virtual bool				ReadFromResource(void* pDest, const CVertexBuffer& Resource, UPTR Size = 0, UPTR Offset = 0) override;
+	virtual bool				ReadFromResource(void* pDest, const CIndexBuffer& Resource, UPTR Size = 0, UPTR Offset = 0) override;
+	virtual bool				ReadFromResource(const CImageData& Dest, const CTexture& Resource, UPTR ArraySlice = 0, UPTR MipLevel = 0, const Data::CBox* pRegion = nullptr) override { FAIL; }
+	virtual bool                ReadFromResource(PTexture& Dest, const CRenderTarget& Resource, const Data::CRect* pRegion = nullptr) override { FAIL; }
+	virtual bool				WriteToResource(CVertexBuffer& Resource, const void* pData, UPTR Size = 0, UPTR Offset = 0) override;
+	virtual bool				WriteToResource(CIndexBuffer& Resource, const void* pData, UPTR Size = 0, UPTR Offset = 0) override;
+	virtual bool				WriteToResource(CTexture& Resource, const CImageData& SrcData, UPTR ArraySlice = 0, UPTR MipLevel = 0, const Data::CBox* pRegion = nullptr) override;
+	virtual bool				WriteToResource(CConstantBuffer& Resource, const void* pData, UPTR Size = 0, UPTR Offset = 0) override;
+
+	virtual bool				BeginShaderConstants(CConstantBuffer& Buffer) override;
+	virtual bool				CommitShaderConstants(CConstantBuffer& Buffer) override;
+
+	virtual PGPUFence           CreateFence() override;
+	virtual bool                SignalFence(IGPUFence& Fence) override { OK; }
+
+	virtual bool                IsRunningUnderGraphicsDebugger() const override { FAIL; }
+	virtual int                 DebugBeginEvent(const wchar_t* pName) const override { return 0; }
+	virtual int                 DebugEndEvent() const override { return 0; }
+	virtual void                DebugMarker(const wchar_t* pName) const override {}
+
+	bool                        BindConstantBuffer(EShaderType ShaderType, U32 Register, CConstantBuffer* pBuffer) { return Bind(ENullGPUCommand::BindConstantBuffer, ShaderType, Register, pBuffer); }
+	bool                        BindResource(EShaderType ShaderType, U32 Register, CTexture* pResource) { return Bind(ENullGPUCommand::BindResource, ShaderType, Register, pResource); }
+	bool                        BindSampler(EShaderType ShaderType, U32 Register, CSampler* pSampler) { return Bind(ENullGPUCommand::BindSampler, ShaderType, Register, pSampler); }
+	void                        UnbindConstantBuffer(EShaderType ShaderType, U32 Register, CConstantBuffer* pBuffer) { Unbind(ENullGPUCommand::BindConstantBuffer, ShaderType, Register, pBuffer); }
+	void                        UnbindResource(EShaderType ShaderType, U32 Register, CTexture* pResource) { Unbind(ENullGPUCommand::BindResource, ShaderType, Register, pResource); }
+	void                        UnbindSampler(EShaderType ShaderType, U32 Register, CSampler* pSampler) { Unbind(ENullGPUCommand::BindSampler, ShaderType, Register, pSampler); }
+
+	// Commands and stats are reset in BeginFrame and are valid until the next frame begins
+	void                        SetRecording(bool Enable) { _Recording = Enable; }
+	bool                        IsRecording() const { return _Recording; }
+	const auto&                 GetCommands() const { return _Commands; }
+	const CNullGPUFrameStats&   GetFrameStats() const { return _Stats; }
+};
+
+typedef Ptr<CNullGPUDriver> PNullGPUDriver;
+
+}
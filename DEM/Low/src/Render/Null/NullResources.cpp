@@ -0,0 +1,107 @@
+#include "NullResources.h"
+#include <Render/TextureData.h>
+#include <Render/ShaderParamTable.h>
+
+namespace Render
+{
+
+bool CNullVertexLayout::Create(const CVertexComponent* pComponents, UPTR Count)
+{
+	if (!pComponents || !Count) FAIL;
+
+	Components.RawCopyFrom(pComponents, Count);
+
+	_UserDefinedNames.clear();
+	_UserDefinedNames.reserve(Count);
+
+	UPTR VSize = 0;
+	for (UPTR i = 0; i < Count; ++i)
+	{
+		VSize += Components[i].GetSize();
+
+		// Don't reference caller memory, components can be built in temporary buffers
+		if (Components[i].UserDefinedName)
+		{
+			_UserDefinedNames.push_back(Components[i].UserDefinedName);
+			Components[i].UserDefinedName = _UserDefinedNames.back().c_str();
+		}
+	}
+	VertexSize = VSize;
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullVertexBuffer::Create(CVertexLayout& Layout, UPTR Count, UPTR AccessFlags, const void* pData)
+{
+	if (!Count || !Layout.GetVertexSizeInBytes()) FAIL;
+
+	VertexLayout = &Layout;
+	VertexCount = Count;
+	Access.ResetTo(AccessFlags);
+
+	const UPTR Size = GetSizeInBytes();
+	_Data.reset(new char[Size]);
+	if (pData) std::memcpy(_Data.get(), pData, Size);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+bool CNullIndexBuffer::Create(EIndexType Type, UPTR Count, UPTR AccessFlags, const void* pData)
+{
+	if (!Count) FAIL;
+
+	IndexType = Type;
+	IndexCount = Count;
+	Access.ResetTo(AccessFlags);
+
+	const UPTR Size = GetSizeInBytes();
+	_Data.reset(new char[Size]);
+	if (pData) std::memcpy(_Data.get(), pData, Size);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+CNullConstantBuffer::CNullConstantBuffer(EUSMBufferType Type, U32 SizeInBytes, U8 AccessFlags, bool Temporary)
+	: _Data(SizeInBytes ? new char[SizeInBytes]() : nullptr)
+	, _SizeInBytes(SizeInBytes)
+	, _Type(Type)
+	, _AccessFlags(AccessFlags)
+	, _Flags(Temporary ? CBNull_Temporary : 0)
+{
+}
+//---------------------------------------------------------------------
+
+void CNullConstantBuffer::WriteData(UPTR Offset, const void* pData, UPTR Size)
+{
+	n_assert_dbg(_Flags.Is(CBNull_InWriteMode) && pData && Size && _Data && (Offset + Size <= _SizeInBytes));
+	std::memcpy(_Data.get() + Offset, pData, Size);
+	_Flags.Set(CBNull_Dirty);
+}
+//---------------------------------------------------------------------
+
+// Texture contents are not needed without a GPU, so RAM data is not held
+bool CNullTexture::Create(PTextureData Data, UPTR AccessFlags)
+{
+	if (!Data) FAIL;
+
+	TextureData = std::move(Data);
+	Access.ResetTo(AccessFlags);
+	RowPitch = 0;
+	SlicePitch = 0;
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+CNullShader::CNullShader(EShaderType Type, U32 InputSignatureID, PShaderParamTable Params)
+	: _InputSignatureID(InputSignatureID)
+{
+	_Type = Type;
+	_Params = std::move(Params);
+}
+//---------------------------------------------------------------------
+
+}
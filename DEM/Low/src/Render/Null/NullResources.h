@@ -0,0 +1,211 @@
+#pragma once
+#include <Render/VertexLayout.h>
+#include <Render/VertexBuffer.h>
+#include <Render/IndexBuffer.h>
+#include <Render/ConstantBuffer.h>
+#include <Render/Texture.h>
+#include <Render/RenderTarget.h>
+#include <Render/DepthStencilBuffer.h>
+#include <Render/Sampler.h>
+#include <Render/SamplerDesc.h>
+#include <Render/RenderState.h>
+#include <Render/RenderStateDesc.h>
+#include <Render/Shader.h>
+#include <Render/GPUFence.h>
+#include <Render/D3D11/USMShaderMetadata.h> // Null driver accepts USM shaders
+
+// Null driver implementations of GPU resources. They have no API objects behind them, buffers are
+// emulated in RAM so that CPU-side code that maps, writes and reads them works as with a real GPU.
+
+namespace Render
+{
+
+class CNullVertexLayout : public CVertexLayout
+{
+	RTTI_CLASS_DECL(Render::CNullVertexLayout, Render::CVertexLayout);
+
+protected:
+
+	std::vector<std::string> _UserDefinedNames; // Owned copies, components point to them
+
+public:
+
+	bool         Create(const CVertexComponent* pComponents, UPTR Count);
+	virtual bool IsValid() const override { return VertexSize > 0; }
+};
+
+class CNullVertexBuffer : public CVertexBuffer
+{
+	RTTI_CLASS_DECL(Render::CNullVertexBuffer, Render::CVertexBuffer);
+
+protected:
+
+	std::unique_ptr<char[]> _Data;
+
+public:
+
+	bool         Create(CVertexLayout& Layout, UPTR Count, UPTR AccessFlags, const void* pData);
+	virtual void SetDebugName(std::string_view Name) override {}
+
+	char*        GetData() const { return _Data.get(); }
+};
+
+class CNullIndexBuffer : public CIndexBuffer
+{
+	RTTI_CLASS_DECL(Render::CNullIndexBuffer, Render::CIndexBuffer);
+
+protected:
+
+	std::unique_ptr<char[]> _Data;
+
+public:
+
+	bool         Create(EIndexType Type, UPTR Count, UPTR AccessFlags, const void* pData);
+	virtual bool IsValid() const override { return !!_Data; }
+	virtual void SetDebugName(std::string_view Name) override {}
+
+	char*        GetData() const { return _Data.get(); }
+};
+
+class CNullConstantBuffer : public CConstantBuffer
+{
+	RTTI_CLASS_DECL(Render::CNullConstantBuffer, Render::CConstantBuffer);
+
+protected:
+
+	enum
+	{
+		CBNull_Dirty       = 0x01,
+		CBNull_InWriteMode = 0x02,
+		CBNull_Temporary   = 0x04
+	};
+
+	std::unique_ptr<char[]> _Data;
+	U32                     _SizeInBytes;
+	EUSMBufferType          _Type;
+	U8                      _AccessFlags;
+	Data::CFlags            _Flags;
+
+public:
+
+	CNullConstantBuffer(EUSMBufferType Type, U32 SizeInBytes, U8 AccessFlags, bool Temporary);
+
+	virtual bool   IsValid() const override { return !!_Data; }
+	virtual bool   IsInWriteMode() const override { return _Flags.Is(CBNull_InWriteMode); }
+	virtual bool   IsDirty() const override { return _Flags.Is(CBNull_Dirty); }
+	virtual bool   IsTemporary() const override { return _Flags.Is(CBNull_Temporary); }
+	virtual U8     GetAccessFlags() const override { return _AccessFlags; }
+	virtual void   SetDebugName(std::string_view Name) override {}
+
+	void           WriteData(UPTR Offset, const void* pData, UPTR Size);
+	void           OnBegin() { _Flags.Set(CBNull_InWriteMode); }
+	void           OnCommit() { _Flags.Clear(CBNull_InWriteMode | CBNull_Dirty); }
+
+	char*          GetData() const { return _Data.get(); }
+	U32            GetSizeInBytes() const { return _SizeInBytes; }
+	EUSMBufferType GetType() const { return _Type; }
+};
+
+class CNullTexture : public CTexture
+{
+	RTTI_CLASS_DECL(Render::CNullTexture, Render::CTexture);
+
+public:
+
+	bool         Create(PTextureData Data, UPTR AccessFlags);
+	virtual void SetDebugName(std::string_view Name) override {}
+};
+
+class CNullRenderTarget : public CRenderTarget
+{
+	RTTI_CLASS_DECL(Render::CNullRenderTarget, Render::CRenderTarget);
+
+protected:
+
+	PTexture _Texture;
+
+public:
+
+	CNullRenderTarget(const CRenderTargetDesc& RTDesc, PTexture Texture) : _Texture(std::move(Texture)) { Desc = RTDesc; }
+
+	virtual void      Destroy() override { _Texture = nullptr; }
+	virtual bool      IsValid() const override { return Desc.Width && Desc.Height; }
+	virtual bool      CopyResolveToTexture(PTexture Dest) const override { return Dest.IsValidPtr(); }
+	virtual CTexture* GetShaderResource() const override { return _Texture.Get(); }
+	virtual void      SetDebugName(std::string_view Name) override {}
+};
+
+class CNullDepthStencilBuffer : public CDepthStencilBuffer
+{
+	RTTI_CLASS_DECL(Render::CNullDepthStencilBuffer, Render::CDepthStencilBuffer);
+
+protected:
+
+	PTexture _Texture;
+
+public:
+
+	CNullDepthStencilBuffer(const CRenderTargetDesc& DSDesc, PTexture Texture) : _Texture(std::move(Texture)) { Desc = DSDesc; }
+
+	virtual void      Destroy() override { _Texture = nullptr; }
+	virtual bool      IsValid() const override { return Desc.Width && Desc.Height; }
+	virtual CTexture* GetShaderResource() const override { return _Texture.Get(); }
+	virtual void      SetDebugName(std::string_view Name) override {}
+};
+
+class CNullSampler : public CSampler
+{
+	RTTI_CLASS_DECL(Render::CNullSampler, Render::CSampler);
+
+public:
+
+	CSamplerDesc Desc;
+
+	CNullSampler(const CSamplerDesc& SamplerDesc) : Desc(SamplerDesc) {}
+};
+
+class CNullRenderState : public CRenderState
+{
+	RTTI_CLASS_DECL(Render::CNullRenderState, Render::CRenderState);
+
+public:
+
+	CRenderStateDesc Desc;
+
+	CNullRenderState(const CRenderStateDesc& StateDesc) : Desc(StateDesc) {}
+};
+
+class CNullShader : public CShader
+{
+	RTTI_CLASS_DECL(Render::CNullShader, Render::CShader);
+
+protected:
+
+	U32 _InputSignatureID = 0;
+
+public:
+
+	CNullShader(EShaderType Type, U32 InputSignatureID, PShaderParamTable Params);
+
+	virtual bool IsValid() const override { return _Type != ShaderType_Invalid; }
+	virtual void SetDebugName(std::string_view Name) override {}
+
+	U32          GetInputSignatureID() const { return _InputSignatureID; }
+};
+
+// There is no GPU timeline, so any fence is signaled as soon as it is submitted
+class CNullGPUFence : public IGPUFence
+{
+public:
+
+	virtual bool IsSignaled() const override { OK; }
+	virtual void Wait() override {}
+};
+
+typedef Ptr<CNullVertexLayout> PNullVertexLayout;
+typedef Ptr<CNullVertexBuffer> PNullVertexBuffer;
+typedef Ptr<CNullIndexBuffer> PNullIndexBuffer;
+typedef Ptr<CNullConstantBuffer> PNullConstantBuffer;
+typedef Ptr<CNullTexture> PNullTexture;
+
+}
@@ -0,0 +1,218 @@
+#include "NullShaderMetadata.h"
+#include <Render/Null/NullGPUDriver.h>
+#include <Render/Null/NullResources.h>
+
+namespace Render
+{
+
+template<typename T, typename TSrc>
+static inline void ConvertAndWrite(CNullConstantBuffer& CB, U32 Offset, const TSrc* pValue, UPTR Count, UPTR DestSize)
+{
+	Count = std::min(Count, DestSize / sizeof(T));
+	const auto* pEnd = pValue + Count;
+	while (pValue < pEnd)
+	{
+		const T Value = static_cast<T>(*pValue);
+		CB.WriteData(Offset, &Value, sizeof(T));
+		++pValue;
+		Offset += sizeof(T);
+	}
+}
+//---------------------------------------------------------------------
+
+template<typename TSrc>
+static inline void WriteTyped(CConstantBuffer& CB, EUSMConstType Type, U32 Offset, const TSrc* pValue, UPTR Count, UPTR DestSize)
+{
+	if (!pValue || !Count) return;
+
+	auto pCB = CB.As<CNullConstantBuffer>();
+	if (!pCB) return;
+
+	switch (Type)
+	{
+		case USMConst_Float:
+		{
+			if constexpr (std::is_same_v<TSrc, float>)
+				pCB->WriteData(Offset, pValue, std::min(Count * sizeof(float), DestSize));
+			else
+				ConvertAndWrite<float>(*pCB, Offset, pValue, Count, DestSize);
+			break;
+		}
+		case USMConst_Int:
+		case USMConst_Bool:
+		{
+			if constexpr (std::is_same_v<TSrc, I32> || std::is_same_v<TSrc, U32>)
+				pCB->WriteData(Offset, pValue, std::min(Count * sizeof(I32), DestSize));
+			else
+				ConvertAndWrite<I32>(*pCB, Offset, pValue, Count, DestSize);
+			break;
+		}
+		default: ::Sys::Error("CNullConstantInfo > typed value writing allowed only for float, int & bool constants"); return;
+	}
+}
+//---------------------------------------------------------------------
+
+PShaderConstantInfo CNullConstantInfo::Clone() const
+{
+	PNullConstantInfo Info = n_new(CNullConstantInfo);
+	Info->CShaderConstantInfo_CopyFields(*this);
+	Info->Type = Type;
+	return Info;
+}
+//---------------------------------------------------------------------
+
+// https://docs.microsoft.com/en-us/windows/win32/direct3dhlsl/dx-graphics-hlsl-packing-rules
+void CNullConstantInfo::CalculateCachedValues()
+{
+	ComponentSize = 4; // All register components are 32-bit
+
+	if (Struct)
+	{
+		VectorStride = 0;
+		ElementSize = ElementStride;
+	}
+	else
+	{
+		const auto MajorDim = IsColumnMajor() ? Columns : Rows;
+		const auto MinorDim = IsColumnMajor() ? Rows : Columns;
+		VectorStride = (MajorDim > 1 ? 4 : MinorDim) * ComponentSize;
+		ElementSize = (MajorDim - 1) * VectorStride + MinorDim * ComponentSize;
+	}
+
+	// For an array don't add padding of the last element
+	TotalSize = ElementCount ? ((ElementCount - 1) * ElementStride + ElementSize) : ElementSize;
+}
+//---------------------------------------------------------------------
+
+void CNullConstantInfo::SetRawValue(CConstantBuffer& CB, U32 Offset, const void* pValue, UPTR Size) const
+{
+	if (!pValue || !Size) return;
+
+	if (auto pCB = CB.As<CNullConstantBuffer>())
+		pCB->WriteData(Offset, pValue, std::min<UPTR>(Size, TotalSize));
+}
+//---------------------------------------------------------------------
+
+void CNullConstantInfo::SetFloats(CConstantBuffer& CB, U32 Offset, const float* pValue, UPTR Count) const
+{
+	WriteTyped(CB, Type, Offset, pValue, Count, TotalSize);
+}
+//---------------------------------------------------------------------
+
+void CNullConstantInfo::SetInts(CConstantBuffer& CB, U32 Offset, const I32* pValue, UPTR Count) const
+{
+	WriteTyped(CB, Type, Offset, pValue, Count, TotalSize);
+}
+//---------------------------------------------------------------------
+
+void CNullConstantInfo::SetUInts(CConstantBuffer& CB, U32 Offset, const U32* pValue, UPTR Count) const
+{
+	WriteTyped(CB, Type, Offset, pValue, Count, TotalSize);
+}
+//---------------------------------------------------------------------
+
+void CNullConstantInfo::SetBools(CConstantBuffer& CB, U32 Offset, const bool* pValue, UPTR Count) const
+{
+	WriteTyped(CB, Type, Offset, pValue, Count, TotalSize);
+}
+//---------------------------------------------------------------------
+
+CNullConstantBufferParam::CNullConstantBufferParam(CStrID Name, U8 ShaderTypeMask, EUSMBufferType Type, U32 Register, U32 Size)
+	: _Name(Name)
+	, _Type(Type)
+	, _Register(Register)
+	, _Size(Size)
+	, _ShaderTypeMask(ShaderTypeMask)
+{
+}
+//---------------------------------------------------------------------
+
+bool CNullConstantBufferParam::Apply(CGPUDriver& GPU, CConstantBuffer* pValue) const
+{
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) FAIL;
+
+	auto pCB = pValue ? pValue->As<CNullConstantBuffer>() : nullptr;
+	if (pValue && !pCB) FAIL;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->BindConstantBuffer(static_cast<EShaderType>(i), _Register, pCB);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullConstantBufferParam::Unapply(CGPUDriver& GPU, CConstantBuffer* pValue) const
+{
+	if (!pValue) return;
+
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) return;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->UnbindConstantBuffer(static_cast<EShaderType>(i), _Register, pValue);
+}
+//---------------------------------------------------------------------
+
+bool CNullConstantBufferParam::IsBufferCompatible(CConstantBuffer& Value) const
+{
+	const auto* pCB = Value.As<CNullConstantBuffer>();
+	return pCB && _Type == pCB->GetType() && _Size <= pCB->GetSizeInBytes();
+}
+//---------------------------------------------------------------------
+
+bool CNullResourceParam::Apply(CGPUDriver& GPU, CTexture* pValue) const
+{
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) FAIL;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->BindResource(static_cast<EShaderType>(i), _Register, pValue);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullResourceParam::Unapply(CGPUDriver& GPU, CTexture* pValue) const
+{
+	if (!pValue) return;
+
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) return;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->UnbindResource(static_cast<EShaderType>(i), _Register, pValue);
+}
+//---------------------------------------------------------------------
+
+bool CNullSamplerParam::Apply(CGPUDriver& GPU, CSampler* pValue) const
+{
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) FAIL;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->BindSampler(static_cast<EShaderType>(i), _Register, pValue);
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CNullSamplerParam::Unapply(CGPUDriver& GPU, CSampler* pValue) const
+{
+	if (!pValue) return;
+
+	auto pGPU = GPU.As<CNullGPUDriver>();
+	if (!pGPU) return;
+
+	for (U8 i = 0; i < ShaderType_COUNT; ++i)
+		if (_ShaderTypeMask & (1 << i))
+			pGPU->UnbindSampler(static_cast<EShaderType>(i), _Register, pValue);
+}
+//---------------------------------------------------------------------
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <Render/D3D11/USMShaderMetadata.h>
+
+// Shader metadata for the null GPU driver. It is loaded from the USM format, so the same compiled effects
+// can be used as with D3D11. Constants are written to RAM buffers and bindings are recorded by the driver.
+
+namespace Render
+{
+typedef Ptr<class CNullConstantInfo> PNullConstantInfo;
+
+// Packing rules are the same as in USM, only the destination buffer differs. Not derived from CUSMConstantInfo
+// to keep the null driver independent from D3D11, which is not available on all platforms.
+class CNullConstantInfo : public CShaderConstantInfo
+{
+protected:
+
+	virtual PShaderConstantInfo Clone() const override;
+
+public:
+
+	EUSMConstType Type;
+
+	virtual void CalculateCachedValues() override;
+
+	virtual void SetRawValue(CConstantBuffer& CB, U32 Offset, const void* pValue, UPTR Size) const override;
+	virtual void SetFloats(CConstantBuffer& CB, U32 Offset, const float* pValue, UPTR Count) const override;
+	virtual void SetInts(CConstantBuffer& CB, U32 Offset, const I32* pValue, UPTR Count) const override;
+	virtual void SetUInts(CConstantBuffer& CB, U32 Offset, const U32* pValue, UPTR Count) const override;
+	virtual void SetBools(CConstantBuffer& CB, U32 Offset, const bool* pValue, UPTR Count) const override;
+};
+
+class CNullConstantBufferParam : public IConstantBufferParam
+{
+	RTTI_CLASS_DECL(CNullConstantBufferParam, IConstantBufferParam);
+
+protected:
+
+	CStrID         _Name;
+	EUSMBufferType _Type;
+	U32            _Register;
+	U32            _Size;
+	U8             _ShaderTypeMask;
+
+public:
+
+	CNullConstantBufferParam(CStrID Name, U8 ShaderTypeMask, EUSMBufferType Type, U32 Register, U32 Size);
+
+	virtual CStrID GetID() const override { return _Name; }
+	virtual bool   Apply(CGPUDriver& GPU, CConstantBuffer* pValue) const override;
+	virtual void   Unapply(CGPUDriver& GPU, CConstantBuffer* pValue) const override;
+	virtual bool   IsBufferCompatible(CConstantBuffer& Value) const override;
+
+	EUSMBufferType GetType() const { return _Type; }
+	U32            GetSize() const { return _Size; }
+	void           AddShaderTypes(U8 Mask) { _ShaderTypeMask |= Mask; }
+};
+
+class CNullResourceParam : public IResourceParam
+{
+protected:
+
+	CStrID _Name;
+	U32    _Register;
+	U8     _ShaderTypeMask;
+
+public:
+
+	CNullResourceParam(CStrID Name, U8 ShaderTypeMask, U32 Register) : _Name(Name), _Register(Register), _ShaderTypeMask(ShaderTypeMask) {}
+
+	virtual CStrID GetID() const override { return _Name; }
+	virtual bool   Apply(CGPUDriver& GPU, CTexture* pValue) const override;
+	virtual void   Unapply(CGPUDriver& GPU, CTexture* pValue) const override;
+};
+
+class CNullSamplerParam : public ISamplerParam
+{
+protected:
+
+	CStrID _Name;
+	U32    _Register;
+	U8     _ShaderTypeMask;
+
+public:
+
+	CNullSamplerParam(CStrID Name, U8 ShaderTypeMask, U32 Register) : _Name(Name), _Register(Register), _ShaderTypeMask(ShaderTypeMask) {}
+
+	virtual CStrID GetID() const override { return _Name; }
+	virtual bool   Apply(CGPUDriver& GPU, CSampler* pValue) const override;
+	virtual void   Unapply(CGPUDriver& GPU, CSampler* pValue) const override;
+};
+
+}
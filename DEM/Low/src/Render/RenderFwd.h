@@ -26,7 +26,6 @@ class CTechnique;
 class IRenderable;
 class IRenderer;
 class CShaderConstantParam;
-enum EEffectType;
 typedef Ptr<class CGPUDriver> PGPUDriver;
 typedef Ptr<class CDisplayDriver> PDisplayDriver;
 typedef Ptr<class CVertexLayout> PVertexLayout;
@@ -1,5 +1,6 @@
 #pragma once
 #include <StdDEM.h>
+#include <Data/Algorithms.h>
 
 // A rendering queue is a set of renderables filtered and sorted according to certain rules.
 // Different filters and sortings are used for draw call and state change optimizations
@@ -60,6 +61,17 @@ public:
 		for (const auto& Rec : _Queue)
 			Callback(Rec.pRenderable);
 	}
+
+	// Visits a part of the queue, e.g. for splitting it between parallel jobs
+	template<typename TCallback>
+	DEM_FORCE_INLINE void ForEachRenderable(size_t Start, size_t End, TCallback Callback)
+	{
+		End = std::min(End, _Queue.size());
+		for (size_t i = Start; i < End; ++i)
+			Callback(_Queue[i].pRenderable);
+	}
+
+	size_t GetCount() const { return _Queue.size(); }
 };
 
 template<typename TKey>
@@ -70,9 +82,18 @@ using PRenderQueueBaseT = std::unique_ptr<CRenderQueueBaseT<TKey>>;
 template<typename TKeyBuilder, typename TKey = decltype(std::declval<TKeyBuilder>()(nullptr))>
 class CRenderQueue : public CRenderQueueBaseT<TKey>
 {
+protected:
+
+	using CBase = CRenderQueueBaseT<TKey>;
+	using CBase::NO_KEY;
+	using CBase::_Queue;
+	using CBase::_ToRemove;
+	using CBase::_SortedSize;
+	using CBase::_FilterMask;
+
 public:
 
-	using CRenderQueueBaseT::CRenderQueueBaseT;
+	using CBase::CBase;
 
 	// Remember a key calculated from the not updated state, it will be equal to the key currently in a queue.
 	virtual void Remove(IRenderable* pRenderable) override
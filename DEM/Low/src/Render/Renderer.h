@@ -1,8 +1,12 @@
 #pragma once
 #include <Core/RTTIBaseClass.h>
 #include <rtm/matrix4x4f.h>
+#include <mutex>
 
-// An object that provides an interface to a rendering algorithm which operates on renderables
+// An object that provides an interface to a rendering algorithm which operates on renderables.
+// Renderers write commands into a command list of a context. When the list is deferred, ranges may be
+// recorded on job workers in parallel, each one with its own renderer instance. Reference counting in
+// shared objects must be guarded with GetSharedStateMutex() then, see CGPUCommandList.
 
 namespace Data
 {
@@ -13,6 +17,7 @@ namespace Render
 {
 class IRenderable;
 class CGPUDriver;
+class CGPUCommandList;
 class CTechnique;
 using PRenderer = std::unique_ptr<class IRenderer>;
 class CShaderParamStorage;
@@ -24,6 +29,26 @@ public:
 	virtual void ModifyPerInstanceShaderParams(CShaderParamStorage& PerInstanceParams, UPTR InstanceIndex) = 0;
 };
 
+// Per-frame renderer counters. A view sums them over all its renderer instances, see CView::GetRenderStats().
+struct CRenderStats
+{
+	U32 InstanceCount = 0;
+	U32 BatchCount = 0;          // Instanced or single draws of the same data
+	U32 DrawCallCount = 0;       // Batches multiplied by tech pass count
+	U32 ReorderedRangeCount = 0; // Runs of instances that had to be regrouped for batching
+	U32 SkippedPaletteCount = 0; // Skin palettes not written because the buffer already holds them
+
+	CRenderStats& operator +=(const CRenderStats& Other)
+	{
+		InstanceCount += Other.InstanceCount;
+		BatchCount += Other.BatchCount;
+		DrawCallCount += Other.DrawCallCount;
+		ReorderedRangeCount += Other.ReorderedRangeCount;
+		SkippedPaletteCount += Other.SkippedPaletteCount;
+		return *this;
+	}
+};
+
 class IRenderer: public DEM::Core::CRTTIBaseClass
 {
 	RTTI_CLASS_DECL(Render::IRenderer, DEM::Core::CRTTIBaseClass);
@@ -33,13 +58,20 @@ public:
 	struct CRenderContext
 	{
 		Render::CGPUDriver*              pGPU = nullptr;
+		Render::CGPUCommandList*         pCommandList = nullptr;
 		const Render::CTechnique* const* pShaderTechCache = nullptr;
 	};
 
+	// Guards creation of per-tech data, which references shared param tables, from different recording threads
+	static std::mutex& GetSharedStateMutex() { static std::mutex Mutex; return Mutex; }
+
 	virtual bool Init(const Data::CParams& Params, CGPUDriver& GPU) = 0;
 	virtual bool BeginRange(const CRenderContext& Context) = 0;
 	virtual void Render(const CRenderContext& Context, IRenderable& Renderable, IRenderModifier* pModifier = nullptr) = 0;
 	virtual void EndRange(const CRenderContext& Context) = 0;
+
+	virtual void AccumulateStats(CRenderStats& Out) const {}
+	virtual void ResetStats() {}
 };
 
 }
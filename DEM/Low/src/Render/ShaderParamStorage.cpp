@@ -362,7 +362,8 @@ bool CShaderParamStorage::Apply()
 
 			if (pCB->IsTemporary())
 			{
-				//!!!must return to the pool only when GPU is finished with this buffer!
+				// Driver is responsible for not overwriting data the GPU may still read,
+				// by buffer renaming or by fencing transient memory until the frame ends
 				_GPU->FreeTemporaryConstantBuffer(*pCB);
 				_ConstantBuffers[i] = nullptr;
 			}
@@ -36,7 +36,7 @@ static inline void SetValues(CShaderConstantInfo* Info, CConstantBuffer& CB, U32
 	else if constexpr (std::is_same<T, matrix44>())
 		Info->SetFloats(CB, Offset, *pValues->m, Count * 16); // NB: only 4x4 matrices are supported here
 	else
-		static_assert(false, "Unsupported type in shader constant SetValues");
+		static_assert(always_false_v<T>, "Unsupported type in shader constant SetValues");
 }
 //---------------------------------------------------------------------
 
@@ -46,7 +46,7 @@ static inline void SetArray(CShaderConstantInfo* Info, CConstantBuffer& CB, U32
 	n_assert_dbg(Info);
 	if (!pValues || !Info || StartIndex >= Info->GetElementCount()) return;
 
-	Count = std::min(Count, Info->GetElementCount() - StartIndex);
+	Count = std::min<UPTR>(Count, Info->GetElementCount() - StartIndex);
 	if (!Count) return;
 
 	Offset += StartIndex * Info->GetElementStride();
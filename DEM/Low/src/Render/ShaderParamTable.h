@@ -24,6 +24,9 @@ private:
 	// For buffer index patching after sorting metadata by ID
 	friend class CShaderParamTable;
 
+	// Records constants by a raw info pointer and an offset to avoid reference counting on worker threads
+	friend class CGPUCommandList;
+
 	PShaderConstantInfo _Info;
 	U32                 _Offset = 0;
 
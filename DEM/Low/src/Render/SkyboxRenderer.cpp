@@ -1,5 +1,6 @@
 #include "SkyboxRenderer.h"
 #include <Render/GPUDriver.h>
+#include <Render/GPUCommandList.h>
 #include <Render/Skybox.h>
 #include <Render/Material.h>
 #include <Render/Effect.h>
@@ -17,6 +18,9 @@ CSkyboxRenderer::CSkyboxTechInterface* CSkyboxRenderer::GetTechInterface(const C
 	auto It = _TechInterfaces.find(pTech);
 	if (It != _TechInterfaces.cend()) return &It->second;
 
+	// Param tables and the GPU are shared between renderer instances recording in parallel
+	std::lock_guard Lock(GetSharedStateMutex());
+
 	auto& TechInterface = _TechInterfaces[pTech];
 
 	if (pTech->GetParamTable().HasParams())
@@ -57,6 +61,11 @@ void CSkyboxRenderer::Render(const CRenderContext& Context, IRenderable& Rendera
 	n_assert_dbg(pMesh);
 	if (!pMesh) return;
 
+	auto& CmdList = *Context.pCommandList;
+
+	// Modifiers write to param storages directly, which is correct only when commands aren't deferred
+	n_assert_dbg(!pModifier || CmdList.IsImmediate());
+
 	if (pTech != _pCurrTech)
 	{
 		_pCurrTech = pTech;
@@ -66,27 +75,27 @@ void CSkyboxRenderer::Render(const CRenderContext& Context, IRenderable& Rendera
 	if (pMaterial != _pCurrMaterial)
 	{
 		_pCurrMaterial = pMaterial;
-		n_verify_dbg(pMaterial->Apply());
+		CmdList.ApplyParams(pMaterial->GetValues());
 	}
 
 	if (_pCurrTechInterface->ConstWorldMatrix)
-		_pCurrTechInterface->PerInstanceParams.SetMatrix(_pCurrTechInterface->ConstWorldMatrix, Skybox.Transform);
+		CmdList.SetMatrix(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstWorldMatrix, Skybox.Transform);
 
 	if (pModifier) pModifier->ModifyPerInstanceShaderParams(_pCurrTechInterface->PerInstanceParams, 0);
 
-	n_verify_dbg(_pCurrTechInterface->PerInstanceParams.Apply());
+	CmdList.ApplyParams(_pCurrTechInterface->PerInstanceParams);
 
 	CVertexBuffer* pVB = pMesh->GetVertexBuffer().Get();
-	_pGPU->SetVertexLayout(pVB->GetVertexLayout());
-	_pGPU->SetVertexBuffer(0, pVB);
-	_pGPU->SetIndexBuffer(pMesh->GetIndexBuffer().Get());
+	CmdList.SetVertexLayout(pVB->GetVertexLayout());
+	CmdList.SetVertexBuffer(0, pVB);
+	CmdList.SetIndexBuffer(pMesh->GetIndexBuffer().Get());
 
 	// NB: rendered at the far clipping plane due to .xyww position swizzling in a shader
 	const CPrimitiveGroup* pGroup = pMesh->GetGroup(0);
 	for (const auto& Pass : pTech->GetPasses())
 	{
-		_pGPU->SetRenderState(Pass);
-		_pGPU->Draw(*pGroup);
+		CmdList.SetRenderState(Pass);
+		CmdList.Draw(*pGroup);
 	}
 }
 //---------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include <Render/Mesh.h>
 #include <Render/Texture.h>
 #include <Data/Algorithms.h>
+#include <Jobs/JobSystem.h>
 #include <Core/Factory.h>
 
 namespace Render
@@ -41,8 +42,10 @@ void CTerrain::UpdateMorphConstants(float VisibilityRange)
 }
 //---------------------------------------------------------------------
 
-void CTerrain::UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSIMDFrustum& ViewFrustum)
+void CTerrain::UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSIMDFrustum& ViewFrustum, DEM::Jobs::CWorker* pWorker)
 {
+	ZoneScoped;
+
 	constexpr TMorton RootMortonCode = 1;
 
 	// NB: always must use the main camera for LOD selection, even if another camera (ViewFrustum) is used for intermediate rendering
@@ -52,15 +55,40 @@ void CTerrain::UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSI
 	Ctx.Offset = Transform.w_axis;
 	Ctx.MainCameraPos = MainCameraPos;
 
-	std::swap(_PrevPatches, _Patches);
-	_Patches.clear();
-	_FullPatchCount = 0;
+	std::swap(_PrevPatches, _Selection.Patches);
+	_Selection.Patches.clear();
+	_Selection.FullPatchCount = 0;
+
+	const U32 RootLOD = CDLODData->GetLODCount() - 1;
+
+	// Select patches in subtrees, in parallel if possible. Most of them are reused from the previous update
+	// when the camera moves slowly or only rotates.
+	if (ValidateSubtreeCache(Ctx))
+	{
+		if (pWorker && _Subtrees.size() > 1)
+		{
+			DEM::Jobs::CJobCounter Counter;
+			for (auto& Subtree : _Subtrees)
+				pWorker->AddJob(Counter, [this, &Ctx, &Subtree]() { ProcessSubtree(Ctx, Subtree); });
+			pWorker->WaitIdle(Counter);
+		}
+		else
+		{
+			for (auto& Subtree : _Subtrees)
+				ProcessSubtree(Ctx, Subtree);
+		}
+
+		Ctx.pSubtrees = _Subtrees.data();
+		Ctx.SubtreeCount = _Subtrees.size();
+		Ctx.SubtreeLOD = _SubtreeLOD;
+	}
 
-	ProcessTerrainNode(Ctx, 0, 0, CDLODData->GetLODCount() - 1, Math::ClipIntersect, RootMortonCode);
+	// Process top levels and merge subtree results
+	ProcessTerrainNode(Ctx, _Selection, 0, 0, RootLOD, Math::ClipIntersect, RootMortonCode);
 
 	// We sort by LOD (the shorter is the code, the coarser is LOD), and therefore we almost sort front to back, as LOD depends solely on it
 	const auto PatchInstanceCmp = [](const CPatchInstance& a, const CPatchInstance& b) { return a.MortonCode > b.MortonCode; };
-	std::sort(_Patches.begin(), _Patches.end(), PatchInstanceCmp);
+	std::sort(_Selection.Patches.begin(), _Selection.Patches.end(), PatchInstanceCmp);
 
 	// Copy cached light data where available. This is much cheaper than constructing from scratch it in CTerrainAttribute::UpdateLightList.
 	// FIXME: can use one collection instead of two? Use bool IsQuarterPatch?! Pushing data to GPU is done record by record anyway!
@@ -69,7 +97,7 @@ void CTerrain::UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSI
 	if (TrackObjectLightIntersections)
 	{
 		size_t MatchCount = 0;
-		DEM::Algo::SortedInnerJoin(_Patches, _PrevPatches, PatchInstanceCmp,
+		DEM::Algo::SortedInnerJoin(_Selection.Patches, _PrevPatches, PatchInstanceCmp,
 			[&MatchCount, MaxLODForDynamicLights = MaxLODForDynamicLights](auto ItNew, auto ItPrev)
 		{
 			const bool WasLitByLOD = (ItPrev->LOD <= MaxLODForDynamicLights);
@@ -83,14 +111,158 @@ void CTerrain::UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSI
 		});
 
 		// If some of new patches could not copy cached lights from prevoius ones, we must force an update of light data
-		if (MatchCount < _Patches.size())
+		if (MatchCount < _Selection.Patches.size())
 			ObjectLightIntersectionsVersion = 0;
 	}
+
+	PackPatchInstanceData();
 }
 //---------------------------------------------------------------------
 
-CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext& Ctx, TCellDim x, TCellDim z, U32 LOD, U8 ParentClipStatus, TMorton MortonCode)
+// Returns false if subtrees can't be used, e.g. the quadtree is too shallow
+bool CTerrain::ValidateSubtreeCache(const CNodeProcessingContext& Ctx)
 {
+	// Two levels give 16 subtrees, enough to load a typical job system and still cheap to merge
+	constexpr U32 SubtreeDepth = 2;
+
+	const U32 RootLOD = CDLODData->GetLODCount() - 1;
+	if (RootLOD < DeepestLOD + SubtreeDepth)
+	{
+		_Subtrees.clear();
+		FAIL;
+	}
+
+	const U32 SubtreeLOD = RootLOD - SubtreeDepth;
+
+	const bool IsCacheValid =
+		_pSubtreeCDLODData == CDLODData.Get() &&
+		_SubtreeLOD == SubtreeLOD &&
+		_SubtreeDeepestLOD == DeepestLOD &&
+		_SubtreeVisibilityRange == _VisibilityRange &&
+		_SubtreeMorphStartRatio == MorphStartRatio &&
+		rtm::vector_all_equal3(_SubtreeScale, Ctx.Scale) &&
+		rtm::vector_all_equal3(_SubtreeOffset, Ctx.Offset);
+
+	if (!IsCacheValid)
+	{
+		_pSubtreeCDLODData = CDLODData.Get();
+		_SubtreeLOD = SubtreeLOD;
+		_SubtreeDeepestLOD = DeepestLOD;
+		_SubtreeVisibilityRange = _VisibilityRange;
+		_SubtreeMorphStartRatio = MorphStartRatio;
+		_SubtreeScale = Ctx.Scale;
+		_SubtreeOffset = Ctx.Offset;
+
+		_Subtrees.clear();
+		CollectSubtrees(0, 0, RootLOD, 1);
+	}
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Collects existing nodes at _SubtreeLOD in ascending Morton code order
+void CTerrain::CollectSubtrees(TCellDim x, TCellDim z, U32 LOD, TMorton MortonCode)
+{
+	if (LOD == _SubtreeLOD)
+	{
+		auto& Subtree = _Subtrees.emplace_back();
+		Subtree.X = x;
+		Subtree.Z = z;
+		Subtree.MortonCode = MortonCode;
+		return;
+	}
+
+	const auto [HasRightChild, HasBottomChild] = CDLODData->GetChildExistence(x, z, LOD);
+	const TCellDim NextX = x << 1;
+	const TCellDim NextZ = z << 1;
+	const TMorton FirstChildMortonCode = (MortonCode << 2);
+
+	CollectSubtrees(NextX, NextZ, LOD - 1, FirstChildMortonCode);
+	if (HasRightChild) CollectSubtrees(NextX + 1, NextZ, LOD - 1, FirstChildMortonCode + 1);
+	if (HasBottomChild) CollectSubtrees(NextX, NextZ + 1, LOD - 1, FirstChildMortonCode + 2);
+	if (HasRightChild && HasBottomChild) CollectSubtrees(NextX + 1, NextZ + 1, LOD - 1, FirstChildMortonCode + 3);
+}
+//---------------------------------------------------------------------
+
+// Can be called from job workers, subtrees are independent
+void CTerrain::ProcessSubtree(const CNodeProcessingContext& Ctx, CSubtree& Subtree) const
+{
+	ZoneScoped;
+
+	// Test subtree visibility. Outside and fully inside subtrees are cheap to process, no need to cache them.
+	U8 ClipStatus = Math::ClipOutside;
+	rtm::vector4f BoxCenter, BoxExtent;
+	if (CDLODData->GetNodeAABB(Subtree.X, Subtree.Z, _SubtreeLOD, BoxCenter, BoxExtent))
+	{
+		CDLODData->ClampNodeToPatchAABB(BoxCenter, BoxExtent);
+		BoxCenter = rtm::vector_add(BoxCenter, Ctx.Offset);
+		BoxExtent = rtm::vector_mul(BoxExtent, Ctx.Scale);
+		ClipStatus = Math::ClipAABB(BoxCenter, BoxExtent, Ctx.ViewFrustum);
+	}
+
+	if (ClipStatus == Math::ClipOutside)
+	{
+		Subtree.Selection.Patches.clear();
+		Subtree.Selection.FullPatchCount = 0;
+		Subtree.Status = ENodeStatus::Invisible;
+		Subtree.IsInside = false;
+		Subtree.IsValid = false;
+		return;
+	}
+
+	// Subtree fully inside the frustum depends only on LOD selection. If the camera moved less than a distance to
+	// the nearest LOD range boundary tested last time, each LOD test gives the same result and the selection is unchanged.
+	const bool IsInside = (ClipStatus == Math::ClipInside);
+	if (IsInside && Subtree.IsValid && Subtree.IsInside)
+	{
+		const float CameraShift = rtm::vector_length3(rtm::vector_sub(Ctx.MainCameraPos, Subtree.CameraPos));
+		if (CameraShift < Subtree.Selection.LODMargin) return;
+	}
+
+	Subtree.Selection.Patches.clear();
+	Subtree.Selection.FullPatchCount = 0;
+	Subtree.Selection.LODMargin = std::numeric_limits<float>::max();
+	Subtree.Status = ProcessTerrainNode(Ctx, Subtree.Selection, Subtree.X, Subtree.Z, _SubtreeLOD, ClipStatus, Subtree.MortonCode);
+	Subtree.CameraPos = Ctx.MainCameraPos;
+	Subtree.IsInside = IsInside;
+	Subtree.IsValid = true;
+}
+//---------------------------------------------------------------------
+
+// Packs per-instance vertex shader data in the order the renderer draws patches, so that it can be uploaded as is
+void CTerrain::PackPatchInstanceData()
+{
+	_PatchInstanceData.resize(_Selection.Patches.size());
+
+	size_t FullIndex = 0;
+	size_t QuarterIndex = _Selection.FullPatchCount;
+	for (const auto& Patch : _Selection.Patches)
+	{
+		auto& Data = _PatchInstanceData[Patch.IsFullPatch ? FullIndex++ : QuarterIndex++];
+		Data.ScaleOffset = Patch.ScaleOffset;
+		Data.MorphConsts = rtm::vector_set(LODParams[Patch.LOD].Morph1, LODParams[Patch.LOD].Morph2, 0.f, 0.f);
+	}
+
+	n_assert_dbg(FullIndex == _Selection.FullPatchCount && QuarterIndex == _Selection.Patches.size());
+}
+//---------------------------------------------------------------------
+
+CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext& Ctx, CPatchSelection& Out, TCellDim x, TCellDim z, U32 LOD, U8 ParentClipStatus, TMorton MortonCode) const
+{
+	// Subtree is already processed, merge its results
+	if (Ctx.pSubtrees && LOD == Ctx.SubtreeLOD)
+	{
+		const auto pEnd = Ctx.pSubtrees + Ctx.SubtreeCount;
+		const auto pSubtree = std::lower_bound(Ctx.pSubtrees, pEnd, MortonCode, [](const CSubtree& Subtree, TMorton Code) { return Subtree.MortonCode < Code; });
+		n_assert_dbg(pSubtree != pEnd && pSubtree->MortonCode == MortonCode);
+		if (pSubtree == pEnd || pSubtree->MortonCode != MortonCode) return ENodeStatus::Invisible;
+
+		Out.Patches.insert(Out.Patches.end(), pSubtree->Selection.Patches.cbegin(), pSubtree->Selection.Patches.cend());
+		Out.FullPatchCount += pSubtree->Selection.FullPatchCount;
+		return pSubtree->Status;
+	}
+
 	// Calculate node world space AABB
 	rtm::vector4f NodeBoxCenter, NodeBoxExtent;
 	if (!CDLODData->GetNodeAABB(x, z, LOD, NodeBoxCenter, NodeBoxExtent)) return ENodeStatus::Invisible;
@@ -111,8 +283,11 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 	NodeBoxCenter = rtm::vector_add(NodeBoxCenter, Ctx.Offset);
 	NodeBoxExtent = rtm::vector_mul(NodeBoxExtent, Ctx.Scale);
 
-	const auto LODSphere = rtm::vector_set_w(Ctx.MainCameraPos, LODParams[LOD].Range);
-	if (!Math::HasIntersection(LODSphere, NodeBoxCenter, NodeBoxExtent)) return ENodeStatus::NotInLOD;
+	// Track how far the camera can move without changing any LOD decision, see ProcessSubtree
+	const float DistToNode = std::sqrt(Math::SqDistancePointAABB(Ctx.MainCameraPos, NodeBoxCenter, NodeBoxExtent));
+	Out.LODMargin = std::min(Out.LODMargin, std::abs(DistToNode - LODParams[LOD].Range));
+
+	if (DistToNode >= LODParams[LOD].Range) return ENodeStatus::NotInLOD;
 
 	// Bits 0 to 3 - if set, add quarterpatch for child[0 .. 3]
 	U8 ChildFlags = 0;
@@ -136,8 +311,9 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 
 		const U32 NextLOD = LOD - 1;
 
-		const auto NextLODSphere = rtm::vector_set_w(Ctx.MainCameraPos, LODParams[NextLOD].Range);
-		if (!Math::HasIntersection(NextLODSphere, NodeBoxCenter, NodeBoxExtent))
+		Out.LODMargin = std::min(Out.LODMargin, std::abs(DistToNode - LODParams[NextLOD].Range));
+
+		if (DistToNode >= LODParams[NextLOD].Range)
 		{
 			// Add the whole node to the current LOD
 			ChildFlags = Child_All;
@@ -149,7 +325,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 			const U32 NextX = x << 1;
 			const U32 NextZ = z << 1;
 
-			ENodeStatus Status = ProcessTerrainNode(Ctx, NextX, NextZ, NextLOD, ParentClipStatus, FirstChildMortonCode);
+			ENodeStatus Status = ProcessTerrainNode(Ctx, Out, NextX, NextZ, NextLOD, ParentClipStatus, FirstChildMortonCode);
 			if (Status != ENodeStatus::Invisible)
 			{
 				IsVisible = true;
@@ -158,7 +334,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 
 			if (HasRightChild)
 			{
-				Status = ProcessTerrainNode(Ctx, NextX + 1, NextZ, NextLOD, ParentClipStatus, FirstChildMortonCode + 1);
+				Status = ProcessTerrainNode(Ctx, Out, NextX + 1, NextZ, NextLOD, ParentClipStatus, FirstChildMortonCode + 1);
 				if (Status != ENodeStatus::Invisible)
 				{
 					IsVisible = true;
@@ -168,7 +344,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 
 			if (HasBottomChild)
 			{
-				Status = ProcessTerrainNode(Ctx, NextX, NextZ + 1, NextLOD, ParentClipStatus, FirstChildMortonCode + 2);
+				Status = ProcessTerrainNode(Ctx, Out, NextX, NextZ + 1, NextLOD, ParentClipStatus, FirstChildMortonCode + 2);
 				if (Status != ENodeStatus::Invisible)
 				{
 					IsVisible = true;
@@ -178,7 +354,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 
 			if (HasRightChild && HasBottomChild)
 			{
-				Status = ProcessTerrainNode(Ctx, NextX + 1, NextZ + 1, NextLOD, ParentClipStatus, FirstChildMortonCode + 3);
+				Status = ProcessTerrainNode(Ctx, Out, NextX + 1, NextZ + 1, NextLOD, ParentClipStatus, FirstChildMortonCode + 3);
 				if (Status != ENodeStatus::Invisible)
 				{
 					IsVisible = true;
@@ -204,12 +380,12 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 	{
 		// Add whole patch
 		// (HalfSizeX + HalfSizeX, HalfSizeZ + HalfSizeZ, CenterX - HalfSizeX, CenterZ - HalfSizeZ)
-		auto& Patch = _Patches.emplace_back();
+		auto& Patch = Out.Patches.emplace_back();
 		Patch.ScaleOffset = rtm::vector_add(HalfSizeXZCenterXZ, HalfSizeXZNegHalfSizeXZ);
 		Patch.LOD = LOD;
 		Patch.MortonCode = MortonCode;
 		Patch.IsFullPatch = true;
-		++_FullPatchCount;
+		++Out.FullPatchCount;
 	}
 	else
 	{
@@ -218,7 +394,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 		if (ChildFlags & Child_TopLeft)
 		{
 			// (HalfSizeX, HalfSizeZ, CenterX - HalfSizeX, CenterZ - HalfSizeZ)
-			auto& Patch = _Patches.emplace_back();
+			auto& Patch = Out.Patches.emplace_back();
 			Patch.ScaleOffset = rtm::vector_mul_add(HalfSizeXZNegHalfSizeXZ, rtm::vector4f{ 0.f, 0.f, 1.f, 1.f }, HalfSizeXZCenterXZ);
 			Patch.LOD = LOD;
 			Patch.MortonCode = FirstChildMortonCode;
@@ -227,7 +403,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 		if (ChildFlags & Child_TopRight)
 		{
 			// (HalfSizeX, HalfSizeZ, CenterX, CenterZ - HalfSizeZ)
-			auto& Patch = _Patches.emplace_back();
+			auto& Patch = Out.Patches.emplace_back();
 			Patch.ScaleOffset = rtm::vector_mul_add(HalfSizeXZNegHalfSizeXZ, rtm::vector4f{ 0.f, 0.f, 0.f, 1.f }, HalfSizeXZCenterXZ);
 			Patch.LOD = LOD;
 			Patch.MortonCode = FirstChildMortonCode + 1;
@@ -236,7 +412,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 		if (ChildFlags & Child_BottomLeft)
 		{
 			// (HalfSizeX, HalfSizeZ, CenterX - HalfSizeX, CenterZ)
-			auto& Patch = _Patches.emplace_back();
+			auto& Patch = Out.Patches.emplace_back();
 			Patch.ScaleOffset = rtm::vector_mul_add(HalfSizeXZNegHalfSizeXZ, rtm::vector4f{ 0.f, 0.f, 1.f, 0.f }, HalfSizeXZCenterXZ);
 			Patch.LOD = LOD;
 			Patch.MortonCode = FirstChildMortonCode + 2;
@@ -245,7 +421,7 @@ CTerrain::ENodeStatus CTerrain::ProcessTerrainNode(const CNodeProcessingContext&
 		if (ChildFlags & Child_BottomRight)
 		{
 			// (HalfSizeX, HalfSizeZ, CenterX, CenterZ)
-			auto& Patch = _Patches.emplace_back();
+			auto& Patch = Out.Patches.emplace_back();
 			Patch.ScaleOffset = HalfSizeXZCenterXZ;
 			Patch.LOD = LOD;
 			Patch.MortonCode = FirstChildMortonCode + 3;
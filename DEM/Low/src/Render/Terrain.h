@@ -5,8 +5,17 @@
 #include <Math/CameraMath.h>
 #include <array>
 
+namespace DEM::Jobs
+{
+	class CWorker;
+}
+
 // Terrain represents a CDLOD heightmap-based model. It has special LOD handling
 // and integrated visibility test.
+// Patch selection is split into subtrees rooted a couple of levels below the quadtree root.
+// Subtrees are processed in parallel and their selection is reused in the next update if
+// the subtree stays fully inside the frustum and the camera didn't move far enough to
+// change any LOD decision inside it.
 
 namespace Render
 {
@@ -35,6 +44,13 @@ public:
 		bool                   IsFullPatch = false;
 	};
 
+	// Per-instance vertex shader data, packed in the order of instances in draw calls
+	struct CPatchInstanceData
+	{
+		rtm::vector4f ScaleOffset;
+		rtm::vector4f MorphConsts;
+	};
+
 	inline static constexpr U32 MAX_LIGHTS_PER_PATCH = std::tuple_size<decltype(CPatchInstance::Lights)>();
 
 protected:
@@ -46,17 +62,49 @@ protected:
 		Processed
 	};
 
+	struct CPatchSelection
+	{
+		std::vector<CPatchInstance> Patches;
+		size_t                      FullPatchCount = 0; // Number of full (not quarter) patches. Used for minor optimization.
+		float                       LODMargin = std::numeric_limits<float>::max(); // Min distance between the camera and any LOD range boundary tested
+	};
+
+	struct CSubtree
+	{
+		CPatchSelection Selection;
+		rtm::vector4f   CameraPos;
+		TMorton         MortonCode;
+		TCellDim        X;
+		TCellDim        Z;
+		ENodeStatus     Status = ENodeStatus::Invisible;
+		bool            IsInside = false; // Was fully inside the frustum, so no frustum tests were made in the subtree
+		bool            IsValid = false;
+	};
+
 	struct CNodeProcessingContext
 	{
 		Math::CSIMDFrustum ViewFrustum;
 		rtm::vector4f      Scale;
 		rtm::vector4f      Offset;
 		rtm::vector4f	   MainCameraPos;
+		const CSubtree*    pSubtrees = nullptr; // If set, nodes at SubtreeLOD are taken from there
+		size_t             SubtreeCount = 0;
+		U32                SubtreeLOD = 0;
 	};
 
-	std::vector<CPatchInstance> _Patches;
-	std::vector<CPatchInstance> _PrevPatches;        // Stored here to avoid per frame allocations
-	size_t                      _FullPatchCount = 0; // Number of full (not quarter) patches in _Patches. Used for minor optimization.
+	CPatchSelection                 _Selection;
+	std::vector<CPatchInstance>     _PrevPatches;       // Stored here to avoid per frame allocations
+	std::vector<CPatchInstanceData> _PatchInstanceData; // Full patches first, then quarter patches
+
+	// Subtree cache is valid while these parameters are unchanged
+	std::vector<CSubtree>           _Subtrees;
+	rtm::vector4f                   _SubtreeScale;
+	rtm::vector4f                   _SubtreeOffset;
+	const CCDLODData*               _pSubtreeCDLODData = nullptr;
+	float                           _SubtreeVisibilityRange = 0.f;
+	float                           _SubtreeMorphStartRatio = 0.f;
+	U32                             _SubtreeLOD = 0;
+	U16                             _SubtreeDeepestLOD = 0;
 
 	//CB or CBs (can add here shadere param storage and make persistent buffers for patch data, get shader meta from saved tech)
 	//!!!???can fill one GPU buffer?! use offset to render first ones, then others.
@@ -69,7 +117,11 @@ protected:
 
 	float                       _VisibilityRange = 0.f;
 
-	ENodeStatus ProcessTerrainNode(const CNodeProcessingContext& Ctx, TCellDim x, TCellDim z, U32 LOD, U8 ParentClipStatus, TMorton MortonCode);
+	ENodeStatus ProcessTerrainNode(const CNodeProcessingContext& Ctx, CPatchSelection& Out, TCellDim x, TCellDim z, U32 LOD, U8 ParentClipStatus, TMorton MortonCode) const;
+	void        ProcessSubtree(const CNodeProcessingContext& Ctx, CSubtree& Subtree) const;
+	void        CollectSubtrees(TCellDim x, TCellDim z, U32 LOD, TMorton MortonCode);
+	bool        ValidateSubtreeCache(const CNodeProcessingContext& Ctx);
+	void        PackPatchInstanceData();
 
 public:
 
@@ -100,14 +152,15 @@ public:
 	virtual ~CTerrain() override;
 
 	void UpdateMorphConstants(float VisibilityRange);
-	void UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSIMDFrustum& ViewFrustum);
+	void UpdatePatches(const rtm::vector4f& MainCameraPos, const Math::CSIMDFrustum& ViewFrustum, DEM::Jobs::CWorker* pWorker = nullptr);
 
 	CCDLODData*         GetCDLODData() const { return CDLODData.Get(); }
 	CMaterial*          GetMaterial() const { return Material.Get(); }
 	CTexture*           GetHeightMap() const { return HeightMap.Get(); }
-	const auto&         GetPatches() const { return _Patches; }
-	auto&               GetPatches() { return _Patches; }
-	size_t              GetFullPatchCount() const { return _FullPatchCount; }
+	const auto&         GetPatches() const { return _Selection.Patches; }
+	auto&               GetPatches() { return _Selection.Patches; }
+	size_t              GetFullPatchCount() const { return _Selection.FullPatchCount; }
+	const auto&         GetPatchInstanceData() const { return _PatchInstanceData; }
 	CMesh*              GetPatchMesh() const { return PatchMesh.Get(); }
 	CMesh*              GetQuarterPatchMesh() const { return QuarterPatchMesh.Get(); }
 	float               GetInvSplatSizeX() const { return InvSplatSizeX; }
@@ -1,5 +1,6 @@
 #include "TerrainRenderer.h"
 #include <Render/GPUDriver.h>
+#include <Render/GPUCommandList.h>
 #include <Render/Terrain.h>
 #include <Render/CDLODData.h>
 #include <Render/Light.h>
@@ -23,6 +24,9 @@ CTerrainRenderer::CTerrainTechInterface* CTerrainRenderer::GetTechInterface(cons
 	auto It = _TechInterfaces.find(pTech);
 	if (It != _TechInterfaces.cend()) return &It->second;
 
+	// Param tables and the GPU are shared between renderer instances recording in parallel
+	std::lock_guard Lock(GetSharedStateMutex());
+
 	auto& TechInterface = _TechInterfaces[pTech];
 
 	auto& ParamTable = pTech->GetParamTable();
@@ -54,7 +58,7 @@ CTerrainRenderer::CTerrainTechInterface* CTerrainRenderer::GetTechInterface(cons
 
 	TechInterface.TechMaxInstanceCount = std::max<U32>(1, TechInterface.ConstInstanceDataVS.GetElementCount());
 	if (TechInterface.ConstInstanceDataPS)
-		TechInterface.TechMaxInstanceCount = std::min(TechInterface.TechMaxInstanceCount, std::max<U32>(1, TechInterface.ConstInstanceDataPS.GetElementCount()));
+		TechInterface.TechMaxInstanceCount = std::min<UPTR>(TechInterface.TechMaxInstanceCount, std::max<U32>(1, TechInterface.ConstInstanceDataPS.GetElementCount()));
 
 	TechInterface.TechLightCount = std::min(CTerrain::MAX_LIGHTS_PER_PATCH, TechInterface.MemberLightIndices.GetTotalComponentCount());
 
@@ -110,6 +114,11 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 	n_assert_dbg(pMaterial);
 	if (!pMaterial) return;
 
+	auto& CmdList = *Context.pCommandList;
+
+	// Modifiers write to param storages directly, which is correct only when commands aren't deferred
+	n_assert_dbg(!pModifier || CmdList.IsImmediate());
+
 	// Apply material, if changed
 
 	if (pTech != _pCurrTech)
@@ -121,13 +130,13 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 		_pCurrTech = pTech;
 
 		if (_pCurrTechInterface->VSLinearSampler)
-			_pCurrTechInterface->VSLinearSampler->Apply(*_pGPU, _HeightMapSampler.Get());
+			CmdList.ApplySampler(*_pCurrTechInterface->VSLinearSampler, _HeightMapSampler.Get());
 	}
 
 	if (_pCurrTechInterface->TechNeedsMaterial && pMaterial != _pCurrMaterial)
 	{
 		_pCurrMaterial = pMaterial;
-		n_verify_dbg(pMaterial->Apply());
+		CmdList.ApplyParams(pMaterial->GetValues());
 	}
 
 	// Pass tech params to GPU
@@ -177,7 +186,8 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 		CDLODParams.InvSplatSizeZ = Terrain.GetInvSplatSizeZ();
 		if (_pCurrMaterial)
 		{
-			if (const auto& Tex = _pCurrMaterial->GetValues().GetResource(CStrID("TexGeometryNormalMap")))
+			static const CStrID sidTexGeometryNormalMap("TexGeometryNormalMap");
+			if (const auto& Tex = _pCurrMaterial->GetValues().GetResource(sidTexGeometryNormalMap))
 			{
 				// Block compressed textures add extra rows & columns, breaking exact texel -> vertex mapping
 				// TODO: can make better?
@@ -190,12 +200,12 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 		CDLODParams.WorldMaxX = rtm::vector_get_x(AABBMax);
 		CDLODParams.WorldMaxZ = rtm::vector_get_z(AABBMax);
 
-		_pCurrTechInterface->PerInstanceParams.SetRawConstant(_pCurrTechInterface->ConstVSCDLODParams, CDLODParams);
+		CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstVSCDLODParams, CDLODParams);
 	}
 
 	// Heightmap texture for a vertex shader
 	if (_pCurrTechInterface->ResourceHeightMap)
-		_pCurrTechInterface->ResourceHeightMap->Apply(*_pGPU, Terrain.GetHeightMap());
+		CmdList.ApplyResource(*_pCurrTechInterface->ResourceHeightMap, Terrain.GetHeightMap());
 
 	// Terrain patch instances and their affecting lights
 	//!!!TODO: implement looping if instance buffer is too small! batch terrain clusters with identical material!
@@ -203,23 +213,25 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 	const auto FullInstanceCount = Terrain.GetFullPatchCount();
 	UPTR FullInstanceIndex = 0;
 	UPTR QuarterInstanceIndex = FullInstanceCount;
+
+	// Instance data is prepacked by the terrain in the drawing order. If the shader layout matches, upload it at once.
+	const auto& InstanceData = Terrain.GetPatchInstanceData();
+	const bool IsInstanceDataPacked = (_pCurrTechInterface->ConstInstanceDataVS.GetElementStride() == sizeof(CTerrain::CPatchInstanceData));
+	if (IsInstanceDataPacked)
+		CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstInstanceDataVS, InstanceData.data(), InstanceData.size() * sizeof(CTerrain::CPatchInstanceData));
+
 	auto ConstVSInstance = _pCurrTechInterface->ConstInstanceDataVS[0];
 	std::array<U32, CTerrain::MAX_LIGHTS_PER_PATCH> LightIndexBuffer;
 	for (const auto& CurrPatch : Terrain.GetPatches())
 	{
 		const auto Index = CurrPatch.IsFullPatch ? FullInstanceIndex++ : QuarterInstanceIndex++;
 
-		//!!!FIXME: tmp! better is to prepare the buffer in advance and don't refill it every frame!
-		struct CRec
-		{
-			rtm::vector4f ScaleOffset;
-			rtm::vector4f MorphConsts;
-		};
-
 		// Setup instance patch constants
-		const CRec Rec{ CurrPatch.ScaleOffset, rtm::vector_set(Terrain.LODParams[CurrPatch.LOD].Morph1, Terrain.LODParams[CurrPatch.LOD].Morph2, 0.f, 0.f) };
-		ConstVSInstance.Shift(_pCurrTechInterface->ConstInstanceDataVS, Index);
-		_pCurrTechInterface->PerInstanceParams.SetRawConstant(ConstVSInstance, Rec);
+		if (!IsInstanceDataPacked)
+		{
+			ConstVSInstance.Shift(_pCurrTechInterface->ConstInstanceDataVS, Index);
+			CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, ConstVSInstance, InstanceData[Index]);
+		}
 
 		// Setup instance lights
 		if (_pCurrTechInterface->TechLightCount)
@@ -237,7 +249,7 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 				if (CurrPatch.Lights[i]->GPUIndex != INVALID_INDEX_T<U32>)
 					LightIndexBuffer[LightCount++] = CurrPatch.Lights[i]->GPUIndex;
 			}
-			_pCurrTechInterface->PerInstanceParams.SetRawConstant(_pCurrTechInterface->MemberLightIndices, LightIndexBuffer.data(), sizeof(U32) * LightCount);
+			CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->MemberLightIndices, LightIndexBuffer.data(), sizeof(U32) * LightCount);
 		}
 	}
 
@@ -252,24 +264,24 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 			float GridConsts[2];
 			GridConsts[0] = CDLOD.GetPatchSize() * 0.5f;
 			GridConsts[1] = 1.f / GridConsts[0];
-			_pCurrTechInterface->PerInstanceParams.SetRawConstant(_pCurrTechInterface->ConstGridConsts, GridConsts);
+			CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstGridConsts, GridConsts);
 		}
 
-		_pCurrTechInterface->PerInstanceParams.SetUInt(_pCurrTechInterface->ConstFirstInstanceIndex, 0);
+		CmdList.SetUInt(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstFirstInstanceIndex, 0);
 
-		_pCurrTechInterface->PerInstanceParams.Apply();
+		CmdList.ApplyParams(_pCurrTechInterface->PerInstanceParams);
 
 		const CMesh* pMesh = Terrain.GetPatchMesh();
 		CVertexBuffer* pVB = pMesh->GetVertexBuffer().Get();
-		_pGPU->SetVertexLayout(pVB->GetVertexLayout());
-		_pGPU->SetVertexBuffer(0, pVB);
-		_pGPU->SetIndexBuffer(pMesh->GetIndexBuffer().Get());
+		CmdList.SetVertexLayout(pVB->GetVertexLayout());
+		CmdList.SetVertexBuffer(0, pVB);
+		CmdList.SetIndexBuffer(pMesh->GetIndexBuffer().Get());
 
 		const CPrimitiveGroup* pGroup = pMesh->GetGroup(0);
 		for (const auto& Pass : _pCurrTech->GetPasses())
 		{
-			_pGPU->SetRenderState(Pass);
-			_pGPU->DrawInstanced(*pGroup, FullInstanceCount);
+			CmdList.SetRenderState(Pass);
+			CmdList.DrawInstanced(*pGroup, FullInstanceCount);
 		}
 	}
 
@@ -280,24 +292,24 @@ void CTerrainRenderer::Render(const CRenderContext& Context, IRenderable& Render
 			float GridConsts[2];
 			GridConsts[0] = CDLOD.GetPatchSize() * 0.25f;
 			GridConsts[1] = 1.f / GridConsts[0];
-			_pCurrTechInterface->PerInstanceParams.SetRawConstant(_pCurrTechInterface->ConstGridConsts, GridConsts);
+			CmdList.SetRawConstant(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstGridConsts, GridConsts);
 		}
 
-		_pCurrTechInterface->PerInstanceParams.SetUInt(_pCurrTechInterface->ConstFirstInstanceIndex, FullInstanceCount);
+		CmdList.SetUInt(_pCurrTechInterface->PerInstanceParams, _pCurrTechInterface->ConstFirstInstanceIndex, FullInstanceCount);
 
-		_pCurrTechInterface->PerInstanceParams.Apply();
+		CmdList.ApplyParams(_pCurrTechInterface->PerInstanceParams);
 
 		const CMesh* pMesh = Terrain.GetQuarterPatchMesh();
 		CVertexBuffer* pVB = pMesh->GetVertexBuffer().Get();
-		_pGPU->SetVertexLayout(pVB->GetVertexLayout());
-		_pGPU->SetVertexBuffer(0, pVB);
-		_pGPU->SetIndexBuffer(pMesh->GetIndexBuffer().Get());
+		CmdList.SetVertexLayout(pVB->GetVertexLayout());
+		CmdList.SetVertexBuffer(0, pVB);
+		CmdList.SetIndexBuffer(pMesh->GetIndexBuffer().Get());
 
 		const CPrimitiveGroup* pGroup = pMesh->GetGroup(0);
 		for (const auto& Pass : _pCurrTech->GetPasses())
 		{
-			_pGPU->SetRenderState(Pass);
-			_pGPU->DrawInstanced(*pGroup, QuarterInstanceIndex - FullInstanceCount);
+			CmdList.SetRenderState(Pass);
+			CmdList.DrawInstanced(*pGroup, QuarterInstanceIndex - FullInstanceCount);
 		}
 	}
 }
@@ -36,7 +36,7 @@ public:
 	UPTR			GetVertexCount() const { return VertexCount; }
 	Data::CFlags	GetAccess() const { return Access; }
 	UPTR			GetSizeInBytes() const { return VertexLayout.IsValidPtr() ? VertexLayout->GetVertexSizeInBytes() * VertexCount : 0; }
-	bool			IsValid() const { VertexLayout.IsValidPtr(); }
+	bool			IsValid() const { return VertexLayout.IsValidPtr(); }
 };
 
 typedef Ptr<CVertexBuffer> PVertexBuffer;
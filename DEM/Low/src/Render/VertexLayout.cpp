@@ -59,7 +59,8 @@ CStrID CVertexLayout::BuildSignature(const CVertexComponent* pComponents, UPTR C
 
 		const char* pSrc = Cmp.GetSemanticString();
 		UPTR Len = strlen(pSrc);
-		if (memcpy_s(pCurr, pEnd - pCurr, pSrc, Len) != 0) break;
+		if (static_cast<UPTR>(pEnd - pCurr) < Len) break;
+		memcpy(pCurr, pSrc, Len);
 		pCurr += Len;
 
 		UPTR CmpIdx = Cmp.Index;
@@ -68,25 +69,28 @@ CStrID CVertexLayout::BuildSignature(const CVertexComponent* pComponents, UPTR C
 			n_assert_dbg(CmpIdx < sizeof_array(IndexStrings));
 			pSrc = IndexStrings[CmpIdx];
 			Len = strlen(pSrc);
-			if (memcpy_s(pCurr, pEnd - pCurr, pSrc, Len) != 0) break;
+			if (static_cast<UPTR>(pEnd - pCurr) < Len) break;
+			memcpy(pCurr, pSrc, Len);
 			pCurr += Len;
 		}
 
 		if (pSrc = Cmp.GetFormatString())
 		{
 			Len = strlen(pSrc);
-			if (memcpy_s(pCurr, pEnd - pCurr, pSrc, Len) != 0) break;
+			if (static_cast<UPTR>(pEnd - pCurr) < Len) break;
+			memcpy(pCurr, pSrc, Len);
 			pCurr += Len;
 		}
 
 		UPTR CmpStream = Cmp.Stream;
 		if (CmpStream > 0)
 		{
-			if (memcpy_s(pCurr, pEnd - pCurr, "s", 1) != 0) break;
-			++pCurr;
+			if (pCurr == pEnd) break;
+			*pCurr++ = 's';
 			pSrc = IndexStrings[CmpStream];
 			Len = strlen(pSrc);
-			if (memcpy_s(pCurr, pEnd - pCurr, pSrc, Len) != 0) break;
+			if (static_cast<UPTR>(pEnd - pCurr) < Len) break;
+			memcpy(pCurr, pSrc, Len);
 			pCurr += Len;
 		}
 	}
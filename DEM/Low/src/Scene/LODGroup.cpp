@@ -17,19 +17,17 @@ bool CLODGroup::LoadDataBlocks(IO::CBinaryReader& DataReader, UPTR Count)
 		{
 			case 'TRSH':
 			{
-				// FIXME: must store last LOD (what is rendered after the last threshold).
-				// Nodes are 1 more than thresholds, if min and max distances aren't used.
-
-				short Count;
-				if (!DataReader.Read(Count)) FAIL;
-				for (short i = 0; i < Count; ++i)
+				// Child ID to the max distance at which it is active. Use FLT_MAX for the last LOD
+				// if it must be active at any distance, or leave it out to disable all children.
+				U16 ThresholdCount;
+				if (!DataReader.Read(ThresholdCount)) FAIL;
+				for (U16 i = 0; i < ThresholdCount; ++i)
 				{
-					float Threshold;
 					CStrID ChildID;
-					DataReader.Read<float>(Threshold);
-					DataReader.Read<CStrID>(ChildID);
-					//!!!check FLT_MAX and what if square it!
-					SqThresholds.emplace(Threshold * Threshold, ChildID);
+					float Threshold;
+					if (!DataReader.Read<CStrID>(ChildID)) FAIL;
+					if (!DataReader.Read<float>(Threshold)) FAIL;
+					SqThresholds.emplace((Threshold < FLT_MAX) ? Threshold * Threshold : FLT_MAX, ChildID);
 				}
 				break;
 			}
@@ -63,14 +61,9 @@ void CLODGroup::UpdateBeforeChildren(const rtm::vector4f* pCOIArray, UPTR COICou
 		if (SqDistance > CurrSqDistance) SqDistance = CurrSqDistance;
 	}
 
-	CStrID SelectedChild;
-	for (const auto [SqThreshold, ID] : SqThresholds)
-	{
-		if (SqThreshold > SqDistance)
-			SelectedChild = ID;
-		else
-			break;
-	}
+	// The first threshold not closer than the distance selects the child
+	auto It = SqThresholds.lower_bound(SqDistance);
+	const CStrID SelectedChild = (It != SqThresholds.cend()) ? It->second : CStrID::Empty;
 
 	for (UPTR i = 0; i < _pNode->GetChildCount(); ++i)
 	{
@@ -1,5 +1,6 @@
 #pragma once
 #include <Core/Object.h>
+#include <Scene/SceneNode.h>
 #include <Data/Flags.h>
 #include <Data/StringID.h>
 #include <rtm/vector4f.h>
@@ -69,4 +70,13 @@ public:
 	void                    SetActive(bool Enable) { _Flags.SetTo(SelfActive, Enable); UpdateActivity(); }
 };
 
+// Defined here and not in SceneNode.h, because CNodeAttribute must be complete
+template<class T> inline T* CSceneNode::FindFirstAttribute() const
+{
+	for (const auto& Attr : Attrs)
+		if (auto Casted = Attr->As<T>()) return Casted;
+	return nullptr;
+}
+//---------------------------------------------------------------------
+
 }
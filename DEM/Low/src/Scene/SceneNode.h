@@ -131,7 +131,7 @@ public:
 		{
 			Visitor(*this);
 		}
-		else static_assert(false, "Callback must accept CSceneNode& and return void or bool");
+		else static_assert(always_false_v<F>, "Callback must accept CSceneNode& and return void or bool");
 
 		for (const auto& Child : Children)
 			if (!Child->Visit(Visitor)) return false;
@@ -150,7 +150,7 @@ public:
 		{
 			Visitor(*this);
 		}
-		else static_assert(false, "Callback must accept const CSceneNode& and return void or bool");
+		else static_assert(always_false_v<F>, "Callback must accept const CSceneNode& and return void or bool");
 
 		for (const auto& Child : Children)
 			if (!Child->Visit(Visitor)) return false;
@@ -167,12 +167,4 @@ inline CSceneNode* CSceneNode::FindNodeByPath(const char* pPath) const
 }
 //---------------------------------------------------------------------
 
-template<class T> inline T* CSceneNode::FindFirstAttribute() const
-{
-	for (const auto& Attr : Attrs)
-		if (auto Casted = Attr->As<T>()) return Casted;
-	return nullptr;
-}
-//---------------------------------------------------------------------
-
 }
@@ -1,21 +1,22 @@
 #include "SolLow.h"
 #include <Input/InputTranslator.h>
 #include <Animation/AnimationController.h>
+#if DEM_UI_CEGUI
 #include <UI/UIWindow.h>
 #include <UI/UIContext.h>
 #include <UI/UIServer.h>
+#endif
 #include <Frame/Lights/PointLightAttribute.h>
 #include <Scene/SceneNode.h>
 #include <Scripting/LuaEventHandler.h>
 #include <Events/Signal.h>
 #include <Math/Vector3.h>
 #include <Data/DataArray.h>
-#include <Data/ParamsUtils.h> // CParams::ToString
 
 namespace DEM::Scripting
 {
 
-static sol::object MakeObjectFromData(sol::state_view& s, const Data::CData& Data)
+static sol::object MakeObjectFromData(sol::state_view s, const Data::CData& Data)
 {
 	if (auto* pVal = Data.As<bool>())
 		return sol::make_object(s, *pVal);
@@ -172,7 +173,9 @@ void RegisterBasicTypes(sol::state& State)
 	});
 
 	DEM::Scripting::RegisterSignalType<void()>(State);
+#if DEM_UI_CEGUI
 	DEM::Scripting::RegisterSignalType<void(UI::PUIWindow)>(State);
+#endif
 
 	State.new_usertype<Input::CInputTranslator>("CInputTranslator"
 		, sol::base_classes, sol::bases<::Events::CEventDispatcher>()
@@ -181,6 +184,7 @@ void RegisterBasicTypes(sol::state& State)
 		, "DisableContext", &Input::CInputTranslator::DisableContext
 	);
 
+#if DEM_UI_CEGUI
 	State.new_usertype<UI::CUIWindow>("CUIWindow"
 		, "AddChild", &UI::CUIWindow::AddChild
 		, "RemoveChild", &UI::CUIWindow::RemoveChild
@@ -202,6 +206,7 @@ void RegisterBasicTypes(sol::state& State)
 		, "ReleaseWindow", [](UI::CUIServer& Self, UI::CUIWindow* pWnd) { Self.ReleaseWindow(Ptr(pWnd)); } // FIXME: sol - bind Ptr<Derived> to Ptr<Base>!
 		, "DestroyAllReusableWindows", & UI::CUIServer::DestroyAllReusableWindows
 	);
+#endif
 
 	//!!!TODO: ensure that it is passed by value as HEntity and CStrID!
 	State.new_usertype<HVar>("HVar");
@@ -3,6 +3,9 @@
 #include <Data/Ptr.h>
 #include <Data/StringUtils.h>
 #include <Data/Metadata.h>
+#include <Data/ParamsUtils.h> // CParams::ToString, must be visible from RegisterStringOperations
+#include <magic_enum/magic_enum.hpp>
+#include <Events/Signal.h>
 
 // Wrapper for Sol header with template overrides required for DEM Low layer
 
@@ -57,11 +60,11 @@ void RegisterSignalType(sol::state& State)
 	State.new_usertype<TSignal>(sol::detail::demangle<TSignal>()
 		, "Subscribe", sol::overload(
 			// NB: use lambda overloads to mitigate indefinitely long holding of temporary connection variable in Lua
-			&TSignal::Subscribe<sol::function>
+			&TSignal::template Subscribe<sol::function>
 			, [](TSignal& Self, Events::CConnection& Conn, const sol::function& Fn) { Conn = Self.Subscribe(Fn); }
 			, [](TSignal& Self, std::vector<Events::CConnection>& Conn, const sol::function& Fn) { Conn.push_back(Self.Subscribe(Fn)); }
 		)
-		, "SubscribeAndForget", &TSignal::SubscribeAndForget<sol::function>
+		, "SubscribeAndForget", &TSignal::template SubscribeAndForget<sol::function>
 		, "UnsubscribeAll", &TSignal::UnsubscribeAll
 		, "Empty", &TSignal::Empty
 	);
@@ -124,7 +127,7 @@ sol::usertype<T> RegisterTypeWithMetadata(sol::state_view& State, TArgs&&... Arg
 {
 	static_assert(Meta::CMetadata<T>::IsRegistered);
 
-	auto UserType = Namespace<T>(State).new_usertype<T>(Meta::CMetadata<T>::GetUnqualifiedClassName(), std::forward<TArgs>(Args)...);
+	auto UserType = Namespace<T>(State).template new_usertype<T>(Meta::CMetadata<T>::GetUnqualifiedClassName(), std::forward<TArgs>(Args)...);
 	RegisterMetadataFields(UserType);
 	return UserType;
 }
@@ -205,7 +208,7 @@ TRet LuaCall(const sol::function& Fn, TArgs&&... Args)
 	auto Result = Fn(std::forward<TArgs>(Args)...);
 	if (!Result.valid())
 	{
-		::Sys::Error(Result.get<sol::error>().what());
+		::Sys::Error(Result.template get<sol::error>().what());
 		return TRet{};
 	}
 
@@ -217,7 +220,7 @@ TRet LuaCall(const sol::function& Fn, TArgs&&... Args)
 	}
 	else if constexpr (!std::is_same_v<TRet, void>)
 	{
-		return Result.get<TRet>();
+		return Result.template get<TRet>();
 	}
 }
 //---------------------------------------------------------------------
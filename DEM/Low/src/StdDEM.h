@@ -14,7 +14,7 @@
 namespace DEM::Literals
 {
 
-auto operator ""_format(const char* s, size_t n)
+inline auto operator ""_format(const char* s, size_t n)
 {
 	return [=](auto&&... args) { return fmt::format(fmt::runtime(std::string_view(s, n)), args...); };
 }
@@ -80,6 +80,12 @@ constexpr size_t sizeof_array(const T(&)[N]) { return N; }
 #define DEM_F16C (1)
 #endif
 
+#if defined(_MSC_VER)
+#   define DEM_DEBUG_BREAK() __debugbreak()
+#else
+#   define DEM_DEBUG_BREAK() __builtin_trap()
+#endif
+
 #if defined(_MSC_VER) // __FUNCTION__ ## "()"
 #   define DEM_FUNCTION_NAME __FUNCSIG__
 #elif defined(__GNUC__)
@@ -122,10 +128,13 @@ typedef UPTR				HHandle;
 //---------------------------------------------------------------------
 //  Compiler-dependent aliases
 //---------------------------------------------------------------------
-#if defined(__LINUX__) || defined(__MACOSX__)
-#define n_stricmp strcasecmp
-#else
+#if defined(_MSC_VER)
 #define n_stricmp _stricmp
+#define n_strnicmp _strnicmp
+#else
+#include <strings.h>
+#define n_stricmp strcasecmp
+#define n_strnicmp strncasecmp
 #endif
 
 #ifdef _MSC_VER
@@ -145,7 +154,7 @@ typedef UPTR				HHandle;
 #ifdef _MSC_VER
     #define DEM_NO_INLINE __declspec(noinline)
 #elif defined(__GNUC__) ||  defined(__CLANG__)
-	#define DEM_FORCE_INLINE __attribute__((noinline))
+	#define DEM_NO_INLINE __attribute__((noinline))
 #else
     #define DEM_NO_INLINE
 #endif
@@ -170,6 +179,13 @@ struct ensure_pointer
 
 template<class T> using ensure_pointer_t = typename ensure_pointer<T>::type;
 
+// For static_assert in templates, GCC and Clang reject a plain false before instantiation
+template<class... T> constexpr bool always_false_v = false;
+
+// Defers the lookup of T until the template depending on U is instantiated
+template<class T, class... U> struct dependent_type { using type = T; };
+template<class T, class... U> using dependent_type_t = typename dependent_type<T, U...>::type;
+
 template <typename T, std::size_t ... Indices>
 auto tuple_pop_front_impl(const T& tuple, std::index_sequence<Indices...>)
 {
@@ -129,7 +129,7 @@ private:
 
 public:
 
-	template<typename... TArgs> T* Construct(TArgs&&... Args) { return _Allocator.Construct<T, TArgs...>(std::forward<TArgs>(Args)...); }
-	void Destroy(T* pPtr)  { _Allocator.Destroy<T>(pPtr); }
+	template<typename... TArgs> T* Construct(TArgs&&... Args) { return _Allocator.template Construct<T, TArgs...>(std::forward<TArgs>(Args)...); }
+	void Destroy(T* pPtr)  { _Allocator.template Destroy<T>(pPtr); }
 	void Clear() { _Allocator.Clear(); }
 };
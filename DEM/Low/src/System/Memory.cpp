@@ -68,3 +68,74 @@ CMemoryStats n_dbgmemgetstats()
 
 #endif
 
+
+#if !DEM_PLATFORM_WIN32
+
+#include "Memory.h"
+#include <cstdint>
+#include <cstring>
+
+bool DEM_LogMemory = false;
+
+namespace
+{
+struct CAlignedHeader
+{
+	void*  pRaw;
+	size_t Size;
+};
+}
+
+static inline CAlignedHeader* GetAlignedHeader(void* memblock)
+{
+	return static_cast<CAlignedHeader*>(memblock) - 1;
+}
+//---------------------------------------------------------------------
+
+void* n_malloc_aligned_std(size_t size, size_t Alignment)
+{
+	if (Alignment < alignof(CAlignedHeader)) Alignment = alignof(CAlignedHeader);
+
+	void* pRaw = std::malloc(size + Alignment + sizeof(CAlignedHeader));
+	if (!pRaw) return nullptr;
+
+	const auto Addr = reinterpret_cast<uintptr_t>(pRaw) + sizeof(CAlignedHeader);
+	void* pAligned = reinterpret_cast<void*>((Addr + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1));
+	*GetAlignedHeader(pAligned) = { pRaw, size };
+	return pAligned;
+}
+//---------------------------------------------------------------------
+
+void* n_realloc_aligned_std(void* memblock, size_t size, size_t Alignment)
+{
+	if (!memblock) return n_malloc_aligned_std(size, Alignment);
+
+	if (!size)
+	{
+		n_free_aligned_std(memblock);
+		return nullptr;
+	}
+
+	// Like _aligned_realloc, the original block stays valid on failure
+	void* pNew = n_malloc_aligned_std(size, Alignment);
+	if (!pNew) return nullptr;
+
+	const size_t OldSize = GetAlignedHeader(memblock)->Size;
+	std::memcpy(pNew, memblock, (OldSize < size) ? OldSize : size);
+	n_free_aligned_std(memblock);
+	return pNew;
+}
+//---------------------------------------------------------------------
+
+void n_free_aligned_std(void* memblock)
+{
+	if (memblock) std::free(GetAlignedHeader(memblock)->pRaw);
+}
+//---------------------------------------------------------------------
+
+// No debug heap outside of the MSVC CRT
+void n_dbgmeminit() {}
+int n_dbgmemdumpleaks() { return 0; }
+CMemoryStats n_dbgmemgetstats() { return CMemoryStats{}; }
+
+#endif
@@ -39,10 +39,13 @@ void n_free_aligned_dbg(void* memblock, const char* filename, int line);
 #define n_free_aligned(memblock) _aligned_free(memblock)
 #endif
 #else
-#define n_malloc_aligned(size, alignment) std::aligned_alloc(size, alignment)
-#error "Need n_realloc_aligned"
-//#define n_realloc_aligned(memblock, size, alignment) _aligned_realloc(memblock, size, alignment)
-#define n_free_aligned(memblock) std::free(memblock)
+// There is no standard aligned realloc, so blocks carry a header like _aligned_malloc does
+void* n_malloc_aligned_std(size_t size, size_t Alignment);
+void* n_realloc_aligned_std(void* memblock, size_t size, size_t Alignment);
+void n_free_aligned_std(void* memblock);
+#define n_malloc_aligned(size, alignment) n_malloc_aligned_std(size, alignment)
+#define n_realloc_aligned(memblock, size, alignment) n_realloc_aligned_std(memblock, size, alignment)
+#define n_free_aligned(memblock) n_free_aligned_std(memblock)
 #endif
 
 struct CDeleterFree { void operator()(void* x) { std::free(x); } };
@@ -2,7 +2,7 @@
 #include <IO/IOFwd.h>
 
 // Platform-dependent native file system access interface. Implemented per-platform / OS.
-// Cross-platform implementation may be added with C++17 std filesystem library.
+// COSFileSystemStd is a cross-platform implementation based on the C++17 std filesystem library.
 
 namespace DEM::Sys
 {
@@ -0,0 +1,348 @@
+#include "OSFileSystemStd.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace DEM::Sys
+{
+namespace fs = std::filesystem;
+
+struct CStdFileHandle
+{
+	std::FILE*  pFile;
+	std::string Path; // For size, write time and truncation, which stdio doesn't provide
+};
+
+struct CStdDirHandle
+{
+	fs::directory_iterator It;
+	std::string            Filter;
+};
+
+static inline I64 TellFile(std::FILE* pFile)
+{
+#if defined(_MSC_VER)
+	return _ftelli64(pFile);
+#else
+	return ftello(pFile);
+#endif
+}
+//---------------------------------------------------------------------
+
+static inline bool SeekFile(std::FILE* pFile, I64 Offset, int Origin)
+{
+#if defined(_MSC_VER)
+	return !_fseeki64(pFile, Offset, Origin);
+#else
+	return !fseeko(pFile, static_cast<off_t>(Offset), Origin);
+#endif
+}
+//---------------------------------------------------------------------
+
+// Supports '*' and '?' wildcards, "*.*" matches names without an extension too, as in Win32
+static bool MatchFilter(const char* pFilter, const char* pName)
+{
+	if (!std::strcmp(pFilter, "*.*")) pFilter = "*";
+
+	const char* pStar = nullptr;
+	const char* pStarName = nullptr;
+	while (*pName)
+	{
+		if (*pFilter == '?' || *pFilter == *pName)
+		{
+			++pFilter;
+			++pName;
+		}
+		else if (*pFilter == '*')
+		{
+			pStar = pFilter++;
+			pStarName = pName;
+		}
+		else if (pStar)
+		{
+			pFilter = pStar + 1;
+			pName = ++pStarName;
+		}
+		else FAIL;
+	}
+
+	while (*pFilter == '*') ++pFilter;
+	return !*pFilter;
+}
+//---------------------------------------------------------------------
+
+// Skips entries not matching the filter, returns false when there are no more entries
+static bool ReadDirectoryEntry(CStdDirHandle& Dir, std::string& OutName, IO::EFSEntryType& OutType)
+{
+	std::error_code EC;
+	for (; Dir.It != fs::directory_iterator(); Dir.It.increment(EC))
+	{
+		if (EC) break;
+
+		std::string Name = Dir.It->path().filename().string();
+		if (!Dir.Filter.empty() && !MatchFilter(Dir.Filter.c_str(), Name.c_str())) continue;
+
+		OutName = std::move(Name);
+		OutType = Dir.It->is_directory(EC) ? IO::FSE_DIR : IO::FSE_FILE;
+		OK;
+	}
+
+	OutName.clear();
+	OutType = IO::FSE_NONE;
+	FAIL;
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::IsValidFileName(const char* pName) const
+{
+	if (!pName || !*pName) FAIL;
+	const auto Length = std::strlen(pName);
+	if (Length > 255) FAIL;
+	if (!std::strcmp(pName, ".") || !std::strcmp(pName, "..")) FAIL;
+	return !std::strpbrk(pName, "/\\:*?\"<>|");
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::FileExists(const char* pPath)
+{
+	std::error_code EC;
+	return fs::is_regular_file(pPath, EC);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::IsFileReadOnly(const char* pPath)
+{
+	std::error_code EC;
+	const auto Status = fs::status(pPath, EC);
+	return !EC && fs::exists(Status) && (Status.permissions() & fs::perms::owner_write) == fs::perms::none;
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::SetFileReadOnly(const char* pPath, bool ReadOnly)
+{
+	std::error_code EC;
+	constexpr auto WritePerms = fs::perms::owner_write | fs::perms::group_write | fs::perms::others_write;
+	fs::permissions(pPath, WritePerms, ReadOnly ? fs::perm_options::remove : fs::perm_options::add, EC);
+	return !EC;
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::DeleteFile(const char* pPath)
+{
+	std::error_code EC;
+	return fs::remove(pPath, EC) && !EC;
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::CopyFile(const char* pSrcPath, const char* pDestPath)
+{
+	// Make the file writable if it exist and is read-only
+	if (IsFileReadOnly(pDestPath) && !SetFileReadOnly(pDestPath, false)) FAIL;
+
+	std::error_code EC;
+	return fs::copy_file(pSrcPath, pDestPath, fs::copy_options::overwrite_existing, EC) && !EC;
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::DirectoryExists(const char* pPath)
+{
+	std::error_code EC;
+	return fs::is_directory(pPath, EC);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::CreateDirectory(const char* pPath)
+{
+	std::error_code EC;
+	fs::create_directories(pPath, EC);
+	return !EC && fs::is_directory(pPath, EC);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::DeleteDirectory(const char* pPath)
+{
+	std::error_code EC;
+	fs::remove_all(pPath, EC);
+	return !EC;
+}
+//---------------------------------------------------------------------
+
+void* COSFileSystemStd::OpenDirectory(const char* pPath, const char* pFilter, std::string& OutName, IO::EFSEntryType& OutType)
+{
+	OutName.clear();
+	OutType = IO::FSE_NONE;
+
+	std::error_code EC;
+	fs::directory_iterator It(pPath, EC);
+	if (EC) return nullptr;
+
+	// Filters are appended to the path in Win32 style, like "/*.*"
+	auto pDir = new CStdDirHandle{ std::move(It), std::string() };
+	if (pFilter)
+	{
+		while (*pFilter == '/' || *pFilter == '\\') ++pFilter;
+		pDir->Filter = pFilter;
+	}
+
+	ReadDirectoryEntry(*pDir, OutName, OutType);
+	return pDir;
+}
+//---------------------------------------------------------------------
+
+void COSFileSystemStd::CloseDirectory(void* hDir)
+{
+	n_assert(hDir);
+	delete static_cast<CStdDirHandle*>(hDir);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::NextDirectoryEntry(void* hDir, std::string& OutName, IO::EFSEntryType& OutType)
+{
+	n_assert(hDir);
+	auto& Dir = *static_cast<CStdDirHandle*>(hDir);
+
+	std::error_code EC;
+	if (Dir.It != fs::directory_iterator()) Dir.It.increment(EC);
+	if (EC)
+	{
+		OutName.clear();
+		OutType = IO::FSE_NONE;
+		FAIL;
+	}
+
+	return ReadDirectoryEntry(Dir, OutName, OutType);
+}
+//---------------------------------------------------------------------
+
+void* COSFileSystemStd::OpenFile(const char* pPath, IO::EStreamAccessMode Mode, IO::EStreamAccessPattern /*Pattern*/)
+{
+	if (!pPath || !*pPath) return nullptr;
+
+	std::FILE* pFile = nullptr;
+	switch (Mode)
+	{
+		case IO::SAM_READ:		pFile = std::fopen(pPath, "rb"); break;
+		case IO::SAM_WRITE:		pFile = std::fopen(pPath, "wb"); break;
+		case IO::SAM_READWRITE:
+		case IO::SAM_APPEND:
+		{
+			// Open always, like Win32 OPEN_ALWAYS. "a" mode is not used because it forbids writing before the end.
+			pFile = std::fopen(pPath, "r+b");
+			if (!pFile) pFile = std::fopen(pPath, "w+b");
+			break;
+		}
+	}
+
+	if (!pFile) return nullptr;
+
+	if (Mode == IO::SAM_APPEND) SeekFile(pFile, 0, SEEK_END);
+
+	return new CStdFileHandle{ pFile, pPath };
+}
+//---------------------------------------------------------------------
+
+void COSFileSystemStd::CloseFile(void* hFile)
+{
+	n_assert(hFile);
+	auto pHandle = static_cast<CStdFileHandle*>(hFile);
+	std::fclose(pHandle->pFile);
+	delete pHandle;
+}
+//---------------------------------------------------------------------
+
+UPTR COSFileSystemStd::Read(void* hFile, void* pData, UPTR Size)
+{
+	n_assert(hFile && pData && Size > 0);
+	return std::fread(pData, 1, Size, static_cast<CStdFileHandle*>(hFile)->pFile);
+}
+//---------------------------------------------------------------------
+
+UPTR COSFileSystemStd::Write(void* hFile, const void* pData, UPTR Size)
+{
+	n_assert(hFile && pData && Size > 0);
+	return std::fwrite(pData, 1, Size, static_cast<CStdFileHandle*>(hFile)->pFile);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::Seek(void* hFile, I64 Offset, IO::ESeekOrigin Origin)
+{
+	n_assert(hFile);
+	int SeekOrigin;
+	switch (Origin)
+	{
+		case IO::Seek_Current:	SeekOrigin = SEEK_CUR; break;
+		case IO::Seek_End:		SeekOrigin = SEEK_END; Offset = -Offset; break;
+		default:				SeekOrigin = SEEK_SET; break;
+	}
+	return SeekFile(static_cast<CStdFileHandle*>(hFile)->pFile, Offset, SeekOrigin);
+}
+//---------------------------------------------------------------------
+
+void COSFileSystemStd::Flush(void* hFile)
+{
+	n_assert(hFile);
+	std::fflush(static_cast<CStdFileHandle*>(hFile)->pFile);
+}
+//---------------------------------------------------------------------
+
+bool COSFileSystemStd::IsEOF(void* hFile) const
+{
+	n_assert(hFile);
+	return Tell(hFile) >= GetFileSize(hFile);
+}
+//---------------------------------------------------------------------
+
+// Measured through the stream and not the path, so that unflushed writes are taken into account
+U64 COSFileSystemStd::GetFileSize(void* hFile) const
+{
+	n_assert_dbg(hFile);
+	std::FILE* pFile = static_cast<CStdFileHandle*>(hFile)->pFile;
+	const I64 Pos = TellFile(pFile);
+	if (Pos < 0 || !SeekFile(pFile, 0, SEEK_END)) return 0;
+	const I64 Size = TellFile(pFile);
+	SeekFile(pFile, Pos, SEEK_SET);
+	return (Size > 0) ? static_cast<U64>(Size) : 0;
+}
+//---------------------------------------------------------------------
+
+// Seconds since the unix epoch. C++17 has no clock_cast, so file clock is converted through the current time.
+U64 COSFileSystemStd::GetFileWriteTime(void* hFile) const
+{
+	n_assert_dbg(hFile);
+	std::error_code EC;
+	const auto FileTime = fs::last_write_time(static_cast<CStdFileHandle*>(hFile)->Path, EC);
+	if (EC) return 0;
+
+	const auto SysTime = std::chrono::system_clock::now() +
+		std::chrono::duration_cast<std::chrono::system_clock::duration>(FileTime - fs::file_time_type::clock::now());
+	const auto Seconds = std::chrono::duration_cast<std::chrono::seconds>(SysTime.time_since_epoch()).count();
+	return (Seconds > 0) ? static_cast<U64>(Seconds) : 0;
+}
+//---------------------------------------------------------------------
+
+U64 COSFileSystemStd::Tell(void* hFile) const
+{
+	n_assert(hFile);
+	const I64 Pos = TellFile(static_cast<CStdFileHandle*>(hFile)->pFile);
+	return (Pos > 0) ? static_cast<U64>(Pos) : 0;
+}
+//---------------------------------------------------------------------
+
+// Cuts the file at the current position
+bool COSFileSystemStd::Truncate(void* hFile)
+{
+	n_assert(hFile);
+	auto pHandle = static_cast<CStdFileHandle*>(hFile);
+	if (std::fflush(pHandle->pFile)) FAIL;
+
+	const I64 Pos = TellFile(pHandle->pFile);
+	if (Pos < 0) FAIL;
+
+	std::error_code EC;
+	fs::resize_file(pHandle->Path, static_cast<std::uintmax_t>(Pos), EC);
+	return !EC;
+}
+//---------------------------------------------------------------------
+
+}
@@ -1,5 +1,7 @@
 #include "System.h"
+#if DEM_PLATFORM_WIN32
 #include <crtdbg.h>
+#endif
 
 namespace Sys
 {
@@ -9,13 +11,13 @@ extern void DefaultLogHandler(EMsgType Type, std::string_view Message);
 
 void DebugBreak()
 {
-	__debugbreak();
+	DEM_DEBUG_BREAK();
 }
 //---------------------------------------------------------------------
 
 void Crash(const char* pFile, int Line, std::string_view Message)
 {
-#ifdef _DEBUG
+#if defined(_DEBUG) && DEM_PLATFORM_WIN32
 	const int CRTReportMode = _CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_WNDW);
 	_CrtSetReportMode(_CRT_ERROR, CRTReportMode);
 
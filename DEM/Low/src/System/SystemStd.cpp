@@ -0,0 +1,80 @@
+#if !DEM_PLATFORM_WIN32
+#include <System/System.h>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Portable implementations of OS-specific system functions for platforms without a native one.
+// There is no system UI, so messages go to the standard streams.
+
+namespace Sys
+{
+
+// Without a UI the default button is chosen, so assertions continue execution like after pressing OK
+EMsgBoxButton ShowMessageBox(EMsgType Type, std::string_view HeaderText, std::string_view Message, unsigned int Buttons)
+{
+	std::FILE* pStream = (Type == MsgType_Error) ? stderr : stdout;
+	if (!HeaderText.empty()) std::fprintf(pStream, "%.*s\n", static_cast<int>(HeaderText.size()), HeaderText.data());
+	std::fprintf(pStream, "%.*s\n", static_cast<int>(Message.size()), Message.data());
+	std::fflush(pStream);
+
+	if (Buttons & MBB_OK) return MBB_OK;
+	if (Buttons & MBB_Yes) return MBB_Yes;
+	if (Buttons & MBB_Retry) return MBB_Retry;
+	return MBB_Cancel;
+}
+//---------------------------------------------------------------------
+
+void Sleep(unsigned long MSec)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(MSec));
+}
+//---------------------------------------------------------------------
+
+// Thread names and affinity are only hints, skipped where there is no portable API
+void SetCurrentThreadName(std::string_view /*Name*/)
+{
+}
+//---------------------------------------------------------------------
+
+void SetCurrentThreadAffinity(size_t /*CPUIndex*/)
+{
+}
+//---------------------------------------------------------------------
+
+void SetCurrentThreadAffinity(std::initializer_list<size_t> /*CPUIndices*/)
+{
+}
+//---------------------------------------------------------------------
+
+bool GetKeyName(U8 /*ScanCode*/, bool /*ExtendedKey*/, std::string& /*OutName*/)
+{
+	FAIL;
+}
+//---------------------------------------------------------------------
+
+double GetAppTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+//---------------------------------------------------------------------
+
+void DefaultLogHandler(EMsgType Type, std::string_view Message)
+{
+	if (Message.empty()) return;
+
+	std::FILE* pStream = (Type == MsgType_Error) ? stderr : stdout;
+	std::fwrite(Message.data(), 1, Message.size(), pStream);
+	std::fflush(pStream);
+}
+//---------------------------------------------------------------------
+
+bool TraceStack(char* /*pTrace*/, unsigned int /*MaxLength*/)
+{
+	FAIL;
+}
+//---------------------------------------------------------------------
+
+}
+
+#endif
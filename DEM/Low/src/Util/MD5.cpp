@@ -85,8 +85,8 @@ std::string CMD5::PrintMD5(U8 md5Digest[16])
 
     for (nCount = 0; nCount < 16; nCount++)
     {
-        sprintf_s(chEach, "%02x", md5Digest[nCount]);
-        strncat_s(chBuffer, chEach, sizeof(chEach));
+        snprintf(chEach, sizeof(chEach), "%02x", md5Digest[nCount]);
+        strncat(chBuffer, chEach, sizeof(chEach));
     }
 
     return std::string(chBuffer);
@@ -5,6 +5,8 @@
 #include <AI/Perception/Perception.h>
 #include <AI/AIStateComponent.h>
 #include <AI/Perception/VisionSensorComponent.h>
+#include <AI/Perception/VisibleComponent.h>
+#include <Scene/SceneComponent.h>
 #include <AI/Perception/SoundSensorComponent.h>
 #include <AI/AILevel.h>
 
@@ -16,6 +18,7 @@ namespace DEM::Game
 namespace DEM::RPG
 {
 constexpr size_t MAX_STIMULI_PER_TICK = 128;
+constexpr size_t MAX_VISION_SENSORS_PER_TICK = 64; // Each sensor must be updated more often than its facts are forgotten
 constexpr float SoundAttenuationCoeff = 0.05f; // TODO: can set in AI level or even vary at different points of the level
 constexpr float LowestUsefulIntensity = 0.01f; // TODO: must set in AI manager
 
@@ -77,6 +80,24 @@ static inline bool ForgetFact(AI::CSensedStimulus& Fact, uint32_t CurrTimestamp,
 }
 //---------------------------------------------------------------------
 
+// Time since the last update after which ForgetFact changes the fact. Must match thresholds in ForgetFact.
+static inline uint32_t GetForgetDelay(const AI::CSensedStimulus& Fact, float PersonalModifier = 1.f)
+{
+	float Threshold;
+	if (Fact.Awareness <= AI::EAwareness::Faint)
+		Threshold = 3.f;
+	else if (Fact.TypeFlags & static_cast<uint8_t>(AI::EStimulusType::Movement))
+		Threshold = 2.f;
+	else if (Fact.Awareness >= AI::EAwareness::Strong)
+		Threshold = 5.f;
+	else
+		Threshold = 2.f;
+
+	// ForgetFact fires when the time is strictly greater than the threshold
+	return static_cast<uint32_t>(Threshold / PersonalModifier) + 1;
+}
+//---------------------------------------------------------------------
+
 static inline AI::EAwareness MergeAwareness(AI::EAwareness a, AI::EAwareness b)
 {
 	// Full awareness is special, it can't be reached by combining information from multiple stimuli
@@ -88,84 +109,186 @@ static inline AI::EAwareness MergeAwareness(AI::EAwareness a, AI::EAwareness b)
 //---------------------------------------------------------------------
 
 // TODO: move common logic to DEMGame as utility function(s)
-void ProcessVisionSensors(Game::CGameSession& Session, Game::CGameWorld& World, Game::CGameLevel& Level)
+void ProcessVisionSensors(Game::CGameSession& Session, Game::CGameWorld& World, Game::CGameLevel& Level, Jobs::CWorker* pWorker)
 {
+	auto* pAILevel = Level.GetAI();
+	if (!pAILevel) return;
+
+	ZoneScoped;
+
+	struct CVisionSensorTask
+	{
+		rtm::vector4f                     Position;
+		const AI::CVisionSensorComponent* pSensor;
+		AI::CAIStateComponent*            pAIState;
+		Game::HEntity                     ID;
+	};
+
+	struct CVisionContact
+	{
+		U32             SensorIndex;
+		U32             ObjectIndex;
+		AI::EAwareness  Awareness;
+		uint8_t         TypeFlags;
+	};
+
+	//!!!DBG TMP! Need reusable buffers in an AI system!
+	static std::vector<CVisionSensorTask> Sensors;
+	static std::vector<U32> Candidates;
+	static std::vector<CVisionContact> Contacts;
+	static std::vector<Game::CGameLevel::CPickRay> LOSRays;
+	static std::vector<Physics::CPhysicsObject*> LOSBlockers;
+
+	Sensors.clear();
+	float MaxSenseRange = 0.f;
 	World.ForEachEntityInLevelWith<const AI::CVisionSensorComponent, AI::CAIStateComponent>(Level.GetID(),
-		[&Session, &Level](auto SensorID, auto& Entity, const AI::CVisionSensorComponent& Sensor, AI::CAIStateComponent& AIState)
+		[&MaxSenseRange](auto SensorID, auto& Entity, const AI::CVisionSensorComponent& Sensor, AI::CAIStateComponent& AIState)
 	{
 		if (!Sensor.Node || Sensor.MaxRadius <= 0.f) return; // continue
 
-		ZoneScopedN("VisionSensor");
-
-		// skip by sparse update, sensors must be distributed more or less evenly among frames
+		Sensors.push_back({ Sensor.Node->GetWorldPosition(), &Sensor, &AIState, SensorID });
+		MaxSenseRange = std::max(MaxSenseRange, Sensor.MaxRadius);
+	});
 
-		//???separate collision world and simplified shapes for sensing? or add sensing collision flags to physics bodies and existing colliders?
+	if (Sensors.empty()) return;
 
-		// TODO PERF: could reuse shape and collision flags and perform contactTest manually, but is it really benefical?
-		Level.EnumEntitiesInSphere(Sensor.Node->GetWorldPosition(), Sensor.MaxRadius, /* "Visible"sv */ ""sv,
-			[&Session, &Level, &Sensor, SensorID, &AIState](Game::HEntity StimulusID, const rtm::vector4f& ContactPos)
-		{
-			if (AIState.NewStimuli.size() >= MAX_STIMULI_PER_TICK) return false; // break
-
-			if (StimulusID == SensorID) return true; // continue
+	// Collect visible objects into the level broadphase once instead of running a physics contact test per sensor
+	//???separate collision world and simplified shapes for sensing? or add sensing collision flags to physics bodies and existing colliders?
+	pAILevel->ClearVisibleObjects();
+	World.ForEachEntityInLevelWith<const AI::CVisibleComponent, const Game::CSceneComponent>(Level.GetID(),
+		[pAILevel](auto EntityID, auto& Entity, const AI::CVisibleComponent& Visible, const Game::CSceneComponent& Scene)
+	{
+		if (!Scene.RootNode) return;
 
-			const auto& SensorTfm = Sensor.Node->GetWorldMatrix();
-			const auto SensorPos = SensorTfm.w_axis;
-			const auto FromSensorToContact = rtm::vector_sub(ContactPos, SensorPos);
+		const auto Position = rtm::vector_add(Scene.RootNode->GetWorldPosition(), rtm::vector_set(0.f, Visible.TargetHeight, 0.f, 0.f));
+		pAILevel->AddVisibleObject(EntityID, Position, Visible.Visibility);
+	});
+	pAILevel->BuildVisibleObjectHash(MaxSenseRange);
 
-			// Test against max vision distance
-			// FIXME: why physics system reports such contacts?
-			const float DistanceToContactSq = rtm::vector_length_squared3(FromSensorToContact);
-			if (DistanceToContactSq > Sensor.MaxRadiusSq) return true; // continue
+	// Only a part of sensors is updated each frame, so that the cost doesn't grow with the number of guards
+	const UPTR SensorCount = Sensors.size();
+	const UPTR SliceSize = std::min<UPTR>(SensorCount, MAX_VISION_SENSORS_PER_TICK);
+	const UPTR FirstSensor = pAILevel->TimeSliceVisionSensors(SensorCount, MAX_VISION_SENSORS_PER_TICK);
 
-			// Test against max vision angle
-			const auto LookatDir = rtm::vector_normalize3(rtm::vector_neg(SensorTfm.z_axis));
-			const auto ContactDir = rtm::vector_mul(FromSensorToContact, rtm::scalar_sqrt_reciprocal(DistanceToContactSq));
-			const float CosLookAtStimulus = rtm::vector_dot3(LookatDir, ContactDir);
-			if (CosLookAtStimulus < Sensor.CosHalfMaxFOV) return true; // continue
+	Contacts.clear();
+	for (UPTR i = 0; i < SliceSize; ++i)
+	{
+		ZoneScopedN("VisionSensor");
 
-			// Modify stimulus intensity with peripheral vision and distance coefficients
-			float Modifier = 1.f;
-			if (CosLookAtStimulus < Sensor.CosHalfPerfectFOV)
-				Modifier *= 1.f - (Sensor.CosHalfPerfectFOV - CosLookAtStimulus) / (Sensor.CosHalfPerfectFOV - Sensor.CosHalfMaxFOV);
-			if (DistanceToContactSq > Sensor.PerfectRadiusSq)
-				Modifier *= 1.f - (rtm::scalar_sqrt(DistanceToContactSq) - Sensor.PerfectRadius) / (Sensor.MaxRadius - Sensor.PerfectRadius);
-			n_assert_dbg(Modifier > 0.f);
+		const U32 SensorIndex = static_cast<U32>((FirstSensor + i) % SensorCount);
+		const auto& Task = Sensors[SensorIndex];
+		const auto& Sensor = *Task.pSensor;
 
-			// Apply game logic
-			AI::EAwareness Awareness = AI::EAwareness::None;
-			uint8_t TypeFlags = 0;
-			RPG::SenseVisualStimulus(Session, SensorID, StimulusID, Modifier, Awareness, TypeFlags);
-			if (Awareness == AI::EAwareness::None) return true; // continue
+		Candidates.clear();
+		pAILevel->ForEachVisibleObjectInRange(Task.Position, Sensor.MaxRadius, [pAILevel, &Task](U32 ObjectIndex)
+		{
+			if (pAILevel->GetVisibleObject(ObjectIndex).ID != Task.ID) Candidates.push_back(ObjectIndex);
+		});
 
-			// Perform line of sight test
-			// TODO PERF:
-			//   can use navmesh raycast as a cheap first chance check, must work good with walls etc
-			//   can offset raycast to target side if it is moving, or try multiple raycasts to sides and upper/lower parts
-			//   can do raycast async, but wait for results if this stimulus is considered by decision making? Or when merging starts?
-			//   raycast can be performed less frequently then a sensor test, especially if the object has passed a raycast test before
-			//   may do async raycasts for objects with previous successfull raycast, i.e. currently visible ones
-			//   must not filter out characters standing one after another! Check only static geometry and dynamic things like doors?
-			if (auto* pLOSBlocker = Level.GetFirstPickIntersection(SensorPos, ContactPos, nullptr, /*"Visible|Static|Dynamic"sv*/ ""sv, SensorID))
+		if (Candidates.empty()) continue;
+
+		const auto LookatDir = rtm::vector_normalize3(rtm::vector_neg(Sensor.Node->GetWorldMatrix().z_axis));
+		const auto SensorX = rtm::vector_dup_x(Task.Position);
+		const auto SensorY = rtm::vector_dup_y(Task.Position);
+		const auto SensorZ = rtm::vector_dup_z(Task.Position);
+		const auto LookatX = rtm::vector_dup_x(LookatDir);
+		const auto LookatY = rtm::vector_dup_y(LookatDir);
+		const auto LookatZ = rtm::vector_dup_z(LookatDir);
+		const auto MaxRadiusSq = rtm::vector_set(Sensor.MaxRadiusSq);
+		const auto CosHalfMaxFOV = rtm::vector_set(Sensor.CosHalfMaxFOV);
+		const auto MinDistance = rtm::vector_set(0.0001f);
+
+		// Test candidates against max vision distance and angle, 4 at a time. The last group is padded with the last candidate.
+		const UPTR CandidateCount = Candidates.size();
+		for (UPTR j = 0; j < CandidateCount; j += 4)
+		{
+			const UPTR Last = CandidateCount - 1;
+			const auto& Pos0 = pAILevel->GetVisibleObject(Candidates[j]).Position;
+			const auto& Pos1 = pAILevel->GetVisibleObject(Candidates[std::min(j + 1, Last)]).Position;
+			const auto& Pos2 = pAILevel->GetVisibleObject(Candidates[std::min(j + 2, Last)]).Position;
+			const auto& Pos3 = pAILevel->GetVisibleObject(Candidates[std::min(j + 3, Last)]).Position;
+
+			rtm::vector4f X, Y, Z;
+			RTM_MATRIXF_TRANSPOSE_4X3(Pos0, Pos1, Pos2, Pos3, X, Y, Z);
+
+			const auto DX = rtm::vector_sub(X, SensorX);
+			const auto DY = rtm::vector_sub(Y, SensorY);
+			const auto DZ = rtm::vector_sub(Z, SensorZ);
+			const auto DistanceSq = rtm::vector_mul_add(DZ, DZ, rtm::vector_mul_add(DY, DY, rtm::vector_mul(DX, DX)));
+			const auto Distance = rtm::vector_sqrt(DistanceSq);
+			const auto Dot = rtm::vector_mul_add(DZ, LookatZ, rtm::vector_mul_add(DY, LookatY, rtm::vector_mul(DX, LookatX)));
+			const auto CosLookAt = rtm::vector_div(Dot, rtm::vector_max(Distance, MinDistance));
+			const auto Mask = rtm::mask_and(rtm::vector_less_equal(DistanceSq, MaxRadiusSq), rtm::vector_greater_equal(CosLookAt, CosHalfMaxFOV));
+			if (!rtm::mask_any_true(Mask)) continue;
+
+			const bool Passed[4] = { !!rtm::mask_get_x(Mask), !!rtm::mask_get_y(Mask), !!rtm::mask_get_z(Mask), !!rtm::mask_get_w(Mask) };
+			float DistanceArray[4];
+			float CosLookAtArray[4];
+			rtm::vector_store(Distance, DistanceArray);
+			rtm::vector_store(CosLookAt, CosLookAtArray);
+
+			const UPTR LaneCount = std::min<UPTR>(4, CandidateCount - j);
+			for (UPTR Lane = 0; Lane < LaneCount; ++Lane)
 			{
-				Game::CTargetInfo LOSCollision;
-				Game::GetTargetFromPhysicsObject(*pLOSBlocker, LOSCollision);
-				if (LOSCollision.Entity != StimulusID) return true; // continue
+				if (!Passed[Lane]) continue;
+
+				// Modify stimulus intensity with peripheral vision and distance coefficients
+				const float CosLookAtStimulus = CosLookAtArray[Lane];
+				float Modifier = 1.f;
+				if (CosLookAtStimulus < Sensor.CosHalfPerfectFOV)
+					Modifier *= 1.f - (Sensor.CosHalfPerfectFOV - CosLookAtStimulus) / (Sensor.CosHalfPerfectFOV - Sensor.CosHalfMaxFOV);
+				if (DistanceArray[Lane] > Sensor.PerfectRadius)
+					Modifier *= 1.f - (DistanceArray[Lane] - Sensor.PerfectRadius) / (Sensor.MaxRadius - Sensor.PerfectRadius);
+				if (Modifier <= 0.f) continue; // Exactly at the max distance or angle
+
+				// Apply game logic
+				const U32 ObjectIndex = Candidates[j + Lane];
+				AI::EAwareness Awareness = AI::EAwareness::None;
+				uint8_t TypeFlags = 0;
+				RPG::SenseVisualStimulus(Session, Task.ID, pAILevel->GetVisibleObject(ObjectIndex).ID, Modifier, Awareness, TypeFlags);
+				if (Awareness == AI::EAwareness::None) continue;
+
+				Contacts.push_back({ SensorIndex, ObjectIndex, Awareness, TypeFlags });
 			}
+		}
+	}
 
-			// Register a new stimulus in the AI brain
-			auto& Stimulus = AIState.NewStimuli.emplace_back();
-			Stimulus.Position = ContactPos;
-			Stimulus.SourceID = StimulusID;
-			//Stimulus.AddedTimestamp - here or later when merging?
-			//Stimulus.UpdatedTimestamp - here or later when merging?
-			Stimulus.Awareness = Awareness;
-			Stimulus.TypeFlags = TypeFlags;
-			Stimulus.ModalityFlags = (1 << static_cast<uint8_t>(AI::ESenseModality::Vision));
+	// Perform line of sight tests for all contacts of all sensors in one batch
+	// TODO PERF:
+	//   can use navmesh raycast as a cheap first chance check, must work good with walls etc
+	//   can offset raycast to target side if it is moving, or try multiple raycasts to sides and upper/lower parts
+	//   raycast can be performed less frequently then a sensor test, especially if the object has passed a raycast test before
+	//   must not filter out characters standing one after another! Check only static geometry and dynamic things like doors?
+	LOSRays.clear();
+	for (const auto& Contact : Contacts)
+		LOSRays.push_back({ Sensors[Contact.SensorIndex].Position, pAILevel->GetVisibleObject(Contact.ObjectIndex).Position, Sensors[Contact.SensorIndex].ID });
+	LOSBlockers.resize(LOSRays.size());
+	Level.GetFirstPickIntersections(LOSRays.data(), LOSBlockers.data(), nullptr, LOSRays.size(), /*"Visible|Static|Dynamic"sv*/ ""sv, pWorker);
+
+	for (UPTR i = 0; i < Contacts.size(); ++i)
+	{
+		const auto& Contact = Contacts[i];
+		auto& AIState = *Sensors[Contact.SensorIndex].pAIState;
+		if (AIState.NewStimuli.size() >= MAX_STIMULI_PER_TICK) continue;
 
-			return true; // continue
-		});
-	});
+		const auto& Object = pAILevel->GetVisibleObject(Contact.ObjectIndex);
+		if (auto* pLOSBlocker = LOSBlockers[i])
+		{
+			Game::CTargetInfo LOSCollision;
+			Game::GetTargetFromPhysicsObject(*pLOSBlocker, LOSCollision);
+			if (LOSCollision.Entity != Object.ID) continue;
+		}
+
+		// Register a new stimulus in the AI brain
+		auto& Stimulus = AIState.NewStimuli.emplace_back();
+		Stimulus.Position = Object.Position;
+		Stimulus.SourceID = Object.ID;
+		//Stimulus.AddedTimestamp - here or later when merging?
+		//Stimulus.UpdatedTimestamp - here or later when merging?
+		Stimulus.Awareness = Contact.Awareness;
+		Stimulus.TypeFlags = Contact.TypeFlags;
+		Stimulus.ModalityFlags = (1 << static_cast<uint8_t>(AI::ESenseModality::Vision));
+	}
 }
 //---------------------------------------------------------------------
 
@@ -251,95 +374,65 @@ void ProcessSoundSensors(Game::CGameSession& Session, Game::CGameWorld& World, G
 
 void MergeAIMemory(Game::CGameWorld& World)
 {
-	//!!!DBG TMP! Need a reusable buffer in an AI system!
-	std::vector<AI::CSensedStimulus> MergedFacts;
-
 	// TODO: need time e.g. in msec from game start, enough for 46 days. Or in AI ticks for memory fact forgetting?
 	//!!!DBG TMP!
 	static uint32_t Timer = 0;
 	uint32_t CurrTimestamp = ++Timer;
 
-	World.ForEachComponent<AI::CAIStateComponent>([&MergedFacts, CurrTimestamp](auto EntityID, AI::CAIStateComponent& AIState)
+	World.ForEachComponent<AI::CAIStateComponent>([CurrTimestamp](auto EntityID, AI::CAIStateComponent& AIState)
 	{
 		//!!!TODO PERF: sparse update! AI ticks and dividing to subsequent frames for an even workload.
 
 		ZoneScopedN("MergeAIMemory");
 
-		if (AIState.NewStimuli.empty() && AIState.Facts.empty()) return; // continue
-
-		MergedFacts.clear();
-		MergedFacts.reserve(std::max(AIState.NewStimuli.size(), AIState.Facts.size()));
+		if (AIState.NewStimuli.empty() && AIState.Facts.IsEmpty()) return; // continue
 
-		// Shift sourceless stimuly to the end of the range, sort sourceful ones by source ID
-		const auto ItNewBegin = AIState.NewStimuli.begin();
-		auto ItNewEnd = std::partition(ItNewBegin, AIState.NewStimuli.end(), [](const AI::CSensedStimulus& Fact) { return Fact.SourceID; });
-		std::sort(ItNewBegin, ItNewEnd, [](const AI::CSensedStimulus& a, const AI::CSensedStimulus& b) { return a.SourceID < b.SourceID; });
-
-		auto ItNew = ItNewBegin;
-		bool IsEndNew = (ItNew == ItNewEnd);
-
-		auto ItCurr = AIState.Facts.begin();
-		auto ItCurrEnd = ItCurr + AIState.FactWithSourceCount;
-		bool IsEndCurr = (ItCurr == ItCurrEnd);
-
-		// Merge existing facts and new stimuli into a new memory state, only for records with sources defined
-		while (!IsEndNew || !IsEndCurr)
+		for (const auto& Stimulus : AIState.NewStimuli)
 		{
-			if (IsEndCurr || (!IsEndNew && ItNew->SourceID < ItCurr->SourceID))
+			// Sourceless records are saved as separate facts /*TODO: but within a limit*/.
+			//!!!TODO: merge by proximity! use k-d tree like nanoflann? or grid spatial hash? or naive O(m*n) is ok for our case with small element count?
+			if (!Stimulus.SourceID)
 			{
-				// Only new stimulus, simply add
-				auto& MergedFact = MergedFacts.emplace_back(*ItNew);
-				MergedFact.AddedTimestamp = CurrTimestamp;
-				MergedFact.UpdatedTimestamp = CurrTimestamp;
-				IsEndNew = (++ItNew == ItNewEnd);
+				const auto Index = AIState.Facts.Add(Stimulus);
+				auto& Fact = AIState.Facts.GetFact(Index);
+				Fact.AddedTimestamp = CurrTimestamp;
+				Fact.UpdatedTimestamp = CurrTimestamp;
+				AIState.Facts.Schedule(Index, CurrTimestamp + GetForgetDelay(Fact));
+				continue;
 			}
-			else if (IsEndNew || ItCurr->SourceID < ItNew->SourceID)
+
+			bool Added;
+			const auto Index = AIState.Facts.FindOrAdd(Stimulus.SourceID, Added);
+			auto& Fact = AIState.Facts.GetFact(Index);
+			if (Added)
 			{
-				// Only old stimulus, apply forgetting and discard if totally forgotten
-				if (!ForgetFact(*ItCurr, CurrTimestamp))
-					MergedFacts.push_back(*ItCurr);
-				IsEndCurr = (++ItCurr == ItCurrEnd);
+				// Only new stimulus, simply add
+				Fact = Stimulus;
+				Fact.AddedTimestamp = CurrTimestamp;
 			}
-			else // equal
+			else
 			{
-				// Update the existing stimulus with new info
-				auto& MergedFact = MergedFacts.emplace_back(*ItCurr);
-				MergedFact.UpdatedTimestamp = CurrTimestamp;
-				IsEndCurr = (++ItCurr == ItCurrEnd);
-
-				do
-				{
-					if (ItNew->Awareness > AI::EAwareness::Faint && ItNew->Awareness >= MergedFact.Awareness)
-						MergedFact.Position = ItNew->Position;
-					MergedFact.Awareness = MergeAwareness(ItNew->Awareness, MergedFact.Awareness);
-					MergedFact.TypeFlags = (ItNew->TypeFlags | MergedFact.TypeFlags);
-					MergedFact.ModalityFlags = (ItNew->ModalityFlags | MergedFact.ModalityFlags);
-
-					IsEndNew = (++ItNew == ItNewEnd);
-				}
-				while (!IsEndNew && ItNew->SourceID == MergedFact.SourceID);
+				// Update the existing fact with new info
+				if (Stimulus.Awareness > AI::EAwareness::Faint && Stimulus.Awareness >= Fact.Awareness)
+					Fact.Position = Stimulus.Position;
+				Fact.Awareness = MergeAwareness(Stimulus.Awareness, Fact.Awareness);
+				Fact.TypeFlags = (Stimulus.TypeFlags | Fact.TypeFlags);
+				Fact.ModalityFlags = (Stimulus.ModalityFlags | Fact.ModalityFlags);
 			}
-		}
+			Fact.UpdatedTimestamp = CurrTimestamp;
 
-		// Remember the count before adding sourceless facts
-		AIState.FactWithSourceCount = MergedFacts.size();
-
-		// Merge sourceless records by proximity, first new, then existing.
-		// What haven't been merged is saved as separate facts /*TODO: but within a limit*/.
-		//!!!TODO: merge by proximity! use k-d tree like nanoflann? or grid spatial hash? or naive O(m*n) is ok for our case with small element count?
-		for (; ItNew != AIState.NewStimuli.end(); ++ItNew)
-		{
-			MergedFacts.push_back(*ItNew);
-		}
-		for (; ItCurr != AIState.Facts.end(); ++ItCurr)
-		{
-			MergedFacts.push_back(*ItCurr);
+			// Sensed facts are not forgotten this tick, their forgetting starts over
+			AIState.Facts.Schedule(Index, CurrTimestamp + GetForgetDelay(Fact));
 		}
 
-		// Store a new memory state in the AI brain
-		// TODO PERF: can prevent all buffers to grow to the size of the biggest one among all actors? May copy contents instead of swap, but it is slower!
-		std::swap(AIState.Facts, MergedFacts);
 		AIState.NewStimuli.clear();
+
+		// Apply forgetting only to facts whose rules may fire by now and discard totally forgotten ones
+		AIState.Facts.Update(CurrTimestamp, [CurrTimestamp](AI::CSensedStimulus& Fact) -> std::optional<uint32_t>
+		{
+			if (ForgetFact(Fact, CurrTimestamp)) return std::nullopt;
+			return Fact.UpdatedTimestamp + GetForgetDelay(Fact);
+		});
 	});
 }
 //---------------------------------------------------------------------
@@ -815,7 +815,7 @@ static size_t CalcTimeTriggerActivationCount(float PrevTime, float dt, float Del
 	if (Period <= 0.f)
 		return WaitFirstTick && Delay <= NewTime; // will return 1 or 0
 
-	float NextTickTime = WaitFirstTick ? Delay : (PrevTime + Period - std::fmodf(PrevTime - Delay, Period));
+	float NextTickTime = WaitFirstTick ? Delay : (PrevTime + Period - std::fmod(PrevTime - Delay, Period));
 	size_t TickCount = 0;
 	while (NextTickTime <= NewTime)
 	{
@@ -0,0 +1,536 @@
+#include "Main.h"
+
+#include <IO/IOServer.h>
+#include <IO/PathUtils.h>
+#include <Data/ParamsUtils.h>
+#include <sqlite3.h>
+
+// Build cache stores, for each exported file, the tool and the command line it was built with and
+// the content hashes of all inputs it depends on, including dependencies discovered during the build.
+// An output is skipped when none of them changed. File content hashes are cached by size and write
+// time, so unchanged files are hashed only once. Package contents are tracked the same way.
+
+static sqlite3*			BuildCacheDB = NULL;
+static sqlite3_stmt*	SQLFindFileStamp = NULL;
+static sqlite3_stmt*	SQLWriteFileStamp = NULL;
+static sqlite3_stmt*	SQLFindOutput = NULL;
+static sqlite3_stmt*	SQLWriteOutput = NULL;
+static sqlite3_stmt*	SQLFindInputs = NULL;
+static sqlite3_stmt*	SQLWriteInput = NULL;
+static sqlite3_stmt*	SQLDeleteInputs = NULL;
+static sqlite3_stmt*	SQLDeleteOutput = NULL;
+static sqlite3_stmt*	SQLFindPackedFiles = NULL;
+static sqlite3_stmt*	SQLWritePackedFile = NULL;
+static sqlite3_stmt*	SQLDeletePackedFiles = NULL;
+
+static bool InitSQL(sqlite3_stmt** ppStmt, const char* pSQL)
+{
+	if (sqlite3_prepare_v2(BuildCacheDB, pSQL, -1, ppStmt, NULL) == SQLITE_OK) OK;
+	n_msg(VL_ERROR, "Build cache SQL error: %s\n", sqlite3_errmsg(BuildCacheDB));
+	FAIL;
+}
+//---------------------------------------------------------------------
+
+// Runs the statement to completion, waiting if the DB is locked by another builder process
+static bool ExecuteStatement(sqlite3_stmt* pStmt)
+{
+	int Result;
+	do
+	{
+		Result = sqlite3_step(pStmt);
+		if (Result == SQLITE_BUSY) Sys::Sleep(100);
+		else if (Result != SQLITE_ROW && Result != SQLITE_DONE)
+		{
+			n_msg(VL_ERROR, "Build cache SQL error: %s\n", sqlite3_errmsg(BuildCacheDB));
+			sqlite3_reset(pStmt);
+			FAIL;
+		}
+	}
+	while (Result != SQLITE_DONE);
+
+	sqlite3_reset(pStmt);
+	OK;
+}
+//---------------------------------------------------------------------
+
+// Returns true if a row is available, false if the query is finished
+static bool StepQuery(sqlite3_stmt* pStmt)
+{
+	int Result;
+	do
+	{
+		Result = sqlite3_step(pStmt);
+		if (Result == SQLITE_BUSY) Sys::Sleep(100);
+	}
+	while (Result == SQLITE_BUSY);
+
+	return Result == SQLITE_ROW;
+}
+//---------------------------------------------------------------------
+
+static void BindText(sqlite3_stmt* pStmt, const char* pParam, const CString& Value)
+{
+	sqlite3_bind_text(pStmt, sqlite3_bind_parameter_index(pStmt, pParam), Value.CStr(), -1, SQLITE_TRANSIENT);
+}
+//---------------------------------------------------------------------
+
+static void BindU64(sqlite3_stmt* pStmt, const char* pParam, U64 Value)
+{
+	sqlite3_bind_int64(pStmt, sqlite3_bind_parameter_index(pStmt, pParam), (sqlite3_int64)Value);
+}
+//---------------------------------------------------------------------
+
+// All paths are stored resolved and lowercase, so the same file always produces the same key
+static CString GetCacheKey(const CString& Path)
+{
+	CString Key = IOSrv->ResolveAssigns(Path);
+	Key.Replace('\\', '/');
+	Key.ToLower();
+	return Key;
+}
+//---------------------------------------------------------------------
+
+// FNV-1a, 64 bit
+U64 GetStringHash(const char* pString, U64 Hash)
+{
+	if (!pString) return Hash;
+	for (; *pString; ++pString)
+	{
+		Hash ^= static_cast<U8>(*pString);
+		Hash *= 0x100000001b3ULL;
+	}
+	return Hash;
+}
+//---------------------------------------------------------------------
+
+static U64 HashFileContents(const CString& Path)
+{
+	IO::PStream File = IOSrv->CreateStream(Path);
+	if (!File->Open(IO::SAM_READ, IO::SAP_SEQUENTIAL)) return 0;
+
+	U64 Hash = 0xcbf29ce484222325ULL;
+	U8 Chunk[64 * 1024];
+	UPTR ReadSize;
+	while ((ReadSize = File->Read(Chunk, sizeof(Chunk))) > 0)
+	{
+		for (UPTR i = 0; i < ReadSize; ++i)
+		{
+			Hash ^= Chunk[i];
+			Hash *= 0x100000001b3ULL;
+		}
+	}
+
+	File->Close();
+
+	// Zero is reserved for missing files
+	return Hash ? Hash : 1;
+}
+//---------------------------------------------------------------------
+
+bool OpenBuildCache(const CString& DBFilePath)
+{
+	n_assert(!BuildCacheDB);
+
+	CString RealPath = IOSrv->ResolveAssigns(DBFilePath);
+	IOSrv->CreateDirectory(PathUtils::ExtractDirName(RealPath));
+
+	if (sqlite3_open_v2(RealPath.CStr(), &BuildCacheDB, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK)
+	{
+		n_msg(VL_ERROR, "Can't open build cache '%s': %s\n", RealPath.CStr(), sqlite3_errmsg(BuildCacheDB));
+		sqlite3_close(BuildCacheDB);
+		BuildCacheDB = NULL;
+		FAIL;
+	}
+
+	const char* pInitSQL = "\
+PRAGMA encoding = \"UTF-8\";\
+PRAGMA journal_mode=MEMORY;\
+PRAGMA synchronous=NORMAL;\
+PRAGMA temp_store=MEMORY;\
+CREATE TABLE IF NOT EXISTS 'FileStamps' (\
+	'Path' VARCHAR(1024) NOT NULL,\
+	'Size' INTEGER,\
+	'WriteTime' INTEGER,\
+	'Hash' INTEGER,\
+	PRIMARY KEY (Path) ON CONFLICT REPLACE);\
+CREATE TABLE IF NOT EXISTS 'Outputs' (\
+	'Path' VARCHAR(1024) NOT NULL,\
+	'ToolHash' INTEGER,\
+	'CmdHash' INTEGER,\
+	'Hash' INTEGER,\
+	PRIMARY KEY (Path) ON CONFLICT REPLACE);\
+CREATE TABLE IF NOT EXISTS 'Inputs' (\
+	'OutputPath' VARCHAR(1024) NOT NULL,\
+	'InputPath' VARCHAR(1024) NOT NULL,\
+	'Hash' INTEGER,\
+	PRIMARY KEY (OutputPath, InputPath) ON CONFLICT REPLACE);\
+CREATE TABLE IF NOT EXISTS 'PackedFiles' (\
+	'Package' VARCHAR(1024) NOT NULL,\
+	'Path' VARCHAR(1024) NOT NULL,\
+	'Hash' INTEGER,\
+	PRIMARY KEY (Package, Path) ON CONFLICT REPLACE)";
+
+	char* pError = NULL;
+	if (sqlite3_exec(BuildCacheDB, pInitSQL, NULL, NULL, &pError) != SQLITE_OK)
+	{
+		n_msg(VL_ERROR, "Can't initialize build cache: %s\n", pError);
+		sqlite3_free(pError);
+		CloseBuildCache();
+		FAIL;
+	}
+
+	if (!InitSQL(&SQLFindFileStamp, "SELECT Size, WriteTime, Hash FROM FileStamps WHERE Path=:Path") ||
+		!InitSQL(&SQLWriteFileStamp, "INSERT INTO FileStamps (Path, Size, WriteTime, Hash) VALUES (:Path, :Size, :WriteTime, :Hash)") ||
+		!InitSQL(&SQLFindOutput, "SELECT ToolHash, CmdHash, Hash FROM Outputs WHERE Path=:Path") ||
+		!InitSQL(&SQLWriteOutput, "INSERT INTO Outputs (Path, ToolHash, CmdHash, Hash) VALUES (:Path, :ToolHash, :CmdHash, :Hash)") ||
+		!InitSQL(&SQLFindInputs, "SELECT InputPath, Hash FROM Inputs WHERE OutputPath=:OutputPath") ||
+		!InitSQL(&SQLWriteInput, "INSERT INTO Inputs (OutputPath, InputPath, Hash) VALUES (:OutputPath, :InputPath, :Hash)") ||
+		!InitSQL(&SQLDeleteInputs, "DELETE FROM Inputs WHERE OutputPath=:OutputPath") ||
+		!InitSQL(&SQLDeleteOutput, "DELETE FROM Outputs WHERE Path=:Path") ||
+		!InitSQL(&SQLFindPackedFiles, "SELECT Path, Hash FROM PackedFiles WHERE Package=:Package") ||
+		!InitSQL(&SQLWritePackedFile, "INSERT INTO PackedFiles (Package, Path, Hash) VALUES (:Package, :Path, :Hash)") ||
+		!InitSQL(&SQLDeletePackedFiles, "DELETE FROM PackedFiles WHERE Package=:Package"))
+	{
+		CloseBuildCache();
+		FAIL;
+	}
+
+	OK;
+}
+//---------------------------------------------------------------------
+
+void CloseBuildCache()
+{
+	if (!BuildCacheDB) return;
+
+	sqlite3_stmt** Statements[] =
+	{
+		&SQLFindFileStamp, &SQLWriteFileStamp, &SQLFindOutput, &SQLWriteOutput, &SQLFindInputs, &SQLWriteInput,
+		&SQLDeleteInputs, &SQLDeleteOutput, &SQLFindPackedFiles, &SQLWritePackedFile, &SQLDeletePackedFiles
+	};
+
+	for (sqlite3_stmt** ppStmt : Statements)
+	{
+		if (*ppStmt)
+		{
+			sqlite3_finalize(*ppStmt);
+			*ppStmt = NULL;
+		}
+	}
+
+	sqlite3_close(BuildCacheDB);
+	BuildCacheDB = NULL;
+}
+//---------------------------------------------------------------------
+
+// Returns 0 for missing files. Works without the cache DB too, but then always reads the file.
+U64 GetFileContentHash(const CString& FilePath)
+{
+	CString Path = GetCacheKey(FilePath);
+	if (!IOSrv->FileExists(Path)) return 0;
+
+	const U64 Size = IOSrv->GetFileSize(Path);
+	const U64 WriteTime = IOSrv->GetFileWriteTime(Path);
+
+	if (BuildCacheDB)
+	{
+		U64 Hash = 0;
+		BindText(SQLFindFileStamp, ":Path", Path);
+		if (StepQuery(SQLFindFileStamp) &&
+			(U64)sqlite3_column_int64(SQLFindFileStamp, 0) == Size &&
+			(U64)sqlite3_column_int64(SQLFindFileStamp, 1) == WriteTime)
+		{
+			Hash = (U64)sqlite3_column_int64(SQLFindFileStamp, 2);
+		}
+		sqlite3_reset(SQLFindFileStamp);
+		if (Hash) return Hash;
+	}
+
+	const U64 Hash = HashFileContents(Path);
+
+	if (BuildCacheDB && Hash)
+	{
+		BindText(SQLWriteFileStamp, ":Path", Path);
+		BindU64(SQLWriteFileStamp, ":Size", Size);
+		BindU64(SQLWriteFileStamp, ":WriteTime", WriteTime);
+		BindU64(SQLWriteFileStamp, ":Hash", Hash);
+		ExecuteStatement(SQLWriteFileStamp);
+	}
+
+	return Hash;
+}
+//---------------------------------------------------------------------
+
+static bool IsShaderSource(const char* pPath)
+{
+	return PathUtils::CheckExtension(pPath, "hlsl") ||
+		PathUtils::CheckExtension(pPath, "hlsli") ||
+		PathUtils::CheckExtension(pPath, "fx") ||
+		PathUtils::CheckExtension(pPath, "fxh") ||
+		PathUtils::CheckExtension(pPath, "h");
+}
+//---------------------------------------------------------------------
+
+// CFShader compiles with the standard D3D include handler, which resolves both "" and <> includes
+// relative to the including file. Includes are followed recursively, conditional compilation is
+// ignored, so the result is a superset of the real include closure. Missing files are skipped.
+static void CollectShaderIncludes(const CString& FilePath, CArray<CString>& Out)
+{
+	Data::CBuffer Buffer;
+	if (!IOSrv->LoadFileToBuffer(FilePath, Buffer)) return;
+
+	const CString FileDir = PathUtils::ExtractDirName(FilePath);
+	const char* pCurr = static_cast<const char*>(Buffer.GetPtr());
+	const char* pEnd = pCurr + Buffer.GetSize();
+	while (pCurr < pEnd)
+	{
+		const char* pLineEnd = static_cast<const char*>(memchr(pCurr, '\n', pEnd - pCurr));
+		if (!pLineEnd) pLineEnd = pEnd;
+
+		// Match '#' 'include' with optional whitespace around '#'
+		const char* pChar = pCurr;
+		while (pChar < pLineEnd && (*pChar == ' ' || *pChar == '\t')) ++pChar;
+		if (pChar < pLineEnd && *pChar == '#')
+		{
+			++pChar;
+			while (pChar < pLineEnd && (*pChar == ' ' || *pChar == '\t')) ++pChar;
+			if (pLineEnd - pChar > 7 && !strncmp(pChar, "include", 7))
+			{
+				pChar += 7;
+				while (pChar < pLineEnd && (*pChar == ' ' || *pChar == '\t')) ++pChar;
+				if (pChar < pLineEnd && (*pChar == '"' || *pChar == '<'))
+				{
+					const char CloseChar = (*pChar == '"') ? '"' : '>';
+					const char* pNameStart = ++pChar;
+					while (pChar < pLineEnd && *pChar != CloseChar) ++pChar;
+					if (pChar < pLineEnd && pChar > pNameStart)
+					{
+						CString IncludePath = FileDir + CString(std::string(pNameStart, pChar).c_str());
+						if (IOSrv->FileExists(IncludePath) && !Out.Contains(IncludePath))
+						{
+							Out.Add(IncludePath);
+							CollectShaderIncludes(IncludePath, Out);
+						}
+					}
+				}
+			}
+		}
+
+		pCurr = pLineEnd + 1;
+	}
+}
+//---------------------------------------------------------------------
+
+static void CollectFileReferences(const Data::CData& Value, CArray<CString>& Out)
+{
+	if (Value.IsA<Data::PParams>())
+	{
+		const Data::CParams& Desc = *Value.GetValue<Data::PParams>();
+		for (UPTR i = 0; i < Desc.GetCount(); ++i)
+			CollectFileReferences(Desc.Get(i).GetRawValue(), Out);
+	}
+	else if (Value.IsA<Data::PDataArray>())
+	{
+		const Data::CDataArray& Array = *Value.GetValue<Data::PDataArray>();
+		for (UPTR i = 0; i < Array.GetCount(); ++i)
+			CollectFileReferences(Array.Get(i), Out);
+	}
+	else if (Value.IsA<CString>())
+	{
+		// Only paths with an assign or a drive are considered, e.g. "SrcShaders:Common.hlsl"
+		const CString& Str = Value.GetValue<CString>();
+		if (Str.FindIndex(':') != INVALID_INDEX && IOSrv->FileExists(Str) && !Out.Contains(Str))
+		{
+			Out.Add(Str);
+			if (IsShaderSource(Str.CStr())) CollectShaderIncludes(IOSrv->ResolveAssigns(Str), Out);
+		}
+	}
+}
+//---------------------------------------------------------------------
+
+// Discovers files referenced from the HRD desc and the include closure of referenced shader sources,
+// so that the output is rebuilt when any of them changes
+void CollectDescDependencies(const CString& DescFilePath, CArray<CString>& Out)
+{
+	if (!Out.Contains(DescFilePath)) Out.Add(DescFilePath);
+
+	Data::PParams Desc;
+	ParamsUtils::LoadParamsFromHRD(DescFilePath, Desc);
+	if (Desc.IsValidPtr()) CollectFileReferences(Data::CData(Desc), Out);
+}
+//---------------------------------------------------------------------
+
+// Hashes a set of input paths, so that adding or removing an input changes the hash even if the
+// files that remain are not changed. Order of paths doesn't matter.
+U64 GetInputSetHash(const CArray<CString>& Inputs, U64 Hash)
+{
+	CArray<CString> Keys;
+	for (UPTR i = 0; i < Inputs.GetCount(); ++i)
+		Keys.InsertSorted(GetCacheKey(Inputs[i]));
+
+	for (UPTR i = 0; i < Keys.GetCount(); ++i)
+	{
+		Hash = GetStringHash(Keys[i].CStr(), Hash);
+		Hash = GetStringHash("\n", Hash); // Separator, so that "ab"+"c" and "a"+"bc" differ
+	}
+
+	return Hash;
+}
+//---------------------------------------------------------------------
+
+// Tool version is identified by the hash of its executable, so rebuilding a tool invalidates its outputs
+U64 GetExternalToolHash(CStrID Name)
+{
+	return GetStringHash(VERSION, GetFileContentHash(GetExternalToolPath(Name)));
+}
+//---------------------------------------------------------------------
+
+bool IsOutputUpToDate(const CString& OutputPath, U64 ToolHash, U64 CmdHash)
+{
+	if (!BuildCacheDB || RebuildAll) FAIL;
+
+	CString Path = GetCacheKey(OutputPath);
+
+	bool Found = false;
+	U64 RecordedHash = 0;
+	BindText(SQLFindOutput, ":Path", Path);
+	if (StepQuery(SQLFindOutput))
+	{
+		Found = ((U64)sqlite3_column_int64(SQLFindOutput, 0) == ToolHash && (U64)sqlite3_column_int64(SQLFindOutput, 1) == CmdHash);
+		RecordedHash = (U64)sqlite3_column_int64(SQLFindOutput, 2);
+	}
+	sqlite3_reset(SQLFindOutput);
+
+	// The output itself must be intact, it might be deleted or edited by hand
+	if (!Found || GetFileContentHash(Path) != RecordedHash) FAIL;
+
+	bool UpToDate = true;
+	BindText(SQLFindInputs, ":OutputPath", Path);
+	while (StepQuery(SQLFindInputs))
+	{
+		CString InputPath((const char*)sqlite3_column_text(SQLFindInputs, 0));
+		const U64 InputHash = (U64)sqlite3_column_int64(SQLFindInputs, 1);
+		if (GetFileContentHash(InputPath) != InputHash)
+		{
+			n_msg(VL_DETAILS, "  Input changed: %s\n", InputPath.CStr());
+			UpToDate = false;
+			break;
+		}
+	}
+	sqlite3_reset(SQLFindInputs);
+
+	return UpToDate;
+}
+//---------------------------------------------------------------------
+
+// Inputs may contain both declared sources and dependencies discovered while building the output
+void RecordOutput(const CString& OutputPath, U64 ToolHash, U64 CmdHash, const CArray<CString>& Inputs)
+{
+	if (!BuildCacheDB) return;
+
+	CString Path = GetCacheKey(OutputPath);
+
+	sqlite3_exec(BuildCacheDB, "BEGIN TRANSACTION", NULL, NULL, NULL);
+
+	BindText(SQLDeleteInputs, ":OutputPath", Path);
+	ExecuteStatement(SQLDeleteInputs);
+
+	for (UPTR i = 0; i < Inputs.GetCount(); ++i)
+	{
+		CString InputPath = GetCacheKey(Inputs[i]);
+		BindText(SQLWriteInput, ":OutputPath", Path);
+		BindText(SQLWriteInput, ":InputPath", InputPath);
+		BindU64(SQLWriteInput, ":Hash", GetFileContentHash(InputPath));
+		ExecuteStatement(SQLWriteInput);
+	}
+
+	BindText(SQLWriteOutput, ":Path", Path);
+	BindU64(SQLWriteOutput, ":ToolHash", ToolHash);
+	BindU64(SQLWriteOutput, ":CmdHash", CmdHash);
+	BindU64(SQLWriteOutput, ":Hash", GetFileContentHash(Path));
+	ExecuteStatement(SQLWriteOutput);
+
+	sqlite3_exec(BuildCacheDB, "COMMIT TRANSACTION", NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------
+
+// Failed builds must not leave a record, or a half-written output would be considered up to date
+void InvalidateOutput(const CString& OutputPath)
+{
+	if (!BuildCacheDB) return;
+
+	CString Path = GetCacheKey(OutputPath);
+	BindText(SQLDeleteOutput, ":Path", Path);
+	ExecuteStatement(SQLDeleteOutput);
+	BindText(SQLDeleteInputs, ":OutputPath", Path);
+	ExecuteStatement(SQLDeleteInputs);
+}
+//---------------------------------------------------------------------
+
+// Files must be sorted. Directories are packed recursively and can't be tracked by a single hash, so
+// a package containing them is always considered outdated.
+bool IsPackageUpToDate(const CArray<CString>& Files, const CString& PkgFileName)
+{
+	if (!BuildCacheDB || RebuildAll) FAIL;
+
+	CString Package = GetCacheKey(PkgFileName);
+	if (!IOSrv->FileExists(Package)) FAIL;
+
+	UPTR MatchedCount = 0;
+	bool UpToDate = true;
+	BindText(SQLFindPackedFiles, ":Package", Package);
+	while (StepQuery(SQLFindPackedFiles))
+	{
+		CString Path((const char*)sqlite3_column_text(SQLFindPackedFiles, 0));
+		const U64 Hash = (U64)sqlite3_column_int64(SQLFindPackedFiles, 1);
+		if (Files.FindIndexSorted(Path) == INVALID_INDEX || GetFileContentHash(Path) != Hash)
+		{
+			n_msg(VL_DETAILS, "  Package entry changed: %s\n", Path.CStr());
+			UpToDate = false;
+			break;
+		}
+		++MatchedCount;
+	}
+	sqlite3_reset(SQLFindPackedFiles);
+
+	// Entries added since the last packing
+	return UpToDate && MatchedCount == Files.GetCount();
+}
+//---------------------------------------------------------------------
+
+void RecordPackage(const CArray<CString>& Files, const CString& PkgFileName)
+{
+	if (!BuildCacheDB) return;
+
+	CString Package = GetCacheKey(PkgFileName);
+
+	sqlite3_exec(BuildCacheDB, "BEGIN TRANSACTION", NULL, NULL, NULL);
+
+	BindText(SQLDeletePackedFiles, ":Package", Package);
+	ExecuteStatement(SQLDeletePackedFiles);
+
+	// A package with directories is left without records, see IsPackageUpToDate()
+	bool HasDirectories = false;
+	for (UPTR i = 0; i < Files.GetCount(); ++i)
+	{
+		if (IOSrv->DirectoryExists(Files[i]))
+		{
+			HasDirectories = true;
+			break;
+		}
+	}
+
+	if (!HasDirectories)
+	{
+		for (UPTR i = 0; i < Files.GetCount(); ++i)
+		{
+			BindText(SQLWritePackedFile, ":Package", Package);
+			BindText(SQLWritePackedFile, ":Path", GetCacheKey(Files[i]));
+			BindU64(SQLWritePackedFile, ":Hash", GetFileContentHash(Files[i]));
+			ExecuteStatement(SQLWritePackedFile);
+		}
+	}
+
+	sqlite3_exec(BuildCacheDB, "COMMIT TRANSACTION", NULL, NULL, NULL);
+}
+//---------------------------------------------------------------------
@@ -15,15 +15,22 @@ void BatchToolInOut(CStrID Name, const CString& InStr, const CString& OutStr)
 }
 //---------------------------------------------------------------------
 
-int RunExternalToolAsProcess(CStrID Name, char* pCmdLine, const char* pWorkingDir)
+CString GetExternalToolPath(CStrID Name)
 {
-	n_msg(VL_DETAILS, "> %s %s\n", Name.CStr(), pCmdLine);
-
 	CString Path = IOSrv->ResolveAssigns("Home:");
 	Path += "\\..\\ContentForge\\";
 	Path += Name.CStr();
 	Path +=	".exe";
 	Path.Replace('/', '\\');
+	return Path;
+}
+//---------------------------------------------------------------------
+
+int RunExternalToolAsProcess(CStrID Name, char* pCmdLine, const char* pWorkingDir)
+{
+	n_msg(VL_DETAILS, "> %s %s\n", Name.CStr(), pCmdLine);
+
+	CString Path = GetExternalToolPath(Name);
 
 	PROCESS_INFORMATION Info;
 	::RtlZeroMemory(&Info, sizeof(Info));
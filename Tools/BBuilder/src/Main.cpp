@@ -14,6 +14,7 @@ bool			IncludeSM30ShadersAndEffects;	// For legacy D3D9 API
 bool			DebugShaders;
 int				Verbose = VL_ERROR;
 int				ExternalVerbosity = VL_ALWAYS;	// Only always printed messages by default
+bool			RebuildAll;						// Ignore the build cache and rebuild everything
 
 CArray<CString>	FilesToPack;
 CArray<U32>		ShadersToPack;
@@ -37,6 +38,9 @@ int main(int argc, const char** argv)
 	IncludeSM30ShadersAndEffects = Args.GetBoolArg("-sm3");
 	DebugShaders = Args.GetBoolArg("-ds");
 
+	// If true, up-to-date outputs from the build cache will be rebuilt too
+	RebuildAll = Args.GetBoolArg("-rebuild");
+
 	// If true, application will wait for key before exit
 	bool WaitKey = Args.GetBoolArg("-waitkey");
 
@@ -87,6 +91,10 @@ int main(int argc, const char** argv)
 		IOSrv->CopyFile("Proj:PathList.hrd", "Build:PathList.hrd");
 	}
 
+	// Without the cache everything is rebuilt, so it is not an error
+	if (!OpenBuildCache("Build:BuildCache.db3"))
+		n_msg(VL_WARNING, "Build cache is not available, all files will be rebuilt\n");
+
 	//???rewrite HRD/PRM to return CData? change root symbol in grammar, so could store array and anything else
 	Data::PParams ClassToFOURCCDesc;
 	ParamsUtils::LoadParamsFromHRD("Proj:ClassToFOURCC.hrd", ClassToFOURCCDesc);
@@ -327,9 +335,16 @@ int main(int argc, const char** argv)
 	}
 	FilesToPack.Sort();
 
+	// NPK stores file data contiguously with offsets in the TOC, so a change in any entry requires
+	// writing the whole package. Skip it entirely when no entry changed since the last packing.
 	CString DestFile("Build:Export.npk");
-	if (PackFiles(FilesToPack, DestFile, ProjectDir, CString("Export")))
+	if (IsPackageUpToDate(FilesToPack, DestFile))
 	{
+		n_msg(VL_INFO, "NPK is up to date: %s\n", IOSrv->ResolveAssigns(DestFile).CStr());
+	}
+	else if (PackFiles(FilesToPack, DestFile, ProjectDir, CString("Export")))
+	{
+		RecordPackage(FilesToPack, DestFile);
 		n_msg(VL_INFO, "\nNPK file:      %s\nNPK file size: %.3f MB\n",
 			IOSrv->ResolveAssigns(DestFile).CStr(),
 			IOSrv->GetFileSize(DestFile) / (1024.f * 1024.f));
@@ -356,6 +371,8 @@ int ExitApp(bool NoError, bool WaitKey)
 
 	Schemes.Clear();
 
+	CloseBuildCache();
+
 	return NoError ? 0 : 1;
 }
 //---------------------------------------------------------------------
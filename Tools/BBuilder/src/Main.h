@@ -24,6 +24,7 @@ extern bool				IncludeSM30ShadersAndEffects;
 extern bool				DebugShaders;
 extern int				Verbose;
 extern int				ExternalVerbosity;
+extern bool				RebuildAll;
 extern CArray<CString>	FilesToPack;
 extern CArray<U32>		ShadersToPack;
 extern CToolFileLists	InFileLists;
@@ -45,11 +46,25 @@ bool	ProcessEntityTplsInFolder(const CString& SrcPath, const CString& ExportPath
 bool	ProcessQuestsInFolder(const CString& SrcPath, const CString& ExportPath);
 bool	ProcessSOActionTplsDesc(const CString& SrcFilePath, const CString& ExportFilePath);
 void	BatchToolInOut(CStrID Name, const CString& InStr, const CString& OutStr);
+CString	GetExternalToolPath(CStrID Name);
 int		RunExternalToolAsProcess(CStrID Name, char* pCmdLine, const char* pWorkingDir = NULL);
 int		RunExternalToolBatch(CStrID Tool, int Verb, const char* pExtraCmdLine = NULL, const char* pWorkingDir = NULL);
 bool	PackFiles(const CArray<CString>& FilesToPack, const CString& PkgFileName, const CString& PkgRoot, CString PkgRootDir);
 int		ExitApp(bool NoError, bool WaitKey);
 
+bool	OpenBuildCache(const CString& DBFilePath);
+void	CloseBuildCache();
+U64		GetStringHash(const char* pString, U64 Hash = 0xcbf29ce484222325ULL);
+U64		GetFileContentHash(const CString& FilePath);
+U64		GetExternalToolHash(CStrID Name);
+bool	IsOutputUpToDate(const CString& OutputPath, U64 ToolHash, U64 CmdHash);
+void	CollectDescDependencies(const CString& DescFilePath, CArray<CString>& Out);
+U64		GetInputSetHash(const CArray<CString>& Inputs, U64 Hash);
+void	RecordOutput(const CString& OutputPath, U64 ToolHash, U64 CmdHash, const CArray<CString>& Inputs);
+void	InvalidateOutput(const CString& OutputPath);
+bool	IsPackageUpToDate(const CArray<CString>& Files, const CString& PkgFileName);
+void	RecordPackage(const CArray<CString>& Files, const CString& PkgFileName);
+
 inline bool IsFileAdded(const CString& File)
 {
 	return FilesToPack.FindIndexSorted(File) != INVALID_INDEX;
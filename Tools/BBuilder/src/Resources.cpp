@@ -26,8 +26,10 @@ bool ProcessResourceDesc(const CString& RsrcFileName, const CString& ExportFileN
 
 		if (Tool == CStrID("CFTerrain"))
 		{
-			CString InStr = IOSrv->ResolveAssigns(RsrcDir + RsrcDesc->Get<CString>(CStrID("In")));
-			CString OutStr = IOSrv->ResolveAssigns(ExportFileName);
+			CString InPath = IOSrv->ResolveAssigns(RsrcDir + RsrcDesc->Get<CString>(CStrID("In")));
+			CString OutPath = IOSrv->ResolveAssigns(ExportFileName);
+			CString InStr = InPath;
+			CString OutStr = OutPath;
 
 			int PatchSize = RsrcDesc->Get<int>(CStrID("PatchSize"), 8);
 			int LODCount = RsrcDesc->Get<int>(CStrID("LODCount"), 6);
@@ -35,18 +37,35 @@ bool ProcessResourceDesc(const CString& RsrcFileName, const CString& ExportFileN
 			if (InStr.FindIndex(' ') != INVALID_INDEX) InStr = "\"" + InStr + "\"";
 			if (OutStr.FindIndex(' ') != INVALID_INDEX) OutStr = "\"" + OutStr + "\"";
 
+			// Verbosity doesn't affect the result, so it is not a part of the cached command line
+			char Args[MAX_CMDLINE_CHARS];
+			sprintf_s(Args, "-patch %d -lod %d -in %s -out %s", PatchSize, LODCount, InStr.CStr(), OutStr.CStr());
+
+			const U64 ToolHash = GetExternalToolHash(Tool);
+			const U64 CmdHash = GetStringHash(Args);
+			if (IsOutputUpToDate(OutPath, ToolHash, CmdHash))
+			{
+				n_msg(VL_DETAILS, "  Up to date: %s\n", OutPath.CStr());
+				continue;
+			}
+
 			CString WorkingDir;
 			Sys::GetWorkingDirectory(WorkingDir);
 
 			char CmdLine[MAX_CMDLINE_CHARS];
-			sprintf_s(CmdLine, "-v %d -patch %d -lod %d -in %s -out %s",
-				ExternalVerbosity, PatchSize, LODCount, InStr.CStr(), OutStr.CStr());
+			sprintf_s(CmdLine, "-v %d %s", ExternalVerbosity, Args);
 			int ExitCode = RunExternalToolAsProcess(Tool, CmdLine, WorkingDir.CStr());
 			if (ExitCode != 0)
 			{
 				n_msg(VL_ERROR, "External tool %s execution failed\n", Tool.CStr());
+				InvalidateOutput(OutPath);
 				FAIL;
 			}
+
+			CArray<CString> Inputs;
+			Inputs.Add(RsrcFileName);
+			Inputs.Add(InPath);
+			RecordOutput(OutPath, ToolHash, CmdHash, Inputs);
 		}
 		else if (Tool == CStrID("CFCopy") || Tool == CStrID("CFLua"))
 		{
@@ -63,63 +82,113 @@ bool ProcessResourceDesc(const CString& RsrcFileName, const CString& ExportFileN
 //???cut out IOSrv assigns from it and use only absolute pathes?
 bool ExportEffect(const CString& SrcFilePath, const CString& ExportFilePath, bool LegacySM30, bool Debug)
 {
-	CString InStr = IOSrv->ResolveAssigns(SrcFilePath);
-	CString OutStr = IOSrv->ResolveAssigns(ExportFilePath);
+	CString InPath = IOSrv->ResolveAssigns(SrcFilePath);
+	CString OutPath = IOSrv->ResolveAssigns(ExportFilePath);
+	CString InStr = InPath;
+	CString OutStr = OutPath;
 
 	if (InStr.FindIndex(' ') != INVALID_INDEX) InStr = "\"" + InStr + "\"";
 	if (OutStr.FindIndex(' ') != INVALID_INDEX) OutStr = "\"" + OutStr + "\"";
 
-	CString WorkingDir;
-	Sys::GetWorkingDirectory(WorkingDir);
-
-	char CmdLine[MAX_CMDLINE_CHARS];
-	sprintf_s(CmdLine, "-v %d %s%s-proj %s -in %s -out %s",
-		ExternalVerbosity,
+	char Args[MAX_CMDLINE_CHARS];
+	sprintf_s(Args, "%s%s-proj %s -in %s -out %s",
 		LegacySM30 ? "-sm3 " : "",
 		Debug ? "-d " : "",
 		ProjectDir.CStr(),
 		InStr.CStr(),
 		OutStr.CStr());
-	int ExitCode = RunExternalToolAsProcess(CStrID("CFShader"), CmdLine, WorkingDir.CStr());
+
+	const CStrID Tool("CFShader");
+	const U64 ToolHash = GetExternalToolHash(Tool);
+	const U64 CmdHash = GetStringHash(Args);
+	if (IsOutputUpToDate(OutPath, ToolHash, CmdHash))
+	{
+		n_msg(VL_DETAILS, "  Up to date: %s\n", OutPath.CStr());
+		OK;
+	}
+
+	CString WorkingDir;
+	Sys::GetWorkingDirectory(WorkingDir);
+
+	char CmdLine[MAX_CMDLINE_CHARS];
+	sprintf_s(CmdLine, "-v %d %s", ExternalVerbosity, Args);
+	int ExitCode = RunExternalToolAsProcess(Tool, CmdLine, WorkingDir.CStr());
 	if (ExitCode != 0)
 	{
 		n_msg(VL_ERROR, "External tool CFShader execution failed\n");
+		InvalidateOutput(OutPath);
 		FAIL;
 	}
 
+	// Shader sources and other files referenced by the effect desc
+	CArray<CString> Inputs;
+	CollectDescDependencies(InPath, Inputs);
+	RecordOutput(OutPath, ToolHash, CmdHash, Inputs);
+
 	OK;
 }
 //---------------------------------------------------------------------
 
 bool ExportRenderPath(const CString& SrcFilePath, const CString& ExportFilePath, bool LegacySM30, bool Debug)
 {
-	CString InStr = IOSrv->ResolveAssigns(SrcFilePath);
-	CString OutStr = IOSrv->ResolveAssigns(ExportFilePath);
+	CString InPath = IOSrv->ResolveAssigns(SrcFilePath);
+	CString OutPath = IOSrv->ResolveAssigns(ExportFilePath);
+	CString InStr = InPath;
+	CString OutStr = OutPath;
 
 	if (InStr.FindIndex(' ') != INVALID_INDEX) InStr = "\"" + InStr + "\"";
 	if (OutStr.FindIndex(' ') != INVALID_INDEX) OutStr = "\"" + OutStr + "\"";
 
-	CString WorkingDir;
-	Sys::GetWorkingDirectory(WorkingDir);
-
 	CString EffDir = IOSrv->ResolveAssigns(LegacySM30 ? "Shaders:SM_3_0/Effects" : "Shaders:USM/Effects");
 
-	char CmdLine[MAX_CMDLINE_CHARS];
-	sprintf_s(CmdLine, "-v %d -rp %s%s-proj \"%s\" -eff \"%s\" -in \"%s\" -out \"%s\"",
-		ExternalVerbosity,
+	char Args[MAX_CMDLINE_CHARS];
+	sprintf_s(Args, "-rp %s%s-proj \"%s\" -eff \"%s\" -in \"%s\" -out \"%s\"",
 		LegacySM30 ? "-sm3 " : "",
 		Debug ? "-d " : "",
 		ProjectDir.CStr(),
 		EffDir.CStr(),
 		InStr.CStr(),
 		OutStr.CStr());
-	int ExitCode = RunExternalToolAsProcess(CStrID("CFShader"), CmdLine, WorkingDir.CStr());
+
+	// Render path reads exported effects from EffDir. Effects are exported before render paths, so
+	// all effect files known at this point are a conservative superset of the real dependencies.
+	// Recorded inputs are only re-hashed, so the current set is a part of the command hash to
+	// rebuild the render path when an effect is added or removed.
+	CArray<CString> Inputs;
+	CollectDescDependencies(InPath, Inputs);
+	CString EffDirKey = EffDir;
+	EffDirKey.ToLower();
+	for (UPTR i = 0; i < FilesToPack.GetCount(); ++i)
+	{
+		CString File = IOSrv->ResolveAssigns(FilesToPack[i]);
+		File.ToLower();
+		if (!strncmp(File.CStr(), EffDirKey.CStr(), EffDirKey.GetLength())) Inputs.Add(File);
+	}
+
+	const CStrID Tool("CFShader");
+	const U64 ToolHash = GetExternalToolHash(Tool);
+	const U64 CmdHash = GetInputSetHash(Inputs, GetStringHash(Args));
+	if (IsOutputUpToDate(OutPath, ToolHash, CmdHash))
+	{
+		n_msg(VL_DETAILS, "  Up to date: %s\n", OutPath.CStr());
+		OK;
+	}
+
+	CString WorkingDir;
+	Sys::GetWorkingDirectory(WorkingDir);
+
+	char CmdLine[MAX_CMDLINE_CHARS];
+	sprintf_s(CmdLine, "-v %d %s", ExternalVerbosity, Args);
+	int ExitCode = RunExternalToolAsProcess(Tool, CmdLine, WorkingDir.CStr());
 	if (ExitCode != 0)
 	{
 		n_msg(VL_ERROR, "External tool CFShader execution failed\n");
+		InvalidateOutput(OutPath);
 		FAIL;
 	}
 
+	RecordOutput(OutPath, ToolHash, CmdHash, Inputs);
+
 	OK;
 }
 //---------------------------------------------------------------------
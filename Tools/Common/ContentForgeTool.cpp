@@ -3,7 +3,12 @@
 #include <Utils.h>
 #include <CLI11.hpp>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <conio.h>
 
 namespace fs = std::filesystem;
@@ -30,6 +35,7 @@ void CContentForgeTool::ProcessCommandLine(CLI::App& CLIApp)
 	CLIApp.add_option("-v", _LogVerbosity, "Verbosity level")->check(
 		CLI::Range(static_cast<int>(EVerbosity::Always), static_cast<int>(EVerbosity::Debug)));
 	CLIApp.add_option("-w,--waitkey", _WaitKey, "Wait for key press after the tool has finished");
+	CLIApp.add_option("-j,--jobs", _ThreadCount, "Max number of threads, shared by tasks processed in parallel, default is hardware thread count");
 
 	// Path aliases (assigns)
 	CLIApp.add_option("--path", [this](CLI::results_t vals)
@@ -135,84 +141,26 @@ int CContentForgeTool::Execute(int argc, const char** argv)
 	if (_LogVerbosity >= EVerbosity::Debug)
 		std::cout << LineEnd;
 
-	// Run tasks in parallel
+	// Run tasks. Logs are flushed in task order as soon as possible, so the output is the same as in a serial run.
 
-	//???pass task count to SupportsMultithreading for perf tuning?
-	if (_Tasks.size() > 1 && SupportsMultithreading())
-	{
-		//!!!DBG TMP!
-		for (auto& Task : _Tasks)
-		{
-			if (_LogVerbosity >= EVerbosity::Info)
-			{
-				Task.Log.GetStream() << "Source: " << Task.SrcFilePath.generic_string() << Task.Log.GetLineEnd();
-				Task.Log.GetStream() << "Task: " << Task.TaskID.CStr() << Task.Log.GetLineEnd();
-				Task.Log.GetStream() << "Thread: " << std::this_thread::get_id() << Task.Log.GetLineEnd();
-			}
-
-			Task.Result = ProcessTask(Task);
-		}
-
-		typedef std::function<void(CContentForgeTask& Task)> FJob;
-		/*
-		const auto WorkerThreadCount = std::max(1u, std::thread::hardware_concurrency());
-
-		for (uint32_t i = 0; i < WorkerThreadCount; ++i)
-		{
-			std::thread Worker([]
-			{
-				FJob Job;
-
-				while (true)
-				{
-					//if (_Tasks.pop_front(job)) // try to grab a job from the jobPool queue
-					//{
-					//	// It found a job, execute it:
-					//	job(); // execute job
-					//	finishedLabel.fetch_add(1); // update worker label state
-					//}
-					//else
-					//{
-					//	// no job, put thread to sleep
-					//	std::unique_lock<std::mutex> lock(wakeMutex);
-					//	wakeCondition.wait(lock);
-					//}
-				}
-			});
-
-			Worker.detach(); // forget about this thread, let it do it's job in the infinite loop that we created above
-		}
-		*/
-
-		// TODO: wait all threads to finish
-	}
-	else
-	{
-		for (auto& Task : _Tasks)
-		{
-			if (_LogVerbosity >= EVerbosity::Info)
-			{
-				Task.Log.GetStream() << "Source: " << Task.SrcFilePath.generic_string() << Task.Log.GetLineEnd();
-				Task.Log.GetStream() << "Task: " << Task.TaskID.CStr() << Task.Log.GetLineEnd();
-				Task.Log.GetStream() << "Thread: " << std::this_thread::get_id() << Task.Log.GetLineEnd();
-			}
-
-			Task.Result = ProcessTask(Task);
-		}
-	}
-
-	// Flush cached logs to stdout, calculate statistics
+	const auto StartTime = std::chrono::steady_clock::now();
 
 	size_t TasksByResult[ETaskResult::COUNT] = {};
-
-	for (auto& Task : _Tasks)
+	size_t FinishedCount = 0;
+	double TotalTaskTime = 0.0;
+	const auto OnTaskFinished = [&](CContentForgeTask& Task)
 	{
 		++TasksByResult[Task.Result];
+		++FinishedCount;
+		TotalTaskTime += Task.Time;
 
 		const auto LoggedString = Task.Log.GetStream().str();
 		if (!LoggedString.empty())
 			std::cout << LoggedString;
 
+		// Free memory as early as possible, there may be a lot of tasks
+		Task.Log.GetStream().str(std::string{});
+
 		if (_LogVerbosity >= EVerbosity::Info)
 		{
 			std::cout << "Status: ";
@@ -224,15 +172,42 @@ int CContentForgeTool::Execute(int argc, const char** argv)
 				case ETaskResult::UpToDate: std::cout << "skipped as up to date"; break;
 				default: std::cout << "unknown"; break;
 			}
-			std::cout << LineEnd << LineEnd;
+			std::cout << " in " << Task.Time << " s [" << FinishedCount << '/' << _Tasks.size() << ']' << LineEnd << LineEnd;
+		}
+	};
+
+	//???pass task count to SupportsMultithreading for perf tuning?
+	uint32_t ThreadCount = 1;
+	if (_Tasks.size() > 1 && SupportsMultithreading())
+		ThreadCount = static_cast<uint32_t>(std::min<size_t>(GetMaxThreadCount(), _Tasks.size()));
+
+	if (ThreadCount > 1)
+	{
+		RunTasksInParallel(ThreadCount, OnTaskFinished);
+	}
+	else
+	{
+		// A single task may use all threads internally
+		_ThreadsPerTask = GetMaxThreadCount();
+
+		for (auto& Task : _Tasks)
+		{
+			RunTask(Task);
+			OnTaskFinished(Task);
 		}
-			
 	}
 
+	const std::chrono::duration<double> WallTime = std::chrono::steady_clock::now() - StartTime;
+
 	std::cout << _Name << ": successful: " << TasksByResult[ETaskResult::Success] <<
 		", failed: " << TasksByResult[ETaskResult::Failure] <<
 		", up to date: " << TasksByResult[ETaskResult::UpToDate] <<
-		LineEnd << LineEnd;
+		LineEnd;
+
+	if (_LogVerbosity >= EVerbosity::Info)
+		std::cout << "Time: " << WallTime.count() << " s, in tasks: " << TotalTaskTime << " s, threads: " << ThreadCount << LineEnd;
+
+	std::cout << LineEnd;
 
 	// Run custom termination code
 
@@ -247,6 +222,154 @@ int CContentForgeTool::Execute(int argc, const char** argv)
 }
 //---------------------------------------------------------------------
 
+void CContentForgeTool::RunTask(CContentForgeTask& Task)
+{
+	if (_LogVerbosity >= EVerbosity::Info)
+	{
+		Task.Log.GetStream() << "Source: " << Task.SrcFilePath.generic_string() << Task.Log.GetLineEnd();
+		Task.Log.GetStream() << "Task: " << Task.TaskID.CStr() << Task.Log.GetLineEnd();
+	}
+
+	// Thread ID is logged only in debug mode to keep the output of parallel runs deterministic
+	if (_LogVerbosity >= EVerbosity::Debug)
+		Task.Log.GetStream() << "Thread: " << std::this_thread::get_id() << Task.Log.GetLineEnd();
+
+	const auto StartTime = std::chrono::steady_clock::now();
+
+	try
+	{
+		Task.Result = ProcessTask(Task);
+	}
+	catch (const std::exception& e)
+	{
+		// An exception must not escape a worker thread, it would terminate the whole tool
+		Task.Log.LogError(std::string("Unhandled exception: ") + e.what());
+		Task.Result = ETaskResult::Failure;
+	}
+
+	const std::chrono::duration<double> Time = std::chrono::steady_clock::now() - StartTime;
+	Task.Time = Time.count();
+}
+//---------------------------------------------------------------------
+
+// Output files are compared by keys, paths are case-insensitive on the target platform
+std::string CContentForgeTool::GetOutputKey(const fs::path& Path)
+{
+	std::string Key = fs::absolute(Path).lexically_normal().generic_string();
+	ToLower(Key);
+	return Key;
+}
+//---------------------------------------------------------------------
+
+// Tasks that share any output key are merged into one group to be run sequentially in their original
+// order, e.g. two metafiles writing the same resulting file. Tasks without keys are groups of their own.
+std::vector<std::vector<size_t>> CContentForgeTool::GroupTasksByOutputs() const
+{
+	// Union-find over task indices, a root is always the smallest index in the set
+	std::vector<size_t> Parents(_Tasks.size());
+	for (size_t i = 0; i < Parents.size(); ++i)
+		Parents[i] = i;
+
+	const auto FindRoot = [&Parents](size_t Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+		return Index;
+	};
+
+	std::unordered_map<std::string, size_t> FirstTaskByKey;
+	for (size_t i = 0; i < _Tasks.size(); ++i)
+	{
+		for (const auto& Key : GetTaskOutputKeys(_Tasks[i]))
+		{
+			auto [It, IsNew] = FirstTaskByKey.emplace(Key, i);
+			if (IsNew) continue;
+
+			const auto RootA = FindRoot(It->second);
+			const auto RootB = FindRoot(i);
+			if (RootA != RootB) Parents[std::max(RootA, RootB)] = std::min(RootA, RootB);
+		}
+	}
+
+	std::vector<std::vector<size_t>> Groups;
+	std::vector<size_t> GroupByRoot(_Tasks.size(), _Tasks.size());
+	for (size_t i = 0; i < _Tasks.size(); ++i)
+	{
+		const auto Root = FindRoot(i);
+		if (GroupByRoot[Root] == _Tasks.size())
+		{
+			GroupByRoot[Root] = Groups.size();
+			Groups.emplace_back();
+		}
+		Groups[GroupByRoot[Root]].push_back(i);
+	}
+
+	return Groups;
+}
+//---------------------------------------------------------------------
+
+uint32_t CContentForgeTool::GetMaxThreadCount() const
+{
+	return _ThreadCount ? _ThreadCount : std::max(1u, std::thread::hardware_concurrency());
+}
+//---------------------------------------------------------------------
+
+// Processes task groups with a fixed number of worker threads, see GroupTasksByOutputs(). OnTaskFinished is called
+// from the calling thread for each task in the original order, as soon as the task and all tasks before it are finished.
+void CContentForgeTool::RunTasksInParallel(uint32_t ThreadCount, const std::function<void(CContentForgeTask&)>& OnTaskFinished)
+{
+	const auto Groups = GroupTasksByOutputs();
+	ThreadCount = static_cast<uint32_t>(std::min<size_t>(ThreadCount, Groups.size()));
+	_ThreadsPerTask = std::max(1u, GetMaxThreadCount() / ThreadCount);
+
+	std::atomic<size_t> NextGroupIndex = 0;
+	std::vector<bool> Finished(_Tasks.size(), false);
+	std::mutex FinishedMutex;
+	std::condition_variable FinishedCondition;
+
+	std::vector<std::thread> Workers;
+	Workers.reserve(ThreadCount);
+	for (uint32_t i = 0; i < ThreadCount; ++i)
+	{
+		Workers.emplace_back([&]()
+		{
+			while (true)
+			{
+				const size_t GroupIndex = NextGroupIndex.fetch_add(1);
+				if (GroupIndex >= Groups.size()) break;
+
+				for (const size_t Index : Groups[GroupIndex])
+				{
+					RunTask(_Tasks[Index]);
+
+					{
+						std::lock_guard Lock(FinishedMutex);
+						Finished[Index] = true;
+					}
+					FinishedCondition.notify_all();
+				}
+			}
+		});
+	}
+
+	for (size_t i = 0; i < _Tasks.size(); ++i)
+	{
+		{
+			std::unique_lock Lock(FinishedMutex);
+			FinishedCondition.wait(Lock, [&Finished, i]() { return Finished[i]; });
+		}
+
+		OnTaskFinished(_Tasks[i]);
+	}
+
+	for (auto& Worker : Workers)
+		Worker.join();
+}
+//---------------------------------------------------------------------
+
 void CContentForgeTool::ProcessMetafile(const std::filesystem::path& Path, std::unordered_set<std::string>& Processed)
 {
 	const auto LineEnd = std::cout.widen('\n');
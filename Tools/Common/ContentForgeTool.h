@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <unordered_set>
 #include <deque>
+#include <functional>
 
 // Base class for different console tools
 
@@ -36,6 +37,7 @@ struct CContentForgeTask
 	Data::CParams Params;
 	CThreadSafeLog Log;
 	ETaskResult Result = ETaskResult::NotStarted;
+	double Time = 0.0; // Processing time in seconds
 
 	CContentForgeTask(EVerbosity LogVerbosity) : Log("", LogVerbosity) {}
 };
@@ -55,9 +57,18 @@ protected:
 	std::deque<CContentForgeTask> _Tasks;
 
 	int _LogVerbosity;
+	uint32_t _ThreadCount = 0; // 0 means to use all hardware threads
+	uint32_t _ThreadsPerTask = 1; // Threads a task may use internally, so that parallel tasks stay within _ThreadCount in total
 	bool _WaitKey = false;
 
 	void ProcessMetafile(const std::filesystem::path& Path, std::unordered_set<std::string>& Processed);
+	void RunTask(CContentForgeTask& Task);
+	void RunTasksInParallel(uint32_t ThreadCount, const std::function<void(CContentForgeTask&)>& OnTaskFinished);
+	std::vector<std::vector<size_t>> GroupTasksByOutputs() const;
+
+	uint32_t GetMaxThreadCount() const;
+
+	static std::string GetOutputKey(const std::filesystem::path& Path);
 
 public:
 
@@ -66,6 +77,7 @@ public:
 	virtual int Init() { return 0; }
 	virtual int Term() { return 0; }
 	virtual bool SupportsMultithreading() const { return false; }
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const { return {}; }
 	virtual void ProcessCommandLine(CLI::App& CLIApp);
 	virtual ETaskResult ProcessTask(CContentForgeTask& Task) = 0;
 
@@ -1,17 +1,22 @@
 #define _HAS_EXCEPTIONS 0
 #include "StringID.h"
 #include "StringIDStorage.h"
+#include <mutex>
 
 namespace Data
 {
 CStringIDStorage CStringID::Storage;
+static std::mutex StorageMutex; // ContentForge tools may create IDs from parallel tasks
 
 const CStringID CStringID::Empty;
 
 CStringID::CStringID(const char* pStr, bool OnlyExisting)
 {
 	if (pStr && *pStr)
+	{
+		std::lock_guard Lock(StorageMutex);
 		pString = OnlyExisting ? Storage.Get(pStr) : Storage.GetOrAdd(pStr);
+	}
 	else pString = CStringID::Empty.CStr();
 }
 //---------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <vector>
 #include <filesystem>
+#include <cstring>
 
 #undef CopyFile
 #undef min
@@ -518,6 +519,19 @@ inline uint32_t Log2(uint32_t x)
 }
 //---------------------------------------------------------------------
 
+// Half precision float to float, only normalized numbers and zeroes are expected (e.g. in vertex data)
+inline float HalfToFloat(uint16_t Value)
+{
+	const uint32_t Sign = static_cast<uint32_t>(Value & 0x8000) << 16;
+	const uint32_t Exponent = (Value >> 10) & 0x1f;
+	const uint32_t Mantissa = Value & 0x3ff;
+	const uint32_t Bits = Exponent ? (Sign | ((Exponent + 112) << 23) | (Mantissa << 13)) : Sign;
+	float Result;
+	std::memcpy(&Result, &Bits, sizeof(float));
+	return Result;
+}
+//---------------------------------------------------------------------
+
 // Divide and round up
 template <typename T, typename U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_integral_v<U>>>
 inline decltype(auto) DivCeil(T Numerator, U Denominator)
@@ -573,6 +573,7 @@ public:
 		// Process attributes
 
 		Data::CDataArray Attributes;
+		Data::CParams Children;
 		bool IsBone = false;
 
 		for (int i = 0; i < pNode->GetNodeAttributeCount(); ++i)
@@ -583,7 +584,7 @@ public:
 			{
 				case FbxNodeAttribute::eMesh:
 				{
-					if (!ExportModel(static_cast<FbxMesh*>(pAttribute), Ctx, Attributes, GlobalTfm)) return false;
+					if (!ExportModel(static_cast<FbxMesh*>(pAttribute), Ctx, Attributes, Children, GlobalTfm)) return false;
 					break;
 				}
 				case FbxNodeAttribute::eLight:
@@ -639,8 +640,6 @@ public:
 
 		// Process children
 
-		Data::CParams Children;
-
 		for (int i = 0; i < pNode->GetChildCount(); ++i)
 		{
 			// Blender FBX exporter bug
@@ -666,7 +665,7 @@ public:
 		return true;
 	}
 
-	bool ExportModel(const FbxMesh* pMesh, CContext& Ctx, Data::CDataArray& Attributes, const rtm::qvvf& GlobalTfm)
+	bool ExportModel(const FbxMesh* pMesh, CContext& Ctx, Data::CDataArray& Attributes, Data::CParams& Children, const rtm::qvvf& GlobalTfm)
 	{
 		Ctx.Log.LogDebug(std::string("Model ") + pMesh->GetName());
 
@@ -684,6 +683,7 @@ public:
 
 		// Add models per mesh group
 
+		Data::CDataArray ModelAttributes;
 		int GroupIndex = 0;
 		for (const std::string& MaterialID : MeshInfo.MaterialIDs)
 		{
@@ -698,11 +698,13 @@ public:
 				ModelAttribute.emplace_back(CStrID("Material"), MaterialID);
 			else
 				Ctx.Log.LogWarning(std::string("Mesh ") + pMesh->GetName() + " has a group with no material attached");
-			Attributes.push_back(std::move(ModelAttribute));
+			ModelAttributes.push_back(std::move(ModelAttribute));
 
 			++GroupIndex;
 		}
 
+		AddModelLODs(ModelAttributes, MeshInfo.LODDistances, Attributes, Children);
+
 		// Assemble the skin attribute if required
 
 		auto SkinIt = Ctx.ProcessedSkins.find(pMesh);
@@ -757,6 +759,8 @@ public:
 		// Determine vertex format
 
 		CVertexFormat VertexFormat;
+		CMeshLODSettings LODSettings;
+		LoadMeshSettings(Ctx.TaskParams, VertexFormat, LODSettings);
 		VertexFormat.BlendWeightSize = 32;
 
 		VertexFormat.NormalCount = std::min(1, pMesh->GetElementNormalCount());
@@ -1121,7 +1125,11 @@ public:
 			}
 		}
 
-		// TODO: simplify, quantize and compress if required, see meshoptimizer readme, can simplify for lower LODs
+		// Skinned model finds its skin on its own node, so it can't be moved to LOD child nodes yet
+		if (VertexFormat.BonesPerVertex) LODSettings.LODCount = 1;
+
+		for (auto& [SubMeshID, SubMesh] : SubMeshes)
+			BuildMeshLODs(SubMesh, LODSettings);
 
 		// Write resulting mesh file
 
@@ -1171,6 +1179,8 @@ public:
 			MergeAABBs(MeshInfo.AABB, SubMesh.AABB);
 		}
 
+		MeshInfo.LODDistances = GetMeshLODDistances(MeshInfo.AABB, GetMeshLODCount(SubMeshes), LODSettings);
+
 		Ctx.ProcessedMeshes.emplace(pMesh, std::move(MeshInfo));
 
 		// Write resulting skin file (if skinned)
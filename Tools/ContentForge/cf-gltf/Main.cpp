@@ -373,6 +373,44 @@ protected:
 	bool                      _OutputBin = false;
 	bool                      _OutputHRD = false; // For debug purposes, saves scene hierarchies in a human-readable format
 
+	static bool LoadDocument(const fs::path& SrcFilePath, gltf::Document& OutDoc, std::unique_ptr<gltf::GLTFResourceReader>* pOutReader, CThreadSafeLog* pLog = nullptr)
+	{
+		auto StreamReader = std::make_unique<CStreamReader>(SrcFilePath.parent_path());
+
+		const auto SrcFileName = SrcFilePath.filename().u8string();
+		auto gltfStream = StreamReader->GetInputStream(SrcFileName);
+
+		std::string Manifest;
+		std::unique_ptr<gltf::GLTFResourceReader> ResourceReader;
+		try
+		{
+			if (SrcFilePath.extension() == ".gltf")
+			{
+				ResourceReader = std::make_unique<gltf::GLTFResourceReader>(std::move(StreamReader));
+
+				std::stringstream manifestStream;
+				manifestStream << gltfStream->rdbuf();
+				Manifest = manifestStream.str();
+			}
+			else
+			{
+				auto glbResourceReader = std::make_unique<gltf::GLBResourceReader>(std::move(StreamReader), std::move(gltfStream));
+				Manifest = glbResourceReader->GetJson();
+				ResourceReader = std::move(glbResourceReader);
+			}
+
+			OutDoc = gltf::Deserialize(Manifest, gltf::KHR::GetKHRExtensionDeserializer_DEM());
+		}
+		catch (const gltf::GLTFException& e)
+		{
+			if (pLog) pLog->LogError("Error deserializing glTF file " + SrcFileName + ":\n" + e.what());
+			return false;
+		}
+
+		if (pOutReader) *pOutReader = std::move(ResourceReader);
+		return true;
+	}
+
 public:
 
 	CGLTFTool(const std::string& Name, const std::string& Desc, CVersion Version)
@@ -393,9 +431,48 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// TODO: check DevIL (Init/TermImageProcessing)
-		// TODO: CStringID and multiple tasks writing to one output file
-		return false;
+		// DevIL calls are serialized inside SceneTools, shared outputs are handled by GetTaskOutputKeys
+		return true;
+	}
+
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const override
+	{
+		// Unnamed resources are prefixed with a task name and are covered by the scene key
+		std::vector<std::string> Keys{ GetOutputKey(GetOutputPath(Task.Params) / Task.TaskID.ToString()) };
+
+		// Named resources may be shared between source files, only the manifest is needed to find them
+		const auto Extension = Task.SrcFilePath.extension();
+		if (Extension != ".gltf" && Extension != ".glb") return Keys;
+
+		gltf::Document Doc;
+		if (!LoadDocument(Task.SrcFilePath, Doc, nullptr)) return Keys;
+
+		const auto MeshPath = GetOutputPath(Task.Params, "MeshOutput");
+		for (const auto& Mesh : Doc.meshes.Elements())
+			if (!Mesh.name.empty())
+				Keys.push_back(GetOutputKey(MeshPath / (GetValidResourceName(Mesh.name) + ".msh")));
+
+		const auto MaterialPath = GetOutputPath(Task.Params, "MaterialOutput");
+		for (const auto& Mtl : Doc.materials.Elements())
+			Keys.push_back(GetOutputKey(MaterialPath / (GetValidResourceName(Mtl.name) + ".mtl")));
+
+		// Texture extension depends on the conversion, the name is enough
+		const auto TexturePath = GetOutputPath(Task.Params, "TextureOutput");
+		for (const auto& Image : Doc.images.Elements())
+			if (!Image.uri.empty())
+				Keys.push_back(GetOutputKey(TexturePath / GetValidResourceName(fs::path(Image.uri).stem().string())));
+
+		const auto SkinPath = GetOutputPath(Task.Params, "SkinOutput");
+		for (const auto& Skin : Doc.skins.Elements())
+			if (!Skin.name.empty())
+				Keys.push_back(GetOutputKey(SkinPath / (GetValidResourceName(Skin.name) + ".skn")));
+
+		const auto AnimPath = GetOutputPath(Task.Params, "AnimOutput");
+		for (const auto& Anim : Doc.animations.Elements())
+			if (!Anim.name.empty())
+				Keys.push_back(GetOutputKey(AnimPath / (GetValidResourceName(Anim.name) + ".anm")));
+
+		return Keys;
 	}
 
 	virtual int Init() override
@@ -454,36 +531,7 @@ public:
 
 		Ctx.SrcFolder = Task.SrcFilePath.parent_path();
 
-		auto StreamReader = std::make_unique<CStreamReader>(Ctx.SrcFolder);
-
-		const auto SrcFileName = Task.SrcFilePath.filename().u8string();
-		auto gltfStream = StreamReader->GetInputStream(SrcFileName);
-
-		std::string Manifest;
-		if (IsGLTF)
-		{
-			Ctx.ResourceReader = std::make_unique<gltf::GLTFResourceReader>(std::move(StreamReader));
-
-			std::stringstream manifestStream;
-			manifestStream << gltfStream->rdbuf();
-			Manifest = manifestStream.str();
-		}
-		else
-		{
-			auto glbResourceReader = std::make_unique<gltf::GLBResourceReader>(std::move(StreamReader), std::move(gltfStream));
-			Manifest = glbResourceReader->GetJson();
-			Ctx.ResourceReader = std::move(glbResourceReader);
-		}
-
-		try
-		{
-			Ctx.Doc = gltf::Deserialize(Manifest, gltf::KHR::GetKHRExtensionDeserializer_DEM());
-		}
-		catch (const gltf::GLTFException& e)
-		{
-			Task.Log.LogError("Error deserializing glTF file " + SrcFileName + ":\n" + e.what());
-			return ETaskResult::Failure;
-		}
+		if (!LoadDocument(Task.SrcFilePath, Ctx.Doc, &Ctx.ResourceReader, &Task.Log)) return ETaskResult::Failure;
 
 		// Output file info
 
@@ -582,12 +630,13 @@ public:
 		// Process attributes
 
 		Data::CDataArray Attributes;
+		Data::CParams Children;
 
 		if (!Node.cameraId.empty())
 			if (!ExportCamera(Node.cameraId, Ctx, Attributes)) return false;
 
 		if (!Node.meshId.empty())
-			if (!ExportModel(Node.meshId, Ctx, Attributes, GlobalTfm)) return false;
+			if (!ExportModel(Node.meshId, Ctx, Attributes, Children, GlobalTfm)) return false;
 
 		if (!Node.skinId.empty())
 		{
@@ -625,8 +674,6 @@ public:
 
 		// Process children
 
-		Data::CParams Children;
-
 		for (const auto& Child : Node.children)
 			if (!ExportNode(Child, Ctx, Children, GlobalTfm)) return false;
 
@@ -641,7 +688,7 @@ public:
 		return true;
 	}
 
-	bool ExportModel(const std::string& MeshName, CContext& Ctx, Data::CDataArray& Attributes, const rtm::qvvf& GlobalTfm)
+	bool ExportModel(const std::string& MeshName, CContext& Ctx, Data::CDataArray& Attributes, Data::CParams& Children, const rtm::qvvf& GlobalTfm)
 	{
 		const auto& Mesh = Ctx.Doc.meshes[MeshName];
 
@@ -661,6 +708,7 @@ public:
 
 		// Add models per mesh group
 
+		Data::CDataArray ModelAttributes;
 		int GroupIndex = 0;
 		for (const auto& MaterialID : MeshInfo.MaterialIDs)
 		{
@@ -670,11 +718,13 @@ public:
 			if (GroupIndex > 0)
 				ModelAttribute.emplace_back(CStrID("MeshGroupIndex"), GroupIndex);
 			ModelAttribute.emplace_back(CStrID("Material"), MaterialID);
-			Attributes.push_back(std::move(ModelAttribute));
+			ModelAttributes.push_back(std::move(ModelAttribute));
 
 			++GroupIndex;
 		}
 
+		AddModelLODs(ModelAttributes, MeshInfo.LODDistances, Attributes, Children);
+
 		// Create collision shape if necessary
 
 		if (!Mesh.extras.empty())
@@ -710,6 +760,8 @@ public:
 		const auto& Mesh = Ctx.Doc.meshes[MeshName];
 
 		CVertexFormat VertexFormat;
+		CMeshLODSettings LODSettings;
+		LoadMeshSettings(Ctx.TaskParams, VertexFormat, LODSettings);
 		VertexFormat.BlendWeightSize = 16;
 		int BoneCount = 0;
 
@@ -941,6 +993,12 @@ public:
 			ProcessGeometry(RawVertices, RawIndices, SubMesh.Vertices, SubMesh.Indices);
 		}
 
+		// Skinned model finds its skin on its own node, so it can't be moved to LOD child nodes yet
+		if (VertexFormat.BonesPerVertex) LODSettings.LODCount = 1;
+
+		for (auto& [SubMeshID, SubMesh] : SubMeshes)
+			BuildMeshLODs(SubMesh, LODSettings);
+
 		// Write resulting mesh file
 
 		//???use node name when possible?
@@ -963,6 +1021,8 @@ public:
 			MergeAABBs(MeshInfo.AABB, SubMesh.AABB);
 		}
 
+		MeshInfo.LODDistances = GetMeshLODDistances(MeshInfo.AABB, GetMeshLODCount(SubMeshes), LODSettings);
+
 		Ctx.ProcessedMeshes.emplace(MeshName, std::move(MeshInfo));
 
 		return true;
@@ -65,12 +65,10 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: must handle duplicate targets (for example 2 metafiles writing the same resulting file, like depth_atest_ps)
-		// FIXME: CStrID
+		// FIXME: the shader DB uses one SQLite connection for all tasks. Shader, binary and input signature records
+		// are looked up and then inserted or updated by separate statements without a transaction, so parallel tasks
+		// compiling the same shader (e.g. depth_atest_ps from 2 metafiles) or reusing a free slot would race.
 		return false;
-
-		// DLL is guaranteed to be thread-safe, but we could add a check: sqlite3_threadsafe()
-		//return true;
 	}
 
 	virtual void ProcessCommandLine(CLI::App& CLIApp) override
@@ -47,9 +47,21 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: must handle duplicate targets (for example 2 metafiles writing the same resulting file, like depth_atest_ps)
-		// FIXME: CStrID
-		return false;
+		// DevIL calls are serialized inside SceneTools, images are referenced by ID and rebound on each call
+		return true;
+	}
+
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const override
+	{
+		// All outputs are named TaskName + cluster postfix, so the task name in each output folder identifies them
+		const std::string TaskName = GetValidResourceName(Task.TaskID.ToString());
+		return
+		{
+			GetOutputKey(GetOutputPath(Task.Params, "TextureOutput") / TaskName),
+			GetOutputKey(GetOutputPath(Task.Params, "MaterialOutput") / TaskName),
+			GetOutputKey(GetOutputPath(Task.Params, "CDLODOutput") / TaskName),
+			GetOutputKey(GetOutputPath(Task.Params) / TaskName)
+		};
 	}
 
 	virtual int Init() override
@@ -20,9 +20,12 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: must handle duplicate targets (for example 2 metafiles writing the same resulting file, like depth_atest_ps)
-		// FIXME: CStrID
-		return false;
+		return true;
+	}
+
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const override
+	{
+		return { GetOutputKey(GetOutputPath(Task.Params) / (Task.TaskID.ToString() + ".mtl")) };
 	}
 
 	virtual ETaskResult ProcessTask(CContentForgeTask& Task) override
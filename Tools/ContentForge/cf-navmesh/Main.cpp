@@ -7,8 +7,11 @@
 #include <DetourNavMesh.h>
 #include <DetourNavMeshQuery.h>
 #include <DetourNavMeshBuilder.h>
+#include <MurmurHash3.h>
 #include <rtm/qvvf.h>
 #include <set>
+#include <thread>
+#include <atomic>
 
 namespace fs = std::filesystem;
 
@@ -27,6 +30,47 @@ struct CRegion
 	std::set<unsigned int> offmeshIds;
 };
 
+constexpr unsigned char POLY_FLAGS_DEFAULT_ENABLED = 1;
+
+struct CAreaMark
+{
+	std::vector<float> verts;
+	float hmin;
+	float hmax;
+	unsigned char area;
+};
+
+struct COffmeshConnections
+{
+	std::vector<float> verts;
+	std::vector<float> rads;
+	std::vector<unsigned char> dirs;
+	std::vector<unsigned char> areas;
+	std::vector<unsigned short> flags;
+	std::vector<unsigned int> ids;
+};
+
+// Input shared by all tiles of the navmesh
+struct CNavMeshBuildParams
+{
+	rcConfig cfg;
+	float agentHeight;
+	float agentRadius;
+	float agentMaxClimb;
+	bool buildDetailMesh;
+	const std::vector<CAreaMark>* pAreaMarks = nullptr;
+	const COffmeshConnections* pOffmesh = nullptr;
+};
+
+struct CNavMeshTile
+{
+	int X;
+	int Z;
+	dtTileRef Ref = 0;
+	uint64_t InputHash[2] = {};
+	std::vector<unsigned char> Data; // Empty if the tile has no polys
+};
+
 class CFRCContext : public rcContext
 {
 public:
@@ -46,10 +90,461 @@ public:
 	}
 };
 
+// Builds Detour data for a single tile or for the whole solo navmesh. Produces no data for an empty tile.
+static bool BuildNavMeshData(rcContext& ctx, const CNavMeshBuildParams& Build, const rcConfig& cfg, const float* verts, int nverts,
+	const int* tris, int ntris, int tileX, int tileZ, std::vector<unsigned char>& OutData, CThreadSafeLog& Log)
+{
+	OutData.clear();
+
+	// Step 2. Rasterize input polygon soup.
+
+	auto rcHeightfieldDeleter = [](rcHeightfield* ptr) { rcFreeHeightField(ptr); };
+	std::unique_ptr<rcHeightfield, decltype(rcHeightfieldDeleter)> solid(rcAllocHeightfield(), rcHeightfieldDeleter);
+	if (!rcCreateHeightfield(&ctx, *solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+	{
+		Log.LogError("buildNavigation: Could not create solid heightfield.");
+		return false;
+	}
+
+	// TODO: can do per geometry object instead of collecting all geometry at once!
+	// TODO: there is also rcClearUnwalkableTriangles, was used with non-RC_NULL_AREA in old CIDE:
+	/* Area is associated with current geometry chunk
+	if (Area == RC_NULL_AREA)
+		rcMarkWalkableTriangles(&Ctx, Cfg.walkableSlopeAngle, pVerts, VertexCount, pTris, TriCount, pAreas);
+	else
+		rcClearUnwalkableTriangles(&Ctx, Cfg.walkableSlopeAngle, pVerts, VertexCount, pTris, TriCount, pAreas);
+	*/
+	if (ntris)
+	{
+		std::unique_ptr<unsigned char[]> triareas(new unsigned char[ntris]);
+		memset(triareas.get(), RC_NULL_AREA, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, triareas.get());
+		if (!rcRasterizeTriangles(&ctx, verts, nverts, tris, triareas.get(), ntris, *solid, cfg.walkableClimb))
+		{
+			Log.LogError("buildNavigation: Could not rasterize triangles.");
+			return false;
+		}
+	}
+
+	// Step 3. Filter walkables surfaces.
+
+	rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *solid);
+	rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid);
+	rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *solid);
+
+	// Step 4. Partition walkable surface to simple regions.
+
+	auto rcCompactHeightfieldDeleter = [](rcCompactHeightfield* ptr) { rcFreeCompactHeightfield(ptr); };
+	std::unique_ptr<rcCompactHeightfield, decltype(rcCompactHeightfieldDeleter)> chf(rcAllocCompactHeightfield(), rcCompactHeightfieldDeleter);
+	if (!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid, *chf))
+	{
+		Log.LogError("buildNavigation: Could not build compact data.");
+		return false;
+	}
+
+	solid.reset();
+
+	if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf))
+	{
+		Log.LogError("buildNavigation: Could not erode.");
+		return false;
+	}
+
+	for (const auto& Mark : *Build.pAreaMarks)
+		rcMarkConvexPolyArea(&ctx, Mark.verts.data(), static_cast<int>(Mark.verts.size() / 3), Mark.hmin, Mark.hmax, Mark.area, *chf);
+
+	if (!rcBuildDistanceField(&ctx, *chf))
+	{
+		Log.LogError("buildNavigation: Could not build distance field.");
+		return false;
+	}
+
+	if (!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+	{
+		Log.LogError("buildNavigation: Could not build watershed regions.");
+		return false;
+	}
+
+	// Step 5. Trace and simplify region contours.
+
+	auto rcContourSetDeleter = [](rcContourSet* ptr) { rcFreeContourSet(ptr); };
+	std::unique_ptr<rcContourSet, decltype(rcContourSetDeleter)> cset(rcAllocContourSet(), rcContourSetDeleter);
+	if (!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset))
+	{
+		Log.LogError("buildNavigation: Could not create contours.");
+		return false;
+	}
+
+	// Step 6. Build polygons mesh from contours.
+
+	auto rcPolyMeshDeleter = [](rcPolyMesh* ptr) { rcFreePolyMesh(ptr); };
+	std::unique_ptr<rcPolyMesh, decltype(rcPolyMeshDeleter)> pmesh(rcAllocPolyMesh(), rcPolyMeshDeleter);
+	if (!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *pmesh))
+	{
+		Log.LogError("buildNavigation: Could not triangulate contours.");
+		return false;
+	}
+
+	cset.reset();
+
+	// Empty tiles are skipped, but empty solo navmesh is reported as an error by the caller
+	if (!pmesh->npolys) return true;
+
+	// Step 7. Create detail mesh which allows to access approximate height on each polygon.
+
+	auto rcPolyMeshDetailDeleter = [](rcPolyMeshDetail* ptr) { rcFreePolyMeshDetail(ptr); };
+	std::unique_ptr<rcPolyMeshDetail, decltype(rcPolyMeshDetailDeleter)> dmesh(nullptr, rcPolyMeshDetailDeleter);
+	if (Build.buildDetailMesh)
+	{
+		dmesh.reset(rcAllocPolyMeshDetail());
+		if (!rcBuildPolyMeshDetail(&ctx, *pmesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh))
+		{
+			Log.LogError("buildNavigation: Could not build detail mesh.");
+			return false;
+		}
+	}
+
+	chf.reset();
+
+	// (Optional) Step 8. Create Detour data from Recast poly mesh.
+
+	// Update poly flags from areas.
+	for (int i = 0; i < pmesh->npolys; ++i)
+	{
+		//!!!DBG TMP! Zero flags pass no filter in detour, so fill with any default for now.
+		//if (pmesh->areas[i] == RC_WALKABLE_AREA)
+			pmesh->flags[i] = POLY_FLAGS_DEFAULT_ENABLED;
+
+		/*
+		if (pmesh->areas[i] == RC_WALKABLE_AREA)
+			pmesh->areas[i] = SAMPLE_POLYAREA_GROUND;
+
+		if (pmesh->areas[i] == SAMPLE_POLYAREA_GROUND ||
+			pmesh->areas[i] == SAMPLE_POLYAREA_GRASS ||
+			pmesh->areas[i] == SAMPLE_POLYAREA_ROAD)
+		{
+			pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK;
+		}
+		else if (pmesh->areas[i] == SAMPLE_POLYAREA_WATER)
+		{
+			pmesh->flags[i] = SAMPLE_POLYFLAGS_SWIM;
+		}
+		else if (pmesh->areas[i] == SAMPLE_POLYAREA_DOOR)
+		{
+			pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK | SAMPLE_POLYFLAGS_DOOR;
+		}
+		*/
+	}
+
+	const auto& Offmesh = *Build.pOffmesh;
+
+	dtNavMeshCreateParams params;
+	memset(&params, 0, sizeof(params));
+	params.verts = pmesh->verts;
+	params.vertCount = pmesh->nverts;
+	params.polys = pmesh->polys;
+	params.polyAreas = pmesh->areas;
+	params.polyFlags = pmesh->flags;
+	params.polyCount = pmesh->npolys;
+	params.nvp = pmesh->nvp;
+	if (dmesh)
+	{
+		params.detailMeshes = dmesh->meshes;
+		params.detailVerts = dmesh->verts;
+		params.detailVertsCount = dmesh->nverts;
+		params.detailTris = dmesh->tris;
+		params.detailTriCount = dmesh->ntris;
+	}
+	if (!Offmesh.rads.empty())
+	{
+		// NB: Detour stores in a tile only connections that start inside it
+		params.offMeshConVerts = Offmesh.verts.data();
+		params.offMeshConRad = Offmesh.rads.data();
+		params.offMeshConDir = Offmesh.dirs.data();
+		params.offMeshConAreas = Offmesh.areas.data();
+		params.offMeshConFlags = Offmesh.flags.data();
+		params.offMeshConUserID = Offmesh.ids.data();
+		params.offMeshConCount = Offmesh.rads.size();
+	}
+	params.walkableHeight = Build.agentHeight;
+	params.walkableRadius = Build.agentRadius;
+	params.walkableClimb = Build.agentMaxClimb;
+	params.tileX = tileX;
+	params.tileY = tileZ;
+	rcVcopy(params.bmin, pmesh->bmin);
+	rcVcopy(params.bmax, pmesh->bmax);
+	params.cs = cfg.cs;
+	params.ch = cfg.ch;
+	params.buildBvTree = true;
+
+	unsigned char* navData = nullptr;
+	int navDataSize = 0;
+	if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
+	{
+		Log.LogError("Could not build Detour navmesh.");
+		return false;
+	}
+
+	OutData.assign(navData, navData + navDataSize);
+	dtFree(navData);
+
+	return true;
+}
+//---------------------------------------------------------------------
+
+template<class T> static inline void AppendHashInput(std::vector<uint8_t>& Buffer, const T* pData, size_t Count)
+{
+	const auto* pBytes = reinterpret_cast<const uint8_t*>(pData);
+	Buffer.insert(Buffer.end(), pBytes, pBytes + Count * sizeof(T));
+}
+//---------------------------------------------------------------------
+
 class CNavmeshTool : public CContentForgeTool
 {
 protected:
 
+	std::string _TileCacheDir;
+
+	using CTileKey = std::pair<int, int>;
+
+	bool LoadTileCache(const fs::path& Path, std::map<CTileKey, CNavMeshTile>& OutTiles)
+	{
+		std::ifstream File(Path, std::ios_base::binary);
+		if (!File) return false;
+
+		if (ReadStream<uint32_t>(File) != 'NMTC' || ReadStream<uint32_t>(File) != 0x00010000) return false;
+
+		const auto Count = ReadStream<uint32_t>(File);
+		for (uint32_t i = 0; i < Count && File; ++i)
+		{
+			CNavMeshTile Tile;
+			ReadStream(File, Tile.X);
+			ReadStream(File, Tile.Z);
+			ReadStream(File, Tile.InputHash[0]);
+			ReadStream(File, Tile.InputHash[1]);
+			Tile.Data.resize(ReadStream<uint32_t>(File));
+			File.read(reinterpret_cast<char*>(Tile.Data.data()), Tile.Data.size());
+			OutTiles.emplace(CTileKey{ Tile.X, Tile.Z }, std::move(Tile));
+		}
+
+		return !!File;
+	}
+
+	bool SaveTileCache(const fs::path& Path, const std::vector<CNavMeshTile>& Tiles)
+	{
+		fs::create_directories(Path.parent_path());
+
+		std::ofstream File(Path, std::ios_base::binary | std::ios_base::trunc);
+		if (!File) return false;
+
+		WriteStream<uint32_t>(File, 'NMTC');
+		WriteStream<uint32_t>(File, 0x00010000);
+		WriteStream<uint32_t>(File, static_cast<uint32_t>(Tiles.size()));
+		for (const auto& Tile : Tiles)
+		{
+			WriteStream(File, Tile.X);
+			WriteStream(File, Tile.Z);
+			WriteStream(File, Tile.InputHash[0]);
+			WriteStream(File, Tile.InputHash[1]);
+			WriteStream<uint32_t>(File, static_cast<uint32_t>(Tile.Data.size()));
+			File.write(reinterpret_cast<const char*>(Tile.Data.data()), Tile.Data.size());
+		}
+
+		return !!File;
+	}
+
+	// Builds tiles in parallel. Each tile is built from triangles that overlap it including a border, so tiles are
+	// independent and their results don't depend on the build order. Tiles with unchanged input are taken from the cache.
+	bool BuildTiles(const CNavMeshBuildParams& Build, int tileSize, const std::vector<float>& verts, const std::vector<int>& tris,
+		const std::string& TaskName, dtNavMeshParams& OutParams, std::vector<CNavMeshTile>& OutTiles, CThreadSafeLog& Log)
+	{
+		const rcConfig& cfg = Build.cfg;
+
+		int gw = 0, gh = 0;
+		rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &gw, &gh);
+		const int tw = (gw + tileSize - 1) / tileSize;
+		const int th = (gh + tileSize - 1) / tileSize;
+		const float tcs = tileSize * cfg.cs;
+
+		// Max tiles and max polys affect how the tile IDs are calculated.
+		// There are 22 bits available for identifying a tile and a polygon.
+		const int tileBits = std::min(static_cast<int>(dtIlog2(dtNextPow2(tw * th))), 14);
+		if (tw * th > (1 << tileBits))
+		{
+			Log.LogError("Too many navmesh tiles (" + std::to_string(tw * th) + "), increase TileSize");
+			return false;
+		}
+		const int polyBits = 22 - tileBits;
+
+		memset(&OutParams, 0, sizeof(OutParams));
+		rcVcopy(OutParams.orig, cfg.bmin);
+		OutParams.tileWidth = tcs;
+		OutParams.tileHeight = tcs;
+		OutParams.maxTiles = 1 << tileBits;
+		OutParams.maxPolys = 1 << polyBits;
+
+		rcConfig TileCfg = cfg;
+		TileCfg.tileSize = tileSize;
+		TileCfg.borderSize = cfg.walkableRadius + 3; // Reserve enough padding
+		TileCfg.width = tileSize + TileCfg.borderSize * 2;
+		TileCfg.height = tileSize + TileCfg.borderSize * 2;
+		const float BorderWorld = TileCfg.borderSize * cfg.cs;
+
+		// Bin triangles into tiles by their XZ bounds
+		const int ntris = static_cast<int>(tris.size() / 3);
+		std::vector<std::vector<int>> TileTris(tw * th);
+		for (int i = 0; i < ntris; ++i)
+		{
+			const float* v0 = &verts[tris[i * 3] * 3];
+			const float* v1 = &verts[tris[i * 3 + 1] * 3];
+			const float* v2 = &verts[tris[i * 3 + 2] * 3];
+			const float MinX = std::min({ v0[0], v1[0], v2[0] }) - BorderWorld - cfg.bmin[0];
+			const float MaxX = std::max({ v0[0], v1[0], v2[0] }) + BorderWorld - cfg.bmin[0];
+			const float MinZ = std::min({ v0[2], v1[2], v2[2] }) - BorderWorld - cfg.bmin[2];
+			const float MaxZ = std::max({ v0[2], v1[2], v2[2] }) + BorderWorld - cfg.bmin[2];
+			const int x0 = std::max(0, static_cast<int>(std::floor(MinX / tcs)));
+			const int x1 = std::min(tw - 1, static_cast<int>(std::floor(MaxX / tcs)));
+			const int z0 = std::max(0, static_cast<int>(std::floor(MinZ / tcs)));
+			const int z1 = std::min(th - 1, static_cast<int>(std::floor(MaxZ / tcs)));
+			for (int z = z0; z <= z1; ++z)
+				for (int x = x0; x <= x1; ++x)
+				{
+					auto& Indices = TileTris[z * tw + x];
+					Indices.push_back(tris[i * 3]);
+					Indices.push_back(tris[i * 3 + 1]);
+					Indices.push_back(tris[i * 3 + 2]);
+				}
+		}
+
+		// Inputs shared by all tiles are hashed once and mixed into each tile hash
+		std::vector<uint8_t> HashInput;
+		for (const auto& Mark : *Build.pAreaMarks)
+		{
+			AppendHashInput(HashInput, Mark.verts.data(), Mark.verts.size());
+			AppendHashInput(HashInput, &Mark.hmin, 1);
+			AppendHashInput(HashInput, &Mark.hmax, 1);
+			AppendHashInput(HashInput, &Mark.area, 1);
+		}
+		const auto& Offmesh = *Build.pOffmesh;
+		AppendHashInput(HashInput, Offmesh.verts.data(), Offmesh.verts.size());
+		AppendHashInput(HashInput, Offmesh.rads.data(), Offmesh.rads.size());
+		AppendHashInput(HashInput, Offmesh.dirs.data(), Offmesh.dirs.size());
+		AppendHashInput(HashInput, Offmesh.areas.data(), Offmesh.areas.size());
+		AppendHashInput(HashInput, Offmesh.flags.data(), Offmesh.flags.size());
+		AppendHashInput(HashInput, Offmesh.ids.data(), Offmesh.ids.size());
+		AppendHashInput(HashInput, &Build.agentHeight, 1);
+		AppendHashInput(HashInput, &Build.agentRadius, 1);
+		AppendHashInput(HashInput, &Build.agentMaxClimb, 1);
+		AppendHashInput(HashInput, &Build.buildDetailMesh, 1);
+		AppendHashInput(HashInput, &TileCfg, 1);
+		uint64_t SharedHash[2];
+		MurmurHash3_x64_128(HashInput.data(), static_cast<int>(HashInput.size()), 0, SharedHash);
+
+		std::map<CTileKey, CNavMeshTile> CachedTiles;
+		fs::path CachePath;
+		if (!_TileCacheDir.empty())
+		{
+			CachePath = fs::path(_TileCacheDir) / (TaskName + ".nmtc");
+			LoadTileCache(CachePath, CachedTiles);
+		}
+
+		std::vector<CNavMeshTile> Tiles(tw * th);
+		std::vector<std::unique_ptr<CThreadSafeLog>> TileLogs(tw * th);
+		std::atomic<int> NextTile { 0 };
+		std::atomic<int> CachedCount { 0 };
+		std::atomic<bool> Failed { false };
+
+		const auto BuildTileJob = [&]()
+		{
+			std::vector<uint8_t> TileHashInput;
+			for (int TileIdx = NextTile++; TileIdx < tw * th && !Failed; TileIdx = NextTile++)
+			{
+				const int x = TileIdx % tw;
+				const int z = TileIdx / tw;
+
+				auto& Tile = Tiles[TileIdx];
+				Tile.X = x;
+				Tile.Z = z;
+
+				TileLogs[TileIdx].reset(new CThreadSafeLog("Tile " + std::to_string(x) + ", " + std::to_string(z) + ": ", Log.GetVerbosity()));
+				auto& TileLog = *TileLogs[TileIdx];
+
+				// Hash tile geometry. Tile bounds are defined by its coords, and the config is already in a shared hash.
+				const auto& Indices = TileTris[TileIdx];
+				TileHashInput.clear();
+				AppendHashInput(TileHashInput, SharedHash, 2);
+				AppendHashInput(TileHashInput, &x, 1);
+				AppendHashInput(TileHashInput, &z, 1);
+				for (const int Index : Indices)
+					AppendHashInput(TileHashInput, &verts[Index * 3], 3);
+				MurmurHash3_x64_128(TileHashInput.data(), static_cast<int>(TileHashInput.size()), 0, Tile.InputHash);
+
+				auto ItCached = CachedTiles.find({ x, z });
+				if (ItCached != CachedTiles.cend() &&
+					ItCached->second.InputHash[0] == Tile.InputHash[0] &&
+					ItCached->second.InputHash[1] == Tile.InputHash[1])
+				{
+					// Map nodes are accessed by a single thread each, so moving the data out is safe
+					Tile.Data = std::move(ItCached->second.Data);
+					++CachedCount;
+					continue;
+				}
+
+				if (Indices.empty()) continue;
+
+				rcConfig tcfg = TileCfg;
+				tcfg.bmin[0] = cfg.bmin[0] + x * tcs - BorderWorld;
+				tcfg.bmin[1] = cfg.bmin[1];
+				tcfg.bmin[2] = cfg.bmin[2] + z * tcs - BorderWorld;
+				tcfg.bmax[0] = cfg.bmin[0] + (x + 1) * tcs + BorderWorld;
+				tcfg.bmax[1] = cfg.bmax[1];
+				tcfg.bmax[2] = cfg.bmin[2] + (z + 1) * tcs + BorderWorld;
+
+				CFRCContext ctx(TileLog);
+				if (!BuildNavMeshData(ctx, Build, tcfg, verts.data(), static_cast<int>(verts.size() / 3), Indices.data(),
+					static_cast<int>(Indices.size() / 3), x, z, Tile.Data, TileLog))
+				{
+					Failed = true;
+				}
+			}
+		};
+
+		// Tasks may already run in parallel, use only this task's share of the -j thread budget
+		const size_t ThreadCount = std::min<size_t>(_ThreadsPerTask, tw * th);
+		std::vector<std::thread> Threads;
+		Threads.reserve(ThreadCount - 1);
+		for (size_t i = 1; i < ThreadCount; ++i)
+			Threads.emplace_back(BuildTileJob);
+		BuildTileJob();
+		for (auto& Thread : Threads)
+			Thread.join();
+
+		// Merge tile logs in a deterministic order
+		for (const auto& TileLog : TileLogs)
+			if (TileLog) Log.GetStream() << TileLog->GetStream().str();
+
+		if (Failed) return false;
+
+		if (!CachePath.empty() && !SaveTileCache(CachePath, Tiles))
+			Log.LogWarning("Could not write navmesh tile cache " + CachePath.generic_string());
+
+		OutTiles.clear();
+		for (auto& Tile : Tiles)
+			if (!Tile.Data.empty())
+				OutTiles.push_back(std::move(Tile));
+
+		Log.LogInfo("Navmesh tiles: " + std::to_string(tw) + "x" + std::to_string(th) + ", non-empty " + std::to_string(OutTiles.size()) +
+			", from cache " + std::to_string(CachedCount.load()));
+
+		if (OutTiles.empty())
+		{
+			Log.LogError("Could not build Detour navmesh, all tiles are empty.");
+			return false;
+		}
+
+		return true;
+	}
+
 public:
 
 	CNavmeshTool(const std::string& Name, const std::string& Desc, CVersion Version)
@@ -59,9 +554,18 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: must handle duplicate targets (for example 2 metafiles writing the same resulting file, like depth_atest_ps)
-		// FIXME: CStrID
-		return false;
+		// Recast contexts and tile buffers are per task. Tiled navmeshes additionally spread tiles over the task's share of threads.
+		return true;
+	}
+
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const override
+	{
+		const std::string TaskName = GetValidResourceName(Task.TaskID.ToString());
+
+		std::vector<std::string> Keys{ GetOutputKey(GetOutputPath(Task.Params) / (TaskName + ".nm")) };
+		if (!_TileCacheDir.empty())
+			Keys.push_back(GetOutputKey(fs::path(_TileCacheDir) / (TaskName + ".nmtc")));
+		return Keys;
 	}
 
 	virtual int Init() override
@@ -72,6 +576,7 @@ public:
 	virtual void ProcessCommandLine(CLI::App& CLIApp) override
 	{
 		CContentForgeTool::ProcessCommandLine(CLIApp);
+		CLIApp.add_option("--tile-cache", _TileCacheDir, "Directory for caching built tiles of tiled navmeshes between runs");
 	}
 
 	virtual ETaskResult ProcessTask(CContentForgeTask& Task) override
@@ -143,35 +648,35 @@ public:
 		float bmin[3] = {};
 		if (nverts) rcCalcBounds(verts.data(), nverts, bmin, bmax);
 
-		// NB: the code below is copied from RecastDemo (Sample_SoloMesh.cpp) with slight changes
+		// NB: the code below is based on RecastDemo (Sample_SoloMesh.cpp, Sample_TileMesh.cpp) with slight changes
 
 		// Step 1. Initialize build config.
 
-		CFRCContext ctx(Task.Log);
-
-		const float agentHeight = ParamsUtils::GetParam(Desc, "AgentHeight", 1.8f);
-		const float agentRadius = ParamsUtils::GetParam(Desc, "AgentRadius", 0.3f);
-		const float agentMaxClimb = ParamsUtils::GetParam(Desc, "AgentMaxClimb", 0.2f);
+		CNavMeshBuildParams Build;
+		Build.agentHeight = ParamsUtils::GetParam(Desc, "AgentHeight", 1.8f);
+		Build.agentRadius = ParamsUtils::GetParam(Desc, "AgentRadius", 0.3f);
+		Build.agentMaxClimb = ParamsUtils::GetParam(Desc, "AgentMaxClimb", 0.2f);
 		const float agentWalkableSlope = ParamsUtils::GetParam(Desc, "AgentWalkableSlope", 60.f);
 
-		const float cellSize = ParamsUtils::GetParam(Desc, "CellSize", agentRadius / 3.f);
+		const float cellSize = ParamsUtils::GetParam(Desc, "CellSize", Build.agentRadius / 3.f);
 		const float cellHeight = ParamsUtils::GetParam(Desc, "CellHeight", cellSize);
 		const float edgeMaxLen = ParamsUtils::GetParam(Desc, "EdgeMaxLength", 12.f);
 		const float edgeMaxError = ParamsUtils::GetParam(Desc, "EdgeMaxError", 1.3f);
 		const int regionMinSize = ParamsUtils::GetParam(Desc, "RegionMinSize", 8);
 		const int regionMergeSize = ParamsUtils::GetParam(Desc, "RegionMergeSize", 8);
-		const bool buildDetailMesh = ParamsUtils::GetParam(Desc, "BuildDetailMesh", true);
+		Build.buildDetailMesh = ParamsUtils::GetParam(Desc, "BuildDetailMesh", true);
 		const float detailSampleDist = ParamsUtils::GetParam(Desc, "DetailSampleDistance", 6.f);
 		const float detailSampleMaxError = ParamsUtils::GetParam(Desc, "DetailSampleMaxError", 1.f);
+		const int tileSize = ParamsUtils::GetParam(Desc, "TileSize", 0); // In cells, 0 builds a single tile navmesh
 
-		rcConfig cfg;
+		rcConfig& cfg = Build.cfg;
 		memset(&cfg, 0, sizeof(cfg));
 		cfg.cs = cellSize;
 		cfg.ch = cellHeight;
 		cfg.walkableSlopeAngle = agentWalkableSlope;
-		cfg.walkableHeight = (int)ceilf(agentHeight / cfg.ch);
-		cfg.walkableClimb = (int)floorf(agentMaxClimb / cfg.ch);
-		cfg.walkableRadius = (int)ceilf(agentRadius / cfg.cs);
+		cfg.walkableHeight = (int)ceilf(Build.agentHeight / cfg.ch);
+		cfg.walkableClimb = (int)floorf(Build.agentMaxClimb / cfg.ch);
+		cfg.walkableRadius = (int)ceilf(Build.agentRadius / cfg.cs);
 		cfg.maxEdgeLen = (int)(edgeMaxLen / cfg.cs);
 		cfg.maxSimplificationError = edgeMaxError;
 		cfg.minRegionArea = rcSqr(regionMinSize); // Note: area = size*size
@@ -184,74 +689,19 @@ public:
 		rcVcopy(cfg.bmax, bmax);
 		rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
-		// Step 2. Rasterize input polygon soup.
-
-		auto rcHeightfieldDeleter = [](rcHeightfield* ptr) { rcFreeHeightField(ptr); };
-		std::unique_ptr<rcHeightfield, decltype(rcHeightfieldDeleter)> solid(rcAllocHeightfield(), rcHeightfieldDeleter);
-		if (!rcCreateHeightfield(&ctx, *solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
-		{
-			Task.Log.LogError("buildNavigation: Could not create solid heightfield.");
-			return ETaskResult::Failure;
-		}
-
-		// TODO: can do per geometry object instead of collecting all geometry at once!
-		// TODO: there is also rcClearUnwalkableTriangles, was used with non-RC_NULL_AREA in old CIDE:
-		/* Area is associated with current geometry chunk
-		if (Area == RC_NULL_AREA)
-			rcMarkWalkableTriangles(&Ctx, Cfg.walkableSlopeAngle, pVerts, VertexCount, pTris, TriCount, pAreas);
-		else
-			rcClearUnwalkableTriangles(&Ctx, Cfg.walkableSlopeAngle, pVerts, VertexCount, pTris, TriCount, pAreas);
-		*/
-		std::unique_ptr<unsigned char[]> triareas(new unsigned char[ntris]);
-		memset(triareas.get(), RC_NULL_AREA, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts.data(), nverts, tris.data(), ntris, triareas.get());
-		if (!rcRasterizeTriangles(&ctx, verts.data(), nverts, tris.data(), triareas.get(), ntris, *solid, cfg.walkableClimb))
-		{
-			Task.Log.LogError("buildNavigation: Could not rasterize triangles.");
-			return ETaskResult::Failure;
-		}
-
-		verts.clear();
-		verts.shrink_to_fit();
-		tris.clear();
-		tris.shrink_to_fit();
-		triareas.reset();
-
-		// Step 3. Filter walkables surfaces.
-
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *solid);
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid);
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *solid);
-
-		// Step 4. Partition walkable surface to simple regions.
-
-		auto rcCompactHeightfieldDeleter = [](rcCompactHeightfield* ptr) { rcFreeCompactHeightfield(ptr); };
-		std::unique_ptr<rcCompactHeightfield, decltype(rcCompactHeightfieldDeleter)> chf(rcAllocCompactHeightfield(), rcCompactHeightfieldDeleter);
-		if (!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid, *chf))
-		{
-			Task.Log.LogError("buildNavigation: Could not build compact data.");
-			return ETaskResult::Failure;
-		}
-
-		solid.reset();
-
-		if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf))
-		{
-			Task.Log.LogError("buildNavigation: Could not erode.");
-			return ETaskResult::Failure;
-		}
+		// Read regions. Regions with an area type are marked on the navmesh, named ones are remembered for runtime access.
 
+		std::vector<CAreaMark> AreaMarks;
 		std::map<std::string, CRegion> NamedRegions;
 
 		const Data::CDataArray* pRegionList;
 		if (ParamsUtils::TryGetParam(pRegionList, Desc, "Regions") && !pRegionList->empty())
 		{
-			std::vector<float> vertsR;
 			for (const auto& Record : *pRegionList)
 			{
 				const auto& RegionDesc = Record.GetValue<Data::CParams>();
 
-				vertsR.clear();
+				std::vector<float> vertsR;
 
 				const auto hmin = ParamsUtils::GetParam(RegionDesc, "HeightStart", bmin[1]);
 				const auto hmax = ParamsUtils::GetParam(RegionDesc, "HeightEnd", bmax[1]);
@@ -272,14 +722,14 @@ public:
 					// NB: there are also rcMarkBoxArea, rcMarkCylinderArea
 					int areaId = RC_WALKABLE_AREA;
 					if (ParamsUtils::TryGetParam<int>(areaId, RegionDesc, "AreaType"))
-						rcMarkConvexPolyArea(&ctx, vertsR.data(), pVertexList->size(), hmin, hmax, static_cast<uint8_t>(areaId), *chf);
+						AreaMarks.push_back({ vertsR, hmin, hmax, static_cast<unsigned char>(areaId) });
 				}
 
 				// If ID is defined, remember this region as named for runtime access
 				auto ID = ParamsUtils::GetParam(RegionDesc, "ID", std::string{});
 				if (!ID.empty())
 				{
-					CRegion NewRegion{ vertsR, hmin, hmax };
+					CRegion NewRegion{ std::move(vertsR), hmin, hmax };
 
 					const Data::CDataArray* pOffmeshCons;
 					if (ParamsUtils::TryGetParam(pOffmeshCons, RegionDesc, "OffmeshIds") && !pOffmeshCons->empty())
@@ -293,192 +743,119 @@ public:
 			}
 		}
 
-		if (!rcBuildDistanceField(&ctx, *chf))
-		{
-			Task.Log.LogError("buildNavigation: Could not build distance field.");
-			return ETaskResult::Failure;
-		}
-
-		if (!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea))
-		{
-			Task.Log.LogError("buildNavigation: Could not build watershed regions.");
-			return ETaskResult::Failure;
-		}
-
-		// Step 5. Trace and simplify region contours.
-
-		auto rcContourSetDeleter = [](rcContourSet* ptr) { rcFreeContourSet(ptr); };
-		std::unique_ptr<rcContourSet, decltype(rcContourSetDeleter)> cset(rcAllocContourSet(), rcContourSetDeleter);
-		if (!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset))
-		{
-			Task.Log.LogError("buildNavigation: Could not create contours.");
-			return ETaskResult::Failure;
-		}
+		// Read offmesh connections
 
-		// Step 6. Build polygons mesh from contours.
+		COffmeshConnections Offmesh;
 
-		auto rcPolyMeshDeleter = [](rcPolyMesh* ptr) { rcFreePolyMesh(ptr); };
-		std::unique_ptr<rcPolyMesh, decltype(rcPolyMeshDeleter)> pmesh(rcAllocPolyMesh(), rcPolyMeshDeleter);
-		if (!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *pmesh))
+		const Data::CDataArray* pOffmeshList;
+		if (ParamsUtils::TryGetParam(pOffmeshList, Desc, "OffmeshConnections") && !pOffmeshList->empty())
 		{
-			Task.Log.LogError("buildNavigation: Could not triangulate contours.");
-			return ETaskResult::Failure;
-		}
+			Offmesh.verts.reserve(pOffmeshList->size() * 3 * 2);
+			Offmesh.rads.reserve(pOffmeshList->size());
+			Offmesh.dirs.reserve(pOffmeshList->size());
+			Offmesh.areas.reserve(pOffmeshList->size());
+			Offmesh.flags.reserve(pOffmeshList->size());
+			Offmesh.ids.reserve(pOffmeshList->size());
 
-		cset.reset();
+			for (const auto& Record : *pOffmeshList)
+			{
+				const auto& OffmeshDesc = Record.GetValue<Data::CParams>();
+				const auto Start = ParamsUtils::GetParam(OffmeshDesc, "Start", float3{});
+				const auto End = ParamsUtils::GetParam(OffmeshDesc, "End", float3{});
 
-		// Step 7. Create detail mesh which allows to access approximate height on each polygon.
+				Offmesh.verts.push_back(Start.x);
+				Offmesh.verts.push_back(Start.y);
+				Offmesh.verts.push_back(Start.z);
+				Offmesh.verts.push_back(End.x);
+				Offmesh.verts.push_back(End.y);
+				Offmesh.verts.push_back(End.z);
+				Offmesh.rads.push_back(ParamsUtils::GetParam(OffmeshDesc, "Radius", Build.agentRadius));
+				Offmesh.dirs.push_back(ParamsUtils::GetParam(OffmeshDesc, "Bidirectional", true) ? 1 : 0);
+				Offmesh.areas.push_back(ParamsUtils::GetParam<int>(OffmeshDesc, "AreaType", RC_WALKABLE_AREA));
+				Offmesh.ids.push_back(ParamsUtils::GetParam(OffmeshDesc, "UserID", 0));
 
-		auto rcPolyMeshDetailDeleter = [](rcPolyMeshDetail* ptr) { rcFreePolyMeshDetail(ptr); };
-		std::unique_ptr<rcPolyMeshDetail, decltype(rcPolyMeshDetailDeleter)> dmesh(nullptr, rcPolyMeshDetailDeleter);
-		if (buildDetailMesh)
-		{
-			dmesh.reset(rcAllocPolyMeshDetail());
-			if (!rcBuildPolyMeshDetail(&ctx, *pmesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh))
-			{
-				Task.Log.LogError("buildNavigation: Could not build detail mesh.");
-				return ETaskResult::Failure;
+				//???or calc based on area, or combine calc and explicit?
+				Offmesh.flags.push_back(ParamsUtils::GetParam<int>(OffmeshDesc, "Flags", POLY_FLAGS_DEFAULT_ENABLED));
 			}
 		}
 
-		chf.reset();
+		Build.pAreaMarks = &AreaMarks;
+		Build.pOffmesh = &Offmesh;
+
+		// Build Detour navmesh data
 
-		// (Optional) Step 8. Create Detour data from Recast poly mesh.
+		auto dtNavMeshDeleter = [](dtNavMesh* ptr) { dtFreeNavMesh(ptr); };
+		std::unique_ptr<dtNavMesh, decltype(dtNavMeshDeleter)> NavMesh(nullptr, dtNavMeshDeleter);
 
-		constexpr unsigned char POLY_FLAGS_DEFAULT_ENABLED = 1;
+		std::vector<unsigned char> SoloData;
+		std::vector<CNavMeshTile> Tiles;
+		dtNavMeshParams TiledParams;
 
-		// Update poly flags from areas.
-		for (int i = 0; i < pmesh->npolys; ++i)
+		if (tileSize > 0)
 		{
-			//!!!DBG TMP! Zero flags pass no filter in detour, so fill with any default for now.
-			//if (pmesh->areas[i] == RC_WALKABLE_AREA)
-				pmesh->flags[i] = POLY_FLAGS_DEFAULT_ENABLED;
+			if (!BuildTiles(Build, tileSize, verts, tris, TaskName, TiledParams, Tiles, Task.Log))
+				return ETaskResult::Failure;
 
-			/*
-			if (pmesh->areas[i] == RC_WALKABLE_AREA)
-				pmesh->areas[i] = SAMPLE_POLYAREA_GROUND;
+			verts.clear();
+			verts.shrink_to_fit();
+			tris.clear();
+			tris.shrink_to_fit();
 
-			if (pmesh->areas[i] == SAMPLE_POLYAREA_GROUND ||
-				pmesh->areas[i] == SAMPLE_POLYAREA_GRASS ||
-				pmesh->areas[i] == SAMPLE_POLYAREA_ROAD)
-			{
-				pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK;
-			}
-			else if (pmesh->areas[i] == SAMPLE_POLYAREA_WATER)
+			// Assign tile refs. They are saved and restored by the loader, so that named region poly refs
+			// remain valid regardless of the order in which tiles are added at runtime.
+			NavMesh.reset(dtAllocNavMesh());
+			if (dtStatusFailed(NavMesh->init(&TiledParams)))
 			{
-				pmesh->flags[i] = SAMPLE_POLYFLAGS_SWIM;
+				Task.Log.LogError("Could not initialize tiled Detour navmesh");
+				return ETaskResult::Failure;
 			}
-			else if (pmesh->areas[i] == SAMPLE_POLYAREA_DOOR)
+
+			// Zero flags mean that NavMesh doesn't own tile data
+			for (auto& Tile : Tiles)
 			{
-				pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK | SAMPLE_POLYFLAGS_DOOR;
+				if (dtStatusFailed(NavMesh->addTile(Tile.Data.data(), static_cast<int>(Tile.Data.size()), 0, 0, &Tile.Ref)))
+				{
+					Task.Log.LogError("Could not add a tile " + std::to_string(Tile.X) + ", " + std::to_string(Tile.Z) + " to the navmesh");
+					return ETaskResult::Failure;
+				}
 			}
-			*/
 		}
-
-		// Read offmesh connections
-
-		std::vector<float> offMeshConVerts;
-		std::vector<float> offMeshConRads;
-		std::vector<unsigned char> offMeshConDirs;
-		std::vector<unsigned char> offMeshConAreas;
-		std::vector<unsigned short> offMeshConFlags;
-		std::vector<unsigned int> offMeshConId;
-
-		const Data::CDataArray* pOffmeshList;
-		if (ParamsUtils::TryGetParam(pOffmeshList, Desc, "OffmeshConnections") && !pOffmeshList->empty())
+		else
 		{
-			offMeshConVerts.reserve(pOffmeshList->size() * 3 * 2);
-			offMeshConRads.reserve(pOffmeshList->size());
-			offMeshConDirs.reserve(pOffmeshList->size());
-			offMeshConAreas.reserve(pOffmeshList->size());
-			offMeshConFlags.reserve(pOffmeshList->size());
-			offMeshConId.reserve(pOffmeshList->size());
+			CFRCContext ctx(Task.Log);
+			if (!BuildNavMeshData(ctx, Build, cfg, verts.data(), nverts, tris.data(), ntris, 0, 0, SoloData, Task.Log))
+				return ETaskResult::Failure;
 
-			for (const auto& Record : *pOffmeshList)
+			verts.clear();
+			verts.shrink_to_fit();
+			tris.clear();
+			tris.shrink_to_fit();
+
+			if (SoloData.empty())
 			{
-				const auto& OffmeshDesc = Record.GetValue<Data::CParams>();
-				const auto Start = ParamsUtils::GetParam(OffmeshDesc, "Start", float3{});
-				const auto End = ParamsUtils::GetParam(OffmeshDesc, "End", float3{});
+				Task.Log.LogError("Could not build Detour navmesh.");
+				return ETaskResult::Failure;
+			}
 
-				offMeshConVerts.push_back(Start.x);
-				offMeshConVerts.push_back(Start.y);
-				offMeshConVerts.push_back(Start.z);
-				offMeshConVerts.push_back(End.x);
-				offMeshConVerts.push_back(End.y);
-				offMeshConVerts.push_back(End.z);
-				offMeshConRads.push_back(ParamsUtils::GetParam(OffmeshDesc, "Radius", agentRadius));
-				offMeshConDirs.push_back(ParamsUtils::GetParam(OffmeshDesc, "Bidirectional", true) ? 1 : 0);
-				offMeshConAreas.push_back(ParamsUtils::GetParam<int>(OffmeshDesc, "AreaType", RC_WALKABLE_AREA));
-				offMeshConId.push_back(ParamsUtils::GetParam(OffmeshDesc, "UserID", 0));
+			if (!NamedRegions.empty())
+			{
+				NavMesh.reset(dtAllocNavMesh());
 
-				//???or calc based on area, or combine calc and explicit?
-				offMeshConFlags.push_back(ParamsUtils::GetParam<int>(OffmeshDesc, "Flags", POLY_FLAGS_DEFAULT_ENABLED));
+				// Zero flags mean that NavMesh doesn't own navData
+				if (dtStatusFailed(NavMesh->init(SoloData.data(), static_cast<int>(SoloData.size()), 0)))
+				{
+					Task.Log.LogError("Could not load Detour navmesh for named region processing");
+					return ETaskResult::Failure;
+				}
 			}
 		}
 
-		dtNavMeshCreateParams params;
-		memset(&params, 0, sizeof(params));
-		params.verts = pmesh->verts;
-		params.vertCount = pmesh->nverts;
-		params.polys = pmesh->polys;
-		params.polyAreas = pmesh->areas;
-		params.polyFlags = pmesh->flags;
-		params.polyCount = pmesh->npolys;
-		params.nvp = pmesh->nvp;
-		if (dmesh)
-		{
-			params.detailMeshes = dmesh->meshes;
-			params.detailVerts = dmesh->verts;
-			params.detailVertsCount = dmesh->nverts;
-			params.detailTris = dmesh->tris;
-			params.detailTriCount = dmesh->ntris;
-		}
-		if (!offMeshConRads.empty())
-		{
-			params.offMeshConVerts = offMeshConVerts.data();
-			params.offMeshConRad = offMeshConRads.data();
-			params.offMeshConDir = offMeshConDirs.data();
-			params.offMeshConAreas = offMeshConAreas.data();
-			params.offMeshConFlags = offMeshConFlags.data();
-			params.offMeshConUserID = offMeshConId.data();
-			params.offMeshConCount = offMeshConRads.size();
-		}
-		params.walkableHeight = agentHeight;
-		params.walkableRadius = agentRadius;
-		params.walkableClimb = agentMaxClimb;
-		rcVcopy(params.bmin, pmesh->bmin);
-		rcVcopy(params.bmax, pmesh->bmax);
-		params.cs = cfg.cs;
-		params.ch = cfg.ch;
-		params.buildBvTree = true;
-
-		unsigned char* navData = nullptr;
-		int navDataSize = 0;
-		if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
-		{
-			Task.Log.LogError("Could not build Detour navmesh.");
-			return ETaskResult::Failure;
-		}
-
-		pmesh.reset();
-		dmesh.reset();
-
 		// Process named regions
 
 		std::vector<std::pair<std::string, std::vector<dtPolyRef>>> NamedRegionPolys;
 
 		if (!NamedRegions.empty())
 		{
-			auto dtNavMeshDeleter = [](dtNavMesh* ptr) { dtFreeNavMesh(ptr); };
-			std::unique_ptr<dtNavMesh, decltype(dtNavMeshDeleter)> NavMesh(dtAllocNavMesh(), dtNavMeshDeleter);
-
-			// Zero flags mean that NavMesh doesn't own navData
-			if (dtStatusFailed(NavMesh->init(navData, navDataSize, 0)))
-			{
-				Task.Log.LogError("Could not load Detour navmesh for named region processing");
-				return ETaskResult::Failure;
-			}
-
 			dtNavMeshQuery Query;
 			if (dtStatusFailed(Query.init(NavMesh.get(), 512)))
 			{
@@ -486,8 +863,6 @@ public:
 				return ETaskResult::Failure;
 			}
 
-			const dtQueryFilter NavFilter;
-
 			NamedRegionPolys.reserve(NamedRegions.size());
 
 			for (auto& [ID, Region] : NamedRegions)
@@ -504,6 +879,8 @@ public:
 			}
 		}
 
+		NavMesh.reset();
+
 		// Write resulting NM file
 		{
 			auto DestPath = GetOutputPath(Task.Params) / (TaskName + ".nm");
@@ -517,13 +894,33 @@ public:
 			}
 
 			WriteStream<uint32_t>(File, 'NAVM');     // Format magic value
-			WriteStream<uint32_t>(File, 0x00010000); // Version 0.1.0.0
-			WriteStream(File, agentRadius);
-			WriteStream(File, agentHeight);
+			WriteStream<uint32_t>(File, Tiles.empty() ? 0x00010000 : 0x00020000); // Version 0.1.0.0 for solo, 0.2.0.0 for tiled
+			WriteStream(File, Build.agentRadius);
+			WriteStream(File, Build.agentHeight);
 			//???save other agent params too?
 
-			WriteStream<uint32_t>(File, navDataSize);
-			File.write(reinterpret_cast<const char*>(navData), navDataSize);
+			if (Tiles.empty())
+			{
+				WriteStream<uint32_t>(File, static_cast<uint32_t>(SoloData.size()));
+				File.write(reinterpret_cast<const char*>(SoloData.data()), SoloData.size());
+			}
+			else
+			{
+				WriteStream(File, TiledParams.orig[0]);
+				WriteStream(File, TiledParams.orig[1]);
+				WriteStream(File, TiledParams.orig[2]);
+				WriteStream(File, TiledParams.tileWidth);
+				WriteStream(File, TiledParams.tileHeight);
+				WriteStream<uint32_t>(File, TiledParams.maxTiles);
+				WriteStream<uint32_t>(File, TiledParams.maxPolys);
+				WriteStream<uint32_t>(File, static_cast<uint32_t>(Tiles.size()));
+				for (const auto& Tile : Tiles)
+				{
+					WriteStream(File, Tile.Ref);
+					WriteStream<uint32_t>(File, static_cast<uint32_t>(Tile.Data.size()));
+					File.write(reinterpret_cast<const char*>(Tile.Data.data()), Tile.Data.size());
+				}
+			}
 
 			WriteStream(File, static_cast<uint32_t>(NamedRegionPolys.size()));
 			for (const auto& [ID, Polys] : NamedRegionPolys)
@@ -534,8 +931,6 @@ public:
 			}
 		}
 
-		dtFree(navData);
-
 		return ETaskResult::Success;
 	}
 
@@ -563,9 +958,6 @@ public:
 #pragma pack(push, 1)
 		struct CMSHMeshHeader
 		{
-			uint32_t Magic;
-			uint32_t Version;
-			uint32_t GroupCount;
 			uint32_t VertexCount;
 			uint32_t IndexCount;
 			uint8_t  IndexSize;
@@ -590,15 +982,21 @@ public:
 		};
 #pragma pack(pop)
 
-		CMSHMeshHeader Header;
-		ReadStream(File, Header);
-
-		if (Header.Magic != 'MESH' || Header.Version != 0x00010000)
+		const auto Magic = ReadStream<uint32_t>(File);
+		const auto Version = ReadStream<uint32_t>(File);
+		if (Magic != 'MESH' || (Version != 0x00010000 && Version != 0x00020000))
 		{
 			Log.LogError("Incorrect format or version: " + Path.generic_string());
 			return false;
 		}
 
+		// Since 0.2.0.0 groups are stored for each LOD, the navmesh is always built from LOD 0 which goes first
+		const auto GroupCount = ReadStream<uint32_t>(File);
+		const auto LODCount = (Version >= 0x00020000) ? ReadStream<uint32_t>(File) : 1;
+
+		CMSHMeshHeader Header;
+		ReadStream(File, Header);
+
 		if (!Header.VertexCount)
 		{
 			Log.LogWarning("Empty mesh: " + Path.generic_string());
@@ -606,7 +1004,7 @@ public:
 		}
 
 		const auto MeshGroupIndex = static_cast<uint32_t>(ParamsUtils::GetParam(Desc, "MeshGroupIndex", 0));
-		if (MeshGroupIndex >= Header.GroupCount)
+		if (MeshGroupIndex >= GroupCount)
 		{
 			Log.LogError("No group " + std::to_string(MeshGroupIndex) + " in a mesh: " + Path.generic_string());
 			return false;
@@ -615,19 +1013,30 @@ public:
 		// Based on a vertex format, calculate offset and stride of the position
 		size_t PositionOffset = 0;
 		size_t VertexStride = 0;
+		auto PositionFormat = VCFmt_Invalid;
 		for (uint32_t i = 0; i < Header.VertexComponentCount; ++i)
 		{
 			CMSHVertexComponent Component;
 			ReadStream(File, Component);
 
-			if (Component.SemanticCode == VCSem_Position) PositionOffset = VertexStride;
+			if (Component.SemanticCode == VCSem_Position)
+			{
+				PositionOffset = VertexStride;
+				PositionFormat = static_cast<EVertexComponentFormat>(Component.FormatCode);
+			}
 
 			VertexStride += GetVertexComponentSize(static_cast<EVertexComponentFormat>(Component.FormatCode));
 		}
 
+		if (PositionFormat != VCFmt_Float32_3 && PositionFormat != VCFmt_Float16_4)
+		{
+			Log.LogError("Unsupported vertex position format in a mesh: " + Path.generic_string());
+			return false;
+		}
+
 		CMSHMeshGroup Group;
 		size_t TriCount = 0;
-		for (uint32_t i = 0; i < Header.GroupCount; ++i)
+		for (uint32_t i = 0; i < GroupCount * LODCount; ++i)
 		{
 			if (i == MeshGroupIndex)
 			{
@@ -652,6 +1061,10 @@ public:
 			}
 		}
 
+		// Skip shadow group index ranges
+		if (Version >= 0x00020000 && ReadStream<uint8_t>(File))
+			File.seekg(GroupCount * LODCount * 2 * sizeof(uint32_t), std::ios_base::cur);
+
 		uint32_t VertexStartPos, IndexStartPos;
 		ReadStream(File, VertexStartPos);
 		ReadStream(File, IndexStartPos);
@@ -669,8 +1082,19 @@ public:
 			const char* pSrc = Vertices.data() + PositionOffset;
 			for (uint32_t i = 0; i < Group.VertexCount; ++i)
 			{
-				auto pPos = reinterpret_cast<const float*>(pSrc);
-				const auto Vertex = rtm::qvv_mul_point3({ pPos[0], pPos[1], pPos[2] }, WorldTfm);
+				rtm::vector4f Pos;
+				if (PositionFormat == VCFmt_Float16_4)
+				{
+					auto pPos = reinterpret_cast<const uint16_t*>(pSrc);
+					Pos = rtm::vector_set(HalfToFloat(pPos[0]), HalfToFloat(pPos[1]), HalfToFloat(pPos[2]));
+				}
+				else
+				{
+					auto pPos = reinterpret_cast<const float*>(pSrc);
+					Pos = rtm::vector_set(pPos[0], pPos[1], pPos[2]);
+				}
+
+				const auto Vertex = rtm::qvv_mul_point3(Pos, WorldTfm);
 				*pCurrVtx++ = rtm::vector_get_x(Vertex);
 				*pCurrVtx++ = rtm::vector_get_y(Vertex);
 				*pCurrVtx++ = rtm::vector_get_z(Vertex);
@@ -718,6 +1142,11 @@ public:
 					*pCurrIdx++ = GetVertexIndex(pSrc, Header.IndexSize, i * 3 + 2);
 				}
 			}
+
+			// Mesh indices are absolute in a vertex buffer, make them relative to the group vertices read above
+			if (Group.FirstVertex)
+				for (auto It = OutIndices.begin() + PrevIndexCount; It != OutIndices.end(); ++It)
+					*It -= static_cast<int>(Group.FirstVertex);
 		}
 
 		return true;
@@ -31,8 +31,8 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: CStrID
-		return false;
+		// Each task reads its own sources and writes its own output file
+		return true;
 	}
 
 	virtual ETaskResult ProcessTask(CContentForgeTask& Task) override
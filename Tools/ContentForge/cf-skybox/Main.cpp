@@ -40,9 +40,28 @@ public:
 
 	virtual bool SupportsMultithreading() const override
 	{
-		// FIXME: must handle duplicate targets (for example 2 metafiles writing the same resulting file, like depth_atest_ps)
-		// FIXME: CStrID
-		return false;
+		return true;
+	}
+
+	virtual std::vector<std::string> GetTaskOutputKeys(const CContentForgeTask& Task) const override
+	{
+		const std::string TaskName = GetValidResourceName(Task.TaskID.ToString());
+
+		std::string SkyboxFileName = Task.SrcFilePath.filename().generic_string();
+		ToLower(SkyboxFileName);
+		const auto TexturePath = GetOutputPath(Task.Params, "TextureOutput");
+		const auto SkyboxName = fs::path(SkyboxFileName).replace_extension().string();
+		const fs::path OutPath = GetOutputPath(Task.Params);
+
+		return
+		{
+			GetOutputKey(TexturePath / SkyboxFileName),
+			GetOutputKey(TexturePath / (SkyboxName + "_iem.dds")),
+			GetOutputKey(TexturePath / (SkyboxName + "_pmrem.dds")),
+			GetOutputKey(GetOutputPath(Task.Params, "MaterialOutput") / (TaskName + ".mtl")),
+			GetOutputKey(OutPath / (TaskName + ".hrd")),
+			GetOutputKey(OutPath / (TaskName + ".scn"))
+		};
 	}
 
 	virtual int Init() override
@@ -11,6 +11,7 @@
 #include <IL/il.h>
 #include <LinearMath/btConvexHullComputer.h>
 #include <regex>
+#include <mutex>
 
 namespace fs = std::filesystem;
 
@@ -119,6 +120,31 @@ void LoadAnimationSettings(const Data::CParams& TaskParams, const std::string& A
 }
 //---------------------------------------------------------------------
 
+void LoadMeshSettings(const Data::CParams& TaskParams, CVertexFormat& OutVertexFormat, CMeshLODSettings& OutLODSettings)
+{
+	ParamsUtils::TryGetParam(OutVertexFormat.QuantizeNormals, TaskParams, "QuantizeNormals");
+	ParamsUtils::TryGetParam(OutVertexFormat.QuantizeUVs, TaskParams, "QuantizeUVs");
+	ParamsUtils::TryGetParam(OutVertexFormat.QuantizePositions, TaskParams, "QuantizePositions");
+	ParamsUtils::TryGetParam(OutVertexFormat.MaxPositionError, TaskParams, "MaxPositionError");
+
+	const Data::CParams* pLODParams = nullptr;
+	if (ParamsUtils::TryGetParam(pLODParams, TaskParams, "LOD"))
+	{
+		OutLODSettings.LODCount = static_cast<size_t>(std::max(1, ParamsUtils::GetParam(*pLODParams, "Count", 1)));
+		ParamsUtils::TryGetParam(OutLODSettings.Reduction, *pLODParams, "Reduction");
+		ParamsUtils::TryGetParam(OutLODSettings.MaxError, *pLODParams, "MaxError");
+		ParamsUtils::TryGetParam(OutLODSettings.DistanceScale, *pLODParams, "DistanceScale");
+
+		const Data::CDataArray* pDistances = nullptr;
+		if (ParamsUtils::TryGetParam(pDistances, *pLODParams, "Distances"))
+			for (const auto& Distance : *pDistances)
+				OutLODSettings.Distances.push_back(Distance.IsA<int>() ? static_cast<float>(Distance.GetValue<int>()) : Distance.GetValue<float>());
+	}
+
+	ParamsUtils::TryGetParam(OutLODSettings.ShadowIndices, TaskParams, "ShadowIndices");
+}
+//---------------------------------------------------------------------
+
 void ProcessGeometry(const std::vector<CVertex>& RawVertices, const std::vector<unsigned int>& RawIndices,
 	std::vector<CVertex>& Vertices, std::vector<unsigned int>& Indices)
 {
@@ -149,9 +175,142 @@ void ProcessGeometry(const std::vector<CVertex>& RawVertices, const std::vector<
 	meshopt_optimizeOverdraw(Indices.data(), Indices.data(), Indices.size(), &Vertices[0].Position.x, Vertices.size(), sizeof(CVertex), 1.05f);
 
 	meshopt_optimizeVertexFetch(Vertices.data(), Indices.data(), Indices.size(), Vertices.data(), Vertices.size(), sizeof(CVertex));
+}
+//---------------------------------------------------------------------
+
+// Must be called after ProcessGeometry, because vertex order must not change after LODs are built
+void BuildMeshLODs(CMeshGroup& SubMesh, const CMeshLODSettings& Settings)
+{
+	SubMesh.LODIndices.clear();
+	SubMesh.ShadowIndices.clear();
+
+	if (SubMesh.Indices.empty()) return;
+
+	const float* pPositions = &SubMesh.Vertices[0].Position.x;
+	const size_t VertexCount = SubMesh.Vertices.size();
+
+	// All LODs are simplified from the original mesh to avoid error accumulation. Vertices are shared
+	// with the original mesh, only new index data is generated.
+	size_t TargetIndexCount = SubMesh.Indices.size();
+	for (size_t LOD = 1; LOD < Settings.LODCount; ++LOD)
+	{
+		TargetIndexCount = static_cast<size_t>(TargetIndexCount * Settings.Reduction);
+
+		const auto& PrevIndices = SubMesh.LODIndices.empty() ? SubMesh.Indices : SubMesh.LODIndices.back();
+
+		std::vector<unsigned int> LODIndices(SubMesh.Indices.size());
+		LODIndices.resize(meshopt_simplify(LODIndices.data(), SubMesh.Indices.data(), SubMesh.Indices.size(),
+			pPositions, VertexCount, sizeof(CVertex), TargetIndexCount, Settings.MaxError));
+
+		// Error limit is reached, further LODs would be the same
+		if (LODIndices.empty() || LODIndices.size() >= PrevIndices.size()) break;
 
-	// TODO: meshopt_generateShadowIndexBuffer for Z prepass and shadow rendering.
-	// Also can separate positions from all other data into 2 vertex streams, and use only positions for shadows & Z prepass.
+		meshopt_optimizeVertexCache(LODIndices.data(), LODIndices.data(), LODIndices.size(), VertexCount);
+
+		SubMesh.LODIndices.push_back(std::move(LODIndices));
+	}
+
+	if (!Settings.ShadowIndices) return;
+
+	// Shadow index buffers reference the first of the vertices with the same position, so that vertices
+	// split by normal or UV seams don't break the post-transform cache when only positions are used
+	SubMesh.ShadowIndices.resize(1 + SubMesh.LODIndices.size());
+	for (size_t LOD = 0; LOD < SubMesh.ShadowIndices.size(); ++LOD)
+	{
+		const auto& Indices = LOD ? SubMesh.LODIndices[LOD - 1] : SubMesh.Indices;
+		auto& ShadowIndices = SubMesh.ShadowIndices[LOD];
+		ShadowIndices.resize(Indices.size());
+		meshopt_generateShadowIndexBuffer(ShadowIndices.data(), Indices.data(), Indices.size(), pPositions, VertexCount, sizeof(float3), sizeof(CVertex));
+		meshopt_optimizeVertexCache(ShadowIndices.data(), ShadowIndices.data(), ShadowIndices.size(), VertexCount);
+	}
+}
+//---------------------------------------------------------------------
+
+size_t GetMeshLODCount(const std::map<std::string, CMeshGroup>& SubMeshes)
+{
+	size_t LODCount = 1;
+	for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+		LODCount = std::max(LODCount, 1 + SubMesh.LODIndices.size());
+	return LODCount;
+}
+//---------------------------------------------------------------------
+
+std::vector<float> GetMeshLODDistances(const CAABB& AABB, size_t LODCount, const CMeshLODSettings& Settings)
+{
+	std::vector<float> Distances;
+	if (LODCount < 2) return Distances;
+
+	if (Settings.Distances.size() >= LODCount - 1)
+	{
+		Distances.assign(Settings.Distances.cbegin(), Settings.Distances.cbegin() + (LODCount - 1));
+		return Distances;
+	}
+
+	const float SizeX = AABB.Max.x - AABB.Min.x;
+	const float SizeY = AABB.Max.y - AABB.Min.y;
+	const float SizeZ = AABB.Max.z - AABB.Min.z;
+	const float Radius = 0.5f * std::sqrt(SizeX * SizeX + SizeY * SizeY + SizeZ * SizeZ);
+
+	float Distance = Radius * Settings.DistanceScale;
+	for (size_t LOD = 1; LOD < LODCount; ++LOD)
+	{
+		Distances.push_back(Distance);
+		Distance *= 2.f;
+	}
+
+	return Distances;
+}
+//---------------------------------------------------------------------
+
+// Models of a mesh with LODs are placed into child nodes switched by Scene::CLODGroup. Each child
+// renders the same mesh with a different MeshLOD. CLODGroup switches all children of its node, so it
+// gets a dedicated child node to not affect other children. Without LODs models are added to the node itself.
+void AddModelLODs(Data::CDataArray& ModelAttributes, const std::vector<float>& LODDistances, Data::CDataArray& Attributes, Data::CParams& Children)
+{
+	if (LODDistances.empty())
+	{
+		for (auto& ModelAttribute : ModelAttributes)
+			Attributes.push_back(std::move(ModelAttribute));
+		return;
+	}
+
+	static const CStrID sidAttrs("Attrs");
+	static const CStrID sidChildren("Children");
+
+	Data::CParams Thresholds;
+	Data::CParams LODNodes;
+	for (size_t LOD = 0; LOD <= LODDistances.size(); ++LOD)
+	{
+		const CStrID ChildID(("LOD" + std::to_string(LOD)).c_str());
+
+		// The last LOD is active at any distance
+		Thresholds.emplace_back(ChildID, (LOD < LODDistances.size()) ? LODDistances[LOD] : FLT_MAX);
+
+		Data::CDataArray ChildAttributes;
+		for (const auto& ModelAttribute : ModelAttributes)
+		{
+			Data::CParams ChildAttribute = ModelAttribute.GetValue<Data::CParams>();
+			if (LOD > 0)
+				ChildAttribute.emplace_back(CStrID("MeshLOD"), static_cast<int>(LOD));
+			ChildAttributes.push_back(std::move(ChildAttribute));
+		}
+
+		Data::CParams ChildSection;
+		ChildSection.emplace_back(sidAttrs, std::move(ChildAttributes));
+		LODNodes.emplace_back(ChildID, std::move(ChildSection));
+	}
+
+	Data::CParams LODGroupAttribute;
+	LODGroupAttribute.emplace_back(CStrID("Class"), 'LODG'); // Scene::CLODGroup
+	LODGroupAttribute.emplace_back(CStrID("Thresholds"), std::move(Thresholds));
+
+	Data::CDataArray LODGroupAttributes;
+	LODGroupAttributes.push_back(std::move(LODGroupAttribute));
+
+	Data::CParams LODGroupSection;
+	LODGroupSection.emplace_back(sidAttrs, std::move(LODGroupAttributes));
+	LODGroupSection.emplace_back(sidChildren, std::move(LODNodes));
+	Children.emplace_back(CStrID("LODGroup"), std::move(LODGroupSection));
 }
 //---------------------------------------------------------------------
 
@@ -164,6 +323,38 @@ void WriteVertexComponent(std::ostream& Stream, EVertexComponentSemantic Semanti
 }
 //---------------------------------------------------------------------
 
+static bool CanStorePositionsAsHalf(const std::map<std::string, CMeshGroup>& SubMeshes, float MaxError)
+{
+	for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+		for (const auto& Vertex : SubMesh.Vertices)
+			for (const float Coord : { Vertex.Position.x, Vertex.Position.y, Vertex.Position.z })
+				if (std::fabs(HalfToFloat(meshopt_quantizeHalf(Coord)) - Coord) > MaxError)
+					return false;
+
+	return true;
+}
+//---------------------------------------------------------------------
+
+static bool IsUVSetNormalized(const std::map<std::string, CMeshGroup>& SubMeshes, size_t UVIndex)
+{
+	for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+		for (const auto& Vertex : SubMesh.Vertices)
+			if (Vertex.UV[UVIndex].x < 0.f || Vertex.UV[UVIndex].x > 1.f || Vertex.UV[UVIndex].y < 0.f || Vertex.UV[UVIndex].y > 1.f)
+				return false;
+
+	return true;
+}
+//---------------------------------------------------------------------
+
+static void WriteVectorSNorm16(std::ostream& Stream, const float3& Value)
+{
+	WriteStream(Stream, static_cast<int16_t>(meshopt_quantizeSnorm(Value.x, 16)));
+	WriteStream(Stream, static_cast<int16_t>(meshopt_quantizeSnorm(Value.y, 16)));
+	WriteStream(Stream, static_cast<int16_t>(meshopt_quantizeSnorm(Value.z, 16)));
+	WriteStream<int16_t>(Stream, 0);
+}
+//---------------------------------------------------------------------
+
 bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGroup>& SubMeshes, const CVertexFormat& VertexFormat, size_t BoneCount, CThreadSafeLog& Log)
 {
 	fs::create_directories(DestPath.parent_path());
@@ -178,20 +369,102 @@ bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGro
 	if (VertexFormat.BlendWeightSize != 8 && VertexFormat.BlendWeightSize != 16 && VertexFormat.BlendWeightSize != 32)
 		Log.LogWarning("Unsupported blend weight size, defaulting to full-precision floats (32). Supported values are 8/16/32.");
 
+	const size_t LODCount = GetMeshLODCount(SubMeshes);
+
+	// Build a single index buffer. Groups are stored LOD-major, and shadow groups follow all regular ones.
+	// A submesh with less LODs than the mesh uses its last LOD for the rest. Indices are rebased to the
+	// beginning of the vertex buffer, because groups are rendered without a base vertex.
+
+	struct CGroupRange
+	{
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+	};
+
+	std::vector<unsigned int> AllIndices;
+	std::vector<CGroupRange> Ranges(SubMeshes.size() * LODCount);
+	std::vector<CGroupRange> ShadowRanges;
+	std::vector<uint32_t> FirstVertices;
+
+	const bool HasShadowGroups = std::all_of(SubMeshes.cbegin(), SubMeshes.cend(), [](const auto& Pair)
+	{
+		return Pair.second.Indices.empty() || !Pair.second.ShadowIndices.empty();
+	});
+	if (HasShadowGroups) ShadowRanges.resize(Ranges.size());
+
 	size_t TotalVertices = 0;
-	size_t TotalIndices = 0;
 	for (const auto& Pair : SubMeshes)
 	{
+		FirstVertices.push_back(static_cast<uint32_t>(TotalVertices));
 		TotalVertices += Pair.second.Vertices.size();
-		TotalIndices += Pair.second.Indices.size();
 	}
 
+	const auto AddIndices = [&AllIndices](const std::vector<unsigned int>& Indices, uint32_t FirstVertex, CGroupRange& OutRange)
+	{
+		OutRange.FirstIndex = static_cast<uint32_t>(AllIndices.size());
+		OutRange.IndexCount = static_cast<uint32_t>(Indices.size());
+		for (auto Index : Indices)
+			AllIndices.push_back(Index + FirstVertex);
+	};
+
+	for (size_t LOD = 0; LOD < LODCount; ++LOD)
+	{
+		size_t SubMeshIndex = 0;
+		for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+		{
+			const size_t SubMeshLOD = std::min(LOD, SubMesh.LODIndices.size());
+			const size_t GroupIndex = LOD * SubMeshes.size() + SubMeshIndex;
+			if (SubMeshLOD == LOD)
+				AddIndices(SubMeshLOD ? SubMesh.LODIndices[SubMeshLOD - 1] : SubMesh.Indices, FirstVertices[SubMeshIndex], Ranges[GroupIndex]);
+			else
+				Ranges[GroupIndex] = Ranges[SubMeshLOD * SubMeshes.size() + SubMeshIndex];
+			++SubMeshIndex;
+		}
+	}
+
+	if (HasShadowGroups)
+	{
+		for (size_t LOD = 0; LOD < LODCount; ++LOD)
+		{
+			size_t SubMeshIndex = 0;
+			for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+			{
+				const size_t SubMeshLOD = std::min(LOD, SubMesh.LODIndices.size());
+				const size_t GroupIndex = LOD * SubMeshes.size() + SubMeshIndex;
+
+				// Empty submesh has no shadow indices, its range is left empty
+				if (!SubMesh.ShadowIndices.empty())
+				{
+					if (SubMeshLOD == LOD)
+						AddIndices(SubMesh.ShadowIndices[SubMeshLOD], FirstVertices[SubMeshIndex], ShadowRanges[GroupIndex]);
+					else
+						ShadowRanges[GroupIndex] = ShadowRanges[SubMeshLOD * SubMeshes.size() + SubMeshIndex];
+				}
+
+				++SubMeshIndex;
+			}
+		}
+	}
+
+	// Choose vertex component formats
+
+	const bool PositionsAsHalf = VertexFormat.QuantizePositions && CanStorePositionsAsHalf(SubMeshes, VertexFormat.MaxPositionError);
+	if (VertexFormat.QuantizePositions && !PositionsAsHalf)
+		Log.LogDebug("Mesh " + DestPath.filename().string() + " positions can't be quantized within the error limit, floats are used");
+
+	bool UVsAsUNorm[MaxUV] = { false };
+	for (size_t i = 0; i < VertexFormat.UVCount; ++i)
+		UVsAsUNorm[i] = VertexFormat.QuantizeUVs && IsUVSetNormalized(SubMeshes, i);
+
+	const auto VectorFormat = VertexFormat.QuantizeNormals ? EVertexComponentFormat::VCFmt_SInt16_4_Norm : EVertexComponentFormat::VCFmt_Float32_3;
+
 	WriteStream<uint32_t>(File, 'MESH');     // Format magic value
-	WriteStream<uint32_t>(File, 0x00010000); // Version 0.1.0.0
+	WriteStream<uint32_t>(File, 0x00020000); // Version 0.2.0.0
 
 	WriteStream(File, static_cast<uint32_t>(SubMeshes.size()));
+	WriteStream(File, static_cast<uint32_t>(LODCount));
 	WriteStream(File, static_cast<uint32_t>(TotalVertices));
-	WriteStream(File, static_cast<uint32_t>(TotalIndices));
+	WriteStream(File, static_cast<uint32_t>(AllIndices.size()));
 
 	// One index size in bytes
 	const bool Indices32 = (TotalVertices > std::numeric_limits<uint16_t>().max());
@@ -216,22 +489,24 @@ bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGro
 
 	WriteStream(File, VertexComponentCount);
 
-	WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Position, EVertexComponentFormat::VCFmt_Float32_3, 0, 0);
+	WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Position,
+		PositionsAsHalf ? EVertexComponentFormat::VCFmt_Float16_4 : EVertexComponentFormat::VCFmt_Float32_3, 0, 0);
 
 	for (uint8_t i = 0; i < VertexFormat.NormalCount; ++i)
-		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Normal, EVertexComponentFormat::VCFmt_Float32_3, i, 0);
+		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Normal, VectorFormat, i, 0);
 
 	for (uint8_t i = 0; i < VertexFormat.TangentCount; ++i)
-		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Tangent, EVertexComponentFormat::VCFmt_Float32_3, i, 0);
+		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Tangent, VectorFormat, i, 0);
 
 	for (uint8_t i = 0; i < VertexFormat.BitangentCount; ++i)
-		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Bitangent, EVertexComponentFormat::VCFmt_Float32_3, i, 0);
+		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Bitangent, VectorFormat, i, 0);
 
 	for (uint8_t i = 0; i < VertexFormat.ColorCount; ++i)
 		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_Color, EVertexComponentFormat::VCFmt_UInt8_4_Norm, i, 0);
 
 	for (uint8_t i = 0; i < VertexFormat.UVCount; ++i)
-		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_TexCoord, EVertexComponentFormat::VCFmt_Float32_2, i, 0);
+		WriteVertexComponent(File, EVertexComponentSemantic::VCSem_TexCoord,
+			UVsAsUNorm[i] ? EVertexComponentFormat::VCFmt_UInt16_2_Norm : EVertexComponentFormat::VCFmt_Float32_2, i, 0);
 
 	if (VertexFormat.BonesPerVertex)
 	{
@@ -270,18 +545,30 @@ bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGro
 		}
 	}
 
-	// Save mesh groups (always 1 LOD now, may change later)
+	// Save mesh groups, [LOD][SubMesh]. LODs share vertices, so the vertex range is the same for all of them.
+	for (size_t LOD = 0; LOD < LODCount; ++LOD)
+	{
+		size_t SubMeshIndex = 0;
+		for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+		{
+			const auto& Range = Ranges[LOD * SubMeshes.size() + SubMeshIndex];
+			WriteStream(File, FirstVertices[SubMeshIndex]);                            // First vertex
+			WriteStream(File, static_cast<uint32_t>(SubMesh.Vertices.size()));         // Vertex count
+			WriteStream(File, Range.FirstIndex);                                       // First index
+			WriteStream(File, Range.IndexCount);                                       // Index count
+			WriteStream(File, static_cast<uint8_t>(EPrimitiveTopology::Prim_TriList));
+			WriteStream(File, SubMesh.AABB.Min);
+			WriteStream(File, SubMesh.AABB.Max);
+			++SubMeshIndex;
+		}
+	}
 
-	// TODO: test if index offset is needed, each submesh starts from zero now
-	for (const auto& [SubMeshID, SubMesh] : SubMeshes)
+	// Save shadow groups, only index ranges differ from regular groups
+	WriteStream<uint8_t>(File, HasShadowGroups ? 1 : 0);
+	for (const auto& Range : ShadowRanges)
 	{
-		WriteStream<uint32_t>(File, 0);                                            // First vertex
-		WriteStream(File, static_cast<uint32_t>(SubMesh.Vertices.size()));         // Vertex count
-		WriteStream<uint32_t>(File, 0);                                            // First index
-		WriteStream(File, static_cast<uint32_t>(SubMesh.Indices.size()));          // Index count
-		WriteStream(File, static_cast<uint8_t>(EPrimitiveTopology::Prim_TriList));
-		WriteStream(File, SubMesh.AABB.Min);
-		WriteStream(File, SubMesh.AABB.Max);
+		WriteStream(File, Range.FirstIndex);
+		WriteStream(File, Range.IndexCount);
 	}
 
 	// Align vertex and index data offsets to 16 bytes. It should speed up loading from memory-mapped file.
@@ -307,15 +594,39 @@ bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGro
 		const auto& Vertices = Pair.second.Vertices;
 		for (const auto& Vertex : Vertices)
 		{
-			WriteStream(File, Vertex.Position);
+			if (PositionsAsHalf)
+			{
+				WriteStream(File, meshopt_quantizeHalf(Vertex.Position.x));
+				WriteStream(File, meshopt_quantizeHalf(Vertex.Position.y));
+				WriteStream(File, meshopt_quantizeHalf(Vertex.Position.z));
+				WriteStream(File, meshopt_quantizeHalf(1.f));
+			}
+			else WriteStream(File, Vertex.Position);
+
+			if (VertexFormat.QuantizeNormals)
+			{
+				if (VertexFormat.NormalCount) WriteVectorSNorm16(File, Vertex.Normal);
+				if (VertexFormat.TangentCount) WriteVectorSNorm16(File, Vertex.Tangent);
+				if (VertexFormat.BitangentCount) WriteVectorSNorm16(File, Vertex.Bitangent);
+			}
+			else
+			{
+				if (VertexFormat.NormalCount) WriteStream(File, Vertex.Normal);
+				if (VertexFormat.TangentCount) WriteStream(File, Vertex.Tangent);
+				if (VertexFormat.BitangentCount) WriteStream(File, Vertex.Bitangent);
+			}
 
-			if (VertexFormat.NormalCount) WriteStream(File, Vertex.Normal);
-			if (VertexFormat.TangentCount) WriteStream(File, Vertex.Tangent);
-			if (VertexFormat.BitangentCount) WriteStream(File, Vertex.Bitangent);
 			if (VertexFormat.ColorCount) WriteStream(File, Vertex.Color);
 
 			for (size_t i = 0; i < VertexFormat.UVCount; ++i)
-				WriteStream(File, Vertex.UV[i]);
+			{
+				if (UVsAsUNorm[i])
+				{
+					WriteStream(File, static_cast<uint16_t>(meshopt_quantizeUnorm(Vertex.UV[i].x, 16)));
+					WriteStream(File, static_cast<uint16_t>(meshopt_quantizeUnorm(Vertex.UV[i].y, 16)));
+				}
+				else WriteStream(File, Vertex.UV[i]);
+			}
 
 			if (VertexFormat.BonesPerVertex)
 			{
@@ -361,22 +672,18 @@ bool WriteDEMMesh(const fs::path& DestPath, const std::map<std::string, CMeshGro
 
 	assert(!(static_cast<uint32_t>(File.tellp()) % 16));
 
-	for (const auto& Pair : SubMeshes)
+	if (Indices32)
 	{
-		const auto& Indices = Pair.second.Indices;
-		if (Indices32)
-		{
-			static_assert(sizeof(unsigned int) == 4);
-			File.write(reinterpret_cast<const char*>(Indices.data()), Indices.size() * 4);
-		}
-		else
-		{
-			for (auto Index : Indices)
-				WriteStream(File, static_cast<uint16_t>(Index));
-		}
+		static_assert(sizeof(unsigned int) == 4);
+		File.write(reinterpret_cast<const char*>(AllIndices.data()), AllIndices.size() * 4);
+	}
+	else
+	{
+		for (auto Index : AllIndices)
+			WriteStream(File, static_cast<uint16_t>(Index));
 	}
 
-	Log.LogInfo(DestPath.filename().generic_string() + " " + std::to_string(File.tellp()) + " bytes saved");
+	Log.LogInfo(DestPath.filename().generic_string() + " " + std::to_string(File.tellp()) + " bytes saved, " + std::to_string(LODCount) + " LOD(s)");
 
 	// Write delayed values
 	File.seekp(DataOffsetsPos);
@@ -398,9 +705,11 @@ bool ReadDEMMeshVertexPositions(const std::filesystem::path& Path, std::vector<f
 
 	// Check format magic and version
 	if (ReadStream<uint32_t>(File) != 'MESH') return false;
-	if (ReadStream<uint32_t>(File) != 0x00010000) return false;
+	const auto Version = ReadStream<uint32_t>(File);
+	if (Version != 0x00010000 && Version != 0x00020000) return false;
 
 	const auto SubMeshCount = ReadStream<uint32_t>(File);
+	const auto LODCount = (Version >= 0x00020000) ? ReadStream<uint32_t>(File) : 1;
 	const auto VertexCount = ReadStream<uint32_t>(File);
 
 	Out.resize(VertexCount);
@@ -413,6 +722,7 @@ bool ReadDEMMeshVertexPositions(const std::filesystem::path& Path, std::vector<f
 	size_t PosOffset = 0;
 	size_t VertexSize = 0;
 	bool PosFound = false;
+	auto PosFormat = EVertexComponentFormat::VCFmt_Invalid;
 	const auto VertexComponentCount = ReadStream<uint32_t>(File);
 	for (uint32_t i = 0; i < VertexComponentCount; ++i)
 	{
@@ -423,7 +733,10 @@ bool ReadDEMMeshVertexPositions(const std::filesystem::path& Path, std::vector<f
 		VertexSize += ComponentSize;
 
 		if (Semantic == EVertexComponentSemantic::VCSem_Position)
+		{
 			PosFound = true;
+			PosFormat = Format;
+		}
 		else if (!PosFound)
 			PosOffset += ComponentSize;
 
@@ -432,19 +745,35 @@ bool ReadDEMMeshVertexPositions(const std::filesystem::path& Path, std::vector<f
 		ReadStream<uint8_t>(File);
 	}
 
+	if (PosFormat != EVertexComponentFormat::VCFmt_Float32_3 && PosFormat != EVertexComponentFormat::VCFmt_Float16_4)
+	{
+		Log.LogError("Unsupported vertex position format in mesh file " + Path.generic_string());
+		return false;
+	}
+
 	// Skip mesh group definitions, 41 byte each
-	File.seekg(SubMeshCount * 41, std::ios_base::_Seekcur);
+	File.seekg(SubMeshCount * LODCount * 41, std::ios_base::_Seekcur);
+
+	// Skip shadow group index ranges
+	if (Version >= 0x00020000 && ReadStream<uint8_t>(File))
+		File.seekg(SubMeshCount * LODCount * 2 * sizeof(uint32_t), std::ios_base::_Seekcur);
 
 	const auto VertexDataOffset = ReadStream<uint32_t>(File);
 	const auto IndexDataOffset = ReadStream<uint32_t>(File);
 
 	// Seek to the first vertex position
 	File.seekg(VertexDataOffset + PosOffset, std::ios_base::_Seekbeg);
-	const auto RemainingVertexSize = VertexSize - sizeof(float3);
+	const auto RemainingVertexSize = VertexSize - GetVertexComponentSize(PosFormat);
 
 	for (uint32_t i = 0; i < VertexCount; ++i)
 	{
-		ReadStream(File, Out[i]);
+		if (PosFormat == EVertexComponentFormat::VCFmt_Float16_4)
+		{
+			uint16_t Half[4];
+			File.read(reinterpret_cast<char*>(Half), sizeof(Half));
+			Out[i] = float3(HalfToFloat(Half[0]), HalfToFloat(Half[1]), HalfToFloat(Half[2]));
+		}
+		else ReadStream(File, Out[i]);
 		if (i < VertexCount - 1 && RemainingVertexSize > 0)
 			File.seekg(RemainingVertexSize, std::ios_base::_Seekcur);
 	}
@@ -699,6 +1028,10 @@ bool WriteDEMScene(const std::filesystem::path& DestDir, const std::string& Name
 }
 //---------------------------------------------------------------------
 
+// DevIL keeps the bound image and settings in a global state, so image calls from parallel tasks must be serialized.
+// Recursive because public image functions call each other.
+static std::recursive_mutex DevILMutex;
+
 void InitImageProcessing()
 {
 	ilInit();
@@ -719,6 +1052,8 @@ static bool IsImageFormatSavingSupported(std::string_view Format)
 
 ILuint LoadILImage(const std::filesystem::path& SrcPath, CThreadSafeLog& Log)
 {
+	std::lock_guard Lock(DevILMutex);
+
 	ILuint ImgId = ilGenImage();
 	ilBindImage(ImgId);
 
@@ -735,12 +1070,16 @@ ILuint LoadILImage(const std::filesystem::path& SrcPath, CThreadSafeLog& Log)
 
 void UnloadILImage(ILuint ID)
 {
-	if (ID) ilDeleteImage(ID);
+	if (!ID) return;
+
+	std::lock_guard Lock(DevILMutex);
+	ilDeleteImage(ID);
 }
 //---------------------------------------------------------------------
 
 CRect GetILImageRect(ILuint ID)
 {
+	std::lock_guard Lock(DevILMutex);
 	ilBindImage(ID);
 	return GetCurrentILImageRect();
 }
@@ -748,6 +1087,7 @@ CRect GetILImageRect(ILuint ID)
 
 CRect GetCurrentILImageRect()
 {
+	std::lock_guard Lock(DevILMutex);
 	return CRect(0, 0, ilGetInteger(IL_IMAGE_WIDTH) - 1, ilGetInteger(IL_IMAGE_HEIGHT) - 1);
 }
 //---------------------------------------------------------------------
@@ -756,6 +1096,8 @@ bool SaveCurrentILImage(const std::string& DestFormat, std::filesystem::path& De
 {
 	fs::create_directories(DestPath.parent_path());
 
+	std::lock_guard Lock(DevILMutex);
+
 	ilEnable(IL_FILE_OVERWRITE);
 
 	ILboolean Result = IL_FALSE;
@@ -814,6 +1156,8 @@ bool SaveCurrentILImage(const std::string& DestFormat, std::filesystem::path& De
 
 bool SaveILImageRegion(ILuint ID, const std::string& DestFormat, std::filesystem::path& DestPath, CRect& Region, CThreadSafeLog& Log)
 {
+	std::lock_guard Lock(DevILMutex);
+
 	ilBindImage(ID);
 
 	const auto ImageRect = GetCurrentILImageRect();
@@ -893,6 +1237,9 @@ std::string WriteTexture(const fs::path& SrcPath, const fs::path& DestDir, const
 	}
 	else
 	{
+		// Load and save must not be interleaved with other tasks binding their images
+		std::lock_guard Lock(DevILMutex);
+
 		ILuint ImgId = LoadILImage(SrcPath, Log);
 		if (!ImgId) return {};
 
@@ -80,6 +80,22 @@ struct CVertexFormat
 	size_t UVCount = 0;
 	size_t BonesPerVertex = 0;
 	size_t BlendWeightSize = 16;
+
+	// Quantization of vertex components, see WriteDEMMesh
+	bool   QuantizeNormals = true;    // Normals, tangents and bitangents as SInt16_4_Norm
+	bool   QuantizeUVs = true;        // UV sets that fit into [0; 1] as UInt16_2_Norm
+	bool   QuantizePositions = false; // Positions as Float16_4 if the error doesn't exceed MaxPositionError
+	float  MaxPositionError = 0.001f; // In mesh units
+};
+
+struct CMeshLODSettings
+{
+	size_t LODCount = 1;           // Including the original mesh, 1 means no simplification
+	float  Reduction = 0.5f;       // Target index count of each LOD relative to the previous one
+	float  MaxError = 0.05f;       // Relative to the mesh extents, simplification stops when it is reached
+	float  DistanceScale = 8.f;    // LOD N is switched at (Radius * DistanceScale * 2^N), if distances are not specified
+	std::vector<float> Distances;  // Explicit switching distances, LODCount - 1 values
+	bool   ShadowIndices = true;   // Generate position-only index buffers for shadows and depth prepass
 };
 
 struct CAABB
@@ -92,6 +108,8 @@ struct CMeshGroup
 {
 	std::vector<CVertex> Vertices;
 	std::vector<unsigned int> Indices;
+	std::vector<std::vector<unsigned int>> LODIndices;    // Simplified LODs starting from 1, reference the same vertices
+	std::vector<std::vector<unsigned int>> ShadowIndices; // Per LOD starting from 0, reference only unique positions
 	CAABB AABB;
 };
 
@@ -99,6 +117,7 @@ struct CMeshAttrInfo
 {
 	std::string MeshID;
 	std::vector<std::string> MaterialIDs; // Per group (submesh)
+	std::vector<float> LODDistances;      // Switching distances, LOD count - 1 values
 	CAABB AABB;
 };
 
@@ -223,7 +242,12 @@ inline void MergeAABBs(CAABB& Dest, const CAABB& Src)
 std::string GetRelativeNodePath(std::vector<std::string>&& From, std::vector<std::string>&& To);
 bool LoadSceneSettings(const std::filesystem::path& Path, CSceneSettings& Out);
 void LoadAnimationSettings(const Data::CParams& TaskParams, const std::string& AnimName, CAnimationSettings& Out);
+void LoadMeshSettings(const Data::CParams& TaskParams, CVertexFormat& OutVertexFormat, CMeshLODSettings& OutLODSettings);
 void ProcessGeometry(const std::vector<CVertex>& RawVertices, const std::vector<unsigned int>& RawIndices, std::vector<CVertex>& Vertices, std::vector<unsigned int>& Indices);
+void BuildMeshLODs(CMeshGroup& SubMesh, const CMeshLODSettings& Settings);
+size_t GetMeshLODCount(const std::map<std::string, CMeshGroup>& SubMeshes);
+std::vector<float> GetMeshLODDistances(const CAABB& AABB, size_t LODCount, const CMeshLODSettings& Settings);
+void AddModelLODs(Data::CDataArray& ModelAttributes, const std::vector<float>& LODDistances, Data::CDataArray& Attributes, Data::CParams& Children);
 void WriteVertexComponent(std::ostream& Stream, EVertexComponentSemantic Semantic, EVertexComponentFormat Format, uint8_t Index, uint8_t StreamIndex);
 bool WriteDEMMesh(const std::filesystem::path& DestPath, const std::map<std::string, CMeshGroup>& SubMeshes, const CVertexFormat& VertexFormat, size_t BoneCount, CThreadSafeLog& Log);
 bool ReadDEMMeshVertexPositions(const std::filesystem::path& Path, std::vector<float3>& Out, CThreadSafeLog& Log);